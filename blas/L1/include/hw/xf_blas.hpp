@@ -44,6 +44,7 @@
 #include "xf_blas/gbmv.hpp"
 #include "xf_blas/symv.hpp"
 #include "xf_blas/trmv.hpp"
+#include "xf_blas/ellspmv.hpp"
 /* TODO
  *
  */
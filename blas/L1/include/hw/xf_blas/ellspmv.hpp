@@ -0,0 +1,267 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef XF_BLAS_ELLSPMV_HPP
+#define XF_BLAS_ELLSPMV_HPP
+
+#ifndef __cplusplus
+#error "BLAS Library only works with C++."
+#endif
+
+#include "ap_int.h"
+#include "hls_stream.h"
+#include "xf_blas/helpers.hpp"
+
+/*
+ * Sparse matrices are streamed in blocked-ELL format.
+ * The matrix is split into column blocks of p_colBlock columns, so that the matching block of x is kept on chip
+ * and reused by all the rows. In each column block, rows are grouped into slices of p_sliceRows rows, and every
+ * row of a slice is padded to the same number of words, each word holding t_ParEntries values and their column
+ * indices local to the column block. Padding entries have value 0.
+ * The width stream gives the number of words per row of each slice, column block by column block.
+ */
+
+namespace xf {
+
+namespace blas {
+
+/**
+ * @brief ellSpmv function that returns the result vector y = A * x + y for a sparse matrix A in blocked-ELL format
+ *
+ * The sum of a row rotates over AdderDelay<t_DataType>::m_Delays partial sums, which are reduced at the end of the
+ * row, so that one word is consumed per cycle even with a floating-point adder.
+ *
+ * @tparam t_DataType the data type of the matrix and vector entries
+ * @tparam t_LogParEntries log2 of the number of parallelly processed entries
+ * @tparam t_MaxColBlock the maximum number of columns in a column block
+ * @tparam t_MaxRows the maximum number of rows in matrix A
+ * @tparam t_IndexType the datatype of the index
+ *
+ * @param p_m the number of rows in matrix A, p_m % t_ParEntries == 0
+ * @param p_n the number of cols in matrix A, p_n % t_ParEntries == 0
+ * @param p_colBlock the number of cols in each column block, p_colBlock % t_ParEntries == 0
+ * @param p_sliceRows the number of rows in each slice
+ * @param p_width the input stream of row widths in words, one per slice and column block
+ * @param p_val the input stream of packed matrix values
+ * @param p_col the input stream of packed column indices, local to the column block
+ * @param p_x the input stream of packed vector x entries
+ * @param p_y the input stream of packed vector y entries
+ * @param p_yr the output stream of packed result entries
+ */
+template <typename t_DataType,
+          unsigned int t_LogParEntries,
+          unsigned int t_MaxColBlock,
+          unsigned int t_MaxRows,
+          typename t_IndexType = unsigned int>
+void ellSpmv(const unsigned int p_m,
+             const unsigned int p_n,
+             const unsigned int p_colBlock,
+             const unsigned int p_sliceRows,
+             hls::stream<t_IndexType>& p_width,
+             hls::stream<WideType<t_DataType, 1 << t_LogParEntries> >& p_val,
+             hls::stream<WideType<t_IndexType, 1 << t_LogParEntries> >& p_col,
+             hls::stream<WideType<t_DataType, 1 << t_LogParEntries> >& p_x,
+             hls::stream<WideType<t_DataType, 1 << t_LogParEntries> >& p_y,
+             hls::stream<WideType<t_DataType, 1 << t_LogParEntries> >& p_yr) {
+    const unsigned int l_parEntries = 1 << t_LogParEntries;
+#ifndef __SYNTHESIS__
+    assert(p_m % l_parEntries == 0);
+    assert(p_n % l_parEntries == 0);
+    assert(p_colBlock % l_parEntries == 0);
+    assert(p_colBlock <= t_MaxColBlock);
+    assert(p_m <= t_MaxRows);
+#endif
+    // one copy of the x block per lane, so that all the lanes gather in the same cycle
+    t_DataType l_x[l_parEntries][t_MaxColBlock];
+#pragma HLS ARRAY_PARTITION variable = l_x complete dim = 1
+#pragma HLS ARRAY_PARTITION variable = l_x cyclic factor = l_parEntries dim = 2
+    t_DataType l_y[t_MaxRows];
+    const unsigned int l_delays = AdderDelay<t_DataType>::m_Delays;
+
+    for (t_IndexType i = 0; i < p_m; i++) {
+#pragma HLS PIPELINE
+        l_y[i] = 0;
+    }
+
+    const unsigned int l_numColBlocks = (p_n + p_colBlock - 1) / p_colBlock;
+    const unsigned int l_numSlices = (p_m + p_sliceRows - 1) / p_sliceRows;
+    for (t_IndexType b = 0; b < l_numColBlocks; b++) {
+        const unsigned int l_cols = (b == l_numColBlocks - 1) ? p_n - b * p_colBlock : p_colBlock;
+        for (t_IndexType i = 0; i < (l_cols >> t_LogParEntries); i++) {
+#pragma HLS PIPELINE
+            WideType<t_DataType, 1 << t_LogParEntries> l_xv = p_x.read();
+            for (t_IndexType c = 0; c < l_parEntries; c++) {
+                for (t_IndexType k = 0; k < l_parEntries; k++) {
+                    l_x[c][(i << t_LogParEntries) + k] = l_xv[k];
+                }
+            }
+        }
+        for (t_IndexType s = 0; s < l_numSlices; s++) {
+            const unsigned int l_width = p_width.read();
+            const unsigned int l_rowBegin = s * p_sliceRows;
+            const unsigned int l_rows = (s == l_numSlices - 1) ? p_m - l_rowBegin : p_sliceRows;
+            for (t_IndexType r = 0; r < l_rows; r++) {
+                // one partial sum per adder stage, so that a word is accumulated every cycle
+                t_DataType l_acc[l_delays];
+#pragma HLS ARRAY_PARTITION variable = l_acc complete dim = 1
+                for (t_IndexType d = 0; d < l_delays; d++) {
+#pragma HLS UNROLL
+                    l_acc[d] = 0;
+                }
+                for (t_IndexType w = 0; w < l_width; w++) {
+#pragma HLS PIPELINE
+#pragma HLS DEPENDENCE variable = l_acc inter false
+                    t_DataType l_dot[1 << t_LogParEntries];
+#pragma HLS ARRAY_PARTITION variable = l_dot complete dim = 1
+                    WideType<t_DataType, 1 << t_LogParEntries> l_val = p_val.read();
+                    WideType<t_IndexType, 1 << t_LogParEntries> l_col = p_col.read();
+                    for (t_IndexType k = 0; k < l_parEntries; k++) {
+                        l_dot[k] = l_val[k] * l_x[k][l_col[k]];
+                    }
+                    l_acc[w & (l_delays - 1)] += BinarySum<t_DataType, 1 << t_LogParEntries>::sum(l_dot);
+                }
+                l_y[l_rowBegin + r] += BinarySum<t_DataType, l_delays>::sum(l_acc);
+            }
+        }
+    }
+
+    for (t_IndexType i = 0; i < (p_m >> t_LogParEntries); i++) {
+#pragma HLS PIPELINE
+        WideType<t_DataType, 1 << t_LogParEntries> l_yv = p_y.read();
+        for (t_IndexType k = 0; k < l_parEntries; k++) {
+            l_yv[k] += l_y[(i << t_LogParEntries) + k];
+        }
+        p_yr.write(l_yv);
+    }
+}
+
+/**
+ * @brief ellSpmm function that returns the result matrix Y = A * X + Y for a sparse matrix A in blocked-ELL format
+ * and dense matrices X and Y
+ *
+ * X and Y are processed in panels of t_ParEntries columns, and A is streamed once per panel.
+ * Each nonzero of A updates a whole row of the Y panel, so one nonzero is consumed per cycle.
+ * As in ellSpmv, the sums of a row rotate over AdderDelay<t_DataType>::m_Delays partial sums, which are reduced
+ * at the end of the row.
+ *
+ * @tparam t_DataType the data type of the matrix entries
+ * @tparam t_LogParEntries log2 of the number of parallelly processed entries
+ * @tparam t_MaxColBlock the maximum number of columns in a column block
+ * @tparam t_MaxRows the maximum number of rows in matrix A
+ * @tparam t_IndexType the datatype of the index
+ *
+ * @param p_m the number of rows in matrix A and Y, p_m % t_ParEntries == 0
+ * @param p_n the number of cols in matrix A, number of rows in X, p_n % t_ParEntries == 0
+ * @param p_k the number of cols in matrix X and Y, p_k % t_ParEntries == 0
+ * @param p_colBlock the number of cols in each column block, p_colBlock % t_ParEntries == 0
+ * @param p_sliceRows the number of rows in each slice
+ * @param p_width the input stream of row widths in words, one per slice and column block, repeated per panel
+ * @param p_val the input stream of packed matrix values, repeated per panel
+ * @param p_col the input stream of packed column indices, repeated per panel
+ * @param p_x the input stream of X rows, panel by panel
+ * @param p_y the input stream of Y rows, panel by panel
+ * @param p_yr the output stream of result rows, panel by panel
+ */
+template <typename t_DataType,
+          unsigned int t_LogParEntries,
+          unsigned int t_MaxColBlock,
+          unsigned int t_MaxRows,
+          typename t_IndexType = unsigned int>
+void ellSpmm(const unsigned int p_m,
+             const unsigned int p_n,
+             const unsigned int p_k,
+             const unsigned int p_colBlock,
+             const unsigned int p_sliceRows,
+             hls::stream<t_IndexType>& p_width,
+             hls::stream<WideType<t_DataType, 1 << t_LogParEntries> >& p_val,
+             hls::stream<WideType<t_IndexType, 1 << t_LogParEntries> >& p_col,
+             hls::stream<WideType<t_DataType, 1 << t_LogParEntries> >& p_x,
+             hls::stream<WideType<t_DataType, 1 << t_LogParEntries> >& p_y,
+             hls::stream<WideType<t_DataType, 1 << t_LogParEntries> >& p_yr) {
+    const unsigned int l_parEntries = 1 << t_LogParEntries;
+#ifndef __SYNTHESIS__
+    assert(p_m % l_parEntries == 0);
+    assert(p_n % l_parEntries == 0);
+    assert(p_k % l_parEntries == 0);
+    assert(p_colBlock % l_parEntries == 0);
+    assert(p_colBlock <= t_MaxColBlock);
+    assert(p_m <= t_MaxRows);
+#endif
+    WideType<t_DataType, 1 << t_LogParEntries> l_x[t_MaxColBlock];
+    WideType<t_DataType, 1 << t_LogParEntries> l_y[t_MaxRows];
+    const unsigned int l_delays = AdderDelay<t_DataType>::m_Delays;
+
+    const unsigned int l_numColBlocks = (p_n + p_colBlock - 1) / p_colBlock;
+    const unsigned int l_numSlices = (p_m + p_sliceRows - 1) / p_sliceRows;
+    for (t_IndexType j = 0; j < (p_k >> t_LogParEntries); j++) {
+        for (t_IndexType i = 0; i < p_m; i++) {
+#pragma HLS PIPELINE
+            l_y[i] = p_y.read();
+        }
+        for (t_IndexType b = 0; b < l_numColBlocks; b++) {
+            const unsigned int l_cols = (b == l_numColBlocks - 1) ? p_n - b * p_colBlock : p_colBlock;
+            for (t_IndexType i = 0; i < l_cols; i++) {
+#pragma HLS PIPELINE
+                l_x[i] = p_x.read();
+            }
+            for (t_IndexType s = 0; s < l_numSlices; s++) {
+                const unsigned int l_width = p_width.read();
+                const unsigned int l_rowBegin = s * p_sliceRows;
+                const unsigned int l_rows = (s == l_numSlices - 1) ? p_m - l_rowBegin : p_sliceRows;
+                for (t_IndexType r = 0; r < l_rows; r++) {
+                    // one partial row per adder stage, so that a nonzero is accumulated every cycle
+                    t_DataType l_acc[1 << t_LogParEntries][l_delays];
+#pragma HLS ARRAY_PARTITION variable = l_acc complete dim = 0
+                    for (t_IndexType d = 0; d < l_delays; d++) {
+#pragma HLS UNROLL
+                        for (t_IndexType k = 0; k < l_parEntries; k++) {
+                            l_acc[k][d] = 0;
+                        }
+                    }
+                    WideType<t_DataType, 1 << t_LogParEntries> l_val;
+                    WideType<t_IndexType, 1 << t_LogParEntries> l_col;
+                    for (t_IndexType t = 0; t < (l_width << t_LogParEntries); t++) {
+#pragma HLS PIPELINE
+#pragma HLS DEPENDENCE variable = l_acc inter false
+                        const unsigned int l_e = t & (l_parEntries - 1);
+                        if (l_e == 0) {
+                            l_val = p_val.read();
+                            l_col = p_col.read();
+                        }
+                        WideType<t_DataType, 1 << t_LogParEntries> l_xr = l_x[l_col[l_e]];
+                        for (t_IndexType k = 0; k < l_parEntries; k++) {
+                            l_acc[k][t & (l_delays - 1)] += l_val[l_e] * l_xr[k];
+                        }
+                    }
+                    for (t_IndexType k = 0; k < l_parEntries; k++) {
+#pragma HLS UNROLL
+                        l_y[l_rowBegin + r][k] += BinarySum<t_DataType, l_delays>::sum(l_acc[k]);
+                    }
+                }
+            }
+        }
+        for (t_IndexType i = 0; i < p_m; i++) {
+#pragma HLS PIPELINE
+            p_yr.write(l_y[i]);
+        }
+    }
+}
+
+} // end namespace blas
+
+} // end namespace xf
+
+#endif
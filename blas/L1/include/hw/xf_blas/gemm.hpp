@@ -21,7 +21,9 @@
 #error "BLAS Library only works with C++."
 #endif
 
+#include <limits>
 #include "ap_int.h"
+#include "hls_math.h"
 #include "hls_stream.h"
 #include "xf_blas/helpers.hpp"
 #include "scal.hpp"
@@ -63,8 +65,8 @@ class SystolicArray {
                 p_sum.write(l_Co[k - t_N]);
             }
 
-            WideType<t_DataType, t_M> l_A = 0;
-            WideType<t_DataType, t_N> l_B = 0;
+            WideType<t_DataType, t_M> l_A = WideType<t_DataType, t_M>::zero();
+            WideType<t_DataType, t_N> l_B = WideType<t_DataType, t_N>::zero();
 
             if (l < p_multi * p_k) {
                 l_A = p_As.read();
@@ -87,6 +89,112 @@ class SystolicArray {
     }
 };
 
+/**
+ * @brief activations of the GEMM epilogue, selected per instruction
+ */
+enum GemmActivation { GEMM_ACT_NONE = 0, GEMM_ACT_RELU = 1, GEMM_ACT_GELU = 2 };
+
+/**
+ * @brief GemmEpilogue computes one output entry from an accumulated sum and its bias
+ *
+ * Floating point sums are returned as act(sum + bias). Integer sums are requantized as
+ * act(sum + bias) * postScale >> postShift, rounded to nearest and saturated to t_OutDataType, with
+ * 0 <= postShift < 64.
+ * GELU on integers is evaluated on the requantized value.
+ *
+ * @tparam t_MacDataType the data type of the accumulated sums and bias
+ * @tparam t_OutDataType the data type of the outputs
+ */
+template <typename t_MacDataType,
+          typename t_OutDataType,
+          bool t_IsInteger = std::numeric_limits<t_MacDataType>::is_integer>
+class GemmEpilogue {
+   public:
+    static float gelu(float p_x) {
+        return 0.5f * p_x * (1.0f + hls::tanh(0.7978845608f * (p_x + 0.044715f * p_x * p_x * p_x)));
+    }
+    static t_OutDataType apply(
+        t_MacDataType p_sum, t_MacDataType p_bias, unsigned int p_activation, int p_postScale, int p_postShift) {
+        t_MacDataType l_val = p_sum + p_bias;
+        if (p_activation == GEMM_ACT_RELU) {
+            l_val = l_val < 0 ? t_MacDataType(0) : l_val;
+        } else if (p_activation == GEMM_ACT_GELU) {
+            l_val = gelu(l_val);
+        }
+        return t_OutDataType(l_val);
+    }
+};
+
+template <typename t_MacDataType, typename t_OutDataType>
+class GemmEpilogue<t_MacDataType, t_OutDataType, true> {
+   public:
+    static t_OutDataType apply(
+        t_MacDataType p_sum, t_MacDataType p_bias, unsigned int p_activation, int p_postScale, int p_postShift) {
+#ifndef __SYNTHESIS__
+        assert(p_postShift >= 0 && p_postShift < 64);
+#endif
+        int64_t l_val = int64_t(p_sum) + int64_t(p_bias);
+        if (p_activation == GEMM_ACT_RELU && l_val < 0) {
+            l_val = 0;
+        }
+        l_val *= p_postScale;
+        if (p_activation == GEMM_ACT_GELU) {
+            float l_x = float(l_val) / float(uint64_t(1) << p_postShift);
+            l_val = hls::round(GemmEpilogue<float, float>::gelu(l_x));
+        } else {
+            const int64_t l_half = p_postShift > 0 ? (int64_t(1) << (p_postShift - 1)) : 0;
+            l_val = (l_val + l_half) >> p_postShift;
+        }
+        const int64_t l_max = std::numeric_limits<t_OutDataType>::max();
+        const int64_t l_min = std::numeric_limits<t_OutDataType>::min();
+        return t_OutDataType(l_val > l_max ? l_max : (l_val < l_min ? l_min : l_val));
+    }
+};
+
+/**
+ * @brief gemmEpilogue function that adds the bias to the sums of SystolicArray, applies the activation and
+ * requantizes, so that no separate pass over C is needed
+ *
+ * @tparam t_MacDataType the data type of the accumulated sums and bias
+ * @tparam t_M the number of rows of each output block
+ * @tparam t_N the number of parallelly processed entries in each row
+ * @tparam t_OutDataType the data type of the outputs
+ *
+ * @param p_r the number of output blocks
+ * @param p_sum the input stream of sums, t_M words per block
+ * @param p_bias the input stream of bias, same shape as p_sum
+ * @param p_C the output stream
+ * @param p_activation one of GemmActivation
+ * @param p_postScale the requantization multiplier, integer sums only
+ * @param p_postShift the requantization right shift in [0, 64), integer sums only
+ */
+template <typename t_MacDataType, unsigned int t_M, unsigned int t_N, typename t_OutDataType>
+void gemmEpilogue(const unsigned int p_r,
+                  hls::stream<WideType<t_MacDataType, t_N> >& p_sum,
+                  hls::stream<WideType<t_MacDataType, t_N> >& p_bias,
+                  hls::stream<WideType<t_OutDataType, t_N> >& p_C,
+                  const unsigned int p_activation,
+                  const int p_postScale,
+                  const int p_postShift) {
+    for (unsigned int i = 0; i < p_r * t_M; i++) {
+#pragma HLS PIPELINE
+        WideType<t_MacDataType, t_N> l_sum = p_sum.read();
+        WideType<t_MacDataType, t_N> l_bias = p_bias.read();
+        WideType<t_OutDataType, t_N> l_out;
+        for (unsigned int n = 0; n < t_N; n++) {
+            l_out[n] = GemmEpilogue<t_MacDataType, t_OutDataType>::apply(l_sum[n], l_bias[n], p_activation,
+                                                                         p_postScale, p_postShift);
+        }
+        p_C.write(l_out);
+    }
+}
+
+/**
+ * @brief gemm function that streams the t_M x t_N output blocks of A * B
+ *
+ * Narrow inputs use a wider accumulator, e.g. t_DataType = int8_t with t_MacDataType = int32_t, or
+ * t_DataType = Bfloat16 with t_MacDataType = float.
+ */
 template <typename t_DataType,
           unsigned int t_M,
           unsigned int t_N = t_M,
@@ -101,6 +209,31 @@ void gemm(const unsigned int p_k,
     SystolicArray<t_DataType, t_M, t_N, t_MacDataType>::process_dsp(p_k, p_A, p_B, p_C, p_r);
 }
 
+/**
+ * @brief gemmFused function that streams act(A * B + bias), requantized to t_OutDataType, see gemmEpilogue
+ */
+template <typename t_DataType,
+          unsigned int t_M,
+          unsigned int t_N = t_M,
+          typename t_IndexType = unsigned int,
+          typename t_MacDataType = t_DataType,
+          typename t_OutDataType = t_DataType>
+void gemmFused(const unsigned int p_k,
+               hls::stream<WideType<t_DataType, t_M> >& p_A,
+               hls::stream<WideType<t_DataType, t_N> >& p_B,
+               hls::stream<WideType<t_MacDataType, t_N> >& p_bias,
+               hls::stream<WideType<t_OutDataType, t_N> >& p_C,
+               const unsigned int p_activation,
+               const int p_postScale,
+               const int p_postShift,
+               const unsigned int p_r = 1) {
+#pragma HLS DATAFLOW
+    hls::stream<WideType<t_MacDataType, t_N> > l_sum;
+    SystolicArray<t_DataType, t_M, t_N, t_MacDataType>::process_dsp(p_k, p_A, p_B, l_sum, p_r);
+    gemmEpilogue<t_MacDataType, t_M, t_N, t_OutDataType>(p_r, l_sum, p_bias, p_C, p_activation, p_postScale,
+                                                         p_postShift);
+}
+
 } // end namespace blas
 
 } // end namespace xf
@@ -251,6 +251,51 @@ class MemUtil {
    public:
     typedef WideType<t_FloatType, t_MemWidth> MemWideType;
 };
+
+/**
+ * @brief Bfloat16 is the upper half of an IEEE float, used as a compact input type of GEMM
+ *
+ * Products of two Bfloat16 values are returned as float, so SystolicArray<Bfloat16, t_M, t_N, float> multiplies
+ * in bfloat16 and accumulates in float.
+ */
+class Bfloat16 {
+   private:
+    uint16_t m_bits;
+
+    static uint32_t floatBits(float p_val) {
+        union {
+            float f;
+            uint32_t u;
+        } l_val;
+        l_val.f = p_val;
+        return l_val.u;
+    }
+
+   public:
+    Bfloat16() : m_bits(0) {}
+    // rounds to nearest even
+    Bfloat16(float p_val) {
+        uint32_t l_bits = floatBits(p_val);
+        if ((l_bits & 0x7fffffff) > 0x7f800000) {
+            m_bits = (l_bits >> 16) | 0x0040;
+        } else {
+            m_bits = (l_bits + 0x7fff + ((l_bits >> 16) & 1)) >> 16;
+        }
+    }
+    Bfloat16(int p_val) { *this = Bfloat16(float(p_val)); }
+
+    operator float() const {
+        union {
+            uint32_t u;
+            float f;
+        } l_val;
+        l_val.u = uint32_t(m_bits) << 16;
+        return l_val.f;
+    }
+
+    friend float operator*(const Bfloat16& p_a, const Bfloat16& p_b) { return float(p_a) * float(p_b); }
+};
+
 /////////////////////////    Control and helper types    /////////////////////////
 
 template <class T, uint8_t t_NumCycles>
@@ -0,0 +1,85 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "ap_int.h"
+#include "hls_stream.h"
+#include "xf_blas.hpp"
+#include "uut_top.hpp"
+
+using namespace xf::blas;
+
+// A is streamed once per panel of Y
+template <typename t_DataType, unsigned int t_ParEntries>
+void readPanels(unsigned int p_numPanels,
+                unsigned int p_n,
+                t_DataType* p_in,
+                hls::stream<WideType<t_DataType, t_ParEntries> >& p_out) {
+    for (unsigned int j = 0; j < p_numPanels; j++) {
+        for (unsigned int i = 0; i < p_n / t_ParEntries; i++) {
+#pragma HLS PIPELINE
+            WideType<t_DataType, t_ParEntries> l_val;
+            for (unsigned int k = 0; k < t_ParEntries; k++) {
+                l_val[k] = p_in[i * t_ParEntries + k];
+            }
+            p_out.write(l_val);
+        }
+    }
+}
+
+void readWidths(unsigned int p_numPanels, unsigned int p_numTiles, uint32_t* p_in, hls::stream<uint32_t>& p_out) {
+    for (unsigned int j = 0; j < p_numPanels; j++) {
+        for (unsigned int i = 0; i < p_numTiles; i++) {
+#pragma HLS PIPELINE
+            p_out.write(p_in[i]);
+        }
+    }
+}
+
+void uut_top(uint32_t p_m,
+             uint32_t p_n,
+             uint32_t p_k,
+             uint32_t p_colBlock,
+             uint32_t p_sliceRows,
+             uint32_t p_numWords,
+             uint32_t p_width[BLAS_maxTiles],
+             BLAS_dataType p_val[BLAS_maxWords * BLAS_parEntries],
+             uint32_t p_col[BLAS_maxWords * BLAS_parEntries],
+             BLAS_dataType p_x[BLAS_maxCols * BLAS_maxK],
+             BLAS_dataType p_y[BLAS_maxRows * BLAS_maxK],
+             BLAS_dataType p_yRes[BLAS_maxRows * BLAS_maxK]) {
+    hls::stream<uint32_t> l_strWidth;
+    hls::stream<WideType<BLAS_dataType, BLAS_parEntries> > l_strVal;
+#pragma HLS data_pack variable = l_strVal
+    hls::stream<WideType<uint32_t, BLAS_parEntries> > l_strCol;
+#pragma HLS data_pack variable = l_strCol
+    hls::stream<WideType<BLAS_dataType, BLAS_parEntries> > l_strX;
+#pragma HLS data_pack variable = l_strX
+    hls::stream<WideType<BLAS_dataType, BLAS_parEntries> > l_strY;
+#pragma HLS data_pack variable = l_strY
+    hls::stream<WideType<BLAS_dataType, BLAS_parEntries> > l_strYR;
+#pragma HLS data_pack variable = l_strYR
+#pragma HLS DATAFLOW
+    uint32_t l_numTiles = ((p_n + p_colBlock - 1) / p_colBlock) * ((p_m + p_sliceRows - 1) / p_sliceRows);
+    uint32_t l_numPanels = p_k / BLAS_parEntries;
+    readWidths(l_numPanels, l_numTiles, p_width, l_strWidth);
+    readPanels<BLAS_dataType, BLAS_parEntries>(l_numPanels, p_numWords * BLAS_parEntries, p_val, l_strVal);
+    readPanels<uint32_t, BLAS_parEntries>(l_numPanels, p_numWords * BLAS_parEntries, p_col, l_strCol);
+    readVec2Stream<BLAS_dataType, BLAS_parEntries>(p_x, p_n * p_k, l_strX);
+    readVec2Stream<BLAS_dataType, BLAS_parEntries>(p_y, p_m * p_k, l_strY);
+    ellSpmm<BLAS_dataType, BLAS_logParEntries, BLAS_maxColBlock, BLAS_maxRows>(p_m, p_n, p_k, p_colBlock, p_sliceRows,
+                                                                               l_strWidth, l_strVal, l_strCol, l_strX,
+                                                                               l_strY, l_strYR);
+    writeStream2Vec<BLAS_dataType, BLAS_parEntries>(l_strYR, p_m * p_k, p_yRes);
+}
@@ -0,0 +1,57 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "ap_int.h"
+#include "hls_stream.h"
+#include "xf_blas.hpp"
+#include "uut_top.hpp"
+
+using namespace xf::blas;
+
+void uut_top(uint32_t p_m,
+             uint32_t p_n,
+             uint32_t p_k,
+             uint32_t p_colBlock,
+             uint32_t p_sliceRows,
+             uint32_t p_numWords,
+             uint32_t p_width[BLAS_maxTiles],
+             BLAS_dataType p_val[BLAS_maxWords * BLAS_parEntries],
+             uint32_t p_col[BLAS_maxWords * BLAS_parEntries],
+             BLAS_dataType p_x[BLAS_maxCols * BLAS_maxK],
+             BLAS_dataType p_y[BLAS_maxRows * BLAS_maxK],
+             BLAS_dataType p_yRes[BLAS_maxRows * BLAS_maxK]) {
+    hls::stream<uint32_t> l_strWidth;
+    hls::stream<WideType<BLAS_dataType, BLAS_parEntries> > l_strVal;
+#pragma HLS data_pack variable = l_strVal
+    hls::stream<WideType<uint32_t, BLAS_parEntries> > l_strCol;
+#pragma HLS data_pack variable = l_strCol
+    hls::stream<WideType<BLAS_dataType, BLAS_parEntries> > l_strX;
+#pragma HLS data_pack variable = l_strX
+    hls::stream<WideType<BLAS_dataType, BLAS_parEntries> > l_strY;
+#pragma HLS data_pack variable = l_strY
+    hls::stream<WideType<BLAS_dataType, BLAS_parEntries> > l_strYR;
+#pragma HLS data_pack variable = l_strYR
+#pragma HLS DATAFLOW
+    uint32_t l_numTiles = ((p_n + p_colBlock - 1) / p_colBlock) * ((p_m + p_sliceRows - 1) / p_sliceRows);
+    mem2stream(l_numTiles, p_width, l_strWidth);
+    readVec2Stream<BLAS_dataType, BLAS_parEntries>(p_val, p_numWords * BLAS_parEntries, l_strVal);
+    readVec2Stream<uint32_t, BLAS_parEntries>(p_col, p_numWords * BLAS_parEntries, l_strCol);
+    readVec2Stream<BLAS_dataType, BLAS_parEntries>(p_x, p_n, l_strX);
+    readVec2Stream<BLAS_dataType, BLAS_parEntries>(p_y, p_m, l_strY);
+    ellSpmv<BLAS_dataType, BLAS_logParEntries, BLAS_maxColBlock, BLAS_maxRows>(p_m, p_n, p_colBlock, p_sliceRows,
+                                                                               l_strWidth, l_strVal, l_strCol, l_strX,
+                                                                               l_strY, l_strYR);
+    writeStream2Vec<BLAS_dataType, BLAS_parEntries>(l_strYR, p_m, p_yRes);
+}
@@ -0,0 +1,46 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "ap_int.h"
+#include "hls_stream.h"
+#include "xf_blas.hpp"
+#include "xf_blas/gemm.hpp"
+#include "uut_top.hpp"
+
+using namespace xf::blas;
+
+void uut_top(uint32_t p_activation,
+             int32_t p_postScale,
+             int32_t p_postShift,
+             BLAS_dataType p_a[BLAS_numBlocks * BLAS_k * BLAS_m],
+             BLAS_dataType p_b[BLAS_numBlocks * BLAS_k * BLAS_n],
+             BLAS_macDataType p_bias[BLAS_numBlocks * BLAS_m * BLAS_n],
+             BLAS_outDataType p_c[BLAS_numBlocks * BLAS_m * BLAS_n]) {
+    hls::stream<WideType<BLAS_dataType, BLAS_m> > l_strA;
+#pragma HLS data_pack variable = l_strA
+    hls::stream<WideType<BLAS_dataType, BLAS_n> > l_strB;
+#pragma HLS data_pack variable = l_strB
+    hls::stream<WideType<BLAS_macDataType, BLAS_n> > l_strBias;
+#pragma HLS data_pack variable = l_strBias
+    hls::stream<WideType<BLAS_outDataType, BLAS_n> > l_strC;
+#pragma HLS data_pack variable = l_strC
+#pragma HLS DATAFLOW
+    readVec2Stream<BLAS_dataType, BLAS_m>(p_a, BLAS_numBlocks * BLAS_k * BLAS_m, l_strA);
+    readVec2Stream<BLAS_dataType, BLAS_n>(p_b, BLAS_numBlocks * BLAS_k * BLAS_n, l_strB);
+    readVec2Stream<BLAS_macDataType, BLAS_n>(p_bias, BLAS_numBlocks * BLAS_m * BLAS_n, l_strBias);
+    gemmFused<BLAS_dataType, BLAS_m, BLAS_n, unsigned int, BLAS_macDataType, BLAS_outDataType>(
+        BLAS_k, l_strA, l_strB, l_strBias, l_strC, p_activation, p_postScale, p_postShift, BLAS_numBlocks);
+    writeStream2Vec<BLAS_outDataType, BLAS_n>(l_strC, BLAS_numBlocks * BLAS_m * BLAS_n, p_c);
+}
@@ -39,4 +39,29 @@ void uut_top(uint32_t p_m,
              BLAS_dataType p_aRes[BLAS_matrixSize],
              BLAS_dataType p_yRes[BLAS_matrixSize / BLAS_vectorSize]);
 #endif
+
+#if BLAS_SPARSE
+void uut_top(uint32_t p_m,
+             uint32_t p_n,
+             uint32_t p_k,
+             uint32_t p_colBlock,
+             uint32_t p_sliceRows,
+             uint32_t p_numWords,
+             uint32_t p_width[BLAS_maxTiles],
+             BLAS_dataType p_val[BLAS_maxWords * BLAS_parEntries],
+             uint32_t p_col[BLAS_maxWords * BLAS_parEntries],
+             BLAS_dataType p_x[BLAS_maxCols * BLAS_maxK],
+             BLAS_dataType p_y[BLAS_maxRows * BLAS_maxK],
+             BLAS_dataType p_yRes[BLAS_maxRows * BLAS_maxK]);
+#endif
+
+#if BLAS_GEMM_FUSED
+void uut_top(uint32_t p_activation,
+             int32_t p_postScale,
+             int32_t p_postShift,
+             BLAS_dataType p_a[BLAS_numBlocks * BLAS_k * BLAS_m],
+             BLAS_dataType p_b[BLAS_numBlocks * BLAS_k * BLAS_n],
+             BLAS_macDataType p_bias[BLAS_numBlocks * BLAS_m * BLAS_n],
+             BLAS_outDataType p_c[BLAS_numBlocks * BLAS_m * BLAS_n]);
+#endif
 #endif
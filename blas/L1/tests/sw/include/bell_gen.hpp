@@ -0,0 +1,105 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/**
+ *  @brief random CSR matrices and reference results for the tests of ellSpmv and ellSpmm,
+ *  the conversion to blocked-ELL is the one of the L3 library
+ */
+
+#ifndef BELL_GEN_HPP
+#define BELL_GEN_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "xf_blas/bell.hpp"
+
+namespace xf {
+
+namespace blas {
+
+/*
+ * Random CSR matrix with ragged rows of 0 to p_maxNnzRow entries, so that empty rows are included.
+ */
+template <typename t_DataType>
+void genCsr(unsigned int p_m,
+            unsigned int p_n,
+            unsigned int p_maxNnzRow,
+            std::vector<unsigned int>& p_rowPtr,
+            std::vector<unsigned int>& p_colIdx,
+            std::vector<t_DataType>& p_val) {
+    p_rowPtr.assign(1, 0);
+    p_colIdx.clear();
+    p_val.clear();
+    std::vector<unsigned int> l_cols(p_n);
+    for (unsigned int c = 0; c < p_n; c++) {
+        l_cols[c] = c;
+    }
+    for (unsigned int r = 0; r < p_m; r++) {
+        unsigned int l_nnz = rand() % (p_maxNnzRow + 1);
+        // every 7th row is empty
+        if (r % 7 == 3) {
+            l_nnz = 0;
+        }
+        for (unsigned int e = 0; e < l_nnz; e++) {
+            std::swap(l_cols[e], l_cols[e + rand() % (p_n - e)]);
+        }
+        std::sort(l_cols.begin(), l_cols.begin() + l_nnz);
+        for (unsigned int e = 0; e < l_nnz; e++) {
+            p_colIdx.push_back(l_cols[e]);
+            p_val.push_back((t_DataType)(rand() % 2048 - 1024) / 256);
+        }
+        p_rowPtr.push_back(p_colIdx.size());
+    }
+}
+
+// Y = A * X + Y with A in CSR, X and Y row-major with p_k cols
+template <typename t_DataType>
+void csrMmRef(unsigned int p_m,
+              unsigned int p_k,
+              const std::vector<unsigned int>& p_rowPtr,
+              const std::vector<unsigned int>& p_colIdx,
+              const std::vector<t_DataType>& p_val,
+              const std::vector<t_DataType>& p_x,
+              std::vector<t_DataType>& p_y) {
+    for (unsigned int r = 0; r < p_m; r++) {
+        for (unsigned int e = p_rowPtr[r]; e < p_rowPtr[r + 1]; e++) {
+            for (unsigned int c = 0; c < p_k; c++) {
+                p_y[r * p_k + c] += p_val[e] * p_x[p_colIdx[e] * p_k + c];
+            }
+        }
+    }
+}
+
+template <typename t_DataType>
+bool compareBell(unsigned int p_n, const t_DataType* p_res, const t_DataType* p_ref) {
+    bool l_ok = true;
+    for (unsigned int i = 0; i < p_n; i++) {
+        if (std::abs(p_res[i] - p_ref[i]) > 1e-3 * std::max<t_DataType>(1, std::abs(p_ref[i]))) {
+            std::cout << "Mismatch at " << i << ": " << p_res[i] << " != " << p_ref[i] << std::endl;
+            l_ok = false;
+        }
+    }
+    return l_ok;
+}
+
+} // namespace blas
+
+} // namespace xf
+
+#endif
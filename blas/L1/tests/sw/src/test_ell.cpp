@@ -0,0 +1,104 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <iostream>
+#include <vector>
+#include <cstdint>
+#include "bell_gen.hpp"
+#include "uut_top.hpp"
+
+using namespace xf::blas;
+
+/*
+ * Layout of a 3 x 6 matrix with parEntries 2, column blocks of 4 and slices of 2 rows
+ *   row 0: 1 2 3 . . 4   ragged, 3 entries in block 0 and 1 in block 1
+ *   row 1: . . . . . .   empty
+ *   row 2: . . . 5 . .
+ * Row 3 is padding, so is the second word of row 0 in block 0.
+ */
+bool testCsr2Bell() {
+    std::vector<unsigned int> l_rowPtr = {0, 4, 4, 5};
+    std::vector<unsigned int> l_colIdx = {0, 1, 2, 5, 3};
+    std::vector<float> l_val = {1, 2, 3, 4, 5};
+    BellMat<float> l_bell;
+    if (!csr2Bell(3, 6, l_rowPtr, l_colIdx, l_val, 2, 4, 2, l_bell)) {
+        std::cout << "csr2Bell failed" << std::endl;
+        return false;
+    }
+    std::vector<unsigned int> l_widthRef = {2, 1, 1, 0};
+    std::vector<float> l_valRef = {1, 2, 3, 0, 0, 0, 0, 0, 5, 0, 0, 0, 4, 0, 0, 0};
+    std::vector<unsigned int> l_colRef = {0, 1, 2, 0, 0, 0, 0, 0, 3, 0, 0, 0, 1, 0, 0, 0};
+    bool l_ok = l_bell.m_paddedRows == 4 && l_bell.m_paddedCols == 6 && l_bell.m_width == l_widthRef &&
+                l_bell.m_val == l_valRef && l_bell.m_col == l_colRef;
+
+    // a column index out of range is rejected
+    l_colIdx[4] = 6;
+    l_ok = l_ok && !csr2Bell(3, 6, l_rowPtr, l_colIdx, l_val, 2, 4, 2, l_bell);
+    if (!l_ok) {
+        std::cout << "csr2Bell layout mismatch" << std::endl;
+    }
+    return l_ok;
+}
+
+int main(int argc, char** argv) {
+    if (!testCsr2Bell()) {
+        return -1;
+    }
+
+    const unsigned int l_m = BLAS_m, l_n = BLAS_n, l_k = BLAS_maxK, l_par = BLAS_parEntries;
+    std::vector<unsigned int> l_rowPtr, l_colIdx;
+    std::vector<BLAS_dataType> l_val;
+    genCsr(l_m, l_n, BLAS_maxNnzRow, l_rowPtr, l_colIdx, l_val);
+    BellMat<BLAS_dataType> l_bell;
+    csr2Bell(l_m, l_n, l_rowPtr, l_colIdx, l_val, l_par, BLAS_colBlock, BLAS_sliceRows, l_bell);
+    unsigned int l_numWords = l_bell.m_val.size() / l_par;
+    if (l_bell.m_width.size() > BLAS_maxTiles || l_numWords > BLAS_maxWords || l_bell.m_paddedRows > BLAS_maxRows ||
+        l_bell.m_paddedCols > BLAS_maxCols) {
+        std::cout << "Test case exceeds the buffers of uut_top" << std::endl;
+        return -1;
+    }
+
+    // X and Y row-major for the reference, packed panel by panel of parEntries cols for the kernel
+    const unsigned int l_kPanel = l_k == 1 ? 1 : l_par;
+    std::vector<BLAS_dataType> l_x(l_n * l_k), l_y(l_m * l_k);
+    for (auto& v : l_x) v = (BLAS_dataType)(rand() % 512 - 256) / 64;
+    for (auto& v : l_y) v = (BLAS_dataType)(rand() % 512 - 256) / 64;
+    std::vector<BLAS_dataType> l_xPacked(BLAS_maxCols * BLAS_maxK, 0), l_yPacked(BLAS_maxRows * BLAS_maxK, 0);
+    std::vector<BLAS_dataType> l_yRes(BLAS_maxRows * BLAS_maxK, 0), l_yRef(BLAS_maxRows * BLAS_maxK, 0);
+    for (unsigned int c = 0; c < l_k; c++) {
+        for (unsigned int r = 0; r < l_n; r++) {
+            l_xPacked[((c / l_kPanel) * l_bell.m_paddedCols + r) * l_kPanel + c % l_kPanel] = l_x[r * l_k + c];
+        }
+        for (unsigned int r = 0; r < l_m; r++) {
+            l_yPacked[((c / l_kPanel) * l_bell.m_paddedRows + r) * l_kPanel + c % l_kPanel] = l_y[r * l_k + c];
+        }
+    }
+    csrMmRef(l_m, l_k, l_rowPtr, l_colIdx, l_val, l_x, l_y);
+    for (unsigned int c = 0; c < l_k; c++) {
+        for (unsigned int r = 0; r < l_m; r++) {
+            l_yRef[((c / l_kPanel) * l_bell.m_paddedRows + r) * l_kPanel + c % l_kPanel] = l_y[r * l_k + c];
+        }
+    }
+
+    uut_top(l_bell.m_paddedRows, l_bell.m_paddedCols, l_k, BLAS_colBlock, BLAS_sliceRows, l_numWords,
+            l_bell.m_width.data(), l_bell.m_val.data(), l_bell.m_col.data(), l_xPacked.data(), l_yPacked.data(),
+            l_yRes.data());
+
+    if (!compareBell(l_bell.m_paddedRows * l_k, l_yRes.data(), l_yRef.data())) {
+        return -1;
+    }
+    std::cout << "Test passed, " << l_rowPtr[l_m] << " nonzeros in " << l_numWords << " words" << std::endl;
+    return 0;
+}
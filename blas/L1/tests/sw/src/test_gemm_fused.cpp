@@ -0,0 +1,98 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <vector>
+#include "uut_top.hpp"
+
+/*
+ * C = sat(round(act(A * B + bias) * postScale / 2^postShift)) for each t_M x t_N block, where the block b of A is
+ * streamed as BLAS_k columns of BLAS_m entries, and of B as BLAS_k rows of BLAS_n entries.
+ */
+void gemmFusedRef(uint32_t p_activation,
+                  int32_t p_postScale,
+                  int32_t p_postShift,
+                  const std::vector<BLAS_dataType>& p_a,
+                  const std::vector<BLAS_dataType>& p_b,
+                  const std::vector<BLAS_macDataType>& p_bias,
+                  std::vector<BLAS_outDataType>& p_c,
+                  unsigned int& p_saturated) {
+    const double l_max = std::numeric_limits<BLAS_outDataType>::max();
+    const double l_min = std::numeric_limits<BLAS_outDataType>::min();
+    for (unsigned int b = 0; b < BLAS_numBlocks; b++) {
+        for (unsigned int m = 0; m < BLAS_m; m++) {
+            for (unsigned int n = 0; n < BLAS_n; n++) {
+                unsigned int l_idx = (b * BLAS_m + m) * BLAS_n + n;
+                double l_val = p_bias[l_idx];
+                for (unsigned int k = 0; k < BLAS_k; k++) {
+                    l_val += double(p_a[(b * BLAS_k + k) * BLAS_m + m]) * double(p_b[(b * BLAS_k + k) * BLAS_n + n]);
+                }
+                if (p_activation == 1 && l_val < 0) {
+                    l_val = 0;
+                }
+                l_val = std::floor(l_val * p_postScale / std::ldexp(1.0, p_postShift) + 0.5);
+                if (l_val > l_max || l_val < l_min) {
+                    p_saturated++;
+                    l_val = l_val > l_max ? l_max : l_min;
+                }
+                p_c[l_idx] = BLAS_outDataType(l_val);
+            }
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    const unsigned int l_sizeA = BLAS_numBlocks * BLAS_k * BLAS_m;
+    const unsigned int l_sizeB = BLAS_numBlocks * BLAS_k * BLAS_n;
+    const unsigned int l_sizeC = BLAS_numBlocks * BLAS_m * BLAS_n;
+    std::vector<BLAS_dataType> l_a(l_sizeA), l_b(l_sizeB);
+    std::vector<BLAS_macDataType> l_bias(l_sizeC);
+    for (auto& v : l_a) v = BLAS_dataType(rand() % 17 - 8);
+    for (auto& v : l_b) v = BLAS_dataType(rand() % 17 - 8);
+    for (auto& v : l_bias) v = BLAS_macDataType(rand() % 257 - 128);
+
+    // activation, postScale, postShift
+    const int l_cases[][3] = {{0, 1, 0}, {1, 1, 0}, {1, 3, 4}, {0, 5, 3}, {0, -7, 6}, {1, 1, 63}};
+    unsigned int l_saturated = 0;
+    bool l_ok = true;
+    for (auto& l_case : l_cases) {
+        std::vector<BLAS_outDataType> l_c(l_sizeC), l_cRef(l_sizeC);
+        gemmFusedRef(l_case[0], l_case[1], l_case[2], l_a, l_b, l_bias, l_cRef, l_saturated);
+        uut_top(l_case[0], l_case[1], l_case[2], l_a.data(), l_b.data(), l_bias.data(), l_c.data());
+        for (unsigned int i = 0; i < l_sizeC; i++) {
+            if (l_c[i] != l_cRef[i]) {
+                std::cout << "Mismatch for activation " << l_case[0] << ", postScale " << l_case[1] << ", postShift "
+                          << l_case[2] << " at " << i << ": " << int64_t(l_c[i]) << " != " << int64_t(l_cRef[i])
+                          << std::endl;
+                l_ok = false;
+                break;
+            }
+        }
+    }
+    // the cases without shift must have driven some outputs into saturation
+    if (l_saturated == 0) {
+        std::cout << "No output was saturated" << std::endl;
+        l_ok = false;
+    }
+    if (!l_ok) {
+        return -1;
+    }
+    std::cout << "Test passed, " << l_saturated << " outputs saturated" << std::endl;
+    return 0;
+}
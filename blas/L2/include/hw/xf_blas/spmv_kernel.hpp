@@ -0,0 +1,259 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file spmv_kernel.hpp
+ * @brief sparse engine of the L3 SPMV instructions, running ellSpmv or ellSpmm on blocked-ELL matrices in memory.
+ *
+ * This file is part of Vitis BLAS Library.
+ */
+
+#ifndef XF_BLAS_SPMV_KERNEL_HPP
+#define XF_BLAS_SPMV_KERNEL_HPP
+
+#include "ap_int.h"
+#include "hls_stream.h"
+#include "xf_blas.hpp"
+
+namespace xf {
+
+namespace blas {
+
+/**
+ * @brief SpmvInstr holds the fields of one SPMV instruction, in the order of SpmvArgs in the L3 host code
+ *
+ * Offsets are in pages of 4KB from the start of the memory of the kernel, page 0 holding the instructions.
+ */
+class SpmvInstr {
+   public:
+    static const unsigned int m_opControl = 0;
+    static const unsigned int m_opSpmv = 4;
+    static const unsigned int m_pageBytes = 4096;
+
+    unsigned int m_opType;
+    unsigned int m_widthPage, m_valPage, m_colPage, m_xPage, m_yPage;
+    unsigned int m_m, m_n, m_k, m_colBlock, m_sliceRows, m_numWords;
+
+    void load(const ap_uint<512>& p_word) {
+        m_opType = p_word.range(31, 0);
+        m_widthPage = p_word.range(63, 32);
+        m_valPage = p_word.range(95, 64);
+        m_colPage = p_word.range(127, 96);
+        m_xPage = p_word.range(159, 128);
+        m_yPage = p_word.range(191, 160);
+        m_m = p_word.range(223, 192);
+        m_n = p_word.range(255, 224);
+        m_k = p_word.range(287, 256);
+        m_colBlock = p_word.range(319, 288);
+        m_sliceRows = p_word.range(351, 320);
+        m_numWords = p_word.range(383, 352);
+    }
+};
+
+/**
+ * @brief spmvReadWidths reads the row widths of all tiles once per panel, t_ParEntries widths per memory word
+ *
+ * @param p_mem the memory of the kernel, p_page the page of the widths
+ * @param p_numTiles the number of tiles, p_numPanels the number of panels of X and Y
+ * @param p_width the output stream of widths
+ */
+template <unsigned int t_LogParEntries, typename t_IndexType>
+void spmvReadWidths(ap_uint<32 << t_LogParEntries>* p_mem,
+                    const unsigned int p_page,
+                    const unsigned int p_numTiles,
+                    const unsigned int p_numPanels,
+                    hls::stream<t_IndexType>& p_width) {
+    const unsigned int l_pageWords = SpmvInstr::m_pageBytes / (4 << t_LogParEntries);
+    ap_uint<32 << t_LogParEntries>* l_widths = p_mem + (unsigned long long)p_page * l_pageWords;
+    for (t_IndexType j = 0; j < p_numPanels; j++) {
+        ap_uint<32 << t_LogParEntries> l_word;
+        for (t_IndexType t = 0; t < p_numTiles; t++) {
+#pragma HLS PIPELINE
+            const unsigned int l_e = t & ((1 << t_LogParEntries) - 1);
+            if (l_e == 0) {
+                l_word = l_widths[t >> t_LogParEntries];
+            }
+            t_IndexType l_width = l_word.range(32 * l_e + 31, 32 * l_e);
+            p_width.write(l_width);
+        }
+    }
+}
+
+/**
+ * @brief spmvReadWords reads p_numWords consecutive memory words p_numPanels times
+ *
+ * @param p_mem the memory of the kernel, p_page the page of the first word
+ * @param p_numWords the number of words, p_numPanels the number of times they are read
+ * @param p_out the output stream of words
+ */
+template <typename t_DataType, unsigned int t_LogParEntries>
+void spmvReadWords(ap_uint<32 << t_LogParEntries>* p_mem,
+                   const unsigned int p_page,
+                   const unsigned int p_numWords,
+                   const unsigned int p_numPanels,
+                   hls::stream<WideType<t_DataType, 1 << t_LogParEntries> >& p_out) {
+    const unsigned int l_pageWords = SpmvInstr::m_pageBytes / (4 << t_LogParEntries);
+    ap_uint<32 << t_LogParEntries>* l_words = p_mem + (unsigned long long)p_page * l_pageWords;
+    for (unsigned int j = 0; j < p_numPanels; j++) {
+        for (unsigned int i = 0; i < p_numWords; i++) {
+#pragma HLS PIPELINE
+            WideType<t_DataType, 1 << t_LogParEntries> l_word(l_words[i]);
+            p_out.write(l_word);
+        }
+    }
+}
+
+/**
+ * @brief spmvWriteWords writes p_numWords consecutive memory words
+ *
+ * @param p_in the input stream of words
+ * @param p_numWords the number of words
+ * @param p_mem the memory of the kernel, p_page the page of the first word
+ */
+template <typename t_DataType, unsigned int t_LogParEntries>
+void spmvWriteWords(hls::stream<WideType<t_DataType, 1 << t_LogParEntries> >& p_in,
+                    const unsigned int p_numWords,
+                    const unsigned int p_page,
+                    ap_uint<32 << t_LogParEntries>* p_mem) {
+    const unsigned int l_pageWords = SpmvInstr::m_pageBytes / (4 << t_LogParEntries);
+    ap_uint<32 << t_LogParEntries>* l_words = p_mem + (unsigned long long)p_page * l_pageWords;
+    for (unsigned int i = 0; i < p_numWords; i++) {
+#pragma HLS PIPELINE
+        WideType<t_DataType, 1 << t_LogParEntries> l_word = p_in.read();
+        l_words[i] = l_word;
+    }
+}
+
+/**
+ * @brief spmvCompute runs ellSpmv for a vector X, that is p_k == 1, and ellSpmm otherwise
+ */
+template <typename t_DataType,
+          unsigned int t_LogParEntries,
+          unsigned int t_MaxColBlock,
+          unsigned int t_MaxRows,
+          typename t_IndexType>
+void spmvCompute(const unsigned int p_m,
+                 const unsigned int p_n,
+                 const unsigned int p_k,
+                 const unsigned int p_colBlock,
+                 const unsigned int p_sliceRows,
+                 hls::stream<t_IndexType>& p_width,
+                 hls::stream<WideType<t_DataType, 1 << t_LogParEntries> >& p_val,
+                 hls::stream<WideType<t_IndexType, 1 << t_LogParEntries> >& p_col,
+                 hls::stream<WideType<t_DataType, 1 << t_LogParEntries> >& p_x,
+                 hls::stream<WideType<t_DataType, 1 << t_LogParEntries> >& p_y,
+                 hls::stream<WideType<t_DataType, 1 << t_LogParEntries> >& p_yr) {
+    if (p_k == 1) {
+        ellSpmv<t_DataType, t_LogParEntries, t_MaxColBlock, t_MaxRows, t_IndexType>(
+            p_m, p_n, p_colBlock, p_sliceRows, p_width, p_val, p_col, p_x, p_y, p_yr);
+    } else {
+        ellSpmm<t_DataType, t_LogParEntries, t_MaxColBlock, t_MaxRows, t_IndexType>(
+            p_m, p_n, p_k, p_colBlock, p_sliceRows, p_width, p_val, p_col, p_x, p_y, p_yr);
+    }
+}
+
+/**
+ * @brief spmvRun runs one SPMV instruction, Y = A * X + Y
+ *
+ * The kernel ports p_memRd and p_memWr point to the same memory. The values, widths and X are read through p_memRd,
+ * and the column indices and Y are read and Y written through p_memWr, so that the two matrix streams get a port
+ * each. For p_k == 1 X and Y are vectors of p_n / t_ParEntries and p_m / t_ParEntries words, otherwise they are
+ * stored panel by panel, one word per row of a panel.
+ */
+template <typename t_DataType,
+          unsigned int t_LogParEntries,
+          unsigned int t_MaxColBlock,
+          unsigned int t_MaxRows,
+          typename t_IndexType>
+void spmvRun(const SpmvInstr& p_instr,
+             ap_uint<32 << t_LogParEntries>* p_memRd,
+             ap_uint<32 << t_LogParEntries>* p_memWr) {
+    const unsigned int l_numPanels = (p_instr.m_k == 1) ? 1 : (p_instr.m_k >> t_LogParEntries);
+    const unsigned int l_numTiles = ((p_instr.m_n + p_instr.m_colBlock - 1) / p_instr.m_colBlock) *
+                                    ((p_instr.m_m + p_instr.m_sliceRows - 1) / p_instr.m_sliceRows);
+    const unsigned int l_xWords = (p_instr.m_n >> t_LogParEntries) * p_instr.m_k;
+    const unsigned int l_yWords = (p_instr.m_m >> t_LogParEntries) * p_instr.m_k;
+
+    hls::stream<t_IndexType> l_strWidth;
+#pragma HLS STREAM variable = l_strWidth depth = 32
+    hls::stream<WideType<t_DataType, 1 << t_LogParEntries> > l_strVal;
+#pragma HLS data_pack variable = l_strVal
+#pragma HLS STREAM variable = l_strVal depth = 64
+    hls::stream<WideType<t_IndexType, 1 << t_LogParEntries> > l_strCol;
+#pragma HLS data_pack variable = l_strCol
+#pragma HLS STREAM variable = l_strCol depth = 64
+    hls::stream<WideType<t_DataType, 1 << t_LogParEntries> > l_strX;
+#pragma HLS data_pack variable = l_strX
+#pragma HLS STREAM variable = l_strX depth = 64
+    hls::stream<WideType<t_DataType, 1 << t_LogParEntries> > l_strY;
+#pragma HLS data_pack variable = l_strY
+#pragma HLS STREAM variable = l_strY depth = 64
+    hls::stream<WideType<t_DataType, 1 << t_LogParEntries> > l_strYR;
+#pragma HLS data_pack variable = l_strYR
+#pragma HLS STREAM variable = l_strYR depth = 64
+#pragma HLS DATAFLOW
+    spmvReadWidths<t_LogParEntries, t_IndexType>(p_memRd, p_instr.m_widthPage, l_numTiles, l_numPanels, l_strWidth);
+    spmvReadWords<t_DataType, t_LogParEntries>(p_memRd, p_instr.m_valPage, p_instr.m_numWords, l_numPanels,
+                                               l_strVal);
+    spmvReadWords<t_IndexType, t_LogParEntries>(p_memWr, p_instr.m_colPage, p_instr.m_numWords, l_numPanels,
+                                                l_strCol);
+    spmvReadWords<t_DataType, t_LogParEntries>(p_memRd, p_instr.m_xPage, l_xWords, 1, l_strX);
+    spmvReadWords<t_DataType, t_LogParEntries>(p_memWr, p_instr.m_yPage, l_yWords, 1, l_strY);
+    spmvCompute<t_DataType, t_LogParEntries, t_MaxColBlock, t_MaxRows, t_IndexType>(
+        p_instr.m_m, p_instr.m_n, p_instr.m_k, p_instr.m_colBlock, p_instr.m_sliceRows, l_strWidth, l_strVal,
+        l_strCol, l_strX, l_strY, l_strYR);
+    spmvWriteWords<t_DataType, t_LogParEntries>(l_strYR, l_yWords, p_instr.m_yPage, p_memWr);
+}
+
+/**
+ * @brief spmvProgram runs the SPMV instructions of page 0 in order, until a control instruction
+ *
+ * Each instruction takes one memory word of 512 bits, the layout of SpmvArgs in the L3 host code.
+ * Rows are partitioned over the kernels by the host, every kernel running on the rows stored in its own memory.
+ *
+ * @tparam t_DataType the data type of the matrix and vector entries, 32 bits wide
+ * @tparam t_LogParEntries log2 of the number of entries in a memory word, 4 for 512-bit words
+ * @tparam t_MaxColBlock the maximum number of columns in a column block
+ * @tparam t_MaxRows the maximum number of rows of an instruction
+ * @tparam t_IndexType the datatype of the column indices, 32 bits wide
+ *
+ * @param p_memRd the memory of the kernel, through the read port
+ * @param p_memWr the same memory, through the write port
+ */
+template <typename t_DataType,
+          unsigned int t_LogParEntries,
+          unsigned int t_MaxColBlock,
+          unsigned int t_MaxRows,
+          typename t_IndexType = unsigned int>
+void spmvProgram(ap_uint<32 << t_LogParEntries>* p_memRd, ap_uint<32 << t_LogParEntries>* p_memWr) {
+    static_assert((32 << t_LogParEntries) == 512, "instructions take one 512-bit memory word");
+    static_assert(sizeof(t_DataType) == 4 && sizeof(t_IndexType) == 4, "entries are packed 32 bits each");
+    const unsigned int l_numInstrs = SpmvInstr::m_pageBytes / (4 << t_LogParEntries);
+    for (unsigned int i = 0; i < l_numInstrs; i++) {
+        SpmvInstr l_instr;
+        l_instr.load(p_memRd[i]);
+        if (l_instr.m_opType != SpmvInstr::m_opSpmv) {
+            break;
+        }
+        spmvRun<t_DataType, t_LogParEntries, t_MaxColBlock, t_MaxRows, t_IndexType>(l_instr, p_memRd, p_memWr);
+    }
+}
+
+} // end namespace blas
+
+} // end namespace xf
+
+#endif
@@ -0,0 +1,150 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * usage: ./spmvTest.exe PATH_TO_XCLBIN/spmvKernel.xclbin PATH_TO/config_info.dat [numKernel [m n k]]
+ *
+ * Runs xfblasSpmv and xfblasSpmm on a random CSR matrix whose rows are spread over numKernel compute units,
+ * and compares them with a reference computed on the host.
+ */
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+#include "xf_blas.hpp"
+
+using namespace std;
+using namespace xf::blas;
+
+// Y = A * X + beta * Y on the host, X and Y row-major with k cols
+void spmmRef(int m,
+             int k,
+             const vector<int>& rowPtr,
+             const vector<int>& colIdx,
+             const vector<float>& val,
+             const vector<float>& x,
+             float beta,
+             vector<float>& y) {
+    for (int r = 0; r < m; r++) {
+        for (int c = 0; c < k; c++) {
+            float l_sum = 0;
+            for (int e = rowPtr[r]; e < rowPtr[r + 1]; e++) {
+                l_sum += val[e] * x[IDX2R(colIdx[e], c, k)];
+            }
+            y[IDX2R(r, c, k)] = l_sum + beta * y[IDX2R(r, c, k)];
+        }
+    }
+}
+
+int compare(const vector<float>& p_ref, const vector<float>& p_res) {
+    int l_errs = 0;
+    for (unsigned int i = 0; i < p_ref.size(); i++) {
+        if (fabs(p_ref[i] - p_res[i]) > 1e-3 * (1 + fabs(p_ref[i]))) {
+            if (l_errs < 10) {
+                cout << "mismatch at " << i << ": " << p_res[i] << " != " << p_ref[i] << "\n";
+            }
+            l_errs++;
+        }
+    }
+    return l_errs;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        cerr << " usage: \n"
+             << " spmvTest.exe spmvKernel.xclbin config_info.dat [numKernel [m n k]]\n";
+        return EXIT_FAILURE;
+    }
+    unsigned int l_argIdx = 1;
+    string l_xclbinFile(argv[l_argIdx++]);
+    string l_configFile(argv[l_argIdx++]);
+    unsigned int l_numKernel = 4;
+    int m = 10000, n = 5000, k = 20;
+    if (argc > 3) {
+        l_numKernel = stoi(argv[l_argIdx++]);
+    }
+    if (argc > 6) {
+        m = stoi(argv[l_argIdx++]);
+        n = stoi(argv[l_argIdx++]);
+        k = stoi(argv[l_argIdx++]);
+    }
+
+    xfblasStatus_t l_status = xfblasCreate(l_xclbinFile.c_str(), l_configFile, XFBLAS_ENGINE_SPMV, l_numKernel);
+    if (l_status != XFBLAS_STATUS_SUCCESS) {
+        cout << "Create Handle failed with error code: " << l_status << "\n";
+        return EXIT_FAILURE;
+    }
+
+    // rows of 0 to 31 nonzeros, so that the chunks of the kernels hold different numbers of rows
+    srand(1);
+    vector<int> l_rowPtr(1, 0), l_colIdx;
+    vector<float> l_val;
+    for (int r = 0; r < m; r++) {
+        int l_nnz = rand() % 32;
+        for (int e = 0; e < l_nnz; e++) {
+            l_colIdx.push_back(rand() % n);
+            l_val.push_back((float)(rand() % 256 - 128) / 64);
+        }
+        l_rowPtr.push_back(l_colIdx.size());
+    }
+    vector<float> l_x(n * k), l_y(m * k);
+    for (auto& l_v : l_x) {
+        l_v = (float)(rand() % 256 - 128) / 64;
+    }
+    for (auto& l_v : l_y) {
+        l_v = (float)(rand() % 256 - 128) / 64;
+    }
+
+    xfblasSpMat<float> l_a;
+    l_status = xfblasCreateSpMatCsr(&l_a, m, n, l_rowPtr.data(), l_colIdx.data(), l_val.data(), l_numKernel);
+    if (l_status != XFBLAS_STATUS_SUCCESS) {
+        cout << "Create sparse matrix failed with error code: " << l_status << "\n";
+        xfblasDestroy();
+        return EXIT_FAILURE;
+    }
+
+    int l_errs = 0;
+    vector<float> l_ref(l_y.begin(), l_y.begin() + m), l_res = l_ref;
+    spmmRef(m, 1, l_rowPtr, l_colIdx, l_val, l_x, 0.5, l_ref);
+    l_status = xfblasSpmv(l_a, 1.0f, l_x.data(), 0.5f, l_res.data());
+    if (l_status != XFBLAS_STATUS_SUCCESS) {
+        cout << "Spmv failed with error code: " << l_status << "\n";
+        l_errs++;
+    } else {
+        l_errs += compare(l_ref, l_res);
+    }
+
+    l_ref = l_y;
+    l_res = l_y;
+    spmmRef(m, k, l_rowPtr, l_colIdx, l_val, l_x, 0.5, l_ref);
+    l_status = xfblasSpmm(l_a, k, 1.0f, l_x.data(), k, 0.5f, l_res.data(), k);
+    if (l_status != XFBLAS_STATUS_SUCCESS) {
+        cout << "Spmm failed with error code: " << l_status << "\n";
+        l_errs++;
+    } else {
+        l_errs += compare(l_ref, l_res);
+    }
+
+    xfblasDestroySpMat(&l_a);
+    xfblasDestroy();
+    if (l_errs != 0) {
+        cout << "Test failed, " << l_errs << " errors\n";
+        return EXIT_FAILURE;
+    }
+    cout << "Test passed, " << l_rowPtr[m] << " nonzeros on " << l_numKernel << " kernels\n";
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,26 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __KERNEL_CONFIG_HPP_
+#define __KERNEL_CONFIG_HPP_
+
+// must match config_info.dat, which the L3 host reads
+#define GEMX_dataType float
+#define GEMX_logDdrWidth 4
+#define GEMX_spmvColBlock 2048
+#define GEMX_spmvMaxRows 4096
+
+#endif
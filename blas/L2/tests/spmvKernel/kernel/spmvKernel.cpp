@@ -0,0 +1,53 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ *
+ * @file spmvKernel.cpp
+ * @brief kernel code of the sparse engine, selected with XFBLAS_ENGINE_SPMV in L3.
+ * This file is part of Vitis BLAS Library.
+ *
+ * @detail Both ports get the base address of the memory of the compute unit, with the instructions in page 0.
+ * Their register offsets are those of the GEMX kernels, so the L3 host starts this kernel the same way.
+ *
+ */
+
+#include <ap_int.h>
+#include <hls_stream.h>
+#include "xf_blas/spmv_kernel.hpp"
+
+#include "kernel_config.hpp"
+
+// @brief top of kernel
+extern "C" void spmvKernel(ap_uint<512>* p_DdrRd, ap_uint<512>* p_DdrWr) {
+// clang-format off
+#pragma HLS INTERFACE m_axi offset = slave latency = 64 \
+	num_write_outstanding = 16 num_read_outstanding = 16 \
+	max_write_burst_length = 64 max_read_burst_length = 64 \
+	bundle = gmemRd port = p_DdrRd
+
+#pragma HLS INTERFACE m_axi offset = slave latency = 64 \
+	num_write_outstanding = 16 num_read_outstanding = 16 \
+	max_write_burst_length = 64 max_read_burst_length = 64 \
+	bundle = gmemWr port = p_DdrWr
+// clang-format on
+
+#pragma HLS INTERFACE s_axilite port = p_DdrRd bundle = control
+#pragma HLS INTERFACE s_axilite port = p_DdrWr bundle = control
+#pragma HLS INTERFACE s_axilite port = return bundle = control
+
+    xf::blas::spmvProgram<GEMX_dataType, GEMX_logDdrWidth, GEMX_spmvColBlock, GEMX_spmvMaxRows>(p_DdrRd, p_DdrWr);
+}
@@ -0,0 +1,159 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * usage: ./gemm_tiled_bench.exe PATH_TO_XCLBIN/gemx.xclbin PATH_TO_XCLBIN/config_info.dat m k n data_dir tileM tileK
+ * tileN numKernel
+ *
+ * Matrices are kept in the host memory, and streamed to the device tile by tile with xfblasGemmTiled.
+ */
+
+#include <string>
+#include <cmath>
+#include <iomanip>
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <assert.h>
+#include <fstream>
+
+#include "xf_blas.hpp"
+#include "../bench_helper.hpp"
+#include "gemm_helper.hpp"
+
+using namespace std;
+
+void readBin(char* mat, unsigned int row, unsigned int col, string dataDir, string name, unsigned int eleSize) {
+    ifstream inFile;
+    inFile.open(dataDir + name + to_string(row) + "_" + to_string(col) + ".bin", ifstream::binary);
+    if (inFile.is_open()) {
+        inFile.read((char*)mat, eleSize * row * col);
+        inFile.close();
+    } else {
+        cerr << "Could not find " << (dataDir + name + to_string(row) + "_" + to_string(col) + ".bin") << endl;
+        exit(1);
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        cerr << " usage: \n"
+             << " gemm_tiled_bench.exe gemx.xclbin config_info.dat m k n data_dir tileM tileK tileN numKernel\n"
+             << " gemm_tiled_bench.exe gemx.xclbin config_info.dat\n";
+        return EXIT_FAILURE;
+    }
+    unsigned int l_argIdx = 1;
+    string l_xclbinFile(argv[l_argIdx++]);
+    string l_configFile(argv[l_argIdx++]);
+    int m = 1024;
+    int k = 1024;
+    int n = 1024;
+
+    if (argc >= 6) {
+        m = stoi(argv[l_argIdx++]);
+        k = stoi(argv[l_argIdx++]);
+        n = stoi(argv[l_argIdx++]);
+        cout << "Read custom sizes of matrix: (" << m << ", " << k << ", " << n << ")\n";
+    }
+
+    string data_dir("./data/float/");
+    if (argc >= 7) {
+        data_dir = (string)argv[l_argIdx++];
+        cout << "Read custom data directory: " << data_dir << endl;
+    }
+
+    int tileM = 512;
+    int tileK = 512;
+    int tileN = 512;
+    if (argc >= 10) {
+        tileM = stoi(argv[l_argIdx++]);
+        tileK = stoi(argv[l_argIdx++]);
+        tileN = stoi(argv[l_argIdx++]);
+        cout << "Read custom sizes of tile: (" << tileM << ", " << tileK << ", " << tileN << ")\n";
+    }
+
+    int l_numKernel = 1;
+    if (argc >= 11) {
+        l_numKernel = stoi(argv[l_argIdx++]);
+        cout << "Read custom kernel number: " << l_numKernel << endl;
+    }
+
+    XFBLAS_dataType *a, *b, *c, *goldenC;
+    posix_memalign((void**)&a, 4096, (size_t)m * k * sizeof(XFBLAS_dataType));
+    posix_memalign((void**)&b, 4096, (size_t)k * n * sizeof(XFBLAS_dataType));
+    posix_memalign((void**)&c, 4096, (size_t)m * n * sizeof(XFBLAS_dataType));
+    posix_memalign((void**)&goldenC, 4096, (size_t)m * n * sizeof(XFBLAS_dataType));
+    readBin((char*)a, m, k, data_dir, "matA_in_", sizeof(XFBLAS_dataType));
+    readBin((char*)b, k, n, data_dir, "matB_in_", sizeof(XFBLAS_dataType));
+    readBin((char*)c, m, n, data_dir, "matC_in_", sizeof(XFBLAS_dataType));
+    readBin((char*)goldenC, m, n, data_dir, "matC_out_", sizeof(XFBLAS_dataType));
+
+    TimePointType l_tp_start_time;
+    TimePointType l_tp_create_time;
+    l_tp_start_time = chrono::high_resolution_clock::now();
+    xfblasEngine_t engineName = XFBLAS_ENGINE_GEMM;
+    xfblasStatus_t status = xfblasCreate(l_xclbinFile.c_str(), l_configFile, engineName, l_numKernel);
+
+    showTimeData("xfblasCreate", l_tp_start_time, l_tp_create_time);
+
+    TimePointType l_tp_loop[2];
+    l_tp_loop[0] = chrono::high_resolution_clock::now();
+    status = xfblasGemmTiled(m, n, k, a, k, b, n, c, n, tileM, tileN, tileK, l_numKernel);
+    showTimeData("xfblasGemmTiled", l_tp_loop[0], l_tp_loop[1]);
+
+    if (status != XFBLAS_STATUS_SUCCESS) {
+        cout << "xfblasGemmTiled failed with status " << status << endl;
+        xfblasDestroy(l_numKernel);
+        return EXIT_FAILURE;
+    }
+
+    chrono::duration<double> l_timeApi = l_tp_loop[1] - l_tp_loop[0];
+    double l_timeMs = l_timeApi.count() * 1e3;
+
+    cout << "Api time is " << fixed << setprecision(6) << l_timeMs << " msec\n";
+
+    unordered_map<string, string> l_configDict;
+
+    readConfigDict(l_configFile, &l_configDict);
+
+    float l_freq = getBoardFreqMHz(l_xclbinFile);
+    int GEMX_ddrWidth = stoi(l_configDict["GEMX_ddrWidth"]);
+    unsigned long int l_Ops = 2ull * m * k * n;
+
+    double l_perfApiInGflops = l_Ops / (l_timeMs * 1e-3) / 1e9;
+    double l_timeMsAt100pctEff = l_Ops / 2 / GEMX_ddrWidth / GEMX_ddrWidth / (l_freq * 1e6) * 1e3 / l_numKernel;
+    double l_effApiPct = 100 * l_timeMsAt100pctEff / l_timeMs;
+
+    cout << std::string("DATA_CSV:,Freq,M,K,N,TileM,TileK,TileN,Kernels,") + "TimeApiMs," + "EffApiPct,PerfApiGflops\n";
+    cout << "DATA_CSV:," << l_freq << "," << m << "," << k << "," << n << "," << tileM << "," << tileK << "," << tileN
+         << "," << l_numKernel << "," << l_timeMs << "," << l_effApiPct << "," << l_perfApiInGflops << "\n";
+
+    bool l_pass = compareGemm(c, goldenC, m, n);
+    if (l_pass) {
+        cout << "Test passed!\n";
+    } else {
+        cout << "Test failed!\n";
+    }
+
+    free(a);
+    free(b);
+    free(c);
+    free(goldenC);
+
+    xfblasDestroy(l_numKernel);
+
+    return l_pass ? EXIT_SUCCESS : EXIT_FAILURE;
+}
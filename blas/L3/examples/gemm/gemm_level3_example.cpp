@@ -0,0 +1,154 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/*
+ * usage: ./gemm_level3_example.exe PATH_TO_XCLBIN/gemx.xclbin PATH_TO_XCLBIN/config_info.dat
+ *
+ */
+
+#include <iomanip>
+#include <cmath>
+#include <vector>
+#include "xf_blas.hpp"
+
+#define IDX2R(i, j, ld) (((i) * (ld)) + (j))
+// larger than XFBLAS_LEVEL3_BLOCK_SIZE, so that both routines run over several blocks
+#define n 600 // rows and cols of the triangular and the symmetric matrices
+#define k 300 // cols of the SYRK operand, and of the TRSM right-hand side
+
+using namespace std;
+
+// C = A * A^T + C on the lower triangle, A is n x k, the upper triangle of C is left as it is
+int runSyrk() {
+    vector<XFBLAS_dataType> a(n * k), c(n * n), goldenC(n * n);
+    for (int i = 0; i < n * k; i++) {
+        a[i] = (XFBLAS_dataType)(i % 4);
+    }
+    for (int i = 0; i < n * n; i++) {
+        c[i] = (XFBLAS_dataType)(i % 3);
+    }
+    for (int row = 0; row < n; row++) {
+        for (int col = 0; col < n; col++) {
+            XFBLAS_dataType l_val = c[IDX2R(row, col, n)];
+            if (col <= row) {
+                for (int i = 0; i < k; i++) {
+                    l_val += a[IDX2R(row, i, k)] * a[IDX2R(col, i, k)];
+                }
+            }
+            goldenC[IDX2R(row, col, n)] = l_val;
+        }
+    }
+
+    xfblasStatus_t status =
+        xfblasSyrk(XFBLAS_FILL_MODE_LOWER, XFBLAS_OP_N, n, k, (XFBLAS_dataType)1, a.data(), k, (XFBLAS_dataType)1,
+                   c.data(), n);
+    if (status != XFBLAS_STATUS_SUCCESS) {
+        cout << "SYRK failed with error code: " << status << "\n";
+        return 1;
+    }
+
+    int l_err = 0;
+    for (int i = 0; i < n * n; i++) {
+        if (c[i] != goldenC[i]) {
+            if (l_err < 10) {
+                cout << "SYRK golden result " << goldenC[i] << " is not equal to fpga result " << c[i] << " at row "
+                     << i / n << " col " << i % n << "\n";
+            }
+            l_err++;
+        }
+    }
+    return l_err;
+}
+
+// solves A X = B for lower triangular A, with B = A * X built from a known X
+int runTrsm() {
+    vector<XFBLAS_dataType> a(n * n, 0), x(n * k), b(n * k);
+    for (int row = 0; row < n; row++) {
+        for (int col = 0; col < row; col++) {
+            a[IDX2R(row, col, n)] = (XFBLAS_dataType)((row + col) % 5) / 8;
+        }
+        // diagonally dominant, so that the solve is well conditioned
+        a[IDX2R(row, row, n)] = (XFBLAS_dataType)(n / 4 + row % 7);
+    }
+    for (int i = 0; i < n * k; i++) {
+        x[i] = (XFBLAS_dataType)(i % 9) - 4;
+    }
+    for (int row = 0; row < n; row++) {
+        for (int col = 0; col < k; col++) {
+            XFBLAS_dataType l_val = 0;
+            for (int i = 0; i <= row; i++) {
+                l_val += a[IDX2R(row, i, n)] * x[IDX2R(i, col, k)];
+            }
+            b[IDX2R(row, col, k)] = l_val;
+        }
+    }
+
+    xfblasStatus_t status = xfblasTrsm(XFBLAS_SIDE_LEFT, XFBLAS_FILL_MODE_LOWER, XFBLAS_OP_N, XFBLAS_DIAG_NON_UNIT, n,
+                                       k, (XFBLAS_dataType)1, a.data(), n, b.data(), k);
+    if (status == XFBLAS_STATUS_NOT_SUPPORTED) {
+        // the kernel is not built for float
+        cout << "TRSM is skipped, it needs a kernel of float data type\n";
+        return 0;
+    }
+    if (status != XFBLAS_STATUS_SUCCESS) {
+        cout << "TRSM failed with error code: " << status << "\n";
+        return 1;
+    }
+
+    int l_err = 0;
+    for (int i = 0; i < n * k; i++) {
+        double l_diff = fabs((double)b[i] - (double)x[i]);
+        if (l_diff > 1e-3 * (1 + fabs((double)x[i]))) {
+            if (l_err < 10) {
+                cout << "TRSM golden result " << x[i] << " is not equal to fpga result " << b[i] << " at row " << i / k
+                     << " col " << i % k << "\n";
+            }
+            l_err++;
+        }
+    }
+    return l_err;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        cerr << " usage: \n"
+             << " gemm_level3_example.exe gemx.xclbin config_info.dat\n";
+        return EXIT_FAILURE;
+    }
+    unsigned int l_argIdx = 1;
+    string l_xclbinFile(argv[l_argIdx++]);
+    string l_configFile(argv[l_argIdx++]);
+
+    xfblasEngine_t engineName = XFBLAS_ENGINE_GEMM;
+    xfblasStatus_t status = xfblasCreate(l_xclbinFile.c_str(), l_configFile, engineName);
+    if (status != XFBLAS_STATUS_SUCCESS) {
+        cout << "Create Handle failed with error code: " << status << "\n";
+        return EXIT_FAILURE;
+    }
+
+    int l_err = runSyrk();
+    l_err += runTrsm();
+    if (l_err == 0) {
+        cout << "Test passed!\n";
+    } else {
+        cout << "Test failed! " << l_err << " mismatches\n";
+    }
+
+    xfblasDestroy();
+
+    return l_err == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,157 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * usage: ./gemm_strided_batched_example.exe PATH_TO_XCLBIN/gemx.xclbin PATH_TO_XCLBIN/config_info.dat
+ *
+ */
+
+#include <iomanip>
+#include <cmath>
+#include "xf_blas.hpp"
+
+#define IDX2R(i, j, ld) (((i) * (ld)) + (j))
+#define m 128     // a - mxk matrix
+#define n 128     // b - kxn matrix
+#define k 128     // c - mxn matrix
+#define batch 16  // number of GEMMs
+
+using namespace std;
+
+void getGoldenMat(XFBLAS_dataType* a, XFBLAS_dataType* b, XFBLAS_dataType* c, XFBLAS_dataType* goldenC) {
+    for (int row = 0; row < m; row++) {
+        for (int col = 0; col < n; col++) {
+            XFBLAS_dataType l_val = 0;
+            for (int i = 0; i < k; i++) {
+                l_val += a[IDX2R(row, i, k)] * b[IDX2R(i, col, n)];
+            }
+            goldenC[IDX2R(row, col, n)] = l_val + c[IDX2R(row, col, n)];
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        cerr << " usage: \n"
+             << " gemm_strided_batched_example.exe gemx.xclbin config_info.dat\n";
+        return EXIT_FAILURE;
+    }
+    unsigned int l_argIdx = 1;
+    string l_xclbinFile(argv[l_argIdx++]);
+    string l_configFile(argv[l_argIdx++]);
+
+    xfblasEngine_t engineName = XFBLAS_ENGINE_GEMM;
+    xfblasStatus_t status = xfblasCreate(l_xclbinFile.c_str(), l_configFile, engineName);
+    if (status != XFBLAS_STATUS_SUCCESS) {
+        cout << "Create Handle failed with error code: " << status << "\n";
+        return EXIT_FAILURE;
+    }
+
+    // all A, B and C of the batch are stored back to back
+    const long long strideA = m * k;
+    const long long strideB = k * n;
+    const long long strideC = m * n;
+    XFBLAS_dataType *a, *b, *c, *goldenC;
+    posix_memalign((void**)&a, 4096, batch * strideA * sizeof(XFBLAS_dataType));
+    posix_memalign((void**)&b, 4096, batch * strideB * sizeof(XFBLAS_dataType));
+    posix_memalign((void**)&c, 4096, batch * strideC * sizeof(XFBLAS_dataType));
+    goldenC = (XFBLAS_dataType*)malloc(batch * strideC * sizeof(XFBLAS_dataType));
+
+    for (int g = 0; g < batch; g++) {
+        for (int i = 0; i < m * k; i++) {
+            a[g * strideA + i] = (XFBLAS_dataType)((i + g) % 7);
+        }
+        for (int i = 0; i < k * n; i++) {
+            b[g * strideB + i] = (XFBLAS_dataType)((i * 3 + g) % 5);
+        }
+        for (int i = 0; i < m * n; i++) {
+            c[g * strideC + i] = 0;
+        }
+        getGoldenMat(a + g * strideA, b + g * strideB, c + g * strideC, goldenC + g * strideC);
+    }
+
+    status = xfblasMallocRestricted(batch * m, k, sizeof(*a), a, k);
+    if (status != XFBLAS_STATUS_SUCCESS) {
+        cout << "Malloc memory for matrix A failed with error code: " << status << "\n";
+        xfblasDestroy();
+        return EXIT_FAILURE;
+    }
+    status = xfblasMallocRestricted(batch * k, n, sizeof(*b), b, n);
+    if (status != XFBLAS_STATUS_SUCCESS) {
+        cout << "Malloc memory for matrix B failed with error code: " << status << "\n";
+        xfblasDestroy();
+        return EXIT_FAILURE;
+    }
+    status = xfblasMallocRestricted(batch * m, n, sizeof(*c), c, n);
+    if (status != XFBLAS_STATUS_SUCCESS) {
+        cout << "Malloc memory for matrix C failed with error code: " << status << "\n";
+        xfblasDestroy();
+        return EXIT_FAILURE;
+    }
+
+    xfblasSetMatrixRestricted(a);
+    xfblasSetMatrixRestricted(b);
+    status = xfblasSetMatrixRestricted(c);
+    if (status != XFBLAS_STATUS_SUCCESS) {
+        cout << "Set Matrix failed with error code: " << status << "\n";
+        xfblasDestroy();
+        return EXIT_FAILURE;
+    }
+
+    // one instruction per GEMM, one kernel start for the whole batch
+    status = xfblasGemmStridedBatched(XFBLAS_OP_N, XFBLAS_OP_N, m, n, k, 1, a, k, strideA, b, n, strideB, 1, c, n,
+                                      strideC, batch);
+    if (status != XFBLAS_STATUS_SUCCESS) {
+        cout << "Batched Matrix Multiplication failed with error code: " << status << "\n";
+        xfblasDestroy();
+        return EXIT_FAILURE;
+    }
+
+    status = xfblasGetMatrixRestricted(c);
+    if (status != XFBLAS_STATUS_SUCCESS) {
+        cout << "Get Matrix failed with error code: " << status << "\n";
+        xfblasDestroy();
+        return EXIT_FAILURE;
+    }
+
+    int l_err = 0;
+    for (int i = 0; i < batch * strideC; i++) {
+        if (c[i] != goldenC[i]) {
+            if (l_err < 10) {
+                cout << "golden result " << goldenC[i] << " is not equal to fpga result " << c[i] << " in GEMM "
+                     << i / strideC << "\n";
+            }
+            l_err++;
+        }
+    }
+    if (l_err == 0) {
+        cout << "Test passed!\n";
+    } else {
+        cout << "Test failed! " << l_err << " mismatches\n";
+    }
+
+    xfblasFree(a);
+    xfblasFree(b);
+    xfblasFree(c);
+    free(a);
+    free(b);
+    free(c);
+    free(goldenC);
+
+    xfblasDestroy();
+
+    return l_err == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
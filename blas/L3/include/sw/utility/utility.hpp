@@ -36,10 +36,19 @@ typedef enum {
     XFBLAS_STATUS_INVALID_PROGRAM  // 9
 } xfblasStatus_t;
 
-typedef enum { XFBLAS_ENGINE_GEMM, XFBLAS_ENGINE_GEMV } xfblasEngine_t;
+typedef enum { XFBLAS_ENGINE_GEMM, XFBLAS_ENGINE_GEMV, XFBLAS_ENGINE_SPMV } xfblasEngine_t;
 
 typedef enum { XFBLAS_OP_N, XFBLAS_OP_T, XFBLAS_OP_C } xfblasOperation_t;
 
+typedef enum { XFBLAS_FILL_MODE_LOWER, XFBLAS_FILL_MODE_UPPER } xfblasFillMode_t;
+
+typedef enum { XFBLAS_SIDE_LEFT, XFBLAS_SIDE_RIGHT } xfblasSideMode_t;
+
+typedef enum { XFBLAS_DIAG_NON_UNIT, XFBLAS_DIAG_UNIT } xfblasDiagType_t;
+
+// same values as GemmActivation of the L1 gemm epilogue
+typedef enum { XFBLAS_ACTIVATION_NONE, XFBLAS_ACTIVATION_RELU, XFBLAS_ACTIVATION_GELU } xfblasActivation_t;
+
 } // namespace blas
 
 } // namespace xf
@@ -24,6 +24,9 @@
 
 #include "xf_blas/wrapper.hpp"
 #include "xf_blas/wrapper_async.hpp"
+#include "xf_blas/gemm_tiled.hpp"
+#include "xf_blas/level3.hpp"
+#include "xf_blas/sparse.hpp"
 
 using namespace xf::blas;
 
@@ -0,0 +1,150 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef XF_BLAS_BELL_HPP
+#define XF_BLAS_BELL_HPP
+
+#include <algorithm>
+#include <vector>
+
+namespace xf {
+
+namespace blas {
+
+/*
+ * Rows of a CSR matrix in blocked-ELL format, the layout read by ellSpmv and ellSpmm in L1.
+ * Rows and cols are padded to a multiple of parEntries, cols are split into column blocks of colBlock cols,
+ * and rows into slices of sliceRows rows. A tile is the part of a slice in a column block.
+ *   m_width  words per row of each tile, at [b * numSlices + s] for column block b and slice s
+ *   m_val    for each tile in the same order, and each of its rows, width words of parEntries values, zero padded
+ *   m_col    same shape as m_val, column indices local to the column block
+ */
+template <typename t_DataType>
+class BellMat {
+   public:
+    unsigned int m_rows = 0, m_paddedRows = 0, m_paddedCols = 0;
+    unsigned int m_parEntries = 0, m_colBlock = 0, m_sliceRows = 0;
+    std::vector<unsigned int> m_width;
+    std::vector<t_DataType> m_val;
+    std::vector<unsigned int> m_col;
+};
+
+/*
+ * Converts rows [p_rowBegin, p_rowEnd) of a CSR matrix with p_n cols into p_bell, row p_rowBegin becoming row 0.
+ * p_rowPtr is indexed by the row numbers of the whole matrix.
+ * Returns false if a column index is out of range.
+ */
+template <typename t_DataType, typename t_IndexType>
+bool csr2Bell(unsigned int p_rowBegin,
+              unsigned int p_rowEnd,
+              unsigned int p_n,
+              const t_IndexType* p_rowPtr,
+              const t_IndexType* p_colIdx,
+              const t_DataType* p_val,
+              unsigned int p_parEntries,
+              unsigned int p_colBlock,
+              unsigned int p_sliceRows,
+              BellMat<t_DataType>& p_bell) {
+    unsigned int l_rows = p_rowEnd - p_rowBegin;
+    p_bell.m_rows = l_rows;
+    p_bell.m_paddedRows = (l_rows + p_parEntries - 1) / p_parEntries * p_parEntries;
+    p_bell.m_paddedCols = (p_n + p_parEntries - 1) / p_parEntries * p_parEntries;
+    p_bell.m_parEntries = p_parEntries;
+    p_bell.m_colBlock = p_colBlock;
+    p_bell.m_sliceRows = p_sliceRows;
+    unsigned int l_numColBlocks = (p_bell.m_paddedCols + p_colBlock - 1) / p_colBlock;
+    unsigned int l_numSlices = (p_bell.m_paddedRows + p_sliceRows - 1) / p_sliceRows;
+
+    // max number of entries per row of each tile, only the column blocks touched by a row are visited
+    std::vector<unsigned int>& l_width = p_bell.m_width;
+    l_width.assign(l_numColBlocks * l_numSlices, 0);
+    std::vector<unsigned int> l_cnt(l_numColBlocks, 0);
+    std::vector<unsigned int> l_touched;
+    for (unsigned int r = 0; r < l_rows; r++) {
+        unsigned int s = r / p_sliceRows;
+        for (t_IndexType e = p_rowPtr[p_rowBegin + r]; e < p_rowPtr[p_rowBegin + r + 1]; e++) {
+            long long l_c = p_colIdx[e];
+            if (l_c < 0 || l_c >= p_n) {
+                return false;
+            }
+            unsigned int b = l_c / p_colBlock;
+            if (l_cnt[b]++ == 0) {
+                l_touched.push_back(b);
+            }
+        }
+        for (unsigned int b : l_touched) {
+            l_width[b * l_numSlices + s] = std::max(l_width[b * l_numSlices + s], l_cnt[b]);
+            l_cnt[b] = 0;
+        }
+        l_touched.clear();
+    }
+
+    // widths in words, and the first word of each tile
+    std::vector<unsigned long long> l_tileBase(l_width.size());
+    unsigned long long l_words = 0;
+    for (unsigned int t = 0; t < l_width.size(); t++) {
+        l_width[t] = (l_width[t] + p_parEntries - 1) / p_parEntries;
+        l_tileBase[t] = l_words;
+        unsigned int s = t % l_numSlices;
+        l_words += (unsigned long long)l_width[t] * std::min(p_sliceRows, p_bell.m_paddedRows - s * p_sliceRows);
+    }
+
+    p_bell.m_val.assign(l_words * p_parEntries, 0);
+    p_bell.m_col.assign(l_words * p_parEntries, 0);
+    for (unsigned int r = 0; r < l_rows; r++) {
+        unsigned int s = r / p_sliceRows;
+        for (t_IndexType e = p_rowPtr[p_rowBegin + r]; e < p_rowPtr[p_rowBegin + r + 1]; e++) {
+            unsigned int b = p_colIdx[e] / p_colBlock;
+            if (l_cnt[b] == 0) {
+                l_touched.push_back(b);
+            }
+            unsigned int l_tile = b * l_numSlices + s;
+            unsigned long long l_word = l_tileBase[l_tile] + (unsigned long long)(r % p_sliceRows) * l_width[l_tile];
+            unsigned long long l_pos = l_word * p_parEntries + l_cnt[b]++;
+            p_bell.m_val[l_pos] = p_val[e];
+            p_bell.m_col[l_pos] = p_colIdx[e] - b * p_colBlock;
+        }
+        for (unsigned int b : l_touched) {
+            l_cnt[b] = 0;
+        }
+        l_touched.clear();
+    }
+    return true;
+}
+
+/*
+ * Converts a whole CSR matrix of p_m rows and p_n cols into p_bell.
+ * Returns false if a column index is out of range.
+ */
+template <typename t_DataType>
+bool csr2Bell(unsigned int p_m,
+              unsigned int p_n,
+              const std::vector<unsigned int>& p_rowPtr,
+              const std::vector<unsigned int>& p_colIdx,
+              const std::vector<t_DataType>& p_val,
+              unsigned int p_parEntries,
+              unsigned int p_colBlock,
+              unsigned int p_sliceRows,
+              BellMat<t_DataType>& p_bell) {
+    return csr2Bell(0, p_m, p_n, p_rowPtr.data(), p_colIdx.data(), p_val.data(), p_parEntries, p_colBlock,
+                    p_sliceRows, p_bell);
+}
+
+} // namespace blas
+
+} // namespace xf
+
+#endif
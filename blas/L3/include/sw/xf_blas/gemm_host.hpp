@@ -40,12 +40,15 @@ class GemmArgs : public BLASArgs {
              unsigned int p_ldc,
              unsigned int p_ldx,
              int p_postScale,
-             int p_postShift)
+             int p_postShift,
+             int p_activation = XFBLAS_ACTIVATION_NONE)
         : m_GemmArgs({int(OpGemm), p_aOffset, p_bOffset, p_cOffset, p_xOffset, p_m, p_k, p_n, p_lda, p_ldb, p_ldc,
                       p_ldx, 0, 0, 0, 0}) {
         m_GemmArgs.m_postScaleVal = (p_postScale << 8) | (p_postShift & 0x000000ff);
+        m_GemmArgs.m_activation = p_activation;
     }
-    size_t sizeInBytes() { return sizeof(m_GemmArgs); }
+    size_t sizeInBytes() { return instrSizeInBytes(); }
+    static size_t instrSizeInBytes() { return sizeof(m_GemmArgs); }
     char* asByteArray() { return reinterpret_cast<char*>(&m_GemmArgs); }
 
    protected:
@@ -53,7 +56,9 @@ class GemmArgs : public BLASArgs {
         int m_optype;
         unsigned int m_aOffset, m_bOffset, m_cOffset, m_xOffset, m_m, m_k, m_n, m_lda, m_ldb, m_ldc, m_ldx;
         int m_postScaleVal;
-        int m_empty[3];
+        // epilogue activation, 0 (none) keeps the instruction readable by kernels without the epilogue
+        int m_activation;
+        int m_empty[2];
     } m_GemmArgs;
 };
 
@@ -77,50 +82,173 @@ class GEMMHost : public BLASHost {
                                      unsigned int p_ldc,
                                      unsigned int p_ldx,
                                      int p_postScale,
-                                     int p_postShift) {
-        if (this->m_bufHandle.find(p_a) == this->m_bufHandle.end() ||
-            this->m_bufHandle.find(p_b) == this->m_bufHandle.end() ||
-            this->m_bufHandle.find(p_c) == this->m_bufHandle.end() ||
-            this->m_bufHandle.find(p_bias) == this->m_bufHandle.end()) {
+                                     int p_postShift,
+                                     xfblasActivation_t p_activation = XFBLAS_ACTIVATION_NONE) {
+        unsigned long long l_aOff, l_bOff, l_cOff, l_xOff;
+        if (!getPageOffset(p_a, &l_aOff) || !getPageOffset(p_b, &l_bOff) || !getPageOffset(p_c, &l_cOff) ||
+            !getPageOffset(p_bias, &l_xOff)) {
             return XFBLAS_STATUS_ALLOC_FAILED;
         }
-        unsigned int handle_A, handle_B, handle_C, handle_bias;
-        auto& l_devPtr = this->m_bufHandle;
+        if (!this->hasInstrSpace(1, GemmArgs::instrSizeInBytes())) {
+            return XFBLAS_STATUS_INVALID_VALUE;
+        }
 
-        handle_A = l_devPtr[p_a];
-        handle_B = l_devPtr[p_b];
-        handle_C = l_devPtr[p_c];
-        handle_bias = l_devPtr[p_bias];
+        GemmArgs l_gargs(l_aOff, l_bOff, l_cOff, l_xOff, p_m, p_k, p_n, p_lda, p_ldb, p_ldc, p_ldx, p_postScale,
+                         p_postShift, p_activation);
+        this->addInstr(&l_gargs);
+        this->enableRun();
 
-        xclBOProperties p;
-        uint64_t address_A = !xclGetBOProperties(this->m_fpga->m_handle, handle_A, &p) ? p.paddr : -1;
-        uint64_t address_B = !xclGetBOProperties(this->m_fpga->m_handle, handle_B, &p) ? p.paddr : -1;
-        uint64_t address_C = !xclGetBOProperties(this->m_fpga->m_handle, handle_C, &p) ? p.paddr : -1;
-        uint64_t address_bias = !xclGetBOProperties(this->m_fpga->m_handle, handle_bias, &p) ? p.paddr : -1;
+        return XFBLAS_STATUS_SUCCESS;
+    }
 
-        unsigned long long l_aOff, l_bOff, l_cOff, l_xOff;
-        l_aOff = (unsigned long long)address_A;
-        l_bOff = (unsigned long long)address_B;
-        l_cOff = (unsigned long long)address_C;
-        l_xOff = (unsigned long long)address_bias;
+    /*
+     * Adds one GEMM instruction per entry of p_a, p_b and p_c, all with the same sizes,
+     * so that the whole batch is run with a single kernel start when it fits in the instruction page.
+     * C is also used as bias, same as addGEMMOp called from xfblasGemm.
+     */
+    virtual xfblasStatus_t addGEMMBatchedOp(void* const* p_a,
+                                            void* const* p_b,
+                                            void* const* p_c,
+                                            unsigned int p_m,
+                                            unsigned int p_n,
+                                            unsigned int p_k,
+                                            unsigned int p_lda,
+                                            unsigned int p_ldb,
+                                            unsigned int p_ldc,
+                                            unsigned int p_batchCount,
+                                            int p_postScale,
+                                            int p_postShift) {
+        // all the matrices are checked before any page of the batch is run
+        vector<unsigned long long> l_offs(3 * p_batchCount);
+        for (unsigned int i = 0; i < p_batchCount; i++) {
+            if (!getPageOffset(p_a[i], &l_offs[3 * i]) || !getPageOffset(p_b[i], &l_offs[3 * i + 1]) ||
+                !getPageOffset(p_c[i], &l_offs[3 * i + 2])) {
+                return XFBLAS_STATUS_ALLOC_FAILED;
+            }
+        }
+        for (unsigned int i = 0; i < p_batchCount; i++) {
+            GemmArgs l_gargs(l_offs[3 * i], l_offs[3 * i + 1], l_offs[3 * i + 2], l_offs[3 * i + 2], p_m, p_k, p_n,
+                             p_lda, p_ldb, p_ldc, p_ldc, p_postScale, p_postShift);
+            xfblasStatus_t l_status = addBatchInstr(&l_gargs);
+            if (l_status != XFBLAS_STATUS_SUCCESS) {
+                return l_status;
+            }
+        }
 
-        l_aOff -= this->m_fpga->m_baseAddress[this->m_cuIndex];
-        l_bOff -= this->m_fpga->m_baseAddress[this->m_cuIndex];
-        l_cOff -= this->m_fpga->m_baseAddress[this->m_cuIndex];
-        l_xOff -= this->m_fpga->m_baseAddress[this->m_cuIndex];
+        return XFBLAS_STATUS_SUCCESS;
+    }
+
+    /*
+     * Adds p_batchCount GEMM instructions over 3 allocations, the i-th GEMM starts at
+     * i * stride bytes from p_a, p_b and p_c. The device buffers are looked up only once,
+     * and strides must be multiples of PAGE_SIZE, as instructions address pages.
+     */
+    virtual xfblasStatus_t addGEMMStridedBatchedOp(void* p_a,
+                                                   void* p_b,
+                                                   void* p_c,
+                                                   unsigned long long p_strideA,
+                                                   unsigned long long p_strideB,
+                                                   unsigned long long p_strideC,
+                                                   unsigned long long p_sizeA,
+                                                   unsigned long long p_sizeB,
+                                                   unsigned long long p_sizeC,
+                                                   unsigned int p_m,
+                                                   unsigned int p_n,
+                                                   unsigned int p_k,
+                                                   unsigned int p_lda,
+                                                   unsigned int p_ldb,
+                                                   unsigned int p_ldc,
+                                                   unsigned int p_batchCount,
+                                                   int p_postScale,
+                                                   int p_postShift) {
+        if (p_strideA % this->PAGE_SIZE != 0 || p_strideB % this->PAGE_SIZE != 0 ||
+            p_strideC % this->PAGE_SIZE != 0) {
+            return XFBLAS_STATUS_INVALID_VALUE;
+        }
+        unsigned long long l_aOff, l_bOff, l_cOff;
+        if (!getPageOffset(p_a, &l_aOff) || !getPageOffset(p_b, &l_bOff) || !getPageOffset(p_c, &l_cOff)) {
+            return XFBLAS_STATUS_ALLOC_FAILED;
+        }
+        // the last matrix of each batch must still be inside its allocation
+        unsigned long long l_last = p_batchCount - 1;
+        if (l_last * p_strideA + p_sizeA > this->m_hostMatSz[p_a] ||
+            l_last * p_strideB + p_sizeB > this->m_hostMatSz[p_b] ||
+            l_last * p_strideC + p_sizeC > this->m_hostMatSz[p_c]) {
+            return XFBLAS_STATUS_INVALID_VALUE;
+        }
+        for (unsigned int i = 0; i < p_batchCount; i++) {
+            GemmArgs l_gargs(l_aOff, l_bOff, l_cOff, l_cOff, p_m, p_k, p_n, p_lda, p_ldb, p_ldc, p_ldc, p_postScale,
+                             p_postShift);
+            xfblasStatus_t l_status = addBatchInstr(&l_gargs);
+            if (l_status != XFBLAS_STATUS_SUCCESS) {
+                return l_status;
+            }
+            l_aOff += p_strideA / this->PAGE_SIZE;
+            l_bOff += p_strideB / this->PAGE_SIZE;
+            l_cOff += p_strideC / this->PAGE_SIZE;
+        }
 
-        l_aOff /= this->PAGE_SIZE;
-        l_bOff /= this->PAGE_SIZE;
-        l_cOff /= this->PAGE_SIZE;
-        l_xOff /= this->PAGE_SIZE;
+        return XFBLAS_STATUS_SUCCESS;
+    }
 
-        GemmArgs l_gargs(l_aOff, l_bOff, l_cOff, l_xOff, p_m, p_k, p_n, p_lda, p_ldb, p_ldc, p_ldx, p_postScale,
+    /*
+     * Adds a GEMM instruction on sub-matrices starting p_aOffset, p_bOffset and p_cOffset bytes
+     * into the allocations of p_a, p_b and p_c, with C also used as bias.
+     * Offsets must be multiples of PAGE_SIZE, and are not checked against the allocation size.
+     */
+    virtual xfblasStatus_t addGEMMOffsetOp(void* p_a,
+                                           unsigned long long p_aOffset,
+                                           void* p_b,
+                                           unsigned long long p_bOffset,
+                                           void* p_c,
+                                           unsigned long long p_cOffset,
+                                           unsigned int p_m,
+                                           unsigned int p_n,
+                                           unsigned int p_k,
+                                           unsigned int p_lda,
+                                           unsigned int p_ldb,
+                                           unsigned int p_ldc,
+                                           int p_postScale,
+                                           int p_postShift) {
+        if (p_aOffset % this->PAGE_SIZE != 0 || p_bOffset % this->PAGE_SIZE != 0 ||
+            p_cOffset % this->PAGE_SIZE != 0) {
+            return XFBLAS_STATUS_INVALID_VALUE;
+        }
+        unsigned long long l_aOff, l_bOff, l_cOff;
+        if (!getPageOffset(p_a, &l_aOff) || !getPageOffset(p_b, &l_bOff) || !getPageOffset(p_c, &l_cOff)) {
+            return XFBLAS_STATUS_ALLOC_FAILED;
+        }
+        if (!this->hasInstrSpace(1, GemmArgs::instrSizeInBytes())) {
+            return XFBLAS_STATUS_INVALID_VALUE;
+        }
+        l_aOff += p_aOffset / this->PAGE_SIZE;
+        l_bOff += p_bOffset / this->PAGE_SIZE;
+        l_cOff += p_cOffset / this->PAGE_SIZE;
+        GemmArgs l_gargs(l_aOff, l_bOff, l_cOff, l_cOff, p_m, p_k, p_n, p_lda, p_ldb, p_ldc, p_ldc, p_postScale,
                          p_postShift);
         this->addInstr(&l_gargs);
         this->enableRun();
 
         return XFBLAS_STATUS_SUCCESS;
     }
+
+   private:
+    /*
+     * Adds one GEMM of a batch. When the instruction page is full, the queued instructions are
+     * run first, so that a batch larger than one page is split into consecutive kernel starts.
+     */
+    xfblasStatus_t addBatchInstr(GemmArgs* p_gargs) {
+        if (!this->hasInstrSpace(1, GemmArgs::instrSizeInBytes())) {
+            xfblasStatus_t l_status = this->execute();
+            this->clearInstrBuf();
+            if (l_status != XFBLAS_STATUS_SUCCESS) {
+                return l_status;
+            }
+        }
+        this->addInstr(p_gargs);
+        this->enableRun();
+        return XFBLAS_STATUS_SUCCESS;
+    }
 };
 
 } // namespace blas
@@ -0,0 +1,275 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef XF_BLAS_GEMM_TILED_HPP
+#define XF_BLAS_GEMM_TILED_HPP
+
+#include <future>
+#include <algorithm>
+
+#include "handle.hpp"
+#include "gemm_host.hpp"
+
+namespace xf {
+
+namespace blas {
+
+/*
+ * Device tiles of one CU for the out-of-core GEMM.
+ * A and B tiles are double-buffered, so that the panels of the next step are
+ * copied to the device while the kernel computes on the current ones.
+ * C tile stays on the device and is accumulated over all the panels.
+ */
+template <typename t_dataType>
+class GEMMTiles {
+   public:
+    t_dataType* m_a[2];
+    t_dataType* m_b[2];
+    t_dataType* m_c;
+    unsigned int m_tileM, m_tileN, m_tileK;
+
+    GEMMTiles() = delete;
+    GEMMTiles(const GEMMTiles&) = delete;
+    GEMMTiles(GEMMHost* p_host, unsigned int p_tileM, unsigned int p_tileN, unsigned int p_tileK)
+        : m_tileM(p_tileM), m_tileN(p_tileN), m_tileK(p_tileK), m_host(p_host) {
+        for (int i = 0; i < 2; i++) {
+            m_a[i] = alloc(m_tileM * m_tileK);
+            m_b[i] = alloc(m_tileK * m_tileN);
+        }
+        m_c = alloc(m_tileM * m_tileN);
+    }
+
+    ~GEMMTiles() {
+        for (auto l_ptr : m_allocated) {
+            m_host->freeMat(l_ptr);
+            free(l_ptr);
+        }
+    }
+
+    bool good() const { return m_good; }
+
+    // copy panel (p_row, p_col) of size rows x cols of a host matrix into a zero-padded tile on the device
+    bool load(t_dataType* p_tile,
+              unsigned int p_tileRows,
+              unsigned int p_tileCols,
+              const t_dataType* p_mat,
+              int p_ld,
+              int p_row,
+              int p_col,
+              int p_rows,
+              int p_cols) {
+        memset(p_tile, 0, sizeof(t_dataType) * p_tileRows * p_tileCols);
+        for (int i = 0; i < p_rows; i++) {
+            memcpy(&p_tile[IDX2R(i, 0, p_tileCols)], &p_mat[IDX2R(p_row + i, p_col, p_ld)],
+                   sizeof(t_dataType) * p_cols);
+        }
+        return m_host->setMatToFPGARestricted(p_tile) == XFBLAS_STATUS_SUCCESS;
+    }
+
+    // copy C tile back from the device, and write the valid part into the host matrix
+    bool store(t_dataType* p_mat, int p_ld, int p_row, int p_col, int p_rows, int p_cols) {
+        if (m_host->getMatRestricted(m_c, m_c) != XFBLAS_STATUS_SUCCESS) {
+            return false;
+        }
+        for (int i = 0; i < p_rows; i++) {
+            memcpy(&p_mat[IDX2R(p_row + i, p_col, p_ld)], &m_c[IDX2R(i, 0, m_tileN)], sizeof(t_dataType) * p_cols);
+        }
+        return true;
+    }
+
+   private:
+    GEMMHost* m_host;
+    vector<t_dataType*> m_allocated;
+    bool m_good = true;
+
+    t_dataType* alloc(unsigned int p_numElem) {
+        t_dataType* l_ptr = nullptr;
+        unsigned long long l_bufSize = (unsigned long long)p_numElem * sizeof(t_dataType);
+        if (posix_memalign((void**)&l_ptr, 4096, l_bufSize)) {
+            m_good = false;
+            return nullptr;
+        }
+        memset(l_ptr, 0, l_bufSize);
+        if (m_host->allocMatRestricted(l_ptr, l_ptr, l_bufSize) != XFBLAS_STATUS_SUCCESS) {
+            m_good = false;
+        }
+        m_allocated.push_back(l_ptr);
+        return l_ptr;
+    }
+};
+
+/*
+ * Computes the C tiles assigned to one CU, the tiles are numbered row by row
+ * and CU kernelIndex takes tile kernelIndex, kernelIndex + numKernel, ...
+ * The host of the CU is looked up by the caller, as the CUs run in their own threads.
+ */
+template <typename t_dataType>
+xfblasStatus_t gemmTiledOnKernel(int m,
+                                 int n,
+                                 int k,
+                                 const t_dataType* A,
+                                 int lda,
+                                 const t_dataType* B,
+                                 int ldb,
+                                 t_dataType* C,
+                                 int ldc,
+                                 unsigned int tileM,
+                                 unsigned int tileN,
+                                 unsigned int tileK,
+                                 unsigned int numKernel,
+                                 unsigned int kernelIndex,
+                                 GEMMHost* l_gemmPtr) {
+    GEMMTiles<t_dataType> l_tiles(l_gemmPtr, tileM, tileN, tileK);
+    if (!l_tiles.good()) {
+        return XFBLAS_STATUS_ALLOC_FAILED;
+    }
+
+    int l_tilesM = (m + tileM - 1) / tileM;
+    int l_tilesN = (n + tileN - 1) / tileN;
+    int l_panels = (k + tileK - 1) / tileK;
+
+    // copies A(i, p) and B(p, j) panels into buffer p % 2
+    auto l_loadPanels = [&](int p_i0, int p_j0, int p_p) {
+        int l_k0 = p_p * tileK;
+        int l_rows = min<int>(tileM, m - p_i0);
+        int l_cols = min<int>(tileN, n - p_j0);
+        int l_depth = min<int>(tileK, k - l_k0);
+        return l_tiles.load(l_tiles.m_a[p_p % 2], tileM, tileK, A, lda, p_i0, l_k0, l_rows, l_depth) &&
+               l_tiles.load(l_tiles.m_b[p_p % 2], tileK, tileN, B, ldb, l_k0, p_j0, l_depth, l_cols);
+    };
+
+    for (int t = kernelIndex; t < l_tilesM * l_tilesN; t += numKernel) {
+        int l_i0 = (t / l_tilesN) * tileM;
+        int l_j0 = (t % l_tilesN) * tileN;
+        int l_rows = min<int>(tileM, m - l_i0);
+        int l_cols = min<int>(tileN, n - l_j0);
+
+        if (!l_tiles.load(l_tiles.m_c, tileM, tileN, C, ldc, l_i0, l_j0, l_rows, l_cols) ||
+            !l_loadPanels(l_i0, l_j0, 0)) {
+            return XFBLAS_STATUS_ALLOC_FAILED;
+        }
+        for (int p = 0; p < l_panels; p++) {
+            future<bool> l_next;
+            if (p + 1 < l_panels) {
+                l_next = async(launch::async, l_loadPanels, l_i0, l_j0, p + 1);
+            }
+            l_gemmPtr->clearInstrBuf();
+            xfblasStatus_t l_status =
+                l_gemmPtr->addGEMMOp(l_tiles.m_a[p % 2], l_tiles.m_b[p % 2], l_tiles.m_c, l_tiles.m_c, tileM, tileN,
+                                     tileK, tileK, tileN, tileN, tileN, 1, 0);
+            if (l_status == XFBLAS_STATUS_SUCCESS) {
+                l_status = l_gemmPtr->execute();
+            }
+            bool l_nextOk = !l_next.valid() || l_next.get();
+            if (l_status != XFBLAS_STATUS_SUCCESS) {
+                return l_status;
+            }
+            if (!l_nextOk) {
+                return XFBLAS_STATUS_ALLOC_FAILED;
+            }
+        }
+        if (!l_tiles.store(C, ldc, l_i0, l_j0, l_rows, l_cols)) {
+            return XFBLAS_STATUS_ALLOC_FAILED;
+        }
+        l_gemmPtr->releaseExecHandles();
+    }
+    l_gemmPtr->clearInstrBuf();
+    return XFBLAS_STATUS_SUCCESS;
+}
+
+/**
+ * @brief This function performs the matrix-matrix multiplication C = A * B + C for matrices in the host memory that
+ * don't need to fit in the FPGA device memory. Panels of A and B are streamed through double-buffered device tiles,
+ * each C tile is accumulated on the device, and the C tiles are distributed over numKernel kernels.
+ * @param m number of rows in matrix A, matrix C
+ * @param n number of cols in matrix B, matrix C
+ * @param k number of cols in matrix A, number of rows in matrix B
+ * @param A pointer to matrix A in the host memory
+ * @param lda leading dimension of matirx A
+ * @param B pointer to matrix B in the host memory
+ * @param ldb leading dimension of matrix B
+ * @param C pointer to matrix C in the host memory
+ * @param ldc leading dimension of matrix C
+ * @param tileM number of rows in A and C tiles, padded to the minimum size of the kernel
+ * @param tileN number of cols in B and C tiles, padded to the minimum size of the kernel
+ * @param tileK number of cols in A tiles and rows in B tiles, padded to the minimum size of the kernel
+ * @param numKernel number of kernels that is being used, default is 1
+ * @param deviceIndex index of device that is being used, default is 0
+ * @retval xfblasStatus_t 0 if the operation completed successfully
+ * @retval xfblasStatus_t 1 if the library was not initialized
+ * @retval xfblasStatus_t 2 if m, n, k, tile sizes <= 0, or the data type doesn't match the kernel
+ * @retval xfblasStatus_t 3 if the device tiles could not be allocated or transferred
+ * @retval xfblasStatus_t 4 if the engine is not supported for now
+ */
+template <typename t_dataType>
+xfblasStatus_t xfblasGemmTiled(int m,
+                               int n,
+                               int k,
+                               const t_dataType* A,
+                               int lda,
+                               const t_dataType* B,
+                               int ldb,
+                               t_dataType* C,
+                               int ldc,
+                               int tileM,
+                               int tileN,
+                               int tileK,
+                               unsigned int numKernel = 1,
+                               unsigned int deviceIndex = 0) {
+    if (ConfigDict::instance().m_dict.empty()) {
+        return XFBLAS_STATUS_NOT_INITIALIZED;
+    }
+    if (ConfigDict::instance().m_dict["GEMX_runGemm"] != "1") {
+        return XFBLAS_STATUS_NOT_SUPPORTED;
+    }
+    auto l_hosts = BLASHostHandle::instance().m_handlePtr.find(deviceIndex);
+    if (m <= 0 || n <= 0 || k <= 0 || tileM <= 0 || tileN <= 0 || tileK <= 0 || numKernel == 0 ||
+        l_hosts == BLASHostHandle::instance().m_handlePtr.end() || numKernel > l_hosts->second.size()) {
+        return XFBLAS_STATUS_INVALID_VALUE;
+    }
+    if (getTypeSize(ConfigDict::instance().m_dict["GEMX_dataType"]) != sizeof(t_dataType)) {
+        return XFBLAS_STATUS_INVALID_VALUE;
+    }
+    int l_minSize = stoi(ConfigDict::instance().m_dict["minSize"]);
+    unsigned int l_tileM = getPaddedSize(tileM, l_minSize);
+    unsigned int l_tileN = getPaddedSize(tileN, l_minSize);
+    unsigned int l_tileK = getPaddedSize(tileK, l_minSize);
+
+    // the shared handle map is only read here, before the threads start
+    vector<GEMMHost*> l_gemmPtrs(numKernel);
+    for (unsigned int i = 0; i < numKernel; i++) {
+        l_gemmPtrs[i] = static_cast<GEMMHost*>(l_hosts->second.at(i).get());
+    }
+    vector<future<xfblasStatus_t> > l_fuStatus;
+    for (unsigned int i = 0; i < numKernel; i++) {
+        l_fuStatus.push_back(async(launch::async, gemmTiledOnKernel<t_dataType>, m, n, k, A, lda, B, ldb, C, ldc,
+                                   l_tileM, l_tileN, l_tileK, numKernel, i, l_gemmPtrs[i]));
+    }
+    xfblasStatus_t l_status = XFBLAS_STATUS_SUCCESS;
+    for (auto& fu : l_fuStatus) {
+        xfblasStatus_t l_kernelStatus = fu.get();
+        if (l_kernelStatus != XFBLAS_STATUS_SUCCESS) {
+            l_status = l_kernelStatus;
+        }
+    }
+    return l_status;
+}
+
+} // namespace blas
+
+} // namespace xf
+
+#endif
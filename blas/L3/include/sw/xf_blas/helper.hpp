@@ -89,6 +89,15 @@ xfblasStatus_t buildConfigDict(string p_configFile,
         }
     }
 
+    if (p_engineName == XFBLAS_ENGINE_SPMV) {
+        if (l_configDict.find("GEMX_spmvColBlock") != l_configDict.end() &&
+            l_configDict.find("GEMX_spmvMaxRows") != l_configDict.end()) {
+            l_configDict["minSize"] = l_configDict["GEMX_ddrWidth"];
+        } else {
+            return XFBLAS_STATUS_NOT_INITIALIZED;
+        }
+    }
+
     *p_configDict = l_configDict;
     return XFBLAS_STATUS_SUCCESS;
 }
@@ -104,11 +113,26 @@ int getTypeSize(string p_typeName) {
         return sizeof(short);
     } else if (p_typeName == "int") {
         return sizeof(int);
+    } else if (p_typeName == "int8_t") {
+        return sizeof(int8_t);
+    } else if (p_typeName == "bfloat16") {
+        return sizeof(uint16_t);
     } else {
         return 0;
     }
 }
 
+/*
+ * Narrow GEMM types accumulate in GEMX_macDataType, which is also the type of the bias, and store C as
+ * GEMX_cDataType. Both default to GEMX_dataType.
+ */
+int getGemmTypeSize(unordered_map<string, string>& p_dict, string p_key) {
+    if (p_dict.find(p_key) == p_dict.end()) {
+        return getTypeSize(p_dict["GEMX_dataType"]);
+    }
+    return getTypeSize(p_dict[p_key]);
+}
+
 } // namespace blas
 
 } // namespace xf
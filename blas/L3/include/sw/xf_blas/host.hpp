@@ -118,8 +118,13 @@ class XFpga {
         return true;
     }
 
-    unsigned int execKernel(unsigned int p_kernelIndex) {
+    // starts the kernel and waits for it, p_execHandle is the command buffer to be freed by the caller, or 0
+    xfblasStatus_t execKernel(unsigned int p_kernelIndex, unsigned int* p_execHandle) {
         unsigned int m_execHandle = xclAllocBO(m_handle, 4096 + 4096, xclBOKind(0), (1 << 31));
+        *p_execHandle = m_execHandle;
+        if (!m_execHandle) {
+            return XFBLAS_STATUS_ALLOC_FAILED;
+        }
         void* execData = xclMapBO(m_handle, m_execHandle, true);
         auto ecmd = reinterpret_cast<ert_start_kernel_cmd*>(execData);
         auto rsz = XGEMXKERNEL_0_GEMXKERNEL_0_CONTROL_ADDR_P_DDRWR_M_VAL_DATA / 4 + 2; // regmap array size
@@ -137,14 +142,17 @@ class XFpga {
             m_baseAddress[p_kernelIndex] >> 32;
 
         if (xclExecBuf(m_handle, m_execHandle)) {
-            return 0;
+            return XFBLAS_STATUS_ALLOC_FAILED;
         }
-        // while (ecmd->state == 1){
-        while (xclExecWait(m_handle, 1) == 0)
-            ;
-
-        //}
-        return m_execHandle;
+        // wait for this command, other CUs may complete in the meantime
+        while (ecmd->state < ERT_CMD_STATE_COMPLETED) {
+            xclExecWait(m_handle, 1);
+        }
+        // the command may also end in error, abort or timeout
+        if (ecmd->state != ERT_CMD_STATE_COMPLETED) {
+            return XFBLAS_STATUS_INVALID_PROGRAM;
+        }
+        return XFBLAS_STATUS_SUCCESS;
     }
 };
 
@@ -302,6 +310,12 @@ class XHost {
         return XFBLAS_STATUS_SUCCESS;
     }
 
+    // true if p_numInstrs more instructions of p_instrSz bytes fit in the instruction page,
+    // the last slot is kept empty to mark the end of program.
+    bool hasInstrSpace(unsigned int p_numInstrs, size_t p_instrSz) const {
+        return m_instrOffset + (unsigned long long)(p_numInstrs + 1) * p_instrSz <= INSTR_BUF_SIZE;
+    }
+
     void addInstr(BLASArgs* p_args) {
         char* l_instr = p_args->asByteArray();
         char* l_currPos = &m_progBuf[m_instrOffset];
@@ -372,6 +386,26 @@ class XHost {
         return XFBLAS_STATUS_SUCCESS;
     }
 
+    // page offset of a device buffer from the base address of this kernel
+    bool getPageOffset(void* p_ptr, unsigned long long* p_off) {
+        auto l_it = m_bufHandle.find(p_ptr);
+        if (l_it == m_bufHandle.end()) {
+            return false;
+        }
+        xclBOProperties p;
+        uint64_t l_address = !xclGetBOProperties(m_fpga->m_handle, l_it->second, &p) ? p.paddr : -1;
+        *p_off = ((unsigned long long)l_address - m_fpga->m_baseAddress[m_cuIndex]) / PAGE_SIZE;
+        return true;
+    }
+
+    // free the command buffers of finished kernel runs
+    void releaseExecHandles() {
+        for (unsigned int i = 0; i < m_execHandles.size(); i++) {
+            xclFreeBO(m_fpga->m_handle, m_execHandles[i]);
+        }
+        m_execHandles.clear();
+    }
+
     void clearInstrBuf() {
         memset(this->m_progBuf, 0, PAGE_SIZE);
         this->m_instrOffset = 0;
@@ -422,10 +456,12 @@ class BLASHost : public XHost {
             if (!this->m_fpga->copyToFpga(this->m_instrBufHandle, this->INSTR_BUF_SIZE + this->KERN_DBG_BUF_SIZE)) {
                 l_status = XFBLAS_STATUS_ALLOC_FAILED;
             }
-            unsigned int m_execHandle = this->m_fpga->execKernel(this->m_cuIndex);
-            if (!m_execHandle) {
-                l_status = XFBLAS_STATUS_ALLOC_FAILED;
-            } else {
+            unsigned int m_execHandle = 0;
+            xfblasStatus_t l_execStatus = this->m_fpga->execKernel(this->m_cuIndex, &m_execHandle);
+            if (l_execStatus != XFBLAS_STATUS_SUCCESS) {
+                l_status = l_execStatus;
+            }
+            if (m_execHandle) {
                 this->m_execHandles.push_back(m_execHandle);
             }
             m_execControl = false;
@@ -434,6 +470,9 @@ class BLASHost : public XHost {
     }
 
     void enableRun() { m_execControl = true; }
+
+    // true if instructions have been added since the last run
+    bool hasPendingInstrs() const { return m_execControl && this->m_instrOffset > 0; }
 };
 
 } // namespace blas
@@ -0,0 +1,538 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef XF_BLAS_LEVEL3_HPP
+#define XF_BLAS_LEVEL3_HPP
+
+#include <type_traits>
+#include <vector>
+
+#include "handle.hpp"
+#include "gemm_host.hpp"
+
+/*
+ * TRSM, SYRK and SYMM are run as blocked algorithms on the GEMM kernel.
+ * Operands are packed into square blocks of XFBLAS_LEVEL3_BLOCK_SIZE (padded to the minimum size of the kernel),
+ * each block is contiguous on the device, and every block update is one GEMM instruction.
+ * Intermediate results stay on the device until the last instruction has run.
+ */
+#ifndef XFBLAS_LEVEL3_BLOCK_SIZE
+#define XFBLAS_LEVEL3_BLOCK_SIZE 512
+#endif
+
+namespace xf {
+
+namespace blas {
+
+/*
+ * Matrix of p_rowBlocks x p_colBlocks square blocks, stored block by block in one device allocation.
+ */
+template <typename t_dataType>
+class BlockedMat {
+   public:
+    BlockedMat() = delete;
+    BlockedMat(const BlockedMat&) = delete;
+    BlockedMat(GEMMHost* p_host, unsigned int p_rowBlocks, unsigned int p_colBlocks, unsigned int p_blockSize)
+        : m_host(p_host), m_rowBlocks(p_rowBlocks), m_colBlocks(p_colBlocks), m_blockSize(p_blockSize) {
+        unsigned long long l_bufSize = (unsigned long long)m_rowBlocks * m_colBlocks * blockBytes();
+        if (posix_memalign((void**)&m_data, 4096, l_bufSize)) {
+            m_data = nullptr;
+            return;
+        }
+        memset(m_data, 0, l_bufSize);
+        m_good = m_host->allocMatRestricted(m_data, m_data, l_bufSize) == XFBLAS_STATUS_SUCCESS;
+    }
+    ~BlockedMat() {
+        if (m_data != nullptr) {
+            m_host->freeMat(m_data);
+            free(m_data);
+        }
+    }
+
+    bool good() const { return m_data != nullptr && m_good; }
+    void* data() const { return m_data; }
+    unsigned long long blockBytes() const { return (unsigned long long)m_blockSize * m_blockSize * sizeof(t_dataType); }
+    // byte offset of block (p_i, p_j) in the allocation
+    unsigned long long offset(unsigned int p_i, unsigned int p_j) const {
+        return ((unsigned long long)p_i * m_colBlocks + p_j) * blockBytes();
+    }
+    t_dataType& at(unsigned int p_row, unsigned int p_col) {
+        unsigned long long l_blk = offset(p_row / m_blockSize, p_col / m_blockSize) / sizeof(t_dataType);
+        return m_data[l_blk + IDX2R(p_row % m_blockSize, p_col % m_blockSize, m_blockSize)];
+    }
+    t_dataType* block(unsigned int p_i, unsigned int p_j) { return m_data + offset(p_i, p_j) / sizeof(t_dataType); }
+
+    xfblasStatus_t toDevice() { return m_host->setMatToFPGARestricted(m_data); }
+    xfblasStatus_t fromDevice() { return m_host->getMatRestricted(m_data, m_data); }
+
+   private:
+    GEMMHost* m_host;
+    unsigned int m_rowBlocks, m_colBlocks, m_blockSize;
+    t_dataType* m_data = nullptr;
+    bool m_good = false;
+};
+
+/*
+ * Emits C(i, j) += A(i, p) * B(p, j) block updates, and starts the kernel whenever
+ * the instruction buffer is full. Instructions run in order, so later updates see
+ * the results of earlier ones.
+ */
+class GEMMBlockProgram {
+   public:
+    GEMMBlockProgram(GEMMHost* p_host, unsigned int p_blockSize) : m_host(p_host), m_blockSize(p_blockSize) {
+        // instructions the user has queued but not run yet stay in front of the program,
+        // the ones of an earlier run are dropped
+        if (!m_host->hasPendingInstrs()) {
+            m_host->clearInstrBuf();
+        }
+    }
+
+    template <typename t_dataType>
+    xfblasStatus_t add(BlockedMat<t_dataType>& p_a,
+                       unsigned int p_ai,
+                       unsigned int p_aj,
+                       BlockedMat<t_dataType>& p_b,
+                       unsigned int p_bi,
+                       unsigned int p_bj,
+                       BlockedMat<t_dataType>& p_c,
+                       unsigned int p_ci,
+                       unsigned int p_cj) {
+        if (!m_host->hasInstrSpace(1, GemmArgs::instrSizeInBytes())) {
+            xfblasStatus_t l_status = flush();
+            if (l_status != XFBLAS_STATUS_SUCCESS) {
+                return l_status;
+            }
+        }
+        xfblasStatus_t l_status = m_host->addGEMMOffsetOp(
+            p_a.data(), p_a.offset(p_ai, p_aj), p_b.data(), p_b.offset(p_bi, p_bj), p_c.data(), p_c.offset(p_ci, p_cj),
+            m_blockSize, m_blockSize, m_blockSize, m_blockSize, m_blockSize, m_blockSize, 1, 0);
+        if (l_status == XFBLAS_STATUS_SUCCESS) {
+            m_queued++;
+        }
+        return l_status;
+    }
+
+    // runs the queued instructions and waits for them, nothing is started if the program has queued none
+    xfblasStatus_t flush() {
+        if (m_queued == 0) {
+            return XFBLAS_STATUS_SUCCESS;
+        }
+        xfblasStatus_t l_status = m_host->execute();
+        m_host->clearInstrBuf();
+        m_host->releaseExecHandles();
+        m_queued = 0;
+        return l_status;
+    }
+
+   private:
+    GEMMHost* m_host;
+    unsigned int m_blockSize;
+    unsigned int m_queued = 0;
+};
+
+// checks the library state for a level 3 routine, and returns the block size and the kernel
+template <typename t_dataType>
+xfblasStatus_t level3Setup(unsigned int p_kernelIndex,
+                           unsigned int p_deviceIndex,
+                           unsigned int* p_blockSize,
+                           GEMMHost** p_gemmPtr) {
+    if (ConfigDict::instance().m_dict.empty()) {
+        return XFBLAS_STATUS_NOT_INITIALIZED;
+    }
+    if (ConfigDict::instance().m_dict["GEMX_runGemm"] != "1") {
+        return XFBLAS_STATUS_NOT_SUPPORTED;
+    }
+    if (getTypeSize(ConfigDict::instance().m_dict["GEMX_dataType"]) != sizeof(t_dataType)) {
+        return XFBLAS_STATUS_INVALID_VALUE;
+    }
+    int l_minSize = stoi(ConfigDict::instance().m_dict["minSize"]);
+    *p_blockSize = getPaddedSize(XFBLAS_LEVEL3_BLOCK_SIZE, l_minSize);
+    if ((unsigned long long)(*p_blockSize) * (*p_blockSize) * sizeof(t_dataType) % 4096 != 0) {
+        return XFBLAS_STATUS_NOT_SUPPORTED;
+    }
+    *p_gemmPtr = static_cast<GEMMHost*>(BLASHostHandle::instance().m_handlePtr[p_deviceIndex][p_kernelIndex].get());
+    return XFBLAS_STATUS_SUCCESS;
+}
+
+// inverts the triangular block in place, returns false if a diagonal element is 0.
+// The inverse of an integer matrix is not an integer matrix, so t_dataType is a floating type.
+template <typename t_dataType>
+bool invertTriangularBlock(t_dataType* p_blk, unsigned int p_size, bool p_lower) {
+    vector<double> l_t(p_size * p_size), l_inv(p_size * p_size, 0);
+    // work on the lower triangle, inv(U) = inv(U^T)^T
+    for (unsigned int i = 0; i < p_size; i++) {
+        for (unsigned int j = 0; j < p_size; j++) {
+            l_t[IDX2R(i, j, p_size)] = p_lower ? p_blk[IDX2R(i, j, p_size)] : p_blk[IDX2R(j, i, p_size)];
+        }
+    }
+    for (unsigned int j = 0; j < p_size; j++) {
+        if (l_t[IDX2R(j, j, p_size)] == 0) {
+            return false;
+        }
+        l_inv[IDX2R(j, j, p_size)] = 1.0 / l_t[IDX2R(j, j, p_size)];
+        for (unsigned int i = j + 1; i < p_size; i++) {
+            double l_sum = 0;
+            for (unsigned int k = j; k < i; k++) {
+                l_sum += l_t[IDX2R(i, k, p_size)] * l_inv[IDX2R(k, j, p_size)];
+            }
+            l_inv[IDX2R(i, j, p_size)] = -l_sum / l_t[IDX2R(i, i, p_size)];
+        }
+    }
+    for (unsigned int i = 0; i < p_size; i++) {
+        for (unsigned int j = 0; j < p_size; j++) {
+            p_blk[IDX2R(i, j, p_size)] = p_lower ? l_inv[IDX2R(i, j, p_size)] : l_inv[IDX2R(j, i, p_size)];
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief This function solves the triangular system op(A)X = alpha*B or Xop(A) = alpha*B, and overwrites B with X.
+ * Matrices are row-major in the host memory. The diagonal blocks of op(A) are inverted on the host, and the blocked
+ * substitution is run on the device as GEMM instructions.
+ * @param side XFBLAS_SIDE_LEFT if op(A) is on the left of X, XFBLAS_SIDE_RIGHT otherwise
+ * @param uplo whether the lower or the upper triangle of A is used
+ * @param trans operation op(A) that is non- or (conj.) transpose
+ * @param diag XFBLAS_DIAG_UNIT if the diagonal elements of A are taken as 1
+ * @param m number of rows in matrix B
+ * @param n number of cols in matrix B
+ * @param alpha scalar used for multiplication
+ * @param A pointer to matrix A in the host memory, m x m for the left side and n x n for the right side
+ * @param lda leading dimension of matirx A
+ * @param B pointer to matrix B in the host memory
+ * @param ldb leading dimension of matrix B
+ * @param kernelIndex index of kernel that is being used, default is 0
+ * @param deviceIndex index of device that is being used, default is 0
+ * @retval xfblasStatus_t 0 if the operation completed successfully
+ * @retval xfblasStatus_t 1 if the library was not initialized
+ * @retval xfblasStatus_t 2 if m, n <= 0, A is singular, or the data type doesn't match the kernel
+ * @retval xfblasStatus_t 3 if the device buffers could not be allocated or transferred
+ * @retval xfblasStatus_t 4 if the engine is not supported for now, or the kernel data type is not float
+ */
+template <typename t_dataType>
+xfblasStatus_t xfblasTrsm(xfblasSideMode_t side,
+                          xfblasFillMode_t uplo,
+                          xfblasOperation_t trans,
+                          xfblasDiagType_t diag,
+                          int m,
+                          int n,
+                          t_dataType alpha,
+                          const t_dataType* A,
+                          int lda,
+                          t_dataType* B,
+                          int ldb,
+                          unsigned int kernelIndex = 0,
+                          unsigned int deviceIndex = 0) {
+    unsigned int l_bs;
+    GEMMHost* l_gemmPtr;
+    xfblasStatus_t l_status = level3Setup<t_dataType>(kernelIndex, deviceIndex, &l_bs, &l_gemmPtr);
+    if (l_status != XFBLAS_STATUS_SUCCESS) {
+        return l_status;
+    }
+    // the inverted diagonal blocks only exist in a floating type
+    if (!is_floating_point<t_dataType>::value || ConfigDict::instance().m_dict["GEMX_dataType"] != "float") {
+        return XFBLAS_STATUS_NOT_SUPPORTED;
+    }
+    if (m <= 0 || n <= 0) {
+        return XFBLAS_STATUS_INVALID_VALUE;
+    }
+
+    // XA = B is solved as A^T X^T = B^T, so that T X = R with triangular T on the left
+    bool l_left = side == XFBLAS_SIDE_LEFT;
+    bool l_transT = (trans != XFBLAS_OP_N) != !l_left;
+    bool l_lower = (uplo == XFBLAS_FILL_MODE_LOWER) != l_transT;
+    int l_tSize = l_left ? m : n;
+    int l_rCols = l_left ? n : m;
+    auto l_t = [&](int r, int c) -> t_dataType {
+        if (l_transT) {
+            swap(r, c);
+        }
+        bool l_inTri = (uplo == XFBLAS_FILL_MODE_LOWER) ? (r >= c) : (r <= c);
+        if (r == c && diag == XFBLAS_DIAG_UNIT) {
+            return 1;
+        }
+        return l_inTri ? A[IDX2R(r, c, lda)] : 0;
+    };
+
+    unsigned int l_tBlocks = (l_tSize + l_bs - 1) / l_bs;
+    unsigned int l_rBlocks = (l_rCols + l_bs - 1) / l_bs;
+    BlockedMat<t_dataType> l_diagInv(l_gemmPtr, l_tBlocks, 1, l_bs);
+    BlockedMat<t_dataType> l_negT(l_gemmPtr, l_tBlocks, l_tBlocks, l_bs);
+    BlockedMat<t_dataType> l_r(l_gemmPtr, l_tBlocks, l_rBlocks, l_bs);
+    BlockedMat<t_dataType> l_x(l_gemmPtr, l_tBlocks, l_rBlocks, l_bs);
+    if (!l_diagInv.good() || !l_negT.good() || !l_r.good() || !l_x.good()) {
+        return XFBLAS_STATUS_ALLOC_FAILED;
+    }
+
+    for (unsigned int r = 0; r < l_tBlocks * l_bs; r++) {
+        for (unsigned int c = 0; c < l_tBlocks * l_bs; c++) {
+            bool l_valid = (int)r < l_tSize && (int)c < l_tSize;
+            t_dataType l_val = l_valid ? l_t(r, c) : (r == c ? 1 : 0);
+            if (r / l_bs == c / l_bs) {
+                l_diagInv.at(r, c % l_bs) = l_val;
+            } else if ((r > c) == l_lower) {
+                l_negT.at(r, c) = -l_val;
+            }
+        }
+    }
+    for (unsigned int i = 0; i < l_tBlocks; i++) {
+        if (!invertTriangularBlock(l_diagInv.block(i, 0), l_bs, l_lower)) {
+            return XFBLAS_STATUS_INVALID_VALUE;
+        }
+    }
+    for (int r = 0; r < l_tSize; r++) {
+        for (int c = 0; c < l_rCols; c++) {
+            l_r.at(r, c) = alpha * (l_left ? B[IDX2R(r, c, ldb)] : B[IDX2R(c, r, ldb)]);
+        }
+    }
+    if (l_diagInv.toDevice() != XFBLAS_STATUS_SUCCESS || l_negT.toDevice() != XFBLAS_STATUS_SUCCESS ||
+        l_r.toDevice() != XFBLAS_STATUS_SUCCESS || l_x.toDevice() != XFBLAS_STATUS_SUCCESS) {
+        return XFBLAS_STATUS_ALLOC_FAILED;
+    }
+
+    // forward substitution for lower T, backward for upper T
+    GEMMBlockProgram l_prog(l_gemmPtr, l_bs);
+    for (unsigned int s = 0; s < l_tBlocks; s++) {
+        unsigned int i = l_lower ? s : l_tBlocks - 1 - s;
+        for (unsigned int t = 0; t < s; t++) {
+            unsigned int k = l_lower ? t : l_tBlocks - 1 - t;
+            for (unsigned int j = 0; j < l_rBlocks && l_status == XFBLAS_STATUS_SUCCESS; j++) {
+                l_status = l_prog.add(l_negT, i, k, l_x, k, j, l_r, i, j);
+            }
+        }
+        for (unsigned int j = 0; j < l_rBlocks && l_status == XFBLAS_STATUS_SUCCESS; j++) {
+            l_status = l_prog.add(l_diagInv, i, 0, l_r, i, j, l_x, i, j);
+        }
+    }
+    if (l_status == XFBLAS_STATUS_SUCCESS) {
+        l_status = l_prog.flush();
+    }
+    if (l_status != XFBLAS_STATUS_SUCCESS || l_x.fromDevice() != XFBLAS_STATUS_SUCCESS) {
+        return l_status != XFBLAS_STATUS_SUCCESS ? l_status : XFBLAS_STATUS_ALLOC_FAILED;
+    }
+    for (int r = 0; r < m; r++) {
+        for (int c = 0; c < n; c++) {
+            B[IDX2R(r, c, ldb)] = l_left ? l_x.at(r, c) : l_x.at(c, r);
+        }
+    }
+    return XFBLAS_STATUS_SUCCESS;
+}
+
+/**
+ * @brief This function performs the symmetric rank-k update C = alpha*op(A)op(A)^T + beta*C, where only the uplo
+ * triangle of C is updated. Matrices are row-major in the host memory. Only the blocks of the uplo triangle are
+ * computed on the device.
+ * @param uplo whether the lower or the upper triangle of C is updated
+ * @param trans operation op(A) that is non- or (conj.) transpose
+ * @param n number of rows and cols in matrix C, number of rows in matrix op(A)
+ * @param k number of cols in matrix op(A)
+ * @param alpha scalar used for multiplication
+ * @param A pointer to matrix A in the host memory
+ * @param lda leading dimension of matirx A
+ * @param beta scalar used for multiplication
+ * @param C pointer to matrix C in the host memory
+ * @param ldc leading dimension of matrix C
+ * @param kernelIndex index of kernel that is being used, default is 0
+ * @param deviceIndex index of device that is being used, default is 0
+ * @retval xfblasStatus_t 0 if the operation completed successfully
+ * @retval xfblasStatus_t 1 if the library was not initialized
+ * @retval xfblasStatus_t 2 if n, k <= 0, or the data type doesn't match the kernel
+ * @retval xfblasStatus_t 3 if the device buffers could not be allocated or transferred
+ * @retval xfblasStatus_t 4 if the engine is not supported for now
+ */
+template <typename t_dataType>
+xfblasStatus_t xfblasSyrk(xfblasFillMode_t uplo,
+                          xfblasOperation_t trans,
+                          int n,
+                          int k,
+                          t_dataType alpha,
+                          const t_dataType* A,
+                          int lda,
+                          t_dataType beta,
+                          t_dataType* C,
+                          int ldc,
+                          unsigned int kernelIndex = 0,
+                          unsigned int deviceIndex = 0) {
+    unsigned int l_bs;
+    GEMMHost* l_gemmPtr;
+    xfblasStatus_t l_status = level3Setup<t_dataType>(kernelIndex, deviceIndex, &l_bs, &l_gemmPtr);
+    if (l_status != XFBLAS_STATUS_SUCCESS) {
+        return l_status;
+    }
+    if (n <= 0 || k <= 0) {
+        return XFBLAS_STATUS_INVALID_VALUE;
+    }
+
+    bool l_lower = uplo == XFBLAS_FILL_MODE_LOWER;
+    unsigned int l_nBlocks = (n + l_bs - 1) / l_bs;
+    unsigned int l_kBlocks = (k + l_bs - 1) / l_bs;
+    BlockedMat<t_dataType> l_p(l_gemmPtr, l_nBlocks, l_kBlocks, l_bs);
+    BlockedMat<t_dataType> l_q(l_gemmPtr, l_kBlocks, l_nBlocks, l_bs);
+    BlockedMat<t_dataType> l_c(l_gemmPtr, l_nBlocks, l_nBlocks, l_bs);
+    if (!l_p.good() || !l_q.good() || !l_c.good()) {
+        return XFBLAS_STATUS_ALLOC_FAILED;
+    }
+
+    // P = alpha*op(A), Q = op(A)^T
+    for (int r = 0; r < n; r++) {
+        for (int c = 0; c < k; c++) {
+            t_dataType l_val = trans == XFBLAS_OP_N ? A[IDX2R(r, c, lda)] : A[IDX2R(c, r, lda)];
+            l_p.at(r, c) = alpha * l_val;
+            l_q.at(c, r) = l_val;
+        }
+    }
+    for (int r = 0; r < n; r++) {
+        for (int c = 0; c < n; c++) {
+            l_c.at(r, c) = beta * C[IDX2R(r, c, ldc)];
+        }
+    }
+    if (l_p.toDevice() != XFBLAS_STATUS_SUCCESS || l_q.toDevice() != XFBLAS_STATUS_SUCCESS ||
+        l_c.toDevice() != XFBLAS_STATUS_SUCCESS) {
+        return XFBLAS_STATUS_ALLOC_FAILED;
+    }
+
+    GEMMBlockProgram l_prog(l_gemmPtr, l_bs);
+    for (unsigned int i = 0; i < l_nBlocks; i++) {
+        unsigned int l_jBegin = l_lower ? 0 : i;
+        unsigned int l_jEnd = l_lower ? i + 1 : l_nBlocks;
+        for (unsigned int j = l_jBegin; j < l_jEnd; j++) {
+            for (unsigned int p = 0; p < l_kBlocks && l_status == XFBLAS_STATUS_SUCCESS; p++) {
+                l_status = l_prog.add(l_p, i, p, l_q, p, j, l_c, i, j);
+            }
+        }
+    }
+    if (l_status == XFBLAS_STATUS_SUCCESS) {
+        l_status = l_prog.flush();
+    }
+    if (l_status != XFBLAS_STATUS_SUCCESS || l_c.fromDevice() != XFBLAS_STATUS_SUCCESS) {
+        return l_status != XFBLAS_STATUS_SUCCESS ? l_status : XFBLAS_STATUS_ALLOC_FAILED;
+    }
+    for (int r = 0; r < n; r++) {
+        int l_cBegin = l_lower ? 0 : r;
+        int l_cEnd = l_lower ? r + 1 : n;
+        for (int c = l_cBegin; c < l_cEnd; c++) {
+            C[IDX2R(r, c, ldc)] = l_c.at(r, c);
+        }
+    }
+    return XFBLAS_STATUS_SUCCESS;
+}
+
+/**
+ * @brief This function performs the matrix-matrix multiplication C = alpha*AB + beta*C or C = alpha*BA + beta*C,
+ * where A is symmetric and only its uplo triangle is read. Matrices are row-major in the host memory.
+ * @param side XFBLAS_SIDE_LEFT if A is on the left of B, XFBLAS_SIDE_RIGHT otherwise
+ * @param uplo whether the lower or the upper triangle of A is used
+ * @param m number of rows in matrix B, matrix C
+ * @param n number of cols in matrix B, matrix C
+ * @param alpha scalar used for multiplication
+ * @param A pointer to matrix A in the host memory, m x m for the left side and n x n for the right side
+ * @param lda leading dimension of matirx A
+ * @param B pointer to matrix B in the host memory
+ * @param ldb leading dimension of matrix B
+ * @param beta scalar used for multiplication
+ * @param C pointer to matrix C in the host memory
+ * @param ldc leading dimension of matrix C
+ * @param kernelIndex index of kernel that is being used, default is 0
+ * @param deviceIndex index of device that is being used, default is 0
+ * @retval xfblasStatus_t 0 if the operation completed successfully
+ * @retval xfblasStatus_t 1 if the library was not initialized
+ * @retval xfblasStatus_t 2 if m, n <= 0, or the data type doesn't match the kernel
+ * @retval xfblasStatus_t 3 if the device buffers could not be allocated or transferred
+ * @retval xfblasStatus_t 4 if the engine is not supported for now
+ */
+template <typename t_dataType>
+xfblasStatus_t xfblasSymm(xfblasSideMode_t side,
+                          xfblasFillMode_t uplo,
+                          int m,
+                          int n,
+                          t_dataType alpha,
+                          const t_dataType* A,
+                          int lda,
+                          const t_dataType* B,
+                          int ldb,
+                          t_dataType beta,
+                          t_dataType* C,
+                          int ldc,
+                          unsigned int kernelIndex = 0,
+                          unsigned int deviceIndex = 0) {
+    unsigned int l_bs;
+    GEMMHost* l_gemmPtr;
+    xfblasStatus_t l_status = level3Setup<t_dataType>(kernelIndex, deviceIndex, &l_bs, &l_gemmPtr);
+    if (l_status != XFBLAS_STATUS_SUCCESS) {
+        return l_status;
+    }
+    if (m <= 0 || n <= 0) {
+        return XFBLAS_STATUS_INVALID_VALUE;
+    }
+
+    bool l_left = side == XFBLAS_SIDE_LEFT;
+    int l_aSize = l_left ? m : n;
+    unsigned int l_aBlocks = (l_aSize + l_bs - 1) / l_bs;
+    unsigned int l_mBlocks = (m + l_bs - 1) / l_bs;
+    unsigned int l_nBlocks = (n + l_bs - 1) / l_bs;
+    BlockedMat<t_dataType> l_a(l_gemmPtr, l_aBlocks, l_aBlocks, l_bs);
+    BlockedMat<t_dataType> l_b(l_gemmPtr, l_mBlocks, l_nBlocks, l_bs);
+    BlockedMat<t_dataType> l_c(l_gemmPtr, l_mBlocks, l_nBlocks, l_bs);
+    if (!l_a.good() || !l_b.good() || !l_c.good()) {
+        return XFBLAS_STATUS_ALLOC_FAILED;
+    }
+
+    // full alpha*A from its uplo triangle
+    for (int r = 0; r < l_aSize; r++) {
+        for (int c = 0; c < l_aSize; c++) {
+            bool l_inTri = (uplo == XFBLAS_FILL_MODE_LOWER) ? (r >= c) : (r <= c);
+            l_a.at(r, c) = alpha * (l_inTri ? A[IDX2R(r, c, lda)] : A[IDX2R(c, r, lda)]);
+        }
+    }
+    for (int r = 0; r < m; r++) {
+        for (int c = 0; c < n; c++) {
+            l_b.at(r, c) = B[IDX2R(r, c, ldb)];
+            l_c.at(r, c) = beta * C[IDX2R(r, c, ldc)];
+        }
+    }
+    if (l_a.toDevice() != XFBLAS_STATUS_SUCCESS || l_b.toDevice() != XFBLAS_STATUS_SUCCESS ||
+        l_c.toDevice() != XFBLAS_STATUS_SUCCESS) {
+        return XFBLAS_STATUS_ALLOC_FAILED;
+    }
+
+    GEMMBlockProgram l_prog(l_gemmPtr, l_bs);
+    for (unsigned int i = 0; i < l_mBlocks; i++) {
+        for (unsigned int j = 0; j < l_nBlocks; j++) {
+            for (unsigned int p = 0; p < l_aBlocks && l_status == XFBLAS_STATUS_SUCCESS; p++) {
+                l_status = l_left ? l_prog.add(l_a, i, p, l_b, p, j, l_c, i, j)
+                                  : l_prog.add(l_b, i, p, l_a, p, j, l_c, i, j);
+            }
+        }
+    }
+    if (l_status == XFBLAS_STATUS_SUCCESS) {
+        l_status = l_prog.flush();
+    }
+    if (l_status != XFBLAS_STATUS_SUCCESS || l_c.fromDevice() != XFBLAS_STATUS_SUCCESS) {
+        return l_status != XFBLAS_STATUS_SUCCESS ? l_status : XFBLAS_STATUS_ALLOC_FAILED;
+    }
+    for (int r = 0; r < m; r++) {
+        for (int c = 0; c < n; c++) {
+            C[IDX2R(r, c, ldc)] = l_c.at(r, c);
+        }
+    }
+    return XFBLAS_STATUS_SUCCESS;
+}
+
+} // namespace blas
+
+} // namespace xf
+
+#endif
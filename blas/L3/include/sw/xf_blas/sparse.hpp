@@ -0,0 +1,377 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef XF_BLAS_SPARSE_HPP
+#define XF_BLAS_SPARSE_HPP
+
+#include <vector>
+#include <future>
+#include <algorithm>
+
+#include "handle.hpp"
+#include "spmv_host.hpp"
+#include "bell.hpp"
+
+namespace xf {
+
+namespace blas {
+
+/*
+ * Rows [m_rowBegin, m_rowBegin + m_rows) of a CSR matrix in blocked-ELL format, as converted by csr2Bell.
+ * The buffer holds the 3 arrays of BellMat, each section starting on a page:
+ *   widths   uint32 words per row, for each column block and slice of rows
+ *   values   for each column block, slice and row, width words of parEntries values, zero padded
+ *   cols     same shape as values, column indices local to the column block
+ */
+template <typename t_dataType>
+class BellChunk {
+   public:
+    unsigned int m_rowBegin = 0, m_rows = 0, m_paddedRows = 0;
+    unsigned int m_kernelIndex = 0, m_numWords = 0;
+    unsigned long long m_widthOffset = 0, m_valOffset = 0, m_colOffset = 0, m_bufSize = 0;
+    char* m_buf = nullptr;
+};
+
+inline unsigned long long pageAlign(unsigned long long p_size) {
+    return (p_size + 4095) / 4096 * 4096;
+}
+
+/*
+ * Copies p_bell, holding rows from p_rowBegin, into the page aligned host buffer of p_chunk.
+ * Returns false if the buffer could not be allocated.
+ */
+template <typename t_dataType>
+bool packBell(const BellMat<t_dataType>& p_bell, unsigned int p_rowBegin, BellChunk<t_dataType>* p_chunk) {
+    p_chunk->m_rowBegin = p_rowBegin;
+    p_chunk->m_rows = p_bell.m_rows;
+    p_chunk->m_paddedRows = p_bell.m_paddedRows;
+    p_chunk->m_numWords = p_bell.m_val.size() / p_bell.m_parEntries;
+    p_chunk->m_widthOffset = 0;
+    p_chunk->m_valOffset = pageAlign(sizeof(unsigned int) * p_bell.m_width.size());
+    p_chunk->m_colOffset = p_chunk->m_valOffset + pageAlign(sizeof(t_dataType) * p_bell.m_val.size());
+    p_chunk->m_bufSize = p_chunk->m_colOffset + pageAlign(sizeof(unsigned int) * p_bell.m_col.size());
+    if (posix_memalign((void**)&p_chunk->m_buf, 4096, p_chunk->m_bufSize)) {
+        p_chunk->m_buf = nullptr;
+        return false;
+    }
+    memset(p_chunk->m_buf, 0, p_chunk->m_bufSize);
+    memcpy(p_chunk->m_buf + p_chunk->m_widthOffset, p_bell.m_width.data(),
+           sizeof(unsigned int) * p_bell.m_width.size());
+    memcpy(p_chunk->m_buf + p_chunk->m_valOffset, p_bell.m_val.data(), sizeof(t_dataType) * p_bell.m_val.size());
+    memcpy(p_chunk->m_buf + p_chunk->m_colOffset, p_bell.m_col.data(), sizeof(unsigned int) * p_bell.m_col.size());
+    return true;
+}
+
+/*
+ * Sparse matrix converted to blocked-ELL and stored on the devices.
+ * Rows are split into chunks of about the same number of nonzeros, and the chunks are distributed over the kernels,
+ * each kernel having its own memory channel. A chunk has at most GEMX_spmvMaxRows rows.
+ */
+template <typename t_dataType>
+class xfblasSpMat {
+   public:
+    int m_m = 0, m_n = 0;
+    unsigned int m_numKernel = 0, m_deviceIndex = 0;
+    unsigned int m_parEntries = 0, m_colBlock = 0, m_sliceRows = 0;
+    vector<BellChunk<t_dataType> > m_chunks;
+};
+
+/**
+ * @brief This function converts a CSR matrix to the blocked-ELL format of the sparse engine, and copies it to the
+ * memory of numKernel kernels
+ * @param spMat the sparse matrix to create
+ * @param m number of rows in the matrix
+ * @param n number of cols in the matrix
+ * @param rowPtr CSR row pointers, m + 1 entries starting from 0
+ * @param colIdx CSR column indices
+ * @param val CSR values
+ * @param numKernel number of kernels that the rows are distributed over, default is 1
+ * @param deviceIndex index of device that is being used, default is 0
+ * @retval xfblasStatus_t 0 if the operation completed successfully
+ * @retval xfblasStatus_t 1 if the library was not initialized
+ * @retval xfblasStatus_t 2 if m, n <= 0, a column index is out of range, or the data type doesn't match the kernel
+ * @retval xfblasStatus_t 3 if the matrix could not be allocated or transferred
+ * @retval xfblasStatus_t 4 if the engine is not supported for now
+ */
+template <typename t_dataType>
+xfblasStatus_t xfblasCreateSpMatCsr(xfblasSpMat<t_dataType>* spMat,
+                                    int m,
+                                    int n,
+                                    const int* rowPtr,
+                                    const int* colIdx,
+                                    const t_dataType* val,
+                                    unsigned int numKernel = 1,
+                                    unsigned int deviceIndex = 0) {
+    if (ConfigDict::instance().m_dict.empty()) {
+        return XFBLAS_STATUS_NOT_INITIALIZED;
+    }
+    if (ConfigDict::instance().m_dict["GEMX_runSpmv"] != "1") {
+        return XFBLAS_STATUS_NOT_SUPPORTED;
+    }
+    if (m <= 0 || n <= 0 || numKernel == 0 || numKernel > BLASHostHandle::instance().m_handlePtr[deviceIndex].size()) {
+        return XFBLAS_STATUS_INVALID_VALUE;
+    }
+    if (getTypeSize(ConfigDict::instance().m_dict["GEMX_dataType"]) != sizeof(t_dataType)) {
+        return XFBLAS_STATUS_INVALID_VALUE;
+    }
+    spMat->m_m = m;
+    spMat->m_n = n;
+    spMat->m_numKernel = numKernel;
+    spMat->m_deviceIndex = deviceIndex;
+    spMat->m_parEntries = stoi(ConfigDict::instance().m_dict["GEMX_ddrWidth"]);
+    spMat->m_colBlock = stoi(ConfigDict::instance().m_dict["GEMX_spmvColBlock"]);
+    spMat->m_sliceRows = spMat->m_parEntries;
+    unsigned int l_maxRows = stoi(ConfigDict::instance().m_dict["GEMX_spmvMaxRows"]);
+    l_maxRows -= l_maxRows % spMat->m_parEntries;
+
+    // chunk boundaries on equal shares of nonzeros, then split to fit in the row buffer of the kernel
+    unsigned int l_numChunks = max<unsigned int>(numKernel, (m + l_maxRows - 1) / l_maxRows);
+    vector<int> l_bounds(1, 0);
+    for (unsigned int c = 1; c <= l_numChunks; c++) {
+        long long l_target = (long long)rowPtr[m] * c / l_numChunks;
+        int l_row = c == l_numChunks ? m : lower_bound(rowPtr, rowPtr + m + 1, l_target) - rowPtr;
+        l_row = max(l_row, l_bounds.back());
+        while (l_row - l_bounds.back() > (int)l_maxRows) {
+            l_bounds.push_back(l_bounds.back() + l_maxRows);
+        }
+        if (l_row > l_bounds.back()) {
+            l_bounds.push_back(l_row);
+        }
+    }
+
+    spMat->m_chunks.resize(l_bounds.size() - 1);
+    for (unsigned int c = 0; c + 1 < l_bounds.size(); c++) {
+        BellChunk<t_dataType>& l_chunk = spMat->m_chunks[c];
+        l_chunk.m_kernelIndex = c % numKernel;
+        BellMat<t_dataType> l_bell;
+        if (!csr2Bell(l_bounds[c], l_bounds[c + 1], n, rowPtr, colIdx, val, spMat->m_parEntries, spMat->m_colBlock,
+                      spMat->m_sliceRows, l_bell)) {
+            return XFBLAS_STATUS_INVALID_VALUE;
+        }
+        if (!packBell(l_bell, l_bounds[c], &l_chunk)) {
+            return XFBLAS_STATUS_ALLOC_FAILED;
+        }
+        BLASHost* l_host = BLASHostHandle::instance().m_handlePtr[deviceIndex][l_chunk.m_kernelIndex].get();
+        if (l_host->allocMatRestricted(l_chunk.m_buf, l_chunk.m_buf, l_chunk.m_bufSize) != XFBLAS_STATUS_SUCCESS ||
+            l_host->setMatToFPGARestricted(l_chunk.m_buf) != XFBLAS_STATUS_SUCCESS) {
+            return XFBLAS_STATUS_ALLOC_FAILED;
+        }
+    }
+    return XFBLAS_STATUS_SUCCESS;
+}
+
+/**
+ * @brief This function frees the device and host memory of a sparse matrix
+ * @param spMat the sparse matrix to destroy
+ * @retval xfblasStatus_t 0 if the operation completed successfully
+ */
+template <typename t_dataType>
+xfblasStatus_t xfblasDestroySpMat(xfblasSpMat<t_dataType>* spMat) {
+    for (auto& l_chunk : spMat->m_chunks) {
+        if (l_chunk.m_buf != nullptr) {
+            BLASHostHandle::instance().m_handlePtr[spMat->m_deviceIndex][l_chunk.m_kernelIndex]->freeMat(l_chunk.m_buf);
+            free(l_chunk.m_buf);
+        }
+    }
+    spMat->m_chunks.clear();
+    return XFBLAS_STATUS_SUCCESS;
+}
+
+/*
+ * Runs Y = alpha * A * X + beta * Y for the chunks of one kernel. X and Y are row-major with k columns,
+ * and are packed into panels of parEntries columns on the device.
+ */
+template <typename t_dataType>
+xfblasStatus_t spmmOnKernel(const xfblasSpMat<t_dataType>& A,
+                            unsigned int kernelIndex,
+                            int k,
+                            t_dataType alpha,
+                            const t_dataType* X,
+                            int ldx,
+                            t_dataType beta,
+                            t_dataType* Y,
+                            int ldy) {
+    SPMVHost* l_host =
+        static_cast<SPMVHost*>(BLASHostHandle::instance().m_handlePtr[A.m_deviceIndex][kernelIndex].get());
+    unsigned int l_par = A.m_parEntries;
+    unsigned int l_paddedN = getPaddedSize(A.m_n, l_par);
+    // a vector stays a vector, a matrix is padded to whole panels
+    unsigned int l_kPanel = k == 1 ? 1 : l_par;
+    unsigned int l_numPanels = (k + l_kPanel - 1) / l_kPanel;
+    unsigned int l_paddedK = l_numPanels * l_kPanel;
+
+    vector<t_dataType*> l_bufs;
+    auto l_alloc = [&](unsigned long long p_size) -> t_dataType* {
+        t_dataType* l_ptr = nullptr;
+        if (posix_memalign((void**)&l_ptr, 4096, pageAlign(p_size))) {
+            return nullptr;
+        }
+        memset(l_ptr, 0, pageAlign(p_size));
+        l_bufs.push_back(l_ptr);
+        if (l_host->allocMatRestricted(l_ptr, l_ptr, pageAlign(p_size)) != XFBLAS_STATUS_SUCCESS) {
+            return nullptr;
+        }
+        return l_ptr;
+    };
+    auto l_release = [&](xfblasStatus_t p_status) {
+        for (auto l_ptr : l_bufs) {
+            l_host->freeMat(l_ptr);
+            free(l_ptr);
+        }
+        return p_status;
+    };
+    // element (r, c) of a matrix packed panel by panel
+    auto l_packed = [&](unsigned int p_rows, unsigned int r, unsigned int c) -> unsigned long long {
+        return ((unsigned long long)(c / l_kPanel) * p_rows + r) * l_kPanel + c % l_kPanel;
+    };
+
+    t_dataType* l_x = l_alloc((unsigned long long)l_paddedN * l_paddedK * sizeof(t_dataType));
+    if (l_x == nullptr) {
+        return l_release(XFBLAS_STATUS_ALLOC_FAILED);
+    }
+    for (int r = 0; r < A.m_n; r++) {
+        for (int c = 0; c < k; c++) {
+            l_x[l_packed(l_paddedN, r, c)] = alpha * X[IDX2R(r, c, ldx)];
+        }
+    }
+    if (l_host->setMatToFPGARestricted(l_x) != XFBLAS_STATUS_SUCCESS) {
+        return l_release(XFBLAS_STATUS_ALLOC_FAILED);
+    }
+
+    // the instructions run in order, and the kernel is started again when the instruction page is full
+    vector<pair<const BellChunk<t_dataType>*, t_dataType*> > l_outs;
+    for (auto& l_chunk : A.m_chunks) {
+        if (l_chunk.m_kernelIndex != kernelIndex) {
+            continue;
+        }
+        t_dataType* l_y = l_alloc((unsigned long long)l_chunk.m_paddedRows * l_paddedK * sizeof(t_dataType));
+        if (l_y == nullptr) {
+            return l_release(XFBLAS_STATUS_ALLOC_FAILED);
+        }
+        for (unsigned int r = 0; r < l_chunk.m_rows; r++) {
+            for (int c = 0; c < k; c++) {
+                l_y[l_packed(l_chunk.m_paddedRows, r, c)] = beta * Y[IDX2R(l_chunk.m_rowBegin + r, c, ldy)];
+            }
+        }
+        if (l_host->setMatToFPGARestricted(l_y) != XFBLAS_STATUS_SUCCESS) {
+            return l_release(XFBLAS_STATUS_ALLOC_FAILED);
+        }
+        if (!l_host->hasInstrSpace(1, SpmvArgs::instrSizeInBytes())) {
+            xfblasStatus_t l_status = l_host->execute();
+            l_host->clearInstrBuf();
+            if (l_status != XFBLAS_STATUS_SUCCESS) {
+                return l_release(l_status);
+            }
+        }
+        xfblasStatus_t l_status =
+            l_host->addSPMVOp(l_chunk.m_buf, l_chunk.m_widthOffset, l_chunk.m_valOffset, l_chunk.m_colOffset, l_x, l_y,
+                              l_chunk.m_paddedRows, l_paddedN, l_paddedK, A.m_colBlock, A.m_sliceRows,
+                              l_chunk.m_numWords);
+        if (l_status != XFBLAS_STATUS_SUCCESS) {
+            return l_release(l_status);
+        }
+        l_outs.push_back(make_pair(&l_chunk, l_y));
+    }
+    xfblasStatus_t l_status = l_host->execute();
+    l_host->clearInstrBuf();
+    l_host->releaseExecHandles();
+    if (l_status != XFBLAS_STATUS_SUCCESS) {
+        return l_release(l_status);
+    }
+
+    for (auto& l_out : l_outs) {
+        const BellChunk<t_dataType>& l_chunk = *l_out.first;
+        if (l_host->getMatRestricted(l_out.second, l_out.second) != XFBLAS_STATUS_SUCCESS) {
+            return l_release(XFBLAS_STATUS_ALLOC_FAILED);
+        }
+        for (unsigned int r = 0; r < l_chunk.m_rows; r++) {
+            for (int c = 0; c < k; c++) {
+                Y[IDX2R(l_chunk.m_rowBegin + r, c, ldy)] = l_out.second[l_packed(l_chunk.m_paddedRows, r, c)];
+            }
+        }
+    }
+    return l_release(XFBLAS_STATUS_SUCCESS);
+}
+
+/**
+ * @brief This function performs the sparse matrix-dense matrix multiplication Y = alpha*A*X + beta*Y, where X and Y
+ * are row-major in the host memory. The kernels holding the rows of A run in parallel.
+ * @param A the sparse matrix, created by xfblasCreateSpMatCsr
+ * @param k number of cols in matrix X, matrix Y
+ * @param alpha scalar used for multiplication
+ * @param X pointer to matrix X in the host memory, with as many rows as the cols of A
+ * @param ldx leading dimension of matrix X
+ * @param beta scalar used for multiplication
+ * @param Y pointer to matrix Y in the host memory, with as many rows as A
+ * @param ldy leading dimension of matrix Y
+ * @retval xfblasStatus_t 0 if the operation completed successfully
+ * @retval xfblasStatus_t 1 if the library was not initialized
+ * @retval xfblasStatus_t 2 if k <= 0 or A is empty
+ * @retval xfblasStatus_t 3 if the dense matrices could not be allocated or transferred
+ */
+template <typename t_dataType>
+xfblasStatus_t xfblasSpmm(const xfblasSpMat<t_dataType>& A,
+                          int k,
+                          t_dataType alpha,
+                          const t_dataType* X,
+                          int ldx,
+                          t_dataType beta,
+                          t_dataType* Y,
+                          int ldy) {
+    if (ConfigDict::instance().m_dict.empty()) {
+        return XFBLAS_STATUS_NOT_INITIALIZED;
+    }
+    if (k <= 0 || A.m_chunks.empty()) {
+        return XFBLAS_STATUS_INVALID_VALUE;
+    }
+    vector<future<xfblasStatus_t> > l_fuStatus;
+    for (unsigned int i = 0; i < A.m_numKernel; i++) {
+        l_fuStatus.push_back(
+            async(launch::async, spmmOnKernel<t_dataType>, cref(A), i, k, alpha, X, ldx, beta, Y, ldy));
+    }
+    xfblasStatus_t l_status = XFBLAS_STATUS_SUCCESS;
+    for (auto& fu : l_fuStatus) {
+        xfblasStatus_t l_kernelStatus = fu.get();
+        if (l_kernelStatus != XFBLAS_STATUS_SUCCESS) {
+            l_status = l_kernelStatus;
+        }
+    }
+    return l_status;
+}
+
+/**
+ * @brief This function performs the sparse matrix-vector multiplication y = alpha*A*x + beta*y
+ * @param A the sparse matrix, created by xfblasCreateSpMatCsr
+ * @param alpha scalar used for multiplication
+ * @param x pointer to vector x in the host memory
+ * @param beta scalar used for multiplication
+ * @param y pointer to vector y in the host memory
+ * @retval xfblasStatus_t 0 if the operation completed successfully
+ * @retval xfblasStatus_t 1 if the library was not initialized
+ * @retval xfblasStatus_t 2 if A is empty
+ * @retval xfblasStatus_t 3 if the vectors could not be allocated or transferred
+ */
+template <typename t_dataType>
+xfblasStatus_t xfblasSpmv(
+    const xfblasSpMat<t_dataType>& A, t_dataType alpha, const t_dataType* x, t_dataType beta, t_dataType* y) {
+    return xfblasSpmm(A, 1, alpha, x, 1, beta, y, 1);
+}
+
+} // namespace blas
+
+} // namespace xf
+
+#endif
@@ -0,0 +1,107 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef XF_BLAS_SPMV_HOST_HPP
+#define XF_BLAS_SPMV_HOST_HPP
+
+#include "handle.hpp"
+#include "host.hpp"
+
+namespace xf {
+
+namespace blas {
+
+class SpmvArgs : public BLASArgs {
+   public:
+    virtual ~SpmvArgs() {}
+    SpmvArgs() = delete;
+    SpmvArgs(unsigned int p_widthOffset,
+             unsigned int p_valOffset,
+             unsigned int p_colOffset,
+             unsigned int p_xOffset,
+             unsigned int p_yOffset,
+             unsigned int p_m,
+             unsigned int p_n,
+             unsigned int p_k,
+             unsigned int p_colBlock,
+             unsigned int p_sliceRows,
+             unsigned int p_numWords)
+        : m_SpmvArgs({int(OpSpmv), p_widthOffset, p_valOffset, p_colOffset, p_xOffset, p_yOffset, p_m, p_n, p_k,
+                      p_colBlock, p_sliceRows, p_numWords, 0, 0, 0, 0}) {}
+    size_t sizeInBytes() { return instrSizeInBytes(); }
+    static size_t instrSizeInBytes() { return sizeof(m_SpmvArgs); }
+    char* asByteArray() { return reinterpret_cast<char*>(&m_SpmvArgs); }
+
+   protected:
+    struct {
+        int m_optype;
+        unsigned int m_widthOffset, m_valOffset, m_colOffset, m_xOffset, m_yOffset, m_m, m_n, m_k, m_colBlock,
+            m_sliceRows, m_numWords;
+        int m_empty[4];
+    } m_SpmvArgs;
+};
+
+class SPMVHost : public BLASHost {
+   public:
+    SPMVHost() = delete;
+    virtual ~SPMVHost() {}
+    SPMVHost(const SPMVHost&) = delete;
+    SPMVHost(const char* p_xclbin, xfblasStatus_t* p_status, unsigned int p_kernelIndex, unsigned int p_deviceIndex)
+        : BLASHost(p_xclbin, p_status, p_kernelIndex, p_deviceIndex) {}
+
+    /*
+     * Adds Y = A * X + Y for one blocked-ELL matrix stored in p_a, with the widths, values and column indices
+     * p_widthOffset, p_valOffset and p_colOffset bytes into the allocation. p_k is 1 for a vector X.
+     * p_numWords is the number of value words, the same as the number of column index words.
+     */
+    virtual xfblasStatus_t addSPMVOp(void* p_a,
+                                     unsigned long long p_widthOffset,
+                                     unsigned long long p_valOffset,
+                                     unsigned long long p_colOffset,
+                                     void* p_x,
+                                     void* p_y,
+                                     unsigned int p_m,
+                                     unsigned int p_n,
+                                     unsigned int p_k,
+                                     unsigned int p_colBlock,
+                                     unsigned int p_sliceRows,
+                                     unsigned int p_numWords) {
+        if (p_widthOffset % this->PAGE_SIZE != 0 || p_valOffset % this->PAGE_SIZE != 0 ||
+            p_colOffset % this->PAGE_SIZE != 0) {
+            return XFBLAS_STATUS_INVALID_VALUE;
+        }
+        unsigned long long l_aOff, l_xOff, l_yOff;
+        if (!getPageOffset(p_a, &l_aOff) || !getPageOffset(p_x, &l_xOff) || !getPageOffset(p_y, &l_yOff)) {
+            return XFBLAS_STATUS_ALLOC_FAILED;
+        }
+        if (!this->hasInstrSpace(1, SpmvArgs::instrSizeInBytes())) {
+            return XFBLAS_STATUS_INVALID_VALUE;
+        }
+        SpmvArgs l_sargs(l_aOff + p_widthOffset / this->PAGE_SIZE, l_aOff + p_valOffset / this->PAGE_SIZE,
+                         l_aOff + p_colOffset / this->PAGE_SIZE, l_xOff, l_yOff, p_m, p_n, p_k, p_colBlock,
+                         p_sliceRows, p_numWords);
+        this->addInstr(&l_sargs);
+        this->enableRun();
+
+        return XFBLAS_STATUS_SUCCESS;
+    }
+};
+
+} // namespace blas
+
+} // namespace xf
+
+#endif
@@ -20,6 +20,7 @@
 #include "handle.hpp"
 #include "gemm_host.hpp"
 #include "gemv_host.hpp"
+#include "spmv_host.hpp"
 
 namespace xf {
 
@@ -78,6 +79,17 @@ xfblasStatus_t xfblasCreate(const char* xclbin,
         }
         return l_status;
 
+    } else if (engineName == XFBLAS_ENGINE_SPMV) {
+        if (ConfigDict::instance().m_dict["GEMX_runSpmv"] != "1") {
+            return XFBLAS_STATUS_INVALID_VALUE;
+        }
+
+        for (unsigned int i = 0; i < kernelNumber; i++) {
+            BLASHostHandle::instance().m_handlePtr[deviceIndex].push_back(
+                shared_ptr<BLASHost>(new SPMVHost(xclbin, &l_status, i, deviceIndex)));
+        }
+        return l_status;
+
     } else {
         return XFBLAS_STATUS_NOT_SUPPORTED;
     }
@@ -220,7 +232,9 @@ xfblasStatus_t xfblasMallocRestricted(
         return XFBLAS_STATUS_INVALID_VALUE;
     }
 
-    if (getTypeSize(ConfigDict::instance().m_dict["GEMX_dataType"]) != elemSize) {
+    auto& l_dict = ConfigDict::instance().m_dict;
+    if (getTypeSize(l_dict["GEMX_dataType"]) != elemSize && getGemmTypeSize(l_dict, "GEMX_macDataType") != elemSize &&
+        getGemmTypeSize(l_dict, "GEMX_cDataType") != elemSize) {
         return XFBLAS_STATUS_INVALID_VALUE;
     }
 
@@ -886,6 +900,222 @@ xfblasStatus_t xfblasGemm(xfblasOperation_t transa,
     }
 }
 
+/**
+ * @brief This function performs the matrix-matrix multiplication C = act(alpha*op(A)op(B) + X) with the bias add,
+ * activation and requantization fused in the GEMM kernel, so that C is written once
+ * @param transa operation op(A) that is non- or (conj.) transpose
+ * @param transb operation op(B) that is non- or (conj.) transpose
+ * @param m number of rows in matrix A, matrix C
+ * @param n number of cols in matrix B, matrix C
+ * @param k number of cols in matrix A, number of rows in matrix B
+ * @param alpha scalar used for multiplication
+ * @param A pointer to matrix A in the host memory, of GEMX_dataType
+ * @param lda leading dimension of matirx A
+ * @param B pointer to matrix B in the host memory, of GEMX_dataType
+ * @param ldb leading dimension of matrix B
+ * @param X pointer to bias matrix X in the host memory, of GEMX_macDataType, may be the same as C
+ * @param ldx leading dimension of matrix X
+ * @param C pointer to matrix C in the host memory, of GEMX_cDataType
+ * @param ldc leading dimension of matrix C
+ * @param activation activation applied after the bias add
+ * @param postScale integer results are multiplied by postScale
+ * @param postShift integer results are then shifted right by postShift with rounding, 0 <= postShift < 64
+ * @param kernelIndex index of kernel that is being used, default is 0
+ * @param deviceIndex index of device that is being used, default is 0
+ * @retval xfblasStatus_t 0 if the operation completed successfully
+ * @retval xfblasStatus_t 1 if the library was not initialized
+ * @retval xfblasStatus_t 2 if postShift is out of range
+ * @retval xfblasStatus_t 3 if not all the matrices have FPGA devie memory allocated
+ * @retval xfblasStatus_t 4 if the engine is not supported for now, or the kernel has no epilogue for the activation
+ */
+xfblasStatus_t xfblasGemmEx(xfblasOperation_t transa,
+                            xfblasOperation_t transb,
+                            int m,
+                            int n,
+                            int k,
+                            int alpha,
+                            void* A,
+                            int lda,
+                            void* B,
+                            int ldb,
+                            void* X,
+                            int ldx,
+                            void* C,
+                            int ldc,
+                            xfblasActivation_t activation,
+                            int postScale = 1,
+                            int postShift = 0,
+                            unsigned int kernelIndex = 0,
+                            unsigned int deviceIndex = 0) {
+    if (ConfigDict::instance().m_dict.empty()) {
+        return XFBLAS_STATUS_NOT_INITIALIZED;
+    }
+    if (ConfigDict::instance().m_dict["GEMX_runGemm"] != "1" || transa != XFBLAS_OP_N || transb != XFBLAS_OP_N ||
+        alpha != 1) {
+        return XFBLAS_STATUS_NOT_SUPPORTED;
+    }
+    if (postShift < 0 || postShift >= 64) {
+        return XFBLAS_STATUS_INVALID_VALUE;
+    }
+    // kernels built without the epilogue ignore the activation field of the instruction
+    if (activation != XFBLAS_ACTIVATION_NONE && ConfigDict::instance().m_dict["GEMX_gemmEpilogue"] != "1") {
+        return XFBLAS_STATUS_NOT_SUPPORTED;
+    }
+    GEMMHost* l_gemmPtr =
+        static_cast<GEMMHost*>(BLASHostHandle::instance().m_handlePtr[deviceIndex][kernelIndex].get());
+    int l_minSize = stoi(ConfigDict::instance().m_dict["minSize"]);
+    return l_gemmPtr->addGEMMOp(A, B, C, X, getPaddedSize(m, l_minSize), getPaddedSize(n, l_minSize),
+                                getPaddedSize(k, l_minSize), getPaddedSize(lda, l_minSize),
+                                getPaddedSize(ldb, l_minSize), getPaddedSize(ldc, l_minSize),
+                                getPaddedSize(ldx, l_minSize), postScale, postShift, activation);
+}
+
+/**
+ * @brief This function performs a batch of matrix-matrix multiplications C[i] = alpha*op(A[i])op(B[i]) + beta*C[i]
+ * with a single kernel start. One kernel start takes up to 63 multiplications, larger batches are split and all
+ * but the last 63 or fewer are run before the function returns
+ * @param transa operation op(A[i]) that is non- or (conj.) transpose
+ * @param transb operation op(B[i]) that is non- or (conj.) transpose
+ * @param m number of rows in matrix A[i], matrix C[i]
+ * @param n number of cols in matrix B[i], matrix C[i]
+ * @param k number of cols in matrix A[i], number of rows in matrix B[i]
+ * @param alpha scalar used for multiplication
+ * @param Aarray array of pointers to matrix A[i] in the host memory
+ * @param lda leading dimension of matirx A[i]
+ * @param Barray array of pointers to matrix B[i] in the host memory
+ * @param ldb leading dimension of matrix B[i]
+ * @param beta scalar used for multiplication
+ * @param Carray array of pointers to matrix C[i] in the host memory
+ * @param ldc leading dimension of matrix C[i]
+ * @param batchCount number of multiplications in the batch
+ * @param kernelIndex index of kernel that is being used, default is 0
+ * @param deviceIndex index of device that is being used, default is 0
+ * @retval xfblasStatus_t 0 if the operation completed successfully
+ * @retval xfblasStatus_t 1 if the library was not initialized
+ * @retval xfblasStatus_t 2 if batchCount <= 0
+ * @retval xfblasStatus_t 3 if not all the matrices have FPGA devie memory allocated
+ * @retval xfblasStatus_t 4 if the engine is not supported for now
+ */
+xfblasStatus_t xfblasGemmBatched(xfblasOperation_t transa,
+                                 xfblasOperation_t transb,
+                                 int m,
+                                 int n,
+                                 int k,
+                                 int alpha,
+                                 void* const Aarray[],
+                                 int lda,
+                                 void* const Barray[],
+                                 int ldb,
+                                 int beta,
+                                 void* const Carray[],
+                                 int ldc,
+                                 int batchCount,
+                                 unsigned int kernelIndex = 0,
+                                 unsigned int deviceIndex = 0) {
+    if (ConfigDict::instance().m_dict.empty()) {
+        return XFBLAS_STATUS_NOT_INITIALIZED;
+    }
+    if (batchCount <= 0) {
+        return XFBLAS_STATUS_INVALID_VALUE;
+    }
+    if (ConfigDict::instance().m_dict["GEMX_runGemm"] == "1") {
+        if (transa == XFBLAS_OP_N && transb == XFBLAS_OP_N && alpha == 1 && beta == 1) {
+            GEMMHost* l_gemmPtr =
+                static_cast<GEMMHost*>(BLASHostHandle::instance().m_handlePtr[deviceIndex][kernelIndex].get());
+            int l_minSize = stoi(ConfigDict::instance().m_dict["minSize"]);
+            return l_gemmPtr->addGEMMBatchedOp(
+                Aarray, Barray, Carray, getPaddedSize(m, l_minSize), getPaddedSize(n, l_minSize),
+                getPaddedSize(k, l_minSize), getPaddedSize(lda, l_minSize), getPaddedSize(ldb, l_minSize),
+                getPaddedSize(ldc, l_minSize), batchCount, 1, 0);
+        } else {
+            return XFBLAS_STATUS_NOT_SUPPORTED;
+        }
+    } else {
+        return XFBLAS_STATUS_NOT_SUPPORTED;
+    }
+}
+
+/**
+ * @brief This function performs a batch of matrix-matrix multiplications C[i] = alpha*op(A[i])op(B[i]) + beta*C[i]
+ * with a single kernel start, where A[i] = A + i*strideA, B[i] = B + i*strideB and C[i] = C + i*strideC
+ * are stored in 3 contiguous allocations. One kernel start takes up to 63 multiplications, larger batches are split
+ * and all but the last 63 or fewer are run before the function returns
+ * @param transa operation op(A[i]) that is non- or (conj.) transpose
+ * @param transb operation op(B[i]) that is non- or (conj.) transpose
+ * @param m number of rows in matrix A[i], matrix C[i]
+ * @param n number of cols in matrix B[i], matrix C[i]
+ * @param k number of cols in matrix A[i], number of rows in matrix B[i]
+ * @param alpha scalar used for multiplication
+ * @param A pointer to the allocation of all A[i] in the host memory
+ * @param lda leading dimension of matirx A[i]
+ * @param strideA number of elements between A[i] and A[i+1], strideA * elemSize must be a multiple of 4096
+ * @param B pointer to the allocation of all B[i] in the host memory
+ * @param ldb leading dimension of matrix B[i]
+ * @param strideB number of elements between B[i] and B[i+1], strideB * elemSize must be a multiple of 4096
+ * @param beta scalar used for multiplication
+ * @param C pointer to the allocation of all C[i] in the host memory
+ * @param ldc leading dimension of matrix C[i]
+ * @param strideC number of elements between C[i] and C[i+1], strideC * elemSize must be a multiple of 4096
+ * @param batchCount number of multiplications in the batch
+ * @param kernelIndex index of kernel that is being used, default is 0
+ * @param deviceIndex index of device that is being used, default is 0
+ * @retval xfblasStatus_t 0 if the operation completed successfully
+ * @retval xfblasStatus_t 1 if the library was not initialized
+ * @retval xfblasStatus_t 2 if batchCount <= 0, strides are not page aligned or the batch exceeds the allocations
+ * @retval xfblasStatus_t 3 if not all the matrices have FPGA devie memory allocated
+ * @retval xfblasStatus_t 4 if the engine is not supported for now
+ */
+xfblasStatus_t xfblasGemmStridedBatched(xfblasOperation_t transa,
+                                        xfblasOperation_t transb,
+                                        int m,
+                                        int n,
+                                        int k,
+                                        int alpha,
+                                        void* A,
+                                        int lda,
+                                        long long strideA,
+                                        void* B,
+                                        int ldb,
+                                        long long strideB,
+                                        int beta,
+                                        void* C,
+                                        int ldc,
+                                        long long strideC,
+                                        int batchCount,
+                                        unsigned int kernelIndex = 0,
+                                        unsigned int deviceIndex = 0) {
+    if (ConfigDict::instance().m_dict.empty()) {
+        return XFBLAS_STATUS_NOT_INITIALIZED;
+    }
+    if (batchCount <= 0 || strideA < 0 || strideB < 0 || strideC < 0) {
+        return XFBLAS_STATUS_INVALID_VALUE;
+    }
+    if (ConfigDict::instance().m_dict["GEMX_runGemm"] == "1") {
+        if (transa == XFBLAS_OP_N && transb == XFBLAS_OP_N && alpha == 1 && beta == 1) {
+            GEMMHost* l_gemmPtr =
+                static_cast<GEMMHost*>(BLASHostHandle::instance().m_handlePtr[deviceIndex][kernelIndex].get());
+            int l_minSize = stoi(ConfigDict::instance().m_dict["minSize"]);
+            unsigned long long l_elemSize = getTypeSize(ConfigDict::instance().m_dict["GEMX_dataType"]);
+            int padded_m = getPaddedSize(m, l_minSize);
+            int padded_n = getPaddedSize(n, l_minSize);
+            int padded_k = getPaddedSize(k, l_minSize);
+            int paddedLda = getPaddedSize(lda, l_minSize);
+            int paddedLdb = getPaddedSize(ldb, l_minSize);
+            int paddedLdc = getPaddedSize(ldc, l_minSize);
+            return l_gemmPtr->addGEMMStridedBatchedOp(
+                A, B, C, strideA * l_elemSize, strideB * l_elemSize, strideC * l_elemSize,
+                (unsigned long long)padded_m * paddedLda * l_elemSize,
+                (unsigned long long)padded_k * paddedLdb * l_elemSize,
+                (unsigned long long)padded_m * paddedLdc * l_elemSize, padded_m, padded_n, padded_k, paddedLda,
+                paddedLdb, paddedLdc, batchCount, 1, 0);
+        } else {
+            return XFBLAS_STATUS_NOT_SUPPORTED;
+        }
+    } else {
+        return XFBLAS_STATUS_NOT_SUPPORTED;
+    }
+}
+
 /**
  * @brief This function performs the matrix-vector multiplication y = alpha*op(A) x+ beta*y
  * @param transa operation op(A) that is non- or (conj.) transpose
@@ -58,11 +58,13 @@ class XfblasRT():
       self.offset_list = [2]
       for w in wgt:
           self._wshape.append(w.shape)
+      # int8 kernels accumulate in int32 like int16 ones, so only the weights and activations get narrower
+      self._qtype = np.int8 if xclbin_opts["GEMX_dataType"] == "int8_t" else np.int16
       if xclbin_opts["GEMX_dataType"] == "float":
           self._qw = wgt
           self.bias = bias
       else:
-          self._qw = [np.int16(np.around(a*b)) for a,b in zip(wgt, wgt_scale)]
+          self._qw = [self.quantize(a*b) for a,b in zip(wgt, wgt_scale)]
           self.bias = [np.int32(np.around(a*b)) for a,b in zip(bias, bias_scale)]
           
       for i,b in enumerate(self._qw):
@@ -79,6 +81,10 @@ class XfblasRT():
       self.idxKernel = idxKernel
       self.idxDevice = idxDevice
       
+  def quantize(self, a):
+      info = np.iinfo(self._qtype)
+      return np.clip(np.around(a), info.min, info.max).astype(self._qtype)
+
   def get_offset(self,w):
       return int(w.shape[0]*w.shape[1]*w.itemsize/4096+self.offset_list[-1])
   
@@ -137,7 +143,7 @@ class XfblasRT():
         np.copyto(self.fpga_buf[0],  padded_arr, casting='same_kind', where=True)
       else:
         padded_arr = self.format_for_fpga(inp * in_scale, self.min_k, self.min_n)
-        np.copyto(self.fpga_buf[0],  np.int16(np.around(padded_arr)), casting='same_kind', where=True)
+        np.copyto(self.fpga_buf[0],  self.quantize(padded_arr), casting='same_kind', where=True)
       for i in self.fpga_buf:
         xfblas.sendMat(i,self.idxKernel,self.idxDevice)
       self.loadInstr()
@@ -165,7 +171,7 @@ class XfblasRT():
         np.copyto(self.fpga_buf[0],  padded_arr, casting='same_kind', where=True)
       else:
         padded_arr = self.format_for_fpga(inp * in_scale, self.min_k, self.min_n)
-        np.copyto(self.fpga_buf[0],  np.int16(np.around(padded_arr)), casting='same_kind', where=True)
+        np.copyto(self.fpga_buf[0],  self.quantize(padded_arr), casting='same_kind', where=True)
       for i in self.fpga_buf:
         self.offset_list.append(self.get_offset(i))
       xfblas.sendMat(self.fpga_buf[0],self.idxKernel,self.idxDevice)
@@ -195,7 +201,7 @@ class XfblasRT():
         np.copyto(self.fpga_buf[0],  padded_arr, casting='same_kind', where=True)
       else:
         padded_arr = self.format_for_fpga(inp * in_scale, self.min_k, self.min_n)
-        np.copyto(self.fpga_buf[0],  np.int16(np.around(padded_arr)), casting='same_kind', where=True)
+        np.copyto(self.fpga_buf[0],  self.quantize(padded_arr), casting='same_kind', where=True)
       for i in self.fpga_buf:
         self.offset_list.append(self.get_offset(i))
       xfblas.sendMat(self.fpga_buf[0],self.idxKernel,self.idxDevice)
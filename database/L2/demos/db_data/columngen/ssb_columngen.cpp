@@ -0,0 +1,317 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "ssb/ssb_read.hpp"
+#include "utils.hpp"
+
+#include <cstdio>
+#include <fstream>
+// C++11 thread
+#include <thread>
+#include <cstring>
+
+// ------------------------------------------------------------
+
+template <typename T>
+void read_tbl(std::string _path, std::vector<T>& _vec) {
+    std::ifstream ifs;
+    ifs.open(_path, std::ios_base::in);
+    if (!ifs) {
+        printf("ERROR: %s cannot ben opened for read.\n", _path.c_str());
+        return;
+    }
+    // read data line
+    while (ifs) {
+        T t;
+        ifs >> t;
+        if (ifs) {
+            _vec.push_back(t);
+        }
+    }
+    ifs.close();
+    printf("INFO: Loaded %s from disk.\n", _path.c_str());
+}
+
+// ------------------------------------------------------------
+
+void columnize_lo(lineorder_t* buf_lo,
+                  size_t nrow, //
+                  TPCH_INT* col_lo_orderdate,
+                  TPCH_INT* col_lo_custkey,
+                  TPCH_INT* col_lo_partkey,
+                  TPCH_INT* col_lo_suppkey,
+                  TPCH_INT* col_lo_quantity,
+                  TPCH_INT* col_lo_extendedprice,
+                  TPCH_INT* col_lo_discount,
+                  TPCH_INT* col_lo_revenue,
+                  TPCH_INT* col_lo_supplycost) {
+    for (size_t i = 0; i < nrow; ++i) {
+        col_lo_orderdate[i] = buf_lo[i].orderdate;
+        col_lo_custkey[i] = buf_lo[i].custkey;
+        col_lo_partkey[i] = buf_lo[i].partkey;
+        col_lo_suppkey[i] = buf_lo[i].suppkey;
+        col_lo_quantity[i] = buf_lo[i].quantity;
+        col_lo_extendedprice[i] = buf_lo[i].extendedprice;
+        col_lo_discount[i] = buf_lo[i].discount;
+        col_lo_revenue[i] = buf_lo[i].revenue;
+        col_lo_supplycost[i] = buf_lo[i].supplycost;
+    }
+}
+
+void columnize_d(date_t* buf_d,
+                 size_t nrow, //
+                 TPCH_INT* col_d_datekey,
+                 TPCH_INT* col_d_year,
+                 TPCH_INT* col_d_yearmonthnum,
+                 TPCH_INT* col_d_weeknuminyear) {
+    for (size_t i = 0; i < nrow; ++i) {
+        col_d_datekey[i] = buf_d[i].datekey;
+        col_d_year[i] = buf_d[i].year;
+        col_d_yearmonthnum[i] = buf_d[i].yearmonthnum;
+        col_d_weeknuminyear[i] = buf_d[i].weeknuminyear;
+    }
+}
+
+void columnize_c(ssb_customer_t* buf_c,
+                 size_t nrow, //
+                 TPCH_INT* col_c_custkey,
+                 TPCH_INT* col_c_city,
+                 TPCH_INT* col_c_nation,
+                 TPCH_INT* col_c_region) {
+    for (size_t i = 0; i < nrow; ++i) {
+        col_c_custkey[i] = buf_c[i].custkey;
+        col_c_city[i] = ssb_city_id(buf_c[i].city.data);
+        col_c_nation[i] = ssb_nation_id(buf_c[i].nation.data);
+        col_c_region[i] = ssb_region_id(buf_c[i].region.data);
+    }
+}
+
+void columnize_s(ssb_supplier_t* buf_s,
+                 size_t nrow, //
+                 TPCH_INT* col_s_suppkey,
+                 TPCH_INT* col_s_city,
+                 TPCH_INT* col_s_nation,
+                 TPCH_INT* col_s_region) {
+    for (size_t i = 0; i < nrow; ++i) {
+        col_s_suppkey[i] = buf_s[i].suppkey;
+        col_s_city[i] = ssb_city_id(buf_s[i].city.data);
+        col_s_nation[i] = ssb_nation_id(buf_s[i].nation.data);
+        col_s_region[i] = ssb_region_id(buf_s[i].region.data);
+    }
+}
+
+void columnize_p(ssb_part_t* buf_p,
+                 size_t nrow, //
+                 TPCH_INT* col_p_partkey,
+                 TPCH_INT* col_p_mfgr,
+                 TPCH_INT* col_p_category,
+                 TPCH_INT* col_p_brand1) {
+    for (size_t i = 0; i < nrow; ++i) {
+        col_p_partkey[i] = buf_p[i].partkey;
+        col_p_mfgr[i] = ssb_mfgr_id(buf_p[i].mfgr.data);
+        col_p_category[i] = ssb_mfgr_id(buf_p[i].category.data);
+        col_p_brand1[i] = ssb_mfgr_id(buf_p[i].brand1.data);
+    }
+}
+
+// ------------------------------------------------------------
+
+template <typename T>
+int write_to_file(const std::string& fn, const std::vector<T>& d) {
+    FILE* f = fopen(fn.c_str(), "wb");
+    if (!f) {
+        printf("ERROR: %s cannot be opened for write.\n", fn.c_str());
+        return 1;
+    }
+    int n = fwrite(d.data(), sizeof(T), d.size(), f);
+    fclose(f);
+    return n;
+}
+
+int main(int argc, const char* argv[]) {
+    // cmd arg parser.
+    ArgParser parser(argc, argv);
+
+    int err = 0;
+
+    std::string in_dir = ".";
+    parser.getCmdOption("-in", in_dir);
+    if (!is_dir(in_dir)) {
+        printf("ERROR: \"%s\" is not a directory!\n", in_dir.c_str());
+        ++err;
+    }
+
+    std::string lo_path = in_dir + "/lineorder.tbl";
+    if (!is_file(lo_path)) {
+        printf("ERROR: \"%s\" is not a file!\n", lo_path.c_str());
+        ++err;
+    }
+    std::string d_path = in_dir + "/date.tbl";
+    if (!is_file(d_path)) {
+        printf("ERROR: \"%s\" is not a file!\n", d_path.c_str());
+        ++err;
+    }
+    std::string c_path = in_dir + "/customer.tbl";
+    if (!is_file(c_path)) {
+        printf("ERROR: \"%s\" is not a file!\n", c_path.c_str());
+        ++err;
+    }
+    std::string s_path = in_dir + "/supplier.tbl";
+    if (!is_file(s_path)) {
+        printf("ERROR: \"%s\" is not a file!\n", s_path.c_str());
+        ++err;
+    }
+    std::string p_path = in_dir + "/part.tbl";
+    if (!is_file(p_path)) {
+        printf("ERROR: \"%s\" is not a file!\n", p_path.c_str());
+        ++err;
+    }
+
+    std::string out_dir = ".";
+    parser.getCmdOption("-out", out_dir);
+    if (!is_dir(out_dir)) {
+        printf("ERROR: \"%s\" is not a directory!\n", out_dir.c_str());
+        ++err;
+    }
+
+    if (err) return err;
+
+    // set up input data and buffers
+
+    std::vector<lineorder_t> lo_vec;
+    std::vector<date_t> d_vec;
+    std::vector<ssb_customer_t> c_vec;
+    std::vector<ssb_supplier_t> s_vec;
+    std::vector<ssb_part_t> p_vec;
+
+    std::thread lo_thread;
+    std::thread d_thread;
+    std::thread c_thread;
+    std::thread s_thread;
+    std::thread p_thread;
+
+    struct timeval tv0, tv1;
+    int usec;
+
+    gettimeofday(&tv0, 0);
+
+    lo_thread = std::thread(read_tbl<lineorder_t>, lo_path, std::ref(lo_vec));
+    d_thread = std::thread(read_tbl<date_t>, d_path, std::ref(d_vec));
+    c_thread = std::thread(read_tbl<ssb_customer_t>, c_path, std::ref(c_vec));
+    s_thread = std::thread(read_tbl<ssb_supplier_t>, s_path, std::ref(s_vec));
+    p_thread = std::thread(read_tbl<ssb_part_t>, p_path, std::ref(p_vec));
+
+    lo_thread.join();
+    d_thread.join();
+    c_thread.join();
+    s_thread.join();
+    p_thread.join();
+
+    gettimeofday(&tv1, 0);
+    usec = tvdiff(&tv0, &tv1);
+    printf("Time to load table: %d usec.\n", usec);
+
+    size_t lo_nrow = lo_vec.size();
+    std::vector<TPCH_INT> col_lo_orderdate(lo_nrow);
+    std::vector<TPCH_INT> col_lo_custkey(lo_nrow);
+    std::vector<TPCH_INT> col_lo_partkey(lo_nrow);
+    std::vector<TPCH_INT> col_lo_suppkey(lo_nrow);
+    std::vector<TPCH_INT> col_lo_quantity(lo_nrow);
+    std::vector<TPCH_INT> col_lo_extendedprice(lo_nrow);
+    std::vector<TPCH_INT> col_lo_discount(lo_nrow);
+    std::vector<TPCH_INT> col_lo_revenue(lo_nrow);
+    std::vector<TPCH_INT> col_lo_supplycost(lo_nrow);
+
+    size_t d_nrow = d_vec.size();
+    std::vector<TPCH_INT> col_d_datekey(d_nrow);
+    std::vector<TPCH_INT> col_d_year(d_nrow);
+    std::vector<TPCH_INT> col_d_yearmonthnum(d_nrow);
+    std::vector<TPCH_INT> col_d_weeknuminyear(d_nrow);
+
+    size_t c_nrow = c_vec.size();
+    std::vector<TPCH_INT> col_c_custkey(c_nrow);
+    std::vector<TPCH_INT> col_c_city(c_nrow);
+    std::vector<TPCH_INT> col_c_nation(c_nrow);
+    std::vector<TPCH_INT> col_c_region(c_nrow);
+
+    size_t s_nrow = s_vec.size();
+    std::vector<TPCH_INT> col_s_suppkey(s_nrow);
+    std::vector<TPCH_INT> col_s_city(s_nrow);
+    std::vector<TPCH_INT> col_s_nation(s_nrow);
+    std::vector<TPCH_INT> col_s_region(s_nrow);
+
+    size_t p_nrow = p_vec.size();
+    std::vector<TPCH_INT> col_p_partkey(p_nrow);
+    std::vector<TPCH_INT> col_p_mfgr(p_nrow);
+    std::vector<TPCH_INT> col_p_category(p_nrow);
+    std::vector<TPCH_INT> col_p_brand1(p_nrow);
+
+    gettimeofday(&tv0, 0);
+
+    lo_thread = std::thread(columnize_lo, lo_vec.data(), lo_nrow, col_lo_orderdate.data(), col_lo_custkey.data(),
+                            col_lo_partkey.data(), col_lo_suppkey.data(), col_lo_quantity.data(),
+                            col_lo_extendedprice.data(), col_lo_discount.data(), col_lo_revenue.data(),
+                            col_lo_supplycost.data());
+    d_thread = std::thread(columnize_d, d_vec.data(), d_nrow, col_d_datekey.data(), col_d_year.data(),
+                           col_d_yearmonthnum.data(), col_d_weeknuminyear.data());
+    c_thread = std::thread(columnize_c, c_vec.data(), c_nrow, col_c_custkey.data(), col_c_city.data(),
+                           col_c_nation.data(), col_c_region.data());
+    s_thread = std::thread(columnize_s, s_vec.data(), s_nrow, col_s_suppkey.data(), col_s_city.data(),
+                           col_s_nation.data(), col_s_region.data());
+    p_thread = std::thread(columnize_p, p_vec.data(), p_nrow, col_p_partkey.data(), col_p_mfgr.data(),
+                           col_p_category.data(), col_p_brand1.data());
+
+    lo_thread.join();
+    d_thread.join();
+    c_thread.join();
+    s_thread.join();
+    p_thread.join();
+
+    gettimeofday(&tv1, 0);
+    usec = tvdiff(&tv0, &tv1);
+    printf("Time to columnize tables: %d usec.\n", usec);
+
+    write_to_file(out_dir + "/lo_orderdate.dat", col_lo_orderdate);
+    write_to_file(out_dir + "/lo_custkey.dat", col_lo_custkey);
+    write_to_file(out_dir + "/lo_partkey.dat", col_lo_partkey);
+    write_to_file(out_dir + "/lo_suppkey.dat", col_lo_suppkey);
+    write_to_file(out_dir + "/lo_quantity.dat", col_lo_quantity);
+    write_to_file(out_dir + "/lo_extendedprice.dat", col_lo_extendedprice);
+    write_to_file(out_dir + "/lo_discount.dat", col_lo_discount);
+    write_to_file(out_dir + "/lo_revenue.dat", col_lo_revenue);
+    write_to_file(out_dir + "/lo_supplycost.dat", col_lo_supplycost);
+
+    write_to_file(out_dir + "/d_datekey.dat", col_d_datekey);
+    write_to_file(out_dir + "/d_year.dat", col_d_year);
+    write_to_file(out_dir + "/d_yearmonthnum.dat", col_d_yearmonthnum);
+    write_to_file(out_dir + "/d_weeknuminyear.dat", col_d_weeknuminyear);
+
+    write_to_file(out_dir + "/c_custkey.dat", col_c_custkey);
+    write_to_file(out_dir + "/c_city.dat", col_c_city);
+    write_to_file(out_dir + "/c_nation.dat", col_c_nation);
+    write_to_file(out_dir + "/c_region.dat", col_c_region);
+
+    write_to_file(out_dir + "/s_suppkey.dat", col_s_suppkey);
+    write_to_file(out_dir + "/s_city.dat", col_s_city);
+    write_to_file(out_dir + "/s_nation.dat", col_s_nation);
+    write_to_file(out_dir + "/s_region.dat", col_s_region);
+
+    write_to_file(out_dir + "/p_partkey.dat", col_p_partkey);
+    write_to_file(out_dir + "/p_mfgr.dat", col_p_mfgr);
+    write_to_file(out_dir + "/p_category.dat", col_p_category);
+    write_to_file(out_dir + "/p_brand1.dat", col_p_brand1);
+
+    return 0;
+}
@@ -0,0 +1,140 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef GQE_SSB_CFG_H
+#define GQE_SSB_CFG_H
+
+#include "ap_int.h"
+
+#include "xf_database/dynamic_alu_host.hpp"
+#include "xf_database/enums.hpp"
+
+#include "ssb_plan.hpp"
+
+#include <cstring>
+
+/* filter
+ * (lo_0 <= col:0 <= hi_0) AND (lo_1 <= col:1 <= hi_1) AND ... AND (lo_3 <= col:3 <= hi_3)
+ * or, when or12 is set,
+ * (lo_0 <= col:0 <= hi_0) AND ((lo_1 <= col:1 <= hi_1) OR (lo_2 <= col:2 <= hi_2)) AND (lo_3 <= col:3 <= hi_3)
+ * INT32_MIN as lo or INT32_MAX as hi leaves that side unbounded.
+ */
+static void gen_ssb_fcfg(uint32_t cfg[], const SsbFilter& f) {
+    using namespace xf::database;
+    int n = 0;
+
+    // cond_1 ~ cond_4
+    for (int i = 0; i < 4; ++i) {
+        bool lo_on = f.on[i] && f.r[i].lo != INT32_MIN;
+        bool hi_on = f.on[i] && f.r[i].hi != INT32_MAX;
+        cfg[n++] = (uint32_t)(lo_on ? f.r[i].lo : 0);
+        cfg[n++] = (uint32_t)(hi_on ? f.r[i].hi : 0);
+        cfg[n++] = 0UL | ((lo_on ? FOP_GE : FOP_DC) << FilterOpWidth) | (hi_on ? FOP_LE : FOP_DC);
+    }
+
+    uint32_t r = 0;
+    int sh = 0;
+    // no var-var comparison between the 4 columns
+    for (int i = 0; i < 6; ++i) {
+        r |= ((uint32_t)(FOP_DC << sh));
+        sh += FilterOpWidth;
+    }
+    cfg[n++] = r;
+
+    // true table, 10b address: bit 0~3 var-const cond, bit 4~9 var-var cond.
+    for (int w = 0; w < 32; ++w) {
+        uint32_t t = 0;
+        for (int b = 0; b < 32; ++b) {
+            int addr = w * 32 + b;
+            bool c0 = addr & 0x1;
+            bool c1 = addr & 0x2;
+            bool c2 = addr & 0x4;
+            bool c3 = addr & 0x8;
+            bool vv = ((addr >> 4) & 0x3f) == 0x3f;
+            bool v = f.or12 ? (c0 && (c1 || c2) && c3) : (c0 && c1 && c2 && c3);
+            if (vv && v) t |= (1UL << b);
+        }
+        cfg[n++] = t;
+    }
+}
+
+void get_ssb_cfg(ap_uint<512>* hbuf, const SsbKrnlCfg& c) {
+    ap_uint<512>* b = hbuf;
+    memset(b, 0, sizeof(ap_uint<512>) * 9);
+
+    // 512b word
+    ap_uint<512> t = 0;
+    t.set_bit(0, c.join_on);
+    t.set_bit(1, c.aggr_on);
+    t.set_bit(2, 0);   // dual-key off
+    t.range(5, 3) = 0; // hash join flag = 0 for normal, 1 for semi, 2 for anti
+
+    for (int i = 0; i < 8; ++i) {
+        t.range(56 + 8 * i + 7, 56 + 8 * i) = c.id_a[i];
+    }
+    for (int i = 0; i < 8; ++i) {
+        t.range(120 + 8 * i + 7, 120 + 8 * i) = c.id_b[i];
+    }
+
+    t.range(191, 184) = c.write_mask;
+
+    b[0] = t;
+
+    // 512b word
+    // alu
+    ap_uint<289> op = 0;
+    if (!c.eval1.empty()) {
+        xf::database::dynamicALUOPCompiler<uint32_t, uint32_t, uint32_t, uint32_t>(c.eval1.c_str(), 0, 0, 0, 0, op);
+    }
+    b[1] = op;
+    op = 0;
+    if (!c.eval2.empty()) {
+        xf::database::dynamicALUOPCompiler<uint32_t, uint32_t, uint32_t, uint32_t>(c.eval2.c_str(), 0, 0, 0, 0, op);
+    }
+    b[2] = op;
+
+    // 512b word * 3
+    // filter a
+    uint32_t cfg[45];
+    gen_ssb_fcfg(cfg, c.fa);
+    memcpy(&b[3], cfg, sizeof(uint32_t) * 45);
+
+    // 512b word * 3
+    // filter b
+    gen_ssb_fcfg(cfg, c.fb);
+    memcpy(&b[6], cfg, sizeof(uint32_t) * 45);
+
+    // --
+    ap_int<64> shuffle1a_cfg;
+    ap_int<64> shuffle1b_cfg;
+    ap_int<64> shuffle2_cfg;
+    ap_int<64> shuffle3_cfg;
+    ap_int<64> shuffle4_cfg;
+    for (int i = 0; i < 8; ++i) {
+        shuffle1a_cfg(8 * i + 7, 8 * i) = c.shuffle1a[i];
+        shuffle1b_cfg(8 * i + 7, 8 * i) = c.shuffle1b[i];
+        shuffle2_cfg(8 * i + 7, 8 * i) = c.shuffle2[i];
+        shuffle3_cfg(8 * i + 7, 8 * i) = c.shuffle3[i];
+        shuffle4_cfg(8 * i + 7, 8 * i) = c.shuffle4[i];
+    }
+
+    b[0].range(255, 192) = shuffle1a_cfg;
+    b[0].range(319, 256) = shuffle1b_cfg;
+    b[0].range(383, 320) = shuffle2_cfg;
+    b[0].range(447, 384) = shuffle3_cfg;
+    b[0].range(511, 448) = shuffle4_cfg;
+}
+
+#endif // GQE_SSB_CFG_H
@@ -0,0 +1,258 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _SSB_CPU_H
+#define _SSB_CPU_H
+
+#include "ssb_query.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <iostream>
+#include <map>
+#include <unordered_map>
+
+// ------------------------------------------------------------
+// columns of SSB in host memory, as generated by ssb_columngen.
+
+class SsbColumns {
+   public:
+    std::map<std::string, std::vector<TPCH_INT> > cols;
+
+    size_t nrow(const std::string& tbl_col) { return cols[tbl_col].size(); }
+
+    const std::vector<TPCH_INT>& col(const std::string& name) { return cols[name]; }
+
+    int load(const std::string& dir) {
+        const char* names[] = {"lo_orderdate", "lo_custkey",   "lo_partkey",     "lo_suppkey",
+                               "lo_quantity",  "lo_extendedprice", "lo_discount", "lo_revenue",
+                               "lo_supplycost", "d_datekey",   "d_year",         "d_yearmonthnum",
+                               "d_weeknuminyear", "c_custkey", "c_city",         "c_nation",
+                               "c_region",     "s_suppkey",    "s_city",         "s_nation",
+                               "s_region",     "p_partkey",    "p_mfgr",         "p_category",
+                               "p_brand1"};
+        for (const char* n : names) {
+            size_t nr = ssb_get_nrow(dir, n);
+            std::vector<TPCH_INT>& v = cols[n];
+            v.resize(nr);
+            std::string fn = dir + "/" + n + ".dat";
+            FILE* f = fopen(fn.c_str(), "rb");
+            if (!f) {
+                std::cerr << "ERROR: " << fn << " cannot be opened for binary read." << std::endl;
+                return -1;
+            }
+            size_t cnt = fread(v.data(), sizeof(TPCH_INT), nr, f);
+            fclose(f);
+            if (cnt != nr) {
+                std::cerr << "ERROR: " << cnt << " entries read from " << fn << ", " << nr << " entries required."
+                          << std::endl;
+                return -1;
+            }
+        }
+        return 0;
+    }
+};
+
+// ------------------------------------------------------------
+// result of one query: key is (d_year, group col 0, group col 1)
+
+typedef std::array<TPCH_INT, 3> SsbKey;
+typedef std::map<SsbKey, int64_t> SsbGroup;
+
+struct SsbRow {
+    SsbKey key;
+    int64_t sum;
+};
+
+inline std::vector<std::string> ssb_group_cols(const SsbQuery& q) {
+    std::vector<std::string> g;
+    for (const SsbDimStep& s : q.steps) {
+        if (!s.group_col.empty()) g.push_back(s.group_col);
+    }
+    return g;
+}
+
+// order the groups as the ORDER BY clause of each flight.
+inline std::vector<SsbRow> ssb_sort(const SsbQuery& q, const SsbGroup& grp) {
+    std::vector<SsbRow> rows;
+    for (SsbGroup::const_iterator it = grp.begin(); it != grp.end(); ++it) {
+        rows.push_back({it->first, it->second});
+    }
+    std::vector<std::string> gc = ssb_group_cols(q);
+    std::sort(rows.begin(), rows.end(), [&](const SsbRow& a, const SsbRow& b) {
+        if (a.key[0] != b.key[0]) return a.key[0] < b.key[0];
+        // Q3.x: order by d_year asc, revenue desc
+        if (q.flight == 3 && a.sum != b.sum) return a.sum > b.sum;
+        for (size_t i = 0; i < gc.size(); ++i) {
+            std::string sa = ssb_group_name(gc[i], a.key[i + 1]);
+            std::string sb = ssb_group_name(gc[i], b.key[i + 1]);
+            if (sa != sb) return sa < sb;
+        }
+        return false;
+    });
+    return rows;
+}
+
+inline void ssb_print(const SsbQuery& q, const std::vector<SsbRow>& rows, size_t limit = 10) {
+    std::vector<std::string> gc = ssb_group_cols(q);
+    if (q.flight == 1) {
+        int64_t v = rows.empty() ? 0 : rows[0].sum;
+        std::cout << "revenue: " << v << std::endl;
+        return;
+    }
+    size_t n = std::min(limit, rows.size());
+    for (size_t i = 0; i < n; ++i) {
+        std::cout << rows[i].key[0];
+        for (size_t j = 0; j < gc.size(); ++j) {
+            std::cout << " | " << ssb_group_name(gc[j], rows[i].key[j + 1]);
+        }
+        std::cout << " | " << rows[i].sum << std::endl;
+    }
+    if (rows.size() > n) std::cout << "... (" << rows.size() << " rows)" << std::endl;
+}
+
+inline bool ssb_compare(const std::vector<SsbRow>& ref, const std::vector<SsbRow>& res) {
+    if (ref.size() != res.size()) {
+        std::cout << "ERROR: " << res.size() << " rows in result, " << ref.size() << " rows expected." << std::endl;
+        return false;
+    }
+    for (size_t i = 0; i < ref.size(); ++i) {
+        if (ref[i].key != res[i].key || ref[i].sum != res[i].sum) {
+            std::cout << "ERROR: row " << i << " mismatch, " << res[i].sum << " vs " << ref[i].sum << " expected."
+                      << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+// ------------------------------------------------------------
+
+inline bool ssb_in(const SsbRange& r, TPCH_INT v) {
+    return v >= r.lo && v <= r.hi;
+}
+
+inline bool ssb_step_match(const SsbDimStep& s, TPCH_INT v) {
+    return ssb_in(s.r0, v) || (s.has_r1 && ssb_in(s.r1, v));
+}
+
+/* Resolve the date predicates to a range of lo_orderdate.
+ * d_datekey is yyyymmdd, so all SSB date predicates select a consecutive
+ * key range, and the join with date dimension can be replaced by a filter on
+ * lo_orderdate, with d_year recovered as lo_orderdate / 10000.
+ * Returns false when the selected keys are not consecutive in date table.
+ */
+inline bool ssb_date_range(const SsbQuery& q, SsbColumns& db, SsbRange& r) {
+    r.lo = INT32_MIN;
+    r.hi = INT32_MAX;
+    if (q.date_preds.empty()) return true;
+
+    const std::vector<TPCH_INT>& dk = db.col("d_datekey");
+    r.lo = INT32_MAX;
+    r.hi = INT32_MIN;
+    size_t nmatch = 0;
+    for (size_t i = 0; i < dk.size(); ++i) {
+        bool m = true;
+        for (const SsbDatePred& p : q.date_preds) {
+            m = m && ssb_in(p.r, db.col(p.col)[i]);
+        }
+        if (m) {
+            r.lo = std::min(r.lo, dk[i]);
+            r.hi = std::max(r.hi, dk[i]);
+            ++nmatch;
+        }
+    }
+    size_t ninside = 0;
+    for (size_t i = 0; i < dk.size(); ++i) {
+        if (ssb_in(r, dk[i])) ++ninside;
+    }
+    return nmatch == ninside;
+}
+
+// ------------------------------------------------------------
+// CPU reference, as a star join with hash tables on each dimension.
+
+inline SsbGroup ssb_cpu_query(const SsbQuery& q, SsbColumns& db) {
+    SsbGroup grp;
+    const std::vector<TPCH_INT>& lo_orderdate = db.col("lo_orderdate");
+    size_t n = lo_orderdate.size();
+
+    // date dimension
+    std::unordered_map<TPCH_INT, TPCH_INT> ht_d; // datekey -> year
+    {
+        const std::vector<TPCH_INT>& dk = db.col("d_datekey");
+        const std::vector<TPCH_INT>& dy = db.col("d_year");
+        for (size_t i = 0; i < dk.size(); ++i) {
+            bool m = true;
+            for (const SsbDatePred& p : q.date_preds) {
+                m = m && ssb_in(p.r, db.col(p.col)[i]);
+            }
+            if (m) ht_d[dk[i]] = dy[i];
+        }
+    }
+
+    if (q.flight == 1) {
+        const std::vector<TPCH_INT>& qty = db.col("lo_quantity");
+        const std::vector<TPCH_INT>& disc = db.col("lo_discount");
+        const std::vector<TPCH_INT>& price = db.col("lo_extendedprice");
+        int64_t sum = 0;
+        for (size_t i = 0; i < n; ++i) {
+            if (ssb_in(q.quantity, qty[i]) && ssb_in(q.discount, disc[i]) && ht_d.count(lo_orderdate[i])) {
+                sum += (int64_t)price[i] * disc[i];
+            }
+        }
+        grp[SsbKey{{0, 0, 0}}] = sum;
+        return grp;
+    }
+
+    // other dimensions, key -> group value
+    size_t ns = q.steps.size();
+    std::vector<std::unordered_map<TPCH_INT, TPCH_INT> > ht(ns);
+    std::vector<const std::vector<TPCH_INT>*> fk(ns);
+    for (size_t s = 0; s < ns; ++s) {
+        const SsbDimStep& st = q.steps[s];
+        const std::vector<TPCH_INT>& key = db.col(ssb_pk_col(st.dim));
+        const std::vector<TPCH_INT>& pred = db.col(st.pred_col);
+        const std::vector<TPCH_INT>* g = st.group_col.empty() ? nullptr : &db.col(st.group_col);
+        for (size_t i = 0; i < key.size(); ++i) {
+            if (ssb_step_match(st, pred[i])) ht[s][key[i]] = g ? (*g)[i] : 0;
+        }
+        fk[s] = &db.col(ssb_fk_col(st.dim));
+    }
+
+    const std::vector<TPCH_INT>& revenue = db.col("lo_revenue");
+    const std::vector<TPCH_INT>& supplycost = db.col("lo_supplycost");
+    for (size_t i = 0; i < n; ++i) {
+        std::unordered_map<TPCH_INT, TPCH_INT>::const_iterator itd = ht_d.find(lo_orderdate[i]);
+        if (itd == ht_d.end()) continue;
+        SsbKey k = {{itd->second, 0, 0}};
+        int g = 1;
+        bool m = true;
+        for (size_t s = 0; s < ns && m; ++s) {
+            std::unordered_map<TPCH_INT, TPCH_INT>::const_iterator it = ht[s].find((*fk[s])[i]);
+            if (it == ht[s].end()) {
+                m = false;
+            } else if (!q.steps[s].group_col.empty()) {
+                k[g++] = it->second;
+            }
+        }
+        if (!m) continue;
+        grp[k] += (q.flight == 4) ? (int64_t)revenue[i] - supplycost[i] : (int64_t)revenue[i];
+    }
+    return grp;
+}
+
+#endif // _SSB_CPU_H
@@ -0,0 +1,187 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _SSB_GQE_H
+#define _SSB_GQE_H
+
+#include "ssb_cfg.hpp"
+#include "ssb_cpu.hpp"
+
+#include <sys/time.h>
+
+/* Runs the planned SSB queries with gqeJoin.
+ * Lineorder and the 3 dimensions are loaded to device once, and each query
+ * then only transfers its configuration and reads back the final result.
+ */
+class SsbGqe {
+    static const int MaxStep = 3;
+
+    cl::CommandQueue q;
+
+    // lineorder for flight 2~4, lineorder for flight 1, customer, supplier, part
+    Table lo;
+    Table lo1;
+    Table dim_c;
+    Table dim_s;
+    Table dim_p;
+    // intermediate and result tables, used in ping-pong
+    Table tk[2];
+    // aggregation result of flight 1
+    Table ta;
+
+    cfgCmd cfgcmds[MaxStep];
+    bufferTmp* buftmp;
+    krnlEngine krnlstep[MaxStep];
+
+    Table& dim(char d) { return d == 'c' ? dim_c : (d == 's' ? dim_s : dim_p); }
+
+   public:
+    size_t lo_n;
+
+    SsbGqe(cl::Context& context, cl::CommandQueue& cq, cl::Program& program, const std::string& in_dir) {
+        q = cq;
+        lo_n = ssb_get_nrow(in_dir, "lo_orderdate");
+
+        lo = Table("lineorder", lo_n, ssb_lo_ncol, in_dir);
+        for (int i = 0; i < ssb_lo_ncol; ++i) {
+            lo.addCol(ssb_lo_cols[i], 4);
+        }
+        lo1 = Table("lineorder_q1", lo_n, ssb_lo1_ncol, in_dir);
+        for (int i = 0; i < ssb_lo1_ncol; ++i) {
+            lo1.addCol(ssb_lo1_cols[i], 4);
+        }
+        const char ds[] = {'c', 's', 'p'};
+        for (char d : ds) {
+            std::vector<std::string> cols = ssb_dim_cols(d);
+            Table& t = dim(d);
+            t = Table(std::string(1, d), ssb_get_nrow(in_dir, cols[0]), cols.size(), in_dir);
+            for (const std::string& c : cols) {
+                t.addCol(c, 4);
+            }
+        }
+        // the largest intermediate result is about 1/5 of lineorder, in Q4.1.
+        tk[0] = Table("tk0", lo_n / 4 + 1024, 8, "");
+        tk[1] = Table("tk1", lo_n / 4 + 1024, 8, "");
+        ta = Table("ta", 48, 8, "");
+
+        Table* tbs[] = {&lo, &lo1, &dim_c, &dim_s, &dim_p};
+        for (Table* t : tbs) {
+            t->allocateHost();
+            t->loadHost();
+            t->allocateDevBuffer(context, 32);
+        }
+        for (int i = 0; i < 2; ++i) {
+            tk[i].allocateHost();
+            tk[i].allocateDevBuffer(context, 32);
+        }
+        ta.allocateHost();
+        ta.allocateDevBuffer(context, 32);
+        for (int i = 0; i < MaxStep; ++i) {
+            cfgcmds[i].allocateHost();
+            cfgcmds[i].allocateDevBuffer(context, 32);
+            krnlstep[i] = krnlEngine(program, q, "gqeJoin");
+        }
+
+        buftmp = new bufferTmp(context);
+        buftmp->initBuffer(q);
+
+        transEngine transin;
+        transin.setq(q);
+        for (Table* t : tbs) {
+            transin.add(t);
+        }
+        transin.host2dev(0, nullptr, nullptr);
+        q.finish();
+    }
+
+    ~SsbGqe() { delete buftmp; }
+
+    /* Runs one query, with date predicates resolved to the given range of lo_orderdate.
+     * Groups are summed on host, and krnl_ms returns the time from config transfer
+     * to result read back.
+     */
+    int run(const SsbQuery& qr, const SsbRange& date, SsbGroup& grp, long& krnl_ms) {
+        SsbPlan plan;
+        if (!ssb_plan(qr, date, plan)) return 1;
+        int nstep = plan.steps.size();
+
+        transEngine transin;
+        transEngine transout;
+        transin.setq(q);
+        transout.setq(q);
+        for (int i = 0; i < nstep; ++i) {
+            get_ssb_cfg(cfgcmds[i].cmd, plan.steps[i]);
+            transin.add(&(cfgcmds[i]));
+        }
+
+        Table* res;
+        if (qr.flight == 1) {
+            krnlstep[0].setup(lo1, lo1, ta, cfgcmds[0], *buftmp);
+            res = &ta;
+        } else {
+            Table* probe = &lo;
+            for (int i = 0; i < nstep; ++i) {
+                krnlstep[i].setup(dim(plan.dims[i]), *probe, tk[i % 2], cfgcmds[i], *buftmp);
+                probe = &tk[i % 2];
+            }
+            res = probe;
+        }
+        transout.add(res);
+
+        std::vector<cl::Event> eventsh2d_write(1);
+        std::vector<cl::Event> eventsd2h_read(1);
+        std::vector<std::vector<cl::Event> > events(nstep);
+        for (int i = 0; i < nstep; ++i) {
+            events[i].resize(1);
+        }
+
+        transin.host2dev(0, nullptr, &(eventsh2d_write[0]));
+        for (int i = 0; i < nstep; ++i) {
+            krnlstep[i].run(0, i == 0 ? &eventsh2d_write : &(events[i - 1]), &(events[i][0]));
+        }
+        transout.dev2host(0, &(events[nstep - 1]), &(eventsd2h_read[0]));
+        q.finish();
+        krnl_ms = getkrltime(eventsh2d_write, eventsd2h_read);
+
+        grp.clear();
+        if (qr.flight == 1) {
+            // sum of col:4 in row 2 (low) and row 3 (high)
+            ap_int<64> sum = 0;
+            sum.range(31, 0) = res->getInt32(2, 4);
+            sum.range(63, 32) = res->getInt32(3, 4);
+            grp[SsbKey{{0, 0, 0}}] = sum.to_int64();
+            return 0;
+        }
+
+        // group by d_year and group cols
+        int od = ssb_index(plan.layout, "lo_orderdate");
+        int ms = ssb_index(plan.layout, qr.flight == 4 ? "profit" : "lo_revenue");
+        std::vector<int> gi;
+        for (const std::string& g : ssb_group_cols(qr)) {
+            gi.push_back(ssb_index(plan.layout, g));
+        }
+        int nrow = res->getNumRow();
+        for (int r = 0; r < nrow; ++r) {
+            SsbKey k = {{res->getInt32(r, od) / 10000, 0, 0}};
+            for (size_t j = 0; j < gi.size(); ++j) {
+                k[j + 1] = res->getInt32(r, gi[j]);
+            }
+            grp[k] += res->getInt32(r, ms);
+        }
+        return 0;
+    }
+};
+
+#endif // _SSB_GQE_H
@@ -0,0 +1,292 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _SSB_PLAN_H
+#define _SSB_PLAN_H
+
+#include "ssb_query.hpp"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+/* Unlike the TPC-H demos, where each query comes with a hand written cfg.hpp,
+ * the 13 SSB queries share a handful of shapes, so the gqeJoin configuration
+ * of each kernel call is planned into the fields of SsbKrnlCfg, and
+ * packed into the 9x512b command by get_ssb_cfg() in ssb_cfg.hpp.
+ *
+ * Flight 1 is a single filter + aggregation call, same as TPC-H Q6.
+ * Flight 2 ~ 4 is a chain of hash joins, one per dimension, with the filtered
+ * dimension as build side and lineorder (or the previous result) as probe side.
+ * The join with date dimension is replaced by a filter on lo_orderdate,
+ * see ssb_date_range() in ssb_cpu.hpp.
+ */
+
+// condition on the first 4 scanned columns, cond 1 and 2 can be OR-ed.
+struct SsbFilter {
+    bool on[4];
+    SsbRange r[4];
+    bool or12;
+};
+
+struct SsbKrnlCfg {
+    bool join_on;
+    bool aggr_on;
+    signed char id_a[8];
+    signed char id_b[8];
+    SsbFilter fa;
+    SsbFilter fb;
+    signed char shuffle1a[8];
+    signed char shuffle1b[8];
+    signed char shuffle2[8];
+    signed char shuffle3[8];
+    signed char shuffle4[8];
+    std::string eval1; // empty for no evaluation
+    std::string eval2;
+    unsigned char write_mask;
+};
+
+inline void ssb_filter_init(SsbFilter& f) {
+    for (int i = 0; i < 4; ++i) {
+        f.on[i] = false;
+        f.r[i] = {0, 0};
+    }
+    f.or12 = false;
+}
+
+inline void ssb_krnl_cfg_init(SsbKrnlCfg& c) {
+    c.join_on = false;
+    c.aggr_on = false;
+    for (int i = 0; i < 8; ++i) {
+        c.id_a[i] = -1;
+        c.id_b[i] = -1;
+        c.shuffle1a[i] = -1;
+        c.shuffle1b[i] = -1;
+        c.shuffle2[i] = -1;
+        c.shuffle3[i] = -1;
+        c.shuffle4[i] = -1;
+    }
+    ssb_filter_init(c.fa);
+    ssb_filter_init(c.fb);
+    c.eval1 = "";
+    c.eval2 = "";
+    c.write_mask = 0;
+}
+
+// ------------------------------------------------------------
+// column layout of the tables loaded to device.
+
+// lineorder columns for flight 2 ~ 4
+static const char* const ssb_lo_cols[] = {"lo_orderdate", "lo_custkey", "lo_partkey",
+                                          "lo_suppkey",   "lo_revenue", "lo_supplycost"};
+static const int ssb_lo_ncol = 6;
+
+// lineorder columns for flight 1, in the order of filter conditions
+static const char* const ssb_lo1_cols[] = {"lo_extendedprice", "lo_discount", "lo_orderdate", "lo_quantity"};
+static const int ssb_lo1_ncol = 4;
+
+// dimension columns, key first
+inline std::vector<std::string> ssb_dim_cols(char dim) {
+    if (dim == 'c') return {"c_custkey", "c_region", "c_nation", "c_city"};
+    if (dim == 's') return {"s_suppkey", "s_region", "s_nation", "s_city"};
+    return {"p_partkey", "p_mfgr", "p_category", "p_brand1"};
+}
+
+inline int ssb_index(const std::vector<std::string>& layout, const std::string& c) {
+    for (size_t i = 0; i < layout.size(); ++i) {
+        if (layout[i] == c) return i;
+    }
+    return -1;
+}
+
+// ------------------------------------------------------------
+
+struct SsbPlan {
+    // one kernel call per step
+    std::vector<SsbKrnlCfg> steps;
+    // dimension as build side of each step, 0 for flight 1
+    std::vector<char> dims;
+    // columns of the final result table
+    std::vector<std::string> layout;
+};
+
+inline void ssb_plan_flight1(const SsbQuery& q, const SsbRange& date, SsbPlan& plan) {
+    SsbKrnlCfg c;
+    ssb_krnl_cfg_init(c);
+    c.join_on = false;
+    c.aggr_on = true;
+    for (int i = 0; i < ssb_lo1_ncol; ++i) {
+        c.id_a[i] = i;
+    }
+    // col:0 lo_extendedprice (eval var a)
+    // col:1 lo_discount      (filter cond 1) (eval var b)
+    // col:2 lo_orderdate     (filter cond 2)
+    // col:3 lo_quantity      (filter cond 3)
+    c.fa.on[1] = true;
+    c.fa.r[1] = q.discount;
+    c.fa.on[2] = true;
+    c.fa.r[2] = date;
+    c.fa.on[3] = true;
+    c.fa.r[3] = q.quantity;
+    for (int i = 0; i < 8; ++i) {
+        c.shuffle1a[i] = i;
+        c.shuffle1b[i] = i;
+        c.shuffle2[i] = i;
+        c.shuffle3[i] = i;
+        c.shuffle4[i] = i;
+    }
+    // eval result as col:4
+    c.shuffle4[4] = 8;
+    c.eval1 = "strm1*strm2";
+    c.eval2 = "strm1*strm2";
+    c.write_mask = 0x10;
+
+    plan.steps.push_back(c);
+    plan.dims.push_back(0);
+    plan.layout = {"", "", "", "", "revenue"};
+}
+
+/* Each join step:
+ *   A: dimension, scanned as key, pred_col, pred_col (only if OR-ed), group_col,
+ *      filtered on the pred_col, and payload is group_col.
+ *   B: lineorder or last result, key is the foreign key of dimension,
+ *      all other columns are payload.
+ * Join output has probe payload at 0 ~ 5, build payload at 6 ~ 11 and key at 12.
+ * Flight 4 evaluates lo_revenue - lo_supplycost right after the first join.
+ */
+inline bool ssb_plan_join(const SsbQuery& q, const SsbRange& date, SsbPlan& plan) {
+    std::vector<std::string> layout;
+    layout.push_back("lo_orderdate");
+    for (const SsbDimStep& s : q.steps) {
+        layout.push_back(ssb_fk_col(s.dim));
+    }
+    layout.push_back("lo_revenue");
+    if (q.flight == 4) layout.push_back("lo_supplycost");
+
+    for (size_t k = 0; k < q.steps.size(); ++k) {
+        const SsbDimStep& s = q.steps[k];
+        SsbKrnlCfg c;
+        ssb_krnl_cfg_init(c);
+        c.join_on = true;
+        c.aggr_on = false;
+
+        // build side
+        std::vector<std::string> dcols = ssb_dim_cols(s.dim);
+        bool grouped = !s.group_col.empty();
+        c.id_a[0] = 0;
+        c.id_a[1] = ssb_index(dcols, s.pred_col);
+        c.id_a[2] = s.has_r1 ? c.id_a[1] : -1;
+        c.id_a[3] = grouped ? ssb_index(dcols, s.group_col) : -1;
+        c.fa.on[1] = true;
+        c.fa.r[1] = s.r0;
+        c.fa.on[2] = s.has_r1;
+        c.fa.r[2] = s.r1;
+        c.fa.or12 = s.has_r1;
+        c.shuffle1a[0] = 0;
+        c.shuffle1a[1] = grouped ? 3 : -1;
+
+        // probe side
+        for (size_t i = 0; i < layout.size(); ++i) {
+            if (k == 0) {
+                std::vector<std::string> lcols(ssb_lo_cols, ssb_lo_cols + ssb_lo_ncol);
+                c.id_b[i] = ssb_index(lcols, layout[i]);
+            } else {
+                c.id_b[i] = i;
+            }
+        }
+        if (k == 0) {
+            // lo_orderdate is col:0 of the first probe.
+            c.fb.on[0] = true;
+            c.fb.r[0] = date;
+        }
+        int fk = ssb_index(layout, ssb_fk_col(s.dim));
+        std::vector<std::string> payload;
+        c.shuffle1b[0] = fk;
+        for (size_t i = 0; i < layout.size(); ++i) {
+            if ((int)i != fk) {
+                c.shuffle1b[1 + payload.size()] = i;
+                payload.push_back(layout[i]);
+            }
+        }
+        if (payload.size() > 6) {
+            std::cout << "ERROR: " << q.name << " has too many columns to join." << std::endl;
+            return false;
+        }
+
+        // after join
+        std::vector<std::string> next;
+        if (q.flight == 4 && k == 0) {
+            // profit = strm1 - strm2, shuffle2 puts lo_revenue and lo_supplycost first
+            std::vector<std::string> rest;
+            int n2 = 0;
+            c.shuffle2[n2++] = ssb_index(payload, "lo_revenue");
+            c.shuffle2[n2++] = ssb_index(payload, "lo_supplycost");
+            for (size_t i = 0; i < payload.size(); ++i) {
+                if (payload[i] != "lo_revenue" && payload[i] != "lo_supplycost") {
+                    c.shuffle2[n2++] = i;
+                    rest.push_back(payload[i]);
+                }
+            }
+            if (grouped) c.shuffle2[n2++] = 6;
+            c.eval1 = "strm1-strm2";
+            int n3 = 0;
+            for (int i = 2; i < n2; ++i) {
+                c.shuffle3[n3++] = i;
+            }
+            c.shuffle3[n3++] = 8;
+            next = rest;
+            if (grouped) next.push_back(s.group_col);
+            next.push_back("profit");
+        } else {
+            int n2 = 0;
+            for (size_t i = 0; i < payload.size(); ++i) {
+                c.shuffle2[n2++] = i;
+            }
+            if (grouped) c.shuffle2[n2++] = 6;
+            for (int i = 0; i < n2; ++i) {
+                c.shuffle3[i] = i;
+            }
+            next = payload;
+            if (grouped) next.push_back(s.group_col);
+        }
+        if (next.size() > 8) {
+            std::cout << "ERROR: " << q.name << " has too many columns to write." << std::endl;
+            return false;
+        }
+        for (size_t i = 0; i < next.size(); ++i) {
+            c.shuffle4[i] = i;
+        }
+        c.write_mask = (1 << next.size()) - 1;
+
+        plan.steps.push_back(c);
+        plan.dims.push_back(s.dim);
+        layout = next;
+    }
+    plan.layout = layout;
+    return true;
+}
+
+inline bool ssb_plan(const SsbQuery& q, const SsbRange& date, SsbPlan& plan) {
+    plan.steps.clear();
+    plan.dims.clear();
+    plan.layout.clear();
+    if (q.flight == 1) {
+        ssb_plan_flight1(q, date, plan);
+        return true;
+    }
+    return ssb_plan_join(q, date, plan);
+}
+
+#endif // _SSB_PLAN_H
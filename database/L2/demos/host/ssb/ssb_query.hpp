@@ -0,0 +1,175 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _SSB_QUERY_H
+#define _SSB_QUERY_H
+
+#include "ssb_read.hpp"
+
+#include <string>
+#include <vector>
+
+/* The 13 queries of Star Schema Benchmark, described as data so that
+ * the same description drives both the CPU reference and the GQE pipeline.
+ *
+ * All predicates of SSB are ranges on dictionary-encoded columns (see ssb_read.hpp),
+ * except Q3.3 and Q3.4 which OR two cities together.
+ * Dimension steps are listed in join order, and the group-by columns
+ * of a query are the group_col of its steps, in step order, after d_year.
+ */
+
+struct SsbRange {
+    TPCH_INT lo;
+    TPCH_INT hi;
+};
+
+// one predicate on date dimension.
+struct SsbDatePred {
+    std::string col; // d_year, d_yearmonthnum or d_weeknuminyear
+    SsbRange r;
+};
+
+// one dimension of customer ('c'), supplier ('s') or part ('p').
+struct SsbDimStep {
+    char dim;
+    std::string pred_col; // column in dimension table, e.g. c_region
+    SsbRange r0;
+    bool has_r1; // pred_col in r0 OR pred_col in r1
+    SsbRange r1;
+    std::string group_col; // empty when not grouped
+};
+
+struct SsbQuery {
+    std::string name;
+    int flight;
+    std::vector<SsbDatePred> date_preds;
+    // flight 1 only
+    SsbRange quantity;
+    SsbRange discount;
+    // flight 2 ~ 4
+    std::vector<SsbDimStep> steps;
+};
+
+// region, nation and city ids used by the queries
+#define SSB_AMERICA 1
+#define SSB_ASIA 2
+#define SSB_EUROPE 3
+#define SSB_UNITED_STATES 24
+#define SSB_UNITED_KI1 231
+#define SSB_UNITED_KI5 235
+
+inline SsbDimStep ssb_step(char dim, std::string pred_col, SsbRange r0, std::string group_col = "") {
+    SsbDimStep s;
+    s.dim = dim;
+    s.pred_col = pred_col;
+    s.r0 = r0;
+    s.has_r1 = false;
+    s.r1 = r0;
+    s.group_col = group_col;
+    return s;
+}
+
+inline SsbDimStep ssb_step_or(char dim, std::string pred_col, SsbRange r0, SsbRange r1, std::string group_col) {
+    SsbDimStep s = ssb_step(dim, pred_col, r0, group_col);
+    s.has_r1 = true;
+    s.r1 = r1;
+    return s;
+}
+
+inline SsbQuery ssb_flight1(std::string name, std::vector<SsbDatePred> dp, SsbRange disc, SsbRange qty) {
+    SsbQuery q;
+    q.name = name;
+    q.flight = 1;
+    q.date_preds = dp;
+    q.discount = disc;
+    q.quantity = qty;
+    return q;
+}
+
+inline SsbQuery ssb_flight(std::string name, int flight, std::vector<SsbDatePred> dp, std::vector<SsbDimStep> steps) {
+    SsbQuery q;
+    q.name = name;
+    q.flight = flight;
+    q.date_preds = dp;
+    q.discount = {0, 0};
+    q.quantity = {0, 0};
+    q.steps = steps;
+    return q;
+}
+
+inline std::vector<SsbQuery> ssb_queries() {
+    std::vector<SsbQuery> v;
+    // Q1.x: sum(lo_extendedprice * lo_discount)
+    v.push_back(ssb_flight1("Q1.1", {{"d_year", {1993, 1993}}}, {1, 3}, {INT32_MIN, 24}));
+    v.push_back(ssb_flight1("Q1.2", {{"d_yearmonthnum", {199401, 199401}}}, {4, 6}, {26, 35}));
+    v.push_back(ssb_flight1("Q1.3", {{"d_weeknuminyear", {6, 6}}, {"d_year", {1994, 1994}}}, {5, 7}, {26, 35}));
+    // Q2.x: sum(lo_revenue) group by d_year, p_brand1
+    v.push_back(ssb_flight("Q2.1", 2, {}, {ssb_step('p', "p_category", {12, 12}, "p_brand1"),
+                                           ssb_step('s', "s_region", {SSB_AMERICA, SSB_AMERICA})}));
+    v.push_back(ssb_flight("Q2.2", 2, {}, {ssb_step('p', "p_brand1", {2221, 2228}, "p_brand1"),
+                                           ssb_step('s', "s_region", {SSB_ASIA, SSB_ASIA})}));
+    v.push_back(ssb_flight("Q2.3", 2, {}, {ssb_step('p', "p_brand1", {2239, 2239}, "p_brand1"),
+                                           ssb_step('s', "s_region", {SSB_EUROPE, SSB_EUROPE})}));
+    // Q3.x: sum(lo_revenue) group by c_xxx, s_xxx, d_year
+    v.push_back(ssb_flight("Q3.1", 3, {{"d_year", {1992, 1997}}},
+                           {ssb_step('c', "c_region", {SSB_ASIA, SSB_ASIA}, "c_nation"),
+                            ssb_step('s', "s_region", {SSB_ASIA, SSB_ASIA}, "s_nation")}));
+    v.push_back(ssb_flight("Q3.2", 3, {{"d_year", {1992, 1997}}},
+                           {ssb_step('c', "c_nation", {SSB_UNITED_STATES, SSB_UNITED_STATES}, "c_city"),
+                            ssb_step('s', "s_nation", {SSB_UNITED_STATES, SSB_UNITED_STATES}, "s_city")}));
+    v.push_back(ssb_flight("Q3.3", 3, {{"d_year", {1992, 1997}}},
+                           {ssb_step_or('c', "c_city", {SSB_UNITED_KI1, SSB_UNITED_KI1},
+                                        {SSB_UNITED_KI5, SSB_UNITED_KI5}, "c_city"),
+                            ssb_step_or('s', "s_city", {SSB_UNITED_KI1, SSB_UNITED_KI1},
+                                        {SSB_UNITED_KI5, SSB_UNITED_KI5}, "s_city")}));
+    v.push_back(ssb_flight("Q3.4", 3, {{"d_yearmonthnum", {199712, 199712}}},
+                           {ssb_step_or('c', "c_city", {SSB_UNITED_KI1, SSB_UNITED_KI1},
+                                        {SSB_UNITED_KI5, SSB_UNITED_KI5}, "c_city"),
+                            ssb_step_or('s', "s_city", {SSB_UNITED_KI1, SSB_UNITED_KI1},
+                                        {SSB_UNITED_KI5, SSB_UNITED_KI5}, "s_city")}));
+    // Q4.x: sum(lo_revenue - lo_supplycost)
+    v.push_back(ssb_flight("Q4.1", 4, {}, {ssb_step('c', "c_region", {SSB_AMERICA, SSB_AMERICA}, "c_nation"),
+                                           ssb_step('s', "s_region", {SSB_AMERICA, SSB_AMERICA}),
+                                           ssb_step('p', "p_mfgr", {1, 2})}));
+    v.push_back(ssb_flight("Q4.2", 4, {{"d_year", {1997, 1998}}},
+                           {ssb_step('c', "c_region", {SSB_AMERICA, SSB_AMERICA}),
+                            ssb_step('s', "s_region", {SSB_AMERICA, SSB_AMERICA}, "s_nation"),
+                            ssb_step('p', "p_mfgr", {1, 2}, "p_category")}));
+    v.push_back(ssb_flight("Q4.3", 4, {{"d_year", {1997, 1998}}},
+                           {ssb_step('s', "s_nation", {SSB_UNITED_STATES, SSB_UNITED_STATES}, "s_city"),
+                            ssb_step('p', "p_category", {14, 14}, "p_brand1"),
+                            ssb_step('c', "c_region", {SSB_AMERICA, SSB_AMERICA})}));
+    return v;
+}
+
+// primary key of a dimension
+inline std::string ssb_pk_col(char dim) {
+    return dim == 'c' ? "c_custkey" : (dim == 's' ? "s_suppkey" : "p_partkey");
+}
+
+// foreign key in lineorder of a dimension
+inline std::string ssb_fk_col(char dim) {
+    return dim == 'c' ? "lo_custkey" : (dim == 's' ? "lo_suppkey" : "lo_partkey");
+}
+
+// name of a group-by value, as would be printed by a SQL engine.
+inline std::string ssb_group_name(const std::string& col, TPCH_INT v) {
+    if (col == "c_region" || col == "s_region") return ssb_region_name(v);
+    if (col == "c_nation" || col == "s_nation") return ssb_nation_name(v);
+    if (col == "c_city" || col == "s_city") return ssb_city_name(v);
+    return ssb_mfgr_name(v);
+}
+
+#endif // _SSB_QUERY_H
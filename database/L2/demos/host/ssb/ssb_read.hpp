@@ -0,0 +1,291 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _SSB_READ_H
+#define _SSB_READ_H
+
+#include "tpch_read_2.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <sys/stat.h>
+
+/* ssb_read.hpp provides read interface to the .tbl files of Star Schema Benchmark,
+ * as generated by ssb-dbgen with SSBM workload.
+ * There're 5 kinds of .tbl files: lineorder, date, customer, supplier and part.
+ *
+ * It reuses d_long and d_string from tpch_read_2.hpp. Money fields of SSB are
+ * printed as integers by dbgen, so they are read as d_long as well.
+ *
+ * All string attributes used by the 13 SSB queries have small domains,
+ * and are dictionary-encoded into TPCH_INT so that they can be filtered,
+ * joined and shuffled by GQE kernels:
+ *   region: 0 ~ 4, in TPC-H order (AFRICA, AMERICA, ASIA, EUROPE, MIDDLE EAST)
+ *   nation: 0 ~ 24, in TPC-H order (ALGERIA, ARGENTINA, ... UNITED STATES)
+ *   city:   nation * 10 + trailing digit, e.g. "UNITED KI1" is 231
+ *   mfgr, category and brand1: the decimal digits after "MFGR#",
+ *           e.g. "MFGR#1" is 1, "MFGR#12" is 12, "MFGR#2221" is 2221
+ */
+
+#define SSB_READ_DATE_LEN 19
+#define SSB_READ_DAY_LEN 10
+#define SSB_READ_MONTH_LEN 10
+#define SSB_READ_YEARMONTH_LEN 8
+#define SSB_READ_SEASON_LEN 13
+#define SSB_READ_NAME_LEN 26
+#define SSB_READ_ADDR_MAX 41
+#define SSB_READ_CITY_LEN 11
+#define SSB_READ_NATION_LEN 16
+#define SSB_READ_REGION_LEN 13
+#define SSB_READ_PHONE_LEN 16
+#define SSB_READ_MKTSEG_LEN 11
+#define SSB_READ_P_NAME_LEN 23
+#define SSB_READ_MFGR_LEN 7
+#define SSB_READ_CATEGORY_LEN 8
+#define SSB_READ_BRAND_LEN 10
+#define SSB_READ_COLOR_LEN 12
+#define SSB_READ_TYPE_LEN 26
+#define SSB_READ_CNTR_LEN 11
+#define SSB_READ_PRIORITY_LEN 16
+#define SSB_READ_SHIPMODE_LEN 11
+
+#define SSB_NATION_NUM 25
+#define SSB_REGION_NUM 5
+
+class lineorder_t {
+   public:
+    d_long orderkey;
+    d_long linenumber;
+    d_long custkey;
+    d_long partkey;
+    d_long suppkey;
+    d_long orderdate;
+    d_string<SSB_READ_PRIORITY_LEN> orderpriority;
+    d_long shippriority;
+    d_long quantity;
+    d_long extendedprice;
+    d_long ordtotalprice;
+    d_long discount;
+    d_long revenue;
+    d_long supplycost;
+    d_long tax;
+    d_long commitdate;
+    d_string<SSB_READ_SHIPMODE_LEN> shipmode;
+
+    friend std::ostream& operator<<(std::ostream& output, lineorder_t& source) {
+        output << source.orderkey << source.linenumber << source.custkey << source.partkey << source.suppkey
+               << source.orderdate << source.orderpriority << source.shippriority << source.quantity
+               << source.extendedprice << source.ordtotalprice << source.discount << source.revenue
+               << source.supplycost << source.tax << source.commitdate << source.shipmode << std::endl;
+        return output;
+    }
+
+    friend std::istream& operator>>(std::istream& input, lineorder_t& target) {
+        input >> target.orderkey >> target.linenumber >> target.custkey >> target.partkey >> target.suppkey >>
+            target.orderdate >> target.orderpriority >> target.shippriority >> target.quantity >>
+            target.extendedprice >> target.ordtotalprice >> target.discount >> target.revenue >> target.supplycost >>
+            target.tax >> target.commitdate >> target.shipmode;
+        input.get();
+        return input;
+    }
+};
+
+class date_t {
+   public:
+    d_long datekey;
+    d_string<SSB_READ_DATE_LEN> date;
+    d_string<SSB_READ_DAY_LEN> dayofweek;
+    d_string<SSB_READ_MONTH_LEN> month;
+    d_long year;
+    d_long yearmonthnum;
+    d_string<SSB_READ_YEARMONTH_LEN> yearmonth;
+    d_long daynuminweek;
+    d_long daynuminmonth;
+    d_long daynuminyear;
+    d_long monthnuminyear;
+    d_long weeknuminyear;
+    d_string<SSB_READ_SEASON_LEN> sellingseason;
+    d_long lastdayinweekfl;
+    d_long lastdayinmonthfl;
+    d_long holidayfl;
+    d_long weekdayfl;
+
+    friend std::ostream& operator<<(std::ostream& output, date_t& source) {
+        output << source.datekey << source.date << source.dayofweek << source.month << source.year
+               << source.yearmonthnum << source.yearmonth << source.daynuminweek << source.daynuminmonth
+               << source.daynuminyear << source.monthnuminyear << source.weeknuminyear << source.sellingseason
+               << source.lastdayinweekfl << source.lastdayinmonthfl << source.holidayfl << source.weekdayfl
+               << std::endl;
+        return output;
+    }
+
+    friend std::istream& operator>>(std::istream& input, date_t& target) {
+        input >> target.datekey >> target.date >> target.dayofweek >> target.month >> target.year >>
+            target.yearmonthnum >> target.yearmonth >> target.daynuminweek >> target.daynuminmonth >>
+            target.daynuminyear >> target.monthnuminyear >> target.weeknuminyear >> target.sellingseason >>
+            target.lastdayinweekfl >> target.lastdayinmonthfl >> target.holidayfl >> target.weekdayfl;
+        input.get();
+        return input;
+    }
+};
+
+class ssb_customer_t {
+   public:
+    d_long custkey;
+    d_string<SSB_READ_NAME_LEN> name;
+    d_string<SSB_READ_ADDR_MAX> address;
+    d_string<SSB_READ_CITY_LEN> city;
+    d_string<SSB_READ_NATION_LEN> nation;
+    d_string<SSB_READ_REGION_LEN> region;
+    d_string<SSB_READ_PHONE_LEN> phone;
+    d_string<SSB_READ_MKTSEG_LEN> mktsegment;
+
+    friend std::ostream& operator<<(std::ostream& output, ssb_customer_t& source) {
+        output << source.custkey << source.name << source.address << source.city << source.nation << source.region
+               << source.phone << source.mktsegment << std::endl;
+        return output;
+    }
+
+    friend std::istream& operator>>(std::istream& input, ssb_customer_t& target) {
+        input >> target.custkey >> target.name >> target.address >> target.city >> target.nation >> target.region >>
+            target.phone >> target.mktsegment;
+        input.get();
+        return input;
+    }
+};
+
+class ssb_supplier_t {
+   public:
+    d_long suppkey;
+    d_string<SSB_READ_NAME_LEN> name;
+    d_string<SSB_READ_ADDR_MAX> address;
+    d_string<SSB_READ_CITY_LEN> city;
+    d_string<SSB_READ_NATION_LEN> nation;
+    d_string<SSB_READ_REGION_LEN> region;
+    d_string<SSB_READ_PHONE_LEN> phone;
+
+    friend std::ostream& operator<<(std::ostream& output, ssb_supplier_t& source) {
+        output << source.suppkey << source.name << source.address << source.city << source.nation << source.region
+               << source.phone << std::endl;
+        return output;
+    }
+
+    friend std::istream& operator>>(std::istream& input, ssb_supplier_t& target) {
+        input >> target.suppkey >> target.name >> target.address >> target.city >> target.nation >> target.region >>
+            target.phone;
+        input.get();
+        return input;
+    }
+};
+
+class ssb_part_t {
+   public:
+    d_long partkey;
+    d_string<SSB_READ_P_NAME_LEN> name;
+    d_string<SSB_READ_MFGR_LEN> mfgr;
+    d_string<SSB_READ_CATEGORY_LEN> category;
+    d_string<SSB_READ_BRAND_LEN> brand1;
+    d_string<SSB_READ_COLOR_LEN> color;
+    d_string<SSB_READ_TYPE_LEN> type;
+    d_long size;
+    d_string<SSB_READ_CNTR_LEN> container;
+
+    friend std::ostream& operator<<(std::ostream& output, ssb_part_t& source) {
+        output << source.partkey << source.name << source.mfgr << source.category << source.brand1 << source.color
+               << source.type << source.size << source.container << std::endl;
+        return output;
+    }
+
+    friend std::istream& operator>>(std::istream& input, ssb_part_t& target) {
+        input >> target.partkey >> target.name >> target.mfgr >> target.category >> target.brand1 >> target.color >>
+            target.type >> target.size >> target.container;
+        input.get();
+        return input;
+    }
+};
+
+// ------------------------------------------------------------
+// dictionary encoding of SSB string attributes
+
+static const char* const ssb_region_names[SSB_REGION_NUM] = {"AFRICA", "AMERICA", "ASIA", "EUROPE", "MIDDLE EAST"};
+
+static const char* const ssb_nation_names[SSB_NATION_NUM] = {
+    "ALGERIA", "ARGENTINA", "BRAZIL",  "CANADA",       "EGYPT",          "ETHIOPIA",      "FRANCE",
+    "GERMANY", "INDIA",     "INDONESIA", "IRAN",       "IRAQ",           "JAPAN",         "JORDAN",
+    "KENYA",   "MOROCCO",   "MOZAMBIQUE", "PERU",      "CHINA",          "ROMANIA",       "SAUDI ARABIA",
+    "VIETNAM", "RUSSIA",    "UNITED KINGDOM", "UNITED STATES"};
+
+inline TPCH_INT ssb_region_id(const char* s) {
+    for (int i = 0; i < SSB_REGION_NUM; ++i) {
+        if (!strcmp(s, ssb_region_names[i])) return i;
+    }
+    return -1;
+}
+
+inline TPCH_INT ssb_nation_id(const char* s) {
+    for (int i = 0; i < SSB_NATION_NUM; ++i) {
+        if (!strcmp(s, ssb_nation_names[i])) return i;
+    }
+    return -1;
+}
+
+// city is the nation name truncated (or padded with space) to 9 chars, plus one digit.
+inline TPCH_INT ssb_city_id(const char* s) {
+    for (int i = 0; i < SSB_NATION_NUM; ++i) {
+        char prefix[10];
+        snprintf(prefix, sizeof(prefix), "%-9.9s", ssb_nation_names[i]);
+        if (!strncmp(s, prefix, 9)) return i * 10 + (s[9] - '0');
+    }
+    return -1;
+}
+
+// "MFGR#1", "MFGR#12" and "MFGR#2221" share the same prefix.
+inline TPCH_INT ssb_mfgr_id(const char* s) {
+    const char* p = strchr(s, '#');
+    return p ? (TPCH_INT)atoi(p + 1) : -1;
+}
+
+inline std::string ssb_region_name(TPCH_INT id) {
+    return (id >= 0 && id < SSB_REGION_NUM) ? std::string(ssb_region_names[id]) : std::string("?");
+}
+
+inline std::string ssb_nation_name(TPCH_INT id) {
+    return (id >= 0 && id < SSB_NATION_NUM) ? std::string(ssb_nation_names[id]) : std::string("?");
+}
+
+inline std::string ssb_city_name(TPCH_INT id) {
+    if (id < 0 || id >= SSB_NATION_NUM * 10) return std::string("?");
+    char name[11];
+    snprintf(name, sizeof(name), "%-9.9s%d", ssb_nation_names[id / 10], id % 10);
+    return std::string(name);
+}
+
+inline std::string ssb_mfgr_name(TPCH_INT id) {
+    return std::string("MFGR#") + std::to_string(id);
+}
+
+// ------------------------------------------------------------
+
+// lineorder cardinality is not an exact multiple of scale factor,
+// so number of rows is recovered from the size of a binary column.
+inline size_t ssb_get_nrow(const std::string& dir, const std::string& col) {
+    std::string fn = dir + "/" + col + ".dat";
+    struct stat info;
+    if (stat(fn.c_str(), &info) != 0) return 0;
+    return info.st_size / sizeof(TPCH_INT);
+}
+
+#endif // _SSB_READ_H
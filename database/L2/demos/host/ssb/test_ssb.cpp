@@ -0,0 +1,235 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "table_dt.hpp"
+#include "utils.hpp"
+
+#include <sys/time.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <climits>
+const int PU_NM = 8;
+#include "gqe_api.hpp"
+#include "ssb_gqe.hpp"
+
+/* Star Schema Benchmark on GQE.
+ *
+ * Each query is run -rep times and checked against the CPU reference,
+ * latency is reported per query, and the suite is summarized as total time,
+ * geometric mean and queries per hour.
+ * With -mode cpu, the CPU reference itself is measured and no device is used.
+ */
+
+struct SsbStat {
+    std::string name;
+    double min_ms;
+    double avg_ms;
+    double max_ms;
+    long krnl_ms;
+    bool pass;
+};
+
+int main(int argc, const char* argv[]) {
+    std::cout << "\n------------ SSB GQE -------------\n";
+
+    // cmd arg parser.
+    ArgParser parser(argc, argv);
+
+    std::string mode = "fpga";
+    parser.getCmdOption("-mode", mode);
+    bool on_cpu = (mode == "cpu" || mode == "CPU");
+
+    std::string xclbin_path; // eg. gqe_join.xclbin
+    if (!on_cpu && !parser.getCmdOption("-xclbin", xclbin_path)) {
+        std::cout << "ERROR: xclbin path is not set!\n";
+        return 1;
+    }
+
+    std::string in_dir;
+    if (!parser.getCmdOption("-in", in_dir) || !is_dir(in_dir)) {
+        std::cout << "ERROR: input dir is not specified or not valid.\n";
+        return 1;
+    }
+    int board = 0;
+    std::string board_s;
+    if (parser.getCmdOption("-b", board_s)) {
+        try {
+            board = std::stoi(board_s);
+        } catch (...) {
+            board = 0;
+        }
+    }
+    int num_rep = 1;
+    std::string num_str;
+    if (parser.getCmdOption("-rep", num_str)) {
+        try {
+            num_rep = std::stoi(num_str);
+        } catch (...) {
+            num_rep = 1;
+        }
+    }
+    if (num_rep < 1) num_rep = 1;
+    if (num_rep > 20) {
+        num_rep = 20;
+        std::cout << "WARNING: limited repeat to " << num_rep << " times\n.";
+    }
+    int scale = 1;
+    std::string scale_str;
+    if (parser.getCmdOption("-c", scale_str)) {
+        try {
+            scale = std::stoi(scale_str);
+        } catch (...) {
+            scale = 1;
+        }
+    }
+    std::string query = "all";
+    parser.getCmdOption("-q", query);
+    std::string csv_path;
+    parser.getCmdOption("-csv", csv_path);
+    std::cout << "NOTE:running in sf" << scale << " data\n.";
+
+    std::vector<SsbQuery> queries;
+    for (const SsbQuery& qr : ssb_queries()) {
+        if (query == "all" || query == qr.name) queries.push_back(qr);
+    }
+    if (queries.empty()) {
+        std::cout << "ERROR: unknown query " << query << ", expect Q1.1 ~ Q4.3 or all.\n";
+        return 1;
+    }
+
+    SsbColumns db;
+    if (db.load(in_dir)) return 1;
+    size_t lo_n = db.nrow("lo_orderdate");
+    std::cout << "lineorder has " << lo_n << " rows." << std::endl;
+
+    // ********************************************************** //
+
+    SsbGqe* gqe = nullptr;
+    cl::Context context;
+    cl::CommandQueue q;
+    cl::Program program;
+    if (!on_cpu) {
+        // Get CL devices.
+        std::vector<cl::Device> devices = xcl::get_xil_devices();
+        cl::Device device = devices[board];
+        // Create context and command queue for selected device
+        context = cl::Context(device);
+        q = cl::CommandQueue(context, device, CL_QUEUE_PROFILING_ENABLE | CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE);
+        std::string devName = device.getInfo<CL_DEVICE_NAME>();
+        std::cout << "Selected Device " << devName << "\n";
+
+        cl::Program::Binaries xclBins = xcl::import_binary_file(xclbin_path);
+        std::vector<cl::Device> devices_;
+        devices_.push_back(device);
+        program = cl::Program(context, devices_, xclBins);
+        std::cout << "Kernel has been created\n";
+
+        gqe = new SsbGqe(context, q, program, in_dir);
+        std::cout << "Tables have been loaded to device\n";
+    }
+
+    // ********************************************************* //
+
+    std::vector<SsbStat> stats;
+    int nerror = 0;
+    for (const SsbQuery& qr : queries) {
+        std::cout << "\n---- " << qr.name << " ----" << std::endl;
+        SsbStat st;
+        st.name = qr.name;
+        st.min_ms = 1e30;
+        st.max_ms = 0;
+        st.avg_ms = 0;
+        st.krnl_ms = 0;
+
+        SsbRange date;
+        if (!ssb_date_range(qr, db, date)) {
+            std::cout << "ERROR: date predicates of " << qr.name << " are not a range of d_datekey." << std::endl;
+            ++nerror;
+            continue;
+        }
+
+        std::vector<SsbRow> ref = ssb_sort(qr, ssb_cpu_query(qr, db));
+        std::vector<SsbRow> res;
+        bool failed = false;
+        for (int r = 0; r < num_rep && !failed; ++r) {
+            struct timeval tv_r_s, tv_r_e;
+            SsbGroup grp;
+            long krnl_ms = 0;
+            gettimeofday(&tv_r_s, 0);
+            if (on_cpu) {
+                grp = ssb_cpu_query(qr, db);
+            } else {
+                failed = gqe->run(qr, date, grp, krnl_ms) != 0;
+            }
+            res = ssb_sort(qr, grp);
+            gettimeofday(&tv_r_e, 0);
+            double ms = tvdiff(&tv_r_s, &tv_r_e) / 1000.0;
+            st.min_ms = std::min(st.min_ms, ms);
+            st.max_ms = std::max(st.max_ms, ms);
+            st.avg_ms += ms / num_rep;
+            st.krnl_ms = std::max(st.krnl_ms, krnl_ms);
+        }
+        ssb_print(qr, res);
+        st.pass = !failed && ssb_compare(ref, res);
+        if (!st.pass) ++nerror;
+        std::cout << qr.name << (st.pass ? " PASS" : " FAIL") << ", latency min/avg/max " << std::fixed
+                  << std::setprecision(3) << st.min_ms << "/" << st.avg_ms << "/" << st.max_ms << " ms";
+        if (!on_cpu) std::cout << ", kernel " << st.krnl_ms << " ms";
+        std::cout << ", " << lo_n / st.avg_ms / 1000.0 << " Mrows/s" << std::endl;
+        stats.push_back(st);
+    }
+
+    // summary
+    double total_ms = 0;
+    double log_sum = 0;
+    for (const SsbStat& st : stats) {
+        total_ms += st.avg_ms;
+        log_sum += std::log(std::max(st.avg_ms, 1e-3));
+    }
+    double geo_ms = stats.empty() ? 0 : std::exp(log_sum / stats.size());
+    double qph = total_ms > 0 ? stats.size() * 3600.0 * 1000.0 / total_ms : 0;
+    std::cout << "\n---- SSB summary, sf" << scale << ", " << mode << " ----" << std::endl;
+    std::cout << std::left << std::setw(8) << "query" << std::right << std::setw(12) << "avg(ms)" << std::setw(12)
+              << "Mrows/s" << std::setw(8) << "result" << std::endl;
+    for (const SsbStat& st : stats) {
+        std::cout << std::left << std::setw(8) << st.name << std::right << std::setw(12) << st.avg_ms << std::setw(12)
+                  << lo_n / st.avg_ms / 1000.0 << std::setw(8) << (st.pass ? "PASS" : "FAIL") << std::endl;
+    }
+    std::cout << "total " << total_ms << " ms, geomean " << geo_ms << " ms, " << qph << " queries per hour"
+              << std::endl;
+
+    if (!csv_path.empty()) {
+        std::ofstream csv(csv_path.c_str(), std::ios::app);
+        if (!csv) {
+            std::cout << "ERROR: " << csv_path << " cannot be opened for write." << std::endl;
+            ++nerror;
+        } else {
+            for (const SsbStat& st : stats) {
+                csv << "ssb," << scale << "," << mode << "," << st.name << "," << st.min_ms << "," << st.avg_ms << ","
+                    << st.max_ms << "," << st.krnl_ms << "," << lo_n / st.avg_ms / 1000.0 << ","
+                    << (st.pass ? "PASS" : "FAIL") << std::endl;
+            }
+            csv << "ssb," << scale << "," << mode << ",total,," << total_ms << ",,,,"
+                << "geomean=" << geo_ms << ";qph=" << qph << std::endl;
+        }
+    }
+
+    delete gqe;
+    return nerror;
+}
@@ -109,10 +109,18 @@ enum OptionStyle {
     Asian_GP,
     EuropeanBypass
 };
+/**
+ * @brief Greeks returned by the Monte Carlo Greeks engines, in this order
+ */
+enum GreeksType { kGreeksPrice, kGreeksDelta, kGreeksGamma, kGreeksVega, kGreeksRho, kGreeksNum };
 /**
  * @brief Barrier Option type
  */
 enum BarrierType { DownIn, DownOut, UpIn, UpOut };
+/**
+ * @brief Trade type of the exposure engine
+ */
+enum TradeType { kTradeSwap, kTradeForward, kTradeOption };
 } // namespace enums
 using namespace enums;
 } // namespace fintech
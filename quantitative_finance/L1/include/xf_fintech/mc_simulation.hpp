@@ -197,6 +197,124 @@ void InitWrap(RNG rngInst[UnrollNm][VariateNum], RNGSeqT rngSeqInst[UnrollNm][1]
         rngSeqInst[i][0].Init(rngInst[i]);
     }
 }
+
+template <typename DT, int N>
+void greeksAccumulator(ap_uint<16> paths,
+                       hls::stream<DT> greeksStrmIn[N],
+                       hls::stream<DT> sumStrm[N],
+                       hls::stream<DT>& squareSumStrm) {
+#pragma HLS inline off
+    const unsigned int DEP = 16;
+    DT sumBuffer[N][DEP]; // because the latency of ACC_LOOP is 14
+#pragma HLS array_partition variable = sumBuffer dim = 1
+    DT squareSumBuffer[DEP];
+BUFF_INIT_LOOP:
+    for (int i = 0; i < DEP; ++i) {
+#pragma HLS pipeline II = 1
+        for (int k = 0; k < N; ++k) {
+#pragma HLS unroll
+            sumBuffer[k][i] = 0;
+        }
+        squareSumBuffer[i] = 0;
+    }
+    ap_uint<4> cnt = 0;
+ACC_LOOP:
+    for (int i = 0; i < paths; ++i) {
+#pragma HLS pipeline II = 1
+#pragma HLS loop_tripcount min = 1024 max = 1024
+        // only the price decides the error estimate
+        DT price = 0;
+        for (int k = 0; k < N; ++k) {
+#pragma HLS unroll
+            DT temp = greeksStrmIn[k].read();
+            if (k == 0) {
+                price = temp;
+            }
+            sumBuffer[k][cnt] = FPTwoAdd(sumBuffer[k][cnt], temp);
+        }
+        squareSumBuffer[cnt] = FPTwoAdd(squareSumBuffer[cnt], FPTwoMul(price, price));
+        cnt++;
+    }
+POST_ACC_LOOP:
+    for (int k = 0; k < N; ++k) {
+        DT sum = 0;
+        for (int i = 0; i < DEP; ++i) {
+#pragma HLS pipeline II = 8
+            sum += sumBuffer[k][i];
+        }
+        sumStrm[k].write(sum);
+    }
+    DT squareSum = 0;
+    for (int i = 0; i < DEP; ++i) {
+#pragma HLS pipeline II = 8
+        squareSum += squareSumBuffer[i];
+    }
+    squareSumStrm.write(squareSum);
+}
+
+template <typename DT, typename RNG, typename PathGeneratorT, typename PathPricerT, typename RNGSeqT, int VariateNum>
+void monteCarloGreeksModel(ap_uint<16> steps,
+                           ap_uint<16> paths,
+                           RNG rngInst[VariateNum],
+                           PathGeneratorT pathGenInst[1],
+                           PathPricerT pathPriInst[1],
+                           RNGSeqT rngSeqInst[1],
+                           hls::stream<DT> sumStrm[PathPricerT::GreeksN],
+                           hls::stream<DT>& squareSumStrm) {
+#pragma HLS inline off
+#pragma HLS DATAFLOW
+    const static unsigned int RN = RNGSeqT::OutN;
+    const static unsigned int GN = PathPricerT::GreeksN;
+
+    hls::stream<DT> rdNmStrm[RN];
+#pragma HLS stream variable = rdNmStrm depth = 8
+    hls::stream<DT> pathStrm[1];
+#pragma HLS stream variable = pathStrm depth = 8
+    hls::stream<DT> greeksStrm[GN];
+#pragma HLS stream variable = greeksStrm depth = 8
+    // Generate random number
+    rngSeqInst[0].NextSeq(steps, paths, rngInst, rdNmStrm);
+    pathGenInst[0].NextPath(steps, paths, rdNmStrm, pathStrm);
+    pathPriInst[0].Pricing(steps, paths, pathStrm, greeksStrm);
+    greeksAccumulator<DT, GN>(paths, greeksStrm, sumStrm, squareSumStrm);
+}
+
+template <typename DT,
+          typename RNG,
+          int UnrollNm,
+          typename PathGeneratorT,
+          typename PathPricerT,
+          typename RNGSeqT,
+          int VariateNum>
+void MultipleMonteCarloGreeksModel(ap_uint<16> steps,
+                                   ap_uint<16> paths,
+                                   RNG rngInst[UnrollNm][VariateNum],
+                                   PathGeneratorT pathGenInst[UnrollNm][1],
+                                   PathPricerT pathPriInst[UnrollNm][1],
+                                   RNGSeqT rngSeqInst[UnrollNm][1],
+                                   DT sum[PathPricerT::GreeksN],
+                                   DT& squareSum) {
+    const static unsigned int GN = PathPricerT::GreeksN;
+    hls::stream<DT> sumStrm[UnrollNm][GN];
+#pragma HLS stream variable = sumStrm depth = 8
+#pragma HLS array_partition variable = sumStrm dim = 0
+    hls::stream<DT> squareSumStrm[UnrollNm];
+#pragma HLS stream variable = squareSumStrm depth = 8
+#pragma HLS array_partition variable = squareSumStrm dim = 0
+
+    for (int i = 0; i < UnrollNm; ++i) {
+#pragma HLS unroll
+        monteCarloGreeksModel<DT, RNG, PathGeneratorT, PathPricerT, RNGSeqT, VariateNum>(
+            steps, paths, rngInst[i], pathGenInst[i], pathPriInst[i], rngSeqInst[i], sumStrm[i], squareSumStrm[i]);
+    }
+    for (int i = 0; i < UnrollNm; ++i) {
+#pragma HLS pipeline
+        for (int k = 0; k < GN; ++k) {
+            sum[k] = FPTwoAdd(sum[k], sumStrm[i][k].read());
+        }
+        squareSum = FPTwoAdd(squareSum, squareSumStrm[i].read());
+    }
+}
 } // namespace internal
 /**
  * @brief Monte Carlo Framework implementation
@@ -310,6 +428,286 @@ Req_Samples_Loop:
 #endif
     return mean; // SampleMean(sum, totalSamples);
 }
+
+/**
+ * @brief Monte Carlo Framework implementation returning the price and its Greeks in the same pass
+ *
+ * Each path is priced once by a GreeksPathPricer, which returns the pathwise or likelihood-ratio estimators of
+ * the Greeks along with the price, so the Greeks cost no extra simulation and share the random numbers of the
+ * price. The number of samples is decided by the tolerance on the price, as in mcSimulation.
+ *
+ * @tparam DT supported data type including double and float data type, which
+ * decides the precision of result, default double-precision data type.
+ * @tparam RNG random number generator type.
+ * @tparam PathGeneratorT path generator type which simulates the dynamics of
+ * the asset price, BSPathGenerator with sample first order.
+ * @tparam PathPricerT Greeks path pricer type, GreeksPathPricer.
+ * @tparam RNGSeqT random number sequence generator type.
+ * @tparam UN number of Monte Carlo Module in parallel, which affects the
+ * latency and resources utilization.
+ * @tparam VariateNum number of variate.
+ * @tparam SampNum the total samples are divided into several steps, SampNum is
+ * the number for each step.
+ * @param timeSteps number of the steps for each path.
+ * @param maxSamples the maximum sample number. When reaching it, the simulation
+ * will stop.
+ * @param requiredTolerance the tolerance required on the price. If requiredSamples is not
+ * set, when reaching the required tolerance, simulation will stop.
+ * @param requiredSamples the samples number required. When reaching the
+ * required number, simulation will stop.
+ * @param pathGenInst instance of path generator.
+ * @param pathPriInst instance of path pricer.
+ * @param rngSeqInst instance of random number sequence.
+ * @param greeks the price and Greeks, in the order of GreeksType.
+ */
+template <typename DT,
+          typename RNG,
+          typename PathGeneratorT,
+          typename PathPricerT,
+          typename RNGSeqT,
+          int UN,
+          int VariateNum,
+          int SampNum>
+void mcSimulationGreeks(ap_uint<16> timeSteps,
+                        ap_uint<27> maxSamples,
+                        ap_uint<27> requiredSamples,
+                        DT requiredTolerance,
+                        PathGeneratorT pathGenInst[UN][1],
+                        PathPricerT pathPriInst[UN][1],
+                        RNGSeqT rngSeqInst[UN][1],
+                        DT greeks[PathPricerT::GreeksN]) {
+    const static unsigned int GN = PathPricerT::GreeksN;
+    // total number of samples per simulation
+    const static ap_uint<16> Batch = UN * SampNum;
+
+    // RNG Instance
+    RNG rngInst[UN][VariateNum];
+#pragma HLS array_partition variable = rngInst dim = 0
+
+    // Initialize RNG
+    internal::InitWrap<RNG, RNGSeqT, UN, VariateNum>(rngInst, rngSeqInst);
+
+    // record the total number of samples
+    ap_uint<27> totalSamples = 0;
+
+    // sums of all samples of the price and the Greeks
+    DT sum[GN];
+#pragma HLS array_partition variable = sum dim = 0
+    for (int k = 0; k < GN; ++k) {
+#pragma HLS unroll
+        sum[k] = 0;
+    }
+    // square sum of all samples of the price
+    DT squareSum = 0;
+
+    // simulation times
+    ap_uint<17> loopNum = 0;
+
+    if (requiredSamples > 0) {
+        loopNum = (requiredSamples + Batch - 1) / Batch;
+        totalSamples = loopNum * Batch;
+    } else {
+        loopNum = 1;
+        totalSamples = Batch;
+    }
+
+Req_Samples_Loop:
+    for (int i = 0; i < loopNum; ++i) {
+#pragma HLS loop_tripcount min = 1 max = 1
+        internal::MultipleMonteCarloGreeksModel<DT, RNG, UN, PathGeneratorT, PathPricerT, RNGSeqT, VariateNum>(
+            timeSteps, SampNum, rngInst, pathGenInst, pathPriInst, rngSeqInst, sum, squareSum);
+    }
+    DT mean = internal::SampleMean(sum[kGreeksPrice], totalSamples);
+    DT error = internal::SampleErrorEstimate(mean, sum[kGreeksPrice], squareSum, totalSamples);
+    if (requiredSamples == 0) {
+    Req_Tolerance_Loop:
+        while ((requiredTolerance < error) && ((maxSamples > 0 && totalSamples < maxSamples) || maxSamples == 0)) {
+#pragma HLS loop_tripcount min = 5 max = 5
+            totalSamples += Batch;
+            // Monte Carlo Module
+            internal::MultipleMonteCarloGreeksModel<DT, RNG, UN, PathGeneratorT, PathPricerT, RNGSeqT, VariateNum>(
+                timeSteps, SampNum, rngInst, pathGenInst, pathPriInst, rngSeqInst, sum, squareSum);
+            mean = internal::SampleMean(sum[kGreeksPrice], totalSamples);
+            error = internal::SampleErrorEstimate(mean, sum[kGreeksPrice], squareSum, totalSamples);
+        }
+    }
+    for (int k = 0; k < GN; ++k) {
+#pragma HLS pipeline
+        greeks[k] = internal::SampleMean(sum[k], totalSamples);
+    }
+}
+/**
+ * @brief Monte Carlo Framework implementation of one level of multilevel Monte Carlo
+ *
+ * Each path is priced by a MultiLevelPathPricer, on the fine time steps and on the coarse time steps of the same
+ * Brownian increments. The number of samples is set by the caller, which chooses it for each level from the
+ * variances returned, so there is no tolerance loop.
+ *
+ * @tparam DT supported data type including double and float data type, which
+ * decides the precision of result, default double-precision data type.
+ * @tparam RNG random number generator type.
+ * @tparam PathGeneratorT path generator type which simulates the dynamics of
+ * the asset price, BSPathGenerator with sample first order.
+ * @tparam PathPricerT multilevel path pricer type, MultiLevelPathPricer.
+ * @tparam RNGSeqT random number sequence generator type.
+ * @tparam UN number of Monte Carlo Module in parallel, which affects the
+ * latency and resources utilization.
+ * @tparam VariateNum number of variate.
+ * @tparam SampNum the total samples are divided into several steps, SampNum is
+ * the number for each step.
+ * @param timeSteps number of the fine steps for each path.
+ * @param requiredSamples the samples number required, rounded up to a multiple of UN * SampNum.
+ * @param pathGenInst instance of path generator.
+ * @param pathPriInst instance of path pricer.
+ * @param rngSeqInst instance of random number sequence.
+ * @param output the mean and variance of the difference of the fine and coarse payoffs, the mean of the fine
+ * payoff and the number of samples.
+ */
+template <typename DT,
+          typename RNG,
+          typename PathGeneratorT,
+          typename PathPricerT,
+          typename RNGSeqT,
+          int UN,
+          int VariateNum,
+          int SampNum>
+void mcSimulationMultiLevel(ap_uint<16> timeSteps,
+                            ap_uint<27> requiredSamples,
+                            PathGeneratorT pathGenInst[UN][1],
+                            PathPricerT pathPriInst[UN][1],
+                            RNGSeqT rngSeqInst[UN][1],
+                            DT output[4]) {
+    const static unsigned int GN = PathPricerT::GreeksN;
+    // total number of samples per simulation
+    const static ap_uint<16> Batch = UN * SampNum;
+
+    // RNG Instance
+    RNG rngInst[UN][VariateNum];
+#pragma HLS array_partition variable = rngInst dim = 0
+
+    // Initialize RNG
+    internal::InitWrap<RNG, RNGSeqT, UN, VariateNum>(rngInst, rngSeqInst);
+
+    // sums of the difference and of the fine payoff
+    DT sum[GN];
+#pragma HLS array_partition variable = sum dim = 0
+    for (int k = 0; k < GN; ++k) {
+#pragma HLS unroll
+        sum[k] = 0;
+    }
+    // square sum of the difference
+    DT squareSum = 0;
+
+    // simulation times
+    ap_uint<17> loopNum = 1;
+    if (requiredSamples > 0) {
+        loopNum = (requiredSamples + Batch - 1) / Batch;
+    }
+    ap_uint<27> totalSamples = loopNum * Batch;
+
+Req_Samples_Loop:
+    for (int i = 0; i < loopNum; ++i) {
+#pragma HLS loop_tripcount min = 1 max = 1
+        internal::MultipleMonteCarloGreeksModel<DT, RNG, UN, PathGeneratorT, PathPricerT, RNGSeqT, VariateNum>(
+            timeSteps, SampNum, rngInst, pathGenInst, pathPriInst, rngSeqInst, sum, squareSum);
+    }
+
+    DT mean = internal::SampleMean(sum[0], totalSamples);
+    output[0] = mean;
+    output[1] = internal::FPTwoMul(internal::FPTwoSub(squareSum, internal::FPTwoMul(mean, sum[0])),
+                                   (DT)1.0 / (DT)(totalSamples - 1));
+    output[2] = internal::SampleMean(sum[1], totalSamples);
+    output[3] = (DT)totalSamples;
+}
+
+/**
+ * @brief Randomized quasi-Monte Carlo Framework implementation
+ *
+ * The simulation is run once per replication, each with its own randomization of a quasi-random sequence and the
+ * same number of samples. The price is the mean of the replications, and its standard error is estimated from their
+ * spread, as the samples of a quasi-random sequence are not independent and their variance does not measure the
+ * error.
+ *
+ * @tparam DT supported data type including double and float data type, which
+ * decides the precision of result, default double-precision data type.
+ * @tparam RNG random number generator type.
+ * @tparam PathGeneratorT path generator type which simulates the dynamics of
+ * the asset price.
+ * @tparam PathPricerT path pricer type which calcualtes the option price based
+ * on asset price.
+ * @tparam RNGSeqT quasi-random number sequence type, like SobolBridgeSequence, randomized by its seed.
+ * @tparam UN number of Monte Carlo Module in parallel, which affects the
+ * latency and resources utilization.
+ * @tparam VariateNum number of variate.
+ * @tparam SampNum the total samples are divided into several steps, SampNum is
+ * the number for each step.
+ * @param timeSteps number of the steps for each path.
+ * @param requiredSamples the samples number of each replication, rounded up to a multiple of UN * SampNum. The
+ * points of a sobol sequence are best balanced when it is a power of 2.
+ * @param replications number of replications.
+ * @param seed seed of the first replication, replication r uses seed + r.
+ * @param pathGenInst instance of path generator.
+ * @param pathPriInst instance of path pricer.
+ * @param rngSeqInst instance of random number sequence.
+ * @param output the price and its standard error.
+ */
+template <typename DT,
+          typename RNG,
+          typename PathGeneratorT,
+          typename PathPricerT,
+          typename RNGSeqT,
+          int UN,
+          int VariateNum,
+          int SampNum>
+void mcSimulationQMC(ap_uint<16> timeSteps,
+                     ap_uint<27> requiredSamples,
+                     ap_uint<16> replications,
+                     ap_uint<32> seed,
+                     PathGeneratorT pathGenInst[UN][1],
+                     PathPricerT pathPriInst[UN][1],
+                     RNGSeqT rngSeqInst[UN][1],
+                     DT output[2]) {
+    // total number of samples per simulation
+    const static ap_uint<16> Batch = UN * SampNum;
+
+    // without a number of samples, the tolerance loop of mcSimulation would not stop
+    if (requiredSamples == 0) {
+        requiredSamples = Batch;
+    }
+
+    // sum and square sum of the prices of the replications, less the first one, which keeps the precision of the
+    // variance when the replications are close
+    DT first = 0;
+    DT sum = 0;
+    DT squareSum = 0;
+
+Replication_Loop:
+    for (int r = 0; r < replications; ++r) {
+#pragma HLS loop_tripcount min = 16 max = 16
+        for (int i = 0; i < UN; ++i) {
+#pragma HLS unroll
+            rngSeqInst[i][0].seed[0] = seed + r;
+        }
+        DT price = mcSimulation<DT, RNG, PathGeneratorT, PathPricerT, RNGSeqT, UN, VariateNum, SampNum>(
+            timeSteps, requiredSamples, requiredSamples, 0, pathGenInst, pathPriInst, rngSeqInst);
+        if (r == 0) {
+            first = price;
+        }
+        DT diff = internal::FPTwoSub(price, first);
+        sum = internal::FPTwoAdd(sum, diff);
+        squareSum = internal::FPTwoAdd(squareSum, internal::FPTwoMul(diff, diff));
+    }
+
+    DT meanDiff = sum / replications;
+    DT mean = internal::FPTwoAdd(first, meanDiff);
+    DT error = 0;
+    if (replications > 1) {
+        DT variance = internal::FPTwoSub(squareSum, internal::FPTwoMul(meanDiff, sum)) / (replications - 1);
+        error = hls::sqrt(MAX(variance, 0) / replications);
+    }
+    output[0] = mean;
+    output[1] = error;
+}
 } // namespace fintech
 } // namespace xf
 #endif
@@ -1656,6 +1656,638 @@ class CapFloorPathPricer {
     }
 };
 
+/**
+ * @brief Model parameters and likelihood-ratio weights shared by the Greeks path pricers.
+ *
+ * The Greeks path pricers read the increments x_i = drift + stdDev * z_i of log price from BSPathGenerator,
+ * samples first, and recover the normal numbers z_i. Each path gives GreeksN values, in the order of GreeksType:
+ * price, delta, gamma, vega and rho, whose sample means are the estimates.
+ *
+ * Likelihood-ratio (LR) estimators multiply the price of the path by the score of the path density:
+ * delta by z_1 / (S_0 * stdDev), gamma by ((z_1^2 - 1) / stdDev - z_1) / (S_0^2 * stdDev),
+ * vega by sum((z_i^2 - 1) / sigma - z_i * sqrt(dt)) and rho by sum(z_i) * sqrt(dt) / sigma.
+ */
+template <typename DT>
+class GreeksPathPricerBase {
+   public:
+    const static unsigned int InN = 1;
+    const static unsigned int GreeksN = kGreeksNum;
+    const static bool byPassGen = false;
+
+    // configuration of the path pricer, same as BSModel of the path generator
+    DT underlying;
+    DT volatility;
+    DT riskFreeRate;
+    DT dividendYield;
+    DT dt;
+    DT drift;
+    DT stdDev;
+
+    // calculated by setup()
+    DT invStdDev;
+    DT sqrtDt;
+    DT invVolatility;
+    DT invUnderlying;
+    DT driftVega;
+
+    GreeksPathPricerBase() {}
+
+    /**
+     * @brief calculate the constants of the estimators, once the configuration is set
+     */
+    void setup() {
+        invStdDev = (DT)1.0 / stdDev;
+        sqrtDt = hls::sqrt(dt);
+        invVolatility = (DT)1.0 / volatility;
+        invUnderlying = (DT)1.0 / underlying;
+        // d(log S_i) / d(sigma) = (log(S_i / S_0) - driftVega * i) / sigma
+        driftVega = FPTwoAdd(FPTwoMul(FPTwoSub(riskFreeRate, dividendYield), dt), FPTwoMul((DT)0.5, stdDev * stdDev));
+    }
+
+    // normal number of increment dLogS
+    DT normal(DT dLogS) { return FPTwoMul(FPTwoSub(dLogS, drift), invStdDev); }
+
+    // LR weight of delta, the score of S_0
+    DT deltaWeight(DT z1) { return z1 * invStdDev * invUnderlying; }
+
+    /**
+     * @brief write the LR estimators for a path of price p, paid at step payStep
+     */
+    void lrGreeks(DT p,
+                  ap_uint<16> payStep,
+                  DT z1,
+                  DT sumZ,
+                  DT sumZZ,
+                  ap_uint<16> steps,
+                  hls::stream<DT> greeksStrmOut[GreeksN]) {
+#pragma HLS inline
+        DT wDelta = deltaWeight(z1);
+        DT wGamma = FPTwoMul(FPTwoSub(FPTwoMul(FPTwoSub(z1 * z1, (DT)1.0), invStdDev), z1),
+                             invStdDev * invUnderlying * invUnderlying);
+        DT wVega = FPTwoSub(FPTwoMul(FPTwoSub(sumZZ, (DT)steps), invVolatility), FPTwoMul(sumZ, sqrtDt));
+        // the discount of the payment adds -t to the score of r
+        DT wRho = FPTwoSub(FPTwoMul(FPTwoMul(sumZ, sqrtDt), invVolatility), FPTwoMul(dt, (DT)payStep));
+        greeksStrmOut[kGreeksPrice].write(p);
+        greeksStrmOut[kGreeksDelta].write(FPTwoMul(p, wDelta));
+        greeksStrmOut[kGreeksGamma].write(FPTwoMul(p, wGamma));
+        greeksStrmOut[kGreeksVega].write(FPTwoMul(p, wVega));
+        greeksStrmOut[kGreeksRho].write(FPTwoMul(p, wRho));
+    }
+};
+
+/**
+ * @brief Path pricer of price and Greeks, for the payoff of option style and Black-Scholes model
+ *
+ * @tparam style option style
+ * @tparam DT supported data type including double and float
+ * @tparam SampNum number of paths in each call
+ */
+template <OptionStyle style, typename DT, int SampNum>
+class GreeksPathPricer : public GreeksPathPricerBase<DT> {};
+
+/**
+ * @brief European option, pathwise delta, vega and rho, and mixed LR-pathwise gamma.
+ *
+ * With k the pathwise derivative of the discounted payoff in S_0, times S_0, delta is k / S_0, vega is
+ * k * d(log S_T) / d(sigma), rho is k * T - T * price and gamma is delta * (z_1 / (S_0 * stdDev) - 1 / S_0).
+ */
+template <typename DT, int SampNum>
+class GreeksPathPricer<European, DT, SampNum> : public GreeksPathPricerBase<DT> {
+   public:
+    typedef GreeksPathPricerBase<DT> Base;
+
+    DT strike;
+    DT discount;
+    bool optionType;
+
+    GreeksPathPricer() {}
+
+    void Pricing(ap_uint<16> steps,
+                 ap_uint<16> paths,
+                 hls::stream<DT> pathStrmIn[1],
+                 hls::stream<DT> greeksStrmOut[Base::GreeksN]) {
+#pragma HLS inline off
+        DT logSBuff[SampNum];
+        DT z1Buff[SampNum];
+        DT T = FPTwoMul(this->dt, (DT)steps);
+        for (int i = 0; i < steps; ++i) {
+#pragma HLS loop_tripcount min = 8 max = 8
+            for (int j = 0; j < paths; ++j) {
+#pragma HLS loop_tripcount min = SampNum max = SampNum
+#pragma HLS pipeline II = 1
+                DT dLogS = pathStrmIn[0].read();
+                DT preLogS = (i == 0) ? (DT)0.0 : logSBuff[j];
+                DT logS = FPTwoAdd(preLogS, dLogS);
+                logSBuff[j] = logS;
+                if (i == 0) {
+                    z1Buff[j] = this->normal(dLogS);
+                }
+                if (i == steps - 1) {
+                    DT s = FPTwoMul(this->underlying, FPExp(logS));
+                    DT op1, op2;
+                    if (optionType) {
+                        op1 = strike;
+                        op2 = s;
+                    } else {
+                        op1 = s;
+                        op2 = strike;
+                    }
+                    DT payoff = MAX(FPTwoSub(op1, op2), 0);
+                    DT price = FPTwoMul(discount, payoff);
+                    DT k = 0;
+                    if (payoff > 0) {
+                        k = optionType ? -FPTwoMul(discount, s) : FPTwoMul(discount, s);
+                    }
+                    DT delta = FPTwoMul(k, this->invUnderlying);
+                    DT dLogSdVol = FPTwoMul(FPTwoSub(logS, FPTwoMul(this->driftVega, (DT)steps)), this->invVolatility);
+                    greeksStrmOut[kGreeksPrice].write(price);
+                    greeksStrmOut[kGreeksDelta].write(delta);
+                    greeksStrmOut[kGreeksGamma].write(
+                        FPTwoMul(delta, FPTwoSub(this->deltaWeight(z1Buff[j]), this->invUnderlying)));
+                    greeksStrmOut[kGreeksVega].write(FPTwoMul(k, dLogSdVol));
+                    greeksStrmOut[kGreeksRho].write(FPTwoMul(FPTwoSub(k, price), T));
+                }
+            }
+        }
+    }
+};
+
+/**
+ * @brief Arithmetic average price Asian option, pathwise delta, vega and rho, and mixed LR-pathwise gamma.
+ *
+ * The average includes S_0 and the prices of all the steps, without the geometric control variate of
+ * PathPricer<Asian_AP>. The estimators are the ones of the European option, with the derivatives of the average,
+ * except gamma. As S_0 is in the average besides S_1 = S_0 * exp(x_1), gamma is
+ * delta * (z_1 / (S_0 * stdDev) - 1 / S_0 + (1 + z_1 / stdDev) / (S_0 * sum(S_i / S_0, i >= 1))).
+ */
+template <typename DT, int SampNum>
+class GreeksPathPricer<Asian_AP, DT, SampNum> : public GreeksPathPricerBase<DT> {
+   public:
+    typedef GreeksPathPricerBase<DT> Base;
+
+    DT strike;
+    DT discount;
+    bool optionType;
+
+    GreeksPathPricer() {}
+
+    void Pricing(ap_uint<16> steps,
+                 ap_uint<16> paths,
+                 hls::stream<DT> pathStrmIn[1],
+                 hls::stream<DT> greeksStrmOut[Base::GreeksN]) {
+#pragma HLS inline off
+        DT logSBuff[SampNum];
+        DT z1Buff[SampNum];
+        // sums of S_i / S_0, of S_i / S_0 * d(log S_i) / d(sigma) * sigma and of S_i / S_0 * i
+        DT sumSBuff[SampNum];
+        DT sumSVBuff[SampNum];
+        DT sumSTBuff[SampNum];
+        DT T = FPTwoMul(this->dt, (DT)steps);
+        DT invN = (DT)1.0 / (DT)(steps + 1);
+        for (int i = 0; i < steps; ++i) {
+#pragma HLS loop_tripcount min = 8 max = 8
+            for (int j = 0; j < paths; ++j) {
+#pragma HLS loop_tripcount min = SampNum max = SampNum
+#pragma HLS pipeline II = 1
+                DT dLogS = pathStrmIn[0].read();
+                DT preLogS, preSumS, preSumSV, preSumST;
+                if (i == 0) {
+                    preLogS = 0;
+                    preSumS = 1;
+                    preSumSV = 0;
+                    preSumST = 0;
+                    z1Buff[j] = this->normal(dLogS);
+                } else {
+                    preLogS = logSBuff[j];
+                    preSumS = sumSBuff[j];
+                    preSumSV = sumSVBuff[j];
+                    preSumST = sumSTBuff[j];
+                }
+                DT logS = FPTwoAdd(preLogS, dLogS);
+                DT e = FPExp(logS);
+                DT sumS = FPTwoAdd(preSumS, e);
+                DT sumSV = FPTwoAdd(preSumSV, FPTwoMul(e, FPTwoSub(logS, FPTwoMul(this->driftVega, (DT)(i + 1)))));
+                DT sumST = FPTwoAdd(preSumST, FPTwoMul(e, (DT)(i + 1)));
+                logSBuff[j] = logS;
+                sumSBuff[j] = sumS;
+                sumSVBuff[j] = sumSV;
+                sumSTBuff[j] = sumST;
+                if (i == steps - 1) {
+                    DT avg = FPTwoMul(FPTwoMul(sumS, invN), this->underlying);
+                    DT op1, op2;
+                    if (optionType) {
+                        op1 = strike;
+                        op2 = avg;
+                    } else {
+                        op1 = avg;
+                        op2 = strike;
+                    }
+                    DT payoff = MAX(FPTwoSub(op1, op2), 0);
+                    DT price = FPTwoMul(discount, payoff);
+                    // discount * d(payoff) / d(average)
+                    DT g = 0;
+                    if (payoff > 0) {
+                        g = optionType ? -discount : discount;
+                    }
+                    DT gS0 = FPTwoMul(FPTwoMul(g, this->underlying), invN);
+                    DT delta = FPTwoMul(FPTwoMul(g, sumS), invN);
+                    // S_0 is in the average besides S_1, which adds the score of S_1 to the weight of gamma
+                    DT z1 = z1Buff[j];
+                    DT wS1 = FPTwoMul(FPTwoAdd((DT)1.0, FPTwoMul(z1, this->invStdDev)),
+                                      this->invUnderlying / FPTwoSub(sumS, (DT)1.0));
+                    DT wGamma = FPTwoAdd(FPTwoSub(this->deltaWeight(z1), this->invUnderlying), wS1);
+                    greeksStrmOut[kGreeksPrice].write(price);
+                    greeksStrmOut[kGreeksDelta].write(delta);
+                    greeksStrmOut[kGreeksGamma].write(FPTwoMul(delta, wGamma));
+                    greeksStrmOut[kGreeksVega].write(FPTwoMul(FPTwoMul(gS0, sumSV), this->invVolatility));
+                    greeksStrmOut[kGreeksRho].write(
+                        FPTwoSub(FPTwoMul(FPTwoMul(gS0, sumST), this->dt), FPTwoMul(price, T)));
+                }
+            }
+        }
+    }
+};
+
+/**
+ * @brief Barrier option monitored at each step, as PathPricer<BarrierBiased>, LR estimators for all Greeks.
+ *
+ * The payoff is discontinuous at the barrier, where pathwise derivatives miss the probability mass crossing it.
+ */
+template <typename DT, int SampNum>
+class GreeksPathPricer<BarrierBiased, DT, SampNum> : public GreeksPathPricerBase<DT> {
+   public:
+    typedef GreeksPathPricerBase<DT> Base;
+
+    DT barrier;
+    DT strike;
+    DT rebate;
+    DT disDt;
+    bool optionType;
+    ap_uint<2> barrierType;
+
+    GreeksPathPricer() {}
+
+    void Pricing(ap_uint<16> steps,
+                 ap_uint<16> paths,
+                 hls::stream<DT> pathStrmIn[1],
+                 hls::stream<DT> greeksStrmOut[Base::GreeksN]) {
+#pragma HLS inline off
+        DT logSBuff[SampNum];
+        DT z1Buff[SampNum];
+        DT sumZBuff[SampNum];
+        DT sumZZBuff[SampNum];
+        bool actBuff[SampNum];
+        ap_uint<16> actPosBuff[SampNum];
+        for (int i = 0; i < steps; ++i) {
+#pragma HLS loop_tripcount min = 8 max = 8
+            for (int j = 0; j < paths; ++j) {
+#pragma HLS loop_tripcount min = SampNum max = SampNum
+#pragma HLS pipeline II = 1
+                DT dLogS = pathStrmIn[0].read();
+                DT z = this->normal(dLogS);
+                DT preLogS, preSumZ, preSumZZ;
+                bool oldAct;
+                ap_uint<16> oldPos;
+                if (i == 0) {
+                    preLogS = 0;
+                    preSumZ = 0;
+                    preSumZZ = 0;
+                    oldAct = false;
+                    oldPos = 0;
+                    z1Buff[j] = z;
+                } else {
+                    preLogS = logSBuff[j];
+                    preSumZ = sumZBuff[j];
+                    preSumZZ = sumZZBuff[j];
+                    oldAct = actBuff[j];
+                    oldPos = actPosBuff[j];
+                }
+                DT logS = FPTwoAdd(preLogS, dLogS);
+                DT sumZ = FPTwoAdd(preSumZ, z);
+                DT sumZZ = FPTwoAdd(preSumZZ, FPTwoMul(z, z));
+                logSBuff[j] = logS;
+                sumZBuff[j] = sumZ;
+                sumZZBuff[j] = sumZZ;
+
+                DT s = FPTwoMul(this->underlying, FPExp(logS));
+                bool isEx = ((barrierType == DownIn || barrierType == DownOut) && s <= barrier) ||
+                            ((barrierType == UpIn || barrierType == UpOut) && s >= barrier);
+                bool curAct = oldAct || isEx;
+                ap_uint<16> newPos = (isEx && !oldAct) ? (ap_uint<16>)i : oldPos;
+                actBuff[j] = curAct;
+                actPosBuff[j] = newPos;
+
+                if (i == steps - 1) {
+                    DT payoff;
+                    ap_uint<16> pos;
+                    if ((curAct && (barrierType == DownIn || barrierType == UpIn)) ||
+                        (!curAct && (barrierType == DownOut || barrierType == UpOut))) {
+                        DT op1, op2;
+                        if (optionType) {
+                            op1 = strike;
+                            op2 = s;
+                        } else {
+                            op1 = s;
+                            op2 = strike;
+                        }
+                        payoff = MAX(FPTwoSub(op1, op2), 0);
+                        pos = steps;
+                    } else {
+                        payoff = rebate;
+                        pos = (barrierType == UpIn || barrierType == DownIn) ? steps : newPos;
+                    }
+                    DT price = FPTwoMul(payoff, FPExp(FPTwoMul(disDt, (DT)pos)));
+                    this->lrGreeks(price, pos, z1Buff[j], sumZ, sumZZ, steps, greeksStrmOut);
+                }
+            }
+        }
+    }
+};
+
+/**
+ * @brief Cash-or-nothing digital option monitored at each step, LR estimators for all Greeks.
+ *
+ * The option pays cashPayoff once the price reaches the strike at a step, at the time of that step if exEarly,
+ * else at expiry. Unlike PathPricer<Digital>, there is no Brownian bridge correction between steps, so that the
+ * payoff only depends on the path and the LR estimators apply.
+ */
+template <typename DT, int SampNum>
+class GreeksPathPricer<Digital, DT, SampNum> : public GreeksPathPricerBase<DT> {
+   public:
+    typedef GreeksPathPricerBase<DT> Base;
+
+    DT strike;
+    DT cashPayoff;
+    DT disDt;
+    bool optionType;
+    bool exEarly;
+
+    GreeksPathPricer() {}
+
+    void Pricing(ap_uint<16> steps,
+                 ap_uint<16> paths,
+                 hls::stream<DT> pathStrmIn[1],
+                 hls::stream<DT> greeksStrmOut[Base::GreeksN]) {
+#pragma HLS inline off
+        DT logSBuff[SampNum];
+        DT z1Buff[SampNum];
+        DT sumZBuff[SampNum];
+        DT sumZZBuff[SampNum];
+        bool actBuff[SampNum];
+        ap_uint<16> actPosBuff[SampNum];
+        for (int i = 0; i < steps; ++i) {
+#pragma HLS loop_tripcount min = 8 max = 8
+            for (int j = 0; j < paths; ++j) {
+#pragma HLS loop_tripcount min = SampNum max = SampNum
+#pragma HLS pipeline II = 1
+                DT dLogS = pathStrmIn[0].read();
+                DT z = this->normal(dLogS);
+                DT preLogS, preSumZ, preSumZZ;
+                bool oldAct;
+                ap_uint<16> oldPos;
+                if (i == 0) {
+                    preLogS = 0;
+                    preSumZ = 0;
+                    preSumZZ = 0;
+                    oldAct = false;
+                    oldPos = 0;
+                    z1Buff[j] = z;
+                } else {
+                    preLogS = logSBuff[j];
+                    preSumZ = sumZBuff[j];
+                    preSumZZ = sumZZBuff[j];
+                    oldAct = actBuff[j];
+                    oldPos = actPosBuff[j];
+                }
+                DT logS = FPTwoAdd(preLogS, dLogS);
+                DT sumZ = FPTwoAdd(preSumZ, z);
+                DT sumZZ = FPTwoAdd(preSumZZ, FPTwoMul(z, z));
+                logSBuff[j] = logS;
+                sumZBuff[j] = sumZ;
+                sumZZBuff[j] = sumZZ;
+
+                DT s = FPTwoMul(this->underlying, FPExp(logS));
+                bool isEx = (optionType && s <= strike) || (!optionType && s >= strike);
+                bool curAct = oldAct || isEx;
+                ap_uint<16> newPos = (isEx && !oldAct) ? (ap_uint<16>)i : oldPos;
+                actBuff[j] = curAct;
+                actPosBuff[j] = newPos;
+
+                if (i == steps - 1) {
+                    DT price = 0;
+                    ap_uint<16> pos = steps;
+                    if (curAct) {
+                        if (exEarly) {
+                            pos = newPos + 1;
+                        }
+                        price = FPTwoMul(cashPayoff, FPExp(FPTwoMul(disDt, (DT)pos)));
+                    }
+                    this->lrGreeks(price, pos, z1Buff[j], sumZ, sumZZ, steps, greeksStrmOut);
+                }
+            }
+        }
+    }
+};
+
+/**
+ * @brief Payoffs of a fine path and of its coarse path, for the levels of multilevel Monte Carlo
+ *
+ * The path pricers read the increments of log price of the fine path from BSPathGenerator, samples first. The coarse
+ * path has half the time steps and is driven by the same Brownian increments, so it is the fine path seen at every
+ * other step, and it has the law of the fine path of the previous level. Each path gives the difference of the fine
+ * and coarse payoffs, or the fine payoff alone on level 0, then the fine payoff.
+ */
+template <typename DT>
+class MultiLevelPathPricerBase {
+   public:
+    const static unsigned int InN = 1;
+    // number of values per path, read by the accumulator of the Greeks framework
+    const static unsigned int GreeksN = 2;
+    const static bool byPassGen = false;
+
+    DT underlying;
+    DT strike;
+    // -riskFreeRate * dt of the fine path
+    DT disDt;
+    bool optionType;
+    // false on level 0, which has no coarse path
+    bool coupled;
+
+    MultiLevelPathPricerBase() {}
+
+    DT vanilla(DT s) {
+#pragma HLS inline
+        DT op1, op2;
+        if (optionType) {
+            op1 = strike;
+            op2 = s;
+        } else {
+            op1 = s;
+            op2 = strike;
+        }
+        return MAX(FPTwoSub(op1, op2), 0);
+    }
+
+    void write(DT fine, DT coarse, hls::stream<DT> levelStrmOut[GreeksN]) {
+#pragma HLS inline
+        levelStrmOut[0].write(coupled ? FPTwoSub(fine, coarse) : fine);
+        levelStrmOut[1].write(fine);
+    }
+};
+
+/**
+ * @brief Path pricer of the fine and coarse payoffs, for the payoff of option style and Black-Scholes model
+ *
+ * @tparam style option style
+ * @tparam DT supported data type including double and float
+ * @tparam SampNum number of paths in each call
+ */
+template <OptionStyle style, typename DT, int SampNum>
+class MultiLevelPathPricer : public MultiLevelPathPricerBase<DT> {};
+
+/**
+ * @brief Arithmetic average price Asian option, the average of S_0 and of the prices of all the steps.
+ *
+ * The coarse average only takes the prices of every other step, and the continuously sampled average is the limit
+ * of the levels.
+ */
+template <typename DT, int SampNum>
+class MultiLevelPathPricer<Asian_AP, DT, SampNum> : public MultiLevelPathPricerBase<DT> {
+   public:
+    MultiLevelPathPricer() {}
+
+    void Pricing(ap_uint<16> steps,
+                 ap_uint<16> paths,
+                 hls::stream<DT> pathStrmIn[1],
+                 hls::stream<DT> levelStrmOut[MultiLevelPathPricerBase<DT>::GreeksN]) {
+#pragma HLS inline off
+        DT logSBuff[SampNum];
+        DT fineSumBuff[SampNum];
+        DT coarseSumBuff[SampNum];
+        DT discount = FPExp(FPTwoMul(this->disDt, (DT)steps));
+        DT fineInvN = (DT)1.0 / (DT)(steps + 1);
+        DT coarseInvN = (DT)1.0 / (DT)(steps / 2 + 1);
+        for (int i = 0; i < steps; ++i) {
+#pragma HLS loop_tripcount min = 8 max = 8
+            for (int j = 0; j < paths; ++j) {
+#pragma HLS loop_tripcount min = SampNum max = SampNum
+#pragma HLS pipeline II = 1
+                DT dLogS = pathStrmIn[0].read();
+                DT preLogS, preFineSum, preCoarseSum;
+                if (i == 0) {
+                    preLogS = 0;
+                    preFineSum = 1;
+                    preCoarseSum = 1;
+                } else {
+                    preLogS = logSBuff[j];
+                    preFineSum = fineSumBuff[j];
+                    preCoarseSum = coarseSumBuff[j];
+                }
+                DT logS = FPTwoAdd(preLogS, dLogS);
+                DT e = FPExp(logS);
+                DT fineSum = FPTwoAdd(preFineSum, e);
+                DT coarseSum = (i & 1) ? FPTwoAdd(preCoarseSum, e) : preCoarseSum;
+                logSBuff[j] = logS;
+                fineSumBuff[j] = fineSum;
+                coarseSumBuff[j] = coarseSum;
+                if (i == steps - 1) {
+                    DT fine = this->vanilla(FPTwoMul(FPTwoMul(fineSum, fineInvN), this->underlying));
+                    DT coarse = this->vanilla(FPTwoMul(FPTwoMul(coarseSum, coarseInvN), this->underlying));
+                    this->write(FPTwoMul(discount, fine), FPTwoMul(discount, coarse), levelStrmOut);
+                }
+            }
+        }
+    }
+};
+
+/**
+ * @brief Barrier option, monitored at each step of the fine path and at every other step of the coarse path.
+ *
+ * The continuously monitored barrier is the limit of the levels. The rebate of the knock-out options is paid at the
+ * step that hits the barrier, the same time on both paths when they hit it together.
+ */
+template <typename DT, int SampNum>
+class MultiLevelPathPricer<BarrierBiased, DT, SampNum> : public MultiLevelPathPricerBase<DT> {
+   public:
+    DT barrier;
+    DT rebate;
+    ap_uint<2> barrierType;
+
+    MultiLevelPathPricer() {}
+
+    DT payoff(bool act, ap_uint<16> actPos, DT s, ap_uint<16> steps) {
+#pragma HLS inline
+        DT p;
+        ap_uint<16> pos;
+        if ((act && (barrierType == DownIn || barrierType == UpIn)) ||
+            (!act && (barrierType == DownOut || barrierType == UpOut))) {
+            p = this->vanilla(s);
+            pos = steps;
+        } else {
+            p = rebate;
+            pos = (barrierType == UpIn || barrierType == DownIn) ? steps : actPos;
+        }
+        return FPTwoMul(p, FPExp(FPTwoMul(this->disDt, (DT)pos)));
+    }
+
+    void Pricing(ap_uint<16> steps,
+                 ap_uint<16> paths,
+                 hls::stream<DT> pathStrmIn[1],
+                 hls::stream<DT> levelStrmOut[MultiLevelPathPricerBase<DT>::GreeksN]) {
+#pragma HLS inline off
+        DT logSBuff[SampNum];
+        bool fineActBuff[SampNum];
+        bool coarseActBuff[SampNum];
+        ap_uint<16> finePosBuff[SampNum];
+        ap_uint<16> coarsePosBuff[SampNum];
+        for (int i = 0; i < steps; ++i) {
+#pragma HLS loop_tripcount min = 8 max = 8
+            for (int j = 0; j < paths; ++j) {
+#pragma HLS loop_tripcount min = SampNum max = SampNum
+#pragma HLS pipeline II = 1
+                DT dLogS = pathStrmIn[0].read();
+                DT preLogS;
+                bool fineOldAct, coarseOldAct;
+                ap_uint<16> fineOldPos, coarseOldPos;
+                if (i == 0) {
+                    preLogS = 0;
+                    fineOldAct = false;
+                    coarseOldAct = false;
+                    fineOldPos = 0;
+                    coarseOldPos = 0;
+                } else {
+                    preLogS = logSBuff[j];
+                    fineOldAct = fineActBuff[j];
+                    coarseOldAct = coarseActBuff[j];
+                    fineOldPos = finePosBuff[j];
+                    coarseOldPos = coarsePosBuff[j];
+                }
+                DT logS = FPTwoAdd(preLogS, dLogS);
+                logSBuff[j] = logS;
+
+                DT s = FPTwoMul(this->underlying, FPExp(logS));
+                bool isEx = ((barrierType == DownIn || barrierType == DownOut) && s <= barrier) ||
+                            ((barrierType == UpIn || barrierType == UpOut) && s >= barrier);
+                // the time of the step, in fine steps
+                ap_uint<16> t = i + 1;
+                bool fineAct = fineOldAct || isEx;
+                bool coarseAct = coarseOldAct || (isEx && (i & 1));
+                ap_uint<16> finePos = (isEx && !fineOldAct) ? t : fineOldPos;
+                ap_uint<16> coarsePos = (isEx && (i & 1) && !coarseOldAct) ? t : coarseOldPos;
+                fineActBuff[j] = fineAct;
+                coarseActBuff[j] = coarseAct;
+                finePosBuff[j] = finePos;
+                coarsePosBuff[j] = coarsePos;
+
+                if (i == steps - 1) {
+                    this->write(payoff(fineAct, finePos, s, steps), payoff(coarseAct, coarsePos, s, steps),
+                                levelStrmOut);
+                }
+            }
+        }
+    }
+};
+
 } // namespace internal
 } // namespace fintech
 } // namespace xf
@@ -26,6 +26,7 @@
 #include "ap_int.h"
 #include "hls_math.h"
 #include "utils.hpp"
+#include "xf_fintech/sobol_rsg.hpp"
 namespace xf {
 namespace fintech {
 namespace internal {
@@ -1556,6 +1557,567 @@ class MT2203IcnRng<float> {
     }
 };
 
+/**
+ * @brief Philox4x32-10 counter-based generator to generate uniform random number.
+ *
+ * Every block of 4 outputs is a pure function of a 128-bit counter and a 64-bit key, so the state is a
+ * few registers instead of a state vector in BRAM, instances with different keys are independent
+ * without any parameter set, and jumping to any position takes a single block computation.
+ * The counter holds a 64-bit path index and the position within the path, so the numbers of a path
+ * only depend on the seed and the path index, whichever unroll unit or CU simulates it.
+ *
+ * Reference: Parallel Random Numbers: As Easy as 1, 2, 3, by John K. Salmon et al.
+ */
+class Philox4x32 {
+   private:
+    /// Bit width of output
+    static const int W = 32;
+    /// Number of rounds
+    static const int ROUNDS = 10;
+    /// Multiplier of counter word 0
+    static const unsigned int M0 = 0xD2511F53;
+    /// Multiplier of counter word 2
+    static const unsigned int M1 = 0xCD9E8D57;
+    /// Increment of key word 0 in each round
+    static const unsigned int W0 = 0x9E3779B9;
+    /// Increment of key word 1 in each round
+    static const unsigned int W1 = 0xBB67AE85;
+
+    /// Key, seed and stream number
+    ap_uint<W> key[2];
+    /// Index of current path
+    ap_uint<64> path;
+    /// Position of next output in current path
+    ap_uint<64> pos;
+    /// Block of outputs holding position pos
+    ap_uint<W> buff[4];
+
+    void refill() {
+#pragma HLS inline
+        ap_uint<64> blockIdx = pos >> 2;
+        ap_uint<W> ctr[4];
+#pragma HLS array_partition variable = ctr dim = 0
+        ctr[0] = blockIdx(W - 1, 0);
+        ctr[1] = blockIdx(2 * W - 1, W);
+        ctr[2] = path(W - 1, 0);
+        ctr[3] = path(2 * W - 1, W);
+        generateBlock(ctr, key, buff);
+    }
+
+   public:
+    /**
+     * @brief compute one block of outputs
+     *
+     * @param ctr counter
+     * @param key key
+     * @param out 4 random 32-bit words
+     */
+    static void generateBlock(ap_uint<W> ctr[4], ap_uint<W> key[2], ap_uint<W> out[4]) {
+#pragma HLS inline
+        ap_uint<W> c0 = ctr[0], c1 = ctr[1], c2 = ctr[2], c3 = ctr[3];
+        ap_uint<W> k0 = key[0], k1 = key[1];
+    ROUND_LOOP:
+        for (int r = 0; r < ROUNDS; r++) {
+#pragma HLS unroll
+            ap_uint<2 * W> p0 = (ap_uint<2 * W>)c0 * (ap_uint<W>)M0;
+            ap_uint<2 * W> p1 = (ap_uint<2 * W>)c2 * (ap_uint<W>)M1;
+            c0 = p1(2 * W - 1, W) ^ c1 ^ k0;
+            c1 = p1(W - 1, 0);
+            c2 = p0(2 * W - 1, W) ^ c3 ^ k1;
+            c3 = p0(W - 1, 0);
+            k0 += W0;
+            k1 += W1;
+        }
+        out[0] = c0;
+        out[1] = c1;
+        out[2] = c2;
+        out[3] = c3;
+    }
+
+    Philox4x32() {
+#pragma HLS array_partition variable = buff dim = 0
+    }
+
+    /**
+     * @brief Constructor with seed
+     *
+     * @param seed initialization seed
+     */
+    Philox4x32(ap_uint<W> seed) {
+#pragma HLS array_partition variable = buff dim = 0
+        seedInitialization(seed);
+    }
+
+    /**
+     * @brief initialize with seed, on stream 0
+     *
+     * @param seed initialization seed
+     */
+    void seedInitialization(ap_uint<W> seed) { seedInitialization(seed, 0); }
+
+    /**
+     * @brief initialize with seed and stream number, and rewind to the start of path 0
+     *
+     * @param seed initialization seed
+     * @param stream stream number, generators with the same seed and different streams are independent
+     */
+    void seedInitialization(ap_uint<W> seed, ap_uint<W> stream) {
+        key[0] = seed;
+        key[1] = stream;
+        setPath(0);
+    }
+
+    /**
+     * @brief jump to the start of a path
+     *
+     * @param p path index
+     */
+    void setPath(ap_uint<64> p) {
+        path = p;
+        pos = 0;
+    }
+
+    /**
+     * @brief skip n outputs of current path
+     *
+     * @param n number of outputs to skip
+     */
+    void skip(ap_uint<64> n) {
+        pos += n;
+        if (pos(1, 0) != 0) {
+            refill();
+        }
+    }
+
+    /**
+     * @brief each call of next() generate a uniformly distributed random number
+     *
+     * @return a uniformly distributed random number
+     */
+    ap_ufixed<W, 0> next() {
+#pragma HLS inline
+        ap_ufixed<W, 0> result;
+        ap_uint<2> lane = pos(1, 0);
+        if (lane == 0) {
+            refill();
+        }
+        result(W - 1, 0) = buff[lane];
+        pos++;
+        return result;
+    }
+
+    /**
+     * @brief each call of nextTwo() generate two uniformly distributed random numbers
+     * @param result_l first random number
+     * @param result_r second random number
+     */
+    void nextTwo(ap_ufixed<W, 0>& result_l, ap_ufixed<W, 0>& result_r) {
+#pragma HLS inline
+        result_l = next();
+        result_r = next();
+    }
+};
+
+/**
+ * @brief Normally distributed random number generator based on Philox4x32-10 and
+ * InverseCumulative function
+ *
+ * @tparam mType data type supported including float and double
+ */
+template <typename mType>
+class PhiloxIcnRng {
+   public:
+    /**
+     * @brief Initialization using seed
+     *
+     * @param seed initialization seed
+     */
+    void seedInitialization(ap_uint<32> seed) {}
+
+    /**
+     * @brief Get next normally distributed random number
+     *
+     * @return a normally distributed random number
+     */
+    mType next() {}
+};
+
+/**
+ * @brief Normally distributed random number generator based on Philox4x32-10 and
+ * InverseCumulative function, output datatype is double.
+ */
+template <>
+class PhiloxIcnRng<double> {
+   private:
+    // uniform in (0, 1) with an odd number of 2^-33 steps, so that it is never 0 or 1
+    double openUniform(ap_ufixed<32, 0> u) {
+#pragma HLS inline
+        ap_ufixed<33, 0> tmp;
+        tmp(32, 1) = u(31, 0);
+        tmp[0] = 1;
+        return tmp;
+    }
+
+   public:
+    Philox4x32 uniformRNG;
+
+    PhiloxIcnRng(ap_uint<32> seed) : uniformRNG(seed) {}
+
+    PhiloxIcnRng() {}
+
+    /**
+     * @brief Initialization using seed
+     *
+     * @param seed initialization seed
+     */
+    void seedInitialization(ap_uint<32> seed) { uniformRNG.seedInitialization(seed); }
+
+    /**
+     * @brief Initialization using seed and stream number
+     *
+     * @param seed initialization seed
+     * @param stream stream number
+     */
+    void seedInitialization(ap_uint<32> seed, ap_uint<32> stream) { uniformRNG.seedInitialization(seed, stream); }
+
+    /**
+     * @brief jump to the start of a path
+     *
+     * @param p path index
+     */
+    void setPath(ap_uint<64> p) { uniformRNG.setPath(p); }
+
+    /**
+     * @brief skip n random numbers of current path
+     *
+     * @param n number of random numbers to skip
+     */
+    void skip(ap_uint<64> n) { uniformRNG.skip(n); }
+
+    /**
+     * @brief Get next normally distributed random number
+     *
+     * @return a normally distributed random number
+     */
+    double next() {
+#pragma HLS inline
+        return inverseCumulativeNormalAcklam<double>(openUniform(uniformRNG.next()));
+    }
+
+    /**
+     * @brief Get next normally distributed random number and its corresponding
+     * uniformly distributed random number
+     *
+     * @param uniformR return uniformly distributed random number that
+     * corrresponding to gaussianR
+     * @param gaussianR return normally distributed random number.
+     */
+    void next(double& uniformR, double& gaussianR) {
+#pragma HLS inline
+        double tmp_uniform = openUniform(uniformRNG.next());
+        uniformR = tmp_uniform;
+        gaussianR = inverseCumulativeNormalAcklam<double>(tmp_uniform);
+    }
+
+    /**
+     * @brief Get next uniformly distributed random number
+     *
+     * @param uniformR return uniformly distributed random number
+     */
+    void next(double& uniformR) {
+#pragma HLS inline
+        uniformR = uniformRNG.next();
+    }
+
+    /**
+     * @brief Get next two normally distributed random number
+     *
+     * @param gaussR return first normally distributed random number.
+     * @param gaussL return second normally distributed random number.
+     */
+    void nextTwo(double& gaussR, double& gaussL) {
+#pragma HLS inline
+        ap_ufixed<32, 0> unifR, unifL;
+        uniformRNG.nextTwo(unifR, unifL);
+        gaussR = inverseCumulativeNormalAcklam<double>(openUniform(unifR));
+        gaussL = inverseCumulativeNormalAcklam<double>(openUniform(unifL));
+    }
+};
+
+/**
+ * @brief Normally distributed random number generator based on Philox4x32-10 and
+ * InverseCumulative function, output datatype is float.
+ */
+template <>
+class PhiloxIcnRng<float> {
+   private:
+    // uniform in (0, 1) on the 24 bits of float mantissa plus half a step, so that it is never 0 or 1
+    float openUniform(ap_ufixed<32, 0> u) {
+#pragma HLS inline
+        ap_ufixed<25, 0> tmp;
+        tmp(24, 1) = u(31, 8);
+        tmp[0] = 1;
+        return tmp;
+    }
+
+   public:
+    Philox4x32 uniformRNG;
+
+    PhiloxIcnRng(ap_uint<32> seed) : uniformRNG(seed) {}
+
+    PhiloxIcnRng() {}
+
+    /**
+     * @brief Initialization using seed
+     *
+     * @param seed initialization seed
+     */
+    void seedInitialization(ap_uint<32> seed) { uniformRNG.seedInitialization(seed); }
+
+    /**
+     * @brief Initialization using seed and stream number
+     *
+     * @param seed initialization seed
+     * @param stream stream number
+     */
+    void seedInitialization(ap_uint<32> seed, ap_uint<32> stream) { uniformRNG.seedInitialization(seed, stream); }
+
+    /**
+     * @brief jump to the start of a path
+     *
+     * @param p path index
+     */
+    void setPath(ap_uint<64> p) { uniformRNG.setPath(p); }
+
+    /**
+     * @brief skip n random numbers of current path
+     *
+     * @param n number of random numbers to skip
+     */
+    void skip(ap_uint<64> n) { uniformRNG.skip(n); }
+
+    /**
+     * @brief Get next normally distributed random number
+     *
+     * @return a normally distributed random number
+     */
+    float next() {
+#pragma HLS inline
+        return inverseCumulativeNormalPPND7<float>(openUniform(uniformRNG.next()));
+    }
+
+    /**
+     * @brief Get next normally distributed random number and its corresponding
+     * uniformly distributed random number
+     *
+     * @param uniformR return uniformly distributed random number that
+     * corrresponding to gaussianR
+     * @param gaussianR return normally distributed random number.
+     */
+    void next(float& uniformR, float& gaussianR) {
+#pragma HLS inline
+        float tmp_uniform = openUniform(uniformRNG.next());
+        uniformR = tmp_uniform;
+        gaussianR = inverseCumulativeNormalPPND7<float>(tmp_uniform);
+    }
+
+    /**
+     * @brief Get next uniformly distributed random number
+     *
+     * @param uniformR return uniformly distributed random number
+     */
+    void next(float& uniformR) {
+#pragma HLS inline
+        uniformR = uniformRNG.next();
+    }
+
+    /**
+     * @brief Get next two normally distributed random number
+     *
+     * @param gaussR return first normally distributed random number.
+     * @param gaussL return second normally distributed random number.
+     */
+    void nextTwo(float& gaussR, float& gaussL) {
+#pragma HLS inline
+        ap_ufixed<32, 0> unifR, unifL;
+        uniformRNG.nextTwo(unifR, unifL);
+        gaussR = inverseCumulativeNormalPPND7<float>(openUniform(unifR));
+        gaussL = inverseCumulativeNormalPPND7<float>(openUniform(unifL));
+    }
+};
+
+namespace internal {
+// normally distributed number of a uniform number moved half a step into (0, 1), as in PhiloxIcnRng
+template <typename mType>
+mType icnOfOpenUniform(ap_ufixed<32, 0> u);
+
+template <>
+inline double icnOfOpenUniform<double>(ap_ufixed<32, 0> u) {
+#pragma HLS inline
+    ap_ufixed<33, 0> tmp;
+    tmp(32, 1) = u(31, 0);
+    tmp[0] = 1;
+    return inverseCumulativeNormalAcklam<double>(tmp);
+}
+
+template <>
+inline float icnOfOpenUniform<float>(ap_ufixed<32, 0> u) {
+#pragma HLS inline
+    ap_ufixed<25, 0> tmp;
+    tmp(24, 1) = u(31, 8);
+    tmp[0] = 1;
+    return inverseCumulativeNormalPPND7<float>(tmp);
+}
+} // namespace internal
+
+/**
+ * @brief Normally distributed quasi-random points, the points of ScrambledSobolRsg mapped by InverseCumulative
+ * function.
+ *
+ * nextPoint() moves to the next point, then each call of next() returns its next dimension. Each seed gives an
+ * independent randomization of the sequence.
+ *
+ * @tparam mType data type supported including float and double
+ * @tparam DIM dimension of the points, maximum is 128
+ */
+template <typename mType, int DIM>
+class SobolIcnRng {
+   private:
+    ap_ufixed<32, 0> point[DIM];
+    ap_uint<8> dim;
+
+   public:
+    ScrambledSobolRsg<DIM> uniformRNG;
+
+    SobolIcnRng() {}
+
+    /**
+     * @brief Initialization using seed
+     *
+     * @param seed initialization seed
+     */
+    void seedInitialization(ap_uint<32> seed) {
+        uniformRNG.seedInitialization(seed);
+        dim = 0;
+    }
+
+    /**
+     * @brief go to the point of index n, the next call of nextPoint() loads it
+     *
+     * @param n index of the point
+     */
+    void skipTo(ap_uint<32> n) { uniformRNG.skipTo(n); }
+
+    /**
+     * @brief load the next point, whose dimensions are returned by next()
+     */
+    void nextPoint() {
+        uniformRNG.next(point);
+        dim = 0;
+    }
+
+    /**
+     * @brief Get the next dimension of the current point
+     *
+     * @return a normally distributed quasi-random number
+     */
+    mType next() {
+#pragma HLS inline
+        mType r = internal::icnOfOpenUniform<mType>(point[dim]);
+        dim++;
+        return r;
+    }
+};
+
+/**
+ * @brief Normally distributed random number generator based on Philox4x32-10 and
+ * Box-Muller Transformation
+ *
+ * Both outputs of a transform are used, so a path consumes as many uniform numbers as normal numbers.
+ *
+ * @tparam mType data type supported including float and double
+ */
+template <typename mType>
+class PhiloxBoxMullerNormalRng {
+   private:
+    mType z2;
+    ap_uint<1> is_odd;
+
+   public:
+    Philox4x32 uniformRNG;
+
+    PhiloxBoxMullerNormalRng(ap_uint<32> seed) : uniformRNG(seed) { is_odd = 0; }
+
+    PhiloxBoxMullerNormalRng() { is_odd = 0; }
+
+    /**
+     * @brief Initialization using seed
+     *
+     * @param seed initialization seed
+     */
+    void seedInitialization(ap_uint<32> seed) {
+        uniformRNG.seedInitialization(seed);
+        is_odd = 0;
+    }
+
+    /**
+     * @brief Initialization using seed and stream number
+     *
+     * @param seed initialization seed
+     * @param stream stream number
+     */
+    void seedInitialization(ap_uint<32> seed, ap_uint<32> stream) {
+        uniformRNG.seedInitialization(seed, stream);
+        is_odd = 0;
+    }
+
+    /**
+     * @brief jump to the start of a path
+     *
+     * @param p path index
+     */
+    void setPath(ap_uint<64> p) {
+        uniformRNG.setPath(p);
+        is_odd = 0;
+    }
+
+    /**
+     * @brief Get next two normally distributed random number
+     *
+     * @param gaussR return first normally distributed random number.
+     * @param gaussL return second normally distributed random number.
+     */
+    void nextTwo(mType& gaussR, mType& gaussL) {
+#pragma HLS inline
+        ap_ufixed<33, 0> u1, u2;
+        ap_ufixed<32, 0> unifR, unifL;
+        uniformRNG.nextTwo(unifR, unifL);
+        u1(32, 1) = unifR(31, 0);
+        u1[0] = 1;
+        u2(32, 1) = unifL(31, 0);
+        u2[0] = 1;
+        boxMullerTransform<mType>(u1, u2, gaussR, gaussL);
+    }
+
+    /**
+     * @brief Get next normally distributed random number
+     * @return a normally distributed random number
+     */
+    mType next() {
+#pragma HLS inline
+        mType z1, result;
+        if (is_odd) {
+            is_odd = 0;
+            result = z2;
+        } else {
+            is_odd = 1;
+            nextTwo(z1, z2);
+            result = z1;
+        }
+        return result;
+    }
+};
+
 /**
  * @brief Multi-variate normal distribution RNG.
  *
@@ -22,6 +22,7 @@
 #define XF_FINTECH_RNG_SEQ_H
 #include "ap_int.h"
 #include "hls_stream.h"
+#include "xf_fintech/brownian_bridge.hpp"
 #include "xf_fintech/corrand.hpp"
 #ifndef __SYNTHESIS__
 #include <assert.h>
@@ -60,6 +61,144 @@ class RNGSequence {
     }
 };
 
+/**
+ * @brief Random sequence whose numbers only depend on the seed and the index of the path.
+ *
+ * All the sequences of an engine, over all its unroll units and CUs, share the same seed. Unit unitId of
+ * unitNum simulates paths (round * unitNum + unitId) * paths to (round * unitNum + unitId + 1) * paths - 1 in
+ * each round, and jumps the RNG to the start of each path, so a path gets the same random numbers whichever
+ * unit or CU simulates it. Which paths are simulated, and the order their results are summed in, still depend
+ * on unitNum. RNG needs setPath(), like PhiloxIcnRng.
+ */
+template <typename DT, typename RNG>
+class PathIndexedRNGSequence {
+   public:
+    const static unsigned int OutN = 1;
+    ap_uint<32> seed[1];
+    /// index of this sequence among all the sequences sharing seed
+    ap_uint<32> unitId;
+    /// number of sequences sharing seed
+    ap_uint<32> unitNum;
+    /// number of calls to NextSeq since Init
+    ap_uint<32> round;
+    // Constructor
+    PathIndexedRNGSequence() : unitId(0), unitNum(1), round(0){};
+
+    void Init(RNG rngInst[1]) {
+        rngInst[0].seedInitialization(seed[0]);
+        round = 0;
+    }
+
+    void NextSeq(ap_uint<16> steps, ap_uint<16> paths, RNG rngInst[1], hls::stream<DT> randNumberStrmOut[1]) {
+#pragma HLS inline off
+        ap_uint<64> firstPath = ((ap_uint<64>)round * unitNum + unitId) * paths;
+    RNG_LOOP:
+        for (int i = 0; i < paths; ++i) {
+#pragma HLS loop_tripcount min = 1024 max = 1024
+            for (int j = 0; j < steps; ++j) {
+#pragma HLS pipeline II = 1
+#pragma HLS loop_tripcount min = 8 max = 8
+                if (j == 0) {
+                    rngInst[0].setPath(firstPath + i);
+                }
+                DT d = rngInst[0].next();
+                randNumberStrmOut[0].write(d);
+            }
+        }
+        round++;
+    }
+};
+
+/**
+ * @brief Quasi-random sequence of one scrambled sobol point per path, whose dimensions are assigned to the time steps
+ * by a Brownian bridge.
+ *
+ * The first dimensions, which are the most uniformly distributed, build the end of the path and then the midpoints,
+ * which decide most of its shape, so that the payoff mostly depends on a few dimensions. The normal increments of the
+ * steps are written path by path if StepFirst, and step by step otherwise, in the order the path generators read
+ * them, which buffers paths * steps numbers. Sequences sharing a seed take disjoint blocks of the same points, as in
+ * PathIndexedRNGSequence, so the points used over all the units are the first ones of the sequence. RNG needs
+ * nextPoint() and skipTo(), like SobolIcnRng, with a dimension of at least MaxSteps.
+ */
+template <typename DT, typename RNG, int SampNum, int MaxSteps, bool StepFirst>
+class SobolBridgeSequence {
+   public:
+    const static unsigned int OutN = 1;
+    ap_uint<32> seed[1];
+    /// index of this sequence among all the sequences sharing seed
+    ap_uint<32> unitId;
+    /// number of sequences sharing seed
+    ap_uint<32> unitNum;
+    /// number of calls to NextSeq since Init
+    ap_uint<32> round;
+    /// number of steps of the bridge
+    ap_uint<16> bridgeSteps;
+    BrownianBridge<DT, MaxSteps> bridge;
+    // Constructor
+    SobolBridgeSequence() : unitId(0), unitNum(1), round(0), bridgeSteps(0){};
+
+    void Init(RNG rngInst[1]) {
+        rngInst[0].seedInitialization(seed[0]);
+        round = 0;
+    }
+
+    void NextPath(ap_uint<16> steps, RNG rngInst[1], hls::stream<DT>& pathStrmOut) {
+        hls::stream<DT> normStrm;
+#pragma HLS stream variable = normStrm depth = MaxSteps
+        rngInst[0].nextPoint();
+        for (int j = 0; j < steps; ++j) {
+#pragma HLS pipeline II = 1
+#pragma HLS loop_tripcount min = 8 max = 8
+            normStrm.write(rngInst[0].next());
+        }
+        bridge.transform(normStrm, pathStrmOut);
+    }
+
+    void NextSeq(ap_uint<16> steps, ap_uint<16> paths, RNG rngInst[1], hls::stream<DT> randNumberStrmOut[1]) {
+#pragma HLS inline off
+#ifndef __SYNTHESIS__
+        assert(steps <= MaxSteps);
+        assert(paths <= SampNum);
+#endif
+        if (steps != bridgeSteps) {
+            bridge.initialize(steps);
+            bridgeSteps = steps;
+        }
+        rngInst[0].skipTo(((ap_uint<64>)round * unitNum + unitId) * paths);
+        if (StepFirst) {
+        RNG_LOOP:
+            for (int i = 0; i < paths; ++i) {
+#pragma HLS loop_tripcount min = 1024 max = 1024
+                NextPath(steps, rngInst, randNumberStrmOut[0]);
+            }
+        } else {
+            DT buff[MaxSteps][SampNum];
+            hls::stream<DT> pathStrm;
+#pragma HLS stream variable = pathStrm depth = MaxSteps
+        PATH_LOOP:
+            for (int i = 0; i < paths; ++i) {
+#pragma HLS loop_tripcount min = 1024 max = 1024
+                NextPath(steps, rngInst, pathStrm);
+                for (int j = 0; j < steps; ++j) {
+#pragma HLS pipeline II = 1
+#pragma HLS loop_tripcount min = 8 max = 8
+                    buff[j][i] = pathStrm.read();
+                }
+            }
+        STEP_LOOP:
+            for (int j = 0; j < steps; ++j) {
+#pragma HLS loop_tripcount min = 8 max = 8
+                for (int i = 0; i < paths; ++i) {
+#pragma HLS pipeline II = 1
+#pragma HLS loop_tripcount min = 1024 max = 1024
+                    randNumberStrmOut[0].write(buff[j][i]);
+                }
+            }
+        }
+        round++;
+    }
+};
+
 template <typename DT, typename RNG>
 class RNGSequence_2 {
    public:
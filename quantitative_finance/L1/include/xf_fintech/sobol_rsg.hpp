@@ -17,7 +17,7 @@
 /**
  * @file sobol_rsg.hpp
  * @brief This file include first dimension sequence generator
- * and 128-dimension sobol sequence generator
+ * and 128-dimension sobol sequence generator, plain and scrambled
  *
  */
 
@@ -167,6 +167,40 @@ const ap_uint<63> initPara[128] = {0x0,
                                    0x4A7592F3AB866FD0,
                                    0x49B439B3B895FFE3,
                                    0x59B053DFF495DFF2};
+
+// degree of the primitive polynomial of dimension i of initPara
+inline ap_uint<4> sobolDegree(ap_uint<8> i) {
+#pragma HLS inline
+    if (i == 1)
+        return 1;
+    else if (i == 2)
+        return 2;
+    else if (i <= 4)
+        return 3;
+    else if (i <= 6)
+        return 4;
+    else if (i <= 12)
+        return 5;
+    else if (i <= 18)
+        return 6;
+    else if (i <= 36)
+        return 7;
+    else if (i <= 52)
+        return 8;
+    else if (i <= 100)
+        return 9;
+    else
+        return 10;
+}
+
+// splitmix64 finalizer, spreads a seed and a counter over the bits of the scrambling matrices
+inline ap_uint<64> sobolScrambleHash(ap_uint<64> x) {
+#pragma HLS inline
+    ap_uint<64> z = x + ap_uint<64>(0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * ap_uint<64>(0xBF58476D1CE4E5B9ULL);
+    z = (z ^ (z >> 27)) * ap_uint<64>(0x94D049BB133111EBULL);
+    return z ^ (z >> 31);
+}
 } // internal
 
 /**
@@ -219,26 +253,7 @@ class SobolRsg {
         for (i = 1; i < DIM; i++) {
 #pragma HLS unroll
             ap_uint<63> init_para = xf::fintech::internal::initPara[i];
-            if (i == 1)
-                s[i] = 1;
-            else if (i == 2)
-                s[i] = 2;
-            else if (i <= 4)
-                s[i] = 3;
-            else if (i <= 6)
-                s[i] = 4;
-            else if (i <= 12)
-                s[i] = 5;
-            else if (i <= 18)
-                s[i] = 6;
-            else if (i <= 36)
-                s[i] = 7;
-            else if (i <= 52)
-                s[i] = 8;
-            else if (i <= 100)
-                s[i] = 9;
-            else
-                s[i] = 10;
+            s[i] = internal::sobolDegree(i);
             a[i] = init_para(7, 0); // 8bit
             begin = 8;
             for (j = 0; j < 10; j++) {
@@ -312,6 +327,146 @@ class SobolRsg {
     }
 };
 
+/**
+ * @brief ScrambledSobolRsg is a multi-dimensional sobol sequence generator with random linear scrambling and digital
+ * shift.
+ *
+ * Each dimension is multiplied by a random lower triangular binary matrix with unit diagonal and added to a random
+ * binary vector, both drawn from the seed. Every seed gives an independent randomization of the sequence which keeps
+ * its low discrepancy, so the spread of the estimates of several seeds measures the error of the quasi-Monte Carlo
+ * estimate. The generator can jump to any point, so that several generators sharing a seed take disjoint blocks of
+ * the same sequence.
+ *
+ * @tparam DIM sobol sequence dimension, maximum is 128
+ */
+template <int DIM>
+class ScrambledSobolRsg {
+   private:
+    // Bit width of element in state vector
+    const static int W = 32;
+    // addr is the index of the next point
+    ap_uint<W> addr;
+    // scrambled direction numbers
+    ap_uint<W> v[DIM][W];
+    // digital shift
+    ap_uint<W> shift[DIM];
+    // next point
+    ap_uint<W> last_seqOut[DIM];
+
+   public:
+    ScrambledSobolRsg() {
+#pragma HLS ARRAY_PARTITION variable = v dim = 1
+#pragma HLS ARRAY_PARTITION variable = shift dim = 0
+#pragma HLS ARRAY_PARTITION variable = last_seqOut dim = 0
+    }
+
+    /**
+     * @brief compute the direction numbers and scramble them with the seed, then go to the first point
+     *
+     * @param seed seed of the randomization
+     */
+    void seedInitialization(ap_uint<32> seed) {
+#pragma HLS RESOURCE variable = xf::fintech::internal::initPara core = ROM_2P_BRAM
+    DIM_LOOP:
+        for (int id = 0; id < DIM; id++) {
+            ap_uint<W> dir[W];
+#pragma HLS ARRAY_PARTITION variable = dir dim = 0
+            if (id == 0) {
+                for (int c = 0; c < W; c++) {
+#pragma HLS unroll
+                    dir[c] = ap_uint<W>(1) << (W - c - 1);
+                }
+            } else {
+                // initial direction numbers from initPara, then the recurrence of the primitive polynomial
+                ap_uint<63> init_para = xf::fintech::internal::initPara[id];
+                ap_uint<4> s = internal::sobolDegree(id);
+                ap_uint<8> a = init_para(7, 0);
+                ap_uint<7> begin = 8;
+                for (int c = 0; c < W; c++) {
+#pragma HLS pipeline
+                    if (c < s) {
+                        dir[c] = ap_uint<W>(init_para(begin + c, begin)) << (W - c - 1);
+                        begin += 1 + c;
+                    } else {
+                        ap_uint<W> v_now = dir[c - s] ^ (dir[c - s] >> s);
+                        for (int k = 1; k < 10; k++) {
+#pragma HLS unroll
+                            if (k < s && ((a >> (s - 1 - k)) & 1)) v_now ^= dir[c - k];
+                        }
+                        dir[c] = v_now;
+                    }
+                }
+            }
+            // bit k from the top of the output is bit k of the input plus a random combination of the bits above
+            ap_uint<W> col[W];
+#pragma HLS ARRAY_PARTITION variable = col dim = 0
+            for (int k = 0; k < W; k++) {
+#pragma HLS pipeline
+                ap_uint<W> r = internal::sobolScrambleHash(((ap_uint<64>)seed << 32) | (id * (W + 1) + k))(W - 1, 0);
+                ap_uint<W> diag = ap_uint<W>(1) << (W - k - 1);
+                col[k] = diag | (r & (diag - 1));
+            }
+            shift[id] = internal::sobolScrambleHash(((ap_uint<64>)seed << 32) | (id * (W + 1) + W))(W - 1, 0);
+            for (int c = 0; c < W; c++) {
+#pragma HLS pipeline
+                ap_uint<W> scr = 0;
+                for (int k = 0; k < W; k++) {
+#pragma HLS unroll
+                    if (dir[c][W - k - 1]) scr ^= col[k];
+                }
+                v[id][c] = scr;
+            }
+        }
+        skipTo(0);
+    }
+
+    /**
+     * @brief go to the point of index n, the next call of next() returns it
+     *
+     * @param n index of the point
+     */
+    void skipTo(ap_uint<W> n) {
+        // the point of index n is the sum of the direction numbers at the bits of the Gray code of n
+        ap_uint<W> gray = n ^ (n >> 1);
+        for (int id = 0; id < DIM; id++) {
+#pragma HLS unroll
+            last_seqOut[id] = shift[id];
+        }
+    SKIP_LOOP:
+        for (int c = 0; c < W; c++) {
+#pragma HLS pipeline
+            for (int id = 0; id < DIM; id++) {
+#pragma HLS unroll
+                if (gray[c]) last_seqOut[id] ^= v[id][c];
+            }
+        }
+        addr = n;
+    }
+
+    /**
+     * @brief each call of next() generates scrambled sobol sequence numbers in DIM dimensions, one number per
+     * dimension
+     *
+     * @param seqOut sobol results in DIM dimensions
+     */
+    void next(ap_ufixed<W, 0> seqOut[DIM]) {
+#pragma HLS PIPELINE
+#pragma HLS ARRAY_PARTITION variable = seqOut dim = 0
+        // Gray code order, the next point differs from this one by the direction number at the lowest zero bit
+        ap_uint<6> c;
+        for (c = 0; c < W - 1; ++c) {
+#pragma HLS unroll
+            if (!addr[c]) break;
+        }
+        for (int id = 0; id < DIM; id++) {
+#pragma HLS unroll
+            seqOut[id](W - 1, 0) = last_seqOut[id](W - 1, 0);
+            last_seqOut[id] ^= v[id][c];
+        }
+        addr++;
+    }
+};
+
 /**
  *
  * @brief One dimensional sobol sequence generator.
@@ -0,0 +1,48 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file dut.cpp
+ *
+ * @brief This file contains top function of test case.
+ */
+
+#include <ap_int.h>
+#include "xf_fintech/rng.hpp"
+
+/**
+ * @brief test function for Philox4x32-10 rng, output[0, num) is path st[1] from its start,
+ * output[num, 2 * num) is path st[2] after skipping st[3] numbers
+ *
+ */
+extern "C" void dut(const int num, ap_uint<32> st[4], ap_ufixed<32, 0> output[200]) {
+    xf::fintech::Philox4x32 rngInst;
+
+    rngInst.seedInitialization(st[0]);
+
+    rngInst.setPath(st[1]);
+    for (int i = 0; i < num; i++) {
+#pragma HLS pipeline II = 1
+        output[i] = rngInst.next();
+    }
+
+    rngInst.setPath(st[2]);
+    rngInst.skip(st[3]);
+    for (int i = 0; i < num; i++) {
+#pragma HLS pipeline II = 1
+        output[num + i] = rngInst.next();
+    }
+}
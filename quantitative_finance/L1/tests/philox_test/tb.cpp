@@ -0,0 +1,98 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <ap_int.h>
+#include <stdint.h>
+#include <iostream>
+#include "xf_fintech/rng.hpp"
+
+extern "C" void dut(const int num, ap_uint<32> st[4], ap_ufixed<32, 0> output[200]);
+
+// reference Philox4x32-10 on plain integers
+static void philoxRef(uint32_t ctr[4], const uint32_t key[2], uint32_t out[4]) {
+    uint32_t c0 = ctr[0], c1 = ctr[1], c2 = ctr[2], c3 = ctr[3];
+    uint32_t k0 = key[0], k1 = key[1];
+    for (int r = 0; r < 10; r++) {
+        uint64_t p0 = (uint64_t)0xD2511F53 * c0;
+        uint64_t p1 = (uint64_t)0xCD9E8D57 * c2;
+        c0 = (uint32_t)(p1 >> 32) ^ c1 ^ k0;
+        c1 = (uint32_t)p1;
+        c2 = (uint32_t)(p0 >> 32) ^ c3 ^ k1;
+        c3 = (uint32_t)p0;
+        k0 += 0x9E3779B9;
+        k1 += 0xBB67AE85;
+    }
+    out[0] = c0;
+    out[1] = c1;
+    out[2] = c2;
+    out[3] = c3;
+}
+
+// n-th number of a path
+static uint32_t pathRef(uint32_t seed, uint32_t path, uint32_t n) {
+    uint32_t ctr[4] = {n >> 2, 0, path, 0};
+    uint32_t key[2] = {seed, 0};
+    uint32_t out[4];
+    philoxRef(ctr, key, out);
+    return out[n & 3];
+}
+
+int main() {
+    int num = 100;
+
+    // known answers from the Random123 distribution
+    const uint32_t katCtr[3][4] = {{0x00000000, 0x00000000, 0x00000000, 0x00000000},
+                                   {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff},
+                                   {0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}};
+    const uint32_t katKey[3][2] = {{0x00000000, 0x00000000}, {0xffffffff, 0xffffffff}, {0xa4093822, 0x299f31d0}};
+    const uint32_t katOut[3][4] = {{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8},
+                                   {0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd},
+                                   {0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}};
+    for (int t = 0; t < 3; ++t) {
+        ap_uint<32> ctr[4], key[2], out[4];
+        for (int i = 0; i < 4; ++i) ctr[i] = katCtr[t][i];
+        for (int i = 0; i < 2; ++i) key[i] = katKey[t][i];
+        xf::fintech::Philox4x32::generateBlock(ctr, key, out);
+        for (int i = 0; i < 4; ++i) {
+            if (out[i] != katOut[t][i]) {
+                std::cout << "known answer " << t << " word " << i << " mismatch" << std::endl;
+                return -1;
+            }
+        }
+    }
+
+    ap_uint<32> st[4];
+    st[0] = 1234;
+    st[1] = 7;
+    st[2] = 1000003;
+    st[3] = 13;
+
+    ap_ufixed<32, 0> output[200];
+    dut(num, st, output);
+
+    for (int i = 0; i < num; ++i) {
+        ap_ufixed<32, 0> ref[2];
+        ref[0].range(31, 0) = pathRef(1234, 7, i);
+        ref[1].range(31, 0) = pathRef(1234, 1000003, 13 + i);
+        if (output[i] != ref[0] || output[num + i] != ref[1]) {
+            std::cout << "i:" << i << ", acut out :" << output[i] << ", " << output[num + i] << ", ref out :" << ref[0]
+                      << ", " << ref[1] << std::endl;
+            return -1;
+        }
+    }
+    std::cout << "output correct." << std::endl;
+    return 0;
+}
@@ -161,6 +161,101 @@ void cfBSMEngine(DT s,
     *gamma = gamma_temp;
     *vega = vega_temp;
 }
+
+/// @brief Single option implied volatility solver
+///
+/// Inverts the closed form Black Scholes Merton price. The premium is normalized to the undiscounted out of the money
+/// call on x = ln(F/K) <= 0, F the forward, divided by sqrt(F * K), so that only w = v * sqrt(t) is unknown; in the
+/// money options have their intrinsic value removed and puts are calls on -x. The initial guess is the Corrado-Miller
+/// rational approximation, refined by a fixed number of Halley steps so that the latency does not depend on the
+/// input. Each step narrows a bracket of the root, and a step that leaves the bracket is replaced by bisection.
+/// Premiums outside the no-arbitrage bounds have no implied volatility and return 0.
+///
+/// @tparam DT Data Type used for this function
+/// @tparam N  number of Halley steps
+/// @param[in]  s     underlying
+/// @param[in]  price call/put premium
+/// @param[in]  r     risk-free rate (decimal form)
+/// @param[in]  t     time to maturity
+/// @param[in]  k     strike price
+/// @param[in]  q     continuous dividend yield rate
+/// @param[in]  call  control whether price is a call or put premium
+/// @param[out] v     implied volatility (decimal form)
+template <typename DT, int N = 6>
+void cfBSMImpliedVolEngine(DT s, DT price, DT r, DT t, DT k, DT q, unsigned int call, DT* v) {
+    // Upper limit of the total standard deviation v * sqrt(t)
+    const DT w_max = 8.0f;
+
+    // Normalize to an out of the money call
+    DT sqrt_t = hls::sqrtf(t);
+    DT f = s * hls::expf((r - q) * t);
+    DT sqrt_fk = hls::sqrtf(f * k);
+    DT beta = price * hls::expf(r * t) / sqrt_fk;
+    DT x = hls::logf(f / k);
+    if (!call) {
+        x = -x; // put on x is a call on -x
+    }
+    DT exp_x2 = hls::expf(0.5f * x);
+    DT exp_x2n = 1.0f / exp_x2;
+    if (x > 0.0f) {
+        beta = beta - (exp_x2 - exp_x2n);
+        x = -x;
+        DT tmp = exp_x2;
+        exp_x2 = exp_x2n;
+        exp_x2n = tmp;
+    }
+
+    // Corrado-Miller guess in normalized units. Far from the money it has no real solution, start from the
+    // inflection point w = sqrt(2|x|) instead, from where Newton steps converge monotonically.
+    DT fk = exp_x2 - exp_x2n;
+    DT m = beta - 0.5f * fk;
+    DT disc = m * m - fk * fk / PI;
+    DT w = hls::sqrtf(-2.0f * x);
+    if (disc > 0.0f) {
+        w = SQRT_2PI / (exp_x2 + exp_x2n) * (m + hls::sqrtf(disc));
+    }
+    DT lo = 0.0f;
+    DT hi = w_max;
+    if (!(w > lo && w < hi)) {
+        w = 0.5f * (lo + hi);
+    }
+
+HALLEY_LOOP:
+    for (int i = 0; i < N; i++) {
+#pragma HLS PIPELINE
+        DT d1 = x / w + 0.5f * w;
+        DT d2 = d1 - w;
+        DT b = exp_x2 * internal::phi<DT>(d1) - exp_x2n * internal::phi<DT>(d2);
+        DT db = exp_x2 * SQRT_2PI_RECIP * hls::expf(-0.5f * d1 * d1);
+        DT err = b - beta;
+
+        // the normalized premium increases with w
+        if (err > 0.0f) {
+            hi = w;
+        } else {
+            lo = w;
+        }
+
+        // Halley step, b'' / b' = d1 * d2 / w
+        DT newton = err / db;
+        DT denom = 1.0f - 0.5f * newton * d1 * d2 / w;
+        DT step = newton;
+        if (denom > 0.5f) {
+            step = newton / denom;
+        }
+        DT w_next = w - step;
+        if (!(w_next >= lo && w_next <= hi && w_next > 0.0f)) {
+            w_next = 0.5f * (lo + hi);
+        }
+        w = w_next;
+    }
+
+    DT v_temp = w / sqrt_t;
+    if (beta <= 0.0f || beta >= exp_x2) {
+        v_temp = 0.0f;
+    }
+    *v = v_temp;
+}
 }
 } // xf::fintech
 
@@ -0,0 +1,624 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file exposure_engine.hpp
+ * @brief This file includes the Monte Carlo exposure engine, which revalues a portfolio of trades on shared risk
+ * factor scenarios and aggregates the expected exposure, PFE and CVA of each netting set.
+ */
+
+#ifndef _XF_FINTECH_EXPOSURE_ENGINE_H_
+#define _XF_FINTECH_EXPOSURE_ENGINE_H_
+
+#include "ap_int.h"
+#include "hls_math.h"
+#include "hls_stream.h"
+#include "xf_fintech/enums.hpp"
+#include "xf_fintech/hw_model.hpp"
+#include "xf_fintech/rng.hpp"
+#include "xf_fintech/utils.hpp"
+
+namespace xf {
+namespace fintech {
+
+/**
+ * @brief A trade of the portfolio revalued by MCExposureEngine.
+ *
+ * Swaps exchange a fixed rate against the floating rate, paid every period from start + period to maturity.
+ * Forwards deliver one unit of a risk factor against the strike at maturity, options are European options on a risk
+ * factor expiring at maturity.
+ *
+ * @tparam DT supported data type including double and float data type.
+ */
+template <typename DT>
+struct ExposureTrade {
+    /// swap, forward or option
+    TradeType type;
+    /// index of the netting set of the trade
+    unsigned int nettingSet;
+    /// index of the risk factor of forwards and options, unused by swaps
+    unsigned int factor;
+    /// notional, positive to receive the fixed leg of a swap or to be long a forward or option
+    DT notional;
+    /// fixed rate of swaps, strike of forwards and options
+    DT strike;
+    /// start of the first accrual period of swaps, unused otherwise
+    DT start;
+    /// last payment of swaps, delivery of forwards, expiry of options
+    DT maturity;
+    /// accrual period of swaps, unused otherwise
+    DT period;
+    /// Call or Put for options, unused otherwise
+    Type optionType;
+};
+
+namespace internal {
+
+/**
+ * @brief Streaming estimate of one quantile of a distribution, by the P-square algorithm of Jain and Chlamtac.
+ *
+ * Five markers are kept whatever the number of samples, instead of the samples themselves.
+ */
+template <typename DT>
+class ExposureQuantile {
+   public:
+    DT height[5];
+    DT desired[5];
+    int position[5];
+    unsigned int count;
+
+    void init() { count = 0; }
+
+    void add(DT x, DT p) {
+        if (count < 5) {
+            // keep the first samples sorted
+            int i = count;
+            while (i > 0 && height[i - 1] > x) {
+                height[i] = height[i - 1];
+                i--;
+            }
+            height[i] = x;
+            count++;
+            if (count == 5) {
+                for (int k = 0; k < 5; k++) {
+                    position[k] = k;
+                }
+                desired[0] = 0;
+                desired[1] = 2.0 * p;
+                desired[2] = 4.0 * p;
+                desired[3] = 2.0 + 2.0 * p;
+                desired[4] = 4.0;
+            }
+            return;
+        }
+
+        // cell of the new sample, extending the extreme markers if needed
+        int k;
+        if (x < height[0]) {
+            height[0] = x;
+            k = 0;
+        } else if (x >= height[4]) {
+            height[4] = x;
+            k = 3;
+        } else {
+            k = 0;
+            while (x >= height[k + 1]) {
+                k++;
+            }
+        }
+        for (int i = k + 1; i < 5; i++) {
+            position[i]++;
+        }
+        desired[1] += 0.5 * p;
+        desired[2] += p;
+        desired[3] += 0.5 * (1.0 + p);
+        desired[4] += 1.0;
+        count++;
+
+        // move the middle markers towards their desired positions
+        for (int i = 1; i < 4; i++) {
+            DT d = desired[i] - position[i];
+            if ((d >= 1.0 && position[i + 1] - position[i] > 1) || (d <= -1.0 && position[i - 1] - position[i] < -1)) {
+                int s = (d > 0) ? 1 : -1;
+                DT np = position[i + 1] - position[i - 1];
+                DT qp = height[i] +
+                        s / np * ((position[i] - position[i - 1] + s) * (height[i + 1] - height[i]) /
+                                      (position[i + 1] - position[i]) +
+                                  (position[i + 1] - position[i] - s) * (height[i] - height[i - 1]) /
+                                      (position[i] - position[i - 1]));
+                if (height[i - 1] < qp && qp < height[i + 1]) {
+                    height[i] = qp;
+                } else {
+                    // parabolic prediction out of order, linear one instead
+                    height[i] = height[i] + s * (height[i + s] - height[i]) / (position[i + s] - position[i]);
+                }
+                position[i] += s;
+            }
+        }
+    }
+
+    DT quantile(DT p) {
+        if (count >= 5) {
+            return height[2];
+        } else if (count == 0) {
+            return 0;
+        } else {
+            // too few samples for the markers, nearest rank
+            return height[(int)(p * (count - 1) + 0.5)];
+        }
+    }
+};
+
+// entry (i, j) of the lower triangular factor, padded with independent variates
+template <typename DT, int NF>
+DT exposureCorrEntry(DT corrLower[NF + 1][NF + 1], int i, int j) {
+    if (i < NF + 1 && j < NF + 1) {
+        return corrLower[i][j];
+    } else {
+        return (i == j) ? (DT)1.0 : (DT)0.0;
+    }
+}
+
+/**
+ * @brief Packs the lower triangular factor of the rate and the factors into the layout of MultiVariateNormalRng.
+ *
+ * Column a of ltm holds column a of the factor from its diagonal down, followed by column 2 * VP - 1 - a from its
+ * diagonal down. An odd number of variates is padded by one independent of the others.
+ */
+template <typename DT, int NF, int VP>
+void exposurePackLTM(DT corrLower[NF + 1][NF + 1], DT ltm[VP * 2 + 1][VP]) {
+    for (int a = 0; a < VP; a++) {
+        for (int k = 0; k < VP * 2 + 1; k++) {
+#pragma HLS pipeline II = 1
+            if (k < VP * 2 - a) {
+                ltm[k][a] = exposureCorrEntry<DT, NF>(corrLower, a + k, a);
+            } else {
+                ltm[k][a] = exposureCorrEntry<DT, NF>(corrLower, k - 1, VP * 2 - 1 - a);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Generates the scenarios of every path and time step once, and broadcasts them to the pricing units.
+ *
+ * The short rate is r = x + fdShortRate(t) of the Hull-White model, with x an Ornstein-Uhlenbeck process from 0
+ * stepped exactly. Each scenario is written as the short rate, the discount factor from 0 and the NF risk factors.
+ */
+template <typename DT, int NF, int UN>
+void exposureScenarioGen(ap_uint<32> seed,
+                         unsigned int paths,
+                         unsigned int steps,
+                         DT dt,
+                         DT meanReversion,
+                         DT rateVolatility,
+                         HWModel<DT, void, 0>& rateModel,
+                         DT underlying[NF],
+                         DT volatility[NF],
+                         DT dividendYield[NF],
+                         DT corrLower[NF + 1][NF + 1],
+                         hls::stream<DT> scenarioStrm[UN]) {
+    // pairs of correlated normals, the rate first
+    const int VP = (NF + 2) / 2;
+    // steps of the RNG before an entry of its buffer is updated again, more than the latency of the update
+    const int BD = 32;
+    DT ltm[VP * 2 + 1][VP];
+    exposurePackLTM<DT, NF, VP>(corrLower, ltm);
+    MultiVariateNormalRng<DT, VP, BD> rng;
+    rng.init(seed, ltm);
+
+    DT expAdt = FPExp(-meanReversion * dt);
+    DT rateStdDev = hls::sqrt(rateVolatility * rateVolatility * (1.0 - expAdt * expAdt) / (2.0 * meanReversion));
+
+    DT logS0[NF];
+    DT stepDrift[NF];
+    DT stepStdDev[NF];
+    for (int f = 0; f < NF; f++) {
+        logS0[f] = hls::log(underlying[f]);
+        stepDrift[f] = -(dividendYield[f] + 0.5 * volatility[f] * volatility[f]) * dt;
+        stepStdDev[f] = volatility[f] * hls::sqrt(dt);
+    }
+
+PATH_LOOP:
+    for (unsigned int p = 0; p < paths; p++) {
+#pragma HLS loop_tripcount min = 1024 max = 1024
+        DT x = 0;
+        DT r = rateModel.fdShortRate(0);
+        DT logDisc = 0;
+        DT logS[NF];
+#pragma HLS array_partition variable = logS dim = 0
+        for (int f = 0; f < NF; f++) {
+#pragma HLS unroll
+            logS[f] = logS0[f];
+        }
+
+    STEP_LOOP:
+        for (unsigned int t = 0; t < steps; t++) {
+#pragma HLS loop_tripcount min = 64 max = 64
+            // correlated normals, rate first
+            DT w[VP * 2];
+#pragma HLS array_partition variable = w dim = 0
+            for (int i = 0; i < VP; i++) {
+#pragma HLS pipeline II = 1
+                rng.next(w[2 * i], w[2 * i + 1]);
+            }
+
+            // factors drift at the short rate of the start of the step, discounting uses the trapezoidal rule
+            x = FPTwoAdd(FPTwoMul(expAdt, x), rateStdDev * w[0]);
+            DT rNext = FPTwoAdd(x, rateModel.fdShortRate((t + 1) * dt));
+            for (int f = 0; f < NF; f++) {
+#pragma HLS unroll
+                logS[f] = FPTwoAdd(FPTwoAdd(logS[f], FPTwoAdd(r * dt, stepDrift[f])), stepStdDev[f] * w[f + 1]);
+            }
+            logDisc = FPTwoSub(logDisc, 0.5 * dt * FPTwoAdd(r, rNext));
+            r = rNext;
+
+            DT disc = FPExp(logDisc);
+            for (int k = 0; k < NF + 2; k++) {
+#pragma HLS pipeline II = 1
+                DT out;
+                if (k == 0) {
+                    out = r;
+                } else if (k == 1) {
+                    out = disc;
+                } else {
+                    out = FPExp(logS[k - 2]);
+                }
+                for (int u = 0; u < UN; u++) {
+#pragma HLS unroll
+                    scenarioStrm[u].write(out);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Value of one trade in one scenario, at time t
+ */
+template <typename DT, int NF>
+DT exposureTradeValue(ExposureTrade<DT>& trade,
+                      DT t,
+                      DT r,
+                      DT factors[NF],
+                      HWModel<DT, void, 0>& rateModel,
+                      DT volatility[NF],
+                      DT dividendYield[NF]) {
+    DT value = 0;
+    if (t < trade.maturity) {
+        DT tau = trade.maturity - t;
+        DT bondMat = rateModel.discountBond(t, trade.maturity, r);
+        if (trade.type == kTradeSwap) {
+            // fixed leg on the remaining payments, floating leg at par from the start or from now
+            DT annuity = 0;
+            int numPayments = (int)((trade.maturity - trade.start) / trade.period + 0.5);
+        SWAP_LOOP:
+            for (int i = 1; i <= numPayments; i++) {
+#pragma HLS loop_tripcount min = 20 max = 20
+#pragma HLS pipeline II = 1
+                DT payment = trade.start + i * trade.period;
+                if (payment > t) {
+                    annuity = FPTwoAdd(annuity, trade.period * rateModel.discountBond(t, payment, r));
+                }
+            }
+            DT floatLeg;
+            if (t < trade.start) {
+                floatLeg = rateModel.discountBond(t, trade.start, r) - bondMat;
+            } else {
+                floatLeg = 1.0 - bondMat;
+            }
+            value = trade.notional * (trade.strike * annuity - floatLeg);
+        } else {
+            DT forward = factors[trade.factor] * FPExp(-dividendYield[trade.factor] * tau) / bondMat;
+            if (trade.type == kTradeForward) {
+                value = trade.notional * bondMat * (forward - trade.strike);
+            } else {
+                // Black formula on the forward, discounted by the bond of the simulated curve
+                DT stdDev = volatility[trade.factor] * hls::sqrt(tau);
+                DT d1 = hls::log(forward / trade.strike) / stdDev + 0.5 * stdDev;
+                DT d2 = d1 - stdDev;
+                DT omega = (trade.optionType == Call) ? 1.0 : -1.0;
+                DT x1 = omega * d1;
+                DT x2 = omega * d2;
+                // the cumulative normal of rng.hpp is accurate within the range of the MT19937 normals
+                x1 = (x1 > 6.0) ? (DT)6.0 : ((x1 < -6.0) ? (DT)-6.0 : x1);
+                x2 = (x2 > 6.0) ? (DT)6.0 : ((x2 < -6.0) ? (DT)-6.0 : x2);
+                value = trade.notional * bondMat * omega *
+                        (forward * CumulativeNormal<DT>(x1) - trade.strike * CumulativeNormal<DT>(x2));
+            }
+        }
+    }
+    return value;
+}
+
+/**
+ * @brief Revalues the trades of one pricing unit in every scenario, and sums them per netting set.
+ */
+template <typename DT, int NF, int MAX_UNIT_TRADES, int MAX_NS>
+void exposurePricingUnit(unsigned int paths,
+                         unsigned int steps,
+                         DT dt,
+                         HWModel<DT, void, 0> rateModel,
+                         DT volatility[NF],
+                         DT dividendYield[NF],
+                         unsigned int numTrades,
+                         ExposureTrade<DT> trades[MAX_UNIT_TRADES],
+                         unsigned int numNettingSets,
+                         hls::stream<DT>& scenarioStrm,
+                         hls::stream<DT>& valueStrm) {
+    DT nsValue[MAX_NS];
+SCENARIO_LOOP:
+    for (unsigned int n = 0; n < paths * steps; n++) {
+#pragma HLS loop_tripcount min = 65536 max = 65536
+        DT t = (n % steps + 1) * dt;
+        DT r = scenarioStrm.read();
+        scenarioStrm.read(); // the discount factor is only used by the aggregation
+        DT factors[NF];
+#pragma HLS array_partition variable = factors dim = 0
+        for (int f = 0; f < NF; f++) {
+#pragma HLS pipeline II = 1
+            factors[f] = scenarioStrm.read();
+        }
+
+        for (unsigned int k = 0; k < numNettingSets; k++) {
+#pragma HLS loop_tripcount min = 16 max = 16
+#pragma HLS pipeline II = 1
+            nsValue[k] = 0;
+        }
+    TRADE_LOOP:
+        for (unsigned int k = 0; k < numTrades; k++) {
+#pragma HLS loop_tripcount min = 256 max = 256
+            DT v = exposureTradeValue<DT, NF>(trades[k], t, r, factors, rateModel, volatility, dividendYield);
+            nsValue[trades[k].nettingSet] = FPTwoAdd(nsValue[trades[k].nettingSet], v);
+        }
+        for (unsigned int k = 0; k < numNettingSets; k++) {
+#pragma HLS loop_tripcount min = 16 max = 16
+#pragma HLS pipeline II = 1
+            valueStrm.write(nsValue[k]);
+        }
+    }
+}
+
+/**
+ * @brief Sums the netting set values of the pricing units, and accumulates the exposures of every time step.
+ */
+template <typename DT, int UN, int MAX_NS, int MAX_STEPS>
+void exposureAggregate(unsigned int paths,
+                       unsigned int steps,
+                       unsigned int numNettingSets,
+                       DT quantile,
+                       hls::stream<DT> valueStrm[UN],
+                       hls::stream<DT>& discStrm,
+                       DT ee[MAX_STEPS][MAX_NS],
+                       DT discountedEE[MAX_STEPS][MAX_NS],
+                       ExposureQuantile<DT> pfe[MAX_STEPS][MAX_NS]) {
+    for (unsigned int t = 0; t < steps; t++) {
+#pragma HLS loop_tripcount min = 64 max = 64
+        for (unsigned int k = 0; k < numNettingSets; k++) {
+#pragma HLS loop_tripcount min = 16 max = 16
+#pragma HLS pipeline II = 1
+            ee[t][k] = 0;
+            discountedEE[t][k] = 0;
+            pfe[t][k].init();
+        }
+    }
+
+SCENARIO_LOOP:
+    for (unsigned int n = 0; n < paths * steps; n++) {
+#pragma HLS loop_tripcount min = 65536 max = 65536
+        unsigned int t = n % steps;
+        DT disc = discStrm.read();
+        for (unsigned int k = 0; k < numNettingSets; k++) {
+#pragma HLS loop_tripcount min = 16 max = 16
+            DT value = 0;
+            for (int u = 0; u < UN; u++) {
+#pragma HLS unroll
+                value = FPTwoAdd(value, valueStrm[u].read());
+            }
+            DT exposure = (value > 0) ? value : (DT)0;
+            ee[t][k] = FPTwoAdd(ee[t][k], exposure);
+            discountedEE[t][k] = FPTwoAdd(discountedEE[t][k], disc * exposure);
+            pfe[t][k].add(exposure, quantile);
+        }
+    }
+}
+
+/**
+ * @brief Extracts the discount factors of the scenarios broadcast to one pricing unit.
+ */
+template <typename DT, int NF>
+void exposureSplitDiscount(unsigned int paths,
+                           unsigned int steps,
+                           hls::stream<DT>& scenarioStrm,
+                           hls::stream<DT>& unitStrm,
+                           hls::stream<DT>& discStrm) {
+    for (unsigned int n = 0; n < paths * steps; n++) {
+#pragma HLS loop_tripcount min = 65536 max = 65536
+        for (int k = 0; k < NF + 2; k++) {
+#pragma HLS pipeline II = 1
+            DT in = scenarioStrm.read();
+            unitStrm.write(in);
+            if (k == 1) {
+                discStrm.write(in);
+            }
+        }
+    }
+}
+
+template <typename DT, int NF, int UN, int MAX_UNIT_TRADES, int MAX_NS, int MAX_STEPS>
+void exposureSimulation(ap_uint<32> seed,
+                        unsigned int paths,
+                        unsigned int steps,
+                        DT dt,
+                        DT meanReversion,
+                        DT rateVolatility,
+                        HWModel<DT, void, 0>& rateModel,
+                        DT underlying[NF],
+                        DT volatility[NF],
+                        DT dividendYield[NF],
+                        DT corrLower[NF + 1][NF + 1],
+                        unsigned int unitTrades[UN],
+                        ExposureTrade<DT> trades[UN][MAX_UNIT_TRADES],
+                        unsigned int numNettingSets,
+                        DT quantile,
+                        DT ee[MAX_STEPS][MAX_NS],
+                        DT discountedEE[MAX_STEPS][MAX_NS],
+                        ExposureQuantile<DT> pfe[MAX_STEPS][MAX_NS]) {
+#pragma HLS dataflow
+    hls::stream<DT> scenarioStrm[UN];
+    hls::stream<DT> unitStrm[UN];
+    hls::stream<DT> valueStrm[UN];
+    hls::stream<DT> discStrm;
+#pragma HLS stream variable = scenarioStrm depth = 32
+#pragma HLS stream variable = unitStrm depth = 32
+#pragma HLS stream variable = valueStrm depth = 32
+#pragma HLS stream variable = discStrm depth = 64
+#pragma HLS array_partition variable = trades dim = 1
+
+    exposureScenarioGen<DT, NF, UN>(seed, paths, steps, dt, meanReversion, rateVolatility, rateModel, underlying,
+                                    volatility, dividendYield, corrLower, scenarioStrm);
+    // the first unit forwards the discount factors to the aggregation
+    exposureSplitDiscount<DT, NF>(paths, steps, scenarioStrm[0], unitStrm[0], discStrm);
+    exposurePricingUnit<DT, NF, MAX_UNIT_TRADES, MAX_NS>(paths, steps, dt, rateModel, volatility, dividendYield,
+                                                         unitTrades[0], trades[0], numNettingSets, unitStrm[0],
+                                                         valueStrm[0]);
+    for (int u = 1; u < UN; u++) {
+#pragma HLS unroll
+        exposurePricingUnit<DT, NF, MAX_UNIT_TRADES, MAX_NS>(paths, steps, dt, rateModel, volatility, dividendYield,
+                                                             unitTrades[u], trades[u], numNettingSets,
+                                                             scenarioStrm[u], valueStrm[u]);
+    }
+    exposureAggregate<DT, UN, MAX_NS, MAX_STEPS>(paths, steps, numNettingSets, quantile, valueStrm, discStrm, ee,
+                                                 discountedEE, pfe);
+}
+
+} // namespace internal
+
+/**
+ * @brief Exposure engine for counterparty credit risk using Monte Carlo Method.
+ *
+ * The risk factors are simulated once and shared by every trade of the portfolio, instead of each trade
+ * simulating its own underlying. A scenario generator draws correlated paths of the short rate and of NF
+ * lognormal risk factors (equities or FX rates). It streams every scenario to UN pricing units, each of them
+ * revaluing its share of the trades and summing them per netting set. The aggregation adds up the units and
+ * accumulates the exposure max(V, 0) of each netting set at each time step.
+ *
+ * The short rate follows the Hull-White model of HWModel fitted to a flat initial curve, so that swaps and the
+ * discounting of forwards and options use its closed form zero coupon bonds of the simulated rate. The risk factors
+ * drift at the short rate less their dividend yield. The correlated normals of the rate and the factors are drawn by
+ * MultiVariateNormalRng from the lower triangular Cholesky factor of their correlation matrix, the rate first.
+ *
+ * @tparam DT supported data type including double and float data type, which decides the precision of result,
+ * default double-precision data type.
+ * @tparam NF number of risk factors besides the short rate.
+ * @tparam UN number of trade pricing units in parallel, which affects the latency and resources utilization.
+ * @tparam MAX_TRADES maximum number of trades.
+ * @tparam MAX_NS maximum number of netting sets.
+ * @tparam MAX_STEPS maximum number of time steps.
+ *
+ * @param seed seed of the RNG.
+ * @param paths number of simulated paths.
+ * @param steps number of time steps, the exposures are calculated at the end of each step.
+ * @param dt length of a time step.
+ * @param r0 initial short rate, also the flat initial curve.
+ * @param meanReversion mean reversion speed of the short rate.
+ * @param rateVolatility volatility of the short rate.
+ * @param underlying initial value of each risk factor.
+ * @param volatility volatility of each risk factor.
+ * @param dividendYield dividend yield, or foreign rate, of each risk factor.
+ * @param corrLower lower triangular Cholesky factor of the correlation matrix of the short rate and the factors.
+ * @param numTrades number of trades.
+ * @param trades the trades of the portfolio.
+ * @param numNettingSets number of netting sets.
+ * @param hazardRate constant default intensity of the counterparty of each netting set.
+ * @param recoveryRate recovery rate of the counterparty of each netting set.
+ * @param quantile quantile of the potential future exposure, e.g. 0.95.
+ * @param ee expected exposure of netting set k at the end of step t, at ee[k * steps + t].
+ * @param pfe potential future exposure of netting set k at the end of step t, at pfe[k * steps + t].
+ * @param cva credit value adjustment of each netting set.
+ */
+template <typename DT = double, int NF = 2, int UN = 4, int MAX_TRADES = 1024, int MAX_NS = 16, int MAX_STEPS = 128>
+void MCExposureEngine(ap_uint<32> seed,
+                      unsigned int paths,
+                      unsigned int steps,
+                      DT dt,
+                      DT r0,
+                      DT meanReversion,
+                      DT rateVolatility,
+                      DT underlying[NF],
+                      DT volatility[NF],
+                      DT dividendYield[NF],
+                      DT corrLower[NF + 1][NF + 1],
+                      unsigned int numTrades,
+                      ExposureTrade<DT> trades[MAX_TRADES],
+                      unsigned int numNettingSets,
+                      DT hazardRate[MAX_NS],
+                      DT recoveryRate[MAX_NS],
+                      DT quantile,
+                      DT* ee,
+                      DT* pfe,
+                      DT* cva) {
+    const int MAX_UNIT_TRADES = (MAX_TRADES + UN - 1) / UN;
+
+    HWModel<DT, void, 0> rateModel;
+    rateModel.initialization(r0, 0.0, meanReversion, rateVolatility);
+
+    // deal the trades to the pricing units
+    ExposureTrade<DT> unitTrades[UN][MAX_UNIT_TRADES];
+    unsigned int unitNumTrades[UN];
+#pragma HLS array_partition variable = unitTrades dim = 1
+#pragma HLS array_partition variable = unitNumTrades dim = 0
+    for (int u = 0; u < UN; u++) {
+#pragma HLS unroll
+        unitNumTrades[u] = 0;
+    }
+    for (unsigned int k = 0; k < numTrades; k++) {
+#pragma HLS loop_tripcount min = 1024 max = 1024
+#pragma HLS pipeline II = 1
+        unitTrades[k % UN][k / UN] = trades[k];
+        unitNumTrades[k % UN]++;
+    }
+
+    DT eeBuff[MAX_STEPS][MAX_NS];
+    DT discountedEE[MAX_STEPS][MAX_NS];
+    internal::ExposureQuantile<DT> pfeBuff[MAX_STEPS][MAX_NS];
+    internal::exposureSimulation<DT, NF, UN, MAX_UNIT_TRADES, MAX_NS, MAX_STEPS>(
+        seed, paths, steps, dt, meanReversion, rateVolatility, rateModel, underlying, volatility, dividendYield,
+        corrLower, unitNumTrades, unitTrades, numNettingSets, quantile, eeBuff, discountedEE, pfeBuff);
+
+    // CVA from the discounted EE and the default probability of each step
+    DT invPaths = 1.0 / paths;
+    for (unsigned int k = 0; k < numNettingSets; k++) {
+#pragma HLS loop_tripcount min = 16 max = 16
+        DT survival = 1.0;
+        DT sum = 0;
+        for (unsigned int t = 0; t < steps; t++) {
+#pragma HLS loop_tripcount min = 64 max = 64
+#pragma HLS pipeline II = 1
+            DT nextSurvival = internal::FPExp(-hazardRate[k] * (t + 1) * dt);
+            sum = internal::FPTwoAdd(sum, discountedEE[t][k] * invPaths * (survival - nextSurvival));
+            survival = nextSurvival;
+            ee[k * steps + t] = eeBuff[t][k] * invPaths;
+            pfe[k * steps + t] = pfeBuff[t][k].quantile(quantile);
+        }
+        cva[k] = (1.0 - recoveryRate[k]) * sum;
+    }
+}
+
+} // namespace fintech
+} // namespace xf
+
+#endif // _XF_FINTECH_EXPOSURE_ENGINE_H_
@@ -142,6 +142,133 @@ void MCEuropeanEngine(DT underlying,
     // output the price of option
     output[0] = price;
 }
+/**
+ * @brief European Option Pricing Engine using Monte Carlo Method, with the
+ * counter-based Philox4x32-10 RNG. This implementation uses Black-Scholes
+ * valuation model.
+ *
+ * All the RNGs share one seed, and each path takes the random numbers of its
+ * own index, so a path is simulated with the same random numbers for any UN
+ * and any number of CUs. With cuNum CUs, CU cuId simulates one UN * 1024 share
+ * of every cuNum * UN * 1024 paths, and the host averages the outputs of the
+ * CUs. The price is not bit-reproducible across UN and cuNum though: the
+ * number of paths is rounded up to whole rounds of UN * 1024 per CU, each CU
+ * checks requiredTolerance on its own paths, and the order of the floating
+ * point sums depends on UN and cuNum.
+ *
+ * @tparam DT supported data type including double and float data type, which
+ * decides the precision of result, default double-precision data type.
+ * @tparam UN number of Monte Carlo Module in parallel, which affects the
+ * latency and resources utilization, default 10.
+ * @tparam Antithetic antithetic is used  for variance reduction, default this
+ * feature is disabled.
+ * @param underlying intial value of underlying asset at time 0.
+ * @param volatility fixed volatility of underlying asset.
+ * @param dividendYield the constant dividend rate for continuous dividends.
+ * @param riskFreeRate risk-free interest rate.
+ * @param timeLength the time length of contract from start to end.
+ * @param strike the strike price also known as exericse price, which is settled
+ * in the contract.
+ * @param optionType option type. 1: put option, 0: call option.
+ * @param seed the seed shared by all the RNGs of all the CUs.
+ * @param cuId index of this CU.
+ * @param cuNum number of CUs sharing the simulation.
+ * @param output output array.
+ * @param requiredTolerance the tolerance required. If requiredSamples is not
+ * set, when reaching the required tolerance, simulation will stop, default
+ * 0.02.
+ * @param requiredSamples the samples number required. When reaching the
+ * required number, simulation will stop, default 1024.
+ * @param timeSteps the number of discrete steps from 0 to T, T is the expiry
+ * time, default 100.
+ * @param maxSamples the maximum sample number. When reaching it, the simulation
+ * will stop, default 2,147,483,648.
+ */
+template <typename DT = double, int UN = 10, bool Antithetic = false>
+void MCEuropeanPhiloxEngine(DT underlying,
+                            DT volatility,
+                            DT dividendYield,
+                            DT riskFreeRate, // model parameter
+                            DT timeLength,
+                            DT strike,
+                            bool optionType, // option parameter
+                            ap_uint<32> seed,
+                            ap_uint<32> cuId,
+                            ap_uint<32> cuNum,
+                            DT* output,
+                            DT requiredTolerance = 0.02,
+                            unsigned int requiredSamples = 1024,
+                            unsigned int timeSteps = 100,
+                            unsigned int maxSamples = MAX_SAMPLE) {
+    // number of samples per simulation
+    const static int SN = 1024;
+
+    // number of variate
+    const static int VN = 1;
+
+    // Step first or sample first for each simulation
+    const static bool SF = true;
+
+    // option style
+    const OptionStyle sty = European;
+
+    // RNG alias name
+    typedef PhiloxIcnRng<DT> RNG;
+
+    BSModel<DT> BSInst;
+
+    // path generator instance
+    BSPathGenerator<DT, SF, SN, Antithetic> pathGenInst[UN][1];
+#pragma HLS array_partition variable = pathGenInst dim = 1
+
+    // path pricer instance
+    PathPricer<sty, DT, SF, SN, Antithetic> pathPriInst[UN][1];
+#pragma HLS array_partition variable = pathPriInst dim = 1
+
+    // RNG sequence instance
+    PathIndexedRNGSequence<DT, RNG> rngSeqInst[UN][1];
+#pragma HLS array_partition variable = rngSeqInst dim = 1
+
+    // pre-process for "cold" logic.
+    DT dt = timeLength / timeSteps;
+    DT f_1 = internal::FPTwoMul(riskFreeRate, timeLength);
+    DT discount = internal::FPExp(-f_1);
+
+    BSInst.riskFreeRate = riskFreeRate;
+    BSInst.dividendYield = dividendYield;
+    BSInst.volatility = volatility;
+    //
+    BSInst.variance(dt);
+    BSInst.stdDeviation();
+    BSInst.updateDrift(dt);
+
+    // configure the path generator and path pricer
+    for (int i = 0; i < UN; ++i) {
+#pragma HLS unroll
+        // Path generator
+        pathPriInst[i][0].optionType = optionType;
+        pathPriInst[i][0].strike = strike;
+        pathPriInst[i][0].underlying = underlying;
+        pathPriInst[i][0].discount = discount;
+        // Path pricer
+        pathGenInst[i][0].BSInst = BSInst;
+        // RNGSequnce
+        rngSeqInst[i][0].seed[0] = seed;
+        rngSeqInst[i][0].unitId = cuId * UN + i;
+        rngSeqInst[i][0].unitNum = cuNum * UN;
+    }
+
+    // call monter carlo simulation
+    DT price =
+        mcSimulation<DT, RNG, BSPathGenerator<DT, SF, SN, Antithetic>, PathPricer<sty, DT, SF, SN, Antithetic>,
+                     PathIndexedRNGSequence<DT, RNG>, UN, VN, SN>(timeSteps, maxSamples, requiredSamples,
+                                                                  requiredTolerance, pathGenInst, pathPriInst,
+                                                                  rngSeqInst);
+
+    // output the price of option
+    output[0] = price;
+}
+
 /**
  * @brief path pricer bypass variant (interface compatible with standard MCEuropeanEngine)
  *
@@ -1228,6 +1355,50 @@ void MCAsianGeometricAPEngine(DT underlying,
     output[0] = price;
 }
 
+namespace internal {
+/**
+ * @brief Closed form price of the Geometric Asian Average Price option on the fixings at time 0 and at each step,
+ * the control variate of the Arithmetic Asian Average Price engines.
+ */
+template <typename DT>
+DT asianGeometricAPPrice(DT underlying,
+                         DT volatility,
+                         DT dividendYield,
+                         DT riskFreeRate,
+                         DT timeLength,
+                         DT strike,
+                         bool optionType,
+                         unsigned int timeSteps,
+                         DT discount) {
+    DT fixings = timeSteps + 1;
+    DT timeSum = (timeSteps + 1) * timeLength * 0.5;
+    // DT temp=(timeSteps-1)*(timeSteps+1)*timeSteps/6.0*dt;
+    DT temp = timeSum * (timeSteps - 1) / 3.0;
+    DT tempFC = 2 * temp + timeSum;
+    DT sqrtFC = hls::sqrt(tempFC);
+    DT tempvf = volatility / fixings;
+
+    DT variance = tempvf * tempvf * tempFC;
+    DT nu = riskFreeRate - dividendYield - 0.5 * volatility * volatility;
+    DT muG = hls::log(underlying) + nu * timeLength * 0.5;
+    DT forwardPrice = std::exp(muG + variance * 0.5);
+    DT stDev = hls::sqrt(variance);
+    DT d1 = hls::log(forwardPrice / strike) / stDev + 0.5 * stDev;
+    DT d2 = d1 - stDev;
+    DT cum_d1 = CumulativeNormal<DT>(d1);
+    DT cum_d2 = CumulativeNormal<DT>(d2);
+    DT alpha, beta;
+    if (optionType) {
+        alpha = -1 + cum_d1;
+        beta = 1 - cum_d2;
+    } else {
+        alpha = cum_d1;
+        beta = -cum_d2;
+    }
+    return discount * (forwardPrice * alpha + strike * beta);
+}
+} // namespace internal
+
 /**
  * @brief Asian Arithmetic Average Price Engine using Monte Carlo Method Based
  * on Black-Scholes Model.
@@ -1349,32 +1520,8 @@ void MCAsianArithmeticAPEngine(DT underlying,
                                         pathPriInst, rngSeqInst);
 
     // Control variate price ref
-    DT fixings = timeSteps + 1;
-    DT timeSum = (timeSteps + 1) * timeLength * 0.5;
-    // DT temp=(timeSteps-1)*(timeSteps+1)*timeSteps/6.0*dt;
-    DT temp = timeSum * (timeSteps - 1) / 3.0;
-    DT tempFC = 2 * temp + timeSum;
-    DT sqrtFC = hls::sqrt(tempFC);
-    DT tempvf = volatility / fixings;
-
-    DT variance = tempvf * tempvf * tempFC;
-    DT nu = riskFreeRate - dividendYield - 0.5 * volatility * volatility;
-    DT muG = hls::log(underlying) + nu * timeLength * 0.5;
-    DT forwardPrice = std::exp(muG + variance * 0.5);
-    DT stDev = hls::sqrt(variance);
-    DT d1 = hls::log(forwardPrice / strike) / stDev + 0.5 * stDev;
-    DT d2 = d1 - stDev;
-    DT cum_d1 = CumulativeNormal<DT>(d1);
-    DT cum_d2 = CumulativeNormal<DT>(d2);
-    DT alpha, beta;
-    if (optionType) {
-        alpha = -1 + cum_d1;
-        beta = 1 - cum_d2;
-    } else {
-        alpha = cum_d1;
-        beta = -cum_d2;
-    }
-    DT priceRef = discount * (forwardPrice * alpha + strike * beta);
+    DT priceRef = internal::asianGeometricAPPrice<DT>(underlying, volatility, dividendYield, riskFreeRate, timeLength,
+                                                      strike, optionType, timeSteps, discount);
     // output result
     output[0] = price + priceRef;
 }
@@ -2062,6 +2209,1006 @@ void MCEuropeanHestonGreeksEngine(DT underlying,
     greeks[7] = (priceBuff[10] - priceBuff[0]) / d_v0;
 }
 
+/**
+ * @brief European Option Greeks Calculating Engine using Monte Carlo Method. This implementation uses Black-Scholes
+ * valuation model, and returns the price and Greeks of the same paths in one simulation, using pathwise estimators
+ * for delta, vega and rho and a mixed likelihood-ratio and pathwise estimator for gamma.
+ *
+ * @tparam DT supported data type including double and float data type, which
+ * decides the precision of result, default double-precision data type.
+ * @tparam UN number of Monte Carlo Module in parallel, which affects the
+ * latency and resources utilization, default 10.
+ * @param underlying intial value of underlying asset at time 0.
+ * @param volatility fixed volatility of underlying asset.
+ * @param dividendYield the constant dividend rate for continuous dividends.
+ * @param riskFreeRate risk-free interest rate.
+ * @param timeLength the time length of contract from start to end.
+ * @param strike the strike price also known as exericse price, which is settled
+ * in the contract.
+ * @param optionType option type. 1: put option, 0: call option.
+ * @param seed array to store the inital seed for each RNG.
+ * @param greeks output array of price, delta, gamma, vega and rho, in the order of GreeksType.
+ * @param requiredTolerance the tolerance required on the price. If requiredSamples is not
+ * set, when reaching the required tolerance, simulation will stop, default
+ * 0.02.
+ * @param requiredSamples the samples number required. When reaching the
+ * required number, simulation will stop, default 1024.
+ * @param timeSteps the number of discrete steps from 0 to T, T is the expiry
+ * time, default 100.
+ * @param maxSamples the maximum sample number. When reaching it, the simulation
+ * will stop, default 2,147,483,648.
+ */
+template <typename DT = double, int UN = 10>
+void MCEuropeanGreeksEngine(DT underlying,
+                            DT volatility,
+                            DT dividendYield,
+                            DT riskFreeRate, // model parameter
+                            DT timeLength,
+                            DT strike,
+                            bool optionType, // option parameter
+                            ap_uint<32>* seed,
+                            DT* greeks,
+                            DT requiredTolerance = 0.02,
+                            unsigned int requiredSamples = 1024,
+                            unsigned int timeSteps = 100,
+                            unsigned int maxSamples = MAX_SAMPLE) {
+    // number of samples per simulation
+    const static int SN = 1024;
+
+    // number of variate
+    const static int VN = 1;
+
+    // the Greeks path pricers read the paths sample first
+    const static bool SF = false;
+
+    // RNG alias name
+    typedef MT19937IcnRng<DT> RNG;
+
+    BSModel<DT> BSInst;
+
+    // path generator instance
+    BSPathGenerator<DT, SF, SN, false> pathGenInst[UN][1];
+#pragma HLS array_partition variable = pathGenInst dim = 1
+
+    // path pricer instance
+    GreeksPathPricer<European, DT, SN> pathPriInst[UN][1];
+#pragma HLS array_partition variable = pathPriInst dim = 1
+
+    // RNG sequence instance
+    RNGSequence<DT, RNG> rngSeqInst[UN][1];
+#pragma HLS array_partition variable = rngSeqInst dim = 1
+
+    // pre-process for "cold" logic.
+    DT dt = timeLength / timeSteps;
+    DT f_1 = internal::FPTwoMul(riskFreeRate, timeLength);
+    DT discount = internal::FPExp(-f_1);
+
+    BSInst.riskFreeRate = riskFreeRate;
+    BSInst.dividendYield = dividendYield;
+    BSInst.volatility = volatility;
+    //
+    BSInst.variance(dt);
+    BSInst.stdDeviation();
+    BSInst.updateDrift(dt);
+
+    // configure the path generator and path pricer
+    for (int i = 0; i < UN; ++i) {
+#pragma HLS unroll
+        // Path pricer
+        pathPriInst[i][0].underlying = underlying;
+        pathPriInst[i][0].volatility = volatility;
+        pathPriInst[i][0].riskFreeRate = riskFreeRate;
+        pathPriInst[i][0].dividendYield = dividendYield;
+        pathPriInst[i][0].dt = dt;
+        pathPriInst[i][0].drift = BSInst.drift;
+        pathPriInst[i][0].stdDev = BSInst.stdDev;
+        pathPriInst[i][0].setup();
+        pathPriInst[i][0].optionType = optionType;
+        pathPriInst[i][0].strike = strike;
+        pathPriInst[i][0].discount = discount;
+        // Path generator
+        pathGenInst[i][0].BSInst = BSInst;
+        // RNGSequnce
+        rngSeqInst[i][0].seed[0] = seed[i];
+    }
+
+    // call monter carlo simulation
+    mcSimulationGreeks<DT, RNG, BSPathGenerator<DT, SF, SN, false>, GreeksPathPricer<European, DT, SN>,
+                       RNGSequence<DT, RNG>, UN, VN, SN>(timeSteps, maxSamples, requiredSamples, requiredTolerance,
+                                                         pathGenInst, pathPriInst, rngSeqInst, greeks);
+}
+
+/**
+ * @brief Asian Arithmetic Average Price Greeks Calculating Engine using Monte Carlo Method Based on Black-Scholes
+ * Model. The average includes the price at time 0 and at each step, and the Greeks are estimated on the same paths
+ * as the price, pathwise for delta, vega and rho and with a mixed likelihood-ratio and pathwise estimator for gamma.
+ * Unlike MCAsianArithmeticAPEngine, no geometric control variate is used.
+ *
+ * @tparam DT supported data type including double and float data type, which
+ * decides the precision of result, default double-precision data type.
+ * @tparam UN number of Monte Carlo Module in parallel, which affects the
+ * latency and resources utilization, default 10.
+ * @param underlying intial value of underlying asset at time 0.
+ * @param volatility fixed volatility of underlying asset.
+ * @param dividendYield the constant dividend rate for continuous dividends.
+ * @param riskFreeRate risk-free interest rate.
+ * @param timeLength the time length of contract from start to end.
+ * @param strike the strike price also known as exericse price, which is settled
+ * in the contract.
+ * @param optionType option type. 1: put option, 0: call option.
+ * @param seed array to store the inital seed for each RNG.
+ * @param greeks output array of price, delta, gamma, vega and rho, in the order of GreeksType.
+ * @param requiredTolerance the tolerance required on the price. If requiredSamples is not
+ * set, when reaching the required tolerance, simulation will stop, default
+ * 0.02.
+ * @param requiredSamples the samples number required. When reaching the
+ * required number, simulation will stop, default 1024.
+ * @param timeSteps the number of discrete steps from 0 to T, T is the expiry
+ * time, default 100.
+ * @param maxSamples the maximum sample number. When reaching it, the simulation
+ * will stop, default 2,147,483,648.
+ */
+template <typename DT = double, int UN = 10>
+void MCAsianArithmeticAPGreeksEngine(DT underlying,
+                                     DT volatility,
+                                     DT dividendYield,
+                                     DT riskFreeRate, // model parameter
+                                     DT timeLength,
+                                     DT strike,
+                                     bool optionType, // option parameter
+                                     ap_uint<32>* seed,
+                                     DT* greeks,
+                                     DT requiredTolerance = 0.02,
+                                     unsigned int requiredSamples = 1024,
+                                     unsigned int timeSteps = 100,
+                                     unsigned int maxSamples = MAX_SAMPLE) {
+    // number of samples per simulation
+    const static int SN = 1024;
+
+    // number of variate
+    const static int VN = 1;
+
+    // the Greeks path pricers read the paths sample first
+    const static bool SF = false;
+
+    // RNG alias name
+    typedef MT19937IcnRng<DT> RNG;
+
+    BSModel<DT> BSInst;
+
+    // path generator instance
+    BSPathGenerator<DT, SF, SN, false> pathGenInst[UN][1];
+#pragma HLS array_partition variable = pathGenInst dim = 1
+
+    // path pricer instance
+    GreeksPathPricer<Asian_AP, DT, SN> pathPriInst[UN][1];
+#pragma HLS array_partition variable = pathPriInst dim = 1
+
+    // RNG sequence instance
+    RNGSequence<DT, RNG> rngSeqInst[UN][1];
+#pragma HLS array_partition variable = rngSeqInst dim = 1
+
+    // pre-process for "cold" logic.
+    DT dt = timeLength / timeSteps;
+    DT f_1 = internal::FPTwoMul(riskFreeRate, timeLength);
+    DT discount = internal::FPExp(-f_1);
+
+    BSInst.riskFreeRate = riskFreeRate;
+    BSInst.dividendYield = dividendYield;
+    BSInst.volatility = volatility;
+    //
+    BSInst.variance(dt);
+    BSInst.stdDeviation();
+    BSInst.updateDrift(dt);
+
+    // configure the path generator and path pricer
+    for (int i = 0; i < UN; ++i) {
+#pragma HLS unroll
+        // Path pricer
+        pathPriInst[i][0].underlying = underlying;
+        pathPriInst[i][0].volatility = volatility;
+        pathPriInst[i][0].riskFreeRate = riskFreeRate;
+        pathPriInst[i][0].dividendYield = dividendYield;
+        pathPriInst[i][0].dt = dt;
+        pathPriInst[i][0].drift = BSInst.drift;
+        pathPriInst[i][0].stdDev = BSInst.stdDev;
+        pathPriInst[i][0].setup();
+        pathPriInst[i][0].optionType = optionType;
+        pathPriInst[i][0].strike = strike;
+        pathPriInst[i][0].discount = discount;
+        // Path generator
+        pathGenInst[i][0].BSInst = BSInst;
+        // RNGSequnce
+        rngSeqInst[i][0].seed[0] = seed[i];
+    }
+
+    // call monter carlo simulation
+    mcSimulationGreeks<DT, RNG, BSPathGenerator<DT, SF, SN, false>, GreeksPathPricer<Asian_AP, DT, SN>,
+                       RNGSequence<DT, RNG>, UN, VN, SN>(timeSteps, maxSamples, requiredSamples, requiredTolerance,
+                                                         pathGenInst, pathPriInst, rngSeqInst, greeks);
+}
+
+/**
+ * @brief Barrier Option Greeks Calculating Engine using Monte Carlo Simulation. The barrier is monitored at each
+ * step as in MCBarrierEngine, and the Greeks are estimated on the same paths as the price with likelihood-ratio
+ * estimators, which stay unbiased across the discontinuity of the payoff at the barrier.
+ *
+ * @tparam DT supported data type including double and float data type, which
+ * decides the precision of result, default double-precision data type.
+ * @tparam UN number of Monte Carlo Module in parallel, which affects the
+ * latency and resources utilization, default 10.
+ * @param underlying intial value of underlying asset at time 0.
+ * @param volatility fixed volatility of underlying asset.
+ * @param dividendYield the constant dividend rate for continuous dividends.
+ * @param riskFreeRate risk-free interest rate.
+ * @param timeLength the time length of contract from start to end.
+ * @param barrier single barrier value.
+ * @param strike the strike price also known as exericse price, which is settled
+ * in the contract.
+ * @param barrierType barrier type including: DownIn(0), DownOut(1), UpIn(2),
+ * UpOut(3).
+ * @param optionType option type. 1: put option, 0: call option.
+ * @param seed array to store the inital seeds for each RNG.
+ * @param greeks output array of price, delta, gamma, vega and rho, in the order of GreeksType.
+ * @param rebate rebate value which is paid when the option is not triggered,
+ * default 0.
+ * @param requiredTolerance the tolerance required on the price. If requiredSamples is not
+ * set, when reaching the required tolerance, simulation will stop, default
+ * 0.02.
+ * @param requiredSamples the samples number required. When reaching the
+ * required number, simulation will stop, default 1024.
+ * @param timeSteps the number of discrete steps from 0 to T, T is the expiry
+ * time, default 100.
+ * @param maxSamples the maximum sample number. When reaching it, the
+ * simulation will stop, default 2,147,483,648.
+ */
+template <typename DT = double, int UN = 10>
+void MCBarrierGreeksEngine(DT underlying,
+                           DT volatility,
+                           DT dividendYield,
+                           DT riskFreeRate,
+                           DT timeLength, // Model parameter
+                           DT barrier,
+                           DT strike,
+                           ap_uint<2> barrierType,
+                           bool optionType, // option parameter
+                           ap_uint<32>* seed,
+                           DT* greeks,
+                           DT rebate = 0,
+                           DT requiredTolerance = 0.02,
+                           unsigned int requiredSamples = 1024,
+                           unsigned int timeSteps = 100,
+                           unsigned int maxSamples = MAX_SAMPLE) {
+    // number of samples per simulation
+    const static int SN = 1024; // SampNum
+
+    // number of variate
+    const static int VN = 1; // VariateNum
+
+    // step first or sample first
+    const static bool SF = false; // StepFirst
+
+    // RNG alias.
+    typedef MT19937IcnRng<DT> RNG;
+
+    // B-S model instance
+    BSModel<DT> BSInst;
+
+    // Path generator instance.
+    BSPathGenerator<DT, SF, SN, false> pathGenInst[UN][1];
+#pragma HLS array_partition variable = pathGenInst dim = 1
+
+    // Path Pricer instance
+    GreeksPathPricer<BarrierBiased, DT, SN> pathPriInst[UN][1];
+#pragma HLS array_partition variable = pathPriInst dim = 1
+
+    // RGn sequence generator instance
+    RNGSequence<DT, RNG> rngSeqInst[UN][1];
+#pragma HLS array_partition variable = rngSeqInst dim = 1
+
+    // pre-process for "cold" logic
+    DT dt = timeLength / timeSteps;
+    DT disDt = -internal::FPTwoMul(riskFreeRate, dt);
+
+    BSInst.riskFreeRate = riskFreeRate;
+    BSInst.dividendYield = dividendYield;
+    BSInst.volatility = volatility;
+    //
+    BSInst.variance(dt);
+    BSInst.stdDeviation();
+    BSInst.updateDrift(dt);
+    // configure path generator, paht pricer and RNG sequence generator.
+    for (int i = 0; i < UN; ++i) {
+#pragma HLS unroll
+        // Path Pricer
+        pathPriInst[i][0].underlying = underlying;
+        pathPriInst[i][0].volatility = volatility;
+        pathPriInst[i][0].riskFreeRate = riskFreeRate;
+        pathPriInst[i][0].dividendYield = dividendYield;
+        pathPriInst[i][0].dt = dt;
+        pathPriInst[i][0].drift = BSInst.drift;
+        pathPriInst[i][0].stdDev = BSInst.stdDev;
+        pathPriInst[i][0].setup();
+        pathPriInst[i][0].barrier = barrier;
+        pathPriInst[i][0].strike = strike;
+        pathPriInst[i][0].rebate = rebate;
+        pathPriInst[i][0].optionType = optionType;
+        pathPriInst[i][0].disDt = disDt;
+        pathPriInst[i][0].barrierType = BarrierType(int(barrierType));
+        // Path generator
+        pathGenInst[i][0].BSInst = BSInst;
+        // RNG sequence
+        rngSeqInst[i][0].seed[0] = seed[i];
+    }
+    // Monte Carlo simulation
+    mcSimulationGreeks<DT, RNG, BSPathGenerator<DT, SF, SN, false>, GreeksPathPricer<BarrierBiased, DT, SN>,
+                       RNGSequence<DT, RNG>, UN, VN, SN>(timeSteps, maxSamples, requiredSamples, requiredTolerance,
+                                                         pathGenInst, pathPriInst, rngSeqInst, greeks);
+}
+
+/**
+ * @brief Digital Option Greeks Calculating Engine using Monte Carlo Simulation.
+ * The B-S model is used to describe dynamics of undelying asset price. The strike is monitored at each step,
+ * without the Brownian bridge correction of MCDigitalEngine, and the Greeks are estimated on the same paths as the
+ * price with likelihood-ratio estimators.
+ *
+ * @tparam DT supported data type including double and float data type, which
+ * decides the precision of result, default double-precision data type.
+ * @tparam UN number of Monte Carlo Module in parallel, which affects the
+ * latency and resources utilization, default 10.
+ * @param underlying intial value of underlying asset at time 0.
+ * @param volatility fixed volatility of underlying asset.
+ * @param dividendYield the constant dividend rate for continuous dividends.
+ * @param riskFreeRate risk-free interest rate.
+ * @param timeLength the time length of contract from start to end.
+ * @param strike the strike price also known as exericse price, which is settled
+ * in the contract.
+ * @param cashPayoff fixed payoff when option is exercised.
+ * @param exEarly exercise early or not, true: option exercise at anytime.
+ * false: option only exericse at expiry time.
+ * @param optionType option type. 1: put option, 0: call option.
+ * @param seed array to store the inital seeds for each RNG.
+ * @param greeks output array of price, delta, gamma, vega and rho, in the order of GreeksType.
+ * @param requiredTolerance the tolerance required on the price. If requiredSamples is not
+ * set, when reaching the required tolerance, simulation will stop, default
+ * 0.02.
+ * @param requiredSamples the samples number required. When reaching the
+ * required number, simulation will stop, default 1024.
+ * @param timeSteps the number of discrete steps from 0 to T, T is the expiry
+ * time, default 100.
+ * @param maxSamples the maximum sample number. When reaching it, the
+ * simulation will stop, default 2,147,483,648.
+ */
+template <typename DT = double, int UN = 10>
+void MCDigitalGreeksEngine(DT underlying,
+                           DT volatility,
+                           DT dividendYield,
+                           DT riskFreeRate,
+                           DT timeLength, // Model parameter
+                           DT strike,
+                           DT cashPayoff,
+                           bool exEarly,
+                           bool optionType, // option parameter
+                           ap_uint<32>* seed,
+                           DT* greeks,
+                           DT requiredTolerance = 0.02,
+                           unsigned int requiredSamples = 1024,
+                           unsigned int timeSteps = 100,
+                           unsigned int maxSamples = MAX_SAMPLE) {
+    // number of samples per simulation
+    const static int SN = 1024; // SampNum
+
+    // number of variate
+    const static int VN = 1; // VariateNum
+
+    // step first or sample first
+    const static bool SF = false; // StepFirst
+
+    // RNG alias.
+    typedef MT19937IcnRng<DT> RNG;
+
+    // B-S model instance
+    BSModel<DT> BSInst;
+
+    // Path generator instance.
+    BSPathGenerator<DT, SF, SN, false> pathGenInst[UN][1];
+#pragma HLS array_partition variable = pathGenInst dim = 1
+
+    // Path Pricer instance
+    GreeksPathPricer<Digital, DT, SN> pathPriInst[UN][1];
+#pragma HLS array_partition variable = pathPriInst dim = 1
+
+    // RGn sequence generator instance
+    RNGSequence<DT, RNG> rngSeqInst[UN][1];
+#pragma HLS array_partition variable = rngSeqInst dim = 1
+
+    // pre-process for "cold" logic
+    DT dt = timeLength / timeSteps;
+    DT disDt = -internal::FPTwoMul(riskFreeRate, dt);
+
+    BSInst.riskFreeRate = riskFreeRate;
+    BSInst.dividendYield = dividendYield;
+    BSInst.volatility = volatility;
+    //
+    BSInst.variance(dt);
+    BSInst.stdDeviation();
+    BSInst.updateDrift(dt);
+    // configure path generator, paht pricer and RNG sequence generator.
+    for (int i = 0; i < UN; ++i) {
+#pragma HLS unroll
+        // Path Pricer
+        pathPriInst[i][0].underlying = underlying;
+        pathPriInst[i][0].volatility = volatility;
+        pathPriInst[i][0].riskFreeRate = riskFreeRate;
+        pathPriInst[i][0].dividendYield = dividendYield;
+        pathPriInst[i][0].dt = dt;
+        pathPriInst[i][0].drift = BSInst.drift;
+        pathPriInst[i][0].stdDev = BSInst.stdDev;
+        pathPriInst[i][0].setup();
+        pathPriInst[i][0].strike = strike;
+        pathPriInst[i][0].cashPayoff = cashPayoff;
+        pathPriInst[i][0].exEarly = exEarly;
+        pathPriInst[i][0].optionType = optionType;
+        pathPriInst[i][0].disDt = disDt;
+        // Path generator
+        pathGenInst[i][0].BSInst = BSInst;
+        // RNG sequence
+        rngSeqInst[i][0].seed[0] = seed[i];
+    }
+    // Monte Carlo simulation
+    mcSimulationGreeks<DT, RNG, BSPathGenerator<DT, SF, SN, false>, GreeksPathPricer<Digital, DT, SN>,
+                       RNGSequence<DT, RNG>, UN, VN, SN>(timeSteps, maxSamples, requiredSamples, requiredTolerance,
+                                                         pathGenInst, pathPriInst, rngSeqInst, greeks);
+}
+
+/**
+ * @brief One level of the multilevel Monte Carlo estimate of an Arithmetic Asian Average Price option.
+ * The B-S model is used to describe the dynamics of underlying asset price. Level l simulates paths of
+ * baseSteps * 2^l steps, and prices each path and its coarse path of baseSteps * 2^(l-1) steps, which shares the same
+ * Brownian increments. The average includes the price at time 0 and at each step. The sum of the means of the levels
+ * 0 to L is the price on the grid of level L, and the caller chooses the number of samples of each level from the
+ * variances returned.
+ *
+ * @tparam DT supported data type including double and float data type, which
+ * decides the precision of result, default double-precision data type.
+ * @tparam UN number of Monte Carlo Module in parallel, which affects the
+ * latency and resources utilization, default 10.
+ * @param underlying intial value of underlying asset at time 0.
+ * @param volatility fixed volatility of underlying asset.
+ * @param dividendYield the constant dividend rate for continuous dividends.
+ * @param riskFreeRate risk-free interest rate.
+ * @param timeLength the time length of contract from start to end.
+ * @param strike the strike price also known as exericse price, which is settled
+ * in the contract.
+ * @param optionType option type. 1: put option, 0: call option.
+ * @param seed array to store the inital seed for each RNG.
+ * @param output output array of the mean and variance of the difference of the fine and coarse prices, the mean of
+ * the fine price and the number of samples.
+ * @param level the level, 0 for the coarsest grid without coarse path.
+ * @param baseSteps the number of steps of level 0, default 4.
+ * @param requiredSamples the samples number required, rounded up to a multiple of UN * 1024, default 1024.
+ */
+template <typename DT = double, int UN = 10>
+void MCAsianArithmeticAPMultiLevelEngine(DT underlying,
+                                         DT volatility,
+                                         DT dividendYield,
+                                         DT riskFreeRate,
+                                         DT timeLength, // Model parameter
+                                         DT strike,
+                                         bool optionType, // option parameter
+                                         ap_uint<32>* seed,
+                                         DT* output,
+                                         unsigned int level,
+                                         unsigned int baseSteps = 4,
+                                         unsigned int requiredSamples = 1024) {
+    // number of samples per simulation
+    const static int SN = 1024; // SampNum
+
+    // number of variate
+    const static int VN = 1; // VariateNum
+
+    // step first or sample first
+    const static bool SF = false; // StepFirst
+
+    // RNG alias.
+    typedef MT19937IcnRng<DT> RNG;
+
+    // B-S model instance
+    BSModel<DT> BSInst;
+
+    // Path generator instance.
+    BSPathGenerator<DT, SF, SN, false> pathGenInst[UN][1];
+#pragma HLS array_partition variable = pathGenInst dim = 1
+
+    // Path Pricer instance
+    MultiLevelPathPricer<Asian_AP, DT, SN> pathPriInst[UN][1];
+#pragma HLS array_partition variable = pathPriInst dim = 1
+
+    // RGn sequence generator instance
+    RNGSequence<DT, RNG> rngSeqInst[UN][1];
+#pragma HLS array_partition variable = rngSeqInst dim = 1
+
+    // pre-process for "cold" logic
+    unsigned int timeSteps = baseSteps << level;
+    DT dt = timeLength / timeSteps;
+    DT disDt = -internal::FPTwoMul(riskFreeRate, dt);
+
+    BSInst.riskFreeRate = riskFreeRate;
+    BSInst.dividendYield = dividendYield;
+    BSInst.volatility = volatility;
+    //
+    BSInst.variance(dt);
+    BSInst.stdDeviation();
+    BSInst.updateDrift(dt);
+    // configure path generator, paht pricer and RNG sequence generator.
+    for (int i = 0; i < UN; ++i) {
+#pragma HLS unroll
+        // Path Pricer
+        pathPriInst[i][0].underlying = underlying;
+        pathPriInst[i][0].strike = strike;
+        pathPriInst[i][0].disDt = disDt;
+        pathPriInst[i][0].optionType = optionType;
+        pathPriInst[i][0].coupled = (level > 0);
+        // Path generator
+        pathGenInst[i][0].BSInst = BSInst;
+        // RNG sequence
+        rngSeqInst[i][0].seed[0] = seed[i];
+    }
+    // Monte Carlo simulation
+    mcSimulationMultiLevel<DT, RNG, BSPathGenerator<DT, SF, SN, false>, MultiLevelPathPricer<Asian_AP, DT, SN>,
+                           RNGSequence<DT, RNG>, UN, VN, SN>(timeSteps, requiredSamples, pathGenInst, pathPriInst,
+                                                             rngSeqInst, output);
+}
+
+/**
+ * @brief One level of the multilevel Monte Carlo estimate of a Barrier option.
+ * The B-S model is used to describe the dynamics of underlying asset price. Level l simulates paths of
+ * baseSteps * 2^l steps, monitoring the barrier at each of them, and prices each path and its coarse path of
+ * baseSteps * 2^(l-1) steps, which shares the same Brownian increments. The sum of the means of the levels 0 to L is
+ * the price with the barrier monitored on the grid of level L, and the caller chooses the number of samples of each
+ * level from the variances returned.
+ *
+ * @tparam DT supported data type including double and float data type, which
+ * decides the precision of result, default double-precision data type.
+ * @tparam UN number of Monte Carlo Module in parallel, which affects the
+ * latency and resources utilization, default 10.
+ * @param underlying intial value of underlying asset at time 0.
+ * @param volatility fixed volatility of underlying asset.
+ * @param dividendYield the constant dividend rate for continuous dividends.
+ * @param riskFreeRate risk-free interest rate.
+ * @param timeLength the time length of contract from start to end.
+ * @param barrier single barrier value.
+ * @param strike the strike price also known as exericse price, which is settled
+ * in the contract.
+ * @param barrierType barrier type including: DownIn(0), DownOut(1), UpIn(2),
+ * UpOut(3).
+ * @param optionType option type. 1: put option, 0: call option.
+ * @param seed array to store the inital seeds for each RNG.
+ * @param output output array of the mean and variance of the difference of the fine and coarse prices, the mean of
+ * the fine price and the number of samples.
+ * @param rebate rebate value which is paid when the option is not triggered.
+ * @param level the level, 0 for the coarsest grid without coarse path.
+ * @param baseSteps the number of steps of level 0, default 4.
+ * @param requiredSamples the samples number required, rounded up to a multiple of UN * 1024, default 1024.
+ */
+template <typename DT = double, int UN = 10>
+void MCBarrierMultiLevelEngine(DT underlying,
+                               DT volatility,
+                               DT dividendYield,
+                               DT riskFreeRate,
+                               DT timeLength, // Model parameter
+                               DT barrier,
+                               DT strike,
+                               ap_uint<2> barrierType,
+                               bool optionType, // option parameter
+                               ap_uint<32>* seed,
+                               DT* output,
+                               DT rebate,
+                               unsigned int level,
+                               unsigned int baseSteps = 4,
+                               unsigned int requiredSamples = 1024) {
+    // number of samples per simulation
+    const static int SN = 1024; // SampNum
+
+    // number of variate
+    const static int VN = 1; // VariateNum
+
+    // step first or sample first
+    const static bool SF = false; // StepFirst
+
+    // RNG alias.
+    typedef MT19937IcnRng<DT> RNG;
+
+    // B-S model instance
+    BSModel<DT> BSInst;
+
+    // Path generator instance.
+    BSPathGenerator<DT, SF, SN, false> pathGenInst[UN][1];
+#pragma HLS array_partition variable = pathGenInst dim = 1
+
+    // Path Pricer instance
+    MultiLevelPathPricer<BarrierBiased, DT, SN> pathPriInst[UN][1];
+#pragma HLS array_partition variable = pathPriInst dim = 1
+
+    // RGn sequence generator instance
+    RNGSequence<DT, RNG> rngSeqInst[UN][1];
+#pragma HLS array_partition variable = rngSeqInst dim = 1
+
+    // pre-process for "cold" logic
+    unsigned int timeSteps = baseSteps << level;
+    DT dt = timeLength / timeSteps;
+    DT disDt = -internal::FPTwoMul(riskFreeRate, dt);
+
+    BSInst.riskFreeRate = riskFreeRate;
+    BSInst.dividendYield = dividendYield;
+    BSInst.volatility = volatility;
+    //
+    BSInst.variance(dt);
+    BSInst.stdDeviation();
+    BSInst.updateDrift(dt);
+    // configure path generator, paht pricer and RNG sequence generator.
+    for (int i = 0; i < UN; ++i) {
+#pragma HLS unroll
+        // Path Pricer
+        pathPriInst[i][0].underlying = underlying;
+        pathPriInst[i][0].strike = strike;
+        pathPriInst[i][0].disDt = disDt;
+        pathPriInst[i][0].optionType = optionType;
+        pathPriInst[i][0].coupled = (level > 0);
+        pathPriInst[i][0].barrier = barrier;
+        pathPriInst[i][0].rebate = rebate;
+        pathPriInst[i][0].barrierType = BarrierType(int(barrierType));
+        // Path generator
+        pathGenInst[i][0].BSInst = BSInst;
+        // RNG sequence
+        rngSeqInst[i][0].seed[0] = seed[i];
+    }
+    // Monte Carlo simulation
+    mcSimulationMultiLevel<DT, RNG, BSPathGenerator<DT, SF, SN, false>, MultiLevelPathPricer<BarrierBiased, DT, SN>,
+                           RNGSequence<DT, RNG>, UN, VN, SN>(timeSteps, requiredSamples, pathGenInst, pathPriInst,
+                                                             rngSeqInst, output);
+}
+
+/**
+ * @brief European Option Pricing Engine using randomized quasi-Monte Carlo Method. The B-S model is used to describe
+ * the dynamics of the underlying asset price.
+ *
+ * The payoff only depends on the price at expiry, so each path is simulated in one step from one number of a
+ * scrambled sobol sequence. The simulation is repeated for a number of independent scramblings of the sequence, and
+ * the spread of their prices gives the standard error of the price, which decreases close to 1 / requiredSamples,
+ * instead of 1 / sqrt(requiredSamples) with pseudo-random numbers.
+ *
+ * @tparam DT supported data type including double and float data type, which
+ * decides the precision of result, default double-precision data type.
+ * @tparam UN number of Monte Carlo Module in parallel, which affects the
+ * latency and resources utilization, default 2.
+ * @param underlying intial value of underlying asset at time 0.
+ * @param volatility fixed volatility of underlying asset.
+ * @param dividendYield the constant dividend rate for continuous dividends.
+ * @param riskFreeRate risk-free interest rate.
+ * @param timeLength the time length of contract from start to end.
+ * @param strike the strike price also known as exericse price, which is settled
+ * in the contract.
+ * @param optionType option type. 1: put option, 0: call option.
+ * @param seed the seed of the scrambling of the first replication, replication r uses seed + r.
+ * @param output output array of the price and its standard error.
+ * @param requiredSamples the samples number of each replication, rounded up to a multiple of UN * 1024, best a
+ * power of 2, default 4096.
+ * @param replications the number of independent scramblings, default 16.
+ */
+template <typename DT = double, int UN = 2>
+void MCEuropeanQMCEngine(DT underlying,
+                         DT volatility,
+                         DT dividendYield,
+                         DT riskFreeRate, // model parameter
+                         DT timeLength,
+                         DT strike,
+                         bool optionType, // option parameter
+                         ap_uint<32> seed,
+                         DT* output,
+                         unsigned int requiredSamples = 4096,
+                         unsigned int replications = 16) {
+    // number of samples per simulation
+    const static int SN = 1024;
+
+    // number of time steps
+    const static int TS = 1;
+
+    // number of variate
+    const static int VN = 1;
+
+    // Step first or sample first for each simulation
+    const static bool SF = true;
+
+    // option style
+    const OptionStyle sty = European;
+
+    // RNG alias name
+    typedef SobolIcnRng<DT, TS> RNG;
+
+    // RNG sequence alias name
+    typedef SobolBridgeSequence<DT, RNG, SN, TS, SF> RNGSeq;
+
+    BSModel<DT> BSInst;
+
+    // path generator instance
+    BSPathGenerator<DT, SF, SN, false> pathGenInst[UN][1];
+#pragma HLS array_partition variable = pathGenInst dim = 1
+
+    // path pricer instance
+    PathPricer<sty, DT, SF, SN, false> pathPriInst[UN][1];
+#pragma HLS array_partition variable = pathPriInst dim = 1
+
+    // RNG sequence instance
+    RNGSeq rngSeqInst[UN][1];
+#pragma HLS array_partition variable = rngSeqInst dim = 1
+
+    // pre-process for "cold" logic.
+    DT f_1 = internal::FPTwoMul(riskFreeRate, timeLength);
+    DT discount = internal::FPExp(-f_1);
+
+    BSInst.riskFreeRate = riskFreeRate;
+    BSInst.dividendYield = dividendYield;
+    BSInst.volatility = volatility;
+    //
+    BSInst.variance(timeLength);
+    BSInst.stdDeviation();
+    BSInst.updateDrift(timeLength);
+
+    // configure the path generator and path pricer
+    for (int i = 0; i < UN; ++i) {
+#pragma HLS unroll
+        // Path generator
+        pathPriInst[i][0].optionType = optionType;
+        pathPriInst[i][0].strike = strike;
+        pathPriInst[i][0].underlying = underlying;
+        pathPriInst[i][0].discount = discount;
+        // Path pricer
+        pathGenInst[i][0].BSInst = BSInst;
+        // RNGSequnce
+        rngSeqInst[i][0].unitId = i;
+        rngSeqInst[i][0].unitNum = UN;
+    }
+
+    // call randomized quasi-Monte Carlo simulation
+    mcSimulationQMC<DT, RNG, BSPathGenerator<DT, SF, SN, false>, PathPricer<sty, DT, SF, SN, false>, RNGSeq, UN, VN,
+                    SN>(TS, requiredSamples, replications, seed, pathGenInst, pathPriInst, rngSeqInst, output);
+}
+
+/**
+ * @brief Asian Arithmetic Average Price Engine using randomized quasi-Monte Carlo Method Based on Black-Scholes
+ * Model.
+ *
+ * The paths are built from a scrambled sobol sequence by a Brownian bridge, and the geometric average price option is
+ * used as control variate, as in MCAsianArithmeticAPEngine. The simulation is repeated for a number of independent
+ * scramblings of the sequence, and the spread of their prices gives the standard error of the price.
+ *
+ * @tparam DT Supported data type including double and float, which decides the
+ * precision of output.
+ * @tparam UN The number of Monte Carlo Module in parallel, which affects the
+ * latency and resources utilization, default 2.
+ * @tparam MaxSteps maximum number of time steps, which is the dimension of the sobol sequence, maximum is 128,
+ * default 64.
+ * @param underlying The initial price of underlying asset.
+ * @param volatility The market's price volatility.
+ * @param dividendYield The dividend yield is the company's total annual
+ * dividend payments divided by its market capitalization, or the dividend per
+ * share, divided by the price per share.
+ * @param riskFreeRate The risk-free interest rate is the rate of return of a
+ * hypothetical investment with no risk of financial loss, over a given period
+ * of time.
+ * @param timeLength The given period of time.
+ * @param strike The strike price also known as exericse price, which is settled
+ * in the contract.
+ * @param optionType Option type. 1: put option, 0: call option.
+ * @param seed the seed of the scrambling of the first replication, replication r uses seed + r.
+ * @param output Output array of the price and its standard error.
+ * @param requiredSamples the samples number of each replication, rounded up to a multiple of UN * 256, best a power
+ * of 2, default 4096.
+ * @param timeSteps Number of interval, default 16.
+ * @param replications the number of independent scramblings, default 16.
+ */
+template <typename DT = double, int UN = 2, int MaxSteps = 64>
+void MCAsianArithmeticAPQMCEngine(DT underlying,
+                                  DT volatility,
+                                  DT dividendYield,
+                                  DT riskFreeRate, // process
+                                  DT timeLength,
+                                  DT strike,
+                                  bool optionType, // option
+                                  ap_uint<32> seed,
+                                  DT* output,
+                                  unsigned int requiredSamples = 4096,
+                                  unsigned int timeSteps = 16,
+                                  unsigned int replications = 16) {
+    // Number of Samples per simulation, the sequence buffers MaxSteps * SN numbers
+    const static int SN = 256; // SampNum
+
+    // Number of Variate
+    const static int VN = 1; // VariateNum
+
+    // Step first or Sample first
+    const static bool SF = false; // StepFirst
+
+    // RNG alias
+    typedef SobolIcnRng<DT, MaxSteps> RNG;
+
+    // RNG sequence alias
+    typedef SobolBridgeSequence<DT, RNG, SN, MaxSteps, SF> RNGSeq;
+
+    // Define Asian Average Strike option type
+    const OptionStyle sty = Asian_AP;
+
+    // B-S model instance
+    BSModel<DT> BSInst;
+
+    // Path generator instance
+    BSPathGenerator<DT, SF, SN, false> pathGenInst[UN][1];
+#pragma HLS array_partition variable = pathGenInst dim = 1
+
+    // Path pricer instance
+    PathPricer<sty, DT, SF, SN, false> pathPriInst[UN][1];
+#pragma HLS array_partition variable = pathPriInst dim = 1
+
+    // RNG sequence Instance
+    RNGSeq rngSeqInst[UN][1];
+#pragma HLS array_partition variable = rngSeqInst dim = 1
+
+    // Pre-process of "cold" logic
+    DT dt = timeLength / ((DT)timeSteps);
+    DT tmpExp = internal::FPTwoMul(riskFreeRate, timeLength);
+    DT discount = hls::exp(-tmpExp);
+
+    BSInst.riskFreeRate = riskFreeRate;
+    BSInst.dividendYield = dividendYield;
+    BSInst.volatility = volatility;
+
+    BSInst.variance(dt);
+    BSInst.stdDeviation();
+    BSInst.updateDrift(dt);
+    // Configure path generator,path pricer and RNG sequence.
+    for (int i = 0; i < UN; ++i) {
+#pragma HLS unroll
+        // Path Pricer
+        pathPriInst[i][0].optionType = optionType;
+        pathPriInst[i][0].underlying = underlying;
+        pathPriInst[i][0].strike = strike;
+        pathPriInst[i][0].discount = discount;
+        pathPriInst[i][0].dt = dt;
+
+        // Path Generator
+        pathGenInst[i][0].BSInst = BSInst;
+
+        // RNG Sequence
+        rngSeqInst[i][0].unitId = i;
+        rngSeqInst[i][0].unitNum = UN;
+    }
+
+    mcSimulationQMC<DT, RNG, BSPathGenerator<DT, SF, SN, false>, PathPricer<sty, DT, SF, SN, false>, RNGSeq, UN, VN,
+                    SN>(timeSteps, requiredSamples, replications, seed, pathGenInst, pathPriInst, rngSeqInst, output);
+
+    // Control variate price ref
+    DT priceRef = internal::asianGeometricAPPrice<DT>(underlying, volatility, dividendYield, riskFreeRate, timeLength,
+                                                      strike, optionType, timeSteps, discount);
+    // output result
+    output[0] += priceRef;
+}
+
+/**
+ * @brief Barrier Option Pricing Engine using randomized quasi-Monte Carlo Simulation.
+ *
+ * The paths are built from a scrambled sobol sequence by a Brownian bridge, and the barrier is monitored at each
+ * step, as in MCBarrierEngine. The simulation is repeated for a number of independent scramblings of the sequence,
+ * and the spread of their prices gives the standard error of the price. The payoff is discontinuous at the barrier,
+ * so the error decreases slower than for smooth payoffs, but still faster than with pseudo-random numbers.
+ *
+ * @tparam DT supported data type including double and float data type, which
+ * decides the precision of result, default double-precision data type.
+ * @tparam UN number of Monte Carlo Module in parallel, which affects the
+ * latency and resources utilization, default 2.
+ * @tparam MaxSteps maximum number of time steps, which is the dimension of the sobol sequence, maximum is 128,
+ * default 64.
+ * @param underlying intial value of underlying asset at time 0.
+ * @param volatility fixed volatility of underlying asset.
+ * @param dividendYield the constant dividend rate for continuous dividends.
+ * @param riskFreeRate risk-free interest rate.
+ * @param timeLength the time length of contract from start to end.
+ * @param barrier single barrier value.
+ * @param strike the strike price also known as exericse price, which is settled
+ * in the contract.
+ * @param barrierType barrier type including: DownIn(0), DownOut(1), UpIn(2),
+ * UpOut(3).
+ * @param optionType option type. 1: put option, 0: call option.
+ * @param seed the seed of the scrambling of the first replication, replication r uses seed + r.
+ * @param output output array of the price and its standard error.
+ * @param rebate rebate value which is paid when the option is not triggered,
+ * default 0.
+ * @param requiredSamples the samples number of each replication, rounded up to a multiple of UN * 256, best a power
+ * of 2, default 4096.
+ * @param timeSteps the number of discrete steps from 0 to T, T is the expiry
+ * time, default 16.
+ * @param replications the number of independent scramblings, default 16.
+ */
+template <typename DT = double, int UN = 2, int MaxSteps = 64>
+void MCBarrierQMCEngine(DT underlying,
+                        DT volatility,
+                        DT dividendYield,
+                        DT riskFreeRate,
+                        DT timeLength, // Model parameter
+                        DT barrier,
+                        DT strike,
+                        ap_uint<2> barrierType,
+                        bool optionType, // option parameter
+                        ap_uint<32> seed,
+                        DT* output,
+                        DT rebate = 0,
+                        unsigned int requiredSamples = 4096,
+                        unsigned int timeSteps = 16,
+                        unsigned int replications = 16) {
+    // number of samples per simulation, the sequence buffers MaxSteps * SN numbers
+    const static int SN = 256; // SampNum
+
+    // number of variate
+    const static int VN = 1; // VariateNum
+
+    // step first or sample first
+    const static bool SF = false; // StepFirst
+
+    // RNG alias.
+    typedef SobolIcnRng<DT, MaxSteps> RNG;
+
+    // RNG sequence alias.
+    typedef SobolBridgeSequence<DT, RNG, SN, MaxSteps, SF> RNGSeq;
+
+    // B-S model instance
+    BSModel<DT> BSInst;
+
+    // Path generator instance.
+    BSPathGenerator<DT, SF, SN, false> pathGenInst[UN][1];
+#pragma HLS array_partition variable = pathGenInst dim = 1
+
+    // Path Pricer instance
+    PathPricer<BarrierBiased, DT, SF, SN, false> pathPriInst[UN][1];
+#pragma HLS array_partition variable = pathPriInst dim = 1
+
+    // RNG sequence generator instance
+    RNGSeq rngSeqInst[UN][1];
+#pragma HLS array_partition variable = rngSeqInst dim = 1
+
+    // pre-process for "cold" logic
+    DT dt = timeLength / timeSteps;
+    DT disDt = -internal::FPTwoMul(riskFreeRate, dt);
+
+    BSInst.riskFreeRate = riskFreeRate;
+    BSInst.dividendYield = dividendYield;
+    BSInst.volatility = volatility;
+    //
+    BSInst.variance(dt);
+    BSInst.stdDeviation();
+    BSInst.updateDrift(dt);
+    // configure path generator, paht pricer and RNG sequence generator.
+    for (int i = 0; i < UN; ++i) {
+#pragma HLS unroll
+        // Path Pricer
+        pathPriInst[i][0].underlying = underlying;
+        pathPriInst[i][0].barrier = barrier;
+        pathPriInst[i][0].strike = strike;
+        pathPriInst[i][0].rebate = rebate;
+        pathPriInst[i][0].optionType = optionType;
+        pathPriInst[i][0].disDt = disDt;
+        pathPriInst[i][0].barrierType = BarrierType(int(barrierType));
+        // Path generator
+        pathGenInst[i][0].BSInst = BSInst;
+        // RNG sequence
+        rngSeqInst[i][0].unitId = i;
+        rngSeqInst[i][0].unitNum = UN;
+    }
+    // randomized quasi-Monte Carlo simulation
+    mcSimulationQMC<DT, RNG, BSPathGenerator<DT, SF, SN, false>, PathPricer<BarrierBiased, DT, SF, SN, false>, RNGSeq,
+                    UN, VN, SN>(timeSteps, requiredSamples, replications, seed, pathGenInst, pathPriInst, rngSeqInst,
+                                output);
+}
+
 /**
  * @brief Cap/Floor Pricing Engine using Monte Carlo Simulation.
  * The Hull-White model is used to describe dynamics of short-term interest.
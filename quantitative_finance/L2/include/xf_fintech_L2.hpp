@@ -32,6 +32,7 @@
 #include "xf_fintech/inflation_capfloor_engine.hpp"
 #include "xf_fintech/fd_solver.hpp"
 #include "xf_fintech/pop_mcmc.hpp"
+#include "xf_fintech/exposure_engine.hpp"
 
 #endif // define XF_FINTECH_L2_H
 
@@ -0,0 +1,212 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+* @file iv_test.cpp
+* @brief Testbench to generate randomized premiums from a full precision model and
+* launch on the implied volatility kernel. The volatilities are compared to the ones
+* used to generate the premiums.
+*/
+
+#include <stdio.h>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "bsm_model.hpp"
+#include "xcl2.hpp"
+
+/// @def Controls the data type used in the kernel
+#define KERNEL_DT float
+
+/// @def Options whose vega (per 1% volatility) is below this are not compared, their premium does not hold
+/// enough digits in KERNEL_DT to recover the volatility
+#define MIN_VEGA 0.01
+
+// Temporary copy of this macro definition until new xcl2.hpp is used
+#define OCL_CHECK(error, call)                                                                   \
+    call;                                                                                        \
+    if (error != CL_SUCCESS) {                                                                   \
+        printf("%s:%d Error calling " #call ", error code is: %d\n", __FILE__, __LINE__, error); \
+        exit(EXIT_FAILURE);                                                                      \
+    }
+
+/// @brief Main entry point to test
+///
+/// This is a command-line application to test the kernel.  It supports software
+/// and hardware emulation as well as
+/// running on an Alveo target.
+///
+/// Usage: ./iv_test ./xclbin/<kernel_name> <number of premiums>
+///
+/// @param[in] argc Standard C++ argument count
+/// @param[in] argv Standard C++ input arguments
+int main(int argc, char* argv[]) {
+    std::cout << std::endl << std::endl;
+    std::cout << "************" << std::endl;
+    std::cout << "IV Demo v1.0" << std::endl;
+    std::cout << "************" << std::endl;
+    std::cout << std::endl;
+
+    // Test parameters
+    static const unsigned int call = 1;
+
+    unsigned int argIdx = 1;
+    std::string xclbin_file(argv[argIdx++]);
+    unsigned int num = std::atoi(argv[argIdx++]);
+
+    // Vectors for parameter storage.  These use an aligned allocator in order
+    // to avoid an additional copy of the host memory into the device
+    std::vector<KERNEL_DT, aligned_allocator<KERNEL_DT> > s(num);
+    std::vector<KERNEL_DT, aligned_allocator<KERNEL_DT> > price(num);
+    std::vector<KERNEL_DT, aligned_allocator<KERNEL_DT> > r(num);
+    std::vector<KERNEL_DT, aligned_allocator<KERNEL_DT> > t(num);
+    std::vector<KERNEL_DT, aligned_allocator<KERNEL_DT> > k(num);
+    std::vector<KERNEL_DT, aligned_allocator<KERNEL_DT> > q(num);
+    std::vector<KERNEL_DT, aligned_allocator<KERNEL_DT> > v(num);
+
+    // Host volatilities and vegas (always double precision)
+    double* host_v = new double[num];
+    double* host_vega = new double[num];
+
+    // Generate randomized volatilities and the premiums to invert
+    std::cout << "Generating randomized data and reference premiums..." << std::endl;
+    for (unsigned int i = 0; i < num; i++) {
+        double s_temp = random_range(10, 200);
+        double v_temp = random_range(0.1, 1.0);
+        double r_temp = random_range(0.001, 0.2);
+        double t_temp = random_range(0.5, 3);
+        double k_temp = s_temp * random_range(0.5, 1.5);
+        double q_temp = random_range(0.0, 0.05);
+        double price_temp, delta_temp, gamma_temp, theta_temp, rho_temp;
+
+        bsm_model(s_temp, v_temp, r_temp, t_temp, k_temp, q_temp, call, price_temp, delta_temp, gamma_temp,
+                  host_vega[i], theta_temp, rho_temp);
+
+        s[i] = s_temp;
+        price[i] = price_temp;
+        r[i] = r_temp;
+        t[i] = t_temp;
+        k[i] = k_temp;
+        q[i] = q_temp;
+        host_v[i] = v_temp;
+    }
+
+    // OPENCL HOST CODE AREA START
+    // get_xil_devices() is a utility API which will find the xilinx
+    // platforms and will return list of devices connected to Xilinx platform
+    std::cout << "Connecting to device and loading kernel..." << std::endl;
+    std::vector<cl::Device> devices = xcl::get_xil_devices();
+    cl::Device device = devices[0];
+    cl_int err;
+
+    OCL_CHECK(err, cl::Context context(device, NULL, NULL, NULL, &err));
+    OCL_CHECK(err, cl::CommandQueue cq(context, device, CL_QUEUE_PROFILING_ENABLE, &err));
+
+    // Load the binary file (using function from xcl2.cpp)
+    cl::Program::Binaries bins = xcl::import_binary_file(xclbin_file);
+
+    devices.resize(1);
+    OCL_CHECK(err, cl::Program program(context, devices, bins, NULL, &err));
+    OCL_CHECK(err, cl::Kernel krnl_cfBSMImpliedVolEngine(program, "iv_kernel", &err));
+
+    // Allocate Buffer in Global Memory
+    // Buffers are allocated using CL_MEM_USE_HOST_PTR for efficient memory and
+    // Device-to-host communication
+    std::cout << "Allocating buffers..." << std::endl;
+    OCL_CHECK(err, cl::Buffer buffer_s(context, CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY, num * sizeof(KERNEL_DT),
+                                       s.data(), &err));
+    OCL_CHECK(err, cl::Buffer buffer_price(context, CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY, num * sizeof(KERNEL_DT),
+                                           price.data(), &err));
+    OCL_CHECK(err, cl::Buffer buffer_r(context, CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY, num * sizeof(KERNEL_DT),
+                                       r.data(), &err));
+    OCL_CHECK(err, cl::Buffer buffer_t(context, CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY, num * sizeof(KERNEL_DT),
+                                       t.data(), &err));
+    OCL_CHECK(err, cl::Buffer buffer_k(context, CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY, num * sizeof(KERNEL_DT),
+                                       k.data(), &err));
+    OCL_CHECK(err, cl::Buffer buffer_q(context, CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY, num * sizeof(KERNEL_DT),
+                                       q.data(), &err));
+    OCL_CHECK(err, cl::Buffer buffer_v(context, CL_MEM_USE_HOST_PTR | CL_MEM_WRITE_ONLY, num * sizeof(KERNEL_DT),
+                                       v.data(), &err));
+
+    // Set the arguments
+    OCL_CHECK(err, err = krnl_cfBSMImpliedVolEngine.setArg(0, buffer_s));
+    OCL_CHECK(err, err = krnl_cfBSMImpliedVolEngine.setArg(1, buffer_price));
+    OCL_CHECK(err, err = krnl_cfBSMImpliedVolEngine.setArg(2, buffer_r));
+    OCL_CHECK(err, err = krnl_cfBSMImpliedVolEngine.setArg(3, buffer_t));
+    OCL_CHECK(err, err = krnl_cfBSMImpliedVolEngine.setArg(4, buffer_k));
+    OCL_CHECK(err, err = krnl_cfBSMImpliedVolEngine.setArg(5, buffer_q));
+    OCL_CHECK(err, err = krnl_cfBSMImpliedVolEngine.setArg(6, call));
+    OCL_CHECK(err, err = krnl_cfBSMImpliedVolEngine.setArg(7, num));
+    OCL_CHECK(err, err = krnl_cfBSMImpliedVolEngine.setArg(8, buffer_v));
+
+    // Copy input data to device global memory
+    OCL_CHECK(err, err = cq.enqueueMigrateMemObjects({buffer_s}, 0));
+    OCL_CHECK(err, err = cq.enqueueMigrateMemObjects({buffer_price}, 0));
+    OCL_CHECK(err, err = cq.enqueueMigrateMemObjects({buffer_r}, 0));
+    OCL_CHECK(err, err = cq.enqueueMigrateMemObjects({buffer_t}, 0));
+    OCL_CHECK(err, err = cq.enqueueMigrateMemObjects({buffer_k}, 0));
+    OCL_CHECK(err, err = cq.enqueueMigrateMemObjects({buffer_q}, 0));
+
+    // Launch the Kernel
+    std::cout << "Launching kernel..." << std::endl;
+    uint64_t nstimestart, nstimeend;
+    cl::Event event;
+    OCL_CHECK(err, err = cq.enqueueTask(krnl_cfBSMImpliedVolEngine, NULL, &event));
+    OCL_CHECK(err, err = cq.finish());
+    OCL_CHECK(err, err = event.getProfilingInfo<uint64_t>(CL_PROFILING_COMMAND_START, &nstimestart));
+    OCL_CHECK(err, err = event.getProfilingInfo<uint64_t>(CL_PROFILING_COMMAND_END, &nstimeend));
+    auto duration_nanosec = nstimeend - nstimestart;
+    std::cout << "  Duration returned by profile API is " << (duration_nanosec * (1.0e-6)) << " ms **** " << std::endl;
+
+    // Copy Result from Device Global Memory to Host Local Memory
+    OCL_CHECK(err, err = cq.enqueueMigrateMemObjects({buffer_v}, CL_MIGRATE_MEM_OBJECT_HOST));
+    cq.finish();
+    // OPENCL HOST CODE AREA END
+
+    // Check results
+    double max_v_diff = 0.0f;
+    unsigned int num_compared = 0;
+
+    for (unsigned int i = 0; i < num; i++) {
+        double temp = 0.0f;
+        if (host_vega[i] < MIN_VEGA) continue;
+        num_compared++;
+        if (std::abs(temp = (v[i] - host_v[i])) > std::abs(max_v_diff)) max_v_diff = temp;
+    }
+
+    std::cout << "Kernel done!" << std::endl;
+    std::cout << "Comparing results..." << std::endl;
+    std::cout << "Processed " << num;
+    if (call) {
+        std::cout << " call premiums:" << std::endl;
+    } else {
+        std::cout << " put premiums:" << std::endl;
+    }
+    std::cout << "Throughput = " << (1.0 * num) / (duration_nanosec * 1.0e-9) / 1.0e6 << " Mega options/sec"
+              << std::endl;
+
+    std::cout << std::endl;
+    std::cout << "  Compared " << num_compared << " options with vega above " << MIN_VEGA << std::endl;
+    std::cout << "  Largest host-kernel volatility difference = " << max_v_diff << std::endl;
+
+    delete[] host_v;
+    delete[] host_vega;
+
+    return 0;
+}
@@ -0,0 +1,226 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+* @file portfolio_test.cpp
+* @brief Testbench to generate a randomized portfolio of trades, price all of them
+* on the portfolio kernel, then move one spot price and reprice only the trades
+* on that underlying. Both runs are compared to a full precision model.
+*/
+
+#include <stdio.h>
+#include <cstring>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "bsm_model.hpp"
+#include "xcl2.hpp"
+
+/// @def Controls the data type used in the kernel
+#define KERNEL_DT float
+
+/// @def Number of 32 bit fields of a trade or result word
+#define WORD_FIELDS 8
+
+/// @def Number of underlyings of the portfolio, each has its own spot and volatility
+#define NUM_UNDERLYINGS 64
+
+// Temporary copy of this macro definition until new xcl2.hpp is used
+#define OCL_CHECK(error, call)                                                                   \
+    call;                                                                                        \
+    if (error != CL_SUCCESS) {                                                                   \
+        printf("%s:%d Error calling " #call ", error code is: %d\n", __FILE__, __LINE__, error); \
+        exit(EXIT_FAILURE);                                                                      \
+    }
+
+/// @brief Largest difference between the kernel prices of the listed trades and the full precision model
+double compare(const std::vector<uint32_t, aligned_allocator<uint32_t> >& trades,
+               const std::vector<KERNEL_DT, aligned_allocator<KERNEL_DT> >& s,
+               const std::vector<KERNEL_DT, aligned_allocator<KERNEL_DT> >& v,
+               const std::vector<KERNEL_DT, aligned_allocator<KERNEL_DT> >& r,
+               const std::vector<uint32_t, aligned_allocator<uint32_t> >& dirty,
+               const std::vector<KERNEL_DT, aligned_allocator<KERNEL_DT> >& results,
+               unsigned int num) {
+    double max_price_diff = 0.0f;
+    for (unsigned int i = 0; i < num; i++) {
+        const uint32_t* trade = &trades[dirty[i] * WORD_FIELDS];
+        KERNEL_DT k, t;
+        std::memcpy(&k, &trade[4], sizeof(k));
+        std::memcpy(&t, &trade[5], sizeof(t));
+        double price, delta, gamma, vega, theta, rho;
+        bsm_model(s[trade[0]], v[trade[1]], r[trade[2]], t, k, 0, trade[3], price, delta, gamma, vega, theta, rho);
+        double temp = results[i * WORD_FIELDS] - price;
+        if (std::abs(temp) > std::abs(max_price_diff)) max_price_diff = temp;
+    }
+    return max_price_diff;
+}
+
+/// @brief Main entry point to test
+///
+/// This is a command-line application to test the kernel.  It supports software
+/// and hardware emulation as well as
+/// running on an Alveo target.
+///
+/// Usage: ./portfolio_test ./xclbin/<kernel_name> <number of trades>
+///
+/// @param[in] argc Standard C++ argument count
+/// @param[in] argv Standard C++ input arguments
+int main(int argc, char* argv[]) {
+    std::cout << std::endl << std::endl;
+    std::cout << "*******************" << std::endl;
+    std::cout << "Portfolio Demo v1.0" << std::endl;
+    std::cout << "*******************" << std::endl;
+    std::cout << std::endl;
+
+    unsigned int argIdx = 1;
+    std::string xclbin_file(argv[argIdx++]);
+    unsigned int num = std::atoi(argv[argIdx++]);
+    unsigned int num_market = NUM_UNDERLYINGS;
+
+    // Vectors for parameter storage.  These use an aligned allocator in order
+    // to avoid an additional copy of the host memory into the device
+    std::vector<uint32_t, aligned_allocator<uint32_t> > trades(num * WORD_FIELDS);
+    std::vector<KERNEL_DT, aligned_allocator<KERNEL_DT> > s(num_market);
+    std::vector<KERNEL_DT, aligned_allocator<KERNEL_DT> > v(num_market);
+    std::vector<KERNEL_DT, aligned_allocator<KERNEL_DT> > r(num_market);
+    std::vector<uint32_t, aligned_allocator<uint32_t> > dirty(num);
+    std::vector<KERNEL_DT, aligned_allocator<KERNEL_DT> > results(num * WORD_FIELDS);
+
+    // Generate the market, one rate for all the trades, and the trades on random underlyings
+    std::cout << "Generating randomized portfolio..." << std::endl;
+    for (unsigned int i = 0; i < num_market; i++) {
+        s[i] = random_range(10, 200);
+        v[i] = random_range(0.1, 1.0);
+        r[i] = random_range(0.001, 0.2);
+    }
+    for (unsigned int i = 0; i < num; i++) {
+        uint32_t* trade = &trades[i * WORD_FIELDS];
+        unsigned int underlying = (unsigned int)random_range(0, num_market) % num_market;
+        KERNEL_DT k = s[underlying] * random_range(0.5, 1.5);
+        KERNEL_DT t = random_range(0.5, 3);
+        trade[0] = underlying;
+        trade[1] = underlying;
+        trade[2] = 0;
+        trade[3] = (random_range(0, 1) < 0.5);
+        std::memcpy(&trade[4], &k, sizeof(k));
+        std::memcpy(&trade[5], &t, sizeof(t));
+        trade[6] = 0;
+        trade[7] = 0;
+        dirty[i] = i;
+    }
+
+    // OPENCL HOST CODE AREA START
+    // get_xil_devices() is a utility API which will find the xilinx
+    // platforms and will return list of devices connected to Xilinx platform
+    std::cout << "Connecting to device and loading kernel..." << std::endl;
+    std::vector<cl::Device> devices = xcl::get_xil_devices();
+    cl::Device device = devices[0];
+    cl_int err;
+
+    OCL_CHECK(err, cl::Context context(device, NULL, NULL, NULL, &err));
+    OCL_CHECK(err, cl::CommandQueue cq(context, device, CL_QUEUE_PROFILING_ENABLE, &err));
+
+    // Load the binary file (using function from xcl2.cpp)
+    cl::Program::Binaries bins = xcl::import_binary_file(xclbin_file);
+
+    devices.resize(1);
+    OCL_CHECK(err, cl::Program program(context, devices, bins, NULL, &err));
+    OCL_CHECK(err, cl::Kernel krnl_portfolio(program, "bs_portfolio_kernel", &err));
+
+    // Allocate Buffer in Global Memory
+    // Buffers are allocated using CL_MEM_USE_HOST_PTR for efficient memory and
+    // Device-to-host communication
+    std::cout << "Allocating buffers..." << std::endl;
+    OCL_CHECK(err, cl::Buffer buffer_trades(context, CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY,
+                                            num * WORD_FIELDS * sizeof(uint32_t), trades.data(), &err));
+    OCL_CHECK(err, cl::Buffer buffer_s(context, CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY,
+                                       num_market * sizeof(KERNEL_DT), s.data(), &err));
+    OCL_CHECK(err, cl::Buffer buffer_v(context, CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY,
+                                       num_market * sizeof(KERNEL_DT), v.data(), &err));
+    OCL_CHECK(err, cl::Buffer buffer_r(context, CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY,
+                                       num_market * sizeof(KERNEL_DT), r.data(), &err));
+    OCL_CHECK(err, cl::Buffer buffer_dirty(context, CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY, num * sizeof(uint32_t),
+                                           dirty.data(), &err));
+    OCL_CHECK(err, cl::Buffer buffer_results(context, CL_MEM_USE_HOST_PTR | CL_MEM_WRITE_ONLY,
+                                             num * WORD_FIELDS * sizeof(KERNEL_DT), results.data(), &err));
+
+    // Set the arguments
+    OCL_CHECK(err, err = krnl_portfolio.setArg(0, buffer_trades));
+    OCL_CHECK(err, err = krnl_portfolio.setArg(1, buffer_s));
+    OCL_CHECK(err, err = krnl_portfolio.setArg(2, buffer_v));
+    OCL_CHECK(err, err = krnl_portfolio.setArg(3, buffer_r));
+    OCL_CHECK(err, err = krnl_portfolio.setArg(4, num_market));
+    OCL_CHECK(err, err = krnl_portfolio.setArg(5, buffer_dirty));
+    OCL_CHECK(err, err = krnl_portfolio.setArg(6, num));
+    OCL_CHECK(err, err = krnl_portfolio.setArg(7, buffer_results));
+
+    // Copy the whole portfolio to device global memory, once
+    OCL_CHECK(err, err = cq.enqueueMigrateMemObjects({buffer_trades, buffer_s, buffer_v, buffer_r, buffer_dirty}, 0));
+
+    // Price all the trades
+    std::cout << "Launching kernel on the whole portfolio..." << std::endl;
+    uint64_t nstimestart, nstimeend;
+    cl::Event event;
+    OCL_CHECK(err, err = cq.enqueueTask(krnl_portfolio, NULL, &event));
+    OCL_CHECK(err, err = cq.finish());
+    OCL_CHECK(err, err = event.getProfilingInfo<uint64_t>(CL_PROFILING_COMMAND_START, &nstimestart));
+    OCL_CHECK(err, err = event.getProfilingInfo<uint64_t>(CL_PROFILING_COMMAND_END, &nstimeend));
+    auto full_nanosec = nstimeend - nstimestart;
+    OCL_CHECK(err, err = cq.enqueueMigrateMemObjects({buffer_results}, CL_MIGRATE_MEM_OBJECT_HOST));
+    cq.finish();
+    double full_diff = compare(trades, s, v, r, dirty, results, num);
+
+    // Move one spot price, only that price and the list of the trades on the underlying are copied, and only
+    // these trades are read and priced by the kernel
+    unsigned int moved = 5 % num_market;
+    s[moved] *= 1.01f;
+    unsigned int num_dirty = 0;
+    uint64_t tick_nanosec = 0;
+    for (unsigned int i = 0; i < num; i++) {
+        if (trades[i * WORD_FIELDS] == moved) dirty[num_dirty++] = i;
+    }
+    if (num_dirty > 0) {
+        std::cout << "Launching kernel on the " << num_dirty << " trades of underlying " << moved << "..."
+                  << std::endl;
+        OCL_CHECK(err, err = cq.enqueueWriteBuffer(buffer_s, CL_FALSE, moved * sizeof(KERNEL_DT), sizeof(KERNEL_DT),
+                                                   &s[moved]));
+        OCL_CHECK(err, err = cq.enqueueWriteBuffer(buffer_dirty, CL_FALSE, 0, num_dirty * sizeof(uint32_t),
+                                                   dirty.data()));
+        OCL_CHECK(err, err = krnl_portfolio.setArg(6, num_dirty));
+        OCL_CHECK(err, err = cq.enqueueTask(krnl_portfolio, NULL, &event));
+        OCL_CHECK(err, err = cq.finish());
+        OCL_CHECK(err, err = event.getProfilingInfo<uint64_t>(CL_PROFILING_COMMAND_START, &nstimestart));
+        OCL_CHECK(err, err = event.getProfilingInfo<uint64_t>(CL_PROFILING_COMMAND_END, &nstimeend));
+        OCL_CHECK(err, err = cq.enqueueReadBuffer(buffer_results, CL_TRUE, 0,
+                                                  num_dirty * WORD_FIELDS * sizeof(KERNEL_DT), results.data()));
+        tick_nanosec = nstimeend - nstimestart;
+    }
+    double tick_diff = compare(trades, s, v, r, dirty, results, num_dirty);
+    // OPENCL HOST CODE AREA END
+
+    std::cout << "Kernel done!" << std::endl;
+    std::cout << "Comparing results..." << std::endl;
+    std::cout << "Processed " << num << " trades on " << num_market << " underlyings:" << std::endl;
+    std::cout << "  Whole portfolio: " << (full_nanosec * (1.0e-6)) << " ms, largest host-kernel price difference = "
+              << full_diff << std::endl;
+    std::cout << "  Repriced " << num_dirty << " trades: " << (tick_nanosec * (1.0e-6))
+              << " ms, largest host-kernel price difference = " << tick_diff << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,163 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file bs_portfolio_kernel.cpp
+ * @brief HLS implementation of the Black Scholes kernel which reprices a
+ * subset of a portfolio of trades kept in device memory
+ */
+
+#include <ap_fixed.h>
+#include <hls_stream.h>
+#include <cmath>
+#include <iostream>
+#include "hls_math.h"
+#include "xf_fintech/cf_bsm.hpp"
+
+/// @brief Specific implementation of this kernel
+///
+#define DT float
+#define DT_EQ_INT uint32_t
+#define WORD_WIDTH 256
+#define MAX_MARKET 4096
+
+// Fields of a trade word, 32 bits each
+#define TRADE_SPOT 0
+#define TRADE_VOLATILITY 1
+#define TRADE_RATE 2
+#define TRADE_CALL 3
+#define TRADE_STRIKE 4
+#define TRADE_MATURITY 5
+
+// Fields of a result word, 32 bits each
+#define RESULT_PRICE 0
+#define RESULT_DELTA 1
+#define RESULT_GAMMA 2
+#define RESULT_VEGA 3
+#define RESULT_THETA 4
+#define RESULT_RHO 5
+
+typedef ap_uint<WORD_WIDTH> WordType;
+
+/// @brief Reads field i of a word as a DT
+DT word_to_dt(WordType w, unsigned int i) {
+#pragma HLS INLINE
+    DT_EQ_INT temp = w.range(32 * i + 31, 32 * i);
+    return *(DT*)(&temp);
+}
+
+/// @brief Writes a DT to field i of a word
+void dt_to_word(DT d, unsigned int i, WordType& w) {
+#pragma HLS INLINE
+    DT_EQ_INT temp = *(DT_EQ_INT*)(&d);
+    w.range(32 * i + 31, 32 * i) = temp;
+}
+
+extern "C" {
+
+/// @brief Kernel top level
+///
+/// This is the top level kernel and represents the interface presented to the
+/// host.
+///
+/// The trades stay in device memory between calls, each call only reads the
+/// trades listed in dirty, looks their market inputs up in the spot,
+/// volatility and rate tables, and writes their price and Greeks to results
+/// in the order of the list. Trade i of the list is priced from:
+/// - spot[trades[i][TRADE_SPOT]], volatility[trades[i][TRADE_VOLATILITY]]
+///   and rate[trades[i][TRADE_RATE]],
+/// - the strike and the time to maturity of the trade,
+/// - a call if trades[i][TRADE_CALL] is non zero, a put otherwise.
+///
+/// @param[in]  trades     Trade words, one per trade of the portfolio
+/// @param[in]  spot       Spot price table
+/// @param[in]  volatility Volatility table
+/// @param[in]  rate       Risk free rate table
+/// @param[in]  numMarket  Number of entries of each table, up to MAX_MARKET
+/// @param[in]  dirty      Indexes of the trades to price
+/// @param[in]  numDirty   Number of trades to price
+/// @param[out] results    Result words, one per trade priced
+void bs_portfolio_kernel(WordType* trades,
+                         DT* spot,
+                         DT* volatility,
+                         DT* rate,
+                         unsigned int numMarket,
+                         unsigned int* dirty,
+                         unsigned int numDirty,
+                         WordType* results) {
+/// @brief Define the AXI parameters.  Each input/output parameter has a
+/// separate port
+#pragma HLS INTERFACE m_axi port = trades offset = slave bundle = in0_port
+#pragma HLS INTERFACE m_axi port = spot offset = slave bundle = in1_port
+#pragma HLS INTERFACE m_axi port = volatility offset = slave bundle = in2_port
+#pragma HLS INTERFACE m_axi port = rate offset = slave bundle = in3_port
+#pragma HLS INTERFACE m_axi port = dirty offset = slave bundle = in4_port
+#pragma HLS INTERFACE m_axi port = results offset = slave bundle = out0_port
+
+#pragma HLS INTERFACE s_axilite port = trades bundle = control
+#pragma HLS INTERFACE s_axilite port = spot bundle = control
+#pragma HLS INTERFACE s_axilite port = volatility bundle = control
+#pragma HLS INTERFACE s_axilite port = rate bundle = control
+#pragma HLS INTERFACE s_axilite port = dirty bundle = control
+#pragma HLS INTERFACE s_axilite port = results bundle = control
+
+#pragma HLS INTERFACE s_axilite port = numMarket bundle = control
+#pragma HLS INTERFACE s_axilite port = numDirty bundle = control
+#pragma HLS INTERFACE s_axilite port = return bundle = control
+
+    DT spot_table[MAX_MARKET];
+    DT volatility_table[MAX_MARKET];
+    DT rate_table[MAX_MARKET];
+
+// The tables are small, they are read once per call and looked up from on chip memory
+load_market:
+    for (unsigned int i = 0; i < numMarket; ++i) {
+#pragma HLS PIPELINE II = 1
+#pragma HLS LOOP_TRIPCOUNT min = 1 max = 4096
+        spot_table[i] = spot[i];
+        volatility_table[i] = volatility[i];
+        rate_table[i] = rate[i];
+    }
+
+// Only the dirty trades are read, the others are neither read nor written
+price_dirty:
+    for (unsigned int i = 0; i < numDirty; ++i) {
+#pragma HLS PIPELINE II = 1
+        WordType trade = trades[dirty[i]];
+        WordType result = 0;
+        DT price, delta, gamma, vega, theta, rho;
+
+        unsigned int spot_index = trade.range(32 * TRADE_SPOT + 31, 32 * TRADE_SPOT);
+        unsigned int volatility_index = trade.range(32 * TRADE_VOLATILITY + 31, 32 * TRADE_VOLATILITY);
+        unsigned int rate_index = trade.range(32 * TRADE_RATE + 31, 32 * TRADE_RATE);
+        unsigned int call = (trade.range(32 * TRADE_CALL + 31, 32 * TRADE_CALL) != 0);
+
+        // Use BSM engine with q fixed to 0 as original BS model
+        xf::fintech::cfBSMEngine<DT>(spot_table[spot_index], volatility_table[volatility_index],
+                                     rate_table[rate_index], word_to_dt(trade, TRADE_MATURITY),
+                                     word_to_dt(trade, TRADE_STRIKE), 0, call, &price, &delta, &gamma, &vega, &theta,
+                                     &rho);
+
+        dt_to_word(price, RESULT_PRICE, result);
+        dt_to_word(delta, RESULT_DELTA, result);
+        dt_to_word(gamma, RESULT_GAMMA, result);
+        dt_to_word(vega, RESULT_VEGA, result);
+        dt_to_word(theta, RESULT_THETA, result);
+        dt_to_word(rho, RESULT_RHO, result);
+        results[i] = result;
+    }
+}
+} // extern C
@@ -0,0 +1,192 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _EXPOSURE_REF_HPP_
+#define _EXPOSURE_REF_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+/*
+ * Host reference of MCExposureEngine, an independent simulation in double of the same model and time grid.
+ * Besides the estimates, it returns the standard error of EE and CVA and the slope of the quantile of each
+ * exposure, from which the tolerances of the kernel are derived.
+ */
+struct ExposureRefTrade {
+    int type; // 0 swap, 1 forward, 2 option
+    int nettingSet;
+    int factor;
+    double notional;
+    double strike;
+    double start;
+    double maturity;
+    double period;
+    int optionType; // 1 call, -1 put
+};
+
+struct ExposureRefModel {
+    double r0;
+    double a;
+    double sigma;
+    int nf;
+    std::vector<double> underlying;
+    std::vector<double> volatility;
+    std::vector<double> dividendYield;
+    std::vector<std::vector<double> > corrLower;
+
+    // deterministic shift of the Hull-White short rate fitted to the flat curve r0
+    double alpha(double t) const {
+        double x = sigma * (1.0 - std::exp(-a * t)) / a;
+        return r0 + 0.5 * x * x;
+    }
+
+    // zero coupon bond from t to T when the short rate is r
+    double bond(double t, double T, double r) const {
+        double b = (1.0 - std::exp(-a * (T - t))) / a;
+        double lnA = b * r0 - sigma * sigma / (4.0 * a) * (1.0 - std::exp(-2.0 * a * t)) * b * b - r0 * (T - t);
+        return std::exp(lnA - b * r);
+    }
+
+    double value(const ExposureRefTrade& trade, double t, double r, const std::vector<double>& s) const {
+        if (t >= trade.maturity) {
+            return 0;
+        }
+        double bondMat = bond(t, trade.maturity, r);
+        if (trade.type == 0) {
+            double annuity = 0;
+            int numPayments = (int)((trade.maturity - trade.start) / trade.period + 0.5);
+            for (int i = 1; i <= numPayments; i++) {
+                double payment = trade.start + i * trade.period;
+                if (payment > t) {
+                    annuity += trade.period * bond(t, payment, r);
+                }
+            }
+            double floatLeg = (t < trade.start) ? bond(t, trade.start, r) - bondMat : 1.0 - bondMat;
+            return trade.notional * (trade.strike * annuity - floatLeg);
+        }
+        double tau = trade.maturity - t;
+        double forward = s[trade.factor] * std::exp(-dividendYield[trade.factor] * tau) / bondMat;
+        if (trade.type == 1) {
+            return trade.notional * bondMat * (forward - trade.strike);
+        }
+        double stdDev = volatility[trade.factor] * std::sqrt(tau);
+        double d1 = std::log(forward / trade.strike) / stdDev + 0.5 * stdDev;
+        double d2 = d1 - stdDev;
+        double w = trade.optionType;
+        double n1 = 0.5 * std::erfc(-w * d1 / std::sqrt(2.0));
+        double n2 = 0.5 * std::erfc(-w * d2 / std::sqrt(2.0));
+        return trade.notional * bondMat * w * (forward * n1 - trade.strike * n2);
+    }
+};
+
+struct ExposureRefResult {
+    // at [k * steps + t], as the kernel
+    std::vector<double> ee, eeStdErr;
+    std::vector<double> pfe, pfeSlope;
+    std::vector<double> cva, cvaStdErr;
+};
+
+inline void exposureReference(const ExposureRefModel& model,
+                              const std::vector<ExposureRefTrade>& trades,
+                              int numNettingSets,
+                              const std::vector<double>& hazardRate,
+                              const std::vector<double>& recoveryRate,
+                              int paths,
+                              int steps,
+                              double dt,
+                              double quantile,
+                              ExposureRefResult& res) {
+    const int nf = model.nf;
+    std::mt19937_64 gen(42);
+    std::normal_distribution<double> normal;
+    double expAdt = std::exp(-model.a * dt);
+    double rateStdDev = std::sqrt(model.sigma * model.sigma * (1.0 - expAdt * expAdt) / (2.0 * model.a));
+
+    // exposures of every path at [(k * steps + t) * paths + p], and CVA of every path at [k * paths + p]
+    std::vector<double> exposure((size_t)numNettingSets * steps * paths);
+    std::vector<double> cvaPath((size_t)numNettingSets * paths, 0);
+    std::vector<double> s(nf), z(nf + 1), w(nf + 1), nsValue(numNettingSets);
+    for (int p = 0; p < paths; p++) {
+        double x = 0;
+        double r = model.alpha(0);
+        double logDisc = 0;
+        for (int f = 0; f < nf; f++) {
+            s[f] = model.underlying[f];
+        }
+        for (int t = 0; t < steps; t++) {
+            for (int i = 0; i < nf + 1; i++) {
+                z[i] = normal(gen);
+            }
+            for (int i = 0; i < nf + 1; i++) {
+                w[i] = 0;
+                for (int j = 0; j <= i; j++) {
+                    w[i] += model.corrLower[i][j] * z[j];
+                }
+            }
+            x = expAdt * x + rateStdDev * w[0];
+            double rNext = x + model.alpha((t + 1) * dt);
+            for (int f = 0; f < nf; f++) {
+                double v = model.volatility[f];
+                s[f] *= std::exp((r - model.dividendYield[f] - 0.5 * v * v) * dt + v * std::sqrt(dt) * w[f + 1]);
+            }
+            logDisc -= 0.5 * dt * (r + rNext);
+            r = rNext;
+
+            double time = (t + 1) * dt;
+            std::fill(nsValue.begin(), nsValue.end(), 0.0);
+            for (size_t k = 0; k < trades.size(); k++) {
+                nsValue[trades[k].nettingSet] += model.value(trades[k], time, r, s);
+            }
+            for (int k = 0; k < numNettingSets; k++) {
+                double e = std::max(nsValue[k], 0.0);
+                exposure[((size_t)k * steps + t) * paths + p] = e;
+                double pd = std::exp(-hazardRate[k] * t * dt) - std::exp(-hazardRate[k] * time);
+                cvaPath[(size_t)k * paths + p] += (1.0 - recoveryRate[k]) * std::exp(logDisc) * e * pd;
+            }
+        }
+    }
+
+    res.ee.assign(numNettingSets * steps, 0);
+    res.eeStdErr.assign(numNettingSets * steps, 0);
+    res.pfe.assign(numNettingSets * steps, 0);
+    res.pfeSlope.assign(numNettingSets * steps, 0);
+    res.cva.assign(numNettingSets, 0);
+    res.cvaStdErr.assign(numNettingSets, 0);
+    auto meanStdErr = [paths](std::vector<double>::iterator first, double& mean, double& stdErr) {
+        double sum = 0, sumSq = 0;
+        for (int p = 0; p < paths; p++) {
+            sum += first[p];
+            sumSq += first[p] * first[p];
+        }
+        mean = sum / paths;
+        stdErr = std::sqrt(std::max(sumSq / paths - mean * mean, 0.0) / paths);
+    };
+    for (int i = 0; i < numNettingSets * steps; i++) {
+        std::vector<double>::iterator first = exposure.begin() + (size_t)i * paths;
+        meanStdErr(first, res.ee[i], res.eeStdErr[i]);
+        // nearest rank quantile, and its slope from the neighbouring ranks
+        std::sort(first, first + paths);
+        auto rank = [paths](double q) { return std::min(std::max((int)(q * paths), 0), paths - 1); };
+        res.pfe[i] = first[rank(quantile)];
+        res.pfeSlope[i] = (first[rank(quantile + 0.01)] - first[rank(quantile - 0.01)]) / 0.02;
+    }
+    for (int k = 0; k < numNettingSets; k++) {
+        meanStdErr(cvaPath.begin() + (size_t)k * paths, res.cva[k], res.cvaStdErr[k]);
+    }
+}
+
+#endif
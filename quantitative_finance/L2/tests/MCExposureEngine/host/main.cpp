@@ -0,0 +1,287 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HLS_TEST
+#include "xcl2.hpp"
+#endif
+#include <cmath>
+#include <cstring>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <sys/time.h>
+#include "ap_int.h"
+#include "utils.hpp"
+#include "exposure_ref.hpp"
+#include "mcengine_top.hpp"
+#define XCL_BANK(n) (((unsigned int)(n)) | XCL_MEM_TOPOLOGY)
+
+#define XCL_BANK0 XCL_BANK(0)
+#define XCL_BANK1 XCL_BANK(1)
+#define XCL_BANK2 XCL_BANK(2)
+#define XCL_BANK3 XCL_BANK(3)
+#define XCL_BANK4 XCL_BANK(4)
+#define XCL_BANK5 XCL_BANK(5)
+#define XCL_BANK6 XCL_BANK(6)
+#define XCL_BANK7 XCL_BANK(7)
+#define XCL_BANK8 XCL_BANK(8)
+#define XCL_BANK9 XCL_BANK(9)
+#define XCL_BANK10 XCL_BANK(10)
+#define XCL_BANK11 XCL_BANK(11)
+#define XCL_BANK12 XCL_BANK(12)
+#define XCL_BANK13 XCL_BANK(13)
+#define XCL_BANK14 XCL_BANK(14)
+#define XCL_BANK15 XCL_BANK(15)
+
+class ArgParser {
+   public:
+    ArgParser(int& argc, const char** argv) {
+        for (int i = 1; i < argc; ++i) mTokens.push_back(std::string(argv[i]));
+    }
+    bool getCmdOption(const std::string option, std::string& value) const {
+        std::vector<std::string>::const_iterator itr;
+        itr = std::find(this->mTokens.begin(), this->mTokens.end(), option);
+        if (itr != this->mTokens.end() && ++itr != this->mTokens.end()) {
+            value = *itr;
+            return true;
+        }
+        return false;
+    }
+
+   private:
+    std::vector<std::string> mTokens;
+};
+
+// lower triangular Cholesky factor of a correlation matrix
+std::vector<std::vector<double> > cholesky(const std::vector<std::vector<double> >& corr) {
+    int n = corr.size();
+    std::vector<std::vector<double> > l(n, std::vector<double>(n, 0));
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j <= i; j++) {
+            double sum = corr[i][j];
+            for (int k = 0; k < j; k++) {
+                sum -= l[i][k] * l[j][k];
+            }
+            l[i][j] = (i == j) ? std::sqrt(sum) : sum / l[j][j];
+        }
+    }
+    return l;
+}
+
+int main(int argc, const char* argv[]) {
+    // cmd parser
+    ArgParser parser(argc, argv);
+    std::string mode;
+    std::string xclbin_path;
+    std::string mode_emu = "hw";
+#ifndef HLS_TEST
+    if (!parser.getCmdOption("-xclbin", xclbin_path)) {
+        std::cout << "ERROR:xclbin path is not set!\n";
+        return 1;
+    }
+
+    if (std::getenv("XCL_EMULATION_MODE") != nullptr) {
+        mode_emu = std::getenv("XCL_EMULATION_MODE");
+    }
+    std::cout << "[INFO]Running in " << mode_emu << " mode" << std::endl;
+#endif
+
+    // -------------setup k0 params---------------
+    // 5 years of quarterly steps, a Hull-White short rate on a flat 5% curve, an equity and an FX rate
+    const int NF = EXPOSURE_NF;
+    unsigned int paths = 32768;
+    const unsigned int steps = 20;
+    const double dt = 0.25;
+    const double quantile = 0.95;
+    ExposureRefModel model;
+    model.r0 = 0.05;
+    model.a = 0.1;
+    model.sigma = 0.01;
+    model.nf = NF;
+    model.underlying = {100, 1.1};
+    model.volatility = {0.25, 0.1};
+    model.dividendYield = {0.02, 0.03};
+    model.corrLower = cholesky({{1, 0.2, -0.3}, {0.2, 1, 0.4}, {-0.3, 0.4, 1}});
+
+    // type, netting set, factor, notional, strike, start, maturity, period, option type
+    std::vector<ExposureRefTrade> trades = {
+        {0, 0, 0, 100, 0.05, 0, 5, 0.5, 1},    // receive fixed
+        {0, 0, 0, -50, 0.045, 1, 4, 0.5, 1},   // pay fixed, forward starting
+        {1, 1, 0, 1, 100, 0, 3, 0, 1},         // long equity forward
+        {1, 1, 1, -100, 1.1, 0, 3, 0, 1},      // short FX forward, hedging part of the equity forward
+        {2, 1, 1, 50, 1.1, 0, 2, 0, 1},        // long FX call
+        {2, 2, 0, 1, 95, 0, 4, 0, -1},         // long equity put
+        {0, 2, 0, -100, 0.052, 0, 3, 0.25, 1}, // pay fixed
+    };
+    const int numNettingSets = 3;
+    std::vector<double> hazardRate = {0.02, 0.03, 0.01};
+    std::vector<double> recoveryRate = {0.4, 0.4, 0.3};
+
+    int refPaths = 131072;
+    if (mode_emu == "hw_emu") {
+        paths = 64;
+        refPaths = 64;
+    }
+
+    // Allocate Memory in Host Memory
+    TEST_DT* factorData = aligned_alloc<TEST_DT>(EXPOSURE_FACTOR_DATA);
+    TEST_DT* tradeData = aligned_alloc<TEST_DT>(EXPOSURE_MAX_TRADES * EXPOSURE_TRADE_FIELDS);
+    TEST_DT* creditData = aligned_alloc<TEST_DT>(2 * EXPOSURE_MAX_NS);
+    TEST_DT* ee = aligned_alloc<TEST_DT>(EXPOSURE_MAX_NS * EXPOSURE_MAX_STEPS);
+    TEST_DT* pfe = aligned_alloc<TEST_DT>(EXPOSURE_MAX_NS * EXPOSURE_MAX_STEPS);
+    TEST_DT* cva = aligned_alloc<TEST_DT>(EXPOSURE_MAX_NS);
+    for (int f = 0; f < NF; f++) {
+        factorData[3 * f] = model.underlying[f];
+        factorData[3 * f + 1] = model.volatility[f];
+        factorData[3 * f + 2] = model.dividendYield[f];
+    }
+    for (int i = 0; i < NF + 1; i++) {
+        for (int j = 0; j < NF + 1; j++) {
+            factorData[3 * NF + i * (NF + 1) + j] = model.corrLower[i][j];
+        }
+    }
+    for (size_t k = 0; k < trades.size(); k++) {
+        TEST_DT* out = tradeData + k * EXPOSURE_TRADE_FIELDS;
+        out[0] = trades[k].type;
+        out[1] = trades[k].nettingSet;
+        out[2] = trades[k].factor;
+        out[3] = trades[k].notional;
+        out[4] = trades[k].strike;
+        out[5] = trades[k].start;
+        out[6] = trades[k].maturity;
+        out[7] = trades[k].period;
+        out[8] = trades[k].optionType;
+    }
+    for (int k = 0; k < numNettingSets; k++) {
+        creditData[k] = hazardRate[k];
+        creditData[numNettingSets + k] = recoveryRate[k];
+    }
+
+    // do pre-process on CPU
+    struct timeval start_time, end_time;
+    // platform related operations
+    std::vector<cl::Device> devices = xcl::get_xil_devices();
+    cl::Device device = devices[0];
+
+    // Creating Context and Command Queue for selected Device
+    cl::Context context(device);
+    cl::CommandQueue q(context, device, CL_QUEUE_PROFILING_ENABLE | CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE);
+    std::string devName = device.getInfo<CL_DEVICE_NAME>();
+    printf("Found Device=%s\n", devName.c_str());
+
+    cl::Program::Binaries xclBins = xcl::import_binary_file(xclbin_path);
+    devices.resize(1);
+    cl::Program program(context, devices, xclBins);
+    cl::Kernel kernel_Engine(program, "MCExposureEngine_k0");
+    std::cout << "kernel has been created" << std::endl;
+
+    cl_mem_ext_ptr_t mext_o[6];
+    mext_o[0].obj = factorData;
+    mext_o[1].obj = tradeData;
+    mext_o[2].obj = creditData;
+    mext_o[3].obj = ee;
+    mext_o[4].obj = pfe;
+    mext_o[5].obj = cva;
+    for (int i = 0; i < 6; ++i) {
+        mext_o[i].param = 0;
+#ifndef USE_HBM
+        mext_o[i].flags = XCL_MEM_DDR_BANK0;
+#else
+        mext_o[i].flags = XCL_BANK0;
+#endif
+    }
+
+    // create device buffer and map dev buf to host buf
+    size_t sizes[6] = {EXPOSURE_FACTOR_DATA,
+                       EXPOSURE_MAX_TRADES * EXPOSURE_TRADE_FIELDS,
+                       2 * EXPOSURE_MAX_NS,
+                       EXPOSURE_MAX_NS * EXPOSURE_MAX_STEPS,
+                       EXPOSURE_MAX_NS * EXPOSURE_MAX_STEPS,
+                       EXPOSURE_MAX_NS};
+    std::vector<cl::Buffer> bufs;
+    for (int i = 0; i < 6; ++i) {
+        bufs.push_back(cl::Buffer(context, CL_MEM_EXT_PTR_XILINX | CL_MEM_USE_HOST_PTR | CL_MEM_READ_WRITE,
+                                  sizes[i] * sizeof(TEST_DT), &mext_o[i]));
+    }
+    std::vector<cl::Memory> ob_in(bufs.begin(), bufs.begin() + 3);
+    std::vector<cl::Memory> ob_out(bufs.begin() + 3, bufs.end());
+
+    q.enqueueMigrateMemObjects(ob_in, 0, nullptr, nullptr);
+    q.finish();
+    // launch kernel and calculate kernel execution time
+    std::cout << "kernel start------" << std::endl;
+    gettimeofday(&start_time, 0);
+    int j = 0;
+    kernel_Engine.setArg(j++, 7u);
+    kernel_Engine.setArg(j++, paths);
+    kernel_Engine.setArg(j++, steps);
+    kernel_Engine.setArg(j++, (TEST_DT)dt);
+    kernel_Engine.setArg(j++, (TEST_DT)model.r0);
+    kernel_Engine.setArg(j++, (TEST_DT)model.a);
+    kernel_Engine.setArg(j++, (TEST_DT)model.sigma);
+    kernel_Engine.setArg(j++, bufs[0]);
+    kernel_Engine.setArg(j++, (unsigned int)trades.size());
+    kernel_Engine.setArg(j++, bufs[1]);
+    kernel_Engine.setArg(j++, (unsigned int)numNettingSets);
+    kernel_Engine.setArg(j++, bufs[2]);
+    kernel_Engine.setArg(j++, (TEST_DT)quantile);
+    kernel_Engine.setArg(j++, bufs[3]);
+    kernel_Engine.setArg(j++, bufs[4]);
+    kernel_Engine.setArg(j++, bufs[5]);
+
+    q.enqueueTask(kernel_Engine, nullptr, nullptr);
+    q.finish();
+    gettimeofday(&end_time, 0);
+    std::cout << "kernel end------" << std::endl;
+    std::cout << "Execution time " << tvdiff(&start_time, &end_time) << "us" << std::endl;
+    q.enqueueMigrateMemObjects(ob_out, 1, nullptr, nullptr);
+    q.finish();
+    for (int k = 0; k < numNettingSets; k++) {
+        std::cout << "netting set " << k << ": CVA=" << cva[k] << ", EE at 1Y=" << ee[k * steps + 3]
+                  << ", PFE at 1Y=" << pfe[k * steps + 3] << std::endl;
+    }
+    if (mode_emu == "hw_emu") {
+        return 0;
+    }
+
+    // The kernel and the reference are independent simulations, so the tolerances are 4 standard errors of their
+    // difference, the kernel taking the variance of the reference. The PFE also allows 2% for the P-square estimate.
+    ExposureRefResult ref;
+    exposureReference(model, trades, numNettingSets, hazardRate, recoveryRate, refPaths, steps, dt, quantile, ref);
+    double scale = std::sqrt((double)refPaths / paths + 1.0);
+    int errs = 0;
+    for (int i = 0; i < numNettingSets * (int)steps; i++) {
+        double eeTol = 4 * scale * ref.eeStdErr[i] + 1e-9;
+        double pfeTol = 4 * scale * ref.pfeSlope[i] * std::sqrt(quantile * (1 - quantile) / refPaths) +
+                        0.02 * ref.pfe[i] + 1e-9;
+        if (std::fabs(ee[i] - ref.ee[i]) > eeTol || std::fabs(pfe[i] - ref.pfe[i]) > pfeTol) {
+            std::cout << "Netting set " << i / steps << ", step " << i % steps << ": EE " << ee[i] << ", expected "
+                      << ref.ee[i] << ", PFE " << pfe[i] << ", expected " << ref.pfe[i] << std::endl;
+            errs++;
+        }
+    }
+    for (int k = 0; k < numNettingSets; k++) {
+        if (std::fabs(cva[k] - ref.cva[k]) > 4 * scale * ref.cvaStdErr[k]) {
+            std::cout << "Netting set " << k << ": CVA " << cva[k] << ", expected " << ref.cva[k] << std::endl;
+            errs++;
+        }
+    }
+    if (errs) {
+        std::cout << "Output is wrong!" << std::endl;
+        return -1;
+    }
+    return 0;
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mcengine_top.hpp"
+#ifndef __SYNTHESIS__
+#include <iostream>
+#endif
+
+extern "C" void MCExposureEngine_k0(unsigned int seed,
+                                    unsigned int paths,
+                                    unsigned int steps,
+                                    TEST_DT dt,
+                                    TEST_DT r0,
+                                    TEST_DT meanReversion,
+                                    TEST_DT rateVolatility, // Model Parameter
+                                    TEST_DT* factorData,
+                                    unsigned int numTrades,
+                                    TEST_DT* tradeData,
+                                    unsigned int numNettingSets,
+                                    TEST_DT* creditData,
+                                    TEST_DT quantile,
+                                    TEST_DT* ee,
+                                    TEST_DT* pfe,
+                                    TEST_DT* cva) {
+#pragma HLS INTERFACE m_axi port = factorData bundle = gmem0 offset = slave
+#pragma HLS INTERFACE m_axi port = tradeData bundle = gmem0 offset = slave
+#pragma HLS INTERFACE m_axi port = creditData bundle = gmem0 offset = slave
+#pragma HLS INTERFACE m_axi port = ee bundle = gmem1 offset = slave
+#pragma HLS INTERFACE m_axi port = pfe bundle = gmem1 offset = slave
+#pragma HLS INTERFACE m_axi port = cva bundle = gmem1 offset = slave
+
+#pragma HLS INTERFACE s_axilite port = seed bundle = control
+#pragma HLS INTERFACE s_axilite port = paths bundle = control
+#pragma HLS INTERFACE s_axilite port = steps bundle = control
+#pragma HLS INTERFACE s_axilite port = dt bundle = control
+#pragma HLS INTERFACE s_axilite port = r0 bundle = control
+#pragma HLS INTERFACE s_axilite port = meanReversion bundle = control
+#pragma HLS INTERFACE s_axilite port = rateVolatility bundle = control
+#pragma HLS INTERFACE s_axilite port = factorData bundle = control
+#pragma HLS INTERFACE s_axilite port = numTrades bundle = control
+#pragma HLS INTERFACE s_axilite port = tradeData bundle = control
+#pragma HLS INTERFACE s_axilite port = numNettingSets bundle = control
+#pragma HLS INTERFACE s_axilite port = creditData bundle = control
+#pragma HLS INTERFACE s_axilite port = quantile bundle = control
+#pragma HLS INTERFACE s_axilite port = ee bundle = control
+#pragma HLS INTERFACE s_axilite port = pfe bundle = control
+#pragma HLS INTERFACE s_axilite port = cva bundle = control
+#pragma HLS INTERFACE s_axilite port = return bundle = control
+
+    const int NF = EXPOSURE_NF;
+    ap_uint<32> seed1 = seed;
+    TEST_DT underlying[NF];
+    TEST_DT volatility[NF];
+    TEST_DT dividendYield[NF];
+    TEST_DT corrLower[NF + 1][NF + 1];
+    for (int f = 0; f < NF; f++) {
+        underlying[f] = factorData[3 * f];
+        volatility[f] = factorData[3 * f + 1];
+        dividendYield[f] = factorData[3 * f + 2];
+    }
+    for (int i = 0; i < NF + 1; i++) {
+        for (int j = 0; j < NF + 1; j++) {
+#pragma HLS pipeline II = 1
+            corrLower[i][j] = factorData[3 * NF + i * (NF + 1) + j];
+        }
+    }
+
+    xf::fintech::ExposureTrade<TEST_DT> trades[EXPOSURE_MAX_TRADES];
+    for (unsigned int k = 0; k < numTrades; k++) {
+#pragma HLS loop_tripcount min = 8 max = 8
+        TEST_DT* in = tradeData + k * EXPOSURE_TRADE_FIELDS;
+        trades[k].type = (xf::fintech::TradeType)(int)in[0];
+        trades[k].nettingSet = (unsigned int)in[1];
+        trades[k].factor = (unsigned int)in[2];
+        trades[k].notional = in[3];
+        trades[k].strike = in[4];
+        trades[k].start = in[5];
+        trades[k].maturity = in[6];
+        trades[k].period = in[7];
+        trades[k].optionType = (in[8] > 0) ? xf::fintech::Call : xf::fintech::Put;
+    }
+
+    TEST_DT hazardRate[EXPOSURE_MAX_NS];
+    TEST_DT recoveryRate[EXPOSURE_MAX_NS];
+    for (unsigned int k = 0; k < numNettingSets; k++) {
+#pragma HLS loop_tripcount min = 3 max = 3
+        hazardRate[k] = creditData[k];
+        recoveryRate[k] = creditData[numNettingSets + k];
+    }
+#ifndef __SYNTHESIS__
+    std::cout << "seed=" << seed1 << ",paths=" << paths << ",steps=" << steps << ",dt=" << dt << ",r0=" << r0
+              << ",meanReversion=" << meanReversion << ",rateVolatility=" << rateVolatility
+              << ",numTrades=" << numTrades << ",numNettingSets=" << numNettingSets << ",quantile=" << quantile
+              << std::endl;
+#endif
+
+    TEST_DT eeBuff[EXPOSURE_MAX_NS * EXPOSURE_MAX_STEPS];
+    TEST_DT pfeBuff[EXPOSURE_MAX_NS * EXPOSURE_MAX_STEPS];
+    TEST_DT cvaBuff[EXPOSURE_MAX_NS];
+    xf::fintech::MCExposureEngine<TEST_DT, NF, EXPOSURE_UN, EXPOSURE_MAX_TRADES, EXPOSURE_MAX_NS, EXPOSURE_MAX_STEPS>(
+        seed1, paths, steps, dt, r0, meanReversion, rateVolatility, underlying, volatility, dividendYield, corrLower,
+        numTrades, trades, numNettingSets, hazardRate, recoveryRate, quantile, eeBuff, pfeBuff, cvaBuff);
+
+    for (unsigned int i = 0; i < numNettingSets * steps; i++) {
+#pragma HLS loop_tripcount min = 60 max = 60
+#pragma HLS pipeline II = 1
+        ee[i] = eeBuff[i];
+        pfe[i] = pfeBuff[i];
+    }
+    for (unsigned int k = 0; k < numNettingSets; k++) {
+#pragma HLS loop_tripcount min = 3 max = 3
+#pragma HLS pipeline II = 1
+        cva[k] = cvaBuff[k];
+    }
+#ifndef __SYNTHESIS__
+    for (unsigned int k = 0; k < numNettingSets; k++) {
+        std::cout << "netting set " << k << ": cva=" << cvaBuff[k] << std::endl;
+    }
+#endif
+}
@@ -0,0 +1,50 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _XF_FINTECH_MCENGINE_TOP_HPP_
+#define _XF_FINTECH_MCENGINE_TOP_HPP_
+
+#include "xf_fintech/enums.hpp"
+#include "xf_fintech/exposure_engine.hpp"
+typedef double TEST_DT;
+// risk factors besides the short rate, pricing units, and sizes of the portfolio and of the time grid
+#define EXPOSURE_NF (2)
+#define EXPOSURE_UN (2)
+#define EXPOSURE_MAX_TRADES (64)
+#define EXPOSURE_MAX_NS (4)
+#define EXPOSURE_MAX_STEPS (32)
+// values of a trade in tradeData: type, netting set, factor, notional, strike, start, maturity, period, option type
+#define EXPOSURE_TRADE_FIELDS (9)
+// values of factorData: underlying, volatility and dividend yield of each factor, then the lower triangular Cholesky
+// factor of the correlation of the short rate and the factors, row by row
+#define EXPOSURE_FACTOR_DATA (3 * EXPOSURE_NF + (EXPOSURE_NF + 1) * (EXPOSURE_NF + 1))
+extern "C" void MCExposureEngine_k0(unsigned int seed,
+                                    unsigned int paths,
+                                    unsigned int steps,
+                                    TEST_DT dt,
+                                    TEST_DT r0,
+                                    TEST_DT meanReversion,
+                                    TEST_DT rateVolatility, // Model Parameter
+                                    TEST_DT* factorData,
+                                    unsigned int numTrades,
+                                    TEST_DT* tradeData,
+                                    unsigned int numNettingSets,
+                                    TEST_DT* creditData, // hazard rate then recovery rate of each netting set
+                                    TEST_DT quantile,
+                                    TEST_DT* ee,
+                                    TEST_DT* pfe,
+                                    TEST_DT* cva);
+
+#endif
@@ -0,0 +1,269 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HLS_TEST
+#include "xcl2.hpp"
+#endif
+#include <cmath>
+#include <cstring>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <sys/time.h>
+#include "ap_int.h"
+#include "utils.hpp"
+#include "mcengine_top.hpp"
+#define XCL_BANK(n) (((unsigned int)(n)) | XCL_MEM_TOPOLOGY)
+
+#define XCL_BANK0 XCL_BANK(0)
+#define XCL_BANK1 XCL_BANK(1)
+#define XCL_BANK2 XCL_BANK(2)
+#define XCL_BANK3 XCL_BANK(3)
+#define XCL_BANK4 XCL_BANK(4)
+#define XCL_BANK5 XCL_BANK(5)
+#define XCL_BANK6 XCL_BANK(6)
+#define XCL_BANK7 XCL_BANK(7)
+#define XCL_BANK8 XCL_BANK(8)
+#define XCL_BANK9 XCL_BANK(9)
+#define XCL_BANK10 XCL_BANK(10)
+#define XCL_BANK11 XCL_BANK(11)
+#define XCL_BANK12 XCL_BANK(12)
+#define XCL_BANK13 XCL_BANK(13)
+#define XCL_BANK14 XCL_BANK(14)
+#define XCL_BANK15 XCL_BANK(15)
+
+class ArgParser {
+   public:
+    ArgParser(int& argc, const char** argv) {
+        for (int i = 1; i < argc; ++i) mTokens.push_back(std::string(argv[i]));
+    }
+    bool getCmdOption(const std::string option, std::string& value) const {
+        std::vector<std::string>::const_iterator itr;
+        itr = std::find(this->mTokens.begin(), this->mTokens.end(), option);
+        if (itr != this->mTokens.end() && ++itr != this->mTokens.end()) {
+            value = *itr;
+            return true;
+        }
+        return false;
+    }
+
+   private:
+    std::vector<std::string> mTokens;
+};
+
+struct GreeksOptionData {
+    int style; // 0 European, 1 arithmetic average price Asian, 2 barrier, 3 digital
+    xf::fintech::enums::BarrierType barrierType;
+    TEST_DT barrier;
+    TEST_DT cashPayoff;
+    bool type;
+    TEST_DT strike;
+    TEST_DT s;                     // spot
+    TEST_DT q;                     // dividend
+    TEST_DT r;                     // risk-free rate
+    TEST_DT t;                     // time to maturity
+    TEST_DT v;                     // volatility
+    unsigned int steps;            // monitoring dates
+    bool closedForm;               // reference of the Greeks, Black-Scholes closed form or bump-and-revalue
+    TEST_DT result[GREEKS_OUTDEP]; // reference price and, for the closed form, Greeks
+    TEST_DT tol[GREEKS_OUTDEP];    // absolute tolerance, about 4 standard errors of the estimator
+};
+
+// price the option of d with spot s, volatility v and risk-free rate r, on the paths of seed 7
+void runEngine(cl::CommandQueue& q,
+               cl::Kernel& kernel,
+               cl::Buffer& seed_buf,
+               cl::Buffer& output_buf,
+               unsigned int* seed,
+               const GreeksOptionData& d,
+               TEST_DT s,
+               TEST_DT v,
+               TEST_DT r,
+               unsigned int requiredSamples) {
+    seed[0] = 7;
+    std::vector<cl::Memory> ob_in;
+    ob_in.push_back(seed_buf);
+    std::vector<cl::Memory> ob_out;
+    ob_out.push_back(output_buf);
+
+    q.enqueueMigrateMemObjects(ob_in, 0, nullptr, nullptr);
+    q.finish();
+    int j = 0;
+    kernel.setArg(j++, s);
+    kernel.setArg(j++, v);
+    kernel.setArg(j++, d.q);
+    kernel.setArg(j++, r);
+    kernel.setArg(j++, d.t);
+    kernel.setArg(j++, d.barrier);
+    kernel.setArg(j++, d.strike);
+    kernel.setArg(j++, d.cashPayoff);
+    kernel.setArg(j++, (int)d.barrierType);
+    kernel.setArg(j++, (int)d.type);
+    kernel.setArg(j++, d.style);
+    kernel.setArg(j++, seed_buf);
+    kernel.setArg(j++, output_buf);
+    kernel.setArg(j++, requiredSamples);
+    kernel.setArg(j++, d.steps);
+
+    q.enqueueTask(kernel, nullptr, nullptr);
+    q.finish();
+    q.enqueueMigrateMemObjects(ob_out, 1, nullptr, nullptr);
+    q.finish();
+}
+
+int main(int argc, const char* argv[]) {
+    // cmd parser
+    ArgParser parser(argc, argv);
+    std::string mode;
+    std::string xclbin_path;
+    std::string mode_emu = "hw";
+#ifndef HLS_TEST
+    if (!parser.getCmdOption("-xclbin", xclbin_path)) {
+        std::cout << "ERROR:xclbin path is not set!\n";
+        return 1;
+    }
+
+    if (std::getenv("XCL_EMULATION_MODE") != nullptr) {
+        mode_emu = std::getenv("XCL_EMULATION_MODE");
+    }
+    std::cout << "[INFO]Running in " << mode_emu << " mode" << std::endl;
+#endif
+    // Allocate Memory in Host Memory
+    TEST_DT* outputs = aligned_alloc<TEST_DT>(GREEKS_OUTDEP);
+    unsigned int* seed = aligned_alloc<unsigned int>(1);
+
+    // -------------setup k0 params---------------
+    // 65536 paths. The European and digital options are checked against the Black-Scholes closed form, with pathwise
+    // and likelihood-ratio estimators respectively. The Asian and barrier options are checked against bump-and-revalue
+    // on the same paths, with the mixed and likelihood-ratio estimators of gamma respectively, and their prices against
+    // the ones of the MCQMCEngine test.
+    const char* names[GREEKS_OUTDEP] = {"price", "delta", "gamma", "vega", "rho"};
+    GreeksOptionData values[] = {
+        // style, barrierType, barrier, cashPayoff, type, strike, s, q, r, t, vol, steps, closedForm,
+        // {price, delta, gamma, vega, rho}, {tolerances}
+        {0, xf::fintech::enums::BarrierType::DownOut, 0, 0, 0, 100, 100, 0.0, 0.05, 1, 0.20, 1, true,
+         {10.4506, 0.63683, 0.018762, 37.524, 53.232},
+         {0.25, 0.01, 0.0007, 1.3, 0.8}},
+        {3, xf::fintech::enums::BarrierType::DownOut, 0, 1, 0, 100, 100, 0.0, 0.05, 1, 0.20, 1, true,
+         {0.53232, 0.018762, -0.00032834, -0.65667, 1.34388},
+         {0.008, 0.0005, 0.00004, 0.075, 0.04}},
+        {1, xf::fintech::enums::BarrierType::DownOut, 0, 0, 0, 100, 100, 0.0, 0.05, 1, 0.20, 16, false,
+         {5.7015, 0, 0, 0, 0},
+         {0.13, 0.005, 0.0025, 0.6, 0.4}},
+        {2, xf::fintech::enums::BarrierType::DownOut, 85, 0, 0, 100, 100, 0.0, 0.05, 1, 0.20, 16, false,
+         {10.2095, 0, 0, 0, 0},
+         {0.25, 0.06, 0.018, 9, 2.2}}};
+    // bumps of spot, volatility and risk-free rate
+    const TEST_DT hS = 2;
+    const TEST_DT hV = 0.01;
+    const TEST_DT hR = 0.005;
+
+    unsigned int requiredSamples = 65536;
+    int test_nm = 4;
+    if (mode_emu == "hw_emu") {
+        test_nm = 1;
+        requiredSamples = 1024;
+    }
+    // do pre-process on CPU
+    struct timeval start_time, end_time;
+    // platform related operations
+    std::vector<cl::Device> devices = xcl::get_xil_devices();
+    cl::Device device = devices[0];
+
+    // Creating Context and Command Queue for selected Device
+    cl::Context context(device);
+    cl::CommandQueue q(context, device, CL_QUEUE_PROFILING_ENABLE | CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE);
+    std::string devName = device.getInfo<CL_DEVICE_NAME>();
+    printf("Found Device=%s\n", devName.c_str());
+
+    cl::Program::Binaries xclBins = xcl::import_binary_file(xclbin_path);
+    devices.resize(1);
+    cl::Program program(context, devices, xclBins);
+    cl::Kernel kernel_Engine(program, "MCGreeksEngine_k0");
+    std::cout << "kernel has been created" << std::endl;
+
+    cl_mem_ext_ptr_t mext_o[2];
+    mext_o[0].obj = outputs;
+    mext_o[0].param = 0;
+
+    mext_o[1].obj = seed;
+    mext_o[1].param = 0;
+    for (int i = 0; i < 2; ++i) {
+#ifndef USE_HBM
+        mext_o[i].flags = XCL_MEM_DDR_BANK0;
+#else
+        mext_o[i].flags = XCL_BANK0;
+#endif
+    }
+
+    // create device buffer and map dev buf to host buf
+    cl::Buffer output_buf;
+    cl::Buffer seed_buf;
+    output_buf = cl::Buffer(context, CL_MEM_EXT_PTR_XILINX | CL_MEM_USE_HOST_PTR | CL_MEM_READ_WRITE,
+                            GREEKS_OUTDEP * sizeof(TEST_DT), &mext_o[0]);
+    seed_buf = cl::Buffer(context, CL_MEM_EXT_PTR_XILINX | CL_MEM_USE_HOST_PTR | CL_MEM_READ_WRITE,
+                          sizeof(unsigned int), &mext_o[1]);
+
+    for (int i = 0; i < test_nm; ++i) {
+        const GreeksOptionData& d = values[i];
+        // launch kernel and calculate kernel execution time
+        std::cout << "kernel start------" << std::endl;
+        gettimeofday(&start_time, 0);
+        runEngine(q, kernel_Engine, seed_buf, output_buf, seed, d, d.s, d.v, d.r, requiredSamples);
+        gettimeofday(&end_time, 0);
+        std::cout << "kernel end------" << std::endl;
+        std::cout << "Execution time " << tvdiff(&start_time, &end_time) << "us" << std::endl;
+        TEST_DT greeks[GREEKS_OUTDEP];
+        for (int k = 0; k < GREEKS_OUTDEP; k++) {
+            greeks[k] = outputs[k];
+        }
+        std::cout << "price=" << greeks[0] << ", delta=" << greeks[1] << ", gamma=" << greeks[2]
+                  << ", vega=" << greeks[3] << ", rho=" << greeks[4] << std::endl;
+        if (mode_emu == "hw_emu") {
+            continue;
+        }
+
+        TEST_DT golden[GREEKS_OUTDEP];
+        for (int k = 0; k < GREEKS_OUTDEP; k++) {
+            golden[k] = d.result[k];
+        }
+        if (!d.closedForm) {
+            // central differences of the prices on the same paths
+            TEST_DT bump[6];
+            const TEST_DT args[6][3] = {{d.s + hS, d.v, d.r}, {d.s - hS, d.v, d.r}, {d.s, d.v + hV, d.r},
+                                        {d.s, d.v - hV, d.r}, {d.s, d.v, d.r + hR}, {d.s, d.v, d.r - hR}};
+            for (int k = 0; k < 6; k++) {
+                runEngine(q, kernel_Engine, seed_buf, output_buf, seed, d, args[k][0], args[k][1], args[k][2],
+                          requiredSamples);
+                bump[k] = outputs[0];
+            }
+            golden[1] = (bump[0] - bump[1]) / (2 * hS);
+            golden[2] = (bump[0] - 2 * greeks[0] + bump[1]) / (hS * hS);
+            golden[3] = (bump[2] - bump[3]) / (2 * hV);
+            golden[4] = (bump[4] - bump[5]) / (2 * hR);
+        }
+        for (int k = 0; k < GREEKS_OUTDEP; k++) {
+            TEST_DT error = std::fabs(golden[k] - greeks[k]);
+            if (error > d.tol[k]) {
+                std::cout << "Output is wrong!" << std::endl;
+                std::cout << "Acutal " << names[k] << ": " << greeks[k] << ", Expected value: " << golden[k]
+                          << ", Absolute error: " << error << std::endl;
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
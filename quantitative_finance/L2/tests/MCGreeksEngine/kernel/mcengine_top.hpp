@@ -0,0 +1,41 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _XF_FINTECH_MCENGINE_TOP_HPP_
+#define _XF_FINTECH_MCENGINE_TOP_HPP_
+
+#include "xf_fintech/enums.hpp"
+#include "xf_fintech/mc_engine.hpp"
+#include "xf_fintech/rng.hpp"
+typedef float TEST_DT;
+// number of values written to output by each call, the price and the Greeks in the order of GreeksType
+#define GREEKS_OUTDEP (5)
+extern "C" void MCGreeksEngine_k0(TEST_DT underlying,
+                                  TEST_DT volatility,
+                                  TEST_DT dividendYield,
+                                  TEST_DT riskFreeRate,
+                                  TEST_DT timeLength, // Model Parameter
+                                  TEST_DT barrier,
+                                  TEST_DT strike,
+                                  TEST_DT cashPayoff,
+                                  int barrierType,
+                                  int optionType, // option parameter.
+                                  int style,      // 0 European, 1 arithmetic average price Asian, 2 barrier, 3 digital
+                                  unsigned int* seed,
+                                  TEST_DT* output,
+                                  unsigned int requiredSamples,
+                                  unsigned int timeSteps);
+
+#endif
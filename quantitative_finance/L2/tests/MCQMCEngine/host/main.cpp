@@ -0,0 +1,221 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HLS_TEST
+#include "xcl2.hpp"
+#endif
+#include <cstring>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <sys/time.h>
+#include "ap_int.h"
+#include "utils.hpp"
+#include "mcengine_top.hpp"
+#define XCL_BANK(n) (((unsigned int)(n)) | XCL_MEM_TOPOLOGY)
+
+#define XCL_BANK0 XCL_BANK(0)
+#define XCL_BANK1 XCL_BANK(1)
+#define XCL_BANK2 XCL_BANK(2)
+#define XCL_BANK3 XCL_BANK(3)
+#define XCL_BANK4 XCL_BANK(4)
+#define XCL_BANK5 XCL_BANK(5)
+#define XCL_BANK6 XCL_BANK(6)
+#define XCL_BANK7 XCL_BANK(7)
+#define XCL_BANK8 XCL_BANK(8)
+#define XCL_BANK9 XCL_BANK(9)
+#define XCL_BANK10 XCL_BANK(10)
+#define XCL_BANK11 XCL_BANK(11)
+#define XCL_BANK12 XCL_BANK(12)
+#define XCL_BANK13 XCL_BANK(13)
+#define XCL_BANK14 XCL_BANK(14)
+#define XCL_BANK15 XCL_BANK(15)
+
+class ArgParser {
+   public:
+    ArgParser(int& argc, const char** argv) {
+        for (int i = 1; i < argc; ++i) mTokens.push_back(std::string(argv[i]));
+    }
+    bool getCmdOption(const std::string option, std::string& value) const {
+        std::vector<std::string>::const_iterator itr;
+        itr = std::find(this->mTokens.begin(), this->mTokens.end(), option);
+        if (itr != this->mTokens.end() && ++itr != this->mTokens.end()) {
+            value = *itr;
+            return true;
+        }
+        return false;
+    }
+
+   private:
+    std::vector<std::string> mTokens;
+};
+
+struct QMCOptionData {
+    int style; // 0 European, 1 arithmetic average price Asian, 2 barrier
+    xf::fintech::enums::BarrierType barrierType;
+    TEST_DT barrier;
+    TEST_DT rebate;
+    bool type;
+    TEST_DT strike;
+    TEST_DT s;          // spot
+    TEST_DT q;          // dividend
+    TEST_DT r;          // risk-free rate
+    TEST_DT t;          // time to maturity
+    TEST_DT v;          // volatility
+    unsigned int steps; // monitoring dates
+    TEST_DT result;     // reference price
+    TEST_DT tol;        // tolerance of the price
+    TEST_DT maxError;   // bound of the standard error, well below that of pseudo-random paths
+};
+
+int main(int argc, const char* argv[]) {
+    // cmd parser
+    ArgParser parser(argc, argv);
+    std::string mode;
+    std::string xclbin_path;
+    std::string mode_emu = "hw";
+#ifndef HLS_TEST
+    if (!parser.getCmdOption("-xclbin", xclbin_path)) {
+        std::cout << "ERROR:xclbin path is not set!\n";
+        return 1;
+    }
+
+    if (std::getenv("XCL_EMULATION_MODE") != nullptr) {
+        mode_emu = std::getenv("XCL_EMULATION_MODE");
+    }
+    std::cout << "[INFO]Running in " << mode_emu << " mode" << std::endl;
+#endif
+    // Allocate Memory in Host Memory
+    TEST_DT* outputs = aligned_alloc<TEST_DT>(QMC_OUTDEP);
+    unsigned int* seed = aligned_alloc<unsigned int>(1);
+
+    // -------------setup k0 params---------------
+    // 16 randomized replications of 4096 paths each. Pseudo-random paths have a standard error of about 0.057 for the
+    // European and barrier options and 0.0015 for the Asian option with the same 65536 paths.
+    QMCOptionData values[] = {
+        // style, barrierType,             barrier, rebate, type, strike, s, q, r, t, vol, steps, result, tol, maxErr
+        {0, xf::fintech::enums::BarrierType::DownOut, 0, 0, 0, 100, 100, 0.0, 0.05, 1, 0.20, 1, 10.4506, 0.001, 0.005},
+        {1, xf::fintech::enums::BarrierType::DownOut, 0, 0, 0, 100, 100, 0.0, 0.05, 1, 0.20, 16, 5.7015, 0.001, 0.001},
+        {2, xf::fintech::enums::BarrierType::DownOut, 85, 0, 0, 100, 100, 0.0, 0.05, 1, 0.20, 16, 10.2095, 0.005,
+         0.02}};
+
+    unsigned int requiredSamples = 4096;
+    unsigned int replications = 16;
+    int test_nm = 3;
+    if (mode_emu == "hw_emu") {
+        test_nm = 1;
+        requiredSamples = 1024;
+        replications = 2;
+    }
+    // do pre-process on CPU
+    struct timeval start_time, end_time;
+    // platform related operations
+    std::vector<cl::Device> devices = xcl::get_xil_devices();
+    cl::Device device = devices[0];
+
+    // Creating Context and Command Queue for selected Device
+    cl::Context context(device);
+    cl::CommandQueue q(context, device, CL_QUEUE_PROFILING_ENABLE | CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE);
+    std::string devName = device.getInfo<CL_DEVICE_NAME>();
+    printf("Found Device=%s\n", devName.c_str());
+
+    cl::Program::Binaries xclBins = xcl::import_binary_file(xclbin_path);
+    devices.resize(1);
+    cl::Program program(context, devices, xclBins);
+    cl::Kernel kernel_Engine(program, "MCQMCEngine_k0");
+    std::cout << "kernel has been created" << std::endl;
+
+    cl_mem_ext_ptr_t mext_o[2];
+    mext_o[0].obj = outputs;
+    mext_o[0].param = 0;
+
+    mext_o[1].obj = seed;
+    mext_o[1].param = 0;
+    for (int i = 0; i < 2; ++i) {
+#ifndef USE_HBM
+        mext_o[i].flags = XCL_MEM_DDR_BANK0;
+#else
+        mext_o[i].flags = XCL_BANK0;
+#endif
+    }
+
+    // create device buffer and map dev buf to host buf
+    cl::Buffer output_buf;
+    cl::Buffer seed_buf;
+    output_buf = cl::Buffer(context, CL_MEM_EXT_PTR_XILINX | CL_MEM_USE_HOST_PTR | CL_MEM_READ_WRITE,
+                            QMC_OUTDEP * sizeof(TEST_DT), &mext_o[0]);
+    seed_buf = cl::Buffer(context, CL_MEM_EXT_PTR_XILINX | CL_MEM_USE_HOST_PTR | CL_MEM_READ_WRITE,
+                          sizeof(unsigned int), &mext_o[1]);
+
+    for (int i = 0; i < test_nm; ++i) {
+        seed[0] = 7;
+
+        std::vector<cl::Memory> ob_in;
+        ob_in.push_back(seed_buf);
+        std::vector<cl::Memory> ob_out;
+        ob_out.push_back(output_buf);
+
+        q.enqueueMigrateMemObjects(ob_in, 0, nullptr, nullptr);
+        q.finish();
+        // launch kernel and calculate kernel execution time
+        std::cout << "kernel start------" << std::endl;
+        gettimeofday(&start_time, 0);
+        int j = 0;
+        kernel_Engine.setArg(j++, values[i].s);
+        kernel_Engine.setArg(j++, values[i].v);
+        kernel_Engine.setArg(j++, values[i].q);
+        kernel_Engine.setArg(j++, values[i].r);
+        kernel_Engine.setArg(j++, values[i].t);
+        kernel_Engine.setArg(j++, values[i].barrier);
+        kernel_Engine.setArg(j++, values[i].strike);
+        kernel_Engine.setArg(j++, (int)values[i].barrierType);
+        kernel_Engine.setArg(j++, (int)values[i].type);
+        kernel_Engine.setArg(j++, values[i].style);
+        kernel_Engine.setArg(j++, seed_buf);
+        kernel_Engine.setArg(j++, output_buf);
+        kernel_Engine.setArg(j++, values[i].rebate);
+        kernel_Engine.setArg(j++, requiredSamples);
+        kernel_Engine.setArg(j++, values[i].steps);
+        kernel_Engine.setArg(j++, replications);
+
+        q.enqueueTask(kernel_Engine, nullptr, nullptr);
+
+        q.finish();
+        gettimeofday(&end_time, 0);
+        std::cout << "kernel end------" << std::endl;
+        std::cout << "Execution time " << tvdiff(&start_time, &end_time) << "us" << std::endl;
+        q.enqueueMigrateMemObjects(ob_out, 1, nullptr, nullptr);
+        q.finish();
+        std::cout << "price=" << outputs[0] << ", standard error=" << outputs[1] << std::endl;
+        if (mode_emu == "hw_emu") {
+            continue;
+        }
+        // the replications must agree far better than pseudo-random paths would
+        if (outputs[1] <= 0 || outputs[1] > values[i].maxError) {
+            std::cout << "Standard error " << outputs[1] << " is out of (0, " << values[i].maxError << "]!"
+                      << std::endl;
+            return -1;
+        }
+        TEST_DT error = std::fabs(values[i].result - outputs[0]) / values[i].result;
+        if (error > values[i].tol) {
+            std::cout << "Output is wrong!" << std::endl;
+            std::cout << "Acutal value: " << outputs[0] << ", Expected value: " << values[i].result
+                      << ", Relative error: " << error << std::endl;
+            return -1;
+        }
+    }
+    return 0;
+}
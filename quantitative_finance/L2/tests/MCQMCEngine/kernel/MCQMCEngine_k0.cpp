@@ -0,0 +1,88 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mcengine_top.hpp"
+#ifndef __SYNTHESIS__
+#include <iostream>
+#endif
+
+extern "C" void MCQMCEngine_k0(TEST_DT underlying,
+                               TEST_DT volatility,
+                               TEST_DT dividendYield,
+                               TEST_DT riskFreeRate,
+                               TEST_DT timeLength, // Model Parameter
+                               TEST_DT barrier,
+                               TEST_DT strike,
+                               int barrierType,
+                               int optionType, // option parameter.
+                               int style,
+                               unsigned int* seed,
+                               TEST_DT* output,
+                               TEST_DT rebate,
+                               unsigned int requiredSamples,
+                               unsigned int timeSteps,
+                               unsigned int replications) {
+#pragma HLS INTERFACE m_axi port = output bundle = gmem0 offset = slave
+#pragma HLS INTERFACE m_axi port = seed bundle = gmem1 offset = slave
+
+#pragma HLS INTERFACE s_axilite port = underlying bundle = control
+#pragma HLS INTERFACE s_axilite port = volatility bundle = control
+#pragma HLS INTERFACE s_axilite port = dividendYield bundle = control
+#pragma HLS INTERFACE s_axilite port = riskFreeRate bundle = control
+#pragma HLS INTERFACE s_axilite port = timeLength bundle = control
+#pragma HLS INTERFACE s_axilite port = barrier bundle = control
+#pragma HLS INTERFACE s_axilite port = strike bundle = control
+#pragma HLS INTERFACE s_axilite port = barrierType bundle = control
+#pragma HLS INTERFACE s_axilite port = optionType bundle = control
+#pragma HLS INTERFACE s_axilite port = style bundle = control
+#pragma HLS INTERFACE s_axilite port = seed bundle = control
+#pragma HLS INTERFACE s_axilite port = output bundle = control
+#pragma HLS INTERFACE s_axilite port = rebate bundle = control
+#pragma HLS INTERFACE s_axilite port = requiredSamples bundle = control
+#pragma HLS INTERFACE s_axilite port = timeSteps bundle = control
+#pragma HLS INTERFACE s_axilite port = replications bundle = control
+#pragma HLS INTERFACE s_axilite port = return bundle = control
+
+    ap_uint<32> seed1 = seed[0];
+    bool optionType1 = optionType;
+    TEST_DT out[QMC_OUTDEP];
+#ifndef __SYNTHESIS__
+    std::cout << "seed[0]=" << seed1 << std::endl;
+    std::cout << "underlying=" << underlying << ",volatility=" << volatility << ",dividendYield=" << dividendYield
+              << ",riskFreeRate=" << riskFreeRate << ",timeLength=" << timeLength << ",barrier=" << barrier
+              << ",strike=" << strike << ",barrierType=" << barrierType << ",optionType=" << optionType1
+              << ",style=" << style << ",rebate=" << rebate << ",requiredSamples=" << requiredSamples
+              << ",timeSteps=" << timeSteps << ",replications=" << replications << std::endl;
+#endif
+    if (style == 0) {
+        xf::fintech::MCEuropeanQMCEngine<TEST_DT, 1>(underlying, volatility, dividendYield, riskFreeRate, timeLength,
+                                                     strike, optionType1, seed1, out, requiredSamples, replications);
+    } else if (style == 1) {
+        xf::fintech::MCAsianArithmeticAPQMCEngine<TEST_DT, 1>(underlying, volatility, dividendYield, riskFreeRate,
+                                                              timeLength, strike, optionType1, seed1, out,
+                                                              requiredSamples, timeSteps, replications);
+    } else {
+        xf::fintech::MCBarrierQMCEngine<TEST_DT, 1>(underlying, volatility, dividendYield, riskFreeRate, timeLength,
+                                                    barrier, strike, barrierType, optionType1, seed1, out, rebate,
+                                                    requiredSamples, timeSteps, replications);
+    }
+    for (int i = 0; i < QMC_OUTDEP; i++) {
+#pragma HLS pipeline II = 1
+        output[i] = out[i];
+    }
+#ifndef __SYNTHESIS__
+    std::cout << "price=" << out[0] << ",stderr=" << out[1] << std::endl;
+#endif
+}
@@ -0,0 +1,213 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _XF_FINTECH_CALIBRATION_H_
+#define _XF_FINTECH_CALIBRATION_H_
+
+#include <vector>
+
+#include "models/xf_fintech_hcf.hpp"
+#include "models/xf_fintech_m76.hpp"
+
+namespace xf {
+namespace fintech {
+
+/**
+ * @class Calibration
+ *
+ * @brief Levenberg-Marquardt calibration of a closed form model to quoted call prices.
+ *
+ * Several underlyings are calibrated together, each with its own quotes and parameters. Every iteration makes two
+ * calls of the pricing model, whatever the number of underlyings and quotes: one prices all the quotes with the
+ * parameters bumped one by one, for the finite difference Jacobian, and one prices all the quotes with the steps of
+ * three damping factors, keeping the best one.
+ */
+class Calibration {
+   public:
+    /**
+     * A quoted call option
+     */
+    struct Quote {
+        float K;      // strike price
+        float T;      // expiration time
+        float price;  // quoted price
+        float weight; // weight of the price error
+    };
+
+    /**
+     * An underlying and its quotes
+     */
+    struct Underlying {
+        float s0; // stock price at t=0
+        float r;  // risk free interest rate
+        std::vector<Quote> quotes;
+    };
+
+    /**
+     * The state of the calibration of one underlying
+     */
+    struct Result {
+        int iterations; // iterations done
+        double rmse;    // root mean square of the weighted price errors
+        bool converged; // false if the maximum number of iterations was reached first, or no step decreased the error
+    };
+
+    virtual ~Calibration();
+
+    /**
+     * Set the maximum number of iterations.
+     */
+    void setMaxIterations(int maxIterations);
+
+    /**
+     * Set the tolerance, the calibration stops once an iteration decreases the sum of square errors by less than
+     * this fraction.
+     */
+    void setTolerance(double tolerance);
+
+    /**
+     * Set the size of the finite difference bumps, relative to the parameters.
+     */
+    void setBumpSize(double bumpSize);
+
+    int getMaxIterations();
+    double getTolerance();
+    double getBumpSize();
+
+   protected:
+    /**
+     * @param numParams number of model parameters
+     * @param lower lower bound of each parameter
+     * @param upper upper bound of each parameter
+     */
+    Calibration(int numParams, const double* lower, const double* upper);
+
+    /**
+     * Calibrate the parameters of each underlying, starting from the given parameters.
+     *
+     * @param underlyings the underlyings and their quotes
+     * @param numUnderlyings number of underlyings
+     * @param params numUnderlyings sets of numParams parameters, the initial guess on input
+     * @param results the state of each calibration
+     */
+    int solve(const Underlying* underlyings, int numUnderlyings, double* params, Result* results);
+
+    /**
+     * Price all the quotes of underlyings[index[k]] with the parameters params[k * numParams], for each k, in one call
+     * of the model. The prices are returned one set after the other.
+     */
+    virtual int price(const Underlying* underlyings,
+                      const std::vector<int>& index,
+                      const std::vector<double>& params,
+                      std::vector<float>& prices) = 0;
+
+   private:
+    int m_numParams;
+    std::vector<double> m_lower;
+    std::vector<double> m_upper;
+
+    int m_maxIterations;
+    double m_tolerance;
+    double m_bumpSize;
+};
+
+/**
+ * @class hcfCalibration
+ *
+ * @brief Calibrates the Heston model priced by hcf.
+ *
+ * The hcf object must have claimed its device, and is not released by hcfCalibration.
+ */
+class hcfCalibration : public Calibration {
+   public:
+    struct hcf_parameters {
+        float v0;    // stock price variance at t=0
+        float kappa; // rate of reversion
+        float vbar;  // long term average variance (theta)
+        float vvol;  // volatility of volatility (sigma)
+        float rho;   // correlation of the 2 Weiner processes
+    };
+
+    hcfCalibration(hcf* model);
+    virtual ~hcfCalibration();
+
+    /**
+     * Calibrate the Heston parameters of one or more underlyings.
+     *
+     * @param underlyings the underlyings and their quotes
+     * @param params the initial guess on input, the calibrated parameters on output, one per underlying
+     * @param results the state of each calibration
+     * @param numUnderlyings number of underlyings
+     */
+    int run(const Underlying* underlyings, struct hcf_parameters* params, Result* results, int numUnderlyings);
+
+   private:
+    static const int NUM_PARAMS = 5;
+
+    int price(const Underlying* underlyings,
+              const std::vector<int>& index,
+              const std::vector<double>& params,
+              std::vector<float>& prices);
+
+    hcf* m_pModel;
+    std::vector<struct hcf::hcf_input_data> m_inputData;
+};
+
+/**
+ * @class m76Calibration
+ *
+ * @brief Calibrates the Merton 76 jump diffusion model priced by m76.
+ *
+ * The m76 object must have claimed its device, and is not released by m76Calibration.
+ */
+class m76Calibration : public Calibration {
+   public:
+    struct m76_parameters {
+        float sigma;  // stock price volatility
+        float lambda; // mean jump per unit time
+        float kappa;  // expected[Y-1] Y is the random variable
+        float delta;  // root of variance of ln(Y)
+    };
+
+    m76Calibration(m76* model);
+    virtual ~m76Calibration();
+
+    /**
+     * Calibrate the jump diffusion parameters of one or more underlyings.
+     *
+     * @param underlyings the underlyings and their quotes
+     * @param params the initial guess on input, the calibrated parameters on output, one per underlying
+     * @param results the state of each calibration
+     * @param numUnderlyings number of underlyings
+     */
+    int run(const Underlying* underlyings, struct m76_parameters* params, Result* results, int numUnderlyings);
+
+   private:
+    static const int NUM_PARAMS = 4;
+
+    int price(const Underlying* underlyings,
+              const std::vector<int>& index,
+              const std::vector<double>& params,
+              std::vector<float>& prices);
+
+    m76* m_pModel;
+    std::vector<struct m76::m76_input_data> m_inputData;
+};
+
+} // end namespace fintech
+} // end namespace xf
+
+#endif /* _XF_FINTECH_CALIBRATION_H_ */
@@ -0,0 +1,136 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _XF_FINTECH_CF_BLACK_SCHOLES_IMPLIED_VOL_H_
+#define _XF_FINTECH_CF_BLACK_SCHOLES_IMPLIED_VOL_H_
+
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include "xf_fintech_device.hpp"
+#include "xf_fintech_ocl_controller.hpp"
+#include "xf_fintech_types.hpp"
+
+namespace xf {
+namespace fintech {
+
+/**
+ * @class CFBlackScholesImpliedVol
+ *
+ * @brief This class implements the inverse of the Closed Form Black Scholes Merton model, it calculates the
+ * volatility implied by option prices.
+ *
+ * @details The parameter passed to the constructor controls the size of the
+ * underlying buffers that will be allocated.
+ * This parameter therefore controls the maximum number of assets that can be
+ * processed per call to run()
+ *
+ * It is intended that the user will populate the input buffers with appropriate
+ * asset data prior to calling run()
+ * When run completes, the implied volatilities will be available in the
+ * output buffer. Prices outside the no-arbitrage bounds give a volatility of 0.
+ */
+class CFBlackScholesImpliedVol : public OCLController {
+   public:
+    CFBlackScholesImpliedVol(unsigned int maxAssetsPerRun);
+    virtual ~CFBlackScholesImpliedVol();
+
+   public:
+    /**
+     * @param KDataType This is the data type that the underlying HW kernel has
+     * been built with.
+     *
+     */
+    typedef float KDataType;
+
+   public: // INPUT BUFFERS
+    KDataType* stockPrice;
+    KDataType* optionPrice;
+    KDataType* strikePrice;
+    KDataType* riskFreeRate;
+    KDataType* timeToMaturity;
+    KDataType* dividendYield;
+
+   public: // OUTPUT BUFFERS
+    KDataType* volatility;
+
+   public:
+    /**
+     * This method is used to begin processing the asset data that is in the input
+     * buffers.
+     * If this function returns successfully, the implied volatilities are available in
+     * the output buffer.
+     *
+     * @param optionType The option type of ALL the option prices
+     * @param numAssets The number of assets to process.
+     */
+    int run(OptionType optionType, unsigned int numAssets);
+
+   public:
+    /**
+     * This method returns the time the execution of the last call to run() took
+     *
+     * @returns Execution time in microseconds
+     */
+    long long int getLastRunTime(void); // in microseconds
+
+   private:
+    // OCLController interface
+    int createOCLObjects(Device* device);
+    int releaseOCLObjects(void);
+
+   private:
+    void allocateBuffers(unsigned int numRequestedElements);
+    void deallocateBuffers(void);
+
+   private:
+    unsigned int calculatePaddedNumElements(unsigned int numRequestedElements);
+    std::string getXCLBINName(Device* device);
+
+   private:
+    unsigned int m_numPaddedBufferElements;
+
+    static const unsigned int KERNEL_PARAMETER_BITWIDTH = 512;
+    static const unsigned int NUM_ELEMENTS_PER_BUFFER_CHUNK;
+
+   private:
+    cl::Context* m_pContext;
+    cl::Program::Binaries m_binaries;
+    cl::Program* m_pProgram;
+    cl::CommandQueue* m_pCommandQueue;
+    cl::Kernel* m_pKernel;
+
+   private:
+    cl::Buffer* m_pStockPriceHWBuffer;
+    cl::Buffer* m_pOptionPriceHWBuffer;
+    cl::Buffer* m_pStrikePriceHWBuffer;
+    cl::Buffer* m_pRiskFreeRateHWBuffer;
+    cl::Buffer* m_pTimeToMaturityHWBuffer;
+    cl::Buffer* m_pDividendYieldHWBuffer;
+
+    cl::Buffer* m_pVolatilityHWBuffer;
+
+   private:
+    std::chrono::time_point<std::chrono::high_resolution_clock> m_runStartTime;
+    std::chrono::time_point<std::chrono::high_resolution_clock> m_runEndTime;
+};
+
+} // end namespace fintech
+} // end namespace xf
+
+#endif
@@ -0,0 +1,226 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _XF_FINTECH_CF_BLACK_SCHOLES_PORTFOLIO_H_
+#define _XF_FINTECH_CF_BLACK_SCHOLES_PORTFOLIO_H_
+
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "xf_fintech_device.hpp"
+#include "xf_fintech_ocl_controller.hpp"
+#include "xf_fintech_types.hpp"
+
+namespace xf {
+namespace fintech {
+
+/**
+ * @class CFBlackScholesPortfolio
+ *
+ * @brief This class keeps a portfolio of options in device memory and reprices
+ * them with the Closed Form Black Scholes model as the market moves.
+ *
+ * @details The trades do not hold their market inputs, they refer to entries of
+ * the spot price, volatility and risk free rate tables, so trades on the same
+ * underlying share the same entries. The trades are copied to the device once,
+ * when they are added. Each market update marks the trades which depend on the
+ * changed entry, and reprice() only copies the changed entries and the list of
+ * marked trades, and only prices these trades.
+ *
+ * The parameters passed to the constructor control the size of the
+ * underlying buffers that will be allocated, that is the maximum number of
+ * trades and of entries of each market table. The kernel holds up to 4096
+ * entries of each table.
+ */
+class CFBlackScholesPortfolio : public OCLController {
+   public:
+    CFBlackScholesPortfolio(unsigned int maxTrades, unsigned int maxMarketInputs);
+    virtual ~CFBlackScholesPortfolio();
+
+   public:
+    /**
+     * @param KDataType This is the data type that the underlying HW kernel has
+     * been built with.
+     *
+     */
+    typedef float KDataType;
+
+    /**
+     * An option of the portfolio
+     */
+    struct Trade {
+        unsigned int underlying;   // entry of the spot price table
+        unsigned int volatility;   // entry of the volatility table
+        unsigned int riskFreeRate; // entry of the risk free rate table
+        KDataType strikePrice;
+        KDataType timeToMaturity;
+        OptionType optionType;
+        KDataType quantity; // number of options held, weights the trade in the value of the portfolio
+    };
+
+    /**
+     * The price and Greeks of a repriced trade
+     */
+    struct Result {
+        unsigned int trade;    // index of the trade, in the order it was added
+        KDataType price;       // price of one option
+        KDataType priceChange; // change of the price since the trade was last priced, the price if never priced
+        KDataType valueChange; // priceChange times the quantity of the trade
+        KDataType delta;
+        KDataType gamma;
+        KDataType vega;
+        KDataType theta;
+        KDataType rho;
+    };
+
+   public:
+    /**
+     * Add a trade to the portfolio, it is priced by the next call to reprice().
+     *
+     * @param trade The trade, its market entries must be below maxMarketInputs
+     * @param tradeId The index of the trade
+     */
+    int addTrade(const Trade& trade, unsigned int* tradeId);
+
+    /**
+     * Set an entry of the spot price table, and mark the trades on that underlying if the price changed.
+     */
+    int setSpotPrice(unsigned int underlying, KDataType value);
+
+    /**
+     * Set an entry of the volatility table, and mark the trades which use it if the volatility changed.
+     */
+    int setVolatility(unsigned int index, KDataType value);
+
+    /**
+     * Set an entry of the risk free rate table, and mark the trades which use it if the rate changed.
+     */
+    int setRiskFreeRate(unsigned int index, KDataType value);
+
+    /**
+     * This method prices the trades which were added or marked by a market update since the last call.
+     * Every market entry used by these trades must have been set before.
+     *
+     * @param results The price and Greeks of each trade priced, in the order the trades were marked, empty if no
+     * trade needed to be priced
+     */
+    int reprice(std::vector<Result>& results);
+
+   public:
+    unsigned int getNumTrades(void);
+
+    /**
+     * @returns The number of trades the next call to reprice() will price
+     */
+    unsigned int getNumDirtyTrades(void);
+
+    /**
+     * @returns The last price of a trade, 0 if it was never priced
+     */
+    KDataType getPrice(unsigned int tradeId);
+
+    /**
+     * @returns The sum of the last prices of the trades times their quantities
+     */
+    double getValue(void);
+
+   public:
+    /**
+     * This method returns the time the execution of the last call to reprice() took
+     *
+     * @returns Execution time in microseconds
+     */
+    long long int getLastRunTime(void); // in microseconds
+
+   private:
+    // OCLController interface
+    int createOCLObjects(Device* device);
+    int releaseOCLObjects(void);
+
+   private:
+    void allocateBuffers(unsigned int maxTrades, unsigned int maxMarketInputs);
+    void deallocateBuffers(void);
+
+   private:
+    /**
+     * A market table, its host copy and device buffer, the trades which depend on each entry, and the range of the
+     * entries changed since the last call to reprice()
+     */
+    struct MarketTable {
+        KDataType* values;
+        std::vector<std::vector<unsigned int> > dependents;
+        unsigned int changedBegin;
+        unsigned int changedEnd;
+        cl::Buffer* pHWBuffer;
+    };
+
+    int setMarketInput(MarketTable& table, unsigned int index, KDataType value);
+    void markDirty(unsigned int tradeId);
+    int writeMarketTable(MarketTable& table);
+    std::string getXCLBINName(Device* device);
+
+   private:
+    // number of 32 bit fields of a trade or result word of the kernel
+    static const unsigned int WORD_FIELDS = 8;
+    // size of the market tables of the kernel
+    static const unsigned int MAX_MARKET_INPUTS = 4096;
+
+    unsigned int m_maxTrades;
+    unsigned int m_maxMarketInputs;
+
+    // host copies of the device buffers
+    uint32_t* m_trades;
+    uint32_t* m_dirty;
+    KDataType* m_results;
+
+    MarketTable m_spotPrice;
+    MarketTable m_volatility;
+    MarketTable m_riskFreeRate;
+
+    unsigned int m_numTrades;
+    unsigned int m_numUploadedTrades;
+    unsigned int m_numDirty;
+    unsigned int m_numMarketInputs;
+
+    std::vector<bool> m_isDirty;
+    std::vector<bool> m_isPriced;
+    std::vector<KDataType> m_prices;
+    std::vector<KDataType> m_quantities;
+
+   private:
+    cl::Context* m_pContext;
+    cl::Program::Binaries m_binaries;
+    cl::Program* m_pProgram;
+    cl::CommandQueue* m_pCommandQueue;
+    cl::Kernel* m_pKernel;
+
+   private:
+    cl::Buffer* m_pTradesHWBuffer;
+    cl::Buffer* m_pDirtyHWBuffer;
+    cl::Buffer* m_pResultsHWBuffer;
+
+   private:
+    std::chrono::time_point<std::chrono::high_resolution_clock> m_runStartTime;
+    std::chrono::time_point<std::chrono::high_resolution_clock> m_runEndTime;
+};
+
+} // end namespace fintech
+} // end namespace xf
+
+#endif
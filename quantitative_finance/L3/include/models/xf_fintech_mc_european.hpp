@@ -17,6 +17,8 @@
 #define _XF_FINTECH_MC_EUROPEAN_H_
 
 #include <chrono>
+#include <future>
+#include <mutex>
 #include <string>
 
 #include "xf_fintech_ocl_controller.hpp"
@@ -142,6 +144,62 @@ class MCEuropean : public OCLController {
             double* outputOptionPrice,
             unsigned int numAssets);
 
+    /**
+     * Submits arrays of asset data, to be processed until required TOLERANCE is met, without blocking.
+     * The arrays must stay valid until the returned future is ready.
+     *
+     * @param optionType either American/European Call or Put
+     * @param stockPrice the stock price
+     * @param strikePrice the strike price
+     * @param riskFreeRate the risk free interest rate
+     * @param dividendYield the dividend yield
+     * @param volatility the volatility
+     * @param timeToMaturity the time to maturity
+     * @param requiredTolerance the required tolerance
+     * @param outputOptionPrice the option price
+     * @param numAssets the number of assets
+     *
+     * @returns a future holding the return value of run()
+     */
+    std::future<int> submit(OptionType* optionType,
+                            double* stockPrice,
+                            double* strikePrice,
+                            double* riskFreeRate,
+                            double* dividendYield,
+                            double* volatility,
+                            double* timeToMaturity,
+                            double* requiredTolerance,
+                            double* outputOptionPrice,
+                            unsigned int numAssets);
+
+    /**
+     * Submits arrays of asset data, to be processed for the REQUIRED NUMBER OF SAMPLES, without blocking.
+     * The arrays must stay valid until the returned future is ready.
+     *
+     * @param optionType either American/European Call or Put
+     * @param stockPrice the stock price
+     * @param strikePrice the strike price
+     * @param riskFreeRate the risk free interest rate
+     * @param dividendYield the dividend yield
+     * @param volatility the volatility
+     * @param timeToMaturity the time to maturity
+     * @param requiredSamples the number of samples
+     * @param outputOptionPrice the option price
+     * @param numAssets the number of assets
+     *
+     * @returns a future holding the return value of run()
+     */
+    std::future<int> submit(OptionType* optionType,
+                            double* stockPrice,
+                            double* strikePrice,
+                            double* riskFreeRate,
+                            double* dividendYield,
+                            double* volatility,
+                            double* timeToMaturity,
+                            unsigned int* requiredSamples,
+                            double* outputOptionPrice,
+                            unsigned int numAssets);
+
    public:
     /**
      * This method returns the time the execution of the last call to run() took
@@ -168,7 +226,7 @@ class MCEuropean : public OCLController {
                     unsigned int requiredSamples,
                     double* pOptionPrice);
 
-    // Run multiple asset values...
+    // Run multiple asset values, NUM_KERNELS at a time, while the results of the previous chunk are read back...
     int runInternal(OptionType* optionType,
                     double* stockPrice,
                     double* strikePrice,
@@ -194,15 +252,21 @@ class MCEuropean : public OCLController {
 
     cl::Kernel* m_pKernels[NUM_KERNELS];
 
-    void* m_hostOutputBuffers[NUM_KERNELS];
+    // output buffers are double buffered, so the kernels run the next chunk while a chunk is read back
+    static const int NUM_BUFFER_SETS = 2;
+
+    void* m_hostOutputBuffers[NUM_BUFFER_SETS][NUM_KERNELS];
     unsigned int* m_hostSeed;
 
-    cl_mem_ext_ptr_t m_hwBufferOptions[NUM_KERNELS];
+    cl_mem_ext_ptr_t m_hwBufferOptions[NUM_BUFFER_SETS][NUM_KERNELS];
     cl_mem_ext_ptr_t m_hwSeed;
 
-    cl::Buffer* m_pHWBuffers[NUM_KERNELS];
+    cl::Buffer* m_pHWBuffers[NUM_BUFFER_SETS][NUM_KERNELS];
     cl::Buffer* m_pSeedBuf;
 
+    // serializes the runs of blocking and submitted calls
+    std::mutex m_runMutex;
+
    private:
     std::chrono::time_point<std::chrono::high_resolution_clock> m_runStartTime;
     std::chrono::time_point<std::chrono::high_resolution_clock> m_runEndTime;
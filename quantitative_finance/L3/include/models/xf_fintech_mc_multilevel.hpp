@@ -0,0 +1,212 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _XF_FINTECH_MC_EUROPEAN_H_
+#ifndef _XF_FINTECH_MC_MULTILEVEL_H_
+#define _XF_FINTECH_MC_MULTILEVEL_H_
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "xf_fintech_ocl_controller.hpp"
+#include "xf_fintech_types.hpp"
+
+namespace xf {
+namespace fintech {
+
+/**
+ * @class MCMultiLevel
+ *
+ * @brief This class implements the multilevel Monte-Carlo estimate of barrier and arithmetic average price Asian
+ * options, under the Black-Scholes model.
+ *
+ * @details Level l simulates paths of baseSteps * 2^l steps, and each of them is priced along with the coarse path
+ * of the previous level driven by the same Brownian increments. The price is the sum over the levels of the mean
+ * difference of the fine and coarse prices, whose variances decrease with the level, so most samples are taken on
+ * the cheap coarse levels. The driver adds levels until the bias estimated from the last levels is small enough, and
+ * sets the samples of each level so that the root mean square error meets the target at the least cost.
+ */
+class MCMultiLevel : public OCLController {
+   public:
+    MCMultiLevel();
+    virtual ~MCMultiLevel();
+
+   public:
+    /**
+     * @typedef BarrierType
+     *
+     * The type of the barrier, in the encoding of the HW kernel
+     */
+    typedef enum { DownIn = 0, DownOut = 1, UpIn = 2, UpOut = 3 } BarrierType;
+
+    /**
+     * The estimates of one level
+     */
+    struct LevelResult {
+        unsigned int steps;   // time steps of the fine paths
+        unsigned int samples; // number of samples
+        double mean;          // mean difference of the fine and coarse prices, fine price on level 0
+        double variance;      // variance of the difference
+    };
+
+    /**
+     * Set the number of time steps of level 0, default 4.
+     */
+    void setBaseSteps(unsigned int baseSteps);
+
+    /**
+     * Set the finest level, default 10. The driver stops there even if the estimated bias is still too large.
+     */
+    void setMaxLevel(unsigned int maxLevel);
+
+    /**
+     * Set the number of samples of the first run of each level, which estimates its variance, default 8192.
+     */
+    void setInitialSamples(unsigned int initialSamples);
+
+    unsigned int getBaseSteps(void);
+    unsigned int getMaxLevel(void);
+    unsigned int getInitialSamples(void);
+
+    /**
+     * Prices an arithmetic average price Asian option to the target root mean square error. The average includes the
+     * stock price at time 0 and at each time step.
+     *
+     * @param optionType either Call or Put
+     * @param stockPrice the stock price
+     * @param strikePrice the strike price
+     * @param riskFreeRate the risk free interest rate
+     * @param dividendYield the dividend yield
+     * @param volatility the volatility
+     * @param timeToMaturity the time to maturity
+     * @param targetRMSE the target root mean square error of the price
+     * @param pOptionPrice the returned option price
+     * @param pLevels if not null, returns the estimates of each level
+     */
+    int runAsian(OptionType optionType,
+                 double stockPrice,
+                 double strikePrice,
+                 double riskFreeRate,
+                 double dividendYield,
+                 double volatility,
+                 double timeToMaturity,
+                 double targetRMSE,
+                 double* pOptionPrice,
+                 std::vector<LevelResult>* pLevels = nullptr);
+
+    /**
+     * Prices a barrier option to the target root mean square error. The continuously monitored barrier is the limit
+     * of the levels.
+     *
+     * @param optionType either Call or Put
+     * @param barrierType the type of the barrier
+     * @param barrier the barrier
+     * @param rebate the rebate paid when the option is not triggered
+     * @param stockPrice the stock price
+     * @param strikePrice the strike price
+     * @param riskFreeRate the risk free interest rate
+     * @param dividendYield the dividend yield
+     * @param volatility the volatility
+     * @param timeToMaturity the time to maturity
+     * @param targetRMSE the target root mean square error of the price
+     * @param pOptionPrice the returned option price
+     * @param pLevels if not null, returns the estimates of each level
+     */
+    int runBarrier(OptionType optionType,
+                   BarrierType barrierType,
+                   double barrier,
+                   double rebate,
+                   double stockPrice,
+                   double strikePrice,
+                   double riskFreeRate,
+                   double dividendYield,
+                   double volatility,
+                   double timeToMaturity,
+                   double targetRMSE,
+                   double* pOptionPrice,
+                   std::vector<LevelResult>* pLevels = nullptr);
+
+   public:
+    /**
+     * This method returns the time the execution of the last call to run() took
+     *
+     * @returns Execution time in microseconds
+     */
+    long long int getLastRunTime(void);
+
+   private:
+    // OCLController interface
+    int createOCLObjects(Device* device);
+    int releaseOCLObjects(void);
+
+   private:
+    // the kernel arguments of an option
+    struct KernelParams {
+        int isBarrier;
+        int optionType;
+        int barrierType;
+        float barrier;
+        float rebate;
+        float stockPrice;
+        float strikePrice;
+        float riskFreeRate;
+        float dividendYield;
+        float volatility;
+        float timeToMaturity;
+    };
+
+    // the running sums of a level
+    struct LevelSums {
+        double sum;
+        double squareSum;
+        unsigned int samples;
+    };
+
+    int runLevel(const KernelParams& params, unsigned int level, unsigned int samples, LevelSums* pSums);
+    int solve(const KernelParams& params, double targetRMSE, double* pOptionPrice, std::vector<LevelResult>* pLevels);
+
+    std::string getXCLBINName(Device* device);
+
+   private:
+    unsigned int m_baseSteps;
+    unsigned int m_maxLevel;
+    unsigned int m_initialSamples;
+    unsigned int m_nextSeed;
+
+    cl::Context* m_pContext;
+    cl::CommandQueue* m_pCommandQueue;
+    cl::Program::Binaries m_binaries;
+    cl::Program* m_pProgram;
+    cl::Kernel* m_pKernel;
+
+    float* m_hostOutputBuffer;
+    unsigned int* m_hostSeed;
+
+    cl_mem_ext_ptr_t m_hwOutputBufferOptions;
+    cl_mem_ext_ptr_t m_hwSeedOptions;
+
+    cl::Buffer* m_pOutputBuffer;
+    cl::Buffer* m_pSeedBuffer;
+
+   private:
+    std::chrono::time_point<std::chrono::high_resolution_clock> m_runStartTime;
+    std::chrono::time_point<std::chrono::high_resolution_clock> m_runEndTime;
+};
+
+} // end namespace fintech
+} // end namespace xf
+
+#endif //_XF_FINTECH_MC_MULTILEVEL_H_
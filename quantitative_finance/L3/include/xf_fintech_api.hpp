@@ -21,6 +21,7 @@
 
 #include "xcl2.hpp"
 
+#include "xf_fintech_controller_pool.hpp"
 #include "xf_fintech_device_manager.hpp"
 #include "xf_fintech_device.hpp"
 #include "xf_fintech_error_codes.hpp"
@@ -30,15 +31,19 @@
 
 #include "models/xf_fintech_cf_black_scholes.hpp"
 #include "models/xf_fintech_cf_black_scholes_merton.hpp"
+#include "models/xf_fintech_cf_black_scholes_implied_vol.hpp"
+#include "models/xf_fintech_cf_black_scholes_portfolio.hpp"
 #include "models/xf_fintech_cf_garman_kohlhagen.hpp"
 #include "models/xf_fintech_quanto.hpp"
 #include "models/xf_fintech_fd_heston.hpp"
 #include "models/xf_fintech_mc_european.hpp"
 #include "models/xf_fintech_mc_european_dje.hpp"
 #include "models/xf_fintech_mc_american.hpp"
+#include "models/xf_fintech_mc_multilevel.hpp"
 #include "models/xf_fintech_binomialtree.hpp"
 #include "models/xf_fintech_hcf.hpp"
 #include "models/xf_fintech_m76.hpp"
+#include "models/xf_fintech_calibration.hpp"
 #include "models/xf_fintech_pop_mcmc.hpp"
 
 #endif //_XF_FINTECH_API_H_
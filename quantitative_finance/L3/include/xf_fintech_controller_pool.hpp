@@ -0,0 +1,219 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _XF_FINTECH_CONTROLLER_POOL_H_
+#define _XF_FINTECH_CONTROLLER_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "xf_fintech_device.hpp"
+#include "xf_fintech_error_codes.hpp"
+
+namespace xf {
+namespace fintech {
+
+/**
+ * @class OCLControllerPool
+ *
+ * @brief Owns one model object per device, and spreads batches of work over all of them.
+ *
+ * A batch is cut into slices that the devices take one after the other, so a faster card simply takes more slices
+ * and no card waits for the others between chunks. Batches are submitted without blocking, and several batches may
+ * be in flight at once; each device runs one slice at a time.
+ *
+ * @tparam t_Model an OCLController subclass, e.g. MCEuropean
+ */
+template <class t_Model>
+class OCLControllerPool {
+   public:
+    /**
+     * Task run on one slice [begin, end) of a batch, with the model of the device that took the slice
+     */
+    typedef std::function<int(t_Model* model, unsigned int begin, unsigned int end)> Task;
+
+    OCLControllerPool() {}
+    virtual ~OCLControllerPool() { releaseDevices(); }
+
+    OCLControllerPool(const OCLControllerPool&) = delete;
+    OCLControllerPool& operator=(const OCLControllerPool&) = delete;
+
+    /**
+     * Claims every device of the list, typically DeviceManager::getDeviceList(), after the submitted batches are done
+     *
+     * @param deviceList the devices to claim
+     */
+    int claimDevices(const std::vector<Device*>& deviceList) {
+        int retval = XLNX_OK;
+        std::unique_lock<std::mutex> lock(m_poolMutex);
+        waitForBatches(lock);
+
+        for (Device* device : deviceList) {
+            std::unique_ptr<t_Model> model(new t_Model());
+
+            retval = model->claimDevice(device);
+            if (retval != XLNX_OK) {
+                break; // out of loop
+            }
+
+            m_models.push_back(std::move(model));
+            m_modelMutexes.push_back(std::unique_ptr<std::mutex>(new std::mutex()));
+        }
+
+        if (retval != XLNX_OK) {
+            releaseModels();
+        }
+
+        return retval;
+    }
+
+    /**
+     * Releases all the devices, after the submitted batches are done
+     */
+    int releaseDevices(void) {
+        std::unique_lock<std::mutex> lock(m_poolMutex);
+        waitForBatches(lock);
+        return releaseModels();
+    }
+
+    /**
+     * Returns the number of devices in the pool
+     */
+    unsigned int getNumDevices(void) {
+        std::lock_guard<std::mutex> lock(m_poolMutex);
+        return m_models.size();
+    }
+
+    /**
+     * Submits a batch of numItems items without blocking
+     *
+     * The returned future holds XLNX_OK once every slice is done, or the last error returned by a slice.
+     * The batch runs on the devices claimed when it is submitted, and releaseDevices() waits for it.
+     *
+     * @param numItems the number of items in the batch
+     * @param sliceSize the number of items passed to each call of task
+     * @param task the function run on each slice
+     */
+    std::future<int> submit(unsigned int numItems, unsigned int sliceSize, Task task) {
+        std::vector<t_Model*> models;
+        std::vector<std::mutex*> modelMutexes;
+        {
+            std::lock_guard<std::mutex> lock(m_poolMutex);
+            for (unsigned int i = 0; i < m_models.size(); i++) {
+                models.push_back(m_models[i].get());
+                modelMutexes.push_back(m_modelMutexes[i].get());
+            }
+            m_numBatches++;
+        }
+
+        return std::async(std::launch::async, [this, numItems, sliceSize, task, models, modelMutexes]() {
+            BatchGuard guard(this);
+
+            if (models.empty() || sliceSize == 0) {
+                return XLNX_ERROR_OCL_CONTROLLER_DOES_NOT_OWN_ANY_DEVICE;
+            }
+
+            std::atomic<unsigned int> nextItem(0);
+            std::vector<std::future<int> > workers;
+
+            for (unsigned int i = 0; i < models.size(); i++) {
+                t_Model* model = models[i];
+                std::mutex* modelMutex = modelMutexes[i];
+                workers.push_back(std::async(std::launch::async, [model, modelMutex, numItems, sliceSize, &task,
+                                                                  &nextItem]() {
+                    int retval = XLNX_OK;
+
+                    while (retval == XLNX_OK) {
+                        unsigned int begin = nextItem.fetch_add(sliceSize);
+                        if (begin >= numItems) {
+                            break; // out of loop
+                        }
+                        unsigned int end = (numItems - begin > sliceSize) ? begin + sliceSize : numItems;
+
+                        std::lock_guard<std::mutex> lock(*modelMutex);
+                        retval = task(model, begin, end);
+                    }
+
+                    return retval;
+                }));
+            }
+
+            int retval = XLNX_OK;
+            for (auto& worker : workers) {
+                int ret = worker.get();
+                if (ret != XLNX_OK) {
+                    retval = ret;
+                }
+            }
+
+            return retval;
+        });
+    }
+
+   private:
+    /**
+     * Counts a submitted batch as done when its task returns, also if a slice throws
+     */
+    class BatchGuard {
+       public:
+        explicit BatchGuard(OCLControllerPool* pool) : m_pool(pool) {}
+        ~BatchGuard() {
+            std::lock_guard<std::mutex> lock(m_pool->m_poolMutex);
+            m_pool->m_numBatches--;
+            m_pool->m_batchesDone.notify_all();
+        }
+
+       private:
+        OCLControllerPool* m_pool;
+    };
+
+    void waitForBatches(std::unique_lock<std::mutex>& lock) {
+        m_batchesDone.wait(lock, [this]() { return m_numBatches == 0; });
+    }
+
+    int releaseModels(void) {
+        int retval = XLNX_OK;
+
+        for (unsigned int i = 0; i < m_models.size(); i++) {
+            int ret = m_models[i]->releaseDevice();
+            if (ret != XLNX_OK) {
+                retval = ret;
+            }
+        }
+        m_models.clear();
+        m_modelMutexes.clear();
+
+        return retval;
+    }
+
+    std::vector<std::unique_ptr<t_Model> > m_models;
+    std::vector<std::unique_ptr<std::mutex> > m_modelMutexes;
+
+    // guards m_models, m_modelMutexes and m_numBatches
+    std::mutex m_poolMutex;
+    std::condition_variable m_batchesDone;
+    unsigned int m_numBatches = 0;
+};
+
+} // end namespace fintech
+} // end namespace xf
+
+#endif //_XF_FINTECH_CONTROLLER_POOL_H_
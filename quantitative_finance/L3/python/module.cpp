@@ -218,6 +218,66 @@ PYBIND11_MODULE(xf_fintech_python, m) {
             return retval;
         });
 
+    py::class_<MCMultiLevel> mcMultiLevel(m, "MCMultiLevel");
+    mcMultiLevel.def(py::init())
+        .def("claimDevice", &MCMultiLevel::claimDevice, py::call_guard<py::scoped_ostream_redirect>())
+        .def("releaseDevice", &MCMultiLevel::releaseDevice, py::call_guard<py::scoped_ostream_redirect>())
+        .def("deviceIsPrepared", &MCMultiLevel::deviceIsPrepared, py::call_guard<py::scoped_ostream_redirect>())
+        .def("lastruntime", &MCMultiLevel::getLastRunTime)
+        .def("setBaseSteps", &MCMultiLevel::setBaseSteps)
+        .def("setMaxLevel", &MCMultiLevel::setMaxLevel)
+        .def("setInitialSamples", &MCMultiLevel::setInitialSamples)
+
+        .def("runAsian",
+             [](MCMultiLevel& self, OptionType optionType, double stockPrice, double strikePrice, double riskFreeRate,
+                double dividendYield, double volatility, double timeToMaturity, double targetRMSE,
+                py::list levelList) {
+                 int retval;
+                 double optionPrice;
+                 std::vector<MCMultiLevel::LevelResult> levels;
+
+                 py::scoped_ostream_redirect outStream(std::cout, py::module::import("sys").attr("stdout"));
+
+                 retval = self.runAsian(optionType, stockPrice, strikePrice, riskFreeRate, dividendYield, volatility,
+                                        timeToMaturity, targetRMSE, &optionPrice, &levels);
+
+                 for (unsigned int i = 0; retval == XLNX_OK && i < levels.size(); i++) {
+                     levelList.append(
+                         py::make_tuple(levels[i].steps, levels[i].samples, levels[i].mean, levels[i].variance));
+                 }
+
+                 return std::make_tuple(retval, optionPrice);
+             })
+
+        .def("runBarrier",
+             [](MCMultiLevel& self, OptionType optionType, MCMultiLevel::BarrierType barrierType, double barrier,
+                double rebate, double stockPrice, double strikePrice, double riskFreeRate, double dividendYield,
+                double volatility, double timeToMaturity, double targetRMSE, py::list levelList) {
+                 int retval;
+                 double optionPrice;
+                 std::vector<MCMultiLevel::LevelResult> levels;
+
+                 py::scoped_ostream_redirect outStream(std::cout, py::module::import("sys").attr("stdout"));
+
+                 retval = self.runBarrier(optionType, barrierType, barrier, rebate, stockPrice, strikePrice,
+                                          riskFreeRate, dividendYield, volatility, timeToMaturity, targetRMSE,
+                                          &optionPrice, &levels);
+
+                 for (unsigned int i = 0; retval == XLNX_OK && i < levels.size(); i++) {
+                     levelList.append(
+                         py::make_tuple(levels[i].steps, levels[i].samples, levels[i].mean, levels[i].variance));
+                 }
+
+                 return std::make_tuple(retval, optionPrice);
+             });
+
+    py::enum_<MCMultiLevel::BarrierType>(mcMultiLevel, "BarrierType")
+        .value("DownIn", MCMultiLevel::DownIn)
+        .value("DownOut", MCMultiLevel::DownOut)
+        .value("UpIn", MCMultiLevel::UpIn)
+        .value("UpOut", MCMultiLevel::UpOut)
+        .export_values();
+
     py::class_<BinomialTreeInputDataType<double> >(m, "BinomialTreeInputDataTypeDouble")
         .def(py::init())
         .def_readwrite("S", &BinomialTreeInputDataType<double>::S)
@@ -436,6 +496,43 @@ PYBIND11_MODULE(xf_fintech_python, m) {
                  return retval;
              });
 
+    py::class_<CFBlackScholesImpliedVol>(m, "CFBlackScholesImpliedVol")
+        .def(py::init<unsigned int>())
+
+        .def("claimDevice", &CFBlackScholesImpliedVol::claimDevice, py::call_guard<py::scoped_ostream_redirect>())
+        .def("releaseDevice", &CFBlackScholesImpliedVol::releaseDevice, py::call_guard<py::scoped_ostream_redirect>())
+        .def("deviceIsPrepared", &CFBlackScholesImpliedVol::deviceIsPrepared,
+             py::call_guard<py::scoped_ostream_redirect>())
+        .def("lastruntime", &CFBlackScholesImpliedVol::getLastRunTime)
+
+        .def("run",
+             [](CFBlackScholesImpliedVol& self, std::vector<float> stockPriceList, std::vector<float> optionPriceList,
+                std::vector<float> strikePriceList, std::vector<float> riskFreeRateList,
+                std::vector<float> timeToMaturityList, std::vector<float> dividendYieldList,
+                // Above are Input Buffers   - Below is the Output Buffer
+                py::list volatilityList, OptionType optionType, unsigned int numAssets)
+
+             {
+                 int retval;
+
+                 py::scoped_ostream_redirect outStream(std::cout, py::module::import("sys").attr("stdout"));
+                 for (unsigned int i = 0; i < numAssets; i++) {
+                     self.stockPrice[i] = stockPriceList[i];
+                     self.optionPrice[i] = optionPriceList[i];
+                     self.strikePrice[i] = strikePriceList[i];
+                     self.riskFreeRate[i] = riskFreeRateList[i];
+                     self.timeToMaturity[i] = timeToMaturityList[i];
+                     self.dividendYield[i] = dividendYieldList[i];
+                 }
+                 retval = self.run(optionType, numAssets);
+
+                 for (unsigned int i = 0; retval == XLNX_OK && i < numAssets; i++) {
+                     volatilityList.append(self.volatility[i]);
+                 }
+
+                 return retval;
+             });
+
     py::class_<CFQuanto>(m, "Quanto")
         .def(py::init<unsigned int>())
 
@@ -0,0 +1,446 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "xf_fintech_error_codes.hpp"
+
+#include "models/xf_fintech_calibration.hpp"
+
+using namespace xf::fintech;
+
+namespace {
+
+// damping factors tried at each iteration, relative to the current one
+const int NUM_DAMPINGS = 3;
+const double DAMPING_FACTORS[NUM_DAMPINGS] = {0.1, 1.0, 10.0};
+
+const double INITIAL_DAMPING = 1e-3;
+// no step decreases the error any more, at the precision of the model
+const double MAX_DAMPING = 1e10;
+
+// smallest parameter scale used for the bumps
+const double MIN_BUMP_SCALE = 1e-2;
+
+/*
+ * Solves (A + lambda * diag(A)) x = b, A being n x n symmetric, by Cholesky decomposition.
+ * Returns false if the damped matrix is not positive definite.
+ */
+bool dampedSolve(int n, const double* A, const double* b, double lambda, double* x) {
+    std::vector<double> L(n * n, 0.0);
+
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j <= i; j++) {
+            double s = A[i * n + j];
+            if (i == j) {
+                s += lambda * std::max(A[i * n + i], 1e-12);
+            }
+            for (int k = 0; k < j; k++) {
+                s -= L[i * n + k] * L[j * n + k];
+            }
+            if (i == j) {
+                if (!(s > 0.0)) {
+                    return false;
+                }
+                L[i * n + i] = std::sqrt(s);
+            } else {
+                L[i * n + j] = s / L[j * n + j];
+            }
+        }
+    }
+
+    for (int i = 0; i < n; i++) {
+        double s = b[i];
+        for (int k = 0; k < i; k++) {
+            s -= L[i * n + k] * x[k];
+        }
+        x[i] = s / L[i * n + i];
+    }
+    for (int i = n - 1; i >= 0; i--) {
+        double s = x[i];
+        for (int k = i + 1; k < n; k++) {
+            s -= L[k * n + i] * x[k];
+        }
+        x[i] = s / L[i * n + i];
+    }
+
+    return true;
+}
+
+double sumSquares(const Calibration::Underlying& underlying, const float* prices) {
+    double sse = 0.0;
+    for (unsigned int q = 0; q < underlying.quotes.size(); q++) {
+        double e = underlying.quotes[q].weight * ((double)prices[q] - underlying.quotes[q].price);
+        sse += e * e;
+    }
+    return sse;
+}
+
+} // namespace
+
+Calibration::Calibration(int numParams, const double* lower, const double* upper) {
+    m_numParams = numParams;
+    m_lower.assign(lower, lower + numParams);
+    m_upper.assign(upper, upper + numParams);
+
+    m_maxIterations = 100;
+    m_tolerance = 1e-6;
+    m_bumpSize = 1e-3;
+}
+
+Calibration::~Calibration() {}
+
+void Calibration::setMaxIterations(int maxIterations) {
+    m_maxIterations = maxIterations;
+}
+
+void Calibration::setTolerance(double tolerance) {
+    m_tolerance = tolerance;
+}
+
+void Calibration::setBumpSize(double bumpSize) {
+    m_bumpSize = bumpSize;
+}
+
+int Calibration::getMaxIterations() {
+    return m_maxIterations;
+}
+
+double Calibration::getTolerance() {
+    return m_tolerance;
+}
+
+double Calibration::getBumpSize() {
+    return m_bumpSize;
+}
+
+int Calibration::solve(const Underlying* underlyings, int numUnderlyings, double* params, Result* results) {
+    int retval = XLNX_OK;
+    const int P = m_numParams;
+
+    std::vector<bool> active(numUnderlyings);
+    std::vector<bool> needJacobian(numUnderlyings, true);
+    std::vector<double> sse(numUnderlyings, 0.0);
+    std::vector<double> damping(numUnderlyings, INITIAL_DAMPING);
+    std::vector<std::vector<float> > basePrices(numUnderlyings);
+    // normal equations J^T J x = -J^T r of each underlying
+    std::vector<double> JtJ(numUnderlyings * P * P);
+    std::vector<double> Jtr(numUnderlyings * P);
+
+    std::vector<int> index;
+    std::vector<double> batch;
+    std::vector<double> bumps;
+    std::vector<float> prices;
+
+    for (int i = 0; i < numUnderlyings; i++) {
+        active[i] = !underlyings[i].quotes.empty();
+        results[i].iterations = 0;
+        results[i].rmse = 0.0;
+        results[i].converged = !active[i];
+        for (int j = 0; j < P; j++) {
+            params[i * P + j] = std::min(std::max(params[i * P + j], m_lower[j]), m_upper[j]);
+        }
+        if (active[i]) {
+            index.push_back(i);
+            batch.insert(batch.end(), params + i * P, params + (i + 1) * P);
+        }
+    }
+
+    // price the initial guesses
+    if (!index.empty()) {
+        retval = price(underlyings, index, batch, prices);
+    }
+    if (retval == XLNX_OK) {
+        unsigned int offset = 0;
+        for (unsigned int k = 0; k < index.size(); k++) {
+            int i = index[k];
+            unsigned int numQuotes = underlyings[i].quotes.size();
+            basePrices[i].assign(prices.begin() + offset, prices.begin() + offset + numQuotes);
+            sse[i] = sumSquares(underlyings[i], basePrices[i].data());
+            offset += numQuotes;
+        }
+    }
+
+    for (int iter = 0; retval == XLNX_OK && iter < m_maxIterations; iter++) {
+        ////////////////////////////////////////////
+        // Jacobian, one bumped set per parameter
+        ////////////////////////////////////////////
+        index.clear();
+        batch.clear();
+        bumps.clear();
+        for (int i = 0; i < numUnderlyings; i++) {
+            if (active[i] && needJacobian[i]) {
+                for (int j = 0; j < P; j++) {
+                    double h = m_bumpSize * std::max(std::fabs(params[i * P + j]), MIN_BUMP_SCALE);
+                    if (params[i * P + j] + h > m_upper[j]) {
+                        h = -h;
+                    }
+                    index.push_back(i);
+                    batch.insert(batch.end(), params + i * P, params + (i + 1) * P);
+                    batch[batch.size() - P + j] += h;
+                    bumps.push_back(h);
+                }
+            }
+        }
+
+        if (!index.empty()) {
+            retval = price(underlyings, index, batch, prices);
+        }
+        if (retval == XLNX_OK) {
+            unsigned int offset = 0;
+            for (unsigned int k = 0; k < index.size(); k += P) {
+                int i = index[k];
+                unsigned int numQuotes = underlyings[i].quotes.size();
+                double* A = &JtJ[i * P * P];
+                double* g = &Jtr[i * P];
+                std::fill(A, A + P * P, 0.0);
+                std::fill(g, g + P, 0.0);
+                std::vector<double> J(P);
+                for (unsigned int q = 0; q < numQuotes; q++) {
+                    const Quote& quote = underlyings[i].quotes[q];
+                    for (int j = 0; j < P; j++) {
+                        J[j] = quote.weight * ((double)prices[offset + j * numQuotes + q] - basePrices[i][q]) /
+                               bumps[k + j];
+                    }
+                    double r = quote.weight * ((double)basePrices[i][q] - quote.price);
+                    for (int j = 0; j < P; j++) {
+                        for (int l = 0; l < P; l++) {
+                            A[j * P + l] += J[j] * J[l];
+                        }
+                        g[j] -= J[j] * r;
+                    }
+                }
+                needJacobian[i] = false;
+                offset += P * numQuotes;
+            }
+        }
+
+        ////////////////////////////////////////////
+        // Steps for each damping factor
+        ////////////////////////////////////////////
+        index.clear();
+        batch.clear();
+        for (int i = 0; retval == XLNX_OK && i < numUnderlyings; i++) {
+            if (active[i]) {
+                for (int d = 0; d < NUM_DAMPINGS; d++) {
+                    std::vector<double> x(P, 0.0);
+                    if (!dampedSolve(P, &JtJ[i * P * P], &Jtr[i * P], damping[i] * DAMPING_FACTORS[d], x.data())) {
+                        std::fill(x.begin(), x.end(), 0.0);
+                    }
+                    index.push_back(i);
+                    for (int j = 0; j < P; j++) {
+                        batch.push_back(std::min(std::max(params[i * P + j] + x[j], m_lower[j]), m_upper[j]));
+                    }
+                }
+            }
+        }
+
+        if (!index.empty()) {
+            retval = price(underlyings, index, batch, prices);
+        }
+        if (retval == XLNX_OK) {
+            unsigned int offset = 0;
+            for (unsigned int k = 0; k < index.size(); k += NUM_DAMPINGS) {
+                int i = index[k];
+                unsigned int numQuotes = underlyings[i].quotes.size();
+                int best = 0;
+                double bestSse = sumSquares(underlyings[i], &prices[offset]);
+                for (int d = 1; d < NUM_DAMPINGS; d++) {
+                    double s = sumSquares(underlyings[i], &prices[offset + d * numQuotes]);
+                    if (s < bestSse) {
+                        best = d;
+                        bestSse = s;
+                    }
+                }
+
+                results[i].iterations = iter + 1;
+                if (bestSse < sse[i]) {
+                    double decrease = (sse[i] - bestSse) / sse[i];
+                    std::copy(batch.begin() + (k + best) * P, batch.begin() + (k + best + 1) * P, params + i * P);
+                    basePrices[i].assign(prices.begin() + offset + best * numQuotes,
+                                         prices.begin() + offset + (best + 1) * numQuotes);
+                    sse[i] = bestSse;
+                    damping[i] *= DAMPING_FACTORS[best];
+                    needJacobian[i] = true;
+                    if (decrease < m_tolerance) {
+                        results[i].converged = true;
+                        active[i] = false;
+                    }
+                } else {
+                    // keep the Jacobian, and retry with shorter steps, a stalled step search is not a fit
+                    damping[i] *= 100.0;
+                    if (damping[i] > MAX_DAMPING) {
+                        results[i].converged = false;
+                        active[i] = false;
+                    }
+                }
+                offset += NUM_DAMPINGS * numQuotes;
+            }
+        }
+
+        if (std::find(active.begin(), active.end(), true) == active.end()) {
+            break; // out of loop
+        }
+    }
+
+    for (int i = 0; i < numUnderlyings; i++) {
+        if (!underlyings[i].quotes.empty()) {
+            results[i].rmse = std::sqrt(sse[i] / underlyings[i].quotes.size());
+        }
+    }
+
+    return retval;
+}
+
+////////////////////////////////////////////
+// Heston
+////////////////////////////////////////////
+
+namespace {
+// v0, kappa, vbar, vvol, rho
+const double HCF_LOWER[] = {1e-4, 1e-3, 1e-4, 1e-3, -0.999};
+const double HCF_UPPER[] = {4.0, 20.0, 4.0, 5.0, 0.999};
+} // namespace
+
+hcfCalibration::hcfCalibration(hcf* model) : Calibration(NUM_PARAMS, HCF_LOWER, HCF_UPPER) {
+    m_pModel = model;
+}
+
+hcfCalibration::~hcfCalibration() {}
+
+int hcfCalibration::run(const Underlying* underlyings,
+                        struct hcf_parameters* params,
+                        Result* results,
+                        int numUnderlyings) {
+    std::vector<double> p(numUnderlyings * NUM_PARAMS);
+
+    for (int i = 0; i < numUnderlyings; i++) {
+        p[i * NUM_PARAMS + 0] = params[i].v0;
+        p[i * NUM_PARAMS + 1] = params[i].kappa;
+        p[i * NUM_PARAMS + 2] = params[i].vbar;
+        p[i * NUM_PARAMS + 3] = params[i].vvol;
+        p[i * NUM_PARAMS + 4] = params[i].rho;
+    }
+
+    int retval = solve(underlyings, numUnderlyings, p.data(), results);
+
+    for (int i = 0; i < numUnderlyings; i++) {
+        params[i].v0 = p[i * NUM_PARAMS + 0];
+        params[i].kappa = p[i * NUM_PARAMS + 1];
+        params[i].vbar = p[i * NUM_PARAMS + 2];
+        params[i].vvol = p[i * NUM_PARAMS + 3];
+        params[i].rho = p[i * NUM_PARAMS + 4];
+    }
+
+    return retval;
+}
+
+int hcfCalibration::price(const Underlying* underlyings,
+                          const std::vector<int>& index,
+                          const std::vector<double>& params,
+                          std::vector<float>& prices) {
+    m_inputData.clear();
+
+    for (unsigned int k = 0; k < index.size(); k++) {
+        const Underlying& underlying = underlyings[index[k]];
+        const double* p = &params[k * NUM_PARAMS];
+        for (unsigned int q = 0; q < underlying.quotes.size(); q++) {
+            struct hcf::hcf_input_data in;
+            in.s0 = underlying.s0;
+            in.v0 = p[0];
+            in.K = underlying.quotes[q].K;
+            in.rho = p[4];
+            in.T = underlying.quotes[q].T;
+            in.r = underlying.r;
+            in.kappa = p[1];
+            in.vvol = p[3];
+            in.vbar = p[2];
+            m_inputData.push_back(in);
+        }
+    }
+
+    prices.resize(m_inputData.size());
+    return m_pModel->run(m_inputData.data(), prices.data(), m_inputData.size());
+}
+
+////////////////////////////////////////////
+// Merton 76
+////////////////////////////////////////////
+
+namespace {
+// sigma, lambda, kappa, delta
+const double M76_LOWER[] = {1e-3, 0.0, -0.99, 1e-3};
+const double M76_UPPER[] = {5.0, 10.0, 2.0, 2.0};
+} // namespace
+
+m76Calibration::m76Calibration(m76* model) : Calibration(NUM_PARAMS, M76_LOWER, M76_UPPER) {
+    m_pModel = model;
+}
+
+m76Calibration::~m76Calibration() {}
+
+int m76Calibration::run(const Underlying* underlyings,
+                        struct m76_parameters* params,
+                        Result* results,
+                        int numUnderlyings) {
+    std::vector<double> p(numUnderlyings * NUM_PARAMS);
+
+    for (int i = 0; i < numUnderlyings; i++) {
+        p[i * NUM_PARAMS + 0] = params[i].sigma;
+        p[i * NUM_PARAMS + 1] = params[i].lambda;
+        p[i * NUM_PARAMS + 2] = params[i].kappa;
+        p[i * NUM_PARAMS + 3] = params[i].delta;
+    }
+
+    int retval = solve(underlyings, numUnderlyings, p.data(), results);
+
+    for (int i = 0; i < numUnderlyings; i++) {
+        params[i].sigma = p[i * NUM_PARAMS + 0];
+        params[i].lambda = p[i * NUM_PARAMS + 1];
+        params[i].kappa = p[i * NUM_PARAMS + 2];
+        params[i].delta = p[i * NUM_PARAMS + 3];
+    }
+
+    return retval;
+}
+
+int m76Calibration::price(const Underlying* underlyings,
+                          const std::vector<int>& index,
+                          const std::vector<double>& params,
+                          std::vector<float>& prices) {
+    m_inputData.clear();
+
+    for (unsigned int k = 0; k < index.size(); k++) {
+        const Underlying& underlying = underlyings[index[k]];
+        const double* p = &params[k * NUM_PARAMS];
+        for (unsigned int q = 0; q < underlying.quotes.size(); q++) {
+            struct m76::m76_input_data in;
+            in.S = underlying.s0;
+            in.sigma = p[0];
+            in.K = underlying.quotes[q].K;
+            in.r = underlying.r;
+            in.T = underlying.quotes[q].T;
+            in.lambda = p[1];
+            in.kappa = p[2];
+            in.delta = p[3];
+            m_inputData.push_back(in);
+        }
+    }
+
+    prices.resize(m_inputData.size());
+    return m_pModel->run(m_inputData.data(), prices.data(), m_inputData.size());
+}
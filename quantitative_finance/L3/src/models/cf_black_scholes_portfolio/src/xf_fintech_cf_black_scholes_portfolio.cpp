@@ -0,0 +1,592 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <limits.h>
+#include <string.h>
+
+#include "xf_fintech_error_codes.hpp"
+#include "xf_fintech_trace.hpp"
+
+#include "models/xf_fintech_cf_black_scholes_portfolio.hpp"
+
+using namespace xf::fintech;
+
+static const char* PORTFOLIO_KERNEL_NAME = "bs_portfolio_kernel";
+
+typedef struct _XCLBINLookupElement {
+    Device::DeviceType deviceType;
+    std::string xclbinName;
+} XCLBINLookupElement;
+
+static XCLBINLookupElement XCLBIN_LOOKUP_TABLE[] = {{Device::DeviceType::U50, "bs_portfolio_kernel.xclbin"},
+                                                    {Device::DeviceType::U200, "bs_portfolio_kernel.xclbin"},
+                                                    {Device::DeviceType::U250, "bs_portfolio_kernel.xclbin"},
+                                                    {Device::DeviceType::U280, "bs_portfolio_kernel.xclbin"}};
+
+static const unsigned int NUM_XCLBIN_LOOKUP_TABLE_ENTRIES =
+    sizeof(XCLBIN_LOOKUP_TABLE) / sizeof(XCLBIN_LOOKUP_TABLE[0]);
+
+// Fields of the trade and result words of the kernel
+enum TradeField { TRADE_SPOT = 0, TRADE_VOLATILITY, TRADE_RATE, TRADE_CALL, TRADE_STRIKE, TRADE_MATURITY };
+enum ResultField { RESULT_PRICE = 0, RESULT_DELTA, RESULT_GAMMA, RESULT_VEGA, RESULT_THETA, RESULT_RHO };
+
+CFBlackScholesPortfolio::CFBlackScholesPortfolio(unsigned int maxTrades, unsigned int maxMarketInputs) {
+    m_pContext = nullptr;
+    m_pCommandQueue = nullptr;
+    m_pProgram = nullptr;
+    m_pKernel = nullptr;
+
+    m_pTradesHWBuffer = nullptr;
+    m_pDirtyHWBuffer = nullptr;
+    m_pResultsHWBuffer = nullptr;
+    m_spotPrice.pHWBuffer = nullptr;
+    m_volatility.pHWBuffer = nullptr;
+    m_riskFreeRate.pHWBuffer = nullptr;
+
+    m_numTrades = 0;
+    m_numUploadedTrades = 0;
+    m_numDirty = 0;
+    m_numMarketInputs = 0;
+
+    m_spotPrice.changedBegin = 0;
+    m_spotPrice.changedEnd = 0;
+    m_volatility.changedBegin = 0;
+    m_volatility.changedEnd = 0;
+    m_riskFreeRate.changedBegin = 0;
+    m_riskFreeRate.changedEnd = 0;
+
+    if (maxMarketInputs > MAX_MARKET_INPUTS) {
+        maxMarketInputs = MAX_MARKET_INPUTS;
+    }
+
+    this->allocateBuffers(maxTrades, maxMarketInputs);
+}
+
+CFBlackScholesPortfolio::~CFBlackScholesPortfolio() {
+    if (deviceIsPrepared()) {
+        releaseDevice();
+    }
+
+    this->deallocateBuffers();
+}
+
+std::string CFBlackScholesPortfolio::getXCLBINName(Device* device) {
+    std::string xclbinName = "UNSUPPORTED_DEVICE";
+    Device::DeviceType deviceType;
+    unsigned int i;
+    XCLBINLookupElement* pElement;
+
+    deviceType = device->getDeviceType();
+
+    for (i = 0; i < NUM_XCLBIN_LOOKUP_TABLE_ENTRIES; i++) {
+        pElement = &XCLBIN_LOOKUP_TABLE[i];
+
+        if (pElement->deviceType == deviceType) {
+            xclbinName = pElement->xclbinName;
+            break; // out of loop
+        }
+    }
+
+    return xclbinName;
+}
+
+int CFBlackScholesPortfolio::createOCLObjects(Device* device) {
+    int retval = XLNX_OK;
+    cl_int cl_retval = CL_SUCCESS;
+    std::chrono::time_point<std::chrono::high_resolution_clock> start;
+    std::chrono::time_point<std::chrono::high_resolution_clock> end;
+    std::string xclbinName;
+
+    cl::Device clDevice;
+
+    clDevice = device->getCLDevice();
+
+    m_pContext = new cl::Context(clDevice, nullptr, nullptr, nullptr, &cl_retval);
+
+    ///////////////////////////////
+    // Create COMMAND QUEUE Object
+    ///////////////////////////////
+    if (cl_retval == CL_SUCCESS) {
+        m_pCommandQueue = new cl::CommandQueue(*m_pContext, clDevice, CL_QUEUE_PROFILING_ENABLE, &cl_retval);
+    }
+
+    /////////////////
+    // Import XCLBIN
+    /////////////////
+    if (cl_retval == CL_SUCCESS) {
+        start = std::chrono::high_resolution_clock::now();
+
+        xclbinName = getXCLBINName(device);
+
+        m_binaries.clear();
+        m_binaries = xcl::import_binary_file(xclbinName);
+
+        end = std::chrono::high_resolution_clock::now();
+
+        Trace::printInfo("[XLNX] Binary Import Time = %lld microseconds\n",
+                         std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+    }
+
+    /////////////////////////
+    // Create PROGRAM Object
+    /////////////////////////
+    if (cl_retval == CL_SUCCESS) {
+        std::vector<cl::Device> devicesToProgram;
+        devicesToProgram.push_back(clDevice);
+
+        start = std::chrono::high_resolution_clock::now();
+
+        m_pProgram = new cl::Program(*m_pContext, devicesToProgram, m_binaries, nullptr, &cl_retval);
+
+        end = std::chrono::high_resolution_clock::now();
+
+        Trace::printInfo("[XLNX] Device Programming Time = %lld microseconds\n",
+                         std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+    }
+
+    /////////////////////////
+    // Create KERNEL Objects
+    /////////////////////////
+    if (cl_retval == CL_SUCCESS) {
+        m_pKernel = new cl::Kernel(*m_pProgram, PORTFOLIO_KERNEL_NAME, &cl_retval);
+    }
+
+    /////////////////////////
+    // Create BUFFER Objects
+    /////////////////////////
+
+    if (cl_retval == CL_SUCCESS) {
+        m_pTradesHWBuffer = new cl::Buffer(*m_pContext, CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY,
+                                           m_maxTrades * WORD_FIELDS * sizeof(uint32_t), m_trades, &cl_retval);
+    }
+
+    if (cl_retval == CL_SUCCESS) {
+        m_spotPrice.pHWBuffer = new cl::Buffer(*m_pContext, CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY,
+                                               m_maxMarketInputs * sizeof(KDataType), m_spotPrice.values, &cl_retval);
+    }
+
+    if (cl_retval == CL_SUCCESS) {
+        m_volatility.pHWBuffer = new cl::Buffer(*m_pContext, CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY,
+                                                m_maxMarketInputs * sizeof(KDataType), m_volatility.values,
+                                                &cl_retval);
+    }
+
+    if (cl_retval == CL_SUCCESS) {
+        m_riskFreeRate.pHWBuffer = new cl::Buffer(*m_pContext, CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY,
+                                                  m_maxMarketInputs * sizeof(KDataType), m_riskFreeRate.values,
+                                                  &cl_retval);
+    }
+
+    if (cl_retval == CL_SUCCESS) {
+        m_pDirtyHWBuffer = new cl::Buffer(*m_pContext, CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY,
+                                          m_maxTrades * sizeof(uint32_t), m_dirty, &cl_retval);
+    }
+
+    if (cl_retval == CL_SUCCESS) {
+        m_pResultsHWBuffer = new cl::Buffer(*m_pContext, CL_MEM_USE_HOST_PTR | CL_MEM_WRITE_ONLY,
+                                            m_maxTrades * WORD_FIELDS * sizeof(KDataType), m_results, &cl_retval);
+    }
+
+    if (cl_retval != CL_SUCCESS) {
+        setCLError(cl_retval);
+        Trace::printCLError(cl_retval);
+        retval = XLNX_ERROR_OPENCL_CALL_ERROR;
+    }
+
+    // the new device buffers hold nothing yet, so the trades and the market tables are copied by the next reprice()
+    m_numUploadedTrades = 0;
+    m_spotPrice.changedBegin = 0;
+    m_spotPrice.changedEnd = m_numMarketInputs;
+    m_volatility.changedBegin = 0;
+    m_volatility.changedEnd = m_numMarketInputs;
+    m_riskFreeRate.changedBegin = 0;
+    m_riskFreeRate.changedEnd = m_numMarketInputs;
+
+    return retval;
+}
+
+int CFBlackScholesPortfolio::releaseOCLObjects(void) {
+    int retval = XLNX_OK;
+    unsigned int i;
+
+    if (m_pTradesHWBuffer != nullptr) {
+        delete (m_pTradesHWBuffer);
+        m_pTradesHWBuffer = nullptr;
+    }
+
+    if (m_spotPrice.pHWBuffer != nullptr) {
+        delete (m_spotPrice.pHWBuffer);
+        m_spotPrice.pHWBuffer = nullptr;
+    }
+
+    if (m_volatility.pHWBuffer != nullptr) {
+        delete (m_volatility.pHWBuffer);
+        m_volatility.pHWBuffer = nullptr;
+    }
+
+    if (m_riskFreeRate.pHWBuffer != nullptr) {
+        delete (m_riskFreeRate.pHWBuffer);
+        m_riskFreeRate.pHWBuffer = nullptr;
+    }
+
+    if (m_pDirtyHWBuffer != nullptr) {
+        delete (m_pDirtyHWBuffer);
+        m_pDirtyHWBuffer = nullptr;
+    }
+
+    if (m_pResultsHWBuffer != nullptr) {
+        delete (m_pResultsHWBuffer);
+        m_pResultsHWBuffer = nullptr;
+    }
+
+    if (m_pKernel != nullptr) {
+        delete (m_pKernel);
+        m_pKernel = nullptr;
+    }
+
+    if (m_pProgram != nullptr) {
+        delete (m_pProgram);
+        m_pProgram = nullptr;
+    }
+
+    for (i = 0; i < m_binaries.size(); i++) {
+        std::pair<const void*, cl::size_type> binaryPair = m_binaries[i];
+        delete[](char*)(binaryPair.first);
+    }
+    m_binaries.clear();
+
+    if (m_pCommandQueue != nullptr) {
+        delete (m_pCommandQueue);
+        m_pCommandQueue = nullptr;
+    }
+
+    if (m_pContext != nullptr) {
+        delete (m_pContext);
+        m_pContext = nullptr;
+    }
+
+    return retval;
+}
+
+void CFBlackScholesPortfolio::allocateBuffers(unsigned int maxTrades, unsigned int maxMarketInputs) {
+    aligned_allocator<uint32_t> wordAllocator;
+    aligned_allocator<KDataType> allocator;
+
+    m_maxTrades = maxTrades;
+    m_maxMarketInputs = maxMarketInputs;
+
+    m_trades = wordAllocator.allocate(m_maxTrades * WORD_FIELDS);
+    m_dirty = wordAllocator.allocate(m_maxTrades);
+    m_results = allocator.allocate(m_maxTrades * WORD_FIELDS);
+
+    m_spotPrice.values = allocator.allocate(m_maxMarketInputs);
+    m_volatility.values = allocator.allocate(m_maxMarketInputs);
+    m_riskFreeRate.values = allocator.allocate(m_maxMarketInputs);
+    memset(m_spotPrice.values, 0, m_maxMarketInputs * sizeof(KDataType));
+    memset(m_volatility.values, 0, m_maxMarketInputs * sizeof(KDataType));
+    memset(m_riskFreeRate.values, 0, m_maxMarketInputs * sizeof(KDataType));
+
+    m_spotPrice.dependents.resize(m_maxMarketInputs);
+    m_volatility.dependents.resize(m_maxMarketInputs);
+    m_riskFreeRate.dependents.resize(m_maxMarketInputs);
+
+    m_isDirty.resize(m_maxTrades, false);
+    m_isPriced.resize(m_maxTrades, false);
+    m_prices.resize(m_maxTrades, 0);
+    m_quantities.resize(m_maxTrades, 0);
+}
+
+void CFBlackScholesPortfolio::deallocateBuffers(void) {
+    aligned_allocator<uint32_t> wordAllocator;
+    aligned_allocator<KDataType> allocator;
+
+    if (m_trades != nullptr) {
+        wordAllocator.deallocate(m_trades, m_maxTrades * WORD_FIELDS);
+        m_trades = nullptr;
+    }
+
+    if (m_dirty != nullptr) {
+        wordAllocator.deallocate(m_dirty, m_maxTrades);
+        m_dirty = nullptr;
+    }
+
+    if (m_results != nullptr) {
+        allocator.deallocate(m_results, m_maxTrades * WORD_FIELDS);
+        m_results = nullptr;
+    }
+
+    if (m_spotPrice.values != nullptr) {
+        allocator.deallocate(m_spotPrice.values, m_maxMarketInputs);
+        m_spotPrice.values = nullptr;
+    }
+
+    if (m_volatility.values != nullptr) {
+        allocator.deallocate(m_volatility.values, m_maxMarketInputs);
+        m_volatility.values = nullptr;
+    }
+
+    if (m_riskFreeRate.values != nullptr) {
+        allocator.deallocate(m_riskFreeRate.values, m_maxMarketInputs);
+        m_riskFreeRate.values = nullptr;
+    }
+
+    m_maxTrades = 0;
+    m_maxMarketInputs = 0;
+}
+
+void CFBlackScholesPortfolio::markDirty(unsigned int tradeId) {
+    if (!m_isDirty[tradeId]) {
+        m_isDirty[tradeId] = true;
+        m_dirty[m_numDirty++] = tradeId;
+    }
+}
+
+int CFBlackScholesPortfolio::addTrade(const Trade& trade, unsigned int* tradeId) {
+    int retval = XLNX_OK;
+    uint32_t* word;
+
+    if (m_numTrades >= m_maxTrades || trade.underlying >= m_maxMarketInputs ||
+        trade.volatility >= m_maxMarketInputs || trade.riskFreeRate >= m_maxMarketInputs) {
+        retval = XLNX_ERROR_MODEL_INTERNAL_ERROR;
+    }
+
+    if (retval == XLNX_OK) {
+        *tradeId = m_numTrades++;
+
+        word = &m_trades[*tradeId * WORD_FIELDS];
+        memset(word, 0, WORD_FIELDS * sizeof(uint32_t));
+        word[TRADE_SPOT] = trade.underlying;
+        word[TRADE_VOLATILITY] = trade.volatility;
+        word[TRADE_RATE] = trade.riskFreeRate;
+        word[TRADE_CALL] = (trade.optionType == OptionType::Call) ? 1 : 0;
+        memcpy(&word[TRADE_STRIKE], &trade.strikePrice, sizeof(KDataType));
+        memcpy(&word[TRADE_MATURITY], &trade.timeToMaturity, sizeof(KDataType));
+
+        m_spotPrice.dependents[trade.underlying].push_back(*tradeId);
+        m_volatility.dependents[trade.volatility].push_back(*tradeId);
+        m_riskFreeRate.dependents[trade.riskFreeRate].push_back(*tradeId);
+
+        m_isPriced[*tradeId] = false;
+        m_prices[*tradeId] = 0;
+        m_quantities[*tradeId] = trade.quantity;
+
+        markDirty(*tradeId);
+    }
+
+    return retval;
+}
+
+int CFBlackScholesPortfolio::setMarketInput(MarketTable& table, unsigned int index, KDataType value) {
+    int retval = XLNX_OK;
+    unsigned int i;
+
+    if (index >= m_maxMarketInputs) {
+        retval = XLNX_ERROR_MODEL_INTERNAL_ERROR;
+    }
+
+    // a republished value does not reprice anything
+    if (retval == XLNX_OK && table.values[index] != value) {
+        table.values[index] = value;
+
+        if (table.changedBegin >= table.changedEnd) {
+            table.changedBegin = index;
+            table.changedEnd = index + 1;
+        } else if (index < table.changedBegin) {
+            table.changedBegin = index;
+        } else if (index >= table.changedEnd) {
+            table.changedEnd = index + 1;
+        }
+
+        if (index >= m_numMarketInputs) {
+            m_numMarketInputs = index + 1;
+        }
+
+        for (i = 0; i < table.dependents[index].size(); i++) {
+            markDirty(table.dependents[index][i]);
+        }
+    }
+
+    return retval;
+}
+
+int CFBlackScholesPortfolio::setSpotPrice(unsigned int underlying, KDataType value) {
+    return setMarketInput(m_spotPrice, underlying, value);
+}
+
+int CFBlackScholesPortfolio::setVolatility(unsigned int index, KDataType value) {
+    return setMarketInput(m_volatility, index, value);
+}
+
+int CFBlackScholesPortfolio::setRiskFreeRate(unsigned int index, KDataType value) {
+    return setMarketInput(m_riskFreeRate, index, value);
+}
+
+int CFBlackScholesPortfolio::writeMarketTable(MarketTable& table) {
+    cl_int cl_retval = CL_SUCCESS;
+
+    // only the range of the changed entries is copied
+    if (table.changedBegin < table.changedEnd) {
+        cl_retval = m_pCommandQueue->enqueueWriteBuffer(
+            *table.pHWBuffer, CL_FALSE, table.changedBegin * sizeof(KDataType),
+            (table.changedEnd - table.changedBegin) * sizeof(KDataType), &table.values[table.changedBegin]);
+    }
+
+    // on an error the range is kept, so that the next reprice copies it again
+    if (cl_retval == CL_SUCCESS) {
+        table.changedBegin = 0;
+        table.changedEnd = 0;
+    }
+
+    return cl_retval;
+}
+
+int CFBlackScholesPortfolio::reprice(std::vector<Result>& results) {
+    int retval = XLNX_OK;
+    cl_int cl_retval = CL_SUCCESS;
+    unsigned int numMarketInputs;
+    unsigned int i;
+    KDataType* word;
+
+    m_runStartTime = std::chrono::high_resolution_clock::now();
+
+    results.clear();
+
+    if (!deviceIsPrepared()) {
+        retval = XLNX_ERROR_OCL_CONTROLLER_DOES_NOT_OWN_ANY_DEVICE;
+    }
+
+    if (retval == XLNX_OK && m_numDirty > 0) {
+        // the trades added since the last call
+        if (m_numUploadedTrades < m_numTrades) {
+            cl_retval = m_pCommandQueue->enqueueWriteBuffer(
+                *m_pTradesHWBuffer, CL_FALSE, m_numUploadedTrades * WORD_FIELDS * sizeof(uint32_t),
+                (m_numTrades - m_numUploadedTrades) * WORD_FIELDS * sizeof(uint32_t),
+                &m_trades[m_numUploadedTrades * WORD_FIELDS]);
+        }
+
+        if (cl_retval == CL_SUCCESS) {
+            cl_retval = writeMarketTable(m_spotPrice);
+        }
+
+        if (cl_retval == CL_SUCCESS) {
+            cl_retval = writeMarketTable(m_volatility);
+        }
+
+        if (cl_retval == CL_SUCCESS) {
+            cl_retval = writeMarketTable(m_riskFreeRate);
+        }
+
+        if (cl_retval == CL_SUCCESS) {
+            cl_retval = m_pCommandQueue->enqueueWriteBuffer(*m_pDirtyHWBuffer, CL_FALSE, 0,
+                                                            m_numDirty * sizeof(uint32_t), m_dirty);
+        }
+
+        if (cl_retval == CL_SUCCESS) {
+            numMarketInputs = m_numMarketInputs;
+
+            m_pKernel->setArg(0, (*m_pTradesHWBuffer));
+            m_pKernel->setArg(1, (*m_spotPrice.pHWBuffer));
+            m_pKernel->setArg(2, (*m_volatility.pHWBuffer));
+            m_pKernel->setArg(3, (*m_riskFreeRate.pHWBuffer));
+            m_pKernel->setArg(4, numMarketInputs);
+            m_pKernel->setArg(5, (*m_pDirtyHWBuffer));
+            m_pKernel->setArg(6, m_numDirty);
+            m_pKernel->setArg(7, (*m_pResultsHWBuffer));
+
+            cl_retval = m_pCommandQueue->enqueueTask(*m_pKernel);
+        }
+
+        // only the results of the trades priced are copied back
+        if (cl_retval == CL_SUCCESS) {
+            cl_retval = m_pCommandQueue->enqueueReadBuffer(
+                *m_pResultsHWBuffer, CL_TRUE, 0, m_numDirty * WORD_FIELDS * sizeof(KDataType), m_results);
+        }
+
+        if (cl_retval != CL_SUCCESS) {
+            setCLError(cl_retval);
+            Trace::printCLError(cl_retval);
+            retval = XLNX_ERROR_OPENCL_CALL_ERROR;
+        }
+    }
+
+    if (retval == XLNX_OK) {
+        m_numUploadedTrades = m_numTrades;
+
+        results.resize(m_numDirty);
+        for (i = 0; i < m_numDirty; i++) {
+            Result& result = results[i];
+            unsigned int tradeId = m_dirty[i];
+
+            word = &m_results[i * WORD_FIELDS];
+            result.trade = tradeId;
+            result.price = word[RESULT_PRICE];
+            result.priceChange = m_isPriced[tradeId] ? result.price - m_prices[tradeId] : result.price;
+            result.valueChange = result.priceChange * m_quantities[tradeId];
+            result.delta = word[RESULT_DELTA];
+            result.gamma = word[RESULT_GAMMA];
+            result.vega = word[RESULT_VEGA];
+            result.theta = word[RESULT_THETA];
+            result.rho = word[RESULT_RHO];
+
+            m_prices[tradeId] = result.price;
+            m_isPriced[tradeId] = true;
+            m_isDirty[tradeId] = false;
+        }
+        m_numDirty = 0;
+    }
+
+    m_runEndTime = std::chrono::high_resolution_clock::now();
+
+    return retval;
+}
+
+unsigned int CFBlackScholesPortfolio::getNumTrades(void) {
+    return m_numTrades;
+}
+
+unsigned int CFBlackScholesPortfolio::getNumDirtyTrades(void) {
+    return m_numDirty;
+}
+
+CFBlackScholesPortfolio::KDataType CFBlackScholesPortfolio::getPrice(unsigned int tradeId) {
+    KDataType price = 0;
+
+    if (tradeId < m_numTrades) {
+        price = m_prices[tradeId];
+    }
+
+    return price;
+}
+
+double CFBlackScholesPortfolio::getValue(void) {
+    double value = 0;
+    unsigned int i;
+
+    for (i = 0; i < m_numTrades; i++) {
+        value += (double)m_prices[i] * m_quantities[i];
+    }
+
+    return value;
+}
+
+long long int CFBlackScholesPortfolio::getLastRunTime(void) {
+    long long int duration = 0;
+
+    duration =
+        (long long int)std::chrono::duration_cast<std::chrono::microseconds>(m_runEndTime - m_runStartTime).count();
+
+    return duration;
+}
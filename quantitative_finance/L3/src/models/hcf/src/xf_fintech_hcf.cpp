@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+
 #include "xf_fintech_error_codes.hpp"
 #include "xf_fintech_trace.hpp"
 
@@ -176,45 +178,48 @@ int hcf::run(struct hcf_input_data* inputData, float* outputData, int numOptions
 
     if (retval == XLNX_OK) {
         if (deviceIsPrepared()) {
-            int num_options = numOptions;
-
-            // prepare the data
-            for (int i = 0; i < numOptions; i++) {
-                m_hostInputBuffer[i].s0 = inputData[i].s0;
-                m_hostInputBuffer[i].v0 = inputData[i].v0;
-                m_hostInputBuffer[i].K = inputData[i].K;
-                m_hostInputBuffer[i].rho = inputData[i].rho;
-                m_hostInputBuffer[i].T = inputData[i].T;
-                m_hostInputBuffer[i].r = inputData[i].r;
-                m_hostInputBuffer[i].kappa = inputData[i].kappa;
-                m_hostInputBuffer[i].vvol = inputData[i].vvol;
-                m_hostInputBuffer[i].vbar = inputData[i].vbar;
-                m_hostInputBuffer[i].dw = m_dw;
-                m_hostInputBuffer[i].w_max = m_w_max;
-            }
-
-            // Set the arguments
-            m_pHcfKernel->setArg(0, *m_pHwInputBuffer);
-            m_pHcfKernel->setArg(1, *m_pHwOutputBuffer);
-            m_pHcfKernel->setArg(2, num_options);
-
-            // Copy input data to device global memory
-            m_pCommandQueue->enqueueMigrateMemObjects({*m_pHwInputBuffer}, 0);
-            m_pCommandQueue->finish();
-
-            // Launch the Kernel
-            m_pCommandQueue->enqueueTask(*m_pHcfKernel);
-            m_pCommandQueue->finish();
-
-            // Copy Result from Device Global Memory to Host Local Memory
-            m_pCommandQueue->enqueueMigrateMemObjects({*m_pHwOutputBuffer}, CL_MIGRATE_MEM_OBJECT_HOST);
-            m_pCommandQueue->finish();
-
-            // --------------------------------
-            // Give the caller back the results
-            // --------------------------------
-            for (int i = 0; i < numOptions; i++) {
-                outputData[i] = m_hostOutputBuffer[i];
+            // larger batches than the device buffers are run one chunk after the other
+            for (int offset = 0; offset < numOptions; offset += MAX_OPTION_CALCULATIONS) {
+                int num_options = std::min(numOptions - offset, MAX_OPTION_CALCULATIONS);
+
+                // prepare the data
+                for (int i = 0; i < num_options; i++) {
+                    m_hostInputBuffer[i].s0 = inputData[offset + i].s0;
+                    m_hostInputBuffer[i].v0 = inputData[offset + i].v0;
+                    m_hostInputBuffer[i].K = inputData[offset + i].K;
+                    m_hostInputBuffer[i].rho = inputData[offset + i].rho;
+                    m_hostInputBuffer[i].T = inputData[offset + i].T;
+                    m_hostInputBuffer[i].r = inputData[offset + i].r;
+                    m_hostInputBuffer[i].kappa = inputData[offset + i].kappa;
+                    m_hostInputBuffer[i].vvol = inputData[offset + i].vvol;
+                    m_hostInputBuffer[i].vbar = inputData[offset + i].vbar;
+                    m_hostInputBuffer[i].dw = m_dw;
+                    m_hostInputBuffer[i].w_max = m_w_max;
+                }
+
+                // Set the arguments
+                m_pHcfKernel->setArg(0, *m_pHwInputBuffer);
+                m_pHcfKernel->setArg(1, *m_pHwOutputBuffer);
+                m_pHcfKernel->setArg(2, num_options);
+
+                // Copy input data to device global memory
+                m_pCommandQueue->enqueueMigrateMemObjects({*m_pHwInputBuffer}, 0);
+                m_pCommandQueue->finish();
+
+                // Launch the Kernel
+                m_pCommandQueue->enqueueTask(*m_pHcfKernel);
+                m_pCommandQueue->finish();
+
+                // Copy Result from Device Global Memory to Host Local Memory
+                m_pCommandQueue->enqueueMigrateMemObjects({*m_pHwOutputBuffer}, CL_MIGRATE_MEM_OBJECT_HOST);
+                m_pCommandQueue->finish();
+
+                // --------------------------------
+                // Give the caller back the results
+                // --------------------------------
+                for (int i = 0; i < num_options; i++) {
+                    outputData[offset + i] = m_hostOutputBuffer[i];
+                }
             }
         } else {
             retval = XLNX_ERROR_DEVICE_NOT_OWNED_BY_SPECIFIED_OCL_CONTROLLER;
@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+
 #include "xf_fintech_error_codes.hpp"
 #include "xf_fintech_trace.hpp"
 
@@ -173,42 +175,45 @@ int m76::run(struct m76_input_data* inputData, float* outputData, int numOptions
 
     if (retval == XLNX_OK) {
         if (deviceIsPrepared()) {
-            int num_options = numOptions;
-
-            // prepare the data
-            for (int i = 0; i < numOptions; i++) {
-                m_hostInputBuffer[i].S = inputData[i].S;
-                m_hostInputBuffer[i].K = inputData[i].K;
-                m_hostInputBuffer[i].r = inputData[i].r;
-                m_hostInputBuffer[i].sigma = inputData[i].sigma;
-                m_hostInputBuffer[i].T = inputData[i].T;
-                m_hostInputBuffer[i].kappa = inputData[i].kappa;
-                m_hostInputBuffer[i].lambda = inputData[i].lambda;
-                m_hostInputBuffer[i].delta = inputData[i].delta;
-            }
-
-            // Set the arguments
-            m_pM76Kernel->setArg(0, *m_pHwInputBuffer);
-            m_pM76Kernel->setArg(1, *m_pHwOutputBuffer);
-            m_pM76Kernel->setArg(2, num_options);
-
-            // Copy input data to device global memory
-            m_pCommandQueue->enqueueMigrateMemObjects({*m_pHwInputBuffer}, 0);
-            m_pCommandQueue->finish();
-
-            // Launch the Kernel
-            m_pCommandQueue->enqueueTask(*m_pM76Kernel);
-            m_pCommandQueue->finish();
-
-            // Copy Result from Device Global Memory to Host Local Memory
-            m_pCommandQueue->enqueueMigrateMemObjects({*m_pHwOutputBuffer}, CL_MIGRATE_MEM_OBJECT_HOST);
-            m_pCommandQueue->finish();
-
-            // --------------------------------
-            // Give the caller back the results
-            // --------------------------------
-            for (int i = 0; i < numOptions; i++) {
-                outputData[i] = m_hostOutputBuffer[i];
+            // larger batches than the device buffers are run one chunk after the other
+            for (int offset = 0; offset < numOptions; offset += MAX_OPTION_CALCULATIONS) {
+                int num_options = std::min(numOptions - offset, MAX_OPTION_CALCULATIONS);
+
+                // prepare the data
+                for (int i = 0; i < num_options; i++) {
+                    m_hostInputBuffer[i].S = inputData[offset + i].S;
+                    m_hostInputBuffer[i].K = inputData[offset + i].K;
+                    m_hostInputBuffer[i].r = inputData[offset + i].r;
+                    m_hostInputBuffer[i].sigma = inputData[offset + i].sigma;
+                    m_hostInputBuffer[i].T = inputData[offset + i].T;
+                    m_hostInputBuffer[i].kappa = inputData[offset + i].kappa;
+                    m_hostInputBuffer[i].lambda = inputData[offset + i].lambda;
+                    m_hostInputBuffer[i].delta = inputData[offset + i].delta;
+                }
+
+                // Set the arguments
+                m_pM76Kernel->setArg(0, *m_pHwInputBuffer);
+                m_pM76Kernel->setArg(1, *m_pHwOutputBuffer);
+                m_pM76Kernel->setArg(2, num_options);
+
+                // Copy input data to device global memory
+                m_pCommandQueue->enqueueMigrateMemObjects({*m_pHwInputBuffer}, 0);
+                m_pCommandQueue->finish();
+
+                // Launch the Kernel
+                m_pCommandQueue->enqueueTask(*m_pM76Kernel);
+                m_pCommandQueue->finish();
+
+                // Copy Result from Device Global Memory to Host Local Memory
+                m_pCommandQueue->enqueueMigrateMemObjects({*m_pHwOutputBuffer}, CL_MIGRATE_MEM_OBJECT_HOST);
+                m_pCommandQueue->finish();
+
+                // --------------------------------
+                // Give the caller back the results
+                // --------------------------------
+                for (int i = 0; i < num_options; i++) {
+                    outputData[offset + i] = m_hostOutputBuffer[i];
+                }
             }
         } else {
             retval = XLNX_ERROR_DEVICE_NOT_OWNED_BY_SPECIFIED_OCL_CONTROLLER;
@@ -16,6 +16,9 @@
 
 #include <limits.h>
 
+#include <deque>
+#include <vector>
+
 #include "xf_fintech_error_codes.hpp"
 #include "xf_fintech_trace.hpp"
 
@@ -49,8 +52,10 @@ MCEuropean::MCEuropean() {
 
     for (int i = 0; i < NUM_KERNELS; i++) {
         m_pKernels[i] = nullptr;
-        m_hostOutputBuffers[i] = nullptr;
-        m_pHWBuffers[i] = nullptr;
+        for (int b = 0; b < NUM_BUFFER_SETS; b++) {
+            m_hostOutputBuffers[b][i] = nullptr;
+            m_pHWBuffers[b][i] = nullptr;
+        }
     }
     m_pSeedBuf = nullptr;
 }
@@ -83,7 +88,7 @@ std::string MCEuropean::getXCLBINName(Device* device) {
 
 int MCEuropean::createOCLObjects(Device* device) {
     int retval = XLNX_OK;
-    unsigned int i;
+    unsigned int i, b;
     cl_int cl_retval = CL_SUCCESS;
     std::chrono::time_point<std::chrono::high_resolution_clock> start;
     std::chrono::time_point<std::chrono::high_resolution_clock> end;
@@ -155,11 +160,11 @@ int MCEuropean::createOCLObjects(Device* device) {
     //////////////////////////
     // Allocate HOST BUFFERS
     //////////////////////////
-    if (cl_retval == CL_SUCCESS) {
+    for (b = 0; b < NUM_BUFFER_SETS && cl_retval == CL_SUCCESS; b++) {
         for (i = 0; i < NUM_KERNELS; i++) {
-            m_hostOutputBuffers[i] = allocator.allocate(OUTDEP);
+            m_hostOutputBuffers[b][i] = allocator.allocate(OUTDEP);
 
-            if (m_hostOutputBuffers[i] == nullptr) {
+            if (m_hostOutputBuffers[b][i] == nullptr) {
                 cl_retval = CL_OUT_OF_HOST_MEMORY;
                 break; // out of loop
             }
@@ -175,21 +180,22 @@ int MCEuropean::createOCLObjects(Device* device) {
     ////////////////////////////
     // Setup HW BUFFER OPTIONS
     ////////////////////////////
-    if (cl_retval == CL_SUCCESS) {
+    // both buffer sets of a kernel are in the bank of that kernel
+    for (b = 0; b < NUM_BUFFER_SETS && cl_retval == CL_SUCCESS; b++) {
         if (NUM_KERNELS >= 1) {
-            m_hwBufferOptions[0] = {XCL_MEM_DDR_BANK0, m_hostOutputBuffers[0], 0};
+            m_hwBufferOptions[b][0] = {XCL_MEM_DDR_BANK0, m_hostOutputBuffers[b][0], 0};
         }
 
         if (NUM_KERNELS >= 2) {
-            m_hwBufferOptions[1] = {XCL_MEM_DDR_BANK1, m_hostOutputBuffers[1], 0};
+            m_hwBufferOptions[b][1] = {XCL_MEM_DDR_BANK1, m_hostOutputBuffers[b][1], 0};
         }
 
         if (NUM_KERNELS >= 3) {
-            m_hwBufferOptions[2] = {XCL_MEM_DDR_BANK2, m_hostOutputBuffers[2], 0};
+            m_hwBufferOptions[b][2] = {XCL_MEM_DDR_BANK2, m_hostOutputBuffers[b][2], 0};
         }
 
         if (NUM_KERNELS >= 4) {
-            m_hwBufferOptions[3] = {XCL_MEM_DDR_BANK3, m_hostOutputBuffers[3], 0};
+            m_hwBufferOptions[b][3] = {XCL_MEM_DDR_BANK3, m_hostOutputBuffers[b][3], 0};
         }
     }
 
@@ -201,11 +207,11 @@ int MCEuropean::createOCLObjects(Device* device) {
     // Allocate HW BUFFER Objects
     ////////////////////////////////
 
-    if (cl_retval == CL_SUCCESS) {
+    for (b = 0; b < NUM_BUFFER_SETS && cl_retval == CL_SUCCESS; b++) {
         for (i = 0; i < NUM_KERNELS; i++) {
-            m_pHWBuffers[i] =
+            m_pHWBuffers[b][i] =
                 new cl::Buffer(*m_pContext, CL_MEM_EXT_PTR_XILINX | CL_MEM_USE_HOST_PTR | CL_MEM_READ_WRITE,
-                               (size_t)(OUTDEP * sizeof(KDataType)), &m_hwBufferOptions[i], &cl_retval);
+                               (size_t)(OUTDEP * sizeof(KDataType)), &m_hwBufferOptions[b][i], &cl_retval);
 
             if (cl_retval != CL_SUCCESS) {
                 break; // out of loop
@@ -234,9 +240,16 @@ int MCEuropean::releaseOCLObjects(void) {
     aligned_allocator<unsigned int> allocator_seed;
 
     for (i = 0; i < NUM_KERNELS; i++) {
-        if (m_pHWBuffers[i] != nullptr) {
-            delete (m_pHWBuffers[i]);
-            m_pHWBuffers[i] = nullptr;
+        for (unsigned int b = 0; b < NUM_BUFFER_SETS; b++) {
+            if (m_pHWBuffers[b][i] != nullptr) {
+                delete (m_pHWBuffers[b][i]);
+                m_pHWBuffers[b][i] = nullptr;
+            }
+
+            if (m_hostOutputBuffers[b][i] != nullptr) {
+                allocator.deallocate((KDataType*)(m_hostOutputBuffers[b][i]), OUTDEP);
+                m_hostOutputBuffers[b][i] = nullptr;
+            }
         }
 
         if (m_pSeedBuf != nullptr) {
@@ -244,11 +257,6 @@ int MCEuropean::releaseOCLObjects(void) {
             m_pSeedBuf = nullptr;
         }
 
-        if (m_hostOutputBuffers[i] != nullptr) {
-            allocator.deallocate((KDataType*)(m_hostOutputBuffers[i]), OUTDEP);
-            m_hostOutputBuffers[i] = nullptr;
-        }
-
         if (m_hostSeed != nullptr) {
             allocator_seed.deallocate((unsigned int*)(m_hostSeed), 2);
             m_hostSeed = nullptr;
@@ -352,8 +360,7 @@ int MCEuropean::run(OptionType* optionType,
                     double* outputOptionPrice,
                     unsigned int numAssets) {
     int retval = XLNX_OK;
-    unsigned int requiredSamples[NUM_KERNELS] = {0};
-    unsigned int numKernelsToRun;
+    std::vector<unsigned int> requiredSamples(numAssets, 0);
 
     // The kernels take in BOTH requiredTolerance AND requiredSamples.
     // However only ONE is used during processing...
@@ -361,20 +368,11 @@ int MCEuropean::run(OptionType* optionType,
     // If requiredSamples == 0, the model will run for as long as necessary to
     // meet requiredTolerance
 
-    // We will process the asset data in NUM_KERNELS sized chunks...
-    for (unsigned int i = 0; i < numAssets; i += NUM_KERNELS) {
-        numKernelsToRun = numAssets - i;
-
-        // need to limit each run to the number of kernels that are present...
-        if (numKernelsToRun > NUM_KERNELS) {
-            numKernelsToRun = NUM_KERNELS;
-        }
-
-        retval = runInternal(&optionType[i], &stockPrice[i], &strikePrice[i], &riskFreeRate[i], &dividendYield[i],
-                             &volatility[i], &timeToMaturity[i], &requiredTolerance[i],
-                             requiredSamples, // <-- remember this is a LOCAL variable
-                             &outputOptionPrice[i], numKernelsToRun);
-    }
+    // runInternal processes the asset data in NUM_KERNELS sized chunks...
+    retval = runInternal(optionType, stockPrice, strikePrice, riskFreeRate, dividendYield, volatility, timeToMaturity,
+                         requiredTolerance,
+                         requiredSamples.data(), // <-- remember this is a LOCAL variable
+                         outputOptionPrice, numAssets);
 
     return retval;
 }
@@ -391,8 +389,7 @@ int MCEuropean::run(OptionType* optionType,
                     double* outputOptionPrice,
                     unsigned int numAssets) {
     int retval = XLNX_OK;
-    double requiredTolerance[NUM_KERNELS] = {0.0};
-    unsigned int numKernelsToRun;
+    std::vector<double> requiredTolerance(numAssets, 0.0);
 
     // The kernels take in BOTH requiredTolerance AND requiredSamples.
     // However only ONE is used during processing...
@@ -400,22 +397,46 @@ int MCEuropean::run(OptionType* optionType,
     // If requiredSamples == 0, the model will run for as long as necessary to
     // meet requiredTolerance
 
-    // We will process the asset data in NUM_KERNELS sized chunks...
-    for (unsigned int i = 0; i < numAssets; i += NUM_KERNELS) {
-        numKernelsToRun = numAssets - i;
+    // runInternal processes the asset data in NUM_KERNELS sized chunks...
+    retval = runInternal(optionType, stockPrice, strikePrice, riskFreeRate, dividendYield, volatility, timeToMaturity,
+                         requiredTolerance.data(), // <-- remember this is a LOCAL variable
+                         requiredSamples, outputOptionPrice, numAssets);
 
-        // need to limit each run to the number of kernels that are present...
-        if (numKernelsToRun > NUM_KERNELS) {
-            numKernelsToRun = NUM_KERNELS;
-        }
+    return retval;
+}
 
-        retval = runInternal(&optionType[i], &stockPrice[i], &strikePrice[i], &riskFreeRate[i], &dividendYield[i],
-                             &volatility[i], &timeToMaturity[i],
-                             requiredTolerance, // <-- remember this is a LOCAL variable
-                             &requiredSamples[i], &outputOptionPrice[i], numKernelsToRun);
-    }
+// MULTI asset, run to TOLERANCE, without blocking
+std::future<int> MCEuropean::submit(OptionType* optionType,
+                                    double* stockPrice,
+                                    double* strikePrice,
+                                    double* riskFreeRate,
+                                    double* dividendYield,
+                                    double* volatility,
+                                    double* timeToMaturity,
+                                    double* requiredTolerance,
+                                    double* outputOptionPrice,
+                                    unsigned int numAssets) {
+    return std::async(std::launch::async, [=]() {
+        return run(optionType, stockPrice, strikePrice, riskFreeRate, dividendYield, volatility, timeToMaturity,
+                   requiredTolerance, outputOptionPrice, numAssets);
+    });
+}
 
-    return retval;
+// MULTI asset, run to REQUIRED NUM SAMPLES, without blocking
+std::future<int> MCEuropean::submit(OptionType* optionType,
+                                    double* stockPrice,
+                                    double* strikePrice,
+                                    double* riskFreeRate,
+                                    double* dividendYield,
+                                    double* volatility,
+                                    double* timeToMaturity,
+                                    unsigned int* requiredSamples,
+                                    double* outputOptionPrice,
+                                    unsigned int numAssets) {
+    return std::async(std::launch::async, [=]() {
+        return run(optionType, stockPrice, strikePrice, riskFreeRate, dividendYield, volatility, timeToMaturity,
+                   requiredSamples, outputOptionPrice, numAssets);
+    });
 }
 
 int MCEuropean::runInternal(OptionType optionType,
@@ -511,56 +532,88 @@ int MCEuropean::runInternal(OptionType* optionType,
     unsigned int loop_nm = 1;
     KDataType totalOutput = 0.0;
     unsigned int i, j;
-    std::vector<cl::Memory> outVector;
+
+    // a chunk of up to NUM_KERNELS assets in flight, with the buffer set holding its outputs
+    struct Chunk {
+        unsigned int begin;
+        unsigned int numAssets;
+        unsigned int bufferSet;
+        cl::Event readEvent;
+    };
+    std::deque<Chunk> chunksInFlight;
+
+    std::lock_guard<std::mutex> lock(m_runMutex);
 
     m_runStartTime = std::chrono::high_resolution_clock::now();
 
     if (deviceIsPrepared()) {
-        for (i = 0; i < numAssets; i++) {
-            m_pKernels[i]->setArg(0, (KDataType)stockPrice[i]);
-            m_pKernels[i]->setArg(1, (KDataType)volatility[i]);
-            m_pKernels[i]->setArg(2, (KDataType)dividendYield[i]);
-            m_pKernels[i]->setArg(3, (KDataType)riskFreeRate[i]);
-            m_pKernels[i]->setArg(4, (KDataType)timeToMaturity[i]);
-            m_pKernels[i]->setArg(5, (KDataType)strikePrice[i]);
-            m_pKernels[i]->setArg(6, (unsigned int)optionType[i]);
-            m_pKernels[i]->setArg(7, *m_pSeedBuf);
-            m_pKernels[i]->setArg(8, *m_pHWBuffers[i]);
-            m_pKernels[i]->setArg(9, (KDataType)requiredTolerance[i]);
-            m_pKernels[i]->setArg(10, requiredSamples[i]);
-            m_pKernels[i]->setArg(11, timeSteps);
-
-            m_pCommandQueue->enqueueTask(*(m_pKernels[i]), nullptr, nullptr);
-        }
+        for (unsigned int begin = 0, c = 0; begin < numAssets || !chunksInFlight.empty(); begin += NUM_KERNELS, c++) {
+            // once both buffer sets are in use, wait for the oldest chunk and post-process it...
+            if (chunksInFlight.size() == NUM_BUFFER_SETS || (begin >= numAssets && !chunksInFlight.empty())) {
+                Chunk& chunk = chunksInFlight.front();
 
-        m_pCommandQueue->flush();
-        m_pCommandQueue->finish();
+                chunk.readEvent.wait();
 
-        for (i = 0; i < numAssets; i++) {
-            outVector.push_back(*(m_pHWBuffers[i]));
-        }
+                // ---------------
+                // Post-Processing
+                // ---------------
 
-        m_pCommandQueue->enqueueMigrateMemObjects(outVector, CL_MIGRATE_MEM_OBJECT_HOST, nullptr /*&kernel_events[i]*/,
-                                                  nullptr);
+                for (i = 0; i < chunk.numAssets; i++) {
+                    KDataType* pBuffer = (KDataType*)(m_hostOutputBuffers[chunk.bufferSet][i]);
 
-        m_pCommandQueue->flush();
-        m_pCommandQueue->finish();
+                    totalOutput = (KDataType)0.0;
 
-        // ---------------
-        // Post-Processing
-        // ---------------
+                    // sum the outputs...
+                    for (j = 0; j < loop_nm; j++) {
+                        totalOutput += pBuffer[j];
+                    }
+
+                    outputOptionPrice[chunk.begin + i] = (double)(totalOutput / (KDataType)loop_nm);
+                }
 
-        for (i = 0; i < numAssets; i++) {
-            KDataType* pBuffer = (KDataType*)(m_hostOutputBuffers[i]);
+                chunksInFlight.pop_front();
+            }
 
-            totalOutput = (KDataType)0.0;
+            if (begin >= numAssets) {
+                continue;
+            }
 
-            // sum the outputs...
-            for (j = 0; j < loop_nm; j++) {
-                totalOutput += pBuffer[j];
+            // ...then start the next chunk on the free buffer set, without waiting for it
+            Chunk chunk;
+            chunk.begin = begin;
+            chunk.numAssets = (numAssets - begin > NUM_KERNELS) ? NUM_KERNELS : numAssets - begin;
+            chunk.bufferSet = c % NUM_BUFFER_SETS;
+
+            std::vector<cl::Event> kernelEvents(chunk.numAssets);
+            std::vector<cl::Memory> outVector;
+
+            for (i = 0; i < chunk.numAssets; i++) {
+                unsigned int a = begin + i;
+
+                m_pKernels[i]->setArg(0, (KDataType)stockPrice[a]);
+                m_pKernels[i]->setArg(1, (KDataType)volatility[a]);
+                m_pKernels[i]->setArg(2, (KDataType)dividendYield[a]);
+                m_pKernels[i]->setArg(3, (KDataType)riskFreeRate[a]);
+                m_pKernels[i]->setArg(4, (KDataType)timeToMaturity[a]);
+                m_pKernels[i]->setArg(5, (KDataType)strikePrice[a]);
+                m_pKernels[i]->setArg(6, (unsigned int)optionType[a]);
+                m_pKernels[i]->setArg(7, *m_pSeedBuf);
+                m_pKernels[i]->setArg(8, *m_pHWBuffers[chunk.bufferSet][i]);
+                m_pKernels[i]->setArg(9, (KDataType)requiredTolerance[a]);
+                m_pKernels[i]->setArg(10, requiredSamples[a]);
+                m_pKernels[i]->setArg(11, timeSteps);
+
+                m_pCommandQueue->enqueueTask(*(m_pKernels[i]), nullptr, &kernelEvents[i]);
+
+                outVector.push_back(*(m_pHWBuffers[chunk.bufferSet][i]));
             }
 
-            outputOptionPrice[i] = (double)(totalOutput / (KDataType)loop_nm);
+            m_pCommandQueue->enqueueMigrateMemObjects(outVector, CL_MIGRATE_MEM_OBJECT_HOST, &kernelEvents,
+                                                      &chunk.readEvent);
+
+            m_pCommandQueue->flush();
+
+            chunksInFlight.push_back(chunk);
         }
 
     } else {
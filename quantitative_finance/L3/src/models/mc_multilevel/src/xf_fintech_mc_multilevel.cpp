@@ -0,0 +1,525 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "xf_fintech_error_codes.hpp"
+#include "xf_fintech_trace.hpp"
+
+#include "models/xf_fintech_mc_multilevel.hpp"
+
+using namespace xf::fintech;
+
+static const char* MLMC_KERNEL_NAME = "MCMultiLevelEngine_k0";
+
+// the kernel returns the mean and variance of the level, the mean of the fine price and the number of samples
+static const unsigned int MLMC_OUTDEP = 4;
+
+// the kernel counts the samples of one run in 27 bits, larger runs are split
+static const unsigned int MAX_SAMPLES_PER_RUN = 1 << 26;
+
+typedef struct _XCLBINLookupElement {
+    Device::DeviceType deviceType;
+    std::string xclbinName;
+} XCLBINLookupElement;
+
+static XCLBINLookupElement XCLBIN_LOOKUP_TABLE[] = {{Device::DeviceType::U50, "MCMultiLevelEngine_k.xclbin"},
+                                                    {Device::DeviceType::U200, "MCMultiLevelEngine_k.xclbin"},
+                                                    {Device::DeviceType::U250, "MCMultiLevelEngine_k.xclbin"},
+                                                    {Device::DeviceType::U280, "MCMultiLevelEngine_k.xclbin"}};
+
+static const unsigned int NUM_XCLBIN_LOOKUP_TABLE_ENTRIES =
+    sizeof(XCLBIN_LOOKUP_TABLE) / sizeof(XCLBIN_LOOKUP_TABLE[0]);
+
+MCMultiLevel::MCMultiLevel() {
+    m_baseSteps = 4;
+    m_maxLevel = 10;
+    m_initialSamples = 8192;
+    m_nextSeed = 1;
+
+    m_pContext = nullptr;
+    m_pCommandQueue = nullptr;
+    m_pProgram = nullptr;
+    m_pKernel = nullptr;
+
+    m_hostOutputBuffer = nullptr;
+    m_hostSeed = nullptr;
+
+    m_pOutputBuffer = nullptr;
+    m_pSeedBuffer = nullptr;
+}
+
+MCMultiLevel::~MCMultiLevel() {
+    if (deviceIsPrepared()) {
+        releaseDevice();
+    }
+}
+
+void MCMultiLevel::setBaseSteps(unsigned int baseSteps) {
+    m_baseSteps = baseSteps;
+}
+
+void MCMultiLevel::setMaxLevel(unsigned int maxLevel) {
+    m_maxLevel = maxLevel;
+}
+
+void MCMultiLevel::setInitialSamples(unsigned int initialSamples) {
+    m_initialSamples = initialSamples;
+}
+
+unsigned int MCMultiLevel::getBaseSteps(void) {
+    return m_baseSteps;
+}
+
+unsigned int MCMultiLevel::getMaxLevel(void) {
+    return m_maxLevel;
+}
+
+unsigned int MCMultiLevel::getInitialSamples(void) {
+    return m_initialSamples;
+}
+
+std::string MCMultiLevel::getXCLBINName(Device* device) {
+    std::string xclbinName = "UNSUPPORTED_DEVICE";
+    Device::DeviceType deviceType;
+    unsigned int i;
+    XCLBINLookupElement* pElement;
+
+    deviceType = device->getDeviceType();
+
+    for (i = 0; i < NUM_XCLBIN_LOOKUP_TABLE_ENTRIES; i++) {
+        pElement = &XCLBIN_LOOKUP_TABLE[i];
+
+        if (pElement->deviceType == deviceType) {
+            xclbinName = pElement->xclbinName;
+            break; // out of loop
+        }
+    }
+
+    return xclbinName;
+}
+
+int MCMultiLevel::createOCLObjects(Device* device) {
+    int retval = XLNX_OK;
+    cl_int cl_retval = CL_SUCCESS;
+    std::chrono::time_point<std::chrono::high_resolution_clock> start;
+    std::chrono::time_point<std::chrono::high_resolution_clock> end;
+    aligned_allocator<float> allocator;
+    aligned_allocator<unsigned int> allocator_seed;
+    std::string xclbinName;
+
+    cl::Device clDevice;
+
+    clDevice = device->getCLDevice();
+
+    m_pContext = new cl::Context(clDevice, nullptr, nullptr, nullptr, &cl_retval);
+
+    ///////////////////////////////
+    // Create COMMAND QUEUE Object
+    ///////////////////////////////
+    if (cl_retval == CL_SUCCESS) {
+        m_pCommandQueue = new cl::CommandQueue(*m_pContext, clDevice, CL_QUEUE_PROFILING_ENABLE, &cl_retval);
+    }
+
+    /////////////////
+    // Import XCLBIN
+    /////////////////
+    if (cl_retval == CL_SUCCESS) {
+        start = std::chrono::high_resolution_clock::now();
+
+        xclbinName = getXCLBINName(device);
+
+        m_binaries.clear();
+        m_binaries = xcl::import_binary_file(xclbinName);
+
+        end = std::chrono::high_resolution_clock::now();
+
+        Trace::printInfo("[XLNX] Binary Import Time = %lld microseconds\n",
+                         std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+    }
+
+    /////////////////////////
+    // Create PROGRAM Object
+    /////////////////////////
+    if (cl_retval == CL_SUCCESS) {
+        std::vector<cl::Device> devicesToProgram;
+        devicesToProgram.push_back(clDevice);
+
+        start = std::chrono::high_resolution_clock::now();
+
+        m_pProgram = new cl::Program(*m_pContext, devicesToProgram, m_binaries, nullptr, &cl_retval);
+
+        end = std::chrono::high_resolution_clock::now();
+
+        Trace::printInfo("[XLNX] Device Programming Time = %lld microseconds\n",
+                         std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+    }
+
+    /////////////////////////
+    // Create KERNEL Objects
+    /////////////////////////
+    if (cl_retval == CL_SUCCESS) {
+        m_pKernel = new cl::Kernel(*m_pProgram, MLMC_KERNEL_NAME, &cl_retval);
+    }
+
+    //////////////////////////
+    // Allocate HOST BUFFERS
+    //////////////////////////
+    if (cl_retval == CL_SUCCESS) {
+        m_hostOutputBuffer = allocator.allocate(MLMC_OUTDEP);
+        m_hostSeed = allocator_seed.allocate(1);
+
+        if (m_hostOutputBuffer == nullptr || m_hostSeed == nullptr) {
+            cl_retval = CL_OUT_OF_HOST_MEMORY;
+        }
+    }
+
+    ////////////////////////////////
+    // Allocate HW BUFFER Objects
+    ////////////////////////////////
+    if (cl_retval == CL_SUCCESS) {
+        m_hwOutputBufferOptions = {XCL_MEM_DDR_BANK0, m_hostOutputBuffer, 0};
+        m_hwSeedOptions = {XCL_MEM_DDR_BANK0, m_hostSeed, 0};
+
+        m_pOutputBuffer =
+            new cl::Buffer(*m_pContext, CL_MEM_EXT_PTR_XILINX | CL_MEM_USE_HOST_PTR | CL_MEM_READ_WRITE,
+                           (size_t)(MLMC_OUTDEP * sizeof(float)), &m_hwOutputBufferOptions, &cl_retval);
+    }
+
+    if (cl_retval == CL_SUCCESS) {
+        m_pSeedBuffer = new cl::Buffer(*m_pContext, CL_MEM_EXT_PTR_XILINX | CL_MEM_USE_HOST_PTR | CL_MEM_READ_WRITE,
+                                       sizeof(unsigned int), &m_hwSeedOptions, &cl_retval);
+    }
+
+    if (cl_retval != CL_SUCCESS) {
+        setCLError(cl_retval);
+        Trace::printError("[XLNX] OpenCL Error = %d\n", cl_retval);
+        retval = XLNX_ERROR_OPENCL_CALL_ERROR;
+    }
+
+    return retval;
+}
+
+int MCMultiLevel::releaseOCLObjects(void) {
+    int retval = XLNX_OK;
+    unsigned int i;
+    aligned_allocator<float> allocator;
+    aligned_allocator<unsigned int> allocator_seed;
+
+    if (m_pOutputBuffer != nullptr) {
+        delete (m_pOutputBuffer);
+        m_pOutputBuffer = nullptr;
+    }
+
+    if (m_pSeedBuffer != nullptr) {
+        delete (m_pSeedBuffer);
+        m_pSeedBuffer = nullptr;
+    }
+
+    if (m_hostOutputBuffer != nullptr) {
+        allocator.deallocate(m_hostOutputBuffer, MLMC_OUTDEP);
+        m_hostOutputBuffer = nullptr;
+    }
+
+    if (m_hostSeed != nullptr) {
+        allocator_seed.deallocate(m_hostSeed, 1);
+        m_hostSeed = nullptr;
+    }
+
+    if (m_pKernel != nullptr) {
+        delete (m_pKernel);
+        m_pKernel = nullptr;
+    }
+
+    if (m_pProgram != nullptr) {
+        delete (m_pProgram);
+        m_pProgram = nullptr;
+    }
+
+    for (i = 0; i < m_binaries.size(); i++) {
+        std::pair<const void*, cl::size_type> binaryPair = m_binaries[i];
+        delete[](char*)(binaryPair.first);
+    }
+    m_binaries.clear();
+
+    if (m_pCommandQueue != nullptr) {
+        delete (m_pCommandQueue);
+        m_pCommandQueue = nullptr;
+    }
+
+    if (m_pContext != nullptr) {
+        delete (m_pContext);
+        m_pContext = nullptr;
+    }
+
+    return retval;
+}
+
+int MCMultiLevel::runAsian(OptionType optionType,
+                           double stockPrice,
+                           double strikePrice,
+                           double riskFreeRate,
+                           double dividendYield,
+                           double volatility,
+                           double timeToMaturity,
+                           double targetRMSE,
+                           double* pOptionPrice,
+                           std::vector<LevelResult>* pLevels) {
+    KernelParams params;
+
+    params.isBarrier = 0;
+    params.optionType = (optionType == Put) ? 1 : 0;
+    params.barrierType = 0;
+    params.barrier = 0;
+    params.rebate = 0;
+    params.stockPrice = (float)stockPrice;
+    params.strikePrice = (float)strikePrice;
+    params.riskFreeRate = (float)riskFreeRate;
+    params.dividendYield = (float)dividendYield;
+    params.volatility = (float)volatility;
+    params.timeToMaturity = (float)timeToMaturity;
+
+    return solve(params, targetRMSE, pOptionPrice, pLevels);
+}
+
+int MCMultiLevel::runBarrier(OptionType optionType,
+                             BarrierType barrierType,
+                             double barrier,
+                             double rebate,
+                             double stockPrice,
+                             double strikePrice,
+                             double riskFreeRate,
+                             double dividendYield,
+                             double volatility,
+                             double timeToMaturity,
+                             double targetRMSE,
+                             double* pOptionPrice,
+                             std::vector<LevelResult>* pLevels) {
+    KernelParams params;
+
+    params.isBarrier = 1;
+    params.optionType = (optionType == Put) ? 1 : 0;
+    params.barrierType = (int)barrierType;
+    params.barrier = (float)barrier;
+    params.rebate = (float)rebate;
+    params.stockPrice = (float)stockPrice;
+    params.strikePrice = (float)strikePrice;
+    params.riskFreeRate = (float)riskFreeRate;
+    params.dividendYield = (float)dividendYield;
+    params.volatility = (float)volatility;
+    params.timeToMaturity = (float)timeToMaturity;
+
+    return solve(params, targetRMSE, pOptionPrice, pLevels);
+}
+
+int MCMultiLevel::runLevel(const KernelParams& params, unsigned int level, unsigned int samples, LevelSums* pSums) {
+    int retval = XLNX_OK;
+    std::vector<cl::Memory> inputVector;
+    std::vector<cl::Memory> outputVector;
+
+    inputVector.push_back(*m_pSeedBuffer);
+    outputVector.push_back(*m_pOutputBuffer);
+
+    while (retval == XLNX_OK && samples > 0) {
+        unsigned int runSamples = (samples > MAX_SAMPLES_PER_RUN) ? MAX_SAMPLES_PER_RUN : samples;
+        samples -= runSamples;
+
+        // every run draws its own random numbers
+        m_hostSeed[0] = m_nextSeed++;
+
+        m_pKernel->setArg(0, params.stockPrice);
+        m_pKernel->setArg(1, params.volatility);
+        m_pKernel->setArg(2, params.dividendYield);
+        m_pKernel->setArg(3, params.riskFreeRate);
+        m_pKernel->setArg(4, params.timeToMaturity);
+        m_pKernel->setArg(5, params.barrier);
+        m_pKernel->setArg(6, params.strikePrice);
+        m_pKernel->setArg(7, params.barrierType);
+        m_pKernel->setArg(8, params.optionType);
+        m_pKernel->setArg(9, params.isBarrier);
+        m_pKernel->setArg(10, *m_pSeedBuffer);
+        m_pKernel->setArg(11, *m_pOutputBuffer);
+        m_pKernel->setArg(12, params.rebate);
+        m_pKernel->setArg(13, level);
+        m_pKernel->setArg(14, m_baseSteps);
+        m_pKernel->setArg(15, runSamples);
+
+        m_pCommandQueue->enqueueMigrateMemObjects(inputVector, 0, nullptr, nullptr);
+        m_pCommandQueue->enqueueTask(*m_pKernel);
+        m_pCommandQueue->enqueueMigrateMemObjects(outputVector, CL_MIGRATE_MEM_OBJECT_HOST, nullptr, nullptr);
+        m_pCommandQueue->finish();
+
+        // the kernel rounds the samples up to whole batches
+        double mean = m_hostOutputBuffer[0];
+        double variance = m_hostOutputBuffer[1];
+        unsigned int n = (unsigned int)m_hostOutputBuffer[3];
+
+        if (n < 2) {
+            retval = XLNX_ERROR_MODEL_INTERNAL_ERROR;
+        } else {
+            pSums->sum += mean * n;
+            pSums->squareSum += variance * (n - 1) + mean * mean * n;
+            pSums->samples += n;
+        }
+    }
+
+    return retval;
+}
+
+int MCMultiLevel::solve(const KernelParams& params,
+                        double targetRMSE,
+                        double* pOptionPrice,
+                        std::vector<LevelResult>* pLevels) {
+    int retval = XLNX_OK;
+    std::vector<LevelSums> sums;
+    std::vector<unsigned int> extraSamples;
+    unsigned int numLevels;
+    bool converged = false;
+
+    m_runStartTime = std::chrono::high_resolution_clock::now();
+
+    if (!deviceIsPrepared()) {
+        retval = XLNX_ERROR_DEVICE_NOT_OWNED_BY_SPECIFIED_OCL_CONTROLLER;
+    } else if (targetRMSE <= 0.0 || m_baseSteps == 0 || (m_baseSteps << m_maxLevel) > 65535) {
+        // the kernel counts the time steps in 16 bits
+        retval = XLNX_ERROR_NOT_SUPPORTED;
+    }
+
+    // start with three levels, to estimate the convergence of the last ones
+    numLevels = (m_maxLevel < 2) ? m_maxLevel + 1 : 3;
+    for (unsigned int l = 0; l < numLevels; l++) {
+        LevelSums s = {0.0, 0.0, 0};
+        sums.push_back(s);
+        extraSamples.push_back(m_initialSamples);
+    }
+
+    while (retval == XLNX_OK && !converged) {
+        for (unsigned int l = 0; l < numLevels && retval == XLNX_OK; l++) {
+            if (extraSamples[l] > 0) {
+                retval = runLevel(params, l, extraSamples[l], &sums[l]);
+                extraSamples[l] = 0;
+            }
+        }
+
+        if (retval != XLNX_OK) {
+            break; // out of loop
+        }
+
+        // means and variances of the levels, the cost of a sample being the number of fine steps
+        std::vector<double> mean(numLevels);
+        std::vector<double> variance(numLevels);
+        double sumSqrtVC = 0.0;
+        for (unsigned int l = 0; l < numLevels; l++) {
+            mean[l] = sums[l].sum / sums[l].samples;
+            variance[l] = (sums[l].squareSum - mean[l] * sums[l].sum) / (sums[l].samples - 1);
+            if (variance[l] < 0.0) {
+                variance[l] = 0.0;
+            }
+            sumSqrtVC += std::sqrt(variance[l] * (double)(m_baseSteps << l));
+        }
+
+        // optimal samples of each level for the variance of the estimate to be half the square error
+        bool moreSamples = false;
+        for (unsigned int l = 0; l < numLevels; l++) {
+            double optimal = std::ceil(2.0 / (targetRMSE * targetRMSE) *
+                                       std::sqrt(variance[l] / (double)(m_baseSteps << l)) * sumSqrtVC);
+            if (optimal > sums[l].samples) {
+                extraSamples[l] = (unsigned int)(optimal - sums[l].samples);
+                moreSamples = true;
+            }
+        }
+
+        if (moreSamples) {
+            continue;
+        }
+
+        // weak convergence rate of the level means, at least 0.5 as for discretely monitored barriers
+        double sxx = 0.0, sxy = 0.0, sx = 0.0, sy = 0.0;
+        unsigned int n = 0;
+        for (unsigned int l = 1; l < numLevels; l++) {
+            if (mean[l] != 0.0) {
+                double y = -std::log2(std::fabs(mean[l]));
+                sx += l;
+                sy += y;
+                sxx += (double)l * l;
+                sxy += l * y;
+                n++;
+            }
+        }
+        double alpha = 0.5;
+        if (n >= 2) {
+            alpha = std::max(alpha, (n * sxy - sx * sy) / (n * sxx - sx * sx));
+        }
+
+        // remaining bias from the last two levels, which must be within half the square error
+        double rate = std::pow(2.0, alpha);
+        double bias = std::fabs(mean[numLevels - 1]);
+        if (numLevels > 2) {
+            bias = std::max(bias, std::fabs(mean[numLevels - 2]) / rate);
+        }
+        bias /= (rate - 1.0);
+
+        if (numLevels <= 1 || bias <= targetRMSE / std::sqrt(2.0)) {
+            converged = true;
+        } else if (numLevels - 1 >= m_maxLevel) {
+            Trace::printInfo("[XLNX] MCMultiLevel reached the maximum level, estimated bias = %f\n", bias);
+            converged = true;
+        } else {
+            LevelSums s = {0.0, 0.0, 0};
+            sums.push_back(s);
+            extraSamples.push_back(m_initialSamples);
+            numLevels++;
+        }
+    }
+
+    if (retval == XLNX_OK) {
+        double price = 0.0;
+
+        if (pLevels != nullptr) {
+            pLevels->clear();
+        }
+
+        for (unsigned int l = 0; l < numLevels; l++) {
+            double mean = sums[l].sum / sums[l].samples;
+            price += mean;
+
+            if (pLevels != nullptr) {
+                LevelResult result;
+                result.steps = m_baseSteps << l;
+                result.samples = sums[l].samples;
+                result.mean = mean;
+                result.variance = (sums[l].squareSum - mean * sums[l].sum) / (sums[l].samples - 1);
+                pLevels->push_back(result);
+            }
+        }
+
+        *pOptionPrice = price;
+    }
+
+    m_runEndTime = std::chrono::high_resolution_clock::now();
+
+    return retval;
+}
+
+long long int MCMultiLevel::getLastRunTime(void) {
+    long long int duration = 0;
+
+    duration =
+        (long long int)std::chrono::duration_cast<std::chrono::microseconds>(m_runEndTime - m_runStartTime).count();
+
+    return duration;
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+#include "xf_fintech_api.hpp"
+
+using namespace xf::fintech;
+
+static const unsigned int numAssets = 16;
+
+CFBlackScholesImpliedVol cfBlackScholesImpliedVol(numAssets);
+
+// Black Scholes Merton call price, to generate the option prices to invert
+static float callPrice(float s, float v, float r, float t, float k, float q) {
+    double d1 = (std::log(s / k) + (r - q + 0.5 * v * v) * t) / (v * std::sqrt(t));
+    double d2 = d1 - v * std::sqrt(t);
+    double nd1 = 0.5 * std::erfc(-d1 / std::sqrt(2.0));
+    double nd2 = 0.5 * std::erfc(-d2 / std::sqrt(2.0));
+
+    return s * std::exp(-q * t) * nd1 - k * std::exp(-r * t) * nd2;
+}
+
+int main() {
+    int retval = XLNX_OK;
+
+    std::vector<Device*> deviceList;
+    Device* pChosenDevice;
+    float inputVolatility[numAssets];
+
+    // fed in to permit hw, sw_emu, & hw_emu
+    deviceList = DeviceManager::getDeviceList(TOSTRING(DEVICE_PART));
+
+    if (deviceList.size() == 0) {
+        printf("[XLNX] No matching devices found\n");
+        exit(0);
+    }
+
+    printf("[XLNX] Found %zu matching devices\n", deviceList.size());
+
+    // we'll just pick the first device in the...
+    pChosenDevice = deviceList[0];
+
+    retval = cfBlackScholesImpliedVol.claimDevice(pChosenDevice);
+
+    if (retval == XLNX_OK) {
+        // Populate the asset data, a smile of volatilities across the strikes...
+        for (unsigned int i = 0; i < numAssets; i++) {
+            float k = 70.0f + 4.0f * i;
+            float m = std::log(k / 100.0f);
+
+            inputVolatility[i] = 0.2f - 0.1f * m + 0.5f * m * m;
+
+            cfBlackScholesImpliedVol.stockPrice[i] = 100.0f;
+            cfBlackScholesImpliedVol.strikePrice[i] = k;
+            cfBlackScholesImpliedVol.riskFreeRate[i] = 0.025f;
+            cfBlackScholesImpliedVol.timeToMaturity[i] = 1.0f;
+            cfBlackScholesImpliedVol.dividendYield[i] = 0.01f;
+            cfBlackScholesImpliedVol.optionPrice[i] = callPrice(100.0f, inputVolatility[i], 0.025f, 1.0f, k, 0.01f);
+        }
+
+        ///////////////////
+        // Run the model...
+        ///////////////////
+        retval = cfBlackScholesImpliedVol.run(OptionType::Call, numAssets);
+    }
+
+    if (retval == XLNX_OK) {
+        printf("[XLNX] +-------+----------+----------+----------+----------+\n");
+        printf("[XLNX] | Index |  Strike  |  Price   |  Input   | Implied  |\n");
+        printf("[XLNX] +-------+----------+----------+----------+----------+\n");
+
+        for (unsigned int i = 0; i < numAssets; i++) {
+            printf("[XLNX] | %5u | %8.3f | %8.5f | %8.5f | %8.5f |\n", i, cfBlackScholesImpliedVol.strikePrice[i],
+                   cfBlackScholesImpliedVol.optionPrice[i], inputVolatility[i], cfBlackScholesImpliedVol.volatility[i]);
+        }
+
+        printf("[XLNX] +-------+----------+----------+----------+----------+\n");
+        printf("[XLNX] Processed %u assets in %lld us\n", numAssets, cfBlackScholesImpliedVol.getLastRunTime());
+    }
+
+    cfBlackScholesImpliedVol.releaseDevice();
+
+    return 0;
+}
@@ -0,0 +1,154 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+#include "xf_fintech_api.hpp"
+
+using namespace xf::fintech;
+
+static const unsigned int numUnderlyings = 8;
+static const unsigned int numTrades = 64;
+
+CFBlackScholesPortfolio cfBlackScholesPortfolio(numTrades, numUnderlyings);
+
+static void printResults(const std::vector<CFBlackScholesPortfolio::Result>& results) {
+    printf("[XLNX] +-------+----------+----------+----------+----------+\n");
+    printf("[XLNX] | Trade |  Price   |  Change  |  Value   |  Delta   |\n");
+    printf("[XLNX] |       |          |          |  Change  |          |\n");
+    printf("[XLNX] +-------+----------+----------+----------+----------+\n");
+
+    for (unsigned int i = 0; i < results.size(); i++) {
+        printf("[XLNX] | %5u | %8.4f | %8.4f | %8.4f | %8.5f |\n", results[i].trade, results[i].price,
+               results[i].priceChange, results[i].valueChange, results[i].delta);
+    }
+
+    printf("[XLNX] +-------+----------+----------+----------+----------+\n");
+}
+
+int main() {
+    int retval = XLNX_OK;
+
+    std::vector<Device*> deviceList;
+    Device* pChosenDevice;
+    std::vector<CFBlackScholesPortfolio::Result> results;
+    unsigned int tradeId;
+
+    // fed in to permit hw, sw_emu, & hw_emu
+    deviceList = DeviceManager::getDeviceList(TOSTRING(DEVICE_PART));
+
+    if (deviceList.size() == 0) {
+        printf("[XLNX] No matching devices found\n");
+        exit(0);
+    }
+
+    printf("[XLNX] Found %zu matching devices\n", deviceList.size());
+
+    // we'll just pick the first device in the...
+    pChosenDevice = deviceList[0];
+
+    retval = cfBlackScholesPortfolio.claimDevice(pChosenDevice);
+
+    if (retval == XLNX_OK) {
+        // The market, each underlying has its own spot price and volatility, all share one rate...
+        for (unsigned int i = 0; i < numUnderlyings && retval == XLNX_OK; i++) {
+            retval = cfBlackScholesPortfolio.setSpotPrice(i, 50.0f + 10.0f * i);
+            if (retval == XLNX_OK) {
+                retval = cfBlackScholesPortfolio.setVolatility(i, 0.15f + 0.02f * i);
+            }
+        }
+        if (retval == XLNX_OK) {
+            retval = cfBlackScholesPortfolio.setRiskFreeRate(0, 0.025f);
+        }
+
+        // ...and the trades, a strip of strikes and maturities on each underlying
+        for (unsigned int i = 0; i < numTrades && retval == XLNX_OK; i++) {
+            CFBlackScholesPortfolio::Trade trade;
+            unsigned int underlying = i % numUnderlyings;
+
+            trade.underlying = underlying;
+            trade.volatility = underlying;
+            trade.riskFreeRate = 0;
+            trade.strikePrice = (50.0f + 10.0f * underlying) * (0.8f + 0.05f * (i / numUnderlyings));
+            trade.timeToMaturity = 0.25f * (1 + i / numUnderlyings);
+            trade.optionType = (i & 1) ? OptionType::Put : OptionType::Call;
+            trade.quantity = 100.0f;
+
+            retval = cfBlackScholesPortfolio.addTrade(trade, &tradeId);
+        }
+    }
+
+    ///////////////////////////////////////////////////////
+    // Price the whole portfolio, it is copied to the device
+    ///////////////////////////////////////////////////////
+    if (retval == XLNX_OK) {
+        retval = cfBlackScholesPortfolio.reprice(results);
+    }
+
+    if (retval == XLNX_OK) {
+        printf("[XLNX] Priced %zu trades in %lld us, portfolio value = %f\n", results.size(),
+               cfBlackScholesPortfolio.getLastRunTime(), cfBlackScholesPortfolio.getValue());
+    }
+
+    /////////////////////////////////////////////////////////////////
+    // A tick on underlying 3 only reprices the trades on underlying 3
+    /////////////////////////////////////////////////////////////////
+    if (retval == XLNX_OK) {
+        retval = cfBlackScholesPortfolio.setSpotPrice(3, 80.5f);
+    }
+
+    if (retval == XLNX_OK) {
+        retval = cfBlackScholesPortfolio.reprice(results);
+    }
+
+    if (retval == XLNX_OK) {
+        printf("[XLNX] Spot price of underlying 3 moved to 80.5\n");
+        printResults(results);
+        printf("[XLNX] Repriced %zu trades in %lld us, portfolio value = %f\n", results.size(),
+               cfBlackScholesPortfolio.getLastRunTime(), cfBlackScholesPortfolio.getValue());
+    }
+
+    ////////////////////////////////////////////////////////////////
+    // A volatility update on underlying 5 with an unchanged spot
+    ////////////////////////////////////////////////////////////////
+    if (retval == XLNX_OK) {
+        retval = cfBlackScholesPortfolio.setSpotPrice(5, 100.0f);
+    }
+
+    if (retval == XLNX_OK) {
+        retval = cfBlackScholesPortfolio.setVolatility(5, 0.27f);
+    }
+
+    if (retval == XLNX_OK) {
+        retval = cfBlackScholesPortfolio.reprice(results);
+    }
+
+    if (retval == XLNX_OK) {
+        printf("[XLNX] Volatility of underlying 5 moved to 0.27\n");
+        printResults(results);
+        printf("[XLNX] Repriced %zu trades in %lld us, portfolio value = %f\n", results.size(),
+               cfBlackScholesPortfolio.getLastRunTime(), cfBlackScholesPortfolio.getValue());
+    }
+
+    cfBlackScholesPortfolio.releaseDevice();
+
+    return 0;
+}
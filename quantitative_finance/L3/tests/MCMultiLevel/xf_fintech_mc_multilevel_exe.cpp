@@ -0,0 +1,125 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+
+#include <chrono>
+#include <vector>
+
+#include "xf_fintech_api.hpp"
+
+using namespace xf::fintech;
+
+static void printLevels(const std::vector<MCMultiLevel::LevelResult>& levels) {
+    printf("[XF_FINTECH] level     steps   samples          mean      variance\n");
+    for (unsigned int i = 0; i < levels.size(); i++) {
+        printf("[XF_FINTECH] %5u %9u %9u %13.6f %13.6e\n", i, levels[i].steps, levels[i].samples, levels[i].mean,
+               levels[i].variance);
+    }
+}
+
+int main() {
+    MCMultiLevel mcMultiLevel;
+
+    int retval = XLNX_OK;
+
+    std::chrono::time_point<std::chrono::high_resolution_clock> start;
+    std::chrono::time_point<std::chrono::high_resolution_clock> end;
+    std::vector<Device*> deviceList;
+    Device* pChosenDevice;
+
+    // device list based on DSA
+    deviceList = DeviceManager::getDeviceList(TOSTRING(DEVICE_PART));
+
+    if (deviceList.size() == 0) {
+        printf("No matching devices found\n");
+        exit(0);
+    }
+
+    printf("Found %zu matching devices\n", deviceList.size());
+
+    // we'll just pick the first device in the...
+    pChosenDevice = deviceList[0];
+
+    if (retval == XLNX_OK) {
+        // turn off trace output...turn it on here if you want extra debug output...
+        Trace::setEnabled(true);
+    }
+
+    double stockPrice = 100.0;
+    double strikePrice = 100.0;
+    double riskFreeRate = 0.05;
+    double dividendYield = 0.0;
+    double volatility = 0.2;
+    double timeToMaturity = 1.0;
+    double barrier = 85.0;
+    double rebate = 0.0;
+    double targetRMSE = 0.02;
+
+    printf("\n\n\n");
+    printf("[XF_FINTECH] MCMultiLevel trying to claim device...\n");
+
+    start = std::chrono::high_resolution_clock::now();
+
+    retval = mcMultiLevel.claimDevice(pChosenDevice);
+
+    end = std::chrono::high_resolution_clock::now();
+
+    if (retval == XLNX_OK) {
+        printf("[XF_FINTECH] Device setup time = %lld microseconds\n",
+               (long long int)std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+    } else {
+        printf("[XF_FINTECH] Failed to claim device - error = %d\n", retval);
+    }
+
+    if (retval == XLNX_OK) {
+        std::vector<MCMultiLevel::LevelResult> levels;
+        double optionPrice;
+
+        printf("[XF_FINTECH] Arithmetic Asian call, target RMSE = %f\n", targetRMSE);
+
+        retval = mcMultiLevel.runAsian(OptionType::Call, stockPrice, strikePrice, riskFreeRate, dividendYield,
+                                       volatility, timeToMaturity, targetRMSE, &optionPrice, &levels);
+
+        if (retval == XLNX_OK) {
+            printLevels(levels);
+            printf("[XF_FINTECH] OptionPrice = %f (expected 5.7470)\n", optionPrice);
+            printf("[XF_FINTECH] ExecutionTime = %lld microseconds\n", (long long int)mcMultiLevel.getLastRunTime());
+        }
+    }
+
+    if (retval == XLNX_OK) {
+        std::vector<MCMultiLevel::LevelResult> levels;
+        double optionPrice;
+
+        printf("[XF_FINTECH] Down and out barrier call, barrier = %f, target RMSE = %f\n", barrier, targetRMSE);
+
+        retval = mcMultiLevel.runBarrier(OptionType::Call, MCMultiLevel::DownOut, barrier, rebate, stockPrice,
+                                         strikePrice, riskFreeRate, dividendYield, volatility, timeToMaturity,
+                                         targetRMSE, &optionPrice, &levels);
+
+        if (retval == XLNX_OK) {
+            printLevels(levels);
+            printf("[XF_FINTECH] OptionPrice = %f (expected 10.1032 with continuous monitoring)\n", optionPrice);
+            printf("[XF_FINTECH] ExecutionTime = %lld microseconds\n", (long long int)mcMultiLevel.getLastRunTime());
+        }
+    }
+
+    printf("[XF_FINTECH] MCMultiLevel releasing device...\n");
+    retval = mcMultiLevel.releaseDevice();
+
+    return 0;
+}
@@ -0,0 +1,176 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <future>
+#include <vector>
+
+#include "xf_fintech_mc_example.hpp"
+
+#include "xf_fintech_api.hpp"
+
+using namespace xf::fintech;
+
+static const double baseStockPrice = 36.0;
+static const double baseStrikePrice = 40.0;
+static const double baseRiskFreeRate = 0.06;
+static const double baseDividendYield = 0.0;
+static const double baseVolatility = 0.20;
+static const double baseTimeToMaturity = 1.0; /* in years */
+
+static const double baseRequiredTolerance = 0.02;
+
+/* The following variable is used to vary our input data for each run....*/
+static const double varianceFactor = 0.001;
+
+static const unsigned int NUM_BATCHES = 4;
+static const unsigned int NUM_ASSETS_PER_BATCH = 1000;
+
+/* Each device takes SLICE_SIZE assets at a time, until the batch is done... */
+static const unsigned int SLICE_SIZE = 100;
+
+struct Batch {
+    std::vector<OptionType> optionType;
+    std::vector<double> stockPrice;
+    std::vector<double> strikePrice;
+    std::vector<double> riskFreeRate;
+    std::vector<double> dividendYield;
+    std::vector<double> volatility;
+    std::vector<double> timeToMaturity;
+    std::vector<double> requiredTolerance;
+    std::vector<double> optionPrice;
+};
+
+static void InitialiseInput(Batch& batch, unsigned int batchIndex) {
+    unsigned int i;
+
+    batch.optionType.assign(NUM_ASSETS_PER_BATCH, Put);
+    batch.stockPrice.resize(NUM_ASSETS_PER_BATCH);
+    batch.strikePrice.resize(NUM_ASSETS_PER_BATCH);
+    batch.riskFreeRate.resize(NUM_ASSETS_PER_BATCH);
+    batch.dividendYield.resize(NUM_ASSETS_PER_BATCH);
+    batch.volatility.resize(NUM_ASSETS_PER_BATCH);
+    batch.timeToMaturity.assign(NUM_ASSETS_PER_BATCH, baseTimeToMaturity);
+    batch.requiredTolerance.assign(NUM_ASSETS_PER_BATCH, baseRequiredTolerance);
+    batch.optionPrice.assign(NUM_ASSETS_PER_BATCH, 0.0);
+
+    for (i = 0; i < NUM_ASSETS_PER_BATCH; i++) {
+        /* We will apply some variance to our data here so we are not cacheing any
+         * values... */
+        double variance = (1.0 + (varianceFactor * (batchIndex * NUM_ASSETS_PER_BATCH + i)));
+
+        batch.stockPrice[i] = baseStockPrice * variance;
+        batch.strikePrice[i] = baseStrikePrice * variance;
+        batch.riskFreeRate[i] = baseRiskFreeRate * variance;
+        batch.dividendYield[i] = baseDividendYield * variance;
+        batch.volatility[i] = baseVolatility * variance;
+    }
+}
+
+int MCDemoRunEuropeanAsync(std::vector<Device*>& deviceList) {
+    int retval = XLNX_OK;
+    unsigned int i;
+    std::chrono::time_point<std::chrono::high_resolution_clock> start;
+    std::chrono::time_point<std::chrono::high_resolution_clock> end;
+    long long int duration;
+
+    OCLControllerPool<MCEuropean> pool;
+    std::vector<Batch> batches(NUM_BATCHES);
+    std::vector<std::future<int> > results;
+
+    printf("\n\n\n");
+
+    printf(
+        "[XLNX] "
+        "***************************************************************\n");
+    printf("[XLNX] Running MC EUROPEAN ASYNC BATCHES...\n");
+    printf(
+        "[XLNX] "
+        "***************************************************************\n");
+
+    //
+    // Claim every matching device, one MCEuropean object per device...
+    //
+    printf("[XLNX] pool trying to claim %zu devices...\n", deviceList.size());
+
+    retval = pool.claimDevices(deviceList);
+
+    if (retval != XLNX_OK) {
+        printf("[XLNX] ERROR- Failed to claim devices - error = %d\n", retval);
+    }
+
+    if (retval == XLNX_OK) {
+        for (i = 0; i < NUM_BATCHES; i++) {
+            InitialiseInput(batches[i], i);
+        }
+    }
+
+    // Submit all the batches, without waiting for the previous ones...
+    if (retval == XLNX_OK) {
+        start = std::chrono::high_resolution_clock::now();
+
+        for (i = 0; i < NUM_BATCHES; i++) {
+            Batch* pBatch = &batches[i];
+
+            OCLControllerPool<MCEuropean>::Task task = [pBatch](MCEuropean* pMCEuropean, unsigned int begin,
+                                                                unsigned int end) {
+                return pMCEuropean->run(&pBatch->optionType[begin], &pBatch->stockPrice[begin],
+                                        &pBatch->strikePrice[begin], &pBatch->riskFreeRate[begin],
+                                        &pBatch->dividendYield[begin], &pBatch->volatility[begin],
+                                        &pBatch->timeToMaturity[begin], &pBatch->requiredTolerance[begin],
+                                        &pBatch->optionPrice[begin], end - begin);
+            };
+
+            results.push_back(pool.submit(NUM_ASSETS_PER_BATCH, SLICE_SIZE, task));
+        }
+
+        // ...then collect them
+        for (i = 0; i < NUM_BATCHES; i++) {
+            int ret = results[i].get();
+            if (ret != XLNX_OK) {
+                retval = ret;
+            }
+        }
+
+        end = std::chrono::high_resolution_clock::now();
+    }
+
+    if (retval == XLNX_OK) {
+        for (i = 0; i < NUM_BATCHES; i++) {
+            printf("[XLNX] Batch %u: first option price = %8.4f, last option price = %8.4f\n", i,
+                   batches[i].optionPrice[0], batches[i].optionPrice[NUM_ASSETS_PER_BATCH - 1]);
+        }
+
+        duration = (long long int)std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+        printf("[XLNX] Overall Execution Time = %lld us on %u devices\n", duration, pool.getNumDevices());
+        printf("[XLNX] Average Execution Time Per Asset = %8.4f us\n",
+               (double)duration / (double)(NUM_BATCHES * NUM_ASSETS_PER_BATCH));
+    } else {
+        printf("[XLNX] Error running algorithm\n");
+    }
+
+    //
+    // Release the devices so other objects can claim them...
+    //
+    printf("[XLNX] pool releasing devices...\n");
+    int ret = pool.releaseDevices();
+    if (retval == XLNX_OK) {
+        retval = ret;
+    }
+
+    return retval;
+}
@@ -70,6 +70,10 @@ int main() {
         retval = MCDemoRunEuropeanMultiple2(pChosenDevice, &mcEuropean);
     }
 
+    if (retval == XLNX_OK) {
+        retval = MCDemoRunEuropeanAsync(deviceList);
+    }
+
     //////////////////////////////////////////////////////////////////////////////////////////
     // Now switch to MC American...
     //////////////////////////////////////////////////////////////////////////////////////////
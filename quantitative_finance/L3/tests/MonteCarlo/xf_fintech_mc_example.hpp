@@ -27,6 +27,8 @@ int MCDemoRunEuropeanMultiple1(Device* pChosenDevice, MCEuropean* pMCEuropean);
 
 int MCDemoRunEuropeanMultiple2(Device* pChosenDevice, MCEuropean* pMCEuropean);
 
+int MCDemoRunEuropeanAsync(std::vector<Device*>& deviceList);
+
 int MCDemoRunAmericanSingle(Device* pChosenDevice, MCAmerican* pMCAmerican);
 
 #endif /* _XF_FINTECH_MC_EXAMPLE_H_ */
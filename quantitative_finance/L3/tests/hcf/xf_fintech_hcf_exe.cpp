@@ -186,6 +186,66 @@ int main() {
         }
     }
 
+    if (retval == XLNX_OK) {
+        printf("[XF_FINTECH] Calibration to the prices of known parameters\n");
+
+        static const int numberStrikes = 5;
+        static const int numberMaturities = 4;
+        float strikes[numberStrikes] = {80.0, 90.0, 100.0, 110.0, 120.0};
+        float maturities[numberMaturities] = {0.25, 0.5, 1.0, 2.0};
+
+        hcfCalibration::hcf_parameters params = {0.1, kappa, vbar, vvol, rho};
+        hcf::hcf_input_data inputData[numberStrikes * numberMaturities];
+        float outputData[numberStrikes * numberMaturities];
+
+        Calibration::Underlying underlying;
+        underlying.s0 = 100.0;
+        underlying.r = r;
+        for (int i = 0; i < numberMaturities; i++) {
+            for (int j = 0; j < numberStrikes; j++) {
+                hcf::hcf_input_data& in = inputData[i * numberStrikes + j];
+                in.s0 = underlying.s0;
+                in.v0 = params.v0;
+                in.K = strikes[j];
+                in.rho = params.rho;
+                in.T = maturities[i];
+                in.r = underlying.r;
+                in.kappa = params.kappa;
+                in.vvol = params.vvol;
+                in.vbar = params.vbar;
+            }
+        }
+        retval = hcf.run(inputData, outputData, numberStrikes * numberMaturities);
+
+        for (int i = 0; retval == XLNX_OK && i < numberStrikes * numberMaturities; i++) {
+            Calibration::Quote quote = {inputData[i].K, inputData[i].T, outputData[i], 1.0};
+            underlying.quotes.push_back(quote);
+        }
+
+        // start away from the parameters of the quotes
+        hcfCalibration::hcf_parameters guess = {0.04, 2.0, 0.06, 0.5, -0.5};
+        Calibration::Result result;
+        hcfCalibration calibration(&hcf);
+
+        start = std::chrono::high_resolution_clock::now();
+        if (retval == XLNX_OK) {
+            retval = calibration.run(&underlying, &guess, &result, 1);
+        }
+        end = std::chrono::high_resolution_clock::now();
+
+        if (retval == XLNX_OK) {
+            printf("[XF_FINTECH] Iterations = %d, RMSE = %f, converged = %d\n", result.iterations, result.rmse,
+                   result.converged);
+            printf("[XF_FINTECH] v0    = %f (%f)\n", guess.v0, params.v0);
+            printf("[XF_FINTECH] kappa = %f (%f)\n", guess.kappa, params.kappa);
+            printf("[XF_FINTECH] vbar  = %f (%f)\n", guess.vbar, params.vbar);
+            printf("[XF_FINTECH] vvol  = %f (%f)\n", guess.vvol, params.vvol);
+            printf("[XF_FINTECH] rho   = %f (%f)\n", guess.rho, params.rho);
+            printf("[XF_FINTECH] ExecutionTime = %lld microseconds\n",
+                   (long long int)std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+        }
+    }
+
     printf("[XF_FINTECH] HCF releasing device...\n");
     retval = hcf.releaseDevice();
 
@@ -0,0 +1,314 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <ap_int.h>
+#include <iostream>
+
+#include <sys/time.h>
+#include <new>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include <xcl2.hpp>
+
+#include "kernel_config.hpp"
+
+// number of messages for each kernel run
+#define N_MSG 32
+// maximum length of a message in bytes
+#define MAX_LEN (1 << 20)
+
+class ArgParser {
+   public:
+    ArgParser(int& argc, const char** argv) {
+        for (int i = 1; i < argc; ++i) mTokens.push_back(std::string(argv[i]));
+    }
+    bool getCmdOption(const std::string option, std::string& value) const {
+        std::vector<std::string>::const_iterator itr;
+        itr = std::find(this->mTokens.begin(), this->mTokens.end(), option);
+        if (itr != this->mTokens.end() && ++itr != this->mTokens.end()) {
+            value = *itr;
+            return true;
+        }
+        return false;
+    }
+
+   private:
+    std::vector<std::string> mTokens;
+};
+
+inline int tvdiff(struct timeval* tv0, struct timeval* tv1) {
+    return (tv1->tv_sec - tv0->tv_sec) * 1000000 + (tv1->tv_usec - tv0->tv_usec);
+}
+
+template <typename T>
+T* aligned_alloc(std::size_t num) {
+    void* ptr = nullptr;
+    if (posix_memalign(&ptr, 4096, num * sizeof(T))) throw std::bad_alloc();
+    return reinterpret_cast<T*>(ptr);
+}
+
+typedef std::vector<unsigned char> Bytes;
+
+// reference BLAKE3, following the reference implementation of the specification with a stack of subtree roots
+static const uint32_t IV[8] = {0x6a09e667UL, 0xbb67ae85UL, 0x3c6ef372UL, 0xa54ff53aUL,
+                               0x510e527fUL, 0x9b05688cUL, 0x1f83d9abUL, 0x5be0cd19UL};
+static const int PERM[16] = {2, 6, 3, 10, 7, 0, 4, 13, 1, 11, 12, 5, 9, 14, 15, 8};
+
+static uint32_t rotr(uint32_t x, int n) {
+    return (x >> n) | (x << (32 - n));
+}
+
+static void g(uint32_t* v, int a, int b, int c, int d, uint32_t mx, uint32_t my) {
+    v[a] = v[a] + v[b] + mx;
+    v[d] = rotr(v[d] ^ v[a], 16);
+    v[c] = v[c] + v[d];
+    v[b] = rotr(v[b] ^ v[c], 12);
+    v[a] = v[a] + v[b] + my;
+    v[d] = rotr(v[d] ^ v[a], 8);
+    v[c] = v[c] + v[d];
+    v[b] = rotr(v[b] ^ v[c], 7);
+}
+
+static void compress(const uint32_t cv[8],
+                     const unsigned char blk[64],
+                     uint64_t counter,
+                     uint32_t len,
+                     uint32_t flags,
+                     uint32_t out[8]) {
+    uint32_t v[16], m[16], t[16];
+    for (int i = 0; i < 8; i++) {
+        v[i] = cv[i];
+    }
+    for (int i = 0; i < 4; i++) {
+        v[8 + i] = IV[i];
+    }
+    v[12] = (uint32_t)counter;
+    v[13] = (uint32_t)(counter >> 32);
+    v[14] = len;
+    v[15] = flags;
+    for (int i = 0; i < 16; i++) {
+        m[i] = blk[4 * i] | (blk[4 * i + 1] << 8) | (blk[4 * i + 2] << 16) | ((uint32_t)blk[4 * i + 3] << 24);
+    }
+    for (int r = 0; r < 7; r++) {
+        g(v, 0, 4, 8, 12, m[0], m[1]);
+        g(v, 1, 5, 9, 13, m[2], m[3]);
+        g(v, 2, 6, 10, 14, m[4], m[5]);
+        g(v, 3, 7, 11, 15, m[6], m[7]);
+        g(v, 0, 5, 10, 15, m[8], m[9]);
+        g(v, 1, 6, 11, 12, m[10], m[11]);
+        g(v, 2, 7, 8, 13, m[12], m[13]);
+        g(v, 3, 4, 9, 14, m[14], m[15]);
+        for (int i = 0; i < 16; i++) {
+            t[i] = m[PERM[i]];
+        }
+        memcpy(m, t, sizeof(m));
+    }
+    for (int i = 0; i < 8; i++) {
+        out[i] = v[i] ^ v[i + 8];
+    }
+}
+
+static void parent(const uint32_t l[8], const uint32_t r[8], uint32_t flags, uint32_t out[8]) {
+    unsigned char blk[64];
+    for (int i = 0; i < 8; i++) {
+        for (int k = 0; k < 4; k++) {
+            blk[4 * i + k] = l[i] >> (8 * k);
+            blk[32 + 4 * i + k] = r[i] >> (8 * k);
+        }
+    }
+    compress(IV, blk, 0, 64, 4 | flags, out);
+}
+
+Bytes refBlake3(const Bytes& msg) {
+    uint64_t chunkNum = msg.empty() ? 1 : (msg.size() + 1023) / 1024;
+    std::vector<std::vector<uint32_t> > stack;
+    uint32_t cv[8];
+    for (uint64_t ch = 0; ch < chunkNum; ch++) {
+        size_t off = ch * 1024;
+        size_t len = msg.size() - off < 1024 ? msg.size() - off : 1024;
+        size_t blkNum = len == 0 ? 1 : (len + 63) / 64;
+        memcpy(cv, IV, sizeof(cv));
+        for (size_t j = 0; j < blkNum; j++) {
+            unsigned char blk[64] = {0};
+            size_t blkLen = len - j * 64 < 64 ? len - j * 64 : 64;
+            memcpy(blk, msg.data() + off + j * 64, blkLen);
+            uint32_t flags = (j == 0 ? 1 : 0) | (j == blkNum - 1 ? 2 : 0);
+            if (j == blkNum - 1 && chunkNum == 1) {
+                flags |= 8;
+            }
+            compress(cv, blk, ch, blkLen, flags, cv);
+        }
+        if (ch + 1 < chunkNum) {
+            uint64_t total = ch + 1;
+            while ((total & 1) == 0) {
+                parent(stack.back().data(), cv, 0, cv);
+                stack.pop_back();
+                total >>= 1;
+            }
+            stack.push_back(std::vector<uint32_t>(cv, cv + 8));
+        }
+    }
+    while (!stack.empty()) {
+        uint32_t flags = stack.size() == 1 ? 8 : 0;
+        parent(stack.back().data(), cv, flags, cv);
+        stack.pop_back();
+    }
+    Bytes md(32);
+    for (int i = 0; i < 32; i++) {
+        md[i] = cv[i / 4] >> (8 * (i % 4));
+    }
+    return md;
+}
+
+int main(int argc, char* argv[]) {
+    // cmd parser
+    ArgParser parser(argc, (const char**)argv);
+    std::string xclbin_path;
+    if (!parser.getCmdOption("-xclbin", xclbin_path)) {
+        std::cout << "ERROR:xclbin path is not set!\n";
+        return 1;
+    }
+
+    // set repeat time
+    int num_rep = 1;
+    std::string num_str;
+    if (parser.getCmdOption("-rep", num_str)) {
+        try {
+            num_rep = std::stoi(num_str);
+        } catch (...) {
+            num_rep = 1;
+        }
+    }
+    if (num_rep > 20) {
+        num_rep = 20;
+        std::cout << "WARNING: limited repeat to " << num_rep << " times.\n";
+    }
+
+    // Host buffers
+    const size_t in_blk = 1 + N_MSG * (1 + MAX_LEN / 64);
+    ap_uint<512>* hb_in = aligned_alloc<ap_uint<512> >(in_blk);
+    ap_uint<512>* hb_out = aligned_alloc<ap_uint<512> >(N_MSG);
+    std::vector<Bytes> golden(N_MSG);
+
+    // generate configuration block
+    hb_in[0] = 0;
+    hb_in[0].range(63, 0) = N_MSG;
+
+    // generate messages and golden, the lengths are not multiples of the chunk size
+    uint64_t total_len = 0;
+    size_t base = 1;
+    for (int i = 0; i < N_MSG; i++) {
+        Bytes msg(MAX_LEN - i * 4099);
+        for (size_t j = 0; j < msg.size(); j++) {
+            msg[j] = rand();
+        }
+        golden[i] = refBlake3(msg);
+        total_len += msg.size();
+
+        hb_in[base] = 0;
+        hb_in[base].range(63, 0) = msg.size();
+        size_t blk_num = (msg.size() + 63) / 64;
+        for (size_t k = 0; k < blk_num; k++) {
+            ap_uint<512> blk = 0;
+            for (size_t j = 0; j < 64 && k * 64 + j < msg.size(); j++) {
+                blk.range(j * 8 + 7, j * 8) = msg[k * 64 + j];
+            }
+            hb_in[base + 1 + k] = blk;
+        }
+        base += 1 + blk_num;
+    }
+    std::cout << "Goldens have been created using the reference implementation.\n";
+
+    // Get CL devices.
+    std::vector<cl::Device> devices = xcl::get_xil_devices();
+    cl::Device device = devices[0];
+
+    // Create context and command queue for selected device
+    cl::Context context(device);
+    cl::CommandQueue q(context, device, CL_QUEUE_PROFILING_ENABLE | CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE);
+    std::string devName = device.getInfo<CL_DEVICE_NAME>();
+    std::cout << "Selected Device " << devName << "\n";
+
+    cl::Program::Binaries xclBins = xcl::import_binary_file(xclbin_path);
+    devices.resize(1);
+    cl::Program program(context, devices, xclBins);
+
+    cl::Kernel kernel(program, "blake3Kernel");
+    std::cout << "Kernel has been created.\n";
+
+    cl_mem_ext_ptr_t mext_in = {XCL_MEM_DDR_BANK0, hb_in, 0};
+    cl_mem_ext_ptr_t mext_out = {XCL_MEM_DDR_BANK0, hb_out, 0};
+
+    // Map buffers
+    cl::Buffer in_buff(context, CL_MEM_EXT_PTR_XILINX | CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY,
+                       (size_t)(sizeof(ap_uint<512>) * in_blk), &mext_in);
+    cl::Buffer out_buff(context, CL_MEM_EXT_PTR_XILINX | CL_MEM_USE_HOST_PTR | CL_MEM_WRITE_ONLY,
+                        (size_t)(sizeof(ap_uint<512>) * N_MSG), &mext_out);
+
+    std::cout << "DDR buffers have been mapped/copy-and-mapped\n";
+
+    // write data to DDR
+    std::vector<cl::Memory> ib;
+    ib.push_back(in_buff);
+    std::vector<cl::Memory> ob;
+    ob.push_back(out_buff);
+    q.enqueueMigrateMemObjects(ib, 0, nullptr, nullptr);
+    q.finish();
+
+    // the kernel time only, messages stay in DDR between the runs
+    kernel.setArg(0, in_buff);
+    kernel.setArg(1, out_buff);
+    struct timeval start_time, end_time;
+    gettimeofday(&start_time, 0);
+    for (int i = 0; i < num_rep; i++) {
+        q.enqueueTask(kernel, nullptr, nullptr);
+    }
+    q.finish();
+    gettimeofday(&end_time, 0);
+
+    // read data from DDR
+    q.enqueueMigrateMemObjects(ob, CL_MIGRATE_MEM_OBJECT_HOST, nullptr, nullptr);
+    q.finish();
+
+    int elapsed = tvdiff(&start_time, &end_time);
+    std::cout << "Kernel has been run for " << std::dec << num_rep << " times." << std::endl;
+    std::cout << "Execution time " << elapsed << "us, "
+              << (double)total_len * num_rep / 1000.0 / (elapsed > 0 ? elapsed : 1) << " GB/s" << std::endl;
+
+    // check result
+    int nerror = 0;
+    for (int i = 0; i < N_MSG; i++) {
+        bool match = true;
+        for (int j = 0; j < 32; j++) {
+            if ((unsigned int)hb_out[i].range(j * 8 + 7, j * 8) != golden[i][j]) {
+                match = false;
+            }
+        }
+        if (!match) {
+            nerror++;
+            std::cout << "Error found in message " << i << std::endl;
+        }
+    }
+
+    if (nerror == 0) {
+        std::cout << std::dec << N_MSG << " messages hashed. No error found!" << std::endl;
+    }
+
+    return nerror;
+}
@@ -0,0 +1,178 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ *
+ * @file blake3Kernel.cpp
+ * @brief kernel code of BLAKE3 hash.
+ * This file is part of Vitis Security Library.
+ *
+ * @detail The messages are kept in DDR in their natural order and read in bursts, and the blocks of every group of
+ * LANE_NM chunks are reordered on chip into the interleaved order taken by the hash engine, so that the host does
+ * not need to shuffle them.
+ *
+ */
+
+#include <ap_int.h>
+#include <hls_stream.h>
+#include "xf_security/blake3.hpp"
+
+#include "kernel_config.hpp"
+
+// @brief read the messages in their natural order, with one burst of up to 16 blocks per chunk.
+static void readMsg(ap_uint<512>* ptr,
+                    hls::stream<ap_uint<512> >& blkStrm,
+                    hls::stream<ap_uint<64> >& msgLenStrm,
+                    hls::stream<bool>& endMsgLenStrm) {
+    unsigned int msgNum = ptr[0].range(63, 0);
+    uint64_t base = 1;
+LOOP_MSG:
+    for (unsigned int m = 0; m < msgNum; m++) {
+        uint64_t len = ptr[base].range(63, 0);
+        uint64_t blkNum = (len + 63) >> 6;
+        msgLenStrm.write(len);
+        endMsgLenStrm.write(false);
+    LOOP_CHUNK:
+        for (uint64_t b = 0; b < blkNum; b += 16) {
+            unsigned int n = (blkNum - b > 16) ? 16 : (unsigned int)(blkNum - b);
+        LOOP_BURST:
+            for (unsigned int k = 0; k < n; k++) {
+#pragma HLS pipeline II = 1
+#pragma HLS loop_tripcount min = 16 max = 16
+                blkStrm.write(ptr[base + 1 + b + k]);
+            }
+        }
+        base += 1 + blkNum;
+    }
+    endMsgLenStrm.write(true);
+} // end readMsg
+
+// @brief reorder the blocks of every group of LANE_NM chunks, block j of every chunk before block j + 1.
+// The blocks of group g are stored into one half of a ping-pong buffer while group g - 1 is sent from the other.
+static void interleaveMsg(hls::stream<ap_uint<512> >& blkStrm,
+                          hls::stream<ap_uint<64> >& msgLenStrm,
+                          hls::stream<bool>& endMsgLenStrm,
+                          hls::stream<ap_uint<512> >& msgStrm,
+                          hls::stream<ap_uint<64> >& lenStrm,
+                          hls::stream<bool>& endLenStrm) {
+    ap_uint<512> buf[2][16 * LANE_NM];
+#pragma HLS array_partition variable = buf complete dim = 1
+#pragma HLS resource variable = buf core = RAM_2P_BRAM
+#pragma HLS dependence variable = buf inter false
+LOOP_MSG:
+    while (!endMsgLenStrm.read()) {
+        uint64_t len = msgLenStrm.read();
+        uint64_t chunkNum = (len == 0) ? 1 : ((len + 1023) >> 10);
+        uint64_t blkNum = (len + 63) >> 6;
+        uint64_t grpNum = (chunkNum + LANE_NM - 1) / LANE_NM;
+        lenStrm.write(len);
+        endLenStrm.write(false);
+    LOOP_GROUP:
+        for (uint64_t g = 0; g <= grpNum; g++) {
+            uint64_t fillBegin = g * 16 * LANE_NM;
+            unsigned int fillNum = 0;
+            if (g < grpNum && blkNum > fillBegin) {
+                fillNum = (blkNum - fillBegin > 16 * LANE_NM) ? 16 * LANE_NM : (unsigned int)(blkNum - fillBegin);
+            }
+            unsigned int c = 0;
+            unsigned int j = 0;
+        LOOP_BLOCK:
+            for (unsigned int i = 0; i < 16 * LANE_NM; i++) {
+#pragma HLS pipeline II = 1
+                if (i < fillNum) {
+                    buf[g % 2][i] = blkStrm.read();
+                }
+                unsigned int e = (c << 4) + j;
+                if (g > 0 && fillBegin - 16 * LANE_NM + e < blkNum) {
+                    msgStrm.write(buf[(g + 1) % 2][e]);
+                }
+                if (c == LANE_NM - 1) {
+                    c = 0;
+                    j++;
+                } else {
+                    c++;
+                }
+            }
+        }
+    }
+    endLenStrm.write(true);
+} // end interleaveMsg
+
+// @brief write one hash per block.
+static void writeHash(hls::stream<ap_uint<256> >& hashStrm, hls::stream<bool>& endHashStrm, ap_uint<512>* ptr) {
+    unsigned int i = 0;
+LOOP_HASH:
+    while (!endHashStrm.read()) {
+#pragma HLS pipeline II = 1
+        ap_uint<512> blk = 0;
+        blk.range(255, 0) = hashStrm.read();
+        ptr[i++] = blk;
+    }
+} // end writeHash
+
+// @brief top of kernel
+extern "C" void blake3Kernel(ap_uint<512> inputData[(1 << 20) + 1], ap_uint<512> outputData[1 << 20]) {
+// clang-format off
+#pragma HLS INTERFACE m_axi offset = slave latency = 64 \
+	num_write_outstanding = 16 num_read_outstanding = 16 \
+	max_write_burst_length = 64 max_read_burst_length = 64 \
+	bundle = gmem0_0 port = inputData
+
+#pragma HLS INTERFACE m_axi offset = slave latency = 64 \
+	num_write_outstanding = 16 num_read_outstanding = 16 \
+	max_write_burst_length = 64 max_read_burst_length = 64 \
+	bundle = gmem0_1 port = outputData
+// clang-format on
+
+#pragma HLS INTERFACE s_axilite port = inputData bundle = control
+#pragma HLS INTERFACE s_axilite port = outputData bundle = control
+#pragma HLS INTERFACE s_axilite port = return bundle = control
+
+#pragma HLS dataflow
+
+    hls::stream<ap_uint<512> > blkStrm("blkStrm");
+#pragma HLS RESOURCE variable = blkStrm core = FIFO_BRAM
+#pragma HLS STREAM variable = blkStrm depth = 64 dim = 1
+    hls::stream<ap_uint<64> > msgLenStrm("msgLenStrm");
+#pragma HLS RESOURCE variable = msgLenStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = msgLenStrm depth = 32 dim = 1
+    hls::stream<bool> endMsgLenStrm("endMsgLenStrm");
+#pragma HLS RESOURCE variable = endMsgLenStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = endMsgLenStrm depth = 32 dim = 1
+    hls::stream<ap_uint<512> > msgStrm("msgStrm");
+#pragma HLS RESOURCE variable = msgStrm core = FIFO_BRAM
+#pragma HLS STREAM variable = msgStrm depth = 128 dim = 1
+    hls::stream<ap_uint<64> > lenStrm("lenStrm");
+#pragma HLS RESOURCE variable = lenStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = lenStrm depth = 32 dim = 1
+    hls::stream<bool> endLenStrm("endLenStrm");
+#pragma HLS RESOURCE variable = endLenStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = endLenStrm depth = 32 dim = 1
+    hls::stream<ap_uint<256> > hashStrm("hashStrm");
+#pragma HLS RESOURCE variable = hashStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = hashStrm depth = 32 dim = 1
+    hls::stream<bool> endHashStrm("endHashStrm");
+#pragma HLS RESOURCE variable = endHashStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = endHashStrm depth = 32 dim = 1
+
+    readMsg(inputData, blkStrm, msgLenStrm, endMsgLenStrm);
+
+    interleaveMsg(blkStrm, msgLenStrm, endMsgLenStrm, msgStrm, lenStrm, endLenStrm);
+
+    xf::security::blake3<LANE_NM>(msgStrm, lenStrm, endLenStrm, hashStrm, endHashStrm);
+
+    writeHash(hashStrm, endHashStrm, outputData);
+} // end blake3Kernel
@@ -0,0 +1,27 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __KERNEL_CONFIG_HPP_
+#define __KERNEL_CONFIG_HPP_
+
+// number of chunks hashed at the same time, no less than the latency of the compression function
+#define LANE_NM 32
+
+// input layout: one configuration block with the number of messages in bits 63..0, then per message one block with
+// its length in bytes in bits 63..0 followed by ceil(len / 64) blocks of data, byte i at bit 8i
+// output layout: one block per message with the 32-byte hash in bits 255..0, byte i at bit 8i
+
+#endif
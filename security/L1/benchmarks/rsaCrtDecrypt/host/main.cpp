@@ -0,0 +1,225 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <ap_int.h>
+#include <iostream>
+
+#include <openssl/bn.h>
+#include <openssl/rsa.h>
+
+#include <sys/time.h>
+#include <new>
+#include <cstdlib>
+
+#include <xcl2.hpp>
+
+#include "kernel_config.hpp"
+
+// number of messages for each kernel run, a multiple of CTX_NM
+#define N_MSG 256
+// number of distinct private keys generated by OpenSSL
+#define N_KEY 16
+
+class ArgParser {
+   public:
+    ArgParser(int& argc, const char** argv) {
+        for (int i = 1; i < argc; ++i) mTokens.push_back(std::string(argv[i]));
+    }
+    bool getCmdOption(const std::string option, std::string& value) const {
+        std::vector<std::string>::const_iterator itr;
+        itr = std::find(this->mTokens.begin(), this->mTokens.end(), option);
+        if (itr != this->mTokens.end() && ++itr != this->mTokens.end()) {
+            value = *itr;
+            return true;
+        }
+        return false;
+    }
+
+   private:
+    std::vector<std::string> mTokens;
+};
+
+inline int tvdiff(struct timeval* tv0, struct timeval* tv1) {
+    return (tv1->tv_sec - tv0->tv_sec) * 1000000 + (tv1->tv_usec - tv0->tv_usec);
+}
+
+template <typename T>
+T* aligned_alloc(std::size_t num) {
+    void* ptr = nullptr;
+    if (posix_memalign(&ptr, 4096, num * sizeof(T))) throw std::bad_alloc();
+    return reinterpret_cast<T*>(ptr);
+}
+
+template <int W>
+ap_uint<W> bn2ap(const BIGNUM* bn) {
+    unsigned char buf[W / 8];
+    BN_bn2binpad(bn, buf, W / 8);
+    ap_uint<W> r = 0;
+    for (int i = 0; i < W / 8; i++) {
+        r.range(W - 1 - 8 * i, W - 8 - 8 * i) = buf[i];
+    }
+    return r;
+}
+
+int main(int argc, char* argv[]) {
+    // cmd parser
+    ArgParser parser(argc, (const char**)argv);
+    std::string xclbin_path;
+    if (!parser.getCmdOption("-xclbin", xclbin_path)) {
+        std::cout << "ERROR:xclbin path is not set!\n";
+        return 1;
+    }
+
+    // set repeat time
+    int num_rep = 1;
+    std::string num_str;
+    if (parser.getCmdOption("-rep", num_str)) {
+        try {
+            num_rep = std::stoi(num_str);
+        } catch (...) {
+            num_rep = 1;
+        }
+    }
+    if (num_rep > 20) {
+        num_rep = 20;
+        std::cout << "WARNING: limited repeat to " << num_rep << " times.\n";
+    }
+
+    // Host buffers
+    ap_uint<512>* hb_in = aligned_alloc<ap_uint<512> >(1 + N_MSG * (KEY_BLK + TEXT_BLK));
+    ap_uint<512>* hb_out = aligned_alloc<ap_uint<512> >(N_MSG * TEXT_BLK);
+    ap_uint<KEY_LEN>* golden = new ap_uint<KEY_LEN>[N_MSG];
+
+    // generate configuration block
+    hb_in[0] = 0;
+    hb_in[0].range(63, 0) = N_MSG;
+
+    // generate keys, messages and golden
+    BN_CTX* bnCtx = BN_CTX_new();
+    BIGNUM* e = BN_new();
+    BN_set_word(e, RSA_F4);
+    RSA* keys[N_KEY];
+    for (int k = 0; k < N_KEY; k++) {
+        keys[k] = RSA_new();
+        RSA_generate_key_ex(keys[k], KEY_LEN, e, NULL);
+    }
+    BIGNUM* m = BN_new();
+    BIGNUM* c = BN_new();
+    for (int i = 0; i < N_MSG; i++) {
+        const BIGNUM *n, *pubExp, *p, *q, *dP, *dQ, *qInv;
+        RSA_get0_key(keys[i % N_KEY], &n, &pubExp, NULL);
+        RSA_get0_factors(keys[i % N_KEY], &p, &q);
+        RSA_get0_crt_params(keys[i % N_KEY], &dP, &dQ, &qInv);
+        BN_rand_range(m, n);
+        BN_mod_exp(c, m, pubExp, n, bnCtx);
+        golden[i] = bn2ap<KEY_LEN>(m);
+
+        const BIGNUM* keyPart[5] = {p, q, dP, dQ, qInv};
+        ap_uint<512>* blk = hb_in + 1 + i * (KEY_BLK + TEXT_BLK);
+        for (int j = 0; j < 5; j++) {
+            ap_uint<KEY_LEN / 2> v = bn2ap<KEY_LEN / 2>(keyPart[j]);
+            blk[2 * j] = v.range(511, 0);
+            blk[2 * j + 1] = v.range(1023, 512);
+        }
+        ap_uint<KEY_LEN> text = bn2ap<KEY_LEN>(c);
+        for (int j = 0; j < TEXT_BLK; j++) {
+            blk[KEY_BLK + j] = text.range(j * 512 + 511, j * 512);
+        }
+    }
+    BN_free(m);
+    BN_free(c);
+    BN_free(e);
+    BN_CTX_free(bnCtx);
+    for (int k = 0; k < N_KEY; k++) {
+        RSA_free(keys[k]);
+    }
+    std::cout << "Goldens have been created using OpenSSL.\n";
+
+    // Get CL devices.
+    std::vector<cl::Device> devices = xcl::get_xil_devices();
+    cl::Device device = devices[0];
+
+    // Create context and command queue for selected device
+    cl::Context context(device);
+    cl::CommandQueue q(context, device, CL_QUEUE_PROFILING_ENABLE | CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE);
+    std::string devName = device.getInfo<CL_DEVICE_NAME>();
+    std::cout << "Selected Device " << devName << "\n";
+
+    cl::Program::Binaries xclBins = xcl::import_binary_file(xclbin_path);
+    devices.resize(1);
+    cl::Program program(context, devices, xclBins);
+
+    cl::Kernel kernel(program, "rsaCrtDecryptKernel");
+    std::cout << "Kernel has been created.\n";
+
+    cl_mem_ext_ptr_t mext_in = {XCL_MEM_DDR_BANK0, hb_in, 0};
+    cl_mem_ext_ptr_t mext_out = {XCL_MEM_DDR_BANK0, hb_out, 0};
+
+    // Map buffers
+    cl::Buffer in_buff(context, CL_MEM_EXT_PTR_XILINX | CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY,
+                       (size_t)(sizeof(ap_uint<512>) * (1 + N_MSG * (KEY_BLK + TEXT_BLK))), &mext_in);
+    cl::Buffer out_buff(context, CL_MEM_EXT_PTR_XILINX | CL_MEM_USE_HOST_PTR | CL_MEM_WRITE_ONLY,
+                        (size_t)(sizeof(ap_uint<512>) * (N_MSG * TEXT_BLK)), &mext_out);
+
+    std::cout << "DDR buffers have been mapped/copy-and-mapped\n";
+
+    // write data to DDR
+    std::vector<cl::Memory> ib;
+    ib.push_back(in_buff);
+    std::vector<cl::Memory> ob;
+    ob.push_back(out_buff);
+    q.enqueueMigrateMemObjects(ib, 0, nullptr, nullptr);
+    q.finish();
+
+    // the kernel time only, keys and cipher texts stay in DDR between the runs
+    kernel.setArg(0, in_buff);
+    kernel.setArg(1, out_buff);
+    struct timeval start_time, end_time;
+    gettimeofday(&start_time, 0);
+    for (int i = 0; i < num_rep; i++) {
+        q.enqueueTask(kernel, nullptr, nullptr);
+    }
+    q.finish();
+    gettimeofday(&end_time, 0);
+
+    // read data from DDR
+    q.enqueueMigrateMemObjects(ob, CL_MIGRATE_MEM_OBJECT_HOST, nullptr, nullptr);
+    q.finish();
+
+    int elapsed = tvdiff(&start_time, &end_time);
+    std::cout << "Kernel has been run for " << std::dec << num_rep << " times." << std::endl;
+    std::cout << "Execution time " << elapsed << "us, "
+              << (double)N_MSG * num_rep * 1000000.0 / (elapsed > 0 ? elapsed : 1) << " decryptions/s" << std::endl;
+
+    // check result
+    int nerror = 0;
+    for (int i = 0; i < N_MSG; i++) {
+        ap_uint<KEY_LEN> plain;
+        for (int j = 0; j < TEXT_BLK; j++) {
+            plain.range(j * 512 + 511, j * 512) = hb_out[i * TEXT_BLK + j];
+        }
+        if (plain != golden[i]) {
+            nerror++;
+            std::cout << "Error found in message " << i << std::endl;
+        }
+    }
+
+    if (nerror == 0) {
+        std::cout << std::dec << N_MSG << " messages decrypted. No error found!" << std::endl;
+    }
+
+    delete[] golden;
+    return nerror;
+}
@@ -0,0 +1,33 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __KERNEL_CONFIG_HPP_
+#define __KERNEL_CONFIG_HPP_
+
+// number of decryptions interleaved in the kernel
+#define CTX_NM 8
+
+// RSA-2048, Montgomery multiplication in 32-bit words
+#define BLOCK_WIDTH 32
+#define BLOCK_NUM 64
+#define KEY_LEN (BLOCK_WIDTH * BLOCK_NUM)
+
+// input layout: one configuration block with the number of messages in bits 63..0, then per message the private key
+// p, q, dP, dQ, qInv in two blocks each and the cipher text in four blocks, all lowest block first
+// output layout: four blocks of plain text per message, lowest block first
+#define KEY_BLK 10
+#define TEXT_BLK 4
+
+#endif
@@ -0,0 +1,114 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ *
+ * @file rsaCrtDecryptKernel.cpp
+ * @brief kernel code of batched RSA-2048 private key decryption with CRT.
+ * This file is part of Vitis Security Library.
+ *
+ * @detail Every CTX_NM messages with their own private keys are loaded as one batch and decrypted together.
+ * Loading takes tens of cycles while decryption takes millions, so batches are simply processed one after another.
+ *
+ */
+
+#include <ap_int.h>
+#include "xf_security/asymmetric.hpp"
+
+#include "kernel_config.hpp"
+
+// @brief load the private keys and cipher texts of one batch.
+static void loadBatch(ap_uint<512>* ptr,
+                      int batch,
+                      ap_uint<KEY_LEN / 2> p[CTX_NM],
+                      ap_uint<KEY_LEN / 2> q[CTX_NM],
+                      ap_uint<KEY_LEN / 2> dP[CTX_NM],
+                      ap_uint<KEY_LEN / 2> dQ[CTX_NM],
+                      ap_uint<KEY_LEN / 2> qInv[CTX_NM],
+                      ap_uint<KEY_LEN> cipher[CTX_NM]) {
+LOOP_LOAD:
+    for (int c = 0; c < CTX_NM; c++) {
+        int base = 1 + (batch * CTX_NM + c) * (KEY_BLK + TEXT_BLK);
+        ap_uint<KEY_LEN / 2> key[KEY_BLK / 2];
+        ap_uint<KEY_LEN> text;
+    LOOP_KEY:
+        for (int i = 0; i < KEY_BLK; i++) {
+#pragma HLS pipeline II = 1
+            key[i / 2].range((i % 2) * 512 + 511, (i % 2) * 512) = ptr[base + i];
+        }
+    LOOP_TEXT:
+        for (int i = 0; i < TEXT_BLK; i++) {
+#pragma HLS pipeline II = 1
+            text.range(i * 512 + 511, i * 512) = ptr[base + KEY_BLK + i];
+        }
+        p[c] = key[0];
+        q[c] = key[1];
+        dP[c] = key[2];
+        dQ[c] = key[3];
+        qInv[c] = key[4];
+        cipher[c] = text;
+    }
+} // end loadBatch
+
+// @brief write the plain texts of one batch.
+static void storeBatch(ap_uint<KEY_LEN> plain[CTX_NM], int batch, ap_uint<512>* ptr) {
+LOOP_STORE:
+    for (int c = 0; c < CTX_NM; c++) {
+        for (int i = 0; i < TEXT_BLK; i++) {
+#pragma HLS pipeline II = 1
+            ptr[(batch * CTX_NM + c) * TEXT_BLK + i] = plain[c].range(i * 512 + 511, i * 512);
+        }
+    }
+} // end storeBatch
+
+// @brief top of kernel
+extern "C" void rsaCrtDecryptKernel(ap_uint<512> inputData[(1 << 20) + 1], ap_uint<512> outputData[1 << 20]) {
+// clang-format off
+#pragma HLS INTERFACE m_axi offset = slave latency = 64 \
+	num_write_outstanding = 16 num_read_outstanding = 16 \
+	max_write_burst_length = 64 max_read_burst_length = 64 \
+	bundle = gmem0_0 port = inputData
+
+#pragma HLS INTERFACE m_axi offset = slave latency = 64 \
+	num_write_outstanding = 16 num_read_outstanding = 16 \
+	max_write_burst_length = 64 max_read_burst_length = 64 \
+	bundle = gmem0_1 port = outputData
+// clang-format on
+
+#pragma HLS INTERFACE s_axilite port = inputData bundle = control
+#pragma HLS INTERFACE s_axilite port = outputData bundle = control
+#pragma HLS INTERFACE s_axilite port = return bundle = control
+
+    // number of messages, a multiple of CTX_NM
+    unsigned int msgNum = inputData[0].range(63, 0);
+
+    ap_uint<KEY_LEN / 2> p[CTX_NM];
+    ap_uint<KEY_LEN / 2> q[CTX_NM];
+    ap_uint<KEY_LEN / 2> dP[CTX_NM];
+    ap_uint<KEY_LEN / 2> dQ[CTX_NM];
+    ap_uint<KEY_LEN / 2> qInv[CTX_NM];
+    ap_uint<KEY_LEN> text[CTX_NM];
+
+    xf::security::rsaCrtMultiCtx<BLOCK_WIDTH, BLOCK_NUM, CTX_NM> inst;
+
+LOOP_BATCH:
+    for (unsigned int b = 0; b < msgNum / CTX_NM; b++) {
+        loadBatch(inputData, b, p, q, dP, dQ, qInv, text);
+        inst.updateKey(p, q, dP, dQ, qInv);
+        inst.process(text, text);
+        storeBatch(text, b, outputData);
+    }
+} // end rsaCrtDecryptKernel
@@ -0,0 +1,321 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <ap_int.h>
+#include <iostream>
+
+#include <openssl/bn.h>
+#include <openssl/ec.h>
+#include <openssl/ecdsa.h>
+#include <openssl/evp.h>
+#include <openssl/obj_mac.h>
+#include <openssl/sha.h>
+
+#include <sys/time.h>
+#include <new>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <xcl2.hpp>
+
+#include "kernel_config.hpp"
+
+// number of signatures for each kernel run, a multiple of CH_NM
+#define N_SIG 4096
+// number of distinct signatures generated by OpenSSL, repeated to fill up N_SIG
+#define N_GOLDEN 64
+
+class ArgParser {
+   public:
+    ArgParser(int& argc, const char** argv) {
+        for (int i = 1; i < argc; ++i) mTokens.push_back(std::string(argv[i]));
+    }
+    bool getCmdOption(const std::string option, std::string& value) const {
+        std::vector<std::string>::const_iterator itr;
+        itr = std::find(this->mTokens.begin(), this->mTokens.end(), option);
+        if (itr != this->mTokens.end() && ++itr != this->mTokens.end()) {
+            value = *itr;
+            return true;
+        }
+        return false;
+    }
+
+   private:
+    std::vector<std::string> mTokens;
+};
+
+inline int tvdiff(struct timeval* tv0, struct timeval* tv1) {
+    return (tv1->tv_sec - tv0->tv_sec) * 1000000 + (tv1->tv_usec - tv0->tv_usec);
+}
+
+template <typename T>
+T* aligned_alloc(std::size_t num) {
+    void* ptr = nullptr;
+    if (posix_memalign(&ptr, 4096, num * sizeof(T))) throw std::bad_alloc();
+    return reinterpret_cast<T*>(ptr);
+}
+
+ap_uint<256> bn2ap(const BIGNUM* bn) {
+    unsigned char buf[32];
+    BN_bn2binpad(bn, buf, 32);
+    ap_uint<256> r = 0;
+    for (int i = 0; i < 32; i++) {
+        r.range(255 - 8 * i, 248 - 8 * i) = buf[i];
+    }
+    return r;
+}
+
+// generate one ECDSA P-256 signature in the kernel input layout, every other one is tampered with
+bool genEcdsaP256(int t, ap_uint<512>* blk) {
+    EC_GROUP* group = EC_GROUP_new_by_curve_name(NID_X9_62_prime256v1);
+    EC_KEY* key = EC_KEY_new_by_curve_name(NID_X9_62_prime256v1);
+    EC_KEY_generate_key(key);
+    char msg[64];
+    sprintf(msg, "ECDSA P-256 benchmark message %d", t);
+    unsigned char digest[SHA256_DIGEST_LENGTH];
+    SHA256((const unsigned char*)msg, strlen(msg), digest);
+    ECDSA_SIG* sig = ECDSA_do_sign(digest, SHA256_DIGEST_LENGTH, key);
+    BIGNUM* x = BN_new();
+    BIGNUM* y = BN_new();
+    EC_POINT_get_affine_coordinates(group, EC_KEY_get0_public_key(key), x, y, NULL);
+
+    blk[0] = 0;
+    for (int i = 0; i < 32; i++) {
+        blk[0].range(255 - 8 * i, 248 - 8 * i) = digest[i];
+    }
+    blk[1].range(255, 0) = bn2ap(ECDSA_SIG_get0_r(sig));
+    blk[1].range(511, 256) = bn2ap(ECDSA_SIG_get0_s(sig));
+    blk[2].range(255, 0) = bn2ap(x);
+    blk[2].range(511, 256) = bn2ap(y);
+
+    bool valid = true;
+    if (t % 4 == 1) {
+        blk[0][0] = ~blk[0][0];
+        valid = false;
+    } else if (t % 4 == 2) {
+        blk[1][300] = ~blk[1][300];
+        valid = false;
+    } else if (t % 8 == 3) {
+        blk[2][0] = ~blk[2][0];
+        valid = false;
+    }
+
+    BN_free(x);
+    BN_free(y);
+    ECDSA_SIG_free(sig);
+    EC_KEY_free(key);
+    EC_GROUP_free(group);
+    return valid;
+}
+
+// generate one Ed25519 signature in the kernel input layout, every other one is tampered with
+bool genEd25519(int t, ap_uint<512>* blk) {
+    EVP_PKEY* pkey = NULL;
+    EVP_PKEY_CTX* kctx = EVP_PKEY_CTX_new_id(EVP_PKEY_ED25519, NULL);
+    EVP_PKEY_keygen_init(kctx);
+    EVP_PKEY_keygen(kctx, &pkey);
+    EVP_PKEY_CTX_free(kctx);
+
+    char msg[64];
+    sprintf(msg, "Ed25519 benchmark message %d", t);
+    size_t msgLen = strlen(msg);
+    unsigned char sig[64];
+    size_t sigLen = sizeof(sig);
+    EVP_MD_CTX* mctx = EVP_MD_CTX_new();
+    EVP_DigestSignInit(mctx, NULL, NULL, NULL, pkey);
+    EVP_DigestSign(mctx, sig, &sigLen, (const unsigned char*)msg, msgLen);
+    EVP_MD_CTX_free(mctx);
+    unsigned char pub[32];
+    size_t pubLen = sizeof(pub);
+    EVP_PKEY_get_raw_public_key(pkey, pub, &pubLen);
+    EVP_PKEY_free(pkey);
+
+    bool valid = true;
+    if (t % 4 == 1) {
+        msg[0] ^= 1;
+        valid = false;
+    } else if (t % 4 == 2) {
+        sig[40] ^= 1;
+        valid = false;
+    } else if (t % 8 == 3) {
+        pub[0] ^= 1;
+        valid = false;
+    }
+
+    // the message hash SHA-512(R || A || M) stays on host
+    unsigned char digest[SHA512_DIGEST_LENGTH];
+    SHA512_CTX sctx;
+    SHA512_Init(&sctx);
+    SHA512_Update(&sctx, sig, 32);
+    SHA512_Update(&sctx, pub, 32);
+    SHA512_Update(&sctx, msg, msgLen);
+    SHA512_Final(digest, &sctx);
+
+    blk[2] = 0;
+    for (int i = 0; i < 64; i++) {
+        blk[0].range(8 * i + 7, 8 * i) = digest[i];
+        blk[1].range(8 * i + 7, 8 * i) = sig[i];
+    }
+    for (int i = 0; i < 32; i++) {
+        blk[2].range(8 * i + 7, 8 * i) = pub[i];
+    }
+    return valid;
+}
+
+int main(int argc, char* argv[]) {
+    // cmd parser
+    ArgParser parser(argc, (const char**)argv);
+    std::string xclbin_path;
+    if (!parser.getCmdOption("-xclbin", xclbin_path)) {
+        std::cout << "ERROR:xclbin path is not set!\n";
+        return 1;
+    }
+
+    // set repeat time
+    int num_rep = 1;
+    std::string num_str;
+    if (parser.getCmdOption("-rep", num_str)) {
+        try {
+            num_rep = std::stoi(num_str);
+        } catch (...) {
+            num_rep = 1;
+        }
+    }
+    if (num_rep > 20) {
+        num_rep = 20;
+        std::cout << "WARNING: limited repeat to " << num_rep << " times.\n";
+    }
+
+    // generate golden
+    ap_uint<512> ecdsaBlk[N_GOLDEN][BLK_PER_SIG];
+    ap_uint<512> edBlk[N_GOLDEN][BLK_PER_SIG];
+    bool ecdsaGolden[N_GOLDEN];
+    bool edGolden[N_GOLDEN];
+    for (int t = 0; t < N_GOLDEN; t++) {
+        ecdsaGolden[t] = genEcdsaP256(t, ecdsaBlk[t]);
+        edGolden[t] = genEd25519(t, edBlk[t]);
+    }
+    std::cout << "Goldens have been created using OpenSSL.\n";
+
+    // Host buffers
+    ap_uint<512>* hb_in[2];
+    ap_uint<512>* hb_out[2];
+    for (int k = 0; k < 2; k++) {
+        hb_in[k] = aligned_alloc<ap_uint<512> >(1 + N_SIG * BLK_PER_SIG);
+        hb_out[k] = aligned_alloc<ap_uint<512> >((N_SIG + 511) / 512);
+        // generate configuration block
+        hb_in[k][0] = 0;
+        hb_in[k][0].range(63, 0) = N_SIG;
+    }
+    // generate signature blocks
+    for (int i = 0; i < N_SIG; i++) {
+        for (int j = 0; j < BLK_PER_SIG; j++) {
+            hb_in[0][1 + i * BLK_PER_SIG + j] = ecdsaBlk[i % N_GOLDEN][j];
+            hb_in[1][1 + i * BLK_PER_SIG + j] = edBlk[i % N_GOLDEN][j];
+        }
+    }
+
+    std::cout << "Host map buffer has been allocated and set.\n";
+
+    // Get CL devices.
+    std::vector<cl::Device> devices = xcl::get_xil_devices();
+    cl::Device device = devices[0];
+
+    // Create context and command queue for selected device
+    cl::Context context(device);
+    cl::CommandQueue q(context, device, CL_QUEUE_PROFILING_ENABLE | CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE);
+    std::string devName = device.getInfo<CL_DEVICE_NAME>();
+    std::cout << "Selected Device " << devName << "\n";
+
+    cl::Program::Binaries xclBins = xcl::import_binary_file(xclbin_path);
+    devices.resize(1);
+    cl::Program program(context, devices, xclBins);
+
+    cl::Kernel kernel[2];
+    kernel[0] = cl::Kernel(program, "ecdsaP256VerifyKernel");
+    kernel[1] = cl::Kernel(program, "ed25519VerifyKernel");
+    const char* kernelName[2] = {"ECDSA P-256", "Ed25519"};
+    std::cout << "Kernel has been created.\n";
+
+    cl_mem_ext_ptr_t mext_in[2];
+    mext_in[0] = {XCL_MEM_DDR_BANK0, hb_in[0], 0};
+    mext_in[1] = {XCL_MEM_DDR_BANK1, hb_in[1], 0};
+
+    cl_mem_ext_ptr_t mext_out[2];
+    mext_out[0] = {XCL_MEM_DDR_BANK0, hb_out[0], 0};
+    mext_out[1] = {XCL_MEM_DDR_BANK1, hb_out[1], 0};
+
+    // Map buffers
+    cl::Buffer in_buff[2];
+    cl::Buffer out_buff[2];
+    for (int k = 0; k < 2; k++) {
+        in_buff[k] = cl::Buffer(context, CL_MEM_EXT_PTR_XILINX | CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY,
+                                (size_t)(sizeof(ap_uint<512>) * (1 + N_SIG * BLK_PER_SIG)), &mext_in[k]);
+        out_buff[k] = cl::Buffer(context, CL_MEM_EXT_PTR_XILINX | CL_MEM_USE_HOST_PTR | CL_MEM_WRITE_ONLY,
+                                 (size_t)(sizeof(ap_uint<512>) * ((N_SIG + 511) / 512)), &mext_out[k]);
+    }
+
+    std::cout << "DDR buffers have been mapped/copy-and-mapped\n";
+
+    int nerror = 0;
+    for (int k = 0; k < 2; k++) {
+        // write data to DDR
+        std::vector<cl::Memory> ib;
+        ib.push_back(in_buff[k]);
+        std::vector<cl::Memory> ob;
+        ob.push_back(out_buff[k]);
+        q.enqueueMigrateMemObjects(ib, 0, nullptr, nullptr);
+        q.finish();
+
+        // the kernel time only, signatures stay in DDR between the runs
+        kernel[k].setArg(0, in_buff[k]);
+        kernel[k].setArg(1, out_buff[k]);
+        struct timeval start_time, end_time;
+        gettimeofday(&start_time, 0);
+        for (int i = 0; i < num_rep; i++) {
+            q.enqueueTask(kernel[k], nullptr, nullptr);
+        }
+        q.finish();
+        gettimeofday(&end_time, 0);
+
+        // read data from DDR
+        q.enqueueMigrateMemObjects(ob, CL_MIGRATE_MEM_OBJECT_HOST, nullptr, nullptr);
+        q.finish();
+
+        int elapsed = tvdiff(&start_time, &end_time);
+        std::cout << kernelName[k] << " kernel has been run for " << std::dec << num_rep << " times." << std::endl;
+        std::cout << "Execution time " << elapsed << "us, "
+                  << (double)N_SIG * num_rep * 1000000.0 / (elapsed > 0 ? elapsed : 1) << " verifications/s"
+                  << std::endl;
+
+        // check result
+        bool* golden = (k == 0) ? ecdsaGolden : edGolden;
+        for (int i = 0; i < N_SIG; i++) {
+            bool result = hb_out[k][i / 512][i % 512];
+            if (result != golden[i % N_GOLDEN]) {
+                nerror++;
+                std::cout << "Error found in " << kernelName[k] << " signature " << i << ", golden = "
+                          << golden[i % N_GOLDEN] << ", fpga = " << result << std::endl;
+            }
+        }
+    }
+
+    if (nerror == 0) {
+        std::cout << std::dec << 2 * N_SIG << " signatures verified. No error found!" << std::endl;
+    }
+
+    return nerror;
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ *
+ * @file ecdsaP256VerifyKernel.cpp
+ * @brief kernel code of batched ECDSA P-256 signature verification.
+ * This file is part of Vitis Security Library.
+ *
+ * @detail Containing read-in, verify and write-out functions.
+ *
+ */
+
+#include <ap_int.h>
+#include <hls_stream.h>
+#include "xf_security/ecdsa_p256.hpp"
+
+#include "kernel_config.hpp"
+
+// @brief scan the signatures, one batch of _channelNumber at a time.
+template <unsigned int _channelNumber>
+static void readIn(ap_uint<512>* ptr,
+                   hls::stream<ap_uint<256> >& hashStrm,
+                   hls::stream<ap_uint<512> >& sigStrm,
+                   hls::stream<ap_uint<512> >& pubKeyStrm,
+                   hls::stream<bool>& endInStrm,
+                   hls::stream<unsigned int>& sigNumStrm) {
+    // number of signatures, a multiple of _channelNumber
+    unsigned int sigNum = ptr[0].range(63, 0);
+    sigNumStrm.write(sigNum);
+
+LOOP_SCAN:
+    for (unsigned int i = 0; i < sigNum; i++) {
+#pragma HLS pipeline II = BLK_PER_SIG
+        if (i % _channelNumber == 0) {
+            endInStrm.write(false);
+        }
+        hashStrm.write(ptr[1 + i * BLK_PER_SIG].range(256 - 1, 0));
+        sigStrm.write(ptr[2 + i * BLK_PER_SIG]);
+        pubKeyStrm.write(ptr[3 + i * BLK_PER_SIG].range(512 - 1, 0));
+    }
+    endInStrm.write(true);
+} // end readIn
+
+// @brief pack the results, one bit per signature.
+static void writeOut(hls::stream<unsigned int>& sigNumStrm, hls::stream<bool>& resultStrm, ap_uint<512>* ptr) {
+    unsigned int sigNum = sigNumStrm.read();
+    ap_uint<512> blk = 0;
+
+LOOP_WRITE:
+    for (unsigned int i = 0; i < sigNum; i++) {
+#pragma HLS pipeline II = 1
+        blk[i % 512] = resultStrm.read();
+        if (i % 512 == 511 || i == sigNum - 1) {
+            ptr[i / 512] = blk;
+            blk = 0;
+        }
+    }
+} // end writeOut
+
+// @brief top of kernel
+extern "C" void ecdsaP256VerifyKernel(ap_uint<512> inputData[(1 << 20) + 1], ap_uint<512> outputData[1 << 20]) {
+#pragma HLS dataflow
+
+// clang-format off
+#pragma HLS INTERFACE m_axi offset = slave latency = 64 \
+	num_write_outstanding = 16 num_read_outstanding = 16 \
+	max_write_burst_length = 64 max_read_burst_length = 64 \
+	bundle = gmem0_0 port = inputData
+
+#pragma HLS INTERFACE m_axi offset = slave latency = 64 \
+	num_write_outstanding = 16 num_read_outstanding = 16 \
+	max_write_burst_length = 64 max_read_burst_length = 64 \
+	bundle = gmem0_1 port = outputData
+// clang-format on
+
+#pragma HLS INTERFACE s_axilite port = inputData bundle = control
+#pragma HLS INTERFACE s_axilite port = outputData bundle = control
+#pragma HLS INTERFACE s_axilite port = return bundle = control
+
+    // a whole batch is buffered, so the next one is read while the current one is verified
+    hls::stream<ap_uint<256> > hashStrm;
+#pragma HLS stream variable = hashStrm depth = 2 * CH_NM
+#pragma HLS resource variable = hashStrm core = FIFO_LUTRAM
+    hls::stream<ap_uint<512> > sigStrm;
+#pragma HLS stream variable = sigStrm depth = 2 * CH_NM
+#pragma HLS resource variable = sigStrm core = FIFO_LUTRAM
+    hls::stream<ap_uint<512> > pubKeyStrm;
+#pragma HLS stream variable = pubKeyStrm depth = 2 * CH_NM
+#pragma HLS resource variable = pubKeyStrm core = FIFO_LUTRAM
+    hls::stream<bool> endInStrm;
+#pragma HLS stream variable = endInStrm depth = 4
+#pragma HLS resource variable = endInStrm core = FIFO_LUTRAM
+    hls::stream<unsigned int> sigNumStrm;
+#pragma HLS stream variable = sigNumStrm depth = 2
+#pragma HLS resource variable = sigNumStrm core = FIFO_LUTRAM
+    hls::stream<bool> resultStrm;
+#pragma HLS stream variable = resultStrm depth = 2 * CH_NM
+#pragma HLS resource variable = resultStrm core = FIFO_LUTRAM
+
+    readIn<CH_NM>(inputData, hashStrm, sigStrm, pubKeyStrm, endInStrm, sigNumStrm);
+
+    xf::security::ecdsaP256VerifyMultiChan<CH_NM>(hashStrm, sigStrm, pubKeyStrm, endInStrm, resultStrm);
+
+    writeOut(sigNumStrm, resultStrm, outputData);
+} // end ecdsaP256VerifyKernel
@@ -0,0 +1,27 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __KERNEL_CONFIG_HPP_
+#define __KERNEL_CONFIG_HPP_
+
+// number of verifications interleaved in each kernel
+#define CH_NM 16
+
+// input layout: one configuration block with the number of signatures in bits 63..0, then three 512-bit blocks per
+// signature: message hash, signature, public key
+// output layout: one bit per signature, 512 signatures per block
+#define BLK_PER_SIG 3
+
+#endif
@@ -0,0 +1,597 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <ap_int.h>
+#include <iostream>
+#include <fstream>
+
+#include <sys/time.h>
+#include <new>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+
+#include <xcl2.hpp>
+
+#include "kernel_config.hpp"
+
+class ArgParser {
+   public:
+    ArgParser(int& argc, const char** argv) {
+        for (int i = 1; i < argc; ++i) mTokens.push_back(std::string(argv[i]));
+    }
+    bool getCmdOption(const std::string option, std::string& value) const {
+        std::vector<std::string>::const_iterator itr;
+        itr = std::find(this->mTokens.begin(), this->mTokens.end(), option);
+        if (itr != this->mTokens.end() && ++itr != this->mTokens.end()) {
+            value = *itr;
+            return true;
+        }
+        return false;
+    }
+
+   private:
+    std::vector<std::string> mTokens;
+};
+
+inline long tvdiff(struct timeval* tv0, struct timeval* tv1) {
+    return (tv1->tv_sec - tv0->tv_sec) * 1000000L + (tv1->tv_usec - tv0->tv_usec);
+}
+
+template <typename T>
+T* aligned_alloc(std::size_t num) {
+    void* ptr = nullptr;
+    if (posix_memalign(&ptr, 4096, num * sizeof(T))) throw std::bad_alloc();
+    return reinterpret_cast<T*>(ptr);
+}
+
+// name, output text, output tag block, tag bytes
+struct AlgoInfo {
+    const char* name;
+    bool text;
+    bool tag;
+    int tagLen;
+};
+
+static const AlgoInfo ALGOS[ALGO_NUM] = {
+    {"aes256_ecb", true, false, 0},  {"aes256_cbc", true, false, 0},       {"aes256_ctr", true, false, 0},
+    {"aes256_cfb128", true, false, 0}, {"aes256_ofb", true, false, 0},     {"aes256_xts", true, false, 0},
+    {"aes256_gcm", true, true, 16},  {"aes256_ccm", true, true, 16},       {"chacha20", true, false, 0},
+    {"chacha20_poly1305", true, true, 16}, {"rc4", true, false, 0},        {"poly1305", false, true, 16},
+    {"hmac_sha256", false, true, 32}, {"md4", false, true, 16},            {"md5", false, true, 16},
+    {"sha1", false, true, 20},       {"sha256", false, true, 32},          {"sha512", false, true, 64},
+    {"sha3_256", false, true, 32},   {"blake2b", false, true, 64},         {"blake3", false, true, 32}};
+
+static size_t blkNum(size_t len) {
+    return (len + 63) / 64;
+}
+
+static size_t outBlkNum(int algo, size_t len) {
+    return (ALGOS[algo].text ? blkNum(len) : 0) + (ALGOS[algo].tag ? 1 : 0);
+}
+
+// keys of all the messages, the XTS key takes the whole 64 bytes and RC4 the first 16
+static unsigned char g_key[64];
+// IV or nonce in bytes 0 to 15, AAD in bytes 16 to 31
+static unsigned char g_iv[32];
+
+// OpenSSL reference of one algorithm, the contexts are reused by all the messages of a thread
+class RefEngine {
+   public:
+    RefEngine(int algo) : mAlgo(algo), mCipher(nullptr), mMd(nullptr), mPkey(nullptr) {
+        mCtx = EVP_CIPHER_CTX_new();
+        mMdCtx = EVP_MD_CTX_new();
+        switch (algo) {
+            case ALGO_AES256_ECB:
+                mCipher = EVP_aes_256_ecb();
+                break;
+            case ALGO_AES256_CBC:
+                mCipher = EVP_aes_256_cbc();
+                break;
+            case ALGO_AES256_CTR:
+                mCipher = EVP_aes_256_ctr();
+                break;
+            case ALGO_AES256_CFB128:
+                mCipher = EVP_aes_256_cfb128();
+                break;
+            case ALGO_AES256_OFB:
+                mCipher = EVP_aes_256_ofb();
+                break;
+            case ALGO_AES256_XTS:
+                mCipher = EVP_aes_256_xts();
+                break;
+            case ALGO_AES256_GCM:
+                mCipher = EVP_aes_256_gcm();
+                break;
+            case ALGO_AES256_CCM:
+                mCipher = EVP_aes_256_ccm();
+                break;
+            case ALGO_CHACHA20:
+                mCipher = EVP_chacha20();
+                break;
+            case ALGO_CHACHA20_POLY1305:
+                mCipher = EVP_chacha20_poly1305();
+                break;
+            case ALGO_RC4:
+                mCipher = EVP_rc4();
+                break;
+            case ALGO_POLY1305:
+                mPkey = EVP_PKEY_new_raw_private_key(EVP_PKEY_POLY1305, nullptr, g_key, 32);
+                break;
+            case ALGO_MD4:
+                mMd = EVP_md4();
+                break;
+            case ALGO_MD5:
+                mMd = EVP_md5();
+                break;
+            case ALGO_SHA1:
+                mMd = EVP_sha1();
+                break;
+            case ALGO_HMAC_SHA256:
+            case ALGO_SHA256:
+                mMd = EVP_sha256();
+                break;
+            case ALGO_SHA512:
+                mMd = EVP_sha512();
+                break;
+            case ALGO_SHA3_256:
+                mMd = EVP_sha3_256();
+                break;
+            case ALGO_BLAKE2B:
+                mMd = EVP_blake2b512();
+                break;
+            default:
+                break;
+        }
+    }
+    ~RefEngine() {
+        EVP_CIPHER_CTX_free(mCtx);
+        EVP_MD_CTX_free(mMdCtx);
+        EVP_PKEY_free(mPkey);
+    }
+
+    // process one message, false when OpenSSL here does not provide the algorithm
+    bool run(const unsigned char* msg, size_t len, unsigned char* text, unsigned char* tag) {
+        int outl = 0;
+        int n = (int)len;
+        if (mCipher != nullptr) {
+            bool aead = mAlgo == ALGO_AES256_GCM || mAlgo == ALGO_AES256_CCM || mAlgo == ALGO_CHACHA20_POLY1305;
+            if (!aead) {
+                if (EVP_EncryptInit_ex(mCtx, mCipher, nullptr, g_key, mAlgo == ALGO_RC4 ? nullptr : g_iv) != 1) {
+                    return false;
+                }
+                EVP_CIPHER_CTX_set_padding(mCtx, 0);
+                EVP_EncryptUpdate(mCtx, text, &outl, msg, n);
+                return EVP_EncryptFinal_ex(mCtx, text + outl, &outl) == 1;
+            }
+            if (EVP_EncryptInit_ex(mCtx, mCipher, nullptr, nullptr, nullptr) != 1) {
+                return false;
+            }
+            if (mAlgo == ALGO_AES256_CCM) {
+                EVP_CIPHER_CTX_ctrl(mCtx, EVP_CTRL_AEAD_SET_IVLEN, 7, nullptr);
+                EVP_CIPHER_CTX_ctrl(mCtx, EVP_CTRL_AEAD_SET_TAG, 16, nullptr);
+            } else {
+                EVP_CIPHER_CTX_ctrl(mCtx, EVP_CTRL_AEAD_SET_IVLEN, 12, nullptr);
+            }
+            EVP_EncryptInit_ex(mCtx, nullptr, nullptr, g_key, g_iv);
+            if (mAlgo == ALGO_AES256_CCM) {
+                EVP_EncryptUpdate(mCtx, nullptr, &outl, nullptr, n);
+            }
+            EVP_EncryptUpdate(mCtx, nullptr, &outl, g_iv + 16, 16);
+            EVP_EncryptUpdate(mCtx, text, &outl, msg, n);
+            EVP_EncryptFinal_ex(mCtx, text + outl, &outl);
+            return EVP_CIPHER_CTX_ctrl(mCtx, EVP_CTRL_AEAD_GET_TAG, 16, tag) == 1;
+        }
+        if (mAlgo == ALGO_POLY1305) {
+            size_t tagl = 16;
+            if (mPkey == nullptr || EVP_DigestSignInit(mMdCtx, nullptr, nullptr, nullptr, mPkey) != 1) {
+                return false;
+            }
+            EVP_DigestSignUpdate(mMdCtx, msg, len);
+            return EVP_DigestSignFinal(mMdCtx, tag, &tagl) == 1;
+        }
+        if (mAlgo == ALGO_HMAC_SHA256) {
+            unsigned int tagl = 32;
+            return HMAC(mMd, g_key, 32, msg, len, tag, &tagl) != nullptr;
+        }
+        if (mMd != nullptr) {
+            unsigned int tagl = 0;
+            if (EVP_DigestInit_ex(mMdCtx, mMd, nullptr) != 1) {
+                return false;
+            }
+            EVP_DigestUpdate(mMdCtx, msg, len);
+            return EVP_DigestFinal_ex(mMdCtx, tag, &tagl) == 1;
+        }
+        // no OpenSSL baseline, BLAKE3
+        return false;
+    }
+
+   private:
+    int mAlgo;
+    const EVP_CIPHER* mCipher;
+    const EVP_MD* mMd;
+    EVP_PKEY* mPkey;
+    EVP_CIPHER_CTX* mCtx;
+    EVP_MD_CTX* mMdCtx;
+};
+
+// one line of the results
+struct Result {
+    std::string platform;
+    int algo;
+    size_t len;
+    int cu;
+    int thread;
+    size_t msgNum;
+    double gbps;
+    double p50;
+    double p90;
+    double p99;
+    std::string verified;
+};
+
+static double percentile(std::vector<double>& v, double p) {
+    if (v.empty()) {
+        return 0;
+    }
+    std::sort(v.begin(), v.end());
+    size_t i = (size_t)(p * (v.size() - 1) + 0.5);
+    return v[i];
+}
+
+static void printResult(const Result& r, std::ofstream& csv) {
+    std::cout << r.platform << " " << ALGOS[r.algo].name << " " << r.len << "B x " << r.msgNum << " msgs, cu "
+              << r.cu << ", thread " << r.thread << ": ";
+    if (r.verified == "n/a" && r.gbps == 0) {
+        std::cout << "n/a" << std::endl;
+    } else {
+        std::cout << r.gbps << " GB/s, p50 " << r.p50 << " us, p90 " << r.p90 << " us, p99 " << r.p99
+                  << " us, verified " << r.verified << std::endl;
+    }
+    csv << r.platform << "," << ALGOS[r.algo].name << "," << r.len << "," << r.cu << "," << r.thread << ","
+        << r.msgNum << "," << r.gbps << "," << r.p50 << "," << r.p90 << "," << r.p99 << "," << r.verified
+        << std::endl;
+}
+
+// CPU baseline, the messages are split among the threads and every message is timed
+static Result runCpu(int algo, const unsigned char* msgs, size_t len, size_t msgNum, int threadNum, int rep) {
+    Result r = {"cpu", algo, len, 0, threadNum, msgNum, 0, 0, 0, 0, "n/a"};
+    // latency of each message in ns, a message of 64 B to 1 KB takes well under 1 us
+    std::vector<std::vector<double> > lat(threadNum);
+    std::vector<int> ok(threadNum, 1);
+    struct timeval tv0, tv1;
+    gettimeofday(&tv0, 0);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threadNum; t++) {
+        workers.push_back(std::thread([&, t]() {
+            RefEngine eng(algo);
+            std::vector<unsigned char> text(len);
+            unsigned char tag[64];
+            for (int i = 0; i < rep; i++) {
+                for (size_t m = t; m < msgNum; m += threadNum) {
+                    std::chrono::steady_clock::time_point m0 = std::chrono::steady_clock::now();
+                    if (!eng.run(msgs + m * len, len, text.data(), tag)) {
+                        ok[t] = 0;
+                        return;
+                    }
+                    std::chrono::steady_clock::time_point m1 = std::chrono::steady_clock::now();
+                    lat[t].push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(m1 - m0).count());
+                }
+            }
+        }));
+    }
+    for (size_t t = 0; t < workers.size(); t++) {
+        workers[t].join();
+    }
+    gettimeofday(&tv1, 0);
+    if (std::find(ok.begin(), ok.end(), 0) != ok.end()) {
+        return r;
+    }
+    std::vector<double> all;
+    for (int t = 0; t < threadNum; t++) {
+        all.insert(all.end(), lat[t].begin(), lat[t].end());
+    }
+    long us = tvdiff(&tv0, &tv1);
+    r.gbps = (double)len * msgNum * rep / 1000.0 / (us > 0 ? us : 1);
+    r.p50 = percentile(all, 0.50) / 1000.0;
+    r.p90 = percentile(all, 0.90) / 1000.0;
+    r.p99 = percentile(all, 0.99) / 1000.0;
+    r.verified = "-";
+    return r;
+}
+
+// pack the header, key, IV and messages into the input blocks of the kernel
+static void packInput(const unsigned char* msgs, size_t len, size_t msgNum, ap_uint<512>* in) {
+    in[0] = 0;
+    in[0].range(63, 0) = msgNum;
+    in[0].range(127, 64) = len;
+    in[1] = 0;
+    in[2] = 0;
+    for (int i = 0; i < 64; i++) {
+        in[1].range(8 * i + 7, 8 * i) = g_key[i];
+    }
+    for (int i = 0; i < 32; i++) {
+        in[2].range(8 * i + 7, 8 * i) = g_iv[i];
+    }
+    for (size_t m = 0; m < msgNum; m++) {
+        for (size_t k = 0; k < blkNum(len); k++) {
+            ap_uint<512> b = 0;
+            for (size_t j = 0; j < 64 && k * 64 + j < len; j++) {
+                b.range(8 * j + 7, 8 * j) = msgs[m * len + k * 64 + j];
+            }
+            in[HDR_BLK + m * blkNum(len) + k] = b;
+        }
+    }
+}
+
+// compare the kernel output of every message with OpenSSL, "n/a" when there is no reference
+static std::string checkOutput(int algo, const unsigned char* msgs, size_t len, size_t msgNum, ap_uint<512>* out) {
+    RefEngine eng(algo);
+    std::vector<unsigned char> text(len);
+    unsigned char tag[64];
+    int nerror = 0;
+    for (size_t m = 0; m < msgNum; m++) {
+        if (!eng.run(msgs + m * len, len, text.data(), tag)) {
+            return "n/a";
+        }
+        size_t base = m * outBlkNum(algo, len);
+        if (ALGOS[algo].text) {
+            for (size_t j = 0; j < len; j++) {
+                if ((unsigned int)out[base + j / 64].range(8 * (j % 64) + 7, 8 * (j % 64)) != text[j]) {
+                    nerror++;
+                    break;
+                }
+            }
+            base += blkNum(len);
+        }
+        for (int j = 0; j < ALGOS[algo].tagLen; j++) {
+            if ((unsigned int)out[base].range(8 * j + 7, 8 * j) != tag[j]) {
+                nerror++;
+                break;
+            }
+        }
+    }
+    if (nerror) {
+        std::cout << "Error found in " << nerror << " messages." << std::endl;
+    }
+    return nerror ? "fail" : "pass";
+}
+
+// the buffers of one CU
+struct CuBuf {
+    ap_uint<512>* hbIn;
+    ap_uint<512>* hbOut;
+    cl::Buffer inBuff;
+    cl::Buffer outBuff;
+    cl::Kernel kernel;
+};
+
+static const unsigned int BANKS[4] = {XCL_MEM_DDR_BANK0, XCL_MEM_DDR_BANK1, XCL_MEM_DDR_BANK2, XCL_MEM_DDR_BANK3};
+
+// FPGA run, every call copies the messages in, runs the kernel and copies the results out, the CUs run in parallel
+static Result runFpga(cl::Context& context,
+                      cl::CommandQueue& q,
+                      std::vector<CuBuf>& cus,
+                      int algo,
+                      const unsigned char* msgs,
+                      size_t len,
+                      size_t msgNum,
+                      int rep) {
+    int cuNum = cus.size();
+    Result r = {"fpga", algo, len, cuNum, 1, msgNum, 0, 0, 0, 0, "n/a"};
+    size_t inSize = sizeof(ap_uint<512>) * (HDR_BLK + msgNum * blkNum(len));
+    size_t outSize = sizeof(ap_uint<512>) * msgNum * outBlkNum(algo, len);
+    for (int c = 0; c < cuNum; c++) {
+        packInput(msgs, len, msgNum, cus[c].hbIn);
+    }
+
+    std::vector<std::vector<cl::Event> > wEvents(rep * cuNum, std::vector<cl::Event>(1));
+    std::vector<std::vector<cl::Event> > kEvents(rep * cuNum, std::vector<cl::Event>(1));
+    std::vector<std::vector<cl::Event> > rEvents(rep * cuNum, std::vector<cl::Event>(1));
+    struct timeval tv0, tv1;
+    gettimeofday(&tv0, 0);
+    for (int i = 0; i < rep; i++) {
+        for (int c = 0; c < cuNum; c++) {
+            int e = i * cuNum + c;
+            // a call reuses the buffers of the CU after its previous call is read back
+            std::vector<cl::Event>* wWait = i > 0 ? &rEvents[e - cuNum] : nullptr;
+            q.enqueueWriteBuffer(cus[c].inBuff, CL_FALSE, 0, inSize, cus[c].hbIn, wWait, &wEvents[e][0]);
+            q.enqueueTask(cus[c].kernel, &wEvents[e], &kEvents[e][0]);
+            q.enqueueReadBuffer(cus[c].outBuff, CL_FALSE, 0, outSize, cus[c].hbOut, &kEvents[e], &rEvents[e][0]);
+        }
+    }
+    q.finish();
+    gettimeofday(&tv1, 0);
+
+    // latency of each call in ns
+    std::vector<double> lat;
+    for (int e = 0; e < rep * cuNum; e++) {
+        cl_ulong start, end;
+        wEvents[e][0].getProfilingInfo(CL_PROFILING_COMMAND_START, &start);
+        rEvents[e][0].getProfilingInfo(CL_PROFILING_COMMAND_END, &end);
+        lat.push_back(end - start);
+    }
+    long us = tvdiff(&tv0, &tv1);
+    r.gbps = (double)len * msgNum * cuNum * rep / 1000.0 / (us > 0 ? us : 1);
+    r.p50 = percentile(lat, 0.50) / 1000.0;
+    r.p90 = percentile(lat, 0.90) / 1000.0;
+    r.p99 = percentile(lat, 0.99) / 1000.0;
+    r.verified = "pass";
+    for (int c = 0; c < cuNum; c++) {
+        std::string v = checkOutput(algo, msgs, len, msgNum, cus[c].hbOut);
+        if (v != "pass") {
+            r.verified = v;
+        }
+    }
+    return r;
+}
+
+int main(int argc, char* argv[]) {
+    // cmd parser
+    ArgParser parser(argc, (const char**)argv);
+    std::string mode = "fpga";
+    std::string str;
+    parser.getCmdOption("-mode", mode);
+
+    // the algorithms, the FPGA runs the one its kernel is built for
+    std::vector<int> algos;
+    if (parser.getCmdOption("-algo", str)) {
+        for (int a = 0; a < ALGO_NUM; a++) {
+            if (str == ALGOS[a].name) {
+                algos.push_back(a);
+            }
+        }
+        if (algos.empty()) {
+            std::cout << "ERROR: unknown algorithm " << str << std::endl;
+            return 1;
+        }
+    } else if (mode == "cpu") {
+        for (int a = 0; a < ALGO_NUM; a++) {
+            algos.push_back(a);
+        }
+    } else {
+        algos.push_back(BENCH_ALGO);
+    }
+    if (mode == "fpga" && (algos.size() != 1 || algos[0] != BENCH_ALGO)) {
+        std::cout << "ERROR: the kernel is built for " << ALGOS[BENCH_ALGO].name << std::endl;
+        return 1;
+    }
+
+    // message sizes from min to max, multiplied by 4 each step
+    size_t minLen = 64;
+    size_t maxLen = 64 << 20;
+    size_t batch = 16 << 20;
+    int cuNum = 1;
+    int threadNum = 1;
+    int rep = 3;
+    if (parser.getCmdOption("-min", str)) minLen = std::stoul(str);
+    if (parser.getCmdOption("-max", str)) maxLen = std::stoul(str);
+    if (parser.getCmdOption("-batch", str)) batch = std::stoul(str);
+    if (parser.getCmdOption("-cu", str)) cuNum = std::stoi(str);
+    if (parser.getCmdOption("-thread", str)) threadNum = std::stoi(str);
+    if (parser.getCmdOption("-rep", str)) rep = std::stoi(str);
+    std::string csvPath = "results.csv";
+    parser.getCmdOption("-out", csvPath);
+    // the block ciphers take whole blocks
+    minLen = std::max<size_t>(64, minLen & ~(size_t)63);
+    maxLen = std::min<size_t>((size_t)(MAX_IN_BLK - HDR_BLK) * 64, maxLen);
+    if (cuNum < 1 || threadNum < 1 || rep < 1) {
+        std::cout << "ERROR: -cu, -thread and -rep should be positive" << std::endl;
+        return 1;
+    }
+
+    // the messages are random, the key and IV are shared
+    for (int i = 0; i < 64; i++) {
+        g_key[i] = rand();
+    }
+    for (int i = 0; i < 32; i++) {
+        g_iv[i] = rand();
+    }
+    size_t maxBytes = std::max(maxLen, batch);
+    std::vector<unsigned char> msgs(maxBytes);
+    for (size_t i = 0; i < maxBytes; i++) {
+        msgs[i] = rand();
+    }
+
+    std::ofstream csv(csvPath);
+    csv << "platform,algo,msg_bytes,cu,thread,msgs,gbps,p50_us,p90_us,p99_us,verified" << std::endl;
+
+    if (mode == "cpu") {
+        for (size_t a = 0; a < algos.size(); a++) {
+            for (size_t len = minLen; len <= maxLen; len *= 4) {
+                size_t msgNum = std::max<size_t>(1, batch / len);
+                printResult(runCpu(algos[a], msgs.data(), len, msgNum, threadNum, rep), csv);
+            }
+        }
+        return 0;
+    }
+
+    std::string xclbin_path;
+    if (!parser.getCmdOption("-xclbin", xclbin_path)) {
+        std::cout << "ERROR:xclbin path is not set!\n";
+        return 1;
+    }
+
+    // Get CL devices.
+    std::vector<cl::Device> devices = xcl::get_xil_devices();
+    cl::Device device = devices[0];
+
+    // Create context and command queue for selected device
+    cl::Context context(device);
+    cl::CommandQueue q(context, device, CL_QUEUE_PROFILING_ENABLE | CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE);
+    std::string devName = device.getInfo<CL_DEVICE_NAME>();
+    std::cout << "Selected Device " << devName << "\n";
+
+    cl::Program::Binaries xclBins = xcl::import_binary_file(xclbin_path);
+    devices.resize(1);
+    cl::Program program(context, devices, xclBins);
+
+    // one pair of buffers in the bank of each CU, sized for the largest call
+    size_t inBlk = 0;
+    size_t outBlk = 0;
+    for (size_t len = minLen; len <= maxLen; len *= 4) {
+        size_t msgNum = std::max<size_t>(1, batch / len);
+        inBlk = std::max(inBlk, HDR_BLK + msgNum * blkNum(len));
+        outBlk = std::max(outBlk, msgNum * outBlkNum(BENCH_ALGO, len));
+    }
+    if (inBlk > MAX_IN_BLK || outBlk > MAX_OUT_BLK) {
+        std::cout << "ERROR: -batch is too large for the kernel" << std::endl;
+        return 1;
+    }
+    std::vector<CuBuf> cus(cuNum);
+    for (int c = 0; c < cuNum; c++) {
+        std::string name = "benchKernel:{benchKernel_" + std::to_string(c + 1) + "}";
+        cus[c].kernel = cl::Kernel(program, name.c_str());
+        cus[c].hbIn = aligned_alloc<ap_uint<512> >(inBlk);
+        cus[c].hbOut = aligned_alloc<ap_uint<512> >(outBlk);
+        cl_mem_ext_ptr_t mext_in = {BANKS[c % 4], cus[c].hbIn, 0};
+        cl_mem_ext_ptr_t mext_out = {BANKS[c % 4], cus[c].hbOut, 0};
+        cus[c].inBuff = cl::Buffer(context, CL_MEM_EXT_PTR_XILINX | CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY,
+                                   sizeof(ap_uint<512>) * inBlk, &mext_in);
+        cus[c].outBuff = cl::Buffer(context, CL_MEM_EXT_PTR_XILINX | CL_MEM_USE_HOST_PTR | CL_MEM_WRITE_ONLY,
+                                    sizeof(ap_uint<512>) * outBlk, &mext_out);
+        cus[c].kernel.setArg(0, cus[c].inBuff);
+        cus[c].kernel.setArg(1, cus[c].outBuff);
+    }
+    std::cout << cuNum << " CUs and their DDR buffers have been created.\n";
+
+    int nerror = 0;
+    for (size_t len = minLen; len <= maxLen; len *= 4) {
+        size_t msgNum = std::max<size_t>(1, batch / len);
+        Result r = runFpga(context, q, cus, BENCH_ALGO, msgs.data(), len, msgNum, rep);
+        if (r.verified == "fail") {
+            nerror++;
+        }
+        printResult(r, csv);
+    }
+
+    for (int c = 0; c < cuNum; c++) {
+        free(cus[c].hbIn);
+        free(cus[c].hbOut);
+    }
+    if (nerror == 0) {
+        std::cout << "Results are written to " << csvPath << ". No error found!" << std::endl;
+    }
+    return nerror;
+}
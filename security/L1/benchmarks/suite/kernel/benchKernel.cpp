@@ -0,0 +1,666 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ *
+ * @file benchKernel.cpp
+ * @brief kernel code of the benchmark suite, built for one algorithm selected by BENCH_ALGO.
+ * This file is part of Vitis Security Library.
+ *
+ * @detail All the messages of a call have the same length and are processed with the same key. Primitives taking a
+ * list of messages see all of them in one dataflow region, and the ones taking a single message are called once per
+ * message.
+ *
+ */
+
+#include <ap_int.h>
+#include <hls_stream.h>
+
+#include "kernel_config.hpp"
+
+#if BENCH_ALGO == ALGO_AES256_ECB
+#include "xf_security/ecb.hpp"
+#elif BENCH_ALGO == ALGO_AES256_CBC
+#include "xf_security/cbc.hpp"
+#elif BENCH_ALGO == ALGO_AES256_CTR
+#include "xf_security/ctr.hpp"
+#elif BENCH_ALGO == ALGO_AES256_CFB128
+#include "xf_security/cfb.hpp"
+#elif BENCH_ALGO == ALGO_AES256_OFB
+#include "xf_security/ofb.hpp"
+#elif BENCH_ALGO == ALGO_AES256_XTS
+#include "xf_security/xts.hpp"
+#elif BENCH_ALGO == ALGO_AES256_GCM
+#include "xf_security/gcm.hpp"
+#elif BENCH_ALGO == ALGO_AES256_CCM
+#include "xf_security/ccm.hpp"
+#elif BENCH_ALGO == ALGO_CHACHA20
+#include "xf_security/chacha20.hpp"
+#elif BENCH_ALGO == ALGO_CHACHA20_POLY1305
+#include "xf_security/chacha20_poly1305.hpp"
+#elif BENCH_ALGO == ALGO_RC4
+#include "xf_security/rc4.hpp"
+#elif BENCH_ALGO == ALGO_POLY1305
+#include "xf_security/poly1305.hpp"
+#elif BENCH_ALGO == ALGO_HMAC_SHA256
+#include "xf_security/hmac.hpp"
+#include "xf_security/sha224_256.hpp"
+#elif BENCH_ALGO == ALGO_MD4
+#include "xf_security/md4.hpp"
+#elif BENCH_ALGO == ALGO_MD5
+#include "xf_security/md5.hpp"
+#elif BENCH_ALGO == ALGO_SHA1
+#include "xf_security/sha1.hpp"
+#elif BENCH_ALGO == ALGO_SHA256
+#include "xf_security/sha224_256.hpp"
+#elif BENCH_ALGO == ALGO_SHA512
+#include "xf_security/sha512_t.hpp"
+#elif BENCH_ALGO == ALGO_SHA3_256
+#include "xf_security/sha3.hpp"
+#elif BENCH_ALGO == ALGO_BLAKE2B
+#include "xf_security/blake2b.hpp"
+#elif BENCH_ALGO == ALGO_BLAKE3
+#include "xf_security/blake3.hpp"
+#endif
+
+// ciphers output a text per message, AEADs a text and a tag, MACs and hashes a tag or digest
+#if BENCH_ALGO <= ALGO_AES256_XTS || BENCH_ALGO == ALGO_CHACHA20 || BENCH_ALGO == ALGO_RC4
+#define OUT_TEXT 1
+#define OUT_TAG 0
+#elif BENCH_ALGO == ALGO_AES256_GCM || BENCH_ALGO == ALGO_AES256_CCM || BENCH_ALGO == ALGO_CHACHA20_POLY1305
+#define OUT_TEXT 1
+#define OUT_TAG 1
+#else
+#define OUT_TEXT 0
+#define OUT_TAG 1
+#endif
+
+// @brief split the blocks from blk into num words of W bits, lowest word first.
+template <int W>
+static void readWords(ap_uint<512>* ptr, uint64_t blk, uint64_t num, hls::stream<ap_uint<W> >& strm) {
+    ap_uint<512> b = 0;
+LOOP_READ_WORD:
+    for (uint64_t i = 0; i < num; i++) {
+#pragma HLS pipeline II = 1
+        unsigned int k = i % (512 / W);
+        if (k == 0) {
+            b = ptr[blk + i / (512 / W)];
+        }
+        strm.write(b.range(W * k + W - 1, W * k));
+    }
+} // end readWords
+
+// @brief split the blocks from blk into num words of W bits with a false end flag each, and a true one to end.
+template <int W>
+static void readWordsEnd(
+    ap_uint<512>* ptr, uint64_t blk, uint64_t num, hls::stream<ap_uint<W> >& strm, hls::stream<bool>& endStrm) {
+    ap_uint<512> b = 0;
+LOOP_READ_WORD_END:
+    for (uint64_t i = 0; i < num; i++) {
+#pragma HLS pipeline II = 1
+        unsigned int k = i % (512 / W);
+        if (k == 0) {
+            b = ptr[blk + i / (512 / W)];
+        }
+        strm.write(b.range(W * k + W - 1, W * k));
+        endStrm.write(false);
+    }
+    endStrm.write(true);
+} // end readWordsEnd
+
+// @brief gather num words of W bits into blocks from blk.
+template <int W>
+static void writeWords(hls::stream<ap_uint<W> >& strm, uint64_t num, ap_uint<512>* ptr, uint64_t blk) {
+    ap_uint<512> b = 0;
+LOOP_WRITE_WORD:
+    for (uint64_t i = 0; i < num; i++) {
+#pragma HLS pipeline II = 1
+        unsigned int k = i % (512 / W);
+        b.range(W * k + W - 1, W * k) = strm.read();
+        if (k == 512 / W - 1 || i == num - 1) {
+            ptr[blk + i / (512 / W)] = b;
+            b = 0;
+        }
+    }
+} // end writeWords
+
+// @brief gather the words of W bits into blocks from blk until a true end flag.
+template <int W>
+static void writeWordsEnd(hls::stream<ap_uint<W> >& strm,
+                          hls::stream<bool>& endStrm,
+                          ap_uint<512>* ptr,
+                          uint64_t blk) {
+    ap_uint<512> b = 0;
+    uint64_t i = 0;
+LOOP_WRITE_WORD_END:
+    while (!endStrm.read()) {
+#pragma HLS pipeline II = 1
+        unsigned int k = i % (512 / W);
+        b.range(W * k + W - 1, W * k) = strm.read();
+        if (k == 512 / W - 1) {
+            ptr[blk + i / (512 / W)] = b;
+            b = 0;
+        }
+        i++;
+    }
+    if (i % (512 / W)) {
+        ptr[blk + i / (512 / W)] = b;
+    }
+} // end writeWordsEnd
+
+// @brief number of 512-bit blocks of a message of len bytes.
+static uint64_t blkNum(uint64_t len) {
+#pragma HLS inline
+    return (len + 63) >> 6;
+}
+
+// @brief number of output blocks of a message of len bytes.
+static uint64_t outBlkNum(uint64_t len) {
+#pragma HLS inline
+    return (OUT_TEXT ? blkNum(len) : 0) + OUT_TAG;
+}
+
+#if BENCH_ALGO <= ALGO_AES256_XTS || BENCH_ALGO == ALGO_CHACHA20 || BENCH_ALGO == ALGO_RC4
+
+#if BENCH_ALGO == ALGO_CHACHA20
+#define TEXT_W 512
+#elif BENCH_ALGO == ALGO_RC4
+#define TEXT_W 8
+#else
+#define TEXT_W 128
+#endif
+
+// @brief read the key, IV and text of message m.
+static void readText(ap_uint<512>* ptr,
+                     uint64_t m,
+                     uint64_t len,
+#if BENCH_ALGO == ALGO_RC4
+                     hls::stream<ap_uint<8> >& keyStrm,
+                     hls::stream<bool>& endKeyStrm,
+#else
+                     hls::stream<ap_uint<256> >& keyStrm,
+#endif
+#if BENCH_ALGO == ALGO_AES256_XTS
+                     hls::stream<ap_uint<64> >& lenStrm,
+#endif
+#if BENCH_ALGO != ALGO_AES256_ECB && BENCH_ALGO != ALGO_RC4
+                     hls::stream<ap_uint<128> >& ivStrm,
+#endif
+                     hls::stream<ap_uint<TEXT_W> >& textStrm,
+                     hls::stream<bool>& endTextStrm) {
+#if BENCH_ALGO == ALGO_RC4
+    readWordsEnd<8>(ptr, 1, 16, keyStrm, endKeyStrm);
+#else
+    ap_uint<512> key = ptr[1];
+    keyStrm.write(key.range(255, 0));
+#if BENCH_ALGO == ALGO_AES256_XTS
+    keyStrm.write(key.range(511, 256));
+    lenStrm.write(len * 8);
+#endif
+#if BENCH_ALGO != ALGO_AES256_ECB
+    ap_uint<512> iv = ptr[2];
+    ivStrm.write(iv.range(127, 0));
+#endif
+#endif
+    readWordsEnd<TEXT_W>(ptr, HDR_BLK + m * blkNum(len), (len * 8 + TEXT_W - 1) / TEXT_W, textStrm, endTextStrm);
+} // end readText
+
+// @brief process message m of a cipher taking one message per call.
+static void processText(ap_uint<512>* in, ap_uint<512>* out, uint64_t m, uint64_t len) {
+#pragma HLS dataflow
+#if BENCH_ALGO == ALGO_RC4
+    hls::stream<ap_uint<8> > keyStrm("keyStrm");
+#pragma HLS RESOURCE variable = keyStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = keyStrm depth = 32 dim = 1
+    hls::stream<bool> endKeyStrm("endKeyStrm");
+#pragma HLS RESOURCE variable = endKeyStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = endKeyStrm depth = 32 dim = 1
+#else
+    hls::stream<ap_uint<256> > keyStrm("keyStrm");
+#pragma HLS RESOURCE variable = keyStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = keyStrm depth = 4 dim = 1
+#endif
+#if BENCH_ALGO == ALGO_AES256_XTS
+    hls::stream<ap_uint<64> > lenStrm("lenStrm");
+#pragma HLS RESOURCE variable = lenStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = lenStrm depth = 4 dim = 1
+#endif
+#if BENCH_ALGO != ALGO_AES256_ECB && BENCH_ALGO != ALGO_RC4
+    hls::stream<ap_uint<128> > ivStrm("ivStrm");
+#pragma HLS RESOURCE variable = ivStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = ivStrm depth = 4 dim = 1
+#endif
+    hls::stream<ap_uint<TEXT_W> > inStrm("inStrm");
+#pragma HLS RESOURCE variable = inStrm core = FIFO_BRAM
+#pragma HLS STREAM variable = inStrm depth = 128 dim = 1
+    hls::stream<bool> endInStrm("endInStrm");
+#pragma HLS RESOURCE variable = endInStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = endInStrm depth = 128 dim = 1
+    hls::stream<ap_uint<TEXT_W> > outStrm("outStrm");
+#pragma HLS RESOURCE variable = outStrm core = FIFO_BRAM
+#pragma HLS STREAM variable = outStrm depth = 128 dim = 1
+    hls::stream<bool> endOutStrm("endOutStrm");
+#pragma HLS RESOURCE variable = endOutStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = endOutStrm depth = 128 dim = 1
+
+#if BENCH_ALGO == ALGO_RC4
+    readText(in, m, len, keyStrm, endKeyStrm, inStrm, endInStrm);
+    xf::security::rc4(keyStrm, endKeyStrm, inStrm, endInStrm, outStrm, endOutStrm);
+#elif BENCH_ALGO == ALGO_AES256_ECB
+    readText(in, m, len, keyStrm, inStrm, endInStrm);
+    xf::security::aes256EcbEncrypt(inStrm, endInStrm, keyStrm, outStrm, endOutStrm);
+#elif BENCH_ALGO == ALGO_AES256_XTS
+    readText(in, m, len, keyStrm, lenStrm, ivStrm, inStrm, endInStrm);
+    xf::security::aes256XtsEncrypt(inStrm, endInStrm, lenStrm, keyStrm, ivStrm, outStrm, endOutStrm);
+#else
+    readText(in, m, len, keyStrm, ivStrm, inStrm, endInStrm);
+#if BENCH_ALGO == ALGO_AES256_CBC
+    xf::security::aes256CbcEncrypt(inStrm, endInStrm, keyStrm, ivStrm, outStrm, endOutStrm);
+#elif BENCH_ALGO == ALGO_AES256_CTR
+    xf::security::aes256CtrEncrypt(inStrm, endInStrm, keyStrm, ivStrm, outStrm, endOutStrm);
+#elif BENCH_ALGO == ALGO_AES256_CFB128
+    xf::security::aes256Cfb128Encrypt(inStrm, endInStrm, keyStrm, ivStrm, outStrm, endOutStrm);
+#elif BENCH_ALGO == ALGO_AES256_OFB
+    xf::security::aes256OfbEncrypt(inStrm, endInStrm, keyStrm, ivStrm, outStrm, endOutStrm);
+#elif BENCH_ALGO == ALGO_CHACHA20
+    xf::security::chacha20(keyStrm, ivStrm, inStrm, endInStrm, outStrm, endOutStrm);
+#endif
+#endif
+    writeWordsEnd<TEXT_W>(outStrm, endOutStrm, out, m * outBlkNum(len));
+} // end processText
+
+// @brief call the cipher once per message.
+static void process(ap_uint<512>* in, ap_uint<512>* out, uint64_t msgNum, uint64_t len) {
+LOOP_MSG:
+    for (uint64_t m = 0; m < msgNum; m++) {
+        processText(in, out, m, len);
+    }
+} // end process
+
+#elif BENCH_ALGO == ALGO_AES256_GCM || BENCH_ALGO == ALGO_AES256_CCM || BENCH_ALGO == ALGO_CHACHA20_POLY1305
+
+#if BENCH_ALGO == ALGO_CHACHA20_POLY1305
+#define TEXT_W 512
+#define NONCE_W 96
+#elif BENCH_ALGO == ALGO_AES256_GCM
+#define TEXT_W 128
+#define NONCE_W 96
+#else
+#define TEXT_W 128
+#define NONCE_W 56
+#endif
+
+// @brief read the key, nonce, AAD and payload of every message.
+static void readAead(ap_uint<512>* ptr,
+                     uint64_t msgNum,
+                     uint64_t len,
+                     hls::stream<ap_uint<256> >& keyStrm,
+                     hls::stream<ap_uint<NONCE_W> >& nonceStrm,
+                     hls::stream<ap_uint<128> >& aadStrm,
+                     hls::stream<ap_uint<64> >& lenAadStrm,
+                     hls::stream<ap_uint<TEXT_W> >& textStrm,
+                     hls::stream<ap_uint<64> >& lenTextStrm,
+                     hls::stream<bool>& endLenStrm) {
+    ap_uint<512> key = ptr[1];
+    ap_uint<512> iv = ptr[2];
+LOOP_AEAD_MSG:
+    for (uint64_t m = 0; m < msgNum; m++) {
+        keyStrm.write(key.range(255, 0));
+        nonceStrm.write(iv.range(NONCE_W - 1, 0));
+#if BENCH_ALGO == ALGO_AES256_GCM
+        // lengths in bits
+        lenAadStrm.write(16 * 8);
+        lenTextStrm.write(len * 8);
+#else
+        lenAadStrm.write(16);
+        lenTextStrm.write(len);
+#endif
+        endLenStrm.write(false);
+        aadStrm.write(iv.range(255, 128));
+        readWords<TEXT_W>(ptr, HDR_BLK + m * blkNum(len), (len * 8 + TEXT_W - 1) / TEXT_W, textStrm);
+    }
+    endLenStrm.write(true);
+} // end readAead
+
+// @brief write the output text and tag of every message.
+static void writeAead(hls::stream<ap_uint<TEXT_W> >& textStrm,
+                      hls::stream<ap_uint<64> >& lenTextStrm,
+                      hls::stream<ap_uint<128> >& tagStrm,
+                      hls::stream<bool>& endTagStrm,
+                      ap_uint<512>* ptr,
+                      uint64_t msgNum,
+                      uint64_t len) {
+LOOP_AEAD_OUT:
+    for (uint64_t m = 0; m < msgNum; m++) {
+        lenTextStrm.read();
+        writeWords<TEXT_W>(textStrm, (len * 8 + TEXT_W - 1) / TEXT_W, ptr, m * outBlkNum(len));
+        ap_uint<512> tag = 0;
+        tag.range(127, 0) = tagStrm.read();
+        ptr[m * outBlkNum(len) + blkNum(len)] = tag;
+        endTagStrm.read();
+    }
+    endTagStrm.read();
+} // end writeAead
+
+// @brief encrypt all the messages in one dataflow region.
+static void process(ap_uint<512>* in, ap_uint<512>* out, uint64_t msgNum, uint64_t len) {
+#pragma HLS dataflow
+    hls::stream<ap_uint<256> > keyStrm("keyStrm");
+#pragma HLS RESOURCE variable = keyStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = keyStrm depth = 4 dim = 1
+    hls::stream<ap_uint<NONCE_W> > nonceStrm("nonceStrm");
+#pragma HLS RESOURCE variable = nonceStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = nonceStrm depth = 4 dim = 1
+    hls::stream<ap_uint<128> > aadStrm("aadStrm");
+#pragma HLS RESOURCE variable = aadStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = aadStrm depth = 4 dim = 1
+    hls::stream<ap_uint<64> > lenAadStrm("lenAadStrm");
+#pragma HLS RESOURCE variable = lenAadStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = lenAadStrm depth = 4 dim = 1
+    hls::stream<ap_uint<TEXT_W> > inStrm("inStrm");
+#pragma HLS RESOURCE variable = inStrm core = FIFO_BRAM
+#pragma HLS STREAM variable = inStrm depth = 128 dim = 1
+    hls::stream<ap_uint<64> > lenInStrm("lenInStrm");
+#pragma HLS RESOURCE variable = lenInStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = lenInStrm depth = 4 dim = 1
+    hls::stream<bool> endLenStrm("endLenStrm");
+#pragma HLS RESOURCE variable = endLenStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = endLenStrm depth = 4 dim = 1
+    hls::stream<ap_uint<TEXT_W> > outStrm("outStrm");
+#pragma HLS RESOURCE variable = outStrm core = FIFO_BRAM
+#pragma HLS STREAM variable = outStrm depth = 128 dim = 1
+    hls::stream<ap_uint<64> > lenOutStrm("lenOutStrm");
+#pragma HLS RESOURCE variable = lenOutStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = lenOutStrm depth = 4 dim = 1
+    hls::stream<ap_uint<128> > tagStrm("tagStrm");
+#pragma HLS RESOURCE variable = tagStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = tagStrm depth = 4 dim = 1
+    hls::stream<bool> endTagStrm("endTagStrm");
+#pragma HLS RESOURCE variable = endTagStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = endTagStrm depth = 4 dim = 1
+
+    readAead(in, msgNum, len, keyStrm, nonceStrm, aadStrm, lenAadStrm, inStrm, lenInStrm, endLenStrm);
+#if BENCH_ALGO == ALGO_AES256_GCM
+    xf::security::aes256GcmEncrypt(inStrm, keyStrm, nonceStrm, aadStrm, lenAadStrm, lenInStrm, endLenStrm, outStrm,
+                                   lenOutStrm, tagStrm, endTagStrm);
+#elif BENCH_ALGO == ALGO_AES256_CCM
+    xf::security::aes256CcmEncrypt<16, 8>(inStrm, keyStrm, nonceStrm, aadStrm, lenAadStrm, lenInStrm, endLenStrm,
+                                          outStrm, lenOutStrm, tagStrm, endTagStrm);
+#else
+    xf::security::chacha20Poly1305Encrypt(keyStrm, nonceStrm, aadStrm, lenAadStrm, inStrm, lenInStrm, endLenStrm,
+                                          outStrm, lenOutStrm, tagStrm, endTagStrm);
+#endif
+    writeAead(outStrm, lenOutStrm, tagStrm, endTagStrm, out, msgNum, len);
+} // end process
+
+#elif BENCH_ALGO == ALGO_POLY1305
+
+// @brief read the one-time key and payload of every message, the end flag of poly1305 is true before each message.
+static void readPoly(ap_uint<512>* ptr,
+                     uint64_t msgNum,
+                     uint64_t len,
+                     hls::stream<ap_uint<256> >& keyStrm,
+                     hls::stream<ap_uint<128> >& textStrm,
+                     hls::stream<ap_uint<64> >& lenStrm,
+                     hls::stream<bool>& endLenStrm) {
+    ap_uint<512> key = ptr[1];
+LOOP_POLY_MSG:
+    for (uint64_t m = 0; m < msgNum; m++) {
+        keyStrm.write(key.range(255, 0));
+        lenStrm.write(len);
+        endLenStrm.write(true);
+        readWords<128>(ptr, HDR_BLK + m * blkNum(len), (len + 15) / 16, textStrm);
+    }
+    endLenStrm.write(false);
+} // end readPoly
+
+// @brief write one tag per message.
+static void writePoly(hls::stream<ap_uint<128> >& tagStrm, ap_uint<512>* ptr, uint64_t msgNum) {
+LOOP_POLY_OUT:
+    for (uint64_t m = 0; m < msgNum; m++) {
+#pragma HLS pipeline II = 1
+        ap_uint<512> b = 0;
+        b.range(127, 0) = tagStrm.read();
+        ptr[m] = b;
+    }
+} // end writePoly
+
+// @brief authenticate all the messages in one dataflow region.
+static void process(ap_uint<512>* in, ap_uint<512>* out, uint64_t msgNum, uint64_t len) {
+#pragma HLS dataflow
+    hls::stream<ap_uint<256> > keyStrm("keyStrm");
+#pragma HLS RESOURCE variable = keyStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = keyStrm depth = 4 dim = 1
+    hls::stream<ap_uint<128> > inStrm("inStrm");
+#pragma HLS RESOURCE variable = inStrm core = FIFO_BRAM
+#pragma HLS STREAM variable = inStrm depth = 128 dim = 1
+    hls::stream<ap_uint<64> > lenStrm("lenStrm");
+#pragma HLS RESOURCE variable = lenStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = lenStrm depth = 4 dim = 1
+    hls::stream<bool> endLenStrm("endLenStrm");
+#pragma HLS RESOURCE variable = endLenStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = endLenStrm depth = 4 dim = 1
+    hls::stream<ap_uint<128> > tagStrm("tagStrm");
+#pragma HLS RESOURCE variable = tagStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = tagStrm depth = 4 dim = 1
+
+    readPoly(in, msgNum, len, keyStrm, inStrm, lenStrm, endLenStrm);
+    xf::security::poly1305(keyStrm, inStrm, lenStrm, endLenStrm, tagStrm);
+    writePoly(tagStrm, out, msgNum);
+} // end process
+
+#else
+
+#if BENCH_ALGO == ALGO_MD4 || BENCH_ALGO == ALGO_MD5
+#define MSG_W 32
+#define LEN_W 64
+#define DIGEST_W 128
+#elif BENCH_ALGO == ALGO_SHA1
+#define MSG_W 32
+#define LEN_W 64
+#define DIGEST_W 160
+#elif BENCH_ALGO == ALGO_SHA256 || BENCH_ALGO == ALGO_HMAC_SHA256
+#define MSG_W 32
+#define LEN_W 64
+#define DIGEST_W 256
+#elif BENCH_ALGO == ALGO_SHA512 || BENCH_ALGO == ALGO_BLAKE2B
+#define MSG_W 64
+#define LEN_W 128
+#define DIGEST_W 512
+#elif BENCH_ALGO == ALGO_SHA3_256
+#define MSG_W 64
+#define LEN_W 128
+#define DIGEST_W 256
+#elif BENCH_ALGO == ALGO_BLAKE3
+#define MSG_W 512
+#define LEN_W 64
+#define DIGEST_W 256
+#endif
+
+#if BENCH_ALGO == ALGO_HMAC_SHA256
+template <int msgW, int lW, int hshW>
+struct sha256Wrapper {
+    static void hash(hls::stream<ap_uint<msgW> >& msgStrm,
+                     hls::stream<ap_uint<64> >& lenStrm,
+                     hls::stream<bool>& eLenStrm,
+                     hls::stream<ap_uint<256> >& hshStrm,
+                     hls::stream<bool>& eHshStrm) {
+        xf::security::sha256<msgW>(msgStrm, lenStrm, eLenStrm, hshStrm, eHshStrm);
+    }
+};
+#endif
+
+// @brief read every message, for BLAKE3 block j of every chunk in a group before block j + 1.
+static void readMsg(ap_uint<512>* ptr,
+                    uint64_t msgNum,
+                    uint64_t len,
+#if BENCH_ALGO == ALGO_HMAC_SHA256
+                    hls::stream<ap_uint<32> >& keyStrm,
+                    hls::stream<ap_uint<64> >& keyLenStrm,
+#elif BENCH_ALGO == ALGO_BLAKE2B
+                    hls::stream<ap_uint<64> >& keyStrm,
+                    hls::stream<ap_uint<8> >& keyLenStrm,
+                    hls::stream<ap_uint<8> >& outLenStrm,
+#endif
+                    hls::stream<ap_uint<MSG_W> >& msgStrm,
+                    hls::stream<ap_uint<LEN_W> >& lenStrm,
+                    hls::stream<bool>& endLenStrm) {
+LOOP_HASH_MSG:
+    for (uint64_t m = 0; m < msgNum; m++) {
+        uint64_t base = HDR_BLK + m * blkNum(len);
+#if BENCH_ALGO == ALGO_HMAC_SHA256
+        keyLenStrm.write(32);
+        readWords<32>(ptr, 1, 8, keyStrm);
+#elif BENCH_ALGO == ALGO_BLAKE2B
+        keyLenStrm.write(0);
+        outLenStrm.write(64);
+#endif
+        lenStrm.write(len);
+        endLenStrm.write(false);
+#if BENCH_ALGO == ALGO_BLAKE3
+        uint64_t chunkNum = (len == 0) ? 1 : ((len + 1023) >> 10);
+    LOOP_GROUP:
+        for (uint64_t g = 0; g < chunkNum; g += BLAKE3_LANE_NM) {
+            unsigned int c = 0;
+            unsigned int j = 0;
+        LOOP_BLOCK:
+            for (unsigned int i = 0; i < 16 * BLAKE3_LANE_NM; i++) {
+#pragma HLS pipeline II = 1
+                uint64_t blk = ((g + c) << 4) + j;
+                if (g + c < chunkNum && blk < blkNum(len)) {
+                    msgStrm.write(ptr[base + blk]);
+                }
+                if (c == BLAKE3_LANE_NM - 1) {
+                    c = 0;
+                    j++;
+                } else {
+                    c++;
+                }
+            }
+        }
+#else
+        readWords<MSG_W>(ptr, base, (len * 8 + MSG_W - 1) / MSG_W, msgStrm);
+#endif
+    }
+    endLenStrm.write(true);
+} // end readMsg
+
+// @brief write one digest per block.
+static void writeDigest(hls::stream<ap_uint<DIGEST_W> >& digestStrm,
+                        hls::stream<bool>& endDigestStrm,
+                        ap_uint<512>* ptr) {
+    uint64_t m = 0;
+LOOP_DIGEST:
+    while (!endDigestStrm.read()) {
+#pragma HLS pipeline II = 1
+        ap_uint<512> b = 0;
+        b.range(DIGEST_W - 1, 0) = digestStrm.read();
+        ptr[m++] = b;
+    }
+} // end writeDigest
+
+// @brief hash all the messages in one dataflow region.
+static void process(ap_uint<512>* in, ap_uint<512>* out, uint64_t msgNum, uint64_t len) {
+#pragma HLS dataflow
+#if BENCH_ALGO == ALGO_HMAC_SHA256
+    hls::stream<ap_uint<32> > keyStrm("keyStrm");
+#pragma HLS RESOURCE variable = keyStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = keyStrm depth = 32 dim = 1
+    hls::stream<ap_uint<64> > keyLenStrm("keyLenStrm");
+#pragma HLS RESOURCE variable = keyLenStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = keyLenStrm depth = 4 dim = 1
+#elif BENCH_ALGO == ALGO_BLAKE2B
+    hls::stream<ap_uint<64> > keyStrm("keyStrm");
+#pragma HLS RESOURCE variable = keyStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = keyStrm depth = 4 dim = 1
+    hls::stream<ap_uint<8> > keyLenStrm("keyLenStrm");
+#pragma HLS RESOURCE variable = keyLenStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = keyLenStrm depth = 4 dim = 1
+    hls::stream<ap_uint<8> > outLenStrm("outLenStrm");
+#pragma HLS RESOURCE variable = outLenStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = outLenStrm depth = 4 dim = 1
+#endif
+    hls::stream<ap_uint<MSG_W> > msgStrm("msgStrm");
+#pragma HLS RESOURCE variable = msgStrm core = FIFO_BRAM
+#pragma HLS STREAM variable = msgStrm depth = 128 dim = 1
+    hls::stream<ap_uint<LEN_W> > lenStrm("lenStrm");
+#pragma HLS RESOURCE variable = lenStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = lenStrm depth = 4 dim = 1
+    hls::stream<bool> endLenStrm("endLenStrm");
+#pragma HLS RESOURCE variable = endLenStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = endLenStrm depth = 4 dim = 1
+    hls::stream<ap_uint<DIGEST_W> > digestStrm("digestStrm");
+#pragma HLS RESOURCE variable = digestStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = digestStrm depth = 4 dim = 1
+    hls::stream<bool> endDigestStrm("endDigestStrm");
+#pragma HLS RESOURCE variable = endDigestStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = endDigestStrm depth = 4 dim = 1
+
+#if BENCH_ALGO == ALGO_HMAC_SHA256
+    readMsg(in, msgNum, len, keyStrm, keyLenStrm, msgStrm, lenStrm, endLenStrm);
+    xf::security::hmac<32, 32, 64, 256, 64, sha256Wrapper>(keyStrm, keyLenStrm, msgStrm, lenStrm, endLenStrm,
+                                                           digestStrm, endDigestStrm);
+#elif BENCH_ALGO == ALGO_BLAKE2B
+    readMsg(in, msgNum, len, keyStrm, keyLenStrm, outLenStrm, msgStrm, lenStrm, endLenStrm);
+    xf::security::blake2b<64>(msgStrm, lenStrm, keyStrm, keyLenStrm, outLenStrm, endLenStrm, digestStrm,
+                              endDigestStrm);
+#else
+    readMsg(in, msgNum, len, msgStrm, lenStrm, endLenStrm);
+#if BENCH_ALGO == ALGO_MD4
+    xf::security::md4(msgStrm, lenStrm, endLenStrm, digestStrm, endDigestStrm);
+#elif BENCH_ALGO == ALGO_MD5
+    xf::security::md5(msgStrm, lenStrm, endLenStrm, digestStrm, endDigestStrm);
+#elif BENCH_ALGO == ALGO_SHA1
+    xf::security::sha1<32>(msgStrm, lenStrm, endLenStrm, digestStrm, endDigestStrm);
+#elif BENCH_ALGO == ALGO_SHA256
+    xf::security::sha256<32>(msgStrm, lenStrm, endLenStrm, digestStrm, endDigestStrm);
+#elif BENCH_ALGO == ALGO_SHA512
+    xf::security::sha512<64>(msgStrm, lenStrm, endLenStrm, digestStrm, endDigestStrm);
+#elif BENCH_ALGO == ALGO_SHA3_256
+    xf::security::sha3_256(msgStrm, lenStrm, endLenStrm, digestStrm, endDigestStrm);
+#elif BENCH_ALGO == ALGO_BLAKE3
+    xf::security::blake3<BLAKE3_LANE_NM>(msgStrm, lenStrm, endLenStrm, digestStrm, endDigestStrm);
+#endif
+#endif
+    writeDigest(digestStrm, endDigestStrm, out);
+} // end process
+
+#endif
+
+// @brief top of kernel
+extern "C" void benchKernel(ap_uint<512> inputData[MAX_IN_BLK], ap_uint<512> outputData[MAX_OUT_BLK]) {
+// clang-format off
+#pragma HLS INTERFACE m_axi offset = slave latency = 64 \
+	num_write_outstanding = 16 num_read_outstanding = 16 \
+	max_write_burst_length = 64 max_read_burst_length = 64 \
+	bundle = gmem0_0 port = inputData
+
+#pragma HLS INTERFACE m_axi offset = slave latency = 64 \
+	num_write_outstanding = 16 num_read_outstanding = 16 \
+	max_write_burst_length = 64 max_read_burst_length = 64 \
+	bundle = gmem0_1 port = outputData
+// clang-format on
+
+#pragma HLS INTERFACE s_axilite port = inputData bundle = control
+#pragma HLS INTERFACE s_axilite port = outputData bundle = control
+#pragma HLS INTERFACE s_axilite port = return bundle = control
+
+    ap_uint<512> hdr = inputData[0];
+    uint64_t msgNum = hdr.range(63, 0);
+    uint64_t len = hdr.range(127, 64);
+
+    process(inputData, outputData, msgNum, len);
+} // end benchKernel
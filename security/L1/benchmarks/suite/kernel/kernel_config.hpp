@@ -0,0 +1,64 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __KERNEL_CONFIG_HPP_
+#define __KERNEL_CONFIG_HPP_
+
+// algorithms of the benchmark suite, one of them is built into benchKernel by BENCH_ALGO
+#define ALGO_AES256_ECB 0
+#define ALGO_AES256_CBC 1
+#define ALGO_AES256_CTR 2
+#define ALGO_AES256_CFB128 3
+#define ALGO_AES256_OFB 4
+#define ALGO_AES256_XTS 5
+#define ALGO_AES256_GCM 6
+#define ALGO_AES256_CCM 7
+#define ALGO_CHACHA20 8
+#define ALGO_CHACHA20_POLY1305 9
+#define ALGO_RC4 10
+#define ALGO_POLY1305 11
+#define ALGO_HMAC_SHA256 12
+#define ALGO_MD4 13
+#define ALGO_MD5 14
+#define ALGO_SHA1 15
+#define ALGO_SHA256 16
+#define ALGO_SHA512 17
+#define ALGO_SHA3_256 18
+#define ALGO_BLAKE2B 19
+#define ALGO_BLAKE3 20
+#define ALGO_NUM 21
+
+#ifndef BENCH_ALGO
+#define BENCH_ALGO ALGO_SHA256
+#endif
+
+// number of chunks hashed at the same time by BLAKE3
+#define BLAKE3_LANE_NM 32
+
+// maximum size of the input and output buffers in 512-bit blocks
+#define MAX_IN_BLK ((1 << 20) + 3)
+#define MAX_OUT_BLK (1 << 21)
+
+// input layout, byte i of each field at bit 8i:
+// block 0: number of messages in bits 63..0 and length of every message in bytes in bits 127..64
+// block 1: key, 32 bytes for the ciphers, two such keys for XTS, 16 bytes for RC4 and 32 bytes for the MACs
+// block 2: IV or nonce in bytes 0 to 15, and 16 bytes of AAD for the AEADs in bytes 16 to 31
+// then ceil(len / 64) blocks of data per message
+// output layout per message: ceil(len / 64) blocks of output text for the ciphers and AEADs, then one block with the
+// tag, MAC or digest for the AEADs, MACs and hashes
+#define HDR_BLK 3
+
+#endif
@@ -19,6 +19,7 @@
 
 #define AP_INT_MAX_W 4096
 #include <ap_int.h>
+#include "xf_security/modular.hpp"
 
 namespace xf {
 namespace security {
@@ -239,6 +240,358 @@ class rsa {
     }
 };
 
+namespace internal {
+
+/**
+ * @brief Montgomery setup of CtxNum independent moduli.
+ *
+ * nPrime is -n^(-1) mod 2^W, by Newton iteration on the lowest word only.
+ * R mod n and R^2 mod n are got by doubling 1 for 2 * W * S times, so there is no big integer division.
+ *
+ * @tparam W Word width of the Montgomery multiplication.
+ * @tparam S Number of words, R = 2^(W * S).
+ * @tparam CtxNum Number of interleaved contexts.
+ * @param n The odd moduli.
+ * @param nPrime Output of -n^(-1) mod 2^W.
+ * @param one Output of R mod n, the Montgomery representation of 1.
+ * @param rr Output of R^2 mod n.
+ */
+template <int W, int S, int CtxNum>
+void montSetupMultiCtx(ap_uint<W * S> n[CtxNum],
+                       ap_uint<W> nPrime[CtxNum],
+                       ap_uint<W * S> one[CtxNum],
+                       ap_uint<W * S> rr[CtxNum]) {
+loop_Prime:
+    for (int c = 0; c < CtxNum; c++) {
+#pragma HLS pipeline II = 1
+        ap_uint<W> n0 = n[c].range(W - 1, 0);
+        // x is correct for the lowest k bits, and every iteration doubles k
+        ap_uint<W> x = 1;
+        for (int k = 1; k < W; k <<= 1) {
+            ap_uint<W> nx = n0 * x;
+            ap_uint<W> two = 2;
+            x = x * (ap_uint<W>)(two - nx);
+        }
+        ap_uint<W> np = 0;
+        np -= x;
+        nPrime[c] = np;
+        rr[c] = 1;
+    }
+
+loop_Double:
+    for (int i = 0; i < 2 * W * S; i++) {
+    loop_DoubleChan:
+        for (int c = 0; c < CtxNum; c++) {
+#pragma HLS pipeline II = 1
+#pragma HLS dependence variable = rr inter distance = CtxNum true
+            ap_uint<W* S + 1> x = rr[c];
+            x <<= 1;
+            if (x >= n[c]) {
+                x -= n[c];
+            }
+            rr[c] = x;
+            if (i == W * S - 1) {
+                one[c] = x;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Montgomery multiplication of CtxNum independent contexts, r = a * b / R mod n.
+ *
+ * The multiplication is word serial. The loop over the words of a is outside and the loop over the contexts is the
+ * pipelined inner loop, so the partial sum of one context is used again CtxNum iterations later and the
+ * multiply-reduce datapath takes new operands every cycle.
+ *
+ * @tparam W Word width of the Montgomery multiplication.
+ * @tparam S Number of words, R = 2^(W * S).
+ * @tparam CtxNum Number of interleaved contexts.
+ * @param a The multiplicands.
+ * @param b The multipliers, less than n.
+ * @param n The odd moduli.
+ * @param nPrime -n^(-1) mod 2^W.
+ * @param r The results, less than n. It could be the same array as a or b.
+ */
+template <int W, int S, int CtxNum>
+void montMulMultiCtx(ap_uint<W * S> a[CtxNum],
+                     ap_uint<W * S> b[CtxNum],
+                     ap_uint<W * S> n[CtxNum],
+                     ap_uint<W> nPrime[CtxNum],
+                     ap_uint<W * S> r[CtxNum]) {
+    // partial sums, always less than 2n
+    ap_uint<W * S + 1> acc[CtxNum];
+
+loop_Init:
+    for (int c = 0; c < CtxNum; c++) {
+#pragma HLS pipeline II = 1
+        acc[c] = 0;
+    }
+
+loop_Word:
+    for (int i = 0; i < S; i++) {
+    loop_WordChan:
+        for (int c = 0; c < CtxNum; c++) {
+#pragma HLS pipeline II = 1
+#pragma HLS dependence variable = acc inter distance = CtxNum true
+            ap_uint<W> ai = a[c].range(i * W + W - 1, i * W);
+            ap_uint<W* S + W + 2> t = acc[c];
+            t += ai * b[c];
+            ap_uint<W> t0 = t.range(W - 1, 0);
+            ap_uint<W> m = t0 * nPrime[c];
+            t += m * n[c];
+            acc[c] = t.range(W * S + W, W);
+        }
+    }
+
+loop_Final:
+    for (int c = 0; c < CtxNum; c++) {
+#pragma HLS pipeline II = 1
+        ap_uint<W* S + 1> x = acc[c];
+        if (x >= n[c]) {
+            x -= n[c];
+        }
+        r[c] = x;
+    }
+}
+
+/**
+ * @brief Modular exponentiation of CtxNum independent contexts in Montgomery representation.
+ *
+ * Every bit takes one squaring and one multiplication, by the base if the bit is 1 and by Montgomery 1 otherwise,
+ * so all contexts go through the multiplier in lock step regardless of their exponents.
+ *
+ * @tparam W Word width of the Montgomery multiplication.
+ * @tparam S Number of words, R = 2^(W * S).
+ * @tparam CtxNum Number of interleaved contexts.
+ * @param base The bases, less than n.
+ * @param exponent The exponents.
+ * @param topBit Position of the highest 1 among all exponents.
+ * @param n The odd moduli.
+ * @param nPrime -n^(-1) mod 2^W.
+ * @param one R mod n.
+ * @param rr R^2 mod n.
+ * @param result base^exponent mod n.
+ */
+template <int W, int S, int CtxNum>
+void montExpMultiCtx(ap_uint<W * S> base[CtxNum],
+                     ap_uint<W * S> exponent[CtxNum],
+                     int topBit,
+                     ap_uint<W * S> n[CtxNum],
+                     ap_uint<W> nPrime[CtxNum],
+                     ap_uint<W * S> one[CtxNum],
+                     ap_uint<W * S> rr[CtxNum],
+                     ap_uint<W * S> result[CtxNum]) {
+    ap_uint<W * S> bm[CtxNum];
+    ap_uint<W * S> acc[CtxNum];
+    ap_uint<W * S> sel[CtxNum];
+
+    // transform base to its Montgomery representation
+    montMulMultiCtx<W, S, CtxNum>(base, rr, n, nPrime, bm);
+
+loop_Init:
+    for (int c = 0; c < CtxNum; c++) {
+#pragma HLS pipeline II = 1
+        acc[c] = one[c];
+    }
+
+loop_Exp:
+    for (int i = topBit; i >= 0; i--) {
+#pragma HLS loop_tripcount min = 17 max = W * S avg = W * S
+        montMulMultiCtx<W, S, CtxNum>(acc, acc, n, nPrime, acc);
+    loop_Select:
+        for (int c = 0; c < CtxNum; c++) {
+#pragma HLS pipeline II = 1
+            sel[c] = exponent[c][i] ? bm[c] : one[c];
+        }
+        montMulMultiCtx<W, S, CtxNum>(acc, sel, n, nPrime, acc);
+    }
+
+    // transform result back to normal representation
+loop_Unit:
+    for (int c = 0; c < CtxNum; c++) {
+#pragma HLS pipeline II = 1
+        sel[c] = 1;
+    }
+    montMulMultiCtx<W, S, CtxNum>(acc, sel, n, nPrime, result);
+}
+
+} // namespace internal
+
+/**
+ * @brief RSA encryption/decryption class for multiple independent contexts
+ *
+ * The modular exponentiations of CtxNum contexts, each with its own key, are interleaved through one Montgomery
+ * multiplier pipeline.
+ *
+ * @tparam BlockWidth Word width of the Montgomery multiplication.
+ * @tparam BlockNum Number of words. keyLength = BlockNum * BlockWidth.
+ * @tparam CtxNum Number of interleaved contexts, should be no less than the latency of the multiplier.
+ */
+template <int BlockWidth, int BlockNum, int CtxNum>
+class rsaMultiCtx {
+   private:
+    const static int keyLength = BlockWidth * BlockNum;
+    ap_uint<keyLength> nModulus[CtxNum];
+    ap_uint<keyLength> nExponent[CtxNum];
+    ap_uint<keyLength> nOne[CtxNum];
+    ap_uint<keyLength> nRR[CtxNum];
+    ap_uint<BlockWidth> nPrime[CtxNum];
+    int topBit;
+
+   public:
+    /**
+     * @brief Update keys of all contexts before use them to encrypt messages
+     *
+     * @param modulus Modulus in RSA public key of each context, should be odd.
+     * @param exponent Exponent in RSA public key or private key of each context.
+     */
+    void updateKey(ap_uint<keyLength> modulus[CtxNum], ap_uint<keyLength> exponent[CtxNum]) {
+        topBit = 0;
+        for (int c = 0; c < CtxNum; c++) {
+#pragma HLS pipeline II = 1
+            nModulus[c] = modulus[c];
+            nExponent[c] = exponent[c];
+            int top = keyLength - 1 - exponent[c].countLeadingZeros();
+            if (top > topBit) {
+                topBit = top;
+            }
+        }
+        internal::montSetupMultiCtx<BlockWidth, BlockNum, CtxNum>(nModulus, nPrime, nOne, nRR);
+    }
+
+    /**
+     * @brief Encrypt messages of all contexts and get results. It does not include any padding scheme
+     *
+     * @param message Messages to be encrypted/decrypted, each less than the modulus of its context.
+     * @param result Generated encrypted/decrypted results.
+     */
+    void process(ap_uint<keyLength> message[CtxNum], ap_uint<keyLength> result[CtxNum]) {
+        internal::montExpMultiCtx<BlockWidth, BlockNum, CtxNum>(message, nExponent, topBit, nModulus, nPrime, nOne,
+                                                                nRR, result);
+    }
+};
+
+/**
+ * @brief RSA private key decryption class with Chinese Remainder Theorem for multiple independent contexts
+ *
+ * Each decryption is split into two exponentiations of half key length, modulo p and modulo q, and all 2 * CtxNum of
+ * them are interleaved through one half width Montgomery multiplier pipeline.
+ *
+ * @tparam BlockWidth Word width of the Montgomery multiplication.
+ * @tparam BlockNum Number of words of the whole key, should be even. keyLength = BlockNum * BlockWidth.
+ * @tparam CtxNum Number of interleaved contexts.
+ */
+template <int BlockWidth, int BlockNum, int CtxNum>
+class rsaCrtMultiCtx {
+   private:
+    const static int keyLength = BlockWidth * BlockNum;
+    const static int halfLength = keyLength / 2;
+    // index c is for prime p of context c, and index c + CtxNum for prime q
+    ap_uint<halfLength> nPrimes[2 * CtxNum];
+    ap_uint<halfLength> nExponent[2 * CtxNum];
+    ap_uint<halfLength> nOne[2 * CtxNum];
+    ap_uint<halfLength> nRR[2 * CtxNum];
+    ap_uint<BlockWidth> nPrime[2 * CtxNum];
+    // qInv * R mod p, only the first CtxNum are used
+    ap_uint<halfLength> nQInv[2 * CtxNum];
+    int topBit;
+
+   public:
+    /**
+     * @brief Update private keys of all contexts before use them to decrypt messages
+     *
+     * @param p The first prime factor of each context, should be exactly keyLength / 2 bits.
+     * @param q The second prime factor of each context, should be exactly keyLength / 2 bits.
+     * @param dP d mod (p - 1) of each context.
+     * @param dQ d mod (q - 1) of each context.
+     * @param qInv q^(-1) mod p of each context.
+     */
+    void updateKey(ap_uint<halfLength> p[CtxNum],
+                   ap_uint<halfLength> q[CtxNum],
+                   ap_uint<halfLength> dP[CtxNum],
+                   ap_uint<halfLength> dQ[CtxNum],
+                   ap_uint<halfLength> qInv[CtxNum]) {
+        ap_uint<halfLength> tmp[2 * CtxNum];
+        topBit = 0;
+        for (int c = 0; c < 2 * CtxNum; c++) {
+#pragma HLS pipeline II = 1
+            bool isP = c < CtxNum;
+            int k = isP ? c : c - CtxNum;
+            nPrimes[c] = isP ? p[k] : q[k];
+            nExponent[c] = isP ? dP[k] : dQ[k];
+            tmp[c] = isP ? qInv[k] : (ap_uint<halfLength>)0;
+            int top = halfLength - 1 - nExponent[c].countLeadingZeros();
+            if (top > topBit) {
+                topBit = top;
+            }
+        }
+        internal::montSetupMultiCtx<BlockWidth, BlockNum / 2, 2 * CtxNum>(nPrimes, nPrime, nOne, nRR);
+        internal::montMulMultiCtx<BlockWidth, BlockNum / 2, 2 * CtxNum>(tmp, nRR, nPrimes, nPrime, nQInv);
+    }
+
+    /**
+     * @brief Decrypt messages of all contexts and get results. It does not include any padding scheme
+     *
+     * @param message Messages to be decrypted, each less than p * q of its context.
+     * @param result Generated decrypted results.
+     */
+    void process(ap_uint<keyLength> message[CtxNum], ap_uint<keyLength> result[CtxNum]) {
+        ap_uint<halfLength> hi[2 * CtxNum];
+        ap_uint<halfLength> lo[2 * CtxNum];
+
+        // split message = hi * R + lo, both halves are less than 2 * prime
+        for (int c = 0; c < 2 * CtxNum; c++) {
+#pragma HLS pipeline II = 1
+            int k = c < CtxNum ? c : c - CtxNum;
+            ap_uint<halfLength> h = message[k].range(keyLength - 1, halfLength);
+            ap_uint<halfLength> l = message[k].range(halfLength - 1, 0);
+            if (h >= nPrimes[c]) {
+                h -= nPrimes[c];
+            }
+            if (l >= nPrimes[c]) {
+                l -= nPrimes[c];
+            }
+            hi[c] = h;
+            lo[c] = l;
+        }
+
+        // message mod prime = (hi * R mod prime) + lo
+        internal::montMulMultiCtx<BlockWidth, BlockNum / 2, 2 * CtxNum>(hi, nRR, nPrimes, nPrime, hi);
+        for (int c = 0; c < 2 * CtxNum; c++) {
+#pragma HLS pipeline II = 1
+            hi[c] = internal::addMod<halfLength>(hi[c], lo[c], nPrimes[c]);
+        }
+
+        // m1 = c^dP mod p, m2 = c^dQ mod q
+        internal::montExpMultiCtx<BlockWidth, BlockNum / 2, 2 * CtxNum>(hi, nExponent, topBit, nPrimes, nPrime, nOne,
+                                                                        nRR, lo);
+
+        // Garner's recombination, h = qInv * (m1 - m2) mod p
+        for (int c = 0; c < 2 * CtxNum; c++) {
+#pragma HLS pipeline II = 1
+            if (c < CtxNum) {
+                ap_uint<halfLength> m2 = lo[c + CtxNum];
+                if (m2 >= nPrimes[c]) {
+                    m2 -= nPrimes[c];
+                }
+                hi[c] = internal::subMod<halfLength>(lo[c], m2, nPrimes[c]);
+            } else {
+                hi[c] = 0;
+            }
+        }
+        internal::montMulMultiCtx<BlockWidth, BlockNum / 2, 2 * CtxNum>(hi, nQInv, nPrimes, nPrime, hi);
+
+        // m = m2 + q * h
+        for (int c = 0; c < CtxNum; c++) {
+#pragma HLS pipeline II = 1
+            ap_uint<keyLength> m = nPrimes[c + CtxNum] * hi[c];
+            m += lo[c + CtxNum];
+            result[c] = m;
+        }
+    }
+};
+
 } // namespace security
 } // namespace xf
 
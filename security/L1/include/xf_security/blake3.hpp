@@ -0,0 +1,401 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file blake3.hpp
+ * @brief header file for BLAKE3 hash in tree mode.
+ * This file is part of Vitis Security Library.
+ *
+ * @detail The message is split into 1 KB chunks which are hashed independently, and the chaining values of the
+ * chunks are merged pairwise in a binary tree up to the root. The chunk stage interleaves many chunks through one
+ * pipelined compression function, and the merge stage reduces each group of chunks on chip before it joins the
+ * rest of the tree.
+ */
+
+#ifndef _XF_SECURITY_BLAKE3_HPP_
+#define _XF_SECURITY_BLAKE3_HPP_
+
+#include <ap_int.h>
+#include <hls_stream.h>
+
+#include "xf_security/utils.hpp"
+
+namespace xf {
+namespace security {
+namespace internal {
+
+// domain separation flags
+enum blake3Flag { BLAKE3_CHUNK_START = 1, BLAKE3_CHUNK_END = 2, BLAKE3_PARENT = 4, BLAKE3_ROOT = 8 };
+
+// @brief rotate right of a 32-bit word.
+static uint32_t blake3Rotr(uint32_t x, unsigned int n) {
+#pragma HLS inline
+    return (x >> n) | (x << (32 - n));
+}
+
+// @brief mixing function G, same as BLAKE2s.
+static void blake3G(uint32_t& a, uint32_t& b, uint32_t& c, uint32_t& d, uint32_t mx, uint32_t my) {
+#pragma HLS inline
+    a = a + b + mx;
+    d = blake3Rotr(d ^ a, 16);
+    c = c + d;
+    b = blake3Rotr(b ^ c, 12);
+    a = a + b + my;
+    d = blake3Rotr(d ^ a, 8);
+    c = c + d;
+    b = blake3Rotr(b ^ c, 7);
+}
+
+/**
+ * @brief Compression function of BLAKE3, fully unrolled so that it can take a new block every cycle.
+ *
+ * Only the first half of the output is computed, which is the chaining value, and also the hash when the ROOT flag
+ * is set and the digest is 32 bytes.
+ *
+ * @param cv The input chaining value, word i at bit 32i.
+ * @param blk The message block, byte i at bit 8i, zero after blkLen.
+ * @param counter The chunk counter, 0 for parent nodes.
+ * @param blkLen Number of bytes in the block.
+ * @param flags Domain separation flags.
+ */
+static ap_uint<256> blake3Compress(
+    ap_uint<256> cv, ap_uint<512> blk, uint64_t counter, uint32_t blkLen, uint32_t flags) {
+#pragma HLS inline
+    static const uint32_t iv[4] = {0x6a09e667UL, 0xbb67ae85UL, 0x3c6ef372UL, 0xa54ff53aUL};
+    static const unsigned char perm[16] = {2, 6, 3, 10, 7, 0, 4, 13, 1, 11, 12, 5, 9, 14, 15, 8};
+
+    uint32_t v[16];
+#pragma HLS array_partition variable = v complete
+    uint32_t m[16];
+#pragma HLS array_partition variable = m complete
+    for (int i = 0; i < 8; i++) {
+#pragma HLS unroll
+        v[i] = cv.range(32 * i + 31, 32 * i);
+    }
+    for (int i = 0; i < 4; i++) {
+#pragma HLS unroll
+        v[8 + i] = iv[i];
+    }
+    v[12] = counter;
+    v[13] = counter >> 32;
+    v[14] = blkLen;
+    v[15] = flags;
+    for (int i = 0; i < 16; i++) {
+#pragma HLS unroll
+        m[i] = blk.range(32 * i + 31, 32 * i);
+    }
+
+loop_Round:
+    for (int r = 0; r < 7; r++) {
+#pragma HLS unroll
+        // columns
+        blake3G(v[0], v[4], v[8], v[12], m[0], m[1]);
+        blake3G(v[1], v[5], v[9], v[13], m[2], m[3]);
+        blake3G(v[2], v[6], v[10], v[14], m[4], m[5]);
+        blake3G(v[3], v[7], v[11], v[15], m[6], m[7]);
+        // diagonals
+        blake3G(v[0], v[5], v[10], v[15], m[8], m[9]);
+        blake3G(v[1], v[6], v[11], v[12], m[10], m[11]);
+        blake3G(v[2], v[7], v[8], v[13], m[12], m[13]);
+        blake3G(v[3], v[4], v[9], v[14], m[14], m[15]);
+        // permute the message words for the next round
+        uint32_t t[16];
+#pragma HLS array_partition variable = t complete
+        for (int i = 0; i < 16; i++) {
+#pragma HLS unroll
+            t[i] = m[perm[i]];
+        }
+        for (int i = 0; i < 16; i++) {
+#pragma HLS unroll
+            m[i] = t[i];
+        }
+    }
+
+    ap_uint<256> out;
+    for (int i = 0; i < 8; i++) {
+#pragma HLS unroll
+        out.range(32 * i + 31, 32 * i) = v[i] ^ v[i + 8];
+    }
+    return out;
+}
+
+// @brief key words of the unkeyed mode, the same as the IV of SHA-256.
+static ap_uint<256> blake3Key() {
+#pragma HLS inline
+    static const uint32_t iv[8] = {0x6a09e667UL, 0xbb67ae85UL, 0x3c6ef372UL, 0xa54ff53aUL,
+                                   0x510e527fUL, 0x9b05688cUL, 0x1f83d9abUL, 0x5be0cd19UL};
+    ap_uint<256> key;
+    for (int i = 0; i < 8; i++) {
+#pragma HLS unroll
+        key.range(32 * i + 31, 32 * i) = iv[i];
+    }
+    return key;
+}
+
+// @brief chaining value of a parent node.
+static ap_uint<256> blake3Parent(ap_uint<256> left, ap_uint<256> right, bool root) {
+#pragma HLS inline
+    ap_uint<512> blk;
+    blk.range(255, 0) = left;
+    blk.range(511, 256) = right;
+    return blake3Compress(blake3Key(), blk, 0, 64, BLAKE3_PARENT | (root ? BLAKE3_ROOT : 0));
+}
+
+/**
+ * @brief Chunk stage of BLAKE3, hashing _laneNum chunks of a message at the same time.
+ *
+ * The 16 blocks of a chunk depend on each other through the chaining value, so the blocks of different chunks are
+ * interleaved: one pipelined loop over (block, lane) feeds the compression function, and the chaining value of a
+ * lane is needed again _laneNum cycles later.
+ *
+ * @tparam _laneNum Number of chunks in flight, no less than the latency of the compression function.
+ * @param msgStrm The message blocks, block j of every chunk of a group which has block j, then block j + 1.
+ * @param lenStrm Length of each message in bytes.
+ * @param endLenStrm Flag to signal the end of the messages.
+ * @param cvStrm Chaining value of each chunk, in chunk order.
+ * @param chunkNumStrm Number of chunks of each message.
+ * @param endChunkNumStrm Flag to signal the end of the messages.
+ */
+template <unsigned int _laneNum>
+void blake3Chunk(hls::stream<ap_uint<512> >& msgStrm,
+                 hls::stream<ap_uint<64> >& lenStrm,
+                 hls::stream<bool>& endLenStrm,
+                 hls::stream<ap_uint<256> >& cvStrm,
+                 hls::stream<ap_uint<64> >& chunkNumStrm,
+                 hls::stream<bool>& endChunkNumStrm) {
+    ap_uint<256> key = blake3Key();
+
+    ap_uint<256> cv[_laneNum];
+#pragma HLS resource variable = cv core = RAM_2P_LUTRAM
+
+    bool end = endLenStrm.read();
+loop_Msg:
+    while (!end) {
+        uint64_t len = lenStrm.read();
+        end = endLenStrm.read();
+        // an empty message still has one chunk with one empty block
+        uint64_t chunkNum = (len == 0) ? 1 : ((len + 1023) >> 10);
+        uint32_t lastLen = len - ((chunkNum - 1) << 10);
+        uint32_t lastBlk = (lastLen == 0) ? 1 : ((lastLen + 63) >> 6);
+        chunkNumStrm.write(chunkNum);
+        endChunkNumStrm.write(false);
+
+    loop_Group:
+        for (uint64_t g = 0; g < chunkNum; g += _laneNum) {
+#pragma HLS loop_tripcount min = 1 max = 1 avg = 1
+            unsigned int n = (chunkNum - g < _laneNum) ? (unsigned int)(chunkNum - g) : _laneNum;
+            // only the last chunk of the message can be short
+            unsigned int blkNum = (n == 1 && g + 1 == chunkNum) ? lastBlk : 16;
+
+            unsigned int c = 0;
+            unsigned int j = 0;
+        loop_Block:
+            for (unsigned int i = 0; i < blkNum * _laneNum; i++) {
+#pragma HLS loop_tripcount min = 16 * _laneNum max = 16 * _laneNum avg = 16 * _laneNum
+#pragma HLS pipeline II = 1
+#pragma HLS dependence variable = cv inter distance = _laneNum true
+                uint64_t idx = g + c;
+                bool last = (idx == chunkNum - 1);
+                unsigned int chunkBlk = last ? lastBlk : 16;
+                if (c < n && j < chunkBlk) {
+                    uint32_t chunkLen = last ? lastLen : 1024;
+                    uint32_t rest = chunkLen - (j << 6);
+                    uint32_t blkLen = (rest < 64) ? rest : 64;
+                    ap_uint<512> blk = 0;
+                    if (blkLen > 0) {
+                        blk = msgStrm.read();
+                    }
+                    for (int k = 0; k < 64; k++) {
+#pragma HLS unroll
+                        if (k >= blkLen) {
+                            blk.range(8 * k + 7, 8 * k) = 0;
+                        }
+                    }
+                    uint32_t flags = 0;
+                    if (j == 0) {
+                        flags |= BLAKE3_CHUNK_START;
+                    }
+                    if (j == chunkBlk - 1) {
+                        flags |= BLAKE3_CHUNK_END;
+                        if (chunkNum == 1) {
+                            flags |= BLAKE3_ROOT;
+                        }
+                    }
+                    cv[c] = blake3Compress((j == 0) ? key : cv[c], blk, idx, blkLen, flags);
+                }
+                if (c == _laneNum - 1) {
+                    c = 0;
+                    j++;
+                } else {
+                    c++;
+                }
+            }
+
+        loop_Emit:
+            for (unsigned int c = 0; c < n; c++) {
+#pragma HLS pipeline II = 1
+                cvStrm.write(cv[c]);
+            }
+        }
+    }
+    endChunkNumStrm.write(true);
+}
+
+/**
+ * @brief Merge stage of BLAKE3, building the tree from the chaining values of the chunks.
+ *
+ * Every group of _laneNum chunks is reduced level by level on chip, each level as one pipelined loop. With
+ * _laneNum a power of two, a full group is a complete subtree, and its root joins the rest of the tree through a
+ * stack of subtree roots, one entry per set bit of the number of groups seen so far. The last group of the message
+ * is reduced the same way and merged with the whole stack, setting the ROOT flag on the last parent node.
+ *
+ * @tparam _laneNum Number of chunks in a group, a power of two.
+ * @param cvStrm Chaining value of each chunk, in chunk order.
+ * @param chunkNumStrm Number of chunks of each message.
+ * @param endChunkNumStrm Flag to signal the end of the messages.
+ * @param hashStrm The hash of each message.
+ * @param endHashStrm Flag to signal the end of the hashes.
+ */
+template <unsigned int _laneNum>
+void blake3Merge(hls::stream<ap_uint<256> >& cvStrm,
+                 hls::stream<ap_uint<64> >& chunkNumStrm,
+                 hls::stream<bool>& endChunkNumStrm,
+                 hls::stream<ap_uint<256> >& hashStrm,
+                 hls::stream<bool>& endHashStrm) {
+    XF_SECURITY_STATIC_ASSERT((_laneNum & (_laneNum - 1)) == 0, "_laneNum must be a power of two");
+
+    // ping-pong buffers of one group, read two nodes from one and write one node to the other per cycle
+    ap_uint<256> node[2][_laneNum];
+#pragma HLS array_partition variable = node complete dim = 1
+#pragma HLS resource variable = node core = RAM_2P_LUTRAM
+    // a message of 2^64 bytes has 2^54 chunks
+    ap_uint<256> stack[64];
+#pragma HLS resource variable = stack core = RAM_2P_LUTRAM
+
+    bool end = endChunkNumStrm.read();
+loop_Msg:
+    while (!end) {
+        uint64_t chunkNum = chunkNumStrm.read();
+        end = endChunkNumStrm.read();
+        unsigned int sp = 0;
+        uint64_t groupIdx = 0;
+        ap_uint<256> cv;
+
+    loop_Group:
+        for (uint64_t g = 0; g < chunkNum; g += _laneNum) {
+#pragma HLS loop_tripcount min = 1 max = 1 avg = 1
+            unsigned int n = (chunkNum - g < _laneNum) ? (unsigned int)(chunkNum - g) : _laneNum;
+            bool lastGroup = (g + n == chunkNum);
+        loop_Load:
+            for (unsigned int c = 0; c < n; c++) {
+#pragma HLS pipeline II = 1
+                node[0][c] = cvStrm.read();
+            }
+
+            // reduce level by level, an odd node at the end of a level is carried up
+            unsigned int src = 0;
+        loop_Level:
+            while (n > 1) {
+#pragma HLS loop_tripcount min = 1 max = 1 avg = 1
+                unsigned int half = n >> 1;
+                // the only parent of a message shorter than a group is the root
+                bool root = lastGroup && g == 0 && n == 2;
+            loop_Pair:
+                for (unsigned int p = 0; p < half; p++) {
+#pragma HLS pipeline II = 1
+#pragma HLS dependence variable = node inter false
+                    node[1 - src][p] = blake3Parent(node[src][2 * p], node[src][2 * p + 1], root);
+                }
+                if (n & 1) {
+                    node[1 - src][half] = node[src][n - 1];
+                }
+                n = half + (n & 1);
+                src = 1 - src;
+            }
+            cv = node[src][0];
+
+            if (!lastGroup) {
+                // push the subtree root, merging with the stack while the group count has trailing zeros
+                uint64_t total = ++groupIdx;
+            loop_Push:
+                while ((total & 1) == 0) {
+#pragma HLS loop_tripcount min = 1 max = 1 avg = 1
+                    cv = blake3Parent(stack[--sp], cv, false);
+                    total >>= 1;
+                }
+                stack[sp++] = cv;
+            }
+        }
+
+    loop_Final:
+        while (sp > 0) {
+#pragma HLS loop_tripcount min = 1 max = 1 avg = 1
+            --sp;
+            cv = blake3Parent(stack[sp], cv, sp == 0);
+        }
+
+        hashStrm.write(cv);
+        endHashStrm.write(false);
+    }
+    endHashStrm.write(true);
+}
+
+} // end of namespace internal
+
+/**
+ * @brief blake3 computes the 32-byte BLAKE3 hash of each message, in the default unkeyed mode.
+ *
+ * The chunks of a message are taken in groups of _laneNum, the last group may be smaller. Inside a group the
+ * 512-bit blocks are interleaved: block j of every chunk which has block j, in chunk order, then block j + 1. Only
+ * ceil(len / 64) blocks of each message are sent, and the bytes after the end of the message are ignored.
+ *
+ * The chunk stage takes one block per cycle, and the merge stage runs in dataflow with it, so a message of at least
+ * _laneNum chunks is hashed at 64 bytes per cycle.
+ *
+ * @tparam _laneNum Number of chunks hashed at the same time, a power of two no less than the latency of the
+ * compression function.
+ * @param msgStrm The message blocks, byte i at bit 8i.
+ * @param lenStrm Length of each message in bytes.
+ * @param endLenStrm Flag to signal the end of the messages, false before each message and true to end.
+ * @param hashStrm The hash of each message, byte i at bit 8i.
+ * @param endHashStrm Flag to signal the end of the hashes.
+ */
+template <unsigned int _laneNum>
+void blake3(hls::stream<ap_uint<512> >& msgStrm,
+            hls::stream<ap_uint<64> >& lenStrm,
+            hls::stream<bool>& endLenStrm,
+            hls::stream<ap_uint<256> >& hashStrm,
+            hls::stream<bool>& endHashStrm) {
+#pragma HLS dataflow
+    hls::stream<ap_uint<256> > cvStrm("cvStrm");
+#pragma HLS RESOURCE variable = cvStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = cvStrm depth = _laneNum * 2 dim = 1
+    hls::stream<ap_uint<64> > chunkNumStrm("chunkNumStrm");
+#pragma HLS RESOURCE variable = chunkNumStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = chunkNumStrm depth = 32 dim = 1
+    hls::stream<bool> endChunkNumStrm("endChunkNumStrm");
+#pragma HLS RESOURCE variable = endChunkNumStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = endChunkNumStrm depth = 32 dim = 1
+
+    internal::blake3Chunk<_laneNum>(msgStrm, lenStrm, endLenStrm, cvStrm, chunkNumStrm, endChunkNumStrm);
+
+    internal::blake3Merge<_laneNum>(cvStrm, chunkNumStrm, endChunkNumStrm, hashStrm, endHashStrm);
+}
+
+} // end of namespace security
+} // end of namespace xf
+
+#endif // _XF_SECURITY_BLAKE3_HPP_
@@ -23,6 +23,8 @@
  * @detail Containing CBC mode with AES-128/192/256 and DES.
  * Loop-carried dependency is enforced by the CBC encryption algorithm,
  * but no dependency in decryption part,
+ * so multi-message encryption interleaves independent messages through one AES,
+ * and parallel decryption takes several blocks in each cycle.
  *
  */
 
@@ -612,6 +614,175 @@ static void aes256CbcDecrypt(
 
 } // end aes256CbcDecrypt
 
+/**
+ *
+ * @brief aesCbcEncryptMultiChan is CBC encryption of many independent messages with one AES single block cipher.
+ *
+ * The chain of one message leaves the AES pipeline idle until each block is encrypted, so _channelNumber messages
+ * form a batch and their blocks are interleaved round-robin through one AES pipeline. The feedback of a message is
+ * needed again _channelNumber cycles later, so the pipeline takes a new block every cycle.
+ *
+ * All messages of a call share one cipher key. In round r, channel c takes its block r if r is less than the length
+ * of its message, otherwise nothing, and the ciphertext blocks are emitted in the same order. Grouping messages of
+ * similar length into a batch saves idle slots.
+ *
+ * @tparam _keyWidth The bit-width of the cipher key, which is 128, 192, or 256.
+ * @tparam _channelNumber Number of messages in one batch, should be no less than the latency of AES.
+ *
+ * @param cipherkeyStrm Input cipher key used in encryption, x bits for AES-x, one per call.
+ * @param IVStrm Initialization vector of each message, 128 bits.
+ * @param lenStrm Length of each message in 128-bit blocks.
+ * @param endLenStrm End flag of the descriptors, false before each batch of _channelNumber messages.
+ * @param plaintextStrm Input block stream text to be encrypted, each block is 128 bits, in round-robin order.
+ * @param ciphertextStrm Output encrypted block stream text, each block is 128 bits, in round-robin order.
+ *
+ */
+
+template <unsigned int _keyWidth, unsigned int _channelNumber>
+void aesCbcEncryptMultiChan(
+    // input cipherkey
+    hls::stream<ap_uint<_keyWidth> >& cipherkeyStrm,
+    // descriptors of the messages
+    hls::stream<ap_uint<128> >& IVStrm,
+    hls::stream<ap_uint<64> >& lenStrm,
+    hls::stream<bool>& endLenStrm,
+    // stream in
+    hls::stream<ap_uint<128> >& plaintextStrm,
+    // stream out
+    hls::stream<ap_uint<128> >& ciphertextStrm) {
+    // local aes cihper
+    xf::security::aesEnc<_keyWidth> cipher;
+    // register cipherkey
+    ap_uint<_keyWidth> key_r = cipherkeyStrm.read();
+    cipher.updateKey(key_r);
+
+    // number of blocks and feedback of each channel
+    ap_uint<64> blkNum[_channelNumber];
+    ap_uint<128> feedback[_channelNumber];
+#pragma HLS resource variable = blkNum core = RAM_2P_LUTRAM
+#pragma HLS resource variable = feedback core = RAM_2P_LUTRAM
+
+loop_Batch:
+    while (!endLenStrm.read()) {
+#pragma HLS loop_tripcount min = 1 max = 1 avg = 1
+        ap_uint<64> roundNum = 0;
+    loop_Load:
+        for (int c = 0; c < _channelNumber; c++) {
+#pragma HLS pipeline II = 1
+            // feedback of the first block is IV
+            feedback[c] = IVStrm.read();
+            ap_uint<64> n = lenStrm.read();
+            blkNum[c] = n;
+            if (n > roundNum) {
+                roundNum = n;
+            }
+        }
+
+    loop_Round:
+        for (ap_uint<64> r = 0; r < roundNum; r++) {
+#pragma HLS loop_tripcount min = 64 max = 64 avg = 64
+        loop_RoundChan:
+            for (int c = 0; c < _channelNumber; c++) {
+#pragma HLS pipeline II = 1
+#pragma HLS dependence variable = feedback inter distance = _channelNumber true
+                if (r < blkNum[c]) {
+                    // CIPH_k(P_j ^ C_j-1)
+                    ap_uint<128> input_block = plaintextStrm.read() ^ feedback[c];
+                    ap_uint<128> output_block;
+                    cipher.process(input_block, key_r, output_block);
+                    feedback[c] = output_block;
+                    ciphertextStrm.write(output_block);
+                }
+            }
+        }
+    }
+
+} // end aesCbcEncryptMultiChan
+
+/**
+ *
+ * @brief aesCbcDecryptParallel is CBC decryption taking _blockNumber blocks in each cycle with AES single block
+ * cipher.
+ *
+ * Given the ciphertext, the blocks of CBC decryption do not depend on each other, so one key schedule feeds
+ * _blockNumber AES decryption pipelines, and a 512-bit word of 4 blocks is decrypted every cycle when _blockNumber is
+ * 4.
+ *
+ * All messages of a call share one cipher key and are taken one after the other. Each message starts at a new word,
+ * block i of a message is in bits 128 * (i % _blockNumber) + 127 to 128 * (i % _blockNumber) of its word i /
+ * _blockNumber, and the output blocks are placed in the same way. The blocks after the end of a message in its last
+ * word are dropped by the caller.
+ *
+ * @tparam _keyWidth The bit-width of the cipher key, which is 128, 192, or 256.
+ * @tparam _blockNumber Number of 128-bit blocks in one word.
+ *
+ * @param cipherkeyStrm Input cipher key used in decryption, x bits for AES-x, one per call.
+ * @param IVStrm Initialization vector of each message, 128 bits.
+ * @param lenStrm Length of each message in 128-bit blocks.
+ * @param endLenStrm End flag of the descriptors, false before each message.
+ * @param ciphertextStrm Input word stream text to be decrypted, _blockNumber blocks in each word.
+ * @param plaintextStrm Output decrypted word stream text, _blockNumber blocks in each word.
+ *
+ */
+
+template <unsigned int _keyWidth, unsigned int _blockNumber>
+void aesCbcDecryptParallel(
+    // input cipherkey
+    hls::stream<ap_uint<_keyWidth> >& cipherkeyStrm,
+    // descriptors of the messages
+    hls::stream<ap_uint<128> >& IVStrm,
+    hls::stream<ap_uint<64> >& lenStrm,
+    hls::stream<bool>& endLenStrm,
+    // stream in
+    hls::stream<ap_uint<128 * _blockNumber> >& ciphertextStrm,
+    // stream out
+    hls::stream<ap_uint<128 * _blockNumber> >& plaintextStrm) {
+    // local decipher, its round keys are shared by all the blocks of a word
+    xf::security::aesDec<_keyWidth> decipher;
+    // register cipherkey
+    ap_uint<_keyWidth> key_r = cipherkeyStrm.read();
+    decipher.updateKey(key_r);
+
+loop_Msg:
+    while (!endLenStrm.read()) {
+        // feedback of the first block is IV
+        ap_uint<128> feedback_r = IVStrm.read();
+        ap_uint<64> len = lenStrm.read();
+        ap_uint<64> wordNum = (len + _blockNumber - 1) / _blockNumber;
+
+    loop_Word:
+        for (ap_uint<64> w = 0; w < wordNum; w++) {
+#pragma HLS pipeline II = 1
+#pragma HLS loop_tripcount min = 64 max = 64 avg = 64
+            ap_uint<128 * _blockNumber> ciphertext_r = ciphertextStrm.read();
+            ap_uint<128 * _blockNumber> plaintext_r;
+
+            // previous ciphertext block of each block
+            ap_uint<128> prev[_blockNumber];
+#pragma HLS array_partition variable = prev complete
+            prev[0] = feedback_r;
+            for (int i = 1; i < _blockNumber; i++) {
+#pragma HLS unroll
+                prev[i] = ciphertext_r.range(128 * i - 1, 128 * i - 128);
+            }
+
+        loop_Block:
+            for (int i = 0; i < _blockNumber; i++) {
+#pragma HLS unroll
+                // CIPH_k^(-1)(C_j) ^ C_j-1
+                ap_uint<128> output_block;
+                decipher.process(ciphertext_r.range(128 * i + 127, 128 * i), key_r, output_block);
+                plaintext_r.range(128 * i + 127, 128 * i) = output_block ^ prev[i];
+            }
+
+            // the last ciphertext block is the feedback of the next word
+            feedback_r = ciphertext_r.range(128 * _blockNumber - 1, 128 * _blockNumber - 128);
+            plaintextStrm.write(plaintext_r);
+        }
+    }
+
+} // end aesCbcDecryptParallel
+
 } // namespace security
 } // namespace xf
 
@@ -0,0 +1,543 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file cdc.hpp
+ * @brief header file for content-defined chunking with fingerprints.
+ * This file is part of Vitis Security Library.
+ *
+ * @detail A Gear rolling hash finds the chunk boundaries in the style of FastCDC, and each chunk is hashed by the
+ * SHA-256 or BLAKE2b core of this library.
+ */
+
+#ifndef _XF_SECURITY_CDC_HPP_
+#define _XF_SECURITY_CDC_HPP_
+
+#include <ap_int.h>
+#include <hls_stream.h>
+
+#include "xf_security/blake2b.hpp"
+#include "xf_security/sha224_256.hpp"
+
+namespace xf {
+namespace security {
+namespace internal {
+
+/**
+ * @brief Find the chunk boundaries of each input with a Gear rolling hash, 8 bytes per cycle.
+ *
+ * The hash is h = (h << 1) + gear[byte], restarted from 0 at every chunk. A chunk of p bytes ends when p reaches
+ * maxSize, or when p is at least minSize and the top bits of h selected by the mask are all 0. Before avgSize the
+ * mask has 2 more bits than log2(avgSize), and after it 2 fewer bits, which normalizes the chunk sizes around avgSize.
+ *
+ * @param dataStrm The input data, 64 bits per word, byte i at bit 8i.
+ * @param lenStrm Length of each input in bytes.
+ * @param endLenStrm Flag to signal the end of the inputs.
+ * @param minSize The minimum chunk size in bytes, no less than 8.
+ * @param avgSize The expected chunk size in bytes, a power of 2.
+ * @param maxSize The maximum chunk size in bytes.
+ * @param wordStrm The input data passed on, zero beyond the length.
+ * @param nbStrm Number of valid bytes of each word.
+ * @param cutStrm Index of the last byte of a chunk in each word, 8 if no chunk ends in the word.
+ * @param fileLenStrm Length of each input passed on.
+ * @param endFileStrm End flag of the inputs passed on.
+ */
+static void gearCut(hls::stream<ap_uint<64> >& dataStrm,
+                    hls::stream<ap_uint<64> >& lenStrm,
+                    hls::stream<bool>& endLenStrm,
+                    ap_uint<32> minSize,
+                    ap_uint<32> avgSize,
+                    ap_uint<32> maxSize,
+                    hls::stream<ap_uint<64> >& wordStrm,
+                    hls::stream<ap_uint<4> >& nbStrm,
+                    hls::stream<ap_uint<4> >& cutStrm,
+                    hls::stream<ap_uint<64> >& fileLenStrm,
+                    hls::stream<bool>& endFileStrm) {
+    // gear table, splitmix64 outputs from seed 0
+    static const uint64_t gear[256] = {
+        0xe220a8397b1dcdafULL, 0x6e789e6aa1b965f4ULL, 0x06c45d188009454fULL, 0xf88bb8a8724c81ecULL,
+        0x1b39896a51a8749bULL, 0x53cb9f0c747ea2eaULL, 0x2c829abe1f4532e1ULL, 0xc584133ac916ab3cULL,
+        0x3ee5789041c98ac3ULL, 0xf3b8488c368cb0a6ULL, 0x657eecdd3cb13d09ULL, 0xc2d326e0055bdef6ULL,
+        0x8621a03fe0bbdb7bULL, 0x8e1f7555983aa92fULL, 0xb54e0f1600cc4d19ULL, 0x84bb3f97971d80abULL,
+        0x7d29825c75521255ULL, 0xc3cf17102b7f7f86ULL, 0x3466e9a083914f64ULL, 0xd81a8d2b5a4485acULL,
+        0xdb01602b100b9ed7ULL, 0xa9038a921825f10dULL, 0xedf5f1d90dca2f6aULL, 0x54496ad67bd2634cULL,
+        0xdd7c01d4f5407269ULL, 0x935e82f1db4c4f7bULL, 0x69b82ebc92233300ULL, 0x40d29eb57de1d510ULL,
+        0xa2f09dabb45c6316ULL, 0xee521d7a0f4d3872ULL, 0xf16952ee72f3454fULL, 0x377d35dea8e40225ULL,
+        0x0c7de8064963bab0ULL, 0x05582d37111ac529ULL, 0xd254741f599dc6f7ULL, 0x69630f7593d108c3ULL,
+        0x417ef96181daa383ULL, 0x3c3c41a3b43343a1ULL, 0x6e19905dcbe531dfULL, 0x4fa9fa7324851729ULL,
+        0x84eb4454a792922aULL, 0x134f7096918175ceULL, 0x07dc930b302278a8ULL, 0x12c015a97019e937ULL,
+        0xcc06c31652ebf438ULL, 0xecee65630a691e37ULL, 0x3e84ecb1763e79adULL, 0x690ed476743aae49ULL,
+        0x774615d7b1a1f2e1ULL, 0x22b353f04f4f52daULL, 0xe3ddd86ba71a5eb1ULL, 0xdf268adeb6513356ULL,
+        0x2098eb73d4367d77ULL, 0x03d6845323ce3c71ULL, 0xc952c5620043c714ULL, 0x9b196bca844f1705ULL,
+        0x30260345dd9e0ec1ULL, 0xcf448a5882bb9698ULL, 0xf4a578dccbc87656ULL, 0xbfdeaed9a17b3c8fULL,
+        0xed79402d1d5c5d7bULL, 0x55f070ab1cbbf170ULL, 0x3e00a34929a88f1dULL, 0xe255b237b8bb18fbULL,
+        0x2a7b67af6c6ad50eULL, 0x466d5e7f3e46f143ULL, 0x42375cb399a4fc72ULL, 0x8c8a1f148a8bb259ULL,
+        0x32fcab5daed5bdfcULL, 0x9e60398c8d8553c0ULL, 0xee89cceb8c4064c0ULL, 0xdb0215941d86a66fULL,
+        0x5ccde78203c367a8ULL, 0xf1bcbc6a1ec11786ULL, 0xef054fceee954551ULL, 0xdf82012d0555c6dfULL,
+        0x292566ff72403c08ULL, 0xc4dd302a1bfa1137ULL, 0xd85f219db5c554e1ULL, 0x6a27ff807441bcd2ULL,
+        0x96a573e9b48216e8ULL, 0x46a9fdac40bf0048ULL, 0x3dd12464a0ee15b4ULL, 0x451e521296a7eea1ULL,
+        0x56e4398a98f8a0fdULL, 0x7b7dc2160e3335a7ULL, 0xc679ee0bebcb1ccaULL, 0x928d6f2d7453424eULL,
+        0x1b38994205234c6dULL, 0x8086d193a6f2b568ULL, 0x21c6e26639ac2c65ULL, 0xd9dccac414d23c6fULL,
+        0x91cd642057e00235ULL, 0x77fc607dc6589373ULL, 0x05b8abe26dd3aee7ULL, 0x12f6436ac376cc66ULL,
+        0x64952424897b2307ULL, 0xee8c2baf6343e5c3ULL, 0xdc4c613d9eba2304ULL, 0x3505b7796bd1a506ULL,
+        0x8176daf800a05f50ULL, 0x8bd8ff7a0385cdbcULL, 0x1a764a3cd78101daULL, 0xbe4d15bf6ca266acULL,
+        0xa85e1f38bb2dc749ULL, 0x56759a968493cd8cULL, 0xf3a9bce7336bd182ULL, 0x365b15013741519bULL,
+        0x1f7a44a6b109ac94ULL, 0x3521d628813cb177ULL, 0x6a77afab0f7c9370ULL, 0x179642d8cde95015ULL,
+        0x5ef102a8fb354461ULL, 0xf51c504764ed82f2ULL, 0xc58427f041ce6808ULL, 0xfad8fc45c9643c37ULL,
+        0xcf8682f9a70fa9c0ULL, 0x7e1b3b75a4005729ULL, 0x992dd867927b52d8ULL, 0x7fbd5db142f6791fULL,
+        0x370595aacab4adaeULL, 0xb1392dbdc5ab61d6ULL, 0x9fea7dfc79d452d9ULL, 0x40b12b120085641cULL,
+        0xa192afe3157c85d0ULL, 0xc847729f4e08f3a3ULL, 0x6f1384a306c41fc2ULL, 0x12d05c4045a39c19ULL,
+        0x9899202fd20f0841ULL, 0xe9c7191857e774b8ULL, 0x4eead809af5b0cc3ULL, 0xe809acafa23864a4ULL,
+        0x4da1edaba1d0f7bdULL, 0x846eb9673349f8e4ULL, 0x87bae55b86039fe8ULL, 0x7f367b8bd953eff2ULL,
+        0x3884700f650d04e1ULL, 0xbfe4b2ab46980cadULL, 0xc5fc89075299106cULL, 0x37b2fa361adea7cdULL,
+        0x7d75d813f04895b4ULL, 0x702f5b393f62c0e0ULL, 0x0a3fc775f4ecf37fULL, 0xe4b23787a352437fULL,
+        0xf83fa245c34d6363ULL, 0xb99bcf040786cf50ULL, 0x38b6ea0a0e6c9d8aULL, 0x093fdc76776e37e1ULL,
+        0x1a75e6f76ba7eee8ULL, 0x442cdcfee9660c62ULL, 0x22d58d35116b5e0bULL, 0x87d4a5180f6a3645ULL,
+        0x589fb216bd82131bULL, 0x91d031cad319aec0ULL, 0xabecf76a553d320bULL, 0xb8686cb347612dcfULL,
+        0xfcab66337c0a77f5ULL, 0xac318214381ec437ULL, 0x6eb7f0fca24494aeULL, 0xcf42861dcdc895a9ULL,
+        0x4abad7a1586d7a91ULL, 0xc21b318dc2f49745ULL, 0xd49474dc2acbd1f0ULL, 0xb1d4873747c1c8e1ULL,
+        0x5434dc8c7d015bf6ULL, 0xe1c486287511b6a9ULL, 0xa8616df62e89a193ULL, 0x31ce6319498d8347ULL,
+        0xafd0b486123d6faaULL, 0xe6495f5d102301ebULL, 0x0dc51ced17a43c52ULL, 0x8bcbcde81355ef2dULL,
+        0x2412af73fdee7cfcULL, 0xc8d589e486e29eedULL, 0x23390e8664517f89ULL, 0x251ade58e8a6849dULL,
+        0xf8555dbd2e8f9cb0ULL, 0xcb417c3eef54f7c3ULL, 0x8028f8e1aac3a919ULL, 0x10e31052acf748a0ULL,
+        0x2d886c073b1e1b78ULL, 0x972974d90df9faeeULL, 0xbc1b7b38796893baULL, 0x1958ed432070e652ULL,
+        0xca5f297197a12dccULL, 0xe025a27375704f28ULL, 0x418010a570a924fbULL, 0x9828e2941bfc419cULL,
+        0x4fbacd2f52b85c1fULL, 0x33dd5b756211cc67ULL, 0x23c8dfdd1db57ff0ULL, 0x32f81801a1a8e901ULL,
+        0x26884eac5ada36daULL, 0xcaa82f9bb42e37d4ULL, 0x19fb1a7491d6a7d1ULL, 0x5aa0243aa357f38eULL,
+        0xb31d917809e447f0ULL, 0x3f9c197225215be0ULL, 0xdc3c315a1e33c095ULL, 0x3dd399ad533e80acULL,
+        0x566f32cce8301d95ULL, 0xc880188083d9ba21ULL, 0xb9cc357f3b0e7d2eULL, 0x0237d2123a8a8d6cULL,
+        0xbf636e9aa7cbf6bdULL, 0xd7bd4284c4e2a6a7ULL, 0xda2ebb47d50577a9ULL, 0x90ba1c11b539087dULL,
+        0x44993d31552b4f57ULL, 0x32c2d6f80a8a8898ULL, 0x450583ed7fb54b19ULL, 0xec2b0b09e50ef3efULL,
+        0xd918a0b6e2efd65cULL, 0xe37a868d9785f572ULL, 0x7d1a6118f2b0f37aULL, 0x9e2e3cc13b343439ULL,
+        0xefd82c11212e37e8ULL, 0xaf89c05cd4fc75edULL, 0x55bc16bb9697108eULL, 0x6c4701fa5db69beeULL,
+        0x9237338441daf445ULL, 0x248cf0831e81a5fcULL, 0xacc13557e77de273ULL, 0x520970c25e06513aULL,
+        0x657329cb02987cabULL, 0xa9b0b3366a4e55a8ULL, 0xc4d06ca2f39acdd4ULL, 0x5dce37d68170cde1ULL,
+        0x5f1e44e77e1854c9ULL, 0x6883d452d55df899ULL, 0x05c5bd62f1067032ULL, 0xe680b683ce60fab0ULL,
+        0x5dc9da3f286d18b1ULL, 0x94b4bf3ab85ed6d8ULL, 0xce65f449e3acc5a3ULL, 0x34b0209642cea639ULL,
+        0xc14c3c771d904827ULL, 0x6addcee2bd9cdee5ULL, 0xe24eed137ffbb613ULL, 0x75dd58ef79963d1bULL,
+        0xfdb83ecf6cc24920ULL, 0x7a1d0057c57169fbULL, 0x339200f4feb62d07ULL, 0xd33f4d4ac88469f4ULL,
+        0x8226f234e68dfee4ULL, 0x320def4f2a105536ULL, 0x7786f3b13aefc159ULL, 0xb28225ac9df63ee2ULL,
+        0x781b9d0376cc6044ULL, 0x05bd0115226c6ab6ULL, 0xd302230207bdfdabULL, 0xdb898abd8e0d2933ULL,
+        0x9e79a397ba00b9ccULL, 0x89df84a5f0003ee8ULL, 0x011f04f2a75fb9beULL, 0x5a5832bb47bcf19eULL};
+#pragma HLS resource variable = gear core = ROM_nP_LUTRAM
+
+    XF_SECURITY_ASSERT(minSize >= 8 && minSize <= avgSize && avgSize <= maxSize);
+
+    // number of bits of avgSize
+    ap_uint<6> avgBits = 0;
+    for (int i = 0; i < 32; i++) {
+#pragma HLS unroll
+        if (avgSize[i] == 1) {
+            avgBits = i;
+        }
+    }
+    ap_uint<64> maskS = 0;
+    ap_uint<64> maskL = 0;
+    for (int i = 0; i < 64; i++) {
+#pragma HLS unroll
+        maskS[63 - i] = (i < avgBits + 2);
+        maskL[63 - i] = (i + 2 < avgBits);
+    }
+
+    while (!endLenStrm.read()) {
+#pragma HLS loop_tripcount min = 1 max = 1 avg = 1
+        ap_uint<64> len = lenStrm.read();
+        fileLenStrm.write(len);
+        endFileStrm.write(false);
+
+        ap_uint<64> h = 0;
+        ap_uint<32> pos = 0;
+    LOOP_GEAR:
+        for (ap_uint<64> w = 0; w < len; w += 8) {
+#pragma HLS loop_tripcount min = 8192 max = 8192 avg = 8192
+#pragma HLS pipeline II = 1
+            ap_uint<64> data = dataStrm.read();
+            ap_uint<4> nb = (len - w > 8) ? ap_uint<64>(8) : ap_uint<64>(len - w);
+            ap_uint<4> cut = 8;
+            for (int i = 0; i < 8; i++) {
+#pragma HLS unroll
+                if (i < nb) {
+                    h = (h << 1) + gear[data.range(8 * i + 7, 8 * i)];
+                    pos++;
+                    bool mask0 = ((h & (pos < avgSize ? maskS : maskL)) == 0);
+                    if (pos >= maxSize || (pos >= minSize && mask0)) {
+                        cut = i;
+                        h = 0;
+                        pos = 0;
+                    }
+                } else {
+                    data.range(8 * i + 7, 8 * i) = 0;
+                }
+            }
+            wordStrm.write(data);
+            nbStrm.write(nb);
+            cutStrm.write(cut);
+        }
+    }
+    endFileStrm.write(true);
+}
+
+/**
+ * @brief Gather each chunk aligned to its first byte, then send its length and words to the hash core.
+ *
+ * A chunk which ends in the middle of a word leaves the rest of the word to the next chunk, and the end of each
+ * input always ends a chunk.
+ *
+ * @tparam _maxChunkSize The size of the chunk buffer in bytes, no less than maxSize of gearCut.
+ * @param wordStrm The input data, 64 bits per word.
+ * @param nbStrm Number of valid bytes of each word.
+ * @param cutStrm Index of the last byte of a chunk in each word, 8 if no chunk ends in the word.
+ * @param fileLenStrm Length of each input.
+ * @param endFileStrm End flag of the inputs.
+ * @param msgStrm The chunk data to hash.
+ * @param msgLenStrm Length of each chunk in bytes to hash.
+ * @param endMsgStrm End flag of the chunks to hash.
+ * @param chunkLenStrm Length of each chunk in bytes passed onto the output.
+ * @param endChunkStrm End flag of the chunks passed onto the output.
+ */
+template <unsigned int _maxChunkSize>
+void chunkCollect(hls::stream<ap_uint<64> >& wordStrm,
+                  hls::stream<ap_uint<4> >& nbStrm,
+                  hls::stream<ap_uint<4> >& cutStrm,
+                  hls::stream<ap_uint<64> >& fileLenStrm,
+                  hls::stream<bool>& endFileStrm,
+                  hls::stream<ap_uint<64> >& msgStrm,
+                  hls::stream<ap_uint<64> >& msgLenStrm,
+                  hls::stream<bool>& endMsgStrm,
+                  hls::stream<ap_uint<32> >& chunkLenStrm,
+                  hls::stream<bool>& endChunkStrm) {
+    ap_uint<64> buf[_maxChunkSize / 8 + 1];
+#pragma HLS resource variable = buf core = RAM_2P_URAM
+
+    while (!endFileStrm.read()) {
+#pragma HLS loop_tripcount min = 1 max = 1 avg = 1
+        ap_uint<64> wordNum = (fileLenStrm.read() + 7) >> 3;
+        // bytes of the current chunk not written to buf yet, always fewer than 8
+        ap_uint<64> tail = 0;
+        unsigned int fill = 0;
+        ap_uint<32> chunkLen = 0;
+
+        while (wordNum > 0 || chunkLen > 0) {
+#pragma HLS loop_tripcount min = 64 max = 64 avg = 64
+            bool cut = false;
+            ap_uint<64> rest = 0;
+            unsigned int restNb = 0;
+            unsigned int idx = 0;
+        LOOP_FILL:
+            while (wordNum > 0 && !cut) {
+#pragma HLS loop_tripcount min = 128 max = 128 avg = 128
+#pragma HLS pipeline II = 1
+                ap_uint<64> data = wordStrm.read();
+                unsigned int nb = nbStrm.read();
+                unsigned int pos = cutStrm.read();
+                --wordNum;
+                // bytes of this word which belong to the current chunk
+                unsigned int k = (pos < 8) ? pos + 1 : nb;
+                ap_uint<64> head = (k == 8) ? data : ap_uint<64>(data & ((ap_uint<64>(1) << (8 * k)) - 1));
+                ap_uint<128> t = tail;
+                t |= ap_uint<128>(head) << (8 * fill);
+                if (fill + k >= 8) {
+                    buf[idx++] = t.range(63, 0);
+                    tail = t.range(127, 64);
+                    fill = fill + k - 8;
+                } else {
+                    tail = t.range(63, 0);
+                    fill = fill + k;
+                }
+                chunkLen += k;
+                if (pos < 8) {
+                    cut = true;
+                    rest = (k == 8) ? ap_uint<64>(0) : ap_uint<64>(data >> (8 * k));
+                    restNb = nb - k;
+                }
+            }
+            if (fill > 0) {
+                buf[idx] = tail;
+            }
+
+            msgLenStrm.write(chunkLen);
+            endMsgStrm.write(false);
+            chunkLenStrm.write(chunkLen);
+            endChunkStrm.write(false);
+        LOOP_EMIT:
+            for (unsigned int i = 0; i < (chunkLen + 7) >> 3; i++) {
+#pragma HLS loop_tripcount min = 1024 max = 1024 avg = 1024
+#pragma HLS pipeline II = 1
+                msgStrm.write(buf[i]);
+            }
+
+            // the rest of the word starts the next chunk
+            tail = rest;
+            fill = restNb;
+            chunkLen = restNb;
+        }
+    }
+    endMsgStrm.write(true);
+    endChunkStrm.write(true);
+}
+
+/**
+ * @brief Provide the BLAKE2b parameters of each chunk, no key and outLen bytes of digest.
+ *
+ * @param msgLenStrm Length of each chunk in bytes.
+ * @param endMsgStrm End flag of the chunks.
+ * @param outLen Length of the digest in bytes.
+ * @param blakeLenStrm Length of each chunk for BLAKE2b.
+ * @param keyLenStrm Key length of each chunk, always 0.
+ * @param outLenStrm Digest length of each chunk.
+ * @param endBlakeStrm End flag of the chunks for BLAKE2b.
+ */
+static void blake2bChunkParam(hls::stream<ap_uint<64> >& msgLenStrm,
+                              hls::stream<bool>& endMsgStrm,
+                              ap_uint<8> outLen,
+                              hls::stream<ap_uint<128> >& blakeLenStrm,
+                              hls::stream<ap_uint<8> >& keyLenStrm,
+                              hls::stream<ap_uint<8> >& outLenStrm,
+                              hls::stream<bool>& endBlakeStrm) {
+    while (!endMsgStrm.read()) {
+#pragma HLS loop_tripcount min = 64 max = 64 avg = 64
+#pragma HLS pipeline II = 1
+        blakeLenStrm.write(msgLenStrm.read());
+        keyLenStrm.write(0);
+        outLenStrm.write(outLen);
+        endBlakeStrm.write(false);
+    }
+    endBlakeStrm.write(true);
+}
+
+/**
+ * @brief Pair each chunk length with its digest and its offset in the whole input.
+ *
+ * @tparam _digestWidth The bit width of the digest.
+ * @param chunkLenStrm Length of each chunk in bytes.
+ * @param endChunkStrm End flag of the chunks.
+ * @param hashStrm The digest of each chunk.
+ * @param endHashStrm End flag of the digests.
+ * @param offsetStrm Offset of each chunk in bytes.
+ * @param lenStrm Length of each chunk in bytes.
+ * @param digestStrm The digest of each chunk.
+ * @param endStrm Flag to signal the end of the chunks.
+ */
+template <unsigned int _digestWidth>
+void chunkOutput(hls::stream<ap_uint<32> >& chunkLenStrm,
+                 hls::stream<bool>& endChunkStrm,
+                 hls::stream<ap_uint<_digestWidth> >& hashStrm,
+                 hls::stream<bool>& endHashStrm,
+                 hls::stream<ap_uint<64> >& offsetStrm,
+                 hls::stream<ap_uint<32> >& lenStrm,
+                 hls::stream<ap_uint<_digestWidth> >& digestStrm,
+                 hls::stream<bool>& endStrm) {
+    ap_uint<64> offset = 0;
+    endHashStrm.read();
+    while (!endChunkStrm.read()) {
+#pragma HLS loop_tripcount min = 64 max = 64 avg = 64
+#pragma HLS pipeline II = 1
+        ap_uint<32> len = chunkLenStrm.read();
+        offsetStrm.write(offset);
+        lenStrm.write(len);
+        digestStrm.write(hashStrm.read());
+        endStrm.write(false);
+        endHashStrm.read();
+        offset += len;
+    }
+    endStrm.write(true);
+}
+
+} // namespace internal
+
+/**
+ * @brief cdcSha256 splits the inputs into content-defined chunks and computes the SHA-256 of each chunk.
+ *
+ * The boundaries come from a Gear rolling hash in the style of FastCDC, checked on 8 bytes per cycle, and do not
+ * move when data is inserted or removed elsewhere in the input. Every input ends its last chunk. Each chunk is
+ * buffered on chip, as the hash core needs its length first, and then hashed by the SHA-256 core.
+ *
+ * @tparam _maxChunkSize The size of the chunk buffer in bytes, no less than maxSize.
+ * @param dataStrm The input data, 64 bits per word, byte i at bit 8i.
+ * @param lenStrm Length of each input in bytes.
+ * @param endLenStrm Flag to signal the end of the inputs, false before each input and true to end.
+ * @param minSize The minimum chunk size in bytes, no less than 8.
+ * @param avgSize The expected chunk size in bytes, a power of 2.
+ * @param maxSize The maximum chunk size in bytes.
+ * @param offsetStrm Offset of each chunk in bytes, counted over all inputs.
+ * @param chunkLenStrm Length of each chunk in bytes.
+ * @param digestStrm The SHA-256 of each chunk, byte i at bit 8i.
+ * @param endChunkStrm Flag to signal the end of the chunks.
+ */
+template <unsigned int _maxChunkSize>
+void cdcSha256(hls::stream<ap_uint<64> >& dataStrm,
+               hls::stream<ap_uint<64> >& lenStrm,
+               hls::stream<bool>& endLenStrm,
+               ap_uint<32> minSize,
+               ap_uint<32> avgSize,
+               ap_uint<32> maxSize,
+               hls::stream<ap_uint<64> >& offsetStrm,
+               hls::stream<ap_uint<32> >& chunkLenStrm,
+               hls::stream<ap_uint<256> >& digestStrm,
+               hls::stream<bool>& endChunkStrm) {
+#pragma HLS DATAFLOW
+
+    hls::stream<ap_uint<64> > wordStrm("wordStrm");
+#pragma HLS RESOURCE variable = wordStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = wordStrm depth = 32 dim = 1
+    hls::stream<ap_uint<4> > nbStrm("nbStrm");
+#pragma HLS RESOURCE variable = nbStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = nbStrm depth = 32 dim = 1
+    hls::stream<ap_uint<4> > cutStrm("cutStrm");
+#pragma HLS RESOURCE variable = cutStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = cutStrm depth = 32 dim = 1
+    hls::stream<ap_uint<64> > fileLenStrm("fileLenStrm");
+#pragma HLS RESOURCE variable = fileLenStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = fileLenStrm depth = 32 dim = 1
+    hls::stream<bool> endFileStrm("endFileStrm");
+#pragma HLS RESOURCE variable = endFileStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = endFileStrm depth = 32 dim = 1
+    hls::stream<ap_uint<64> > msgStrm("msgStrm");
+#pragma HLS RESOURCE variable = msgStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = msgStrm depth = 32 dim = 1
+    hls::stream<ap_uint<64> > msgLenStrm("msgLenStrm");
+#pragma HLS RESOURCE variable = msgLenStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = msgLenStrm depth = 32 dim = 1
+    hls::stream<bool> endMsgStrm("endMsgStrm");
+#pragma HLS RESOURCE variable = endMsgStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = endMsgStrm depth = 32 dim = 1
+    hls::stream<ap_uint<32> > lenOutStrm("lenOutStrm");
+#pragma HLS RESOURCE variable = lenOutStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = lenOutStrm depth = 32 dim = 1
+    hls::stream<bool> endOutStrm("endOutStrm");
+#pragma HLS RESOURCE variable = endOutStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = endOutStrm depth = 32 dim = 1
+    hls::stream<ap_uint<256> > hashStrm("hashStrm");
+#pragma HLS RESOURCE variable = hashStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = hashStrm depth = 32 dim = 1
+    hls::stream<bool> endHashStrm("endHashStrm");
+#pragma HLS RESOURCE variable = endHashStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = endHashStrm depth = 32 dim = 1
+
+    internal::gearCut(dataStrm, lenStrm, endLenStrm, minSize, avgSize, maxSize, wordStrm, nbStrm, cutStrm,
+                      fileLenStrm, endFileStrm);
+
+    internal::chunkCollect<_maxChunkSize>(wordStrm, nbStrm, cutStrm, fileLenStrm, endFileStrm, msgStrm, msgLenStrm,
+                                          endMsgStrm, lenOutStrm, endOutStrm);
+
+    sha256<64>(msgStrm, msgLenStrm, endMsgStrm, hashStrm, endHashStrm);
+
+    internal::chunkOutput<256>(lenOutStrm, endOutStrm, hashStrm, endHashStrm, offsetStrm, chunkLenStrm, digestStrm,
+                               endChunkStrm);
+}
+
+/**
+ * @brief cdcBlake2b splits the inputs into content-defined chunks and computes the BLAKE2b of each chunk.
+ *
+ * The chunking is the same as cdcSha256, and each chunk is hashed by the BLAKE2b core without a key.
+ *
+ * @tparam _maxChunkSize The size of the chunk buffer in bytes, no less than maxSize.
+ * @param dataStrm The input data, 64 bits per word, byte i at bit 8i.
+ * @param lenStrm Length of each input in bytes.
+ * @param endLenStrm Flag to signal the end of the inputs, false before each input and true to end.
+ * @param minSize The minimum chunk size in bytes, no less than 8.
+ * @param avgSize The expected chunk size in bytes, a power of 2.
+ * @param maxSize The maximum chunk size in bytes.
+ * @param outLen Length of the BLAKE2b digest in bytes, 1 to 64.
+ * @param offsetStrm Offset of each chunk in bytes, counted over all inputs.
+ * @param chunkLenStrm Length of each chunk in bytes.
+ * @param digestStrm The BLAKE2b of each chunk in the lower outLen bytes, byte i at bit 8i.
+ * @param endChunkStrm Flag to signal the end of the chunks.
+ */
+template <unsigned int _maxChunkSize>
+void cdcBlake2b(hls::stream<ap_uint<64> >& dataStrm,
+                hls::stream<ap_uint<64> >& lenStrm,
+                hls::stream<bool>& endLenStrm,
+                ap_uint<32> minSize,
+                ap_uint<32> avgSize,
+                ap_uint<32> maxSize,
+                ap_uint<8> outLen,
+                hls::stream<ap_uint<64> >& offsetStrm,
+                hls::stream<ap_uint<32> >& chunkLenStrm,
+                hls::stream<ap_uint<512> >& digestStrm,
+                hls::stream<bool>& endChunkStrm) {
+#pragma HLS DATAFLOW
+
+    hls::stream<ap_uint<64> > wordStrm("wordStrm");
+#pragma HLS RESOURCE variable = wordStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = wordStrm depth = 32 dim = 1
+    hls::stream<ap_uint<4> > nbStrm("nbStrm");
+#pragma HLS RESOURCE variable = nbStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = nbStrm depth = 32 dim = 1
+    hls::stream<ap_uint<4> > cutStrm("cutStrm");
+#pragma HLS RESOURCE variable = cutStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = cutStrm depth = 32 dim = 1
+    hls::stream<ap_uint<64> > fileLenStrm("fileLenStrm");
+#pragma HLS RESOURCE variable = fileLenStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = fileLenStrm depth = 32 dim = 1
+    hls::stream<bool> endFileStrm("endFileStrm");
+#pragma HLS RESOURCE variable = endFileStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = endFileStrm depth = 32 dim = 1
+    hls::stream<ap_uint<64> > msgStrm("msgStrm");
+#pragma HLS RESOURCE variable = msgStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = msgStrm depth = 32 dim = 1
+    hls::stream<ap_uint<64> > msgLenStrm("msgLenStrm");
+#pragma HLS RESOURCE variable = msgLenStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = msgLenStrm depth = 32 dim = 1
+    hls::stream<bool> endMsgStrm("endMsgStrm");
+#pragma HLS RESOURCE variable = endMsgStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = endMsgStrm depth = 32 dim = 1
+    hls::stream<ap_uint<128> > blakeLenStrm("blakeLenStrm");
+#pragma HLS RESOURCE variable = blakeLenStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = blakeLenStrm depth = 32 dim = 1
+    hls::stream<ap_uint<64> > keyStrm("keyStrm");
+#pragma HLS RESOURCE variable = keyStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = keyStrm depth = 32 dim = 1
+    hls::stream<ap_uint<8> > keyLenStrm("keyLenStrm");
+#pragma HLS RESOURCE variable = keyLenStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = keyLenStrm depth = 32 dim = 1
+    hls::stream<ap_uint<8> > outLenStrm("outLenStrm");
+#pragma HLS RESOURCE variable = outLenStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = outLenStrm depth = 32 dim = 1
+    hls::stream<bool> endBlakeStrm("endBlakeStrm");
+#pragma HLS RESOURCE variable = endBlakeStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = endBlakeStrm depth = 32 dim = 1
+    hls::stream<ap_uint<32> > lenOutStrm("lenOutStrm");
+#pragma HLS RESOURCE variable = lenOutStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = lenOutStrm depth = 32 dim = 1
+    hls::stream<bool> endOutStrm("endOutStrm");
+#pragma HLS RESOURCE variable = endOutStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = endOutStrm depth = 32 dim = 1
+    hls::stream<ap_uint<512> > hashStrm("hashStrm");
+#pragma HLS RESOURCE variable = hashStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = hashStrm depth = 32 dim = 1
+    hls::stream<bool> endHashStrm("endHashStrm");
+#pragma HLS RESOURCE variable = endHashStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = endHashStrm depth = 32 dim = 1
+
+    internal::gearCut(dataStrm, lenStrm, endLenStrm, minSize, avgSize, maxSize, wordStrm, nbStrm, cutStrm,
+                      fileLenStrm, endFileStrm);
+
+    internal::chunkCollect<_maxChunkSize>(wordStrm, nbStrm, cutStrm, fileLenStrm, endFileStrm, msgStrm, msgLenStrm,
+                                          endMsgStrm, lenOutStrm, endOutStrm);
+
+    internal::blake2bChunkParam(msgLenStrm, endMsgStrm, outLen, blakeLenStrm, keyLenStrm, outLenStrm, endBlakeStrm);
+
+    blake2b<64>(msgStrm, blakeLenStrm, keyStrm, keyLenStrm, outLenStrm, endBlakeStrm, hashStrm, endHashStrm);
+
+    internal::chunkOutput<512>(lenOutStrm, endOutStrm, hashStrm, endHashStrm, offsetStrm, chunkLenStrm, digestStrm,
+                               endChunkStrm);
+}
+
+} // namespace security
+} // namespace xf
+
+#endif // _XF_SECURITY_CDC_HPP_
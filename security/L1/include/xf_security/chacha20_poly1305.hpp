@@ -0,0 +1,690 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file chacha20_poly1305.hpp
+ * @brief header file for ChaCha20-Poly1305 AEAD (RFC 8439).
+ * This file part of Vitis Security Library.
+ *
+ * @detail The one-time Poly1305 key is taken from the first ChaCha20 block of each message, and the padding of AAD
+ * and ciphertext is done inside, so the message is streamed only once.
+ */
+
+#ifndef _XF_SECURITY_CHACHA20_POLY1305_HPP_
+#define _XF_SECURITY_CHACHA20_POLY1305_HPP_
+
+#include <ap_int.h>
+#include <hls_stream.h>
+
+#include "xf_security/chacha20.hpp"
+
+namespace xf {
+namespace security {
+namespace internal {
+
+/**
+ * @brief Generate one 64-byte ChaCha20 keystream block.
+ *
+ * @param key The 256-bit key, byte i at bit 8i.
+ * @param counter The block counter.
+ * @param nonce The 96-bit nonce, byte i at bit 8i.
+ * @return The keystream block, byte i at bit 8i.
+ */
+static ap_uint<512> chachaBlock(ap_uint<256> key, ap_uint<32> counter, ap_uint<96> nonce) {
+#pragma HLS inline
+    ap_uint<32> s[16];
+#pragma HLS array_partition variable = s complete
+    ap_uint<32> x[16];
+#pragma HLS array_partition variable = x complete
+    // "expand 32-byte k"
+    s[0] = 0x61707865;
+    s[1] = 0x3320646e;
+    s[2] = 0x79622d32;
+    s[3] = 0x6b206574;
+    for (int i = 0; i < 8; ++i) {
+#pragma HLS unroll
+        s[i + 4] = key.range(i * 32 + 31, i * 32);
+    }
+    s[12] = counter;
+    for (int i = 0; i < 3; ++i) {
+#pragma HLS unroll
+        s[i + 13] = nonce.range(i * 32 + 31, i * 32);
+    }
+    for (int i = 0; i < 16; ++i) {
+#pragma HLS unroll
+        x[i] = s[i];
+    }
+    for (int i = 0; i < ROUNDS; i += 2) {
+#pragma HLS unroll
+        QR(x[0], x[4], x[8], x[12]);
+        QR(x[1], x[5], x[9], x[13]);
+        QR(x[2], x[6], x[10], x[14]);
+        QR(x[3], x[7], x[11], x[15]);
+        QR(x[0], x[5], x[10], x[15]);
+        QR(x[1], x[6], x[11], x[12]);
+        QR(x[2], x[7], x[8], x[13]);
+        QR(x[3], x[4], x[9], x[14]);
+    }
+    ap_uint<512> ks;
+    for (int i = 0; i < 16; ++i) {
+#pragma HLS unroll
+        ks.range(i * 32 + 31, i * 32) = x[i] + s[i];
+    }
+    return ks;
+}
+
+/**
+ * @brief Clear the bytes of a block from lenByte on.
+ *
+ * @param blk The block, byte i at bit 8i.
+ * @param lenByte Number of valid bytes, 0 to 64.
+ * @return The masked block.
+ */
+static ap_uint<512> maskTail(ap_uint<512> blk, ap_uint<7> lenByte) {
+#pragma HLS inline
+    ap_uint<512> res = 0;
+    for (int i = 0; i < 64; i++) {
+#pragma HLS unroll
+        if (i < lenByte) {
+            res.range(i * 8 + 7, i * 8) = blk.range(i * 8 + 7, i * 8);
+        }
+    }
+    return res;
+}
+
+/**
+ * @brief Reduce a product modulo 2^130 - 5.
+ *
+ * 2^130 is 5 modulo 2^130 - 5, so the bits above 130 are folded back with a multiplication by 5.
+ *
+ * @param x The number to reduce, less than 2^264.
+ * @return x mod 2^130 - 5.
+ */
+static ap_uint<130> poly1305Reduce(ap_uint<264> x) {
+#pragma HLS inline
+    ap_uint<138> t0 = x.range(129, 0);
+    ap_uint<134> h0 = x.range(263, 130);
+    t0 += h0 * 5;
+    ap_uint<131> t1 = t0.range(129, 0);
+    ap_uint<8> h1 = t0.range(137, 130);
+    t1 += h1 * 5;
+    ap_uint<131> t2 = t1.range(129, 0);
+    if (t1[130] == 1) {
+        t2 += 5;
+    }
+    // t2 < 2^130 here, one subtraction at most
+    ap_uint<131> p = 0;
+    p.range(129, 0) = -5;
+    if (t2 >= p) {
+        t2 -= p;
+    }
+    return t2.range(129, 0);
+}
+
+/**
+ * @brief Modular multiplication, the result is a * b mod 2^130 - 5.
+ *
+ * @param a The multiplicand.
+ * @param b The multiplier, less than 2^130 - 5.
+ * @return The product.
+ */
+static ap_uint<130> poly1305MultMod(ap_uint<131> a, ap_uint<130> b) {
+#pragma HLS inline
+    ap_uint<264> prod = a * b;
+    return poly1305Reduce(prod);
+}
+
+/**
+ * @brief Absorb up to four 16-byte blocks into the Poly1305 accumulator at once.
+ *
+ * The blocks are zero padded to 16 bytes as RFC 8439 asks for AEAD, and with k blocks the accumulator becomes
+ * (acc + m1) * r^k + m2 * r^(k - 1) + ... + mk * r, so the loop carried dependency is one multiplication per up
+ * to 64 bytes instead of one per 16 bytes.
+ *
+ * @param acc The accumulator, less than 2^130 - 5.
+ * @param data The blocks, byte i at bit 8i, zero beyond lenByte.
+ * @param lenByte Number of valid bytes, 1 to 64.
+ * @param rPow r, r^2, r^3 and r^4 modulo 2^130 - 5.
+ * @return The updated accumulator.
+ */
+static ap_uint<130> poly1305Absorb(ap_uint<130> acc, ap_uint<512> data, ap_uint<7> lenByte, ap_uint<130> rPow[4]) {
+#pragma HLS inline
+    ap_uint<3> k = (lenByte + 15) >> 4;
+    ap_uint<264> sum = 0;
+    for (int j = 0; j < 4; j++) {
+#pragma HLS unroll
+        if (j < k) {
+            ap_uint<131> m = data.range(j * 128 + 127, j * 128);
+            m[128] = 1;
+            if (j == 0) {
+                m += acc;
+            }
+            ap_uint<262> prod = m * rPow[k - 1 - j];
+            sum += prod;
+        }
+    }
+    return poly1305Reduce(sum);
+}
+
+/**
+ * @brief Compute r, r^2, r^3 and r^4 from the one-time Poly1305 key.
+ *
+ * @param polyKey The first 32 bytes of ChaCha20 block 0, r in the low half and s in the high half.
+ * @param rPow r, r^2, r^3 and r^4 modulo 2^130 - 5.
+ */
+static void poly1305Powers(ap_uint<256> polyKey, ap_uint<130> rPow[4]) {
+#pragma HLS inline
+    ap_uint<128> clamp;
+    clamp.range(127, 64) = 0x0ffffffc0ffffffc;
+    clamp.range(63, 0) = 0x0ffffffc0fffffff;
+    rPow[0] = polyKey.range(127, 0) & clamp;
+    for (int j = 1; j < 4; j++) {
+#pragma HLS unroll
+        rPow[j] = poly1305MultMod(rPow[j - 1], rPow[0]);
+    }
+}
+
+/**
+ * @brief Encrypt or decrypt the payload, and pass the one-time key and the ciphertext onto the MAC.
+ *
+ * @tparam _encrypt Encrypt if true, otherwise decrypt.
+ * @param keyStrm The 256-bit key.
+ * @param nonceStrm The 96-bit nonce.
+ * @param inStrm Input text, 512 bits per block.
+ * @param lenInStrm Length of input text in bytes.
+ * @param endLenStrm Flag to signal the end of the length stream.
+ * @param polyKeyStrm The one-time Poly1305 key passed onto the MAC.
+ * @param macStrm The ciphertext passed onto the MAC.
+ * @param lenMacStrm Length of the ciphertext in bytes passed onto the MAC.
+ * @param endMacStrm End flag passed onto the MAC.
+ * @param outStrm Output text, 512 bits per block, zero beyond the length.
+ * @param lenOutStrm Length of output text in bytes.
+ */
+template <bool _encrypt>
+void chachaCipher(hls::stream<ap_uint<256> >& keyStrm,
+                  hls::stream<ap_uint<96> >& nonceStrm,
+                  hls::stream<ap_uint<512> >& inStrm,
+                  hls::stream<ap_uint<64> >& lenInStrm,
+                  hls::stream<bool>& endLenStrm,
+                  hls::stream<ap_uint<256> >& polyKeyStrm,
+                  hls::stream<ap_uint<512> >& macStrm,
+                  hls::stream<ap_uint<64> >& lenMacStrm,
+                  hls::stream<bool>& endMacStrm,
+                  hls::stream<ap_uint<512> >& outStrm,
+                  hls::stream<ap_uint<64> >& lenOutStrm) {
+    bool end = endLenStrm.read();
+    while (!end) {
+#pragma HLS loop_tripcount min = 1 max = 1 avg = 1
+        ap_uint<256> key = keyStrm.read();
+        ap_uint<96> nonce = nonceStrm.read();
+        ap_uint<64> len = lenInStrm.read();
+
+        // block 0 is the one-time Poly1305 key, the text starts from block 1
+        ap_uint<512> blk0 = chachaBlock(key, 0, nonce);
+        polyKeyStrm.write(blk0.range(255, 0));
+        lenMacStrm.write(len);
+        lenOutStrm.write(len);
+        endMacStrm.write(false);
+
+        ap_uint<32> counter = 1;
+    LOOP_TEXT:
+        for (ap_uint<64> i = 0; i < len; i += 64) {
+#pragma HLS loop_tripcount min = 24 max = 24 avg = 24
+#pragma HLS pipeline II = 1
+            ap_uint<7> lenByte = (len - i > 64) ? ap_uint<64>(64) : ap_uint<64>(len - i);
+            ap_uint<512> in = maskTail(inStrm.read(), lenByte);
+            ap_uint<512> out = maskTail(in ^ chachaBlock(key, counter, nonce), lenByte);
+            outStrm.write(out);
+            macStrm.write(_encrypt ? out : in);
+            counter++;
+        }
+
+        end = endLenStrm.read();
+    }
+    endMacStrm.write(true);
+}
+
+/**
+ * @brief Compute r^4, r^8, ..., r^(4 * _laneNumber), the steps between the words of the interleaved accumulators.
+ *
+ * @tparam _laneNumber Number of interleaved accumulators.
+ * @param r4 r^4 modulo 2^130 - 5.
+ * @param laneR laneR[j] is r^(4j) modulo 2^130 - 5, with laneR[0] = 1.
+ */
+template <unsigned int _laneNumber>
+void poly1305LanePowers(ap_uint<130> r4, ap_uint<130> laneR[_laneNumber + 1]) {
+#pragma HLS inline
+    laneR[0] = 1;
+    laneR[1] = r4;
+    for (int j = 2; j <= _laneNumber; j++) {
+#pragma HLS unroll
+        laneR[j] = poly1305MultMod(laneR[j - 1], r4);
+    }
+}
+
+/**
+ * @brief Compute the Poly1305 tag over the padded AAD, the padded ciphertext and their lengths.
+ *
+ * The full 64-byte words of the ciphertext are spread round-robin over _laneNumber independent accumulators, and
+ * each of them steps by r^(4 * _laneNumber), so the same accumulator is only needed again _laneNumber cycles later.
+ * The lanes are aligned so that the last full word falls into the last lane, then lane j is weighted by
+ * r^(4 * (_laneNumber - 1 - j)) and the lanes are summed up. A partial last word is absorbed after that.
+ *
+ * @tparam _laneNumber Number of interleaved accumulators, a power of 2 no less than the latency of one step.
+ * @param AADStrm AAD, 128 bits per block.
+ * @param lenAADStrm Length of AAD in bytes.
+ * @param polyKeyStrm The one-time Poly1305 key.
+ * @param macStrm The ciphertext, 512 bits per block.
+ * @param lenMacStrm Length of the ciphertext in bytes.
+ * @param endMacStrm Flag to signal the end of the messages.
+ * @param tagStrm The MAC stream.
+ * @param endTagStrm Flag to signal the end of the MAC stream.
+ */
+template <unsigned int _laneNumber>
+void poly1305Mac(hls::stream<ap_uint<128> >& AADStrm,
+                 hls::stream<ap_uint<64> >& lenAADStrm,
+                 hls::stream<ap_uint<256> >& polyKeyStrm,
+                 hls::stream<ap_uint<512> >& macStrm,
+                 hls::stream<ap_uint<64> >& lenMacStrm,
+                 hls::stream<bool>& endMacStrm,
+                 hls::stream<ap_uint<128> >& tagStrm,
+                 hls::stream<bool>& endTagStrm) {
+    ap_uint<130> rPow[4];
+#pragma HLS array_partition variable = rPow complete
+    ap_uint<130> laneR[_laneNumber + 1];
+#pragma HLS array_partition variable = laneR complete
+    ap_uint<130> lanes[_laneNumber];
+#pragma HLS resource variable = lanes core = RAM_2P_LUTRAM
+
+    while (!endMacStrm.read()) {
+#pragma HLS loop_tripcount min = 1 max = 1 avg = 1
+        ap_uint<256> polyKey = polyKeyStrm.read();
+        poly1305Powers(polyKey, rPow);
+        poly1305LanePowers<_laneNumber>(rPow[3], laneR);
+        ap_uint<64> lenAAD = lenAADStrm.read();
+        ap_uint<64> len = lenMacStrm.read();
+        ap_uint<130> acc = 0;
+
+    LOOP_AAD:
+        for (ap_uint<64> i = 0; i < lenAAD; i += 16) {
+#pragma HLS loop_tripcount min = 1 max = 1 avg = 1
+#pragma HLS pipeline
+            ap_uint<7> lenByte = (lenAAD - i > 16) ? ap_uint<64>(16) : ap_uint<64>(lenAAD - i);
+            ap_uint<512> data = 0;
+            data.range(127, 0) = AADStrm.read();
+            acc = poly1305Absorb(acc, maskTail(data, lenByte), lenByte, rPow);
+        }
+
+    LOOP_LANE_INIT:
+        for (unsigned int j = 0; j < _laneNumber; j++) {
+#pragma HLS pipeline II = 1
+            lanes[j] = 0;
+        }
+
+        // the lanes before the first word would only absorb zeros, so the first word starts at lane offset
+        ap_uint<64> numFull = len >> 6;
+        ap_uint<64> offset = (_laneNumber - numFull % _laneNumber) % _laneNumber;
+    LOOP_TEXT:
+        for (ap_uint<64> i = 0; i < numFull; i++) {
+#pragma HLS loop_tripcount min = 24 max = 24 avg = 24
+#pragma HLS pipeline II = 1
+#pragma HLS dependence variable = lanes inter distance = _laneNumber true
+            // the AAD accumulator goes in with the first word
+            ap_uint<130> a = poly1305Absorb(i == 0 ? acc : ap_uint<130>(0), macStrm.read(), 64, rPow);
+            unsigned int l = (i + offset) % _laneNumber;
+            ap_uint<264> t = lanes[l] * laneR[_laneNumber];
+            t += a;
+            lanes[l] = poly1305Reduce(t);
+        }
+
+        if (numFull > 0) {
+            ap_uint<264> sum = 0;
+        LOOP_LANE_SUM:
+            for (unsigned int j = 0; j < _laneNumber; j++) {
+#pragma HLS pipeline II = 1
+                ap_uint<262> prod = lanes[j] * laneR[_laneNumber - 1 - j];
+                sum += prod;
+            }
+            acc = poly1305Reduce(sum);
+        }
+
+        ap_uint<7> lenTail = len.range(5, 0);
+        if (lenTail > 0) {
+            acc = poly1305Absorb(acc, macStrm.read(), lenTail, rPow);
+        }
+
+        // little-endian AAD length and ciphertext length
+        ap_uint<512> lenBlk = 0;
+        lenBlk.range(63, 0) = lenAAD;
+        lenBlk.range(127, 64) = len;
+        acc = poly1305Absorb(acc, lenBlk, 16, rPow);
+
+        ap_uint<128> tag = acc.range(127, 0) + polyKey.range(255, 128);
+        tagStrm.write(tag);
+        endTagStrm.write(false);
+    }
+    endTagStrm.write(true);
+}
+
+/**
+ * @brief Dataflow of the ChaCha20 cipher and the Poly1305 MAC.
+ *
+ * @tparam _encrypt Encrypt if true, otherwise decrypt.
+ */
+template <bool _encrypt>
+void chacha20Poly1305Imp(hls::stream<ap_uint<256> >& keyStrm,
+                         hls::stream<ap_uint<96> >& nonceStrm,
+                         hls::stream<ap_uint<128> >& AADStrm,
+                         hls::stream<ap_uint<64> >& lenAADStrm,
+                         hls::stream<ap_uint<512> >& inStrm,
+                         hls::stream<ap_uint<64> >& lenInStrm,
+                         hls::stream<bool>& endLenStrm,
+                         hls::stream<ap_uint<512> >& outStrm,
+                         hls::stream<ap_uint<64> >& lenOutStrm,
+                         hls::stream<ap_uint<128> >& tagStrm,
+                         hls::stream<bool>& endTagStrm) {
+#pragma HLS DATAFLOW
+
+    hls::stream<ap_uint<256> > polyKeyStrm("polyKeyStrm");
+#pragma HLS RESOURCE variable = polyKeyStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = polyKeyStrm depth = 32 dim = 1
+
+    hls::stream<ap_uint<512> > macStrm("macStrm");
+#pragma HLS RESOURCE variable = macStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = macStrm depth = 32 dim = 1
+
+    hls::stream<ap_uint<64> > lenMacStrm("lenMacStrm");
+#pragma HLS RESOURCE variable = lenMacStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = lenMacStrm depth = 32 dim = 1
+
+    hls::stream<bool> endMacStrm("endMacStrm");
+#pragma HLS RESOURCE variable = endMacStrm core = FIFO_LUTRAM
+#pragma HLS STREAM variable = endMacStrm depth = 32 dim = 1
+
+    chachaCipher<_encrypt>(keyStrm, nonceStrm, inStrm, lenInStrm, endLenStrm, polyKeyStrm, macStrm, lenMacStrm,
+                           endMacStrm, outStrm, lenOutStrm);
+
+    poly1305Mac<8>(AADStrm, lenAADStrm, polyKeyStrm, macStrm, lenMacStrm, endMacStrm, tagStrm, endTagStrm);
+}
+
+/**
+ * @brief Multi-channel ChaCha20-Poly1305 of one batch after another.
+ *
+ * @tparam _channelNumber Number of messages in one batch.
+ * @tparam _encrypt Encrypt if true, otherwise decrypt.
+ */
+template <unsigned int _channelNumber, bool _encrypt>
+void chacha20Poly1305MultiChanImp(hls::stream<ap_uint<256> >& keyStrm,
+                                  hls::stream<ap_uint<96> >& nonceStrm,
+                                  hls::stream<ap_uint<64> >& lenAADStrm,
+                                  hls::stream<ap_uint<64> >& lenInStrm,
+                                  hls::stream<bool>& endLenStrm,
+                                  hls::stream<ap_uint<128> >& AADStrm,
+                                  hls::stream<ap_uint<512> >& inStrm,
+                                  hls::stream<ap_uint<512> >& outStrm,
+                                  hls::stream<ap_uint<128> >& tagStrm) {
+    ap_uint<256> key[_channelNumber];
+    ap_uint<96> nonce[_channelNumber];
+    ap_uint<64> lenAAD[_channelNumber];
+    ap_uint<64> len[_channelNumber];
+    ap_uint<64> blkAAD[_channelNumber];
+    ap_uint<64> blkText[_channelNumber];
+    ap_uint<128> sKey[_channelNumber];
+    ap_uint<130> r1[_channelNumber];
+    ap_uint<130> r2[_channelNumber];
+    ap_uint<130> r3[_channelNumber];
+    ap_uint<130> r4[_channelNumber];
+    ap_uint<130> acc[_channelNumber];
+    ap_uint<128> tag[_channelNumber];
+#pragma HLS resource variable = key core = RAM_2P_LUTRAM
+#pragma HLS resource variable = nonce core = RAM_2P_LUTRAM
+#pragma HLS resource variable = lenAAD core = RAM_2P_LUTRAM
+#pragma HLS resource variable = len core = RAM_2P_LUTRAM
+#pragma HLS resource variable = blkAAD core = RAM_2P_LUTRAM
+#pragma HLS resource variable = blkText core = RAM_2P_LUTRAM
+#pragma HLS resource variable = sKey core = RAM_2P_LUTRAM
+#pragma HLS resource variable = r1 core = RAM_2P_LUTRAM
+#pragma HLS resource variable = r2 core = RAM_2P_LUTRAM
+#pragma HLS resource variable = r3 core = RAM_2P_LUTRAM
+#pragma HLS resource variable = r4 core = RAM_2P_LUTRAM
+#pragma HLS resource variable = acc core = RAM_2P_LUTRAM
+#pragma HLS resource variable = tag core = RAM_2P_LUTRAM
+
+loop_Batch:
+    while (!endLenStrm.read()) {
+#pragma HLS loop_tripcount min = 1 max = 1 avg = 1
+        ap_uint<64> roundNum = 0;
+    loop_Load:
+        for (unsigned int c = 0; c < _channelNumber; c++) {
+#pragma HLS pipeline II = 1
+            key[c] = keyStrm.read();
+            nonce[c] = nonceStrm.read();
+            lenAAD[c] = lenAADStrm.read();
+            len[c] = lenInStrm.read();
+            blkAAD[c] = (lenAAD[c] + 15) >> 4;
+            blkText[c] = (len[c] + 63) >> 6;
+            // key generation, AAD blocks, text blocks and the length block
+            ap_uint<64> n = blkAAD[c] + blkText[c] + 2;
+            if (n > roundNum) {
+                roundNum = n;
+            }
+        }
+
+    loop_Round:
+        for (ap_uint<64> r = 0; r < roundNum; r++) {
+#pragma HLS loop_tripcount min = 26 max = 26 avg = 26
+        loop_RoundChan:
+            for (unsigned int c = 0; c < _channelNumber; c++) {
+#pragma HLS pipeline II = 1
+#pragma HLS dependence variable = acc inter distance = _channelNumber true
+#pragma HLS dependence variable = r1 inter distance = _channelNumber true
+#pragma HLS dependence variable = r2 inter distance = _channelNumber true
+#pragma HLS dependence variable = r3 inter distance = _channelNumber true
+#pragma HLS dependence variable = r4 inter distance = _channelNumber true
+                ap_uint<64> ba = blkAAD[c];
+                ap_uint<64> bt = blkText[c];
+                if (r < ba + bt + 2) {
+                    // one keystream block and one absorb per slot
+                    ap_uint<32> counter = (r == 0) ? ap_uint<64>(0) : ap_uint<64>(r - ba);
+                    ap_uint<512> ks = chachaBlock(key[c], counter, nonce[c]);
+                    ap_uint<130> rPow[4];
+#pragma HLS array_partition variable = rPow complete
+                    rPow[0] = r1[c];
+                    rPow[1] = r2[c];
+                    rPow[2] = r3[c];
+                    rPow[3] = r4[c];
+                    ap_uint<512> data = 0;
+                    ap_uint<7> lenByte = 0;
+
+                    if (r == 0) {
+                        poly1305Powers(ks.range(255, 0), rPow);
+                        r1[c] = rPow[0];
+                        r2[c] = rPow[1];
+                        r3[c] = rPow[2];
+                        r4[c] = rPow[3];
+                        sKey[c] = ks.range(255, 128);
+                        acc[c] = 0;
+                    } else if (r <= ba) {
+                        ap_uint<64> off = (r - 1) << 4;
+                        lenByte = (lenAAD[c] - off > 16) ? ap_uint<64>(16) : ap_uint<64>(lenAAD[c] - off);
+                        data.range(127, 0) = AADStrm.read();
+                        data = maskTail(data, lenByte);
+                    } else if (r <= ba + bt) {
+                        ap_uint<64> off = (r - 1 - ba) << 6;
+                        lenByte = (len[c] - off > 64) ? ap_uint<64>(64) : ap_uint<64>(len[c] - off);
+                        ap_uint<512> in = maskTail(inStrm.read(), lenByte);
+                        ap_uint<512> out = maskTail(in ^ ks, lenByte);
+                        outStrm.write(out);
+                        data = _encrypt ? out : in;
+                    } else {
+                        lenByte = 16;
+                        data.range(63, 0) = lenAAD[c];
+                        data.range(127, 64) = len[c];
+                    }
+
+                    if (r != 0) {
+                        ap_uint<130> a = poly1305Absorb(acc[c], data, lenByte, rPow);
+                        acc[c] = a;
+                        tag[c] = a.range(127, 0) + sKey[c];
+                    }
+                }
+            }
+        }
+
+    loop_Tag:
+        for (unsigned int c = 0; c < _channelNumber; c++) {
+#pragma HLS pipeline II = 1
+            tagStrm.write(tag[c]);
+        }
+    }
+}
+
+} // end of namespace internal
+
+/**
+ * @brief chacha20Poly1305Encrypt is the AEAD encryption of RFC 8439.
+ *
+ * ChaCha20 generates the keystream and Poly1305 takes the ciphertext in a dataflow region, so each message is read
+ * only once. The one-time Poly1305 key and the padding of AAD and ciphertext are handled inside.
+ * The cipher part takes one 512-bit block per cycle, and so does the MAC part with 8 interleaved accumulators.
+ *
+ * @param keyStrm The 256-bit key, byte i at bit 8i.
+ * @param nonceStrm The 96-bit nonce, byte i at bit 8i.
+ * @param AADStrm Additional authenticated data, 128 bits per block.
+ * @param lenAADStrm Length of AAD in bytes.
+ * @param payloadStrm The plaintext, 512 bits per block.
+ * @param lenPldStrm Length of plaintext in bytes.
+ * @param endLenStrm Flag to signal the end of the length streams, false before each message and true to end.
+ * @param cipherStrm The ciphertext, 512 bits per block, zero beyond the length.
+ * @param lenCphStrm Length of ciphertext in bytes.
+ * @param tagStrm The MAC stream.
+ * @param endTagStrm Flag to signal the end of the MAC stream.
+ */
+static void chacha20Poly1305Encrypt(hls::stream<ap_uint<256> >& keyStrm,
+                                    hls::stream<ap_uint<96> >& nonceStrm,
+                                    hls::stream<ap_uint<128> >& AADStrm,
+                                    hls::stream<ap_uint<64> >& lenAADStrm,
+                                    hls::stream<ap_uint<512> >& payloadStrm,
+                                    hls::stream<ap_uint<64> >& lenPldStrm,
+                                    hls::stream<bool>& endLenStrm,
+                                    hls::stream<ap_uint<512> >& cipherStrm,
+                                    hls::stream<ap_uint<64> >& lenCphStrm,
+                                    hls::stream<ap_uint<128> >& tagStrm,
+                                    hls::stream<bool>& endTagStrm) {
+    internal::chacha20Poly1305Imp<true>(keyStrm, nonceStrm, AADStrm, lenAADStrm, payloadStrm, lenPldStrm, endLenStrm,
+                                        cipherStrm, lenCphStrm, tagStrm, endTagStrm);
+}
+
+/**
+ * @brief chacha20Poly1305Decrypt is the AEAD decryption of RFC 8439.
+ *
+ * The tag is computed over the received ciphertext, it should be compared with the received tag by the caller.
+ *
+ * @param keyStrm The 256-bit key, byte i at bit 8i.
+ * @param nonceStrm The 96-bit nonce, byte i at bit 8i.
+ * @param AADStrm Additional authenticated data, 128 bits per block.
+ * @param lenAADStrm Length of AAD in bytes.
+ * @param cipherStrm The ciphertext, 512 bits per block.
+ * @param lenCphStrm Length of ciphertext in bytes.
+ * @param endLenStrm Flag to signal the end of the length streams, false before each message and true to end.
+ * @param payloadStrm The plaintext, 512 bits per block, zero beyond the length.
+ * @param lenPldStrm Length of plaintext in bytes.
+ * @param tagStrm The MAC stream.
+ * @param endTagStrm Flag to signal the end of the MAC stream.
+ */
+static void chacha20Poly1305Decrypt(hls::stream<ap_uint<256> >& keyStrm,
+                                    hls::stream<ap_uint<96> >& nonceStrm,
+                                    hls::stream<ap_uint<128> >& AADStrm,
+                                    hls::stream<ap_uint<64> >& lenAADStrm,
+                                    hls::stream<ap_uint<512> >& cipherStrm,
+                                    hls::stream<ap_uint<64> >& lenCphStrm,
+                                    hls::stream<bool>& endLenStrm,
+                                    hls::stream<ap_uint<512> >& payloadStrm,
+                                    hls::stream<ap_uint<64> >& lenPldStrm,
+                                    hls::stream<ap_uint<128> >& tagStrm,
+                                    hls::stream<bool>& endTagStrm) {
+    internal::chacha20Poly1305Imp<false>(keyStrm, nonceStrm, AADStrm, lenAADStrm, cipherStrm, lenCphStrm, endLenStrm,
+                                         payloadStrm, lenPldStrm, tagStrm, endTagStrm);
+}
+
+/**
+ * @brief chacha20Poly1305EncryptMultiChan is the AEAD encryption of many messages with interleaved channels.
+ *
+ * _channelNumber messages form a batch. Their blocks go round-robin through one ChaCha20 core and one Poly1305
+ * absorber, so the accumulator of a message is needed again _channelNumber cycles later and both take a new block
+ * every cycle. In round r, channel c takes its AAD block r - 1 if 1 <= r <= AAD blocks, or its text block
+ * r - 1 - AAD blocks if that is within text blocks, otherwise nothing. The output blocks come in the same order.
+ *
+ * @tparam _channelNumber Number of messages in one batch, should be no less than the latency of the absorber.
+ * @param keyStrm The 256-bit key of each message.
+ * @param nonceStrm The 96-bit nonce of each message.
+ * @param lenAADStrm Length of AAD of each message in bytes.
+ * @param lenPldStrm Length of plaintext of each message in bytes.
+ * @param endLenStrm Flag to signal the end of the messages, false before each batch of _channelNumber messages.
+ * @param AADStrm AAD, 128 bits per block, in round-robin order.
+ * @param payloadStrm The plaintext, 512 bits per block, in round-robin order.
+ * @param cipherStrm The ciphertext, 512 bits per block, in round-robin order.
+ * @param tagStrm The MAC of each message, _channelNumber per batch.
+ */
+template <unsigned int _channelNumber>
+void chacha20Poly1305EncryptMultiChan(hls::stream<ap_uint<256> >& keyStrm,
+                                      hls::stream<ap_uint<96> >& nonceStrm,
+                                      hls::stream<ap_uint<64> >& lenAADStrm,
+                                      hls::stream<ap_uint<64> >& lenPldStrm,
+                                      hls::stream<bool>& endLenStrm,
+                                      hls::stream<ap_uint<128> >& AADStrm,
+                                      hls::stream<ap_uint<512> >& payloadStrm,
+                                      hls::stream<ap_uint<512> >& cipherStrm,
+                                      hls::stream<ap_uint<128> >& tagStrm) {
+    internal::chacha20Poly1305MultiChanImp<_channelNumber, true>(keyStrm, nonceStrm, lenAADStrm, lenPldStrm,
+                                                                 endLenStrm, AADStrm, payloadStrm, cipherStrm, tagStrm);
+}
+
+/**
+ * @brief chacha20Poly1305DecryptMultiChan is the AEAD decryption of many messages with interleaved channels.
+ *
+ * The scheduling is the same as chacha20Poly1305EncryptMultiChan, the tags are computed over the received
+ * ciphertext and should be compared with the received tags by the caller.
+ *
+ * @tparam _channelNumber Number of messages in one batch, should be no less than the latency of the absorber.
+ * @param keyStrm The 256-bit key of each message.
+ * @param nonceStrm The 96-bit nonce of each message.
+ * @param lenAADStrm Length of AAD of each message in bytes.
+ * @param lenCphStrm Length of ciphertext of each message in bytes.
+ * @param endLenStrm Flag to signal the end of the messages, false before each batch of _channelNumber messages.
+ * @param AADStrm AAD, 128 bits per block, in round-robin order.
+ * @param cipherStrm The ciphertext, 512 bits per block, in round-robin order.
+ * @param payloadStrm The plaintext, 512 bits per block, in round-robin order.
+ * @param tagStrm The MAC of each message, _channelNumber per batch.
+ */
+template <unsigned int _channelNumber>
+void chacha20Poly1305DecryptMultiChan(hls::stream<ap_uint<256> >& keyStrm,
+                                      hls::stream<ap_uint<96> >& nonceStrm,
+                                      hls::stream<ap_uint<64> >& lenAADStrm,
+                                      hls::stream<ap_uint<64> >& lenCphStrm,
+                                      hls::stream<bool>& endLenStrm,
+                                      hls::stream<ap_uint<128> >& AADStrm,
+                                      hls::stream<ap_uint<512> >& cipherStrm,
+                                      hls::stream<ap_uint<512> >& payloadStrm,
+                                      hls::stream<ap_uint<128> >& tagStrm) {
+    internal::chacha20Poly1305MultiChanImp<_channelNumber, false>(keyStrm, nonceStrm, lenAADStrm, lenCphStrm,
+                                                                  endLenStrm, AADStrm, cipherStrm, payloadStrm,
+                                                                  tagStrm);
+}
+
+} // end of namespace security
+} // end of namespace xf
+#endif // _XF_SECURITY_CHACHA20_POLY1305_HPP_
@@ -0,0 +1,566 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file ecdsa_p256.hpp
+ * @brief header file for ECDSA signature verification over the NIST P-256 curve.
+ * This file is part of Vitis Security Library.
+ *
+ * @detail Points are kept in Jacobian coordinates (X, Y, Z) for x = X / Z^2 and y = Y / Z^3, the point at infinity
+ * has Z = 0. Field elements are reduced with the fast reduction of FIPS 186-4 D.2, scalars modulo the group order
+ * with Barrett reduction.
+ */
+
+#ifndef _XF_SECURITY_ECDSA_P256_HPP_
+#define _XF_SECURITY_ECDSA_P256_HPP_
+
+#include <ap_int.h>
+#include <hls_stream.h>
+
+#include "modular.hpp"
+
+namespace xf {
+namespace security {
+namespace internal {
+
+/// @brief The field prime p = 2^256 - 2^224 + 2^192 + 2^96 - 1.
+static ap_uint<256> p256Prime() {
+    ap_uint<256> p;
+    p.range(255, 192) = 0xffffffff00000001;
+    p.range(191, 128) = 0x0000000000000000;
+    p.range(127, 64) = 0x00000000ffffffff;
+    p.range(63, 0) = 0xffffffffffffffff;
+    return p;
+}
+
+/// @brief The order n of the base point.
+static ap_uint<256> p256Order() {
+    ap_uint<256> n;
+    n.range(255, 192) = 0xffffffff00000000;
+    n.range(191, 128) = 0xffffffffffffffff;
+    n.range(127, 64) = 0xbce6faada7179e84;
+    n.range(63, 0) = 0xf3b9cac2fc632551;
+    return n;
+}
+
+/// @brief The Barrett constant floor(2^512 / n).
+static ap_uint<264> p256OrderMu() {
+    ap_uint<264> mu = 0;
+    mu.range(256, 256) = 0x1;
+    mu.range(255, 192) = 0x00000000ffffffff;
+    mu.range(191, 128) = 0xfffffffeffffffff;
+    mu.range(127, 64) = 0x43190552df1a6c21;
+    mu.range(63, 0) = 0x012ffd85eedf9bfe;
+    return mu;
+}
+
+/// @brief The curve coefficient b of y^2 = x^3 - 3x + b.
+static ap_uint<256> p256B() {
+    ap_uint<256> b;
+    b.range(255, 192) = 0x5ac635d8aa3a93e7;
+    b.range(191, 128) = 0xb3ebbd55769886bc;
+    b.range(127, 64) = 0x651d06b0cc53b0f6;
+    b.range(63, 0) = 0x3bce3c3e27d2604b;
+    return b;
+}
+
+/// @brief The x coordinate of the base point G.
+static ap_uint<256> p256Gx() {
+    ap_uint<256> x;
+    x.range(255, 192) = 0x6b17d1f2e12c4247;
+    x.range(191, 128) = 0xf8bce6e563a440f2;
+    x.range(127, 64) = 0x77037d812deb33a0;
+    x.range(63, 0) = 0xf4a13945d898c296;
+    return x;
+}
+
+/// @brief The y coordinate of the base point G.
+static ap_uint<256> p256Gy() {
+    ap_uint<256> y;
+    y.range(255, 192) = 0x4fe342e2fe1a7f9b;
+    y.range(191, 128) = 0x8ee7eb4a7c0f9e16;
+    y.range(127, 64) = 0x2bce33576b315ece;
+    y.range(63, 0) = 0xcbb6406837bf51f5;
+    return y;
+}
+
+static ap_uint<256> p256Pack(ap_uint<32> w7,
+                             ap_uint<32> w6,
+                             ap_uint<32> w5,
+                             ap_uint<32> w4,
+                             ap_uint<32> w3,
+                             ap_uint<32> w2,
+                             ap_uint<32> w1,
+                             ap_uint<32> w0) {
+#pragma HLS inline
+    ap_uint<256> r;
+    r.range(255, 224) = w7;
+    r.range(223, 192) = w6;
+    r.range(191, 160) = w5;
+    r.range(159, 128) = w4;
+    r.range(127, 96) = w3;
+    r.range(95, 64) = w2;
+    r.range(63, 32) = w1;
+    r.range(31, 0) = w0;
+    return r;
+}
+
+/**
+ *
+ * @brief The fast reduction modulo p, the result is c mod p.
+ * The 512-bit number is split into sixteen 32-bit words and folded into nine 256-bit terms, which only need additions
+ * and subtractions.
+ *
+ * @param c The number to reduce, less than p^2.
+ * @return The reduced result.
+ */
+static ap_uint<256> p256Reduce(ap_uint<512> c) {
+#pragma HLS inline off
+    ap_uint<32> w[16];
+#pragma HLS array_partition variable = w complete
+    for (int i = 0; i < 16; i++) {
+#pragma HLS unroll
+        w[i] = c.range(32 * i + 31, 32 * i);
+    }
+    ap_uint<256> s1 = c.range(255, 0);
+    ap_uint<256> s2 = p256Pack(w[15], w[14], w[13], w[12], w[11], 0, 0, 0);
+    ap_uint<256> s3 = p256Pack(0, w[15], w[14], w[13], w[12], 0, 0, 0);
+    ap_uint<256> s4 = p256Pack(w[15], w[14], 0, 0, 0, w[10], w[9], w[8]);
+    ap_uint<256> s5 = p256Pack(w[8], w[13], w[15], w[14], w[13], w[11], w[10], w[9]);
+    ap_uint<256> s6 = p256Pack(w[10], w[8], 0, 0, 0, w[13], w[12], w[11]);
+    ap_uint<256> s7 = p256Pack(w[11], w[9], 0, 0, w[15], w[14], w[13], w[12]);
+    ap_uint<256> s8 = p256Pack(w[12], 0, w[10], w[9], w[8], w[15], w[14], w[13]);
+    ap_uint<256> s9 = p256Pack(w[13], 0, w[11], w[10], w[9], 0, w[15], w[14]);
+
+    ap_uint<256> p = p256Prime();
+    // 5p is larger than the negative terms, so t never goes below 0 and stays less than 12 * 2^256
+    ap_uint<260> p5 = p;
+    p5 = (p5 << 2) + p;
+    ap_uint<260> t = s1;
+    t += s2;
+    t += s2;
+    t += s3;
+    t += s3;
+    t += s4;
+    t += s5;
+    t += p5;
+    t -= s6;
+    t -= s7;
+    t -= s8;
+    t -= s9;
+
+    // t - q * p is less than 2p for q = floor(t / 2^256)
+    ap_uint<4> q = t.range(259, 256);
+    t -= q * p;
+    if (t >= p) {
+        t -= p;
+    }
+    return t.range(255, 0);
+}
+
+static ap_uint<256> p256Add(ap_uint<256> a, ap_uint<256> b) {
+#pragma HLS inline
+    return addMod<256>(a, b, p256Prime());
+}
+
+static ap_uint<256> p256Sub(ap_uint<256> a, ap_uint<256> b) {
+#pragma HLS inline
+    return subMod<256>(a, b, p256Prime());
+}
+
+static ap_uint<256> p256Mul(ap_uint<256> a, ap_uint<256> b) {
+#pragma HLS inline
+    ap_uint<512> prod = a * b;
+    return p256Reduce(prod);
+}
+
+/**
+ *
+ * @brief Point doubling in Jacobian coordinates for a = -3, the result is 2 * P1.
+ * The point at infinity doubles to itself.
+ *
+ * @param X1 X coordinate of P1.
+ * @param Y1 Y coordinate of P1.
+ * @param Z1 Z coordinate of P1.
+ * @param X3 X coordinate of the result.
+ * @param Y3 Y coordinate of the result.
+ * @param Z3 Z coordinate of the result.
+ */
+static void p256PointDouble(ap_uint<256> X1,
+                            ap_uint<256> Y1,
+                            ap_uint<256> Z1,
+                            ap_uint<256>& X3,
+                            ap_uint<256>& Y3,
+                            ap_uint<256>& Z3) {
+#pragma HLS inline
+    ap_uint<256> delta = p256Mul(Z1, Z1);
+    ap_uint<256> gamma = p256Mul(Y1, Y1);
+    ap_uint<256> beta = p256Mul(X1, gamma);
+    ap_uint<256> alpha = p256Mul(p256Sub(X1, delta), p256Add(X1, delta));
+    alpha = p256Add(alpha, p256Add(alpha, alpha));
+    ap_uint<256> beta2 = p256Add(beta, beta);
+    ap_uint<256> beta4 = p256Add(beta2, beta2);
+    ap_uint<256> beta8 = p256Add(beta4, beta4);
+    ap_uint<256> x = p256Sub(p256Mul(alpha, alpha), beta8);
+    ap_uint<256> yz = p256Add(Y1, Z1);
+    ap_uint<256> z = p256Sub(p256Sub(p256Mul(yz, yz), gamma), delta);
+    ap_uint<256> gamma2 = p256Mul(gamma, gamma);
+    gamma2 = p256Add(gamma2, gamma2);
+    gamma2 = p256Add(gamma2, gamma2);
+    gamma2 = p256Add(gamma2, gamma2);
+    ap_uint<256> y = p256Sub(p256Mul(alpha, p256Sub(beta4, x)), gamma2);
+    X3 = x;
+    Y3 = y;
+    Z3 = z;
+}
+
+/**
+ *
+ * @brief Point addition in Jacobian coordinates, the result is P1 + P2.
+ * Either point can be the point at infinity, and P1 == P2 falls back to doubling.
+ *
+ * @param X1 X coordinate of P1.
+ * @param Y1 Y coordinate of P1.
+ * @param Z1 Z coordinate of P1.
+ * @param X2 X coordinate of P2.
+ * @param Y2 Y coordinate of P2.
+ * @param Z2 Z coordinate of P2.
+ * @param X3 X coordinate of the result.
+ * @param Y3 Y coordinate of the result.
+ * @param Z3 Z coordinate of the result.
+ */
+static void p256PointAdd(ap_uint<256> X1,
+                         ap_uint<256> Y1,
+                         ap_uint<256> Z1,
+                         ap_uint<256> X2,
+                         ap_uint<256> Y2,
+                         ap_uint<256> Z2,
+                         ap_uint<256>& X3,
+                         ap_uint<256>& Y3,
+                         ap_uint<256>& Z3) {
+#pragma HLS inline
+    ap_uint<256> z1z1 = p256Mul(Z1, Z1);
+    ap_uint<256> z2z2 = p256Mul(Z2, Z2);
+    ap_uint<256> u1 = p256Mul(X1, z2z2);
+    ap_uint<256> u2 = p256Mul(X2, z1z1);
+    ap_uint<256> s1 = p256Mul(Y1, p256Mul(Z2, z2z2));
+    ap_uint<256> s2 = p256Mul(Y2, p256Mul(Z1, z1z1));
+    ap_uint<256> h = p256Sub(u2, u1);
+    ap_uint<256> r = p256Sub(s2, s1);
+    r = p256Add(r, r);
+    ap_uint<256> h2 = p256Add(h, h);
+    ap_uint<256> i = p256Mul(h2, h2);
+    ap_uint<256> j = p256Mul(h, i);
+    ap_uint<256> v = p256Mul(u1, i);
+    ap_uint<256> x = p256Sub(p256Sub(p256Mul(r, r), j), p256Add(v, v));
+    ap_uint<256> s1j = p256Mul(s1, j);
+    ap_uint<256> y = p256Sub(p256Mul(r, p256Sub(v, x)), p256Add(s1j, s1j));
+    ap_uint<256> zz = p256Add(Z1, Z2);
+    ap_uint<256> z = p256Mul(p256Sub(p256Sub(p256Mul(zz, zz), z1z1), z2z2), h);
+
+    // h == 0 with r != 0 means P1 == -P2, and z is already 0 for the point at infinity
+    ap_uint<256> dx, dy, dz;
+    p256PointDouble(X1, Y1, Z1, dx, dy, dz);
+    if (Z1 == 0) {
+        X3 = X2;
+        Y3 = Y2;
+        Z3 = Z2;
+    } else if (Z2 == 0) {
+        X3 = X1;
+        Y3 = Y1;
+        Z3 = Z1;
+    } else if (h == 0 && r == 0) {
+        X3 = dx;
+        Y3 = dy;
+        Z3 = dz;
+    } else {
+        X3 = x;
+        Y3 = y;
+        Z3 = z;
+    }
+}
+
+/**
+ *
+ * @brief Check the public key is an affine point on the curve, y^2 = x^3 - 3x + b.
+ *
+ * @param x X coordinate.
+ * @param y Y coordinate.
+ * @return True if the point is on the curve.
+ */
+static bool p256OnCurve(ap_uint<256> x, ap_uint<256> y) {
+#pragma HLS inline
+    ap_uint<256> p = p256Prime();
+    ap_uint<256> x3 = p256Mul(p256Mul(x, x), x);
+    ap_uint<256> x3b = p256Add(x3, p256B());
+    ap_uint<256> rhs = p256Sub(x3b, p256Add(x, p256Add(x, x)));
+    return x < p && y < p && p256Mul(y, y) == rhs;
+}
+
+/**
+ *
+ * @brief Check the range of the signature and the public key before the scalar multiplication.
+ *
+ * @param r The r half of the signature.
+ * @param s The s half of the signature.
+ * @param qx X coordinate of the public key.
+ * @param qy Y coordinate of the public key.
+ * @return True if 0 < r, s < n and the public key is on the curve.
+ */
+static bool p256CheckInput(ap_uint<256> r, ap_uint<256> s, ap_uint<256> qx, ap_uint<256> qy) {
+#pragma HLS inline
+    ap_uint<256> n = p256Order();
+    return r != 0 && r < n && s != 0 && s < n && p256OnCurve(qx, qy);
+}
+
+/**
+ *
+ * @brief One step of the dual scalar multiplication u1 * G + u2 * Q with Shamir's trick: the accumulator is doubled,
+ * then G, Q or G + Q is added according to one bit of each scalar.
+ *
+ * @param X X coordinate of the accumulator.
+ * @param Y Y coordinate of the accumulator.
+ * @param Z Z coordinate of the accumulator.
+ * @param bit1 Current bit of u1.
+ * @param bit2 Current bit of u2.
+ * @param qx X coordinate of Q.
+ * @param qy Y coordinate of Q.
+ * @param gqX X coordinate of G + Q.
+ * @param gqY Y coordinate of G + Q.
+ * @param gqZ Z coordinate of G + Q.
+ */
+static void p256ShamirStep(ap_uint<256>& X,
+                           ap_uint<256>& Y,
+                           ap_uint<256>& Z,
+                           bool bit1,
+                           bool bit2,
+                           ap_uint<256> qx,
+                           ap_uint<256> qy,
+                           ap_uint<256> gqX,
+                           ap_uint<256> gqY,
+                           ap_uint<256> gqZ) {
+#pragma HLS inline
+    ap_uint<256> dx, dy, dz;
+    p256PointDouble(X, Y, Z, dx, dy, dz);
+    ap_uint<256> tx, ty, tz;
+    if (bit1 && bit2) {
+        tx = gqX;
+        ty = gqY;
+        tz = gqZ;
+    } else if (bit1) {
+        tx = p256Gx();
+        ty = p256Gy();
+        tz = 1;
+    } else {
+        tx = qx;
+        ty = qy;
+        tz = 1;
+    }
+    ap_uint<256> ax, ay, az;
+    p256PointAdd(dx, dy, dz, tx, ty, tz, ax, ay, az);
+    if (bit1 || bit2) {
+        X = ax;
+        Y = ay;
+        Z = az;
+    } else {
+        X = dx;
+        Y = dy;
+        Z = dz;
+    }
+}
+
+/**
+ *
+ * @brief Final check of the verification, the affine x coordinate of the result must be congruent to r mod n.
+ * Since p < 2n, x is either r or r + n, which is compared as X == x * Z^2 without a field inversion.
+ *
+ * @param X X coordinate of u1 * G + u2 * Q.
+ * @param Z Z coordinate of u1 * G + u2 * Q.
+ * @param r The r half of the signature.
+ * @return True if the signature is valid.
+ */
+static bool p256CheckResult(ap_uint<256> X, ap_uint<256> Z, ap_uint<256> r) {
+#pragma HLS inline
+    ap_uint<256> z2 = p256Mul(Z, Z);
+    ap_uint<257> rn = r + p256Order();
+    bool match = (X == p256Mul(r, z2));
+    if (rn < p256Prime()) {
+        match = match || (X == p256Mul(rn.range(255, 0), z2));
+    }
+    return Z != 0 && match;
+}
+
+} // end of namespace internal
+
+/**
+ *
+ * @brief Verify one ECDSA signature over the P-256 curve.
+ *
+ * @param hash The message hash as a big-endian integer, the leftmost 256 bits of the digest.
+ * @param signature The signature, r in the lower 256 bits and s in the upper 256 bits.
+ * @param pubKey The public key, x in the lower 256 bits and y in the upper 256 bits.
+ * @return True if the signature is valid.
+ */
+static bool ecdsaP256Verify(ap_uint<256> hash, ap_uint<512> signature, ap_uint<512> pubKey) {
+    ap_uint<256> n = internal::p256Order();
+    ap_uint<264> mu = internal::p256OrderMu();
+    ap_uint<256> r = signature.range(255, 0);
+    ap_uint<256> s = signature.range(511, 256);
+    ap_uint<256> qx = pubKey.range(255, 0);
+    ap_uint<256> qy = pubKey.range(511, 256);
+    bool valid = internal::p256CheckInput(r, s, qx, qy);
+    if (!valid) {
+        s = 1;
+    }
+
+    ap_uint<256> e = hash;
+    if (e >= n) {
+        e -= n;
+    }
+    ap_uint<256> w = internal::modularInv<256>(s, n, mu);
+    ap_uint<256> u1 = internal::productMod<256>(e, w, n, mu);
+    ap_uint<256> u2 = internal::productMod<256>(r, w, n, mu);
+
+    ap_uint<256> gqX, gqY, gqZ;
+    internal::p256PointAdd(internal::p256Gx(), internal::p256Gy(), 1, qx, qy, 1, gqX, gqY, gqZ);
+    ap_uint<256> X = 0, Y = 1, Z = 0;
+loop_Shamir:
+    for (int i = 255; i >= 0; i--) {
+        internal::p256ShamirStep(X, Y, Z, u1[i], u2[i], qx, qy, gqX, gqY, gqZ);
+    }
+    return valid && internal::p256CheckResult(X, Z, r);
+}
+
+/**
+ *
+ * @brief Verify ECDSA signatures over the P-256 curve, N independent verifications at a time.
+ * The verifications of a batch are interleaved in every loop, so the long dependency chain of each one is hidden by
+ * the others and the pipelines of the field arithmetic stay busy.
+ *
+ * @tparam N Channel number, the number of verifications in a batch.
+ * @param hashStrm The message hash as a big-endian integer, the leftmost 256 bits of the digest.
+ * @param sigStrm The signature, r in the lower 256 bits and s in the upper 256 bits.
+ * @param pubKeyStrm The public key, x in the lower 256 bits and y in the upper 256 bits.
+ * @param endInStrm Flag to signal the end of the input streams, false before each batch of N signatures.
+ * @param resultStrm True for each valid signature, N results per batch.
+ */
+template <int N>
+void ecdsaP256VerifyMultiChan(
+    // stream in
+    hls::stream<ap_uint<256> >& hashStrm,
+    hls::stream<ap_uint<512> >& sigStrm,
+    hls::stream<ap_uint<512> >& pubKeyStrm,
+    hls::stream<bool>& endInStrm,
+    // stream out
+    hls::stream<bool>& resultStrm) {
+    const ap_uint<256> n = internal::p256Order();
+    const ap_uint<264> mu = internal::p256OrderMu();
+    const ap_uint<256> nm2 = n - 2;
+loop_Batch:
+    while (!endInStrm.read()) {
+#pragma HLS loop_tripcount max = 10 min = 10
+        ap_uint<256> e[N], r[N], s[N], w[N], u1[N], u2[N];
+        ap_uint<256> qx[N], qy[N], gqX[N], gqY[N], gqZ[N];
+        ap_uint<256> X[N], Y[N], Z[N];
+        bool valid[N];
+#pragma HLS resource variable = e core = RAM_2P_LUTRAM
+#pragma HLS resource variable = r core = RAM_2P_LUTRAM
+#pragma HLS resource variable = s core = RAM_2P_LUTRAM
+#pragma HLS resource variable = w core = RAM_2P_LUTRAM
+#pragma HLS resource variable = u1 core = RAM_2P_LUTRAM
+#pragma HLS resource variable = u2 core = RAM_2P_LUTRAM
+#pragma HLS resource variable = qx core = RAM_2P_LUTRAM
+#pragma HLS resource variable = qy core = RAM_2P_LUTRAM
+#pragma HLS resource variable = gqX core = RAM_2P_LUTRAM
+#pragma HLS resource variable = gqY core = RAM_2P_LUTRAM
+#pragma HLS resource variable = gqZ core = RAM_2P_LUTRAM
+#pragma HLS resource variable = X core = RAM_2P_LUTRAM
+#pragma HLS resource variable = Y core = RAM_2P_LUTRAM
+#pragma HLS resource variable = Z core = RAM_2P_LUTRAM
+    loop_Load:
+        for (int i = 0; i < N; i++) {
+#pragma HLS pipeline
+            ap_uint<256> hash = hashStrm.read();
+            ap_uint<512> sig = sigStrm.read();
+            ap_uint<512> key = pubKeyStrm.read();
+            r[i] = sig.range(255, 0);
+            ap_uint<256> si = sig.range(511, 256);
+            qx[i] = key.range(255, 0);
+            qy[i] = key.range(511, 256);
+            valid[i] = internal::p256CheckInput(r[i], si, qx[i], qy[i]);
+            s[i] = valid[i] ? si : ap_uint<256>(1);
+            e[i] = (hash >= n) ? ap_uint<256>(hash - n) : hash;
+            w[i] = 1;
+        }
+
+    // w = s^(n - 2) mod n, one bit of the exponent for every channel per round
+    loop_Inv:
+        for (int k = 255; k >= 0; k--) {
+        loop_InvChan:
+            for (int i = 0; i < N; i++) {
+#pragma HLS pipeline
+#pragma HLS dependence variable = w inter distance = N true
+                ap_uint<256> t = internal::productMod<256>(w[i], w[i], n, mu);
+                if (nm2[k] == 1) {
+                    t = internal::productMod<256>(t, s[i], n, mu);
+                }
+                w[i] = t;
+            }
+        }
+
+    loop_Prepare:
+        for (int i = 0; i < N; i++) {
+#pragma HLS pipeline
+            u1[i] = internal::productMod<256>(e[i], w[i], n, mu);
+            u2[i] = internal::productMod<256>(r[i], w[i], n, mu);
+            ap_uint<256> tx, ty, tz;
+            internal::p256PointAdd(internal::p256Gx(), internal::p256Gy(), 1, qx[i], qy[i], 1, tx, ty, tz);
+            gqX[i] = tx;
+            gqY[i] = ty;
+            gqZ[i] = tz;
+            X[i] = 0;
+            Y[i] = 1;
+            Z[i] = 0;
+        }
+
+    loop_Shamir:
+        for (int k = 255; k >= 0; k--) {
+        loop_ShamirChan:
+            for (int i = 0; i < N; i++) {
+#pragma HLS pipeline
+#pragma HLS dependence variable = X inter distance = N true
+#pragma HLS dependence variable = Y inter distance = N true
+#pragma HLS dependence variable = Z inter distance = N true
+                ap_uint<256> x = X[i], y = Y[i], z = Z[i];
+                internal::p256ShamirStep(x, y, z, u1[i][k], u2[i][k], qx[i], qy[i], gqX[i], gqY[i], gqZ[i]);
+                X[i] = x;
+                Y[i] = y;
+                Z[i] = z;
+            }
+        }
+
+    loop_Check:
+        for (int i = 0; i < N; i++) {
+#pragma HLS pipeline
+            resultStrm.write(valid[i] && internal::p256CheckResult(X[i], Z[i], r[i]));
+        }
+    }
+}
+
+} // end of namespace security
+} // end of namespace xf
+
+#endif // _XF_SECURITY_ECDSA_P256_HPP_
@@ -0,0 +1,620 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file ed25519.hpp
+ * @brief header file for Ed25519 signature verification.
+ * This file is part of Vitis Security Library.
+ *
+ * @detail Points of the twisted Edwards curve -x^2 + y^2 = 1 + d x^2 y^2 are kept in extended coordinates
+ * (X, Y, Z, T) for x = X / Z, y = Y / Z and x * y = T / Z. The addition formula is complete, so the identity and
+ * doubling need no special case. Field elements are reduced modulo 2^255 - 19 by folding, scalars modulo the group
+ * order with Barrett reduction. Encodings follow RFC 8032, byte i of a little-endian string is bits 8i+7..8i.
+ */
+
+#ifndef _XF_SECURITY_ED25519_HPP_
+#define _XF_SECURITY_ED25519_HPP_
+
+#include <ap_int.h>
+#include <hls_stream.h>
+
+#include "modular.hpp"
+
+namespace xf {
+namespace security {
+namespace internal {
+
+/// @brief The field prime p = 2^255 - 19.
+static ap_uint<256> p25519Prime() {
+    ap_uint<256> p;
+    p.range(255, 192) = 0x7fffffffffffffff;
+    p.range(191, 128) = 0xffffffffffffffff;
+    p.range(127, 64) = 0xffffffffffffffff;
+    p.range(63, 0) = 0xffffffffffffffed;
+    return p;
+}
+
+/// @brief The order L = 2^252 + 27742317777372353535851937790883648493 of the base point.
+static ap_uint<256> ed25519Order() {
+    ap_uint<256> l;
+    l.range(255, 192) = 0x1000000000000000;
+    l.range(191, 128) = 0x0000000000000000;
+    l.range(127, 64) = 0x14def9dea2f79cd6;
+    l.range(63, 0) = 0x5812631a5cf5d3ed;
+    return l;
+}
+
+/// @brief The Barrett constant floor(2^512 / L).
+static ap_uint<264> ed25519OrderMu() {
+    ap_uint<264> mu = 0;
+    mu.range(259, 256) = 0xf;
+    mu.range(255, 192) = 0xffffffffffffffff;
+    mu.range(191, 128) = 0xffffffffffffffeb;
+    mu.range(127, 64) = 0x2106215d086329a7;
+    mu.range(63, 0) = 0xed9ce5a30a2c131b;
+    return mu;
+}
+
+/// @brief The curve constant 2d, for d = -121665 / 121666.
+static ap_uint<256> ed25519D2() {
+    ap_uint<256> d2;
+    d2.range(255, 192) = 0x2406d9dc56dffce7;
+    d2.range(191, 128) = 0x198e80f2eef3d130;
+    d2.range(127, 64) = 0x00e0149a8283b156;
+    d2.range(63, 0) = 0xebd69b9426b2f159;
+    return d2;
+}
+
+/// @brief The curve constant d = -121665 / 121666.
+static ap_uint<256> ed25519D() {
+    ap_uint<256> d;
+    d.range(255, 192) = 0x52036cee2b6ffe73;
+    d.range(191, 128) = 0x8cc740797779e898;
+    d.range(127, 64) = 0x00700a4d4141d8ab;
+    d.range(63, 0) = 0x75eb4dca135978a3;
+    return d;
+}
+
+/// @brief A square root of -1, 2^((p - 1) / 4).
+static ap_uint<256> p25519SqrtM1() {
+    ap_uint<256> s;
+    s.range(255, 192) = 0x2b8324804fc1df0b;
+    s.range(191, 128) = 0x2b4d00993dfbd7a7;
+    s.range(127, 64) = 0x2f431806ad2fe478;
+    s.range(63, 0) = 0xc4ee1b274a0ea0b0;
+    return s;
+}
+
+/// @brief The x coordinate of the base point B.
+static ap_uint<256> ed25519Bx() {
+    ap_uint<256> x;
+    x.range(255, 192) = 0x216936d3cd6e53fe;
+    x.range(191, 128) = 0xc0a4e231fdd6dc5c;
+    x.range(127, 64) = 0x692cc7609525a7b2;
+    x.range(63, 0) = 0xc9562d608f25d51a;
+    return x;
+}
+
+/// @brief The y coordinate of the base point B, 4 / 5.
+static ap_uint<256> ed25519By() {
+    ap_uint<256> y;
+    y.range(255, 192) = 0x6666666666666666;
+    y.range(191, 128) = 0x6666666666666666;
+    y.range(127, 64) = 0x6666666666666666;
+    y.range(63, 0) = 0x6666666666666658;
+    return y;
+}
+
+/// @brief The T coordinate x * y of the base point B.
+static ap_uint<256> ed25519Bt() {
+    ap_uint<256> t;
+    t.range(255, 192) = 0x67875f0fd78b7665;
+    t.range(191, 128) = 0x66ea4e8e64abe37d;
+    t.range(127, 64) = 0x20f09f80775152f5;
+    t.range(63, 0) = 0x6dde8ab3a5b7dda3;
+    return t;
+}
+
+/**
+ *
+ * @brief The reduction modulo p, the result is c mod p.
+ * As 2^256 = 38 mod p, the upper half is folded into the lower half with a small multiplication, twice.
+ *
+ * @param c The number to reduce.
+ * @return The reduced result.
+ */
+static ap_uint<256> p25519Reduce(ap_uint<512> c) {
+#pragma HLS inline off
+    ap_uint<256> hi = c.range(511, 256);
+    ap_uint<263> t = c.range(255, 0);
+    t += hi * 38;
+    ap_uint<8> top = t.range(262, 255);
+    ap_uint<256> r = t.range(254, 0);
+    r += top * 19;
+    if (r >= p25519Prime()) {
+        r -= p25519Prime();
+    }
+    return r;
+}
+
+static ap_uint<256> p25519Add(ap_uint<256> a, ap_uint<256> b) {
+#pragma HLS inline
+    return addMod<256>(a, b, p25519Prime());
+}
+
+static ap_uint<256> p25519Sub(ap_uint<256> a, ap_uint<256> b) {
+#pragma HLS inline
+    return subMod<256>(a, b, p25519Prime());
+}
+
+static ap_uint<256> p25519Mul(ap_uint<256> a, ap_uint<256> b) {
+#pragma HLS inline
+    ap_uint<512> prod = a * b;
+    return p25519Reduce(prod);
+}
+
+/**
+ *
+ * @brief One step of a left-to-right exponentiation, acc = acc^2 * base^bit.
+ *
+ * @param acc The accumulator.
+ * @param base The base of the exponentiation.
+ * @param bit Current bit of the exponent.
+ */
+static void p25519PowStep(ap_uint<256>& acc, ap_uint<256> base, bool bit) {
+#pragma HLS inline
+    ap_uint<256> t = p25519Mul(acc, acc);
+    if (bit) {
+        t = p25519Mul(t, base);
+    }
+    acc = t;
+}
+
+/**
+ *
+ * @brief Point addition in extended coordinates, the result is P1 + P2.
+ *
+ * @param X1 X coordinate of P1.
+ * @param Y1 Y coordinate of P1.
+ * @param Z1 Z coordinate of P1.
+ * @param T1 T coordinate of P1.
+ * @param X2 X coordinate of P2.
+ * @param Y2 Y coordinate of P2.
+ * @param Z2 Z coordinate of P2.
+ * @param T2 T coordinate of P2.
+ * @param X3 X coordinate of the result.
+ * @param Y3 Y coordinate of the result.
+ * @param Z3 Z coordinate of the result.
+ * @param T3 T coordinate of the result.
+ */
+static void ed25519PointAdd(ap_uint<256> X1,
+                            ap_uint<256> Y1,
+                            ap_uint<256> Z1,
+                            ap_uint<256> T1,
+                            ap_uint<256> X2,
+                            ap_uint<256> Y2,
+                            ap_uint<256> Z2,
+                            ap_uint<256> T2,
+                            ap_uint<256>& X3,
+                            ap_uint<256>& Y3,
+                            ap_uint<256>& Z3,
+                            ap_uint<256>& T3) {
+#pragma HLS inline
+    ap_uint<256> a = p25519Mul(p25519Sub(Y1, X1), p25519Sub(Y2, X2));
+    ap_uint<256> b = p25519Mul(p25519Add(Y1, X1), p25519Add(Y2, X2));
+    ap_uint<256> c = p25519Mul(p25519Mul(T1, ed25519D2()), T2);
+    ap_uint<256> d = p25519Mul(Z1, Z2);
+    d = p25519Add(d, d);
+    ap_uint<256> e = p25519Sub(b, a);
+    ap_uint<256> f = p25519Sub(d, c);
+    ap_uint<256> g = p25519Add(d, c);
+    ap_uint<256> h = p25519Add(b, a);
+    X3 = p25519Mul(e, f);
+    Y3 = p25519Mul(g, h);
+    Z3 = p25519Mul(f, g);
+    T3 = p25519Mul(e, h);
+}
+
+/**
+ *
+ * @brief Point doubling in extended coordinates, the result is 2 * P1.
+ *
+ * @param X1 X coordinate of P1.
+ * @param Y1 Y coordinate of P1.
+ * @param Z1 Z coordinate of P1.
+ * @param X3 X coordinate of the result.
+ * @param Y3 Y coordinate of the result.
+ * @param Z3 Z coordinate of the result.
+ * @param T3 T coordinate of the result.
+ */
+static void ed25519PointDouble(ap_uint<256> X1,
+                               ap_uint<256> Y1,
+                               ap_uint<256> Z1,
+                               ap_uint<256>& X3,
+                               ap_uint<256>& Y3,
+                               ap_uint<256>& Z3,
+                               ap_uint<256>& T3) {
+#pragma HLS inline
+    ap_uint<256> a = p25519Mul(X1, X1);
+    ap_uint<256> b = p25519Mul(Y1, Y1);
+    ap_uint<256> c = p25519Mul(Z1, Z1);
+    c = p25519Add(c, c);
+    ap_uint<256> xy = p25519Add(X1, Y1);
+    ap_uint<256> e = p25519Sub(p25519Sub(p25519Mul(xy, xy), a), b);
+    ap_uint<256> g = p25519Sub(b, a);
+    ap_uint<256> f = p25519Sub(g, c);
+    ap_uint<256> h = p25519Sub(0, p25519Add(a, b));
+    X3 = p25519Mul(e, f);
+    Y3 = p25519Mul(g, h);
+    Z3 = p25519Mul(f, g);
+    T3 = p25519Mul(e, h);
+}
+
+/**
+ *
+ * @brief First half of the point decoding: x^2 = u / v for u = y^2 - 1 and v = d y^2 + 1, and the candidate root is
+ * x = u v^3 (u v^7)^((p - 5) / 8). This prepares u, v, u v^3 and the base u v^7 of the exponentiation.
+ *
+ * @param y The y coordinate, less than p.
+ * @param u The numerator y^2 - 1.
+ * @param v The denominator d y^2 + 1.
+ * @param uv3 u v^3.
+ * @param uv7 u v^7.
+ */
+static void ed25519DecodeInit(
+    ap_uint<256> y, ap_uint<256>& u, ap_uint<256>& v, ap_uint<256>& uv3, ap_uint<256>& uv7) {
+#pragma HLS inline
+    ap_uint<256> y2 = p25519Mul(y, y);
+    u = p25519Sub(y2, 1);
+    v = p25519Add(p25519Mul(ed25519D(), y2), 1);
+    ap_uint<256> v2 = p25519Mul(v, v);
+    ap_uint<256> v3 = p25519Mul(v2, v);
+    uv3 = p25519Mul(u, v3);
+    uv7 = p25519Mul(uv3, p25519Mul(v2, v2));
+}
+
+/**
+ *
+ * @brief Second half of the point decoding, checks the candidate root and fixes its sign.
+ *
+ * @param sign The sign bit of x in the encoding.
+ * @param u The numerator y^2 - 1.
+ * @param v The denominator d y^2 + 1.
+ * @param uv3 u v^3.
+ * @param pw (u v^7)^((p - 5) / 8).
+ * @param x The decoded x coordinate.
+ * @return True if the point exists.
+ */
+static bool ed25519DecodeFinal(
+    bool sign, ap_uint<256> u, ap_uint<256> v, ap_uint<256> uv3, ap_uint<256> pw, ap_uint<256>& x) {
+#pragma HLS inline
+    ap_uint<256> r = p25519Mul(uv3, pw);
+    ap_uint<256> vr2 = p25519Mul(v, p25519Mul(r, r));
+    bool ok = true;
+    if (vr2 != u) {
+        if (vr2 == p25519Sub(0, u)) {
+            r = p25519Mul(r, p25519SqrtM1());
+        } else {
+            ok = false;
+        }
+    }
+    if (r == 0 && sign) {
+        ok = false;
+    }
+    if (r[0] != sign) {
+        r = p25519Sub(0, r);
+    }
+    x = r;
+    return ok;
+}
+
+/**
+ *
+ * @brief One step of the dual scalar multiplication S * B + h * (-A) with Shamir's trick: the accumulator is doubled,
+ * then B, -A or B - A is added according to one bit of each scalar.
+ *
+ * @param X X coordinate of the accumulator.
+ * @param Y Y coordinate of the accumulator.
+ * @param Z Z coordinate of the accumulator.
+ * @param T T coordinate of the accumulator.
+ * @param bit1 Current bit of S.
+ * @param bit2 Current bit of h.
+ * @param ax X coordinate of -A, its Z coordinate is 1.
+ * @param ay Y coordinate of -A.
+ * @param at T coordinate of -A.
+ * @param baX X coordinate of B - A.
+ * @param baY Y coordinate of B - A.
+ * @param baZ Z coordinate of B - A.
+ * @param baT T coordinate of B - A.
+ */
+static void ed25519ShamirStep(ap_uint<256>& X,
+                              ap_uint<256>& Y,
+                              ap_uint<256>& Z,
+                              ap_uint<256>& T,
+                              bool bit1,
+                              bool bit2,
+                              ap_uint<256> ax,
+                              ap_uint<256> ay,
+                              ap_uint<256> at,
+                              ap_uint<256> baX,
+                              ap_uint<256> baY,
+                              ap_uint<256> baZ,
+                              ap_uint<256> baT) {
+#pragma HLS inline
+    ap_uint<256> dx, dy, dz, dt;
+    ed25519PointDouble(X, Y, Z, dx, dy, dz, dt);
+    ap_uint<256> tx, ty, tz, tt;
+    if (bit1 && bit2) {
+        tx = baX;
+        ty = baY;
+        tz = baZ;
+        tt = baT;
+    } else if (bit1) {
+        tx = ed25519Bx();
+        ty = ed25519By();
+        tz = 1;
+        tt = ed25519Bt();
+    } else {
+        tx = ax;
+        ty = ay;
+        tz = 1;
+        tt = at;
+    }
+    ap_uint<256> sx, sy, sz, st;
+    ed25519PointAdd(dx, dy, dz, dt, tx, ty, tz, tt, sx, sy, sz, st);
+    if (bit1 || bit2) {
+        X = sx;
+        Y = sy;
+        Z = sz;
+        T = st;
+    } else {
+        X = dx;
+        Y = dy;
+        Z = dz;
+        T = dt;
+    }
+}
+
+/**
+ *
+ * @brief Final check of the verification, the encoding of the result must equal R.
+ *
+ * @param X X coordinate of S * B - h * A.
+ * @param Y Y coordinate of S * B - h * A.
+ * @param zInv The inverse of its Z coordinate.
+ * @param R The R half of the signature.
+ * @return True if the signature is valid.
+ */
+static bool ed25519CheckResult(ap_uint<256> X, ap_uint<256> Y, ap_uint<256> zInv, ap_uint<256> R) {
+#pragma HLS inline
+    ap_uint<256> x = p25519Mul(X, zInv);
+    ap_uint<256> enc = p25519Mul(Y, zInv);
+    enc[255] = x[0];
+    return enc == R;
+}
+
+} // end of namespace internal
+
+/**
+ *
+ * @brief Verify one Ed25519 signature, as specified in RFC 8032.
+ *
+ * @param digest The SHA-512 digest of R || A || M, byte i in bits 8i+7..8i as produced by sha512 in sha512_t.hpp.
+ * @param signature The 64-byte signature, R in the lower 256 bits and S in the upper 256 bits.
+ * @param pubKey The 32-byte public key A.
+ * @return True if the signature is valid.
+ */
+static bool ed25519Verify(ap_uint<512> digest, ap_uint<512> signature, ap_uint<256> pubKey) {
+    ap_uint<256> R = signature.range(255, 0);
+    ap_uint<256> S = signature.range(511, 256);
+    ap_uint<256> h = internal::barrettReduce<256>(digest, internal::ed25519Order(), internal::ed25519OrderMu());
+
+    // decode A
+    bool sign = pubKey[255];
+    ap_uint<256> y = pubKey;
+    y[255] = 0;
+    bool valid = (S < internal::ed25519Order()) && (y < internal::p25519Prime());
+    ap_uint<256> u, v, uv3, uv7;
+    internal::ed25519DecodeInit(y, u, v, uv3, uv7);
+    const ap_uint<256> e1 = (internal::p25519Prime() - 5) >> 3;
+    ap_uint<256> pw = 1;
+loop_Decode:
+    for (int k = 251; k >= 0; k--) {
+        internal::p25519PowStep(pw, uv7, e1[k]);
+    }
+    ap_uint<256> x;
+    valid = internal::ed25519DecodeFinal(sign, u, v, uv3, pw, x) && valid;
+
+    // -A and B - A
+    ap_uint<256> ax = internal::p25519Sub(0, x);
+    ap_uint<256> at = internal::p25519Mul(ax, y);
+    ap_uint<256> baX, baY, baZ, baT;
+    internal::ed25519PointAdd(internal::ed25519Bx(), internal::ed25519By(), 1, internal::ed25519Bt(), ax, y, 1, at,
+                              baX, baY, baZ, baT);
+
+    ap_uint<256> X = 0, Y = 1, Z = 1, T = 0;
+loop_Shamir:
+    for (int k = 252; k >= 0; k--) {
+        internal::ed25519ShamirStep(X, Y, Z, T, S[k], h[k], ax, y, at, baX, baY, baZ, baT);
+    }
+
+    const ap_uint<256> e2 = internal::p25519Prime() - 2;
+    ap_uint<256> zInv = 1;
+loop_Inv:
+    for (int k = 254; k >= 0; k--) {
+        internal::p25519PowStep(zInv, Z, e2[k]);
+    }
+    return valid && internal::ed25519CheckResult(X, Y, zInv, R);
+}
+
+/**
+ *
+ * @brief Verify Ed25519 signatures, N independent verifications at a time.
+ * The verifications of a batch are interleaved in every loop, so the long dependency chain of each one is hidden by
+ * the others and the pipelines of the field arithmetic stay busy.
+ *
+ * @tparam N Channel number, the number of verifications in a batch.
+ * @param digestStrm The SHA-512 digest of R || A || M, byte i in bits 8i+7..8i as produced by sha512 in sha512_t.hpp.
+ * @param sigStrm The 64-byte signature, R in the lower 256 bits and S in the upper 256 bits.
+ * @param pubKeyStrm The 32-byte public key A.
+ * @param endInStrm Flag to signal the end of the input streams, false before each batch of N signatures.
+ * @param resultStrm True for each valid signature, N results per batch.
+ */
+template <int N>
+void ed25519VerifyMultiChan(
+    // stream in
+    hls::stream<ap_uint<512> >& digestStrm,
+    hls::stream<ap_uint<512> >& sigStrm,
+    hls::stream<ap_uint<256> >& pubKeyStrm,
+    hls::stream<bool>& endInStrm,
+    // stream out
+    hls::stream<bool>& resultStrm) {
+    const ap_uint<256> l = internal::ed25519Order();
+    const ap_uint<264> mu = internal::ed25519OrderMu();
+    const ap_uint<256> e1 = (internal::p25519Prime() - 5) >> 3;
+    const ap_uint<256> e2 = internal::p25519Prime() - 2;
+loop_Batch:
+    while (!endInStrm.read()) {
+#pragma HLS loop_tripcount max = 10 min = 10
+        ap_uint<256> R[N], S[N], h[N], ay[N], u[N], v[N], uv3[N], uv7[N], pw[N];
+        ap_uint<256> ax[N], at[N], baX[N], baY[N], baZ[N], baT[N];
+        ap_uint<256> X[N], Y[N], Z[N], T[N];
+        bool sign[N], valid[N];
+#pragma HLS resource variable = R core = RAM_2P_LUTRAM
+#pragma HLS resource variable = S core = RAM_2P_LUTRAM
+#pragma HLS resource variable = h core = RAM_2P_LUTRAM
+#pragma HLS resource variable = ay core = RAM_2P_LUTRAM
+#pragma HLS resource variable = u core = RAM_2P_LUTRAM
+#pragma HLS resource variable = v core = RAM_2P_LUTRAM
+#pragma HLS resource variable = uv3 core = RAM_2P_LUTRAM
+#pragma HLS resource variable = uv7 core = RAM_2P_LUTRAM
+#pragma HLS resource variable = pw core = RAM_2P_LUTRAM
+#pragma HLS resource variable = ax core = RAM_2P_LUTRAM
+#pragma HLS resource variable = at core = RAM_2P_LUTRAM
+#pragma HLS resource variable = baX core = RAM_2P_LUTRAM
+#pragma HLS resource variable = baY core = RAM_2P_LUTRAM
+#pragma HLS resource variable = baZ core = RAM_2P_LUTRAM
+#pragma HLS resource variable = baT core = RAM_2P_LUTRAM
+#pragma HLS resource variable = X core = RAM_2P_LUTRAM
+#pragma HLS resource variable = Y core = RAM_2P_LUTRAM
+#pragma HLS resource variable = Z core = RAM_2P_LUTRAM
+#pragma HLS resource variable = T core = RAM_2P_LUTRAM
+    loop_Load:
+        for (int i = 0; i < N; i++) {
+#pragma HLS pipeline
+            ap_uint<512> digest = digestStrm.read();
+            ap_uint<512> sig = sigStrm.read();
+            ap_uint<256> key = pubKeyStrm.read();
+            R[i] = sig.range(255, 0);
+            S[i] = sig.range(511, 256);
+            h[i] = internal::barrettReduce<256>(digest, l, mu);
+            sign[i] = key[255];
+            key[255] = 0;
+            ay[i] = key;
+            valid[i] = (S[i] < l) && (key < internal::p25519Prime());
+            ap_uint<256> ui, vi, uv3i, uv7i;
+            internal::ed25519DecodeInit(key, ui, vi, uv3i, uv7i);
+            u[i] = ui;
+            v[i] = vi;
+            uv3[i] = uv3i;
+            uv7[i] = uv7i;
+            pw[i] = 1;
+        }
+
+    // (u v^7)^((p - 5) / 8), one bit of the exponent for every channel per round
+    loop_Decode:
+        for (int k = 251; k >= 0; k--) {
+        loop_DecodeChan:
+            for (int i = 0; i < N; i++) {
+#pragma HLS pipeline
+#pragma HLS dependence variable = pw inter distance = N true
+                ap_uint<256> acc = pw[i];
+                internal::p25519PowStep(acc, uv7[i], e1[k]);
+                pw[i] = acc;
+            }
+        }
+
+    loop_Prepare:
+        for (int i = 0; i < N; i++) {
+#pragma HLS pipeline
+            ap_uint<256> x;
+            valid[i] = internal::ed25519DecodeFinal(sign[i], u[i], v[i], uv3[i], pw[i], x) && valid[i];
+            ap_uint<256> nx = internal::p25519Sub(0, x);
+            ap_uint<256> nt = internal::p25519Mul(nx, ay[i]);
+            ax[i] = nx;
+            at[i] = nt;
+            ap_uint<256> tx, ty, tz, tt;
+            internal::ed25519PointAdd(internal::ed25519Bx(), internal::ed25519By(), 1, internal::ed25519Bt(), nx,
+                                      ay[i], 1, nt, tx, ty, tz, tt);
+            baX[i] = tx;
+            baY[i] = ty;
+            baZ[i] = tz;
+            baT[i] = tt;
+            X[i] = 0;
+            Y[i] = 1;
+            Z[i] = 1;
+            T[i] = 0;
+        }
+
+    loop_Shamir:
+        for (int k = 252; k >= 0; k--) {
+        loop_ShamirChan:
+            for (int i = 0; i < N; i++) {
+#pragma HLS pipeline
+#pragma HLS dependence variable = X inter distance = N true
+#pragma HLS dependence variable = Y inter distance = N true
+#pragma HLS dependence variable = Z inter distance = N true
+#pragma HLS dependence variable = T inter distance = N true
+                ap_uint<256> x = X[i], y = Y[i], z = Z[i], t = T[i];
+                internal::ed25519ShamirStep(x, y, z, t, S[i][k], h[i][k], ax[i], ay[i], at[i], baX[i], baY[i],
+                                            baZ[i], baT[i]);
+                X[i] = x;
+                Y[i] = y;
+                Z[i] = z;
+                T[i] = t;
+            }
+        }
+
+    // Z^(p - 2), reusing the accumulator of the decoding
+    loop_InvInit:
+        for (int i = 0; i < N; i++) {
+#pragma HLS pipeline
+            pw[i] = 1;
+        }
+    loop_Inv:
+        for (int k = 254; k >= 0; k--) {
+        loop_InvChan:
+            for (int i = 0; i < N; i++) {
+#pragma HLS pipeline
+#pragma HLS dependence variable = pw inter distance = N true
+                ap_uint<256> acc = pw[i];
+                internal::p25519PowStep(acc, Z[i], e2[k]);
+                pw[i] = acc;
+            }
+        }
+
+    loop_Check:
+        for (int i = 0; i < N; i++) {
+#pragma HLS pipeline
+            resultStrm.write(valid[i] && internal::ed25519CheckResult(X[i], Y[i], pw[i], R[i]));
+        }
+    }
+}
+
+} // end of namespace security
+} // end of namespace xf
+
+#endif // _XF_SECURITY_ED25519_HPP_
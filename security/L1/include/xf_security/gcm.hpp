@@ -840,6 +840,235 @@ static void aes256GcmDecrypt(hls::stream<ap_uint<128> >& payloadStrm,
 
 } // end aes256GcmDecrypt
 
+/**
+ *
+ * @brief aesGcmMultiChan is GCM encryption and decryption of many concurrent flows with AES single block cipher.
+ *
+ * The expanded round keys and hash subkeys of all flows are kept in an on-chip key table, indexed by key-id.
+ * Each packet is described by its key-id, IV, AAD and payload. _channelNumber packets form a batch, and their
+ * blocks are interleaved round-robin through one AES pipeline and one GHASH pipeline, so the GHASH accumulator of a
+ * packet is needed again _channelNumber cycles later and both pipelines take a new block every cycle.
+ *
+ * The AAD and payload blocks of a batch are taken in rounds. In round r, channel c takes its AAD block r - 1 if
+ * 1 <= r <= AAD blocks, or its payload block r - 1 - AAD blocks if that is within payload blocks, otherwise nothing.
+ * The output blocks are emitted in the same order. Grouping packets of similar length into a batch saves idle slots.
+ *
+ * @tparam _keyWidth The bit-width of the cipher key, which is 128, 192, or 256.
+ * @tparam _channelNumber Number of packets in one batch, should be no less than the latency of GHASH.
+ * @tparam _keyTableSize Number of entries in the key table.
+ *
+ */
+template <unsigned int _keyWidth, unsigned int _channelNumber, unsigned int _keyTableSize>
+class aesGcmMultiChan {
+   private:
+    static const int roundKeyNum = _keyWidth / 32 + 7;
+    ap_uint<128> roundKeyTable[_keyTableSize][roundKeyNum];
+    ap_uint<128> hashKeyTable[_keyTableSize];
+
+    template <bool _isEncrypt>
+    void process(hls::stream<ap_uint<32> >& keyIdStrm,
+                 hls::stream<ap_uint<96> >& IVStrm,
+                 hls::stream<ap_uint<64> >& lenAADStrm,
+                 hls::stream<ap_uint<64> >& lenPldStrm,
+                 hls::stream<bool>& endLenStrm,
+                 hls::stream<ap_uint<128> >& AADStrm,
+                 hls::stream<ap_uint<128> >& payloadStrm,
+                 hls::stream<ap_uint<128> >& outStrm,
+                 hls::stream<ap_uint<128> >& tagStrm) {
+        xf::security::aesEnc<_keyWidth> cipher;
+
+        ap_uint<32> keyId[_channelNumber];
+        ap_uint<96> IV[_channelNumber];
+        ap_uint<64> lenAAD[_channelNumber];
+        ap_uint<64> lenPld[_channelNumber];
+        ap_uint<32> blkAAD[_channelNumber];
+        ap_uint<32> blkPld[_channelNumber];
+        ap_uint<128> EKY0[_channelNumber];
+        ap_uint<128> ghash[_channelNumber];
+#pragma HLS resource variable = keyId core = RAM_2P_LUTRAM
+#pragma HLS resource variable = IV core = RAM_2P_LUTRAM
+#pragma HLS resource variable = lenAAD core = RAM_2P_LUTRAM
+#pragma HLS resource variable = lenPld core = RAM_2P_LUTRAM
+#pragma HLS resource variable = blkAAD core = RAM_2P_LUTRAM
+#pragma HLS resource variable = blkPld core = RAM_2P_LUTRAM
+#pragma HLS resource variable = EKY0 core = RAM_2P_LUTRAM
+#pragma HLS resource variable = ghash core = RAM_2P_LUTRAM
+
+    loop_Batch:
+        while (!endLenStrm.read()) {
+#pragma HLS loop_tripcount min = 1 max = 1 avg = 1
+            ap_uint<32> roundNum = 0;
+        loop_Load:
+            for (int c = 0; c < _channelNumber; c++) {
+#pragma HLS pipeline II = 1
+                keyId[c] = keyIdStrm.read();
+                IV[c] = IVStrm.read();
+                ap_uint<64> la = lenAADStrm.read();
+                ap_uint<64> lp = lenPldStrm.read();
+                lenAAD[c] = la;
+                lenPld[c] = lp;
+                ap_uint<32> ba = la / 128 + ((la % 128) > 0);
+                ap_uint<32> bp = lp / 128 + ((lp % 128) > 0);
+                blkAAD[c] = ba;
+                blkPld[c] = bp;
+                ghash[c] = 0;
+                // E(K,Y0), the AAD, the payload, and len(A)||len(C)
+                if (ba + bp + 2 > roundNum) {
+                    roundNum = ba + bp + 2;
+                }
+            }
+
+        loop_Round:
+            for (ap_uint<32> r = 0; r < roundNum; r++) {
+#pragma HLS loop_tripcount min = 10 max = 10 avg = 10
+            loop_RoundChan:
+                for (int c = 0; c < _channelNumber; c++) {
+#pragma HLS pipeline II = 1
+#pragma HLS dependence variable = ghash inter distance = _channelNumber true
+                    ap_uint<32> ba = blkAAD[c];
+                    ap_uint<32> bp = blkPld[c];
+                    if (r < ba + bp + 2) {
+                        ap_uint<32> id = keyId[c];
+                        for (int k = 0; k < roundKeyNum; k++) {
+#pragma HLS unroll
+                            cipher.key_list[k] = roundKeyTable[id][k];
+                        }
+
+                        // counter block, Y0 in the first round and inc32(Y0) onwards for the payload
+                        ap_uint<32> ctr = (r <= ba) ? (ap_uint<32>)1 : (ap_uint<32>)(r - ba + 1);
+                        ap_uint<128> ctrBlk;
+                        ctrBlk.range(95, 0) = IV[c];
+                        ctrBlk.range(103, 96) = ctr.range(31, 24);
+                        ctrBlk.range(111, 104) = ctr.range(23, 16);
+                        ctrBlk.range(119, 112) = ctr.range(15, 8);
+                        ctrBlk.range(127, 120) = ctr.range(7, 0);
+                        ap_uint<128> keyStream;
+                        cipher.process(ctrBlk, 0, keyStream);
+
+                        ap_uint<128> ghashIn = 0;
+                        bool absorb = true;
+                        if (r == 0) {
+                            EKY0[c] = keyStream;
+                            absorb = false;
+                        } else if (r <= ba) {
+                            ghashIn = AADStrm.read();
+                            ap_uint<64> tail = lenAAD[c] % 128;
+                            if (r == ba && tail > 0) {
+                                ghashIn.range(127, tail) = 0;
+                            }
+                        } else if (r <= ba + bp) {
+                            ap_uint<128> in = payloadStrm.read();
+                            ap_uint<128> out = in ^ keyStream;
+                            ap_uint<64> tail = lenPld[c] % 128;
+                            if (r == ba + bp && tail > 0) {
+                                in.range(127, tail) = 0;
+                                out.range(127, tail) = 0;
+                            }
+                            outStrm.write(out);
+                            ghashIn = _isEncrypt ? out : in;
+                        } else {
+                            ap_uint<64> la = lenAAD[c];
+                            ap_uint<64> lp = lenPld[c];
+                            for (int i = 0; i < 8; i++) {
+#pragma HLS unroll
+                                ghashIn.range(63 - i * 8, 56 - i * 8) = la.range(i * 8 + 7, i * 8);
+                                ghashIn.range(127 - i * 8, 120 - i * 8) = lp.range(i * 8 + 7, i * 8);
+                            }
+                        }
+
+                        if (absorb) {
+                            ap_uint<128> acc;
+                            internal::GF128_mult(ghash[c] ^ ghashIn, hashKeyTable[id], acc);
+                            ghash[c] = acc;
+                        }
+                    }
+                }
+            }
+
+        loop_Tag:
+            for (int c = 0; c < _channelNumber; c++) {
+#pragma HLS pipeline II = 1
+                tagStrm.write(ghash[c] ^ EKY0[c]);
+            }
+        }
+    }
+
+   public:
+    aesGcmMultiChan() {
+#pragma HLS array_partition variable = roundKeyTable complete dim = 2
+    }
+
+    /**
+     * @brief Expand a cipher key and store it in the key table
+     *
+     * @param keyId Index of the key table entry, less than _keyTableSize.
+     * @param cipherkey Key of the flow, x bits for AES-x.
+     */
+    void updateKey(ap_uint<32> keyId, ap_uint<_keyWidth> cipherkey) {
+        xf::security::aesEnc<_keyWidth> cipher;
+        cipher.updateKey(cipherkey);
+        for (int k = 0; k < roundKeyNum; k++) {
+#pragma HLS pipeline II = 1
+            roundKeyTable[keyId][k] = cipher.key_list[k];
+        }
+        // hash subkey H = E(K, 0)
+        ap_uint<128> H;
+        cipher.process(0, cipherkey, H);
+        hashKeyTable[keyId] = H;
+    }
+
+    /**
+     * @brief Encrypt batches of packets
+     *
+     * @param keyIdStrm Key-id of each packet.
+     * @param IVStrm Initialization vector of each packet.
+     * @param lenAADStrm Length of AAD of each packet in bits.
+     * @param lenPldStrm Length of payload of each packet in bits.
+     * @param endLenStrm Flag to signal the end of the descriptors, false before each batch of _channelNumber packets.
+     * @param AADStrm AAD blocks, 128 bits, in round-robin order.
+     * @param payloadStrm Plaintext blocks, 128 bits, in round-robin order.
+     * @param cipherStrm Ciphertext blocks, 128 bits, in round-robin order.
+     * @param tagStrm The MAC of each packet, _channelNumber per batch.
+     */
+    void encrypt(hls::stream<ap_uint<32> >& keyIdStrm,
+                 hls::stream<ap_uint<96> >& IVStrm,
+                 hls::stream<ap_uint<64> >& lenAADStrm,
+                 hls::stream<ap_uint<64> >& lenPldStrm,
+                 hls::stream<bool>& endLenStrm,
+                 hls::stream<ap_uint<128> >& AADStrm,
+                 hls::stream<ap_uint<128> >& payloadStrm,
+                 hls::stream<ap_uint<128> >& cipherStrm,
+                 hls::stream<ap_uint<128> >& tagStrm) {
+        process<true>(keyIdStrm, IVStrm, lenAADStrm, lenPldStrm, endLenStrm, AADStrm, payloadStrm, cipherStrm, tagStrm);
+    }
+
+    /**
+     * @brief Decrypt batches of packets
+     *
+     * @param keyIdStrm Key-id of each packet.
+     * @param IVStrm Initialization vector of each packet.
+     * @param lenAADStrm Length of AAD of each packet in bits.
+     * @param lenCphStrm Length of ciphertext of each packet in bits.
+     * @param endLenStrm Flag to signal the end of the descriptors, false before each batch of _channelNumber packets.
+     * @param AADStrm AAD blocks, 128 bits, in round-robin order.
+     * @param cipherStrm Ciphertext blocks, 128 bits, in round-robin order.
+     * @param payloadStrm Plaintext blocks, 128 bits, in round-robin order.
+     * @param tagStrm The MAC of each packet, _channelNumber per batch, to be compared with the received one.
+     */
+    void decrypt(hls::stream<ap_uint<32> >& keyIdStrm,
+                 hls::stream<ap_uint<96> >& IVStrm,
+                 hls::stream<ap_uint<64> >& lenAADStrm,
+                 hls::stream<ap_uint<64> >& lenCphStrm,
+                 hls::stream<bool>& endLenStrm,
+                 hls::stream<ap_uint<128> >& AADStrm,
+                 hls::stream<ap_uint<128> >& cipherStrm,
+                 hls::stream<ap_uint<128> >& payloadStrm,
+                 hls::stream<ap_uint<128> >& tagStrm) {
+        process<false>(keyIdStrm, IVStrm, lenAADStrm, lenCphStrm, endLenStrm, AADStrm, cipherStrm, payloadStrm,
+                       tagStrm);
+    }
+};
+
 } // namespace security
 } // namespace xf
 
@@ -0,0 +1,157 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file merkle.hpp
+ * @brief header file for SHA-256 Merkle tree.
+ * This file is part of Vitis Security Library.
+ *
+ * @detail The leaves and every level of the tree are hashed by the multi-lane SHA-256 engine, and the nodes are kept
+ * on chip until the root is reached.
+ */
+
+#ifndef _XF_SECURITY_MERKLE_HPP_
+#define _XF_SECURITY_MERKLE_HPP_
+
+#include <ap_int.h>
+#include <hls_stream.h>
+
+#include "xf_security/sha224_256.hpp"
+
+namespace xf {
+namespace security {
+
+/**
+ * @brief sha256MerkleTree builds a binary SHA-256 Merkle tree and outputs its root.
+ *
+ * Each leaf is the SHA-256 of the byte 0x00 followed by one message, and each node of a higher level is the SHA-256
+ * of the byte 0x01 followed by the 64-byte concatenation of its left and right child, as in RFC 6962. The prefixes
+ * separate the two domains, so a leaf message equal to two concatenated child digests does not collide with the
+ * node above them. An odd node at the end of a level is carried up to the next level as it is. The leaf messages are
+ * taken in groups of _laneNum in the same order as sha256MultiLane, without the prefix.
+ *
+ * When outputAll is true, all nodes are output level by level, from the leaves to the root, each level from left to
+ * right. Otherwise only the root is output. Nothing but the end flag is output when there is no leaf.
+ *
+ * @tparam _laneNum Number of SHA-256 lanes.
+ * @tparam _maxLeafNum Maximum number of leaves, which is the size of the on-chip node buffer.
+ * @param msgStrm The leaf message blocks, 512 bits per block, byte i at bit 8i.
+ * @param lenStrm Length of each leaf message in bytes.
+ * @param endLenStrm Flag to signal the end of the leaves, false before each leaf and true to end.
+ * @param outputAll Output all nodes if true, otherwise only the root.
+ * @param nodeStrm The nodes, byte i at bit 8i.
+ * @param endNodeStrm Flag to signal the end of the nodes.
+ */
+template <unsigned int _laneNum, unsigned int _maxLeafNum>
+void sha256MerkleTree(hls::stream<ap_uint<512> >& msgStrm,
+                      hls::stream<ap_uint<64> >& lenStrm,
+                      hls::stream<bool>& endLenStrm,
+                      bool outputAll,
+                      hls::stream<ap_uint<256> >& nodeStrm,
+                      hls::stream<bool>& endNodeStrm) {
+    ap_uint<256> node[_maxLeafNum];
+#pragma HLS resource variable = node core = RAM_2P_URAM
+    uint64_t len[_laneNum];
+#pragma HLS resource variable = len core = RAM_2P_LUTRAM
+    ap_uint<256> digest[_laneNum];
+#pragma HLS resource variable = digest core = RAM_2P_LUTRAM
+
+    hls::stream<ap_uint<512> > pairStrm("pairStrm");
+#pragma HLS stream variable = pairStrm depth = _laneNum
+
+    // hash the leaves
+    unsigned int num = 0;
+    bool end = endLenStrm.read();
+loop_Leaf:
+    while (!end) {
+#pragma HLS loop_tripcount min = 1 max = 1 avg = 1
+        unsigned int n = 0;
+    loop_LeafGroup:
+        while (!end && n < _laneNum) {
+#pragma HLS pipeline II = 1
+            len[n] = lenStrm.read();
+            ++n;
+            end = endLenStrm.read();
+        }
+
+        internal::sha256MultiLaneGroup<_laneNum>(n, len, msgStrm, digest, true, 0x00);
+
+    loop_LeafStore:
+        for (unsigned int c = 0; c < n; c++) {
+#pragma HLS pipeline II = 1
+            XF_SECURITY_ASSERT(num < _maxLeafNum);
+            node[num++] = digest[c];
+            if (outputAll) {
+                nodeStrm.write(digest[c]);
+                endNodeStrm.write(false);
+            }
+        }
+    }
+
+    // reduce level by level, in place as node j of the next level is never after node 2j of this level
+loop_Level:
+    while (num > 1) {
+#pragma HLS loop_tripcount min = 1 max = 1 avg = 1
+        unsigned int half = num >> 1;
+    loop_LevelGroup:
+        for (unsigned int i = 0; i < half; i += _laneNum) {
+#pragma HLS loop_tripcount min = 1 max = 1 avg = 1
+            unsigned int n = (half - i < _laneNum) ? half - i : _laneNum;
+        loop_Pair:
+            for (unsigned int c = 0; c < n; c++) {
+#pragma HLS pipeline II = 1
+                ap_uint<512> blk;
+                blk.range(255, 0) = node[2 * (i + c)];
+                blk.range(511, 256) = node[2 * (i + c) + 1];
+                pairStrm.write(blk);
+                len[c] = 64;
+            }
+
+            internal::sha256MultiLaneGroup<_laneNum>(n, len, pairStrm, digest, true, 0x01);
+
+        loop_PairStore:
+            for (unsigned int c = 0; c < n; c++) {
+#pragma HLS pipeline II = 1
+                node[i + c] = digest[c];
+                if (outputAll) {
+                    nodeStrm.write(digest[c]);
+                    endNodeStrm.write(false);
+                }
+            }
+        }
+        // the odd node is carried up
+        if (num & 1) {
+            node[half] = node[num - 1];
+            if (outputAll) {
+                nodeStrm.write(node[half]);
+                endNodeStrm.write(false);
+            }
+        }
+        num = half + (num & 1);
+    }
+
+    // the root is the last node output above when outputAll is true
+    if (!outputAll && num == 1) {
+        nodeStrm.write(node[0]);
+        endNodeStrm.write(false);
+    }
+    endNodeStrm.write(true);
+}
+
+} // namespace security
+} // namespace xf
+
+#endif // _XF_SECURITY_MERKLE_HPP_
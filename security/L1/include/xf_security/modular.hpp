@@ -0,0 +1,137 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file modular.hpp
+ * @brief header file for modular arithmetic over a generic odd modulus.
+ * This file is part of Vitis Security Library.
+ *
+ * @detail The modulus is fixed for the duration of a call and its Barrett constant is precomputed by the caller, so
+ * there is no big integer division anywhere.
+ */
+
+#ifndef _XF_SECURITY_MODULAR_HPP_
+#define _XF_SECURITY_MODULAR_HPP_
+
+#include <ap_int.h>
+
+namespace xf {
+namespace security {
+namespace internal {
+
+/**
+ * @brief Modular addition, the result is (a + b) mod m.
+ *
+ * @tparam N Bit width of the operands.
+ * @param a The first operand, less than m.
+ * @param b The second operand, less than m.
+ * @param m The modulus.
+ */
+template <int N>
+ap_uint<N> addMod(ap_uint<N> a, ap_uint<N> b, ap_uint<N> m) {
+#pragma HLS inline
+    ap_uint<N + 1> sum = a + b;
+    if (sum >= m) {
+        sum -= m;
+    }
+    return sum;
+}
+
+/**
+ * @brief Modular subtraction, the result is (a - b) mod m.
+ *
+ * @tparam N Bit width of the operands.
+ * @param a The first operand, less than m.
+ * @param b The second operand, less than m.
+ * @param m The modulus.
+ */
+template <int N>
+ap_uint<N> subMod(ap_uint<N> a, ap_uint<N> b, ap_uint<N> m) {
+#pragma HLS inline
+    ap_uint<N + 1> dif = a;
+    if (a < b) {
+        dif += m;
+    }
+    dif -= b;
+    return dif;
+}
+
+/**
+ * @brief Barrett reduction, the result is x mod m.
+ *
+ * The quotient estimate floor(x * mu / 2^(2N)) is at most one below the real quotient, so one conditional
+ * subtraction finishes the reduction.
+ *
+ * @tparam N Bit width of the modulus, which must be larger than 2^(N - 8).
+ * @param x The number to reduce.
+ * @param m The modulus.
+ * @param mu The Barrett constant floor(2^(2N) / m).
+ */
+template <int N>
+ap_uint<N> barrettReduce(ap_uint<2 * N> x, ap_uint<N> m, ap_uint<N + 8> mu) {
+#pragma HLS inline
+    ap_uint<3 * N + 8> prod = x * mu;
+    ap_uint<N + 8> q = prod.range(3 * N + 7, 2 * N);
+    ap_uint<N + 1> r = x - q * m;
+    if (r >= m) {
+        r -= m;
+    }
+    return r;
+}
+
+/**
+ * @brief Modular multiplication, the result is a * b mod m.
+ *
+ * @tparam N Bit width of the modulus.
+ * @param a The multiplicand, less than m.
+ * @param b The multiplier, less than m.
+ * @param m The modulus.
+ * @param mu The Barrett constant floor(2^(2N) / m).
+ */
+template <int N>
+ap_uint<N> productMod(ap_uint<N> a, ap_uint<N> b, ap_uint<N> m, ap_uint<N + 8> mu) {
+#pragma HLS inline
+    ap_uint<2 * N> prod = a * b;
+    return barrettReduce<N>(prod, m, mu);
+}
+
+/**
+ * @brief Modular inverse by Fermat's little theorem, the result is a^(m - 2) mod m.
+ *
+ * @tparam N Bit width of the modulus.
+ * @param a The number to invert, less than m and not 0.
+ * @param m The modulus, which must be prime.
+ * @param mu The Barrett constant floor(2^(2N) / m).
+ */
+template <int N>
+ap_uint<N> modularInv(ap_uint<N> a, ap_uint<N> m, ap_uint<N + 8> mu) {
+    ap_uint<N> e = m - 2;
+    ap_uint<N> r = 1;
+    for (int i = N - 1; i >= 0; i--) {
+#pragma HLS pipeline
+        r = productMod<N>(r, r, m, mu);
+        if (e[i] == 1) {
+            r = productMod<N>(r, a, m, mu);
+        }
+    }
+    return r;
+}
+
+} // end of namespace internal
+} // end of namespace security
+} // end of namespace xf
+
+#endif // _XF_SECURITY_MODULAR_HPP_
@@ -797,6 +797,193 @@ inline void sha256_top(hls::stream<ap_uint<m_width> >& msg_strm,
     sha256Digest(nblk_strm2, end_nblk_strm2, w_strm, //
                  hash_strm, end_hash_strm);
 } // sha256_top
+
+/// @brief Hash a group of messages with the rounds of different messages interleaved.
+///
+/// The 64 rounds of every block run as one pipelined loop over (round, lane), so the working variables of a
+/// lane are needed again _lane_num cycles later, and the round logic can be pipelined without stalling.
+///
+/// When prefix_en is true, the byte prefix is hashed in front of every message, and the blocks are shifted by one
+/// byte on the fly, so the caller still sends ceil(len / 64) blocks of each message as they are.
+///
+/// @tparam _lane_num the number of lanes.
+/// @param lane_num the number of messages in this group, no more than _lane_num.
+/// @param len the length of each message in byte, without the prefix.
+/// @param blk_strm the 512-bit message blocks, byte i at bit 8i, block k of every lane before block k + 1.
+/// @param digest the hash of each message, byte i at bit 8i.
+/// @param prefix_en hash the prefix byte in front of every message if true.
+/// @param prefix the prefix byte.
+template <unsigned int _lane_num>
+void sha256MultiLaneGroup(unsigned int lane_num,
+                          uint64_t len[_lane_num],
+                          hls::stream<ap_uint<512> >& blk_strm,
+                          ap_uint<256> digest[_lane_num],
+                          bool prefix_en = false,
+                          ap_uint<8> prefix = 0) {
+    /// constant K
+    static const uint32_t K[64] = {
+        0x428a2f98UL, 0x71374491UL, 0xb5c0fbcfUL, 0xe9b5dba5UL, 0x3956c25bUL, 0x59f111f1UL, 0x923f82a4UL, 0xab1c5ed5UL,
+        0xd807aa98UL, 0x12835b01UL, 0x243185beUL, 0x550c7dc3UL, 0x72be5d74UL, 0x80deb1feUL, 0x9bdc06a7UL, 0xc19bf174UL,
+        0xe49b69c1UL, 0xefbe4786UL, 0x0fc19dc6UL, 0x240ca1ccUL, 0x2de92c6fUL, 0x4a7484aaUL, 0x5cb0a9dcUL, 0x76f988daUL,
+        0x983e5152UL, 0xa831c66dUL, 0xb00327c8UL, 0xbf597fc7UL, 0xc6e00bf3UL, 0xd5a79147UL, 0x06ca6351UL, 0x14292967UL,
+        0x27b70a85UL, 0x2e1b2138UL, 0x4d2c6dfcUL, 0x53380d13UL, 0x650a7354UL, 0x766a0abbUL, 0x81c2c92eUL, 0x92722c85UL,
+        0xa2bfe8a1UL, 0xa81a664bUL, 0xc24b8b70UL, 0xc76c51a3UL, 0xd192e819UL, 0xd6990624UL, 0xf40e3585UL, 0x106aa070UL,
+        0x19a4c116UL, 0x1e376c08UL, 0x2748774cUL, 0x34b0bcb5UL, 0x391c0cb3UL, 0x4ed8aa4aUL, 0x5b9cca4fUL, 0x682e6ff3UL,
+        0x748f82eeUL, 0x78a5636fUL, 0x84c87814UL, 0x8cc70208UL, 0x90befffaUL, 0xa4506cebUL, 0xbef9a3f7UL, 0xc67178f2UL};
+#pragma HLS array_partition variable = K complete
+
+    /// internal states, working variables and message schedule of each lane.
+    uint32_t H[8][_lane_num];
+#pragma HLS array_partition variable = H complete dim = 1
+    uint32_t V[8][_lane_num];
+#pragma HLS array_partition variable = V complete dim = 1
+    uint32_t W[16][_lane_num];
+#pragma HLS array_partition variable = W complete dim = 1
+    uint64_t blk_num[_lane_num];
+#pragma HLS resource variable = blk_num core = RAM_2P_LUTRAM
+    /// hashed length with the prefix, and the last byte of the previous input block of each lane.
+    uint64_t hash_len[_lane_num];
+#pragma HLS resource variable = hash_len core = RAM_2P_LUTRAM
+    ap_uint<8> carry[_lane_num];
+#pragma HLS resource variable = carry core = RAM_2P_LUTRAM
+
+    uint64_t max_blk = 0;
+LOOP_SHA256_ML_INIT:
+    for (unsigned int c = 0; c < _lane_num; ++c) {
+#pragma HLS pipeline II = 1
+        uint64_t l = len[c] + (prefix_en ? 1 : 0);
+        uint64_t n = 0;
+        if (c < lane_num) {
+            n = (l >> 6) + 1 + ((l & 0x3f) > 55);
+        }
+        hash_len[c] = l;
+        carry[c] = prefix;
+        blk_num[c] = n;
+        if (n > max_blk) {
+            max_blk = n;
+        }
+        H[0][c] = 0x6a09e667UL;
+        H[1][c] = 0xbb67ae85UL;
+        H[2][c] = 0x3c6ef372UL;
+        H[3][c] = 0xa54ff53aUL;
+        H[4][c] = 0x510e527fUL;
+        H[5][c] = 0x9b05688cUL;
+        H[6][c] = 0x1f83d9abUL;
+        H[7][c] = 0x5be0cd19UL;
+    }
+
+LOOP_SHA256_ML_BLK:
+    for (uint64_t k = 0; k < max_blk; ++k) {
+#pragma HLS loop_tripcount min = 64 max = 64
+    LOOP_SHA256_ML_LOAD:
+        for (unsigned int c = 0; c < _lane_num; ++c) {
+#pragma HLS pipeline II = 1
+            if (k < blk_num[c]) {
+                uint64_t off = k << 6;
+                uint64_t l = hash_len[c];
+                ap_uint<512> blk = 0;
+                if (off < len[c]) {
+                    blk = blk_strm.read();
+                }
+                // block k of the prefixed message is the last byte of input block k - 1 and 63 bytes of block k
+                if (prefix_en) {
+                    ap_uint<8> last = blk.range(511, 504);
+                    blk = (blk << 8) | ap_uint<512>(carry[c]);
+                    carry[c] = last;
+                }
+                // pad 1 after the message and zeros
+                for (int i = 0; i < 64; ++i) {
+#pragma HLS unroll
+                    if (off + i == l) {
+                        blk.range(8 * i + 7, 8 * i) = 0x80;
+                    } else if (off + i > l) {
+                        blk.range(8 * i + 7, 8 * i) = 0;
+                    }
+                }
+                // append L in the last block
+                if (k == blk_num[c] - 1) {
+                    uint64_t L = 8 * l;
+                    for (int i = 0; i < 8; ++i) {
+#pragma HLS unroll
+                        blk.range(8 * (63 - i) + 7, 8 * (63 - i)) = (L >> (8 * i)) & 0xff;
+                    }
+                }
+                for (int i = 0; i < 16; ++i) {
+#pragma HLS unroll
+                    uint32_t l = blk.range(32 * i + 31, 32 * i);
+                    // XXX algorithm assumes big-endian.
+                    W[i][c] = ((0x000000ffUL & l) << 24) | ((0x0000ff00UL & l) << 8) | ((0x00ff0000UL & l) >> 8) |
+                              ((0xff000000UL & l) >> 24);
+                }
+                for (int i = 0; i < 8; ++i) {
+#pragma HLS unroll
+                    V[i][c] = H[i][c];
+                }
+            }
+        }
+
+        unsigned int c = 0;
+        short t = 0;
+    LOOP_SHA256_ML_ROUNDS:
+        for (unsigned int i = 0; i < 64 * _lane_num; ++i) {
+#pragma HLS pipeline II = 1
+#pragma HLS dependence variable = V inter distance = _lane_num true
+#pragma HLS dependence variable = W inter distance = _lane_num true
+            if (k < blk_num[c]) {
+                uint32_t Wt;
+                if (t < 16) {
+                    Wt = W[t][c];
+                } else {
+                    Wt = SSIG1(W[(t - 2) & 15][c]) + W[(t - 7) & 15][c] + SSIG0(W[(t - 15) & 15][c]) + W[t & 15][c];
+                    W[t & 15][c] = Wt;
+                }
+                uint32_t a = V[0][c], b = V[1][c], cc = V[2][c], d = V[3][c];
+                uint32_t e = V[4][c], f = V[5][c], g = V[6][c], h = V[7][c];
+                uint32_t T1 = h + BSIG1(e) + CH(e, f, g) + K[t] + Wt;
+                uint32_t T2 = BSIG0(a) + MAJ(a, b, cc);
+                V[7][c] = g;
+                V[6][c] = f;
+                V[5][c] = e;
+                V[4][c] = d + T1;
+                V[3][c] = cc;
+                V[2][c] = b;
+                V[1][c] = a;
+                V[0][c] = T1 + T2;
+            }
+            if (c == _lane_num - 1) {
+                c = 0;
+                ++t;
+            } else {
+                ++c;
+            }
+        }
+
+    LOOP_SHA256_ML_UPDATE:
+        for (unsigned int c = 0; c < _lane_num; ++c) {
+#pragma HLS pipeline II = 1
+            if (k < blk_num[c]) {
+                for (int i = 0; i < 8; ++i) {
+#pragma HLS unroll
+                    H[i][c] += V[i][c];
+                }
+            }
+        }
+    }
+
+LOOP_SHA256_ML_EMIT:
+    for (unsigned int c = 0; c < _lane_num; ++c) {
+#pragma HLS pipeline II = 1
+        ap_uint<256> w256;
+        for (int i = 0; i < 8; ++i) {
+#pragma HLS unroll
+            uint32_t l = H[i][c];
+            // XXX shift algorithm's big endian to HLS's little endian.
+            w256.range(32 * i + 31, 32 * i) = ((0x000000ffUL & l) << 24) | ((0x0000ff00UL & l) << 8) |
+                                              ((0x00ff0000UL & l) >> 8) | ((0xff000000UL & l) >> 24);
+        }
+        digest[c] = w256;
+    }
+} // sha256MultiLaneGroup
 } // namespace internal
 
 /// @brief SHA-224 algorithm with ap_uint stream input and output.
@@ -832,6 +1019,54 @@ void sha256(hls::stream<ap_uint<m_width> >& msg_strm,      // in
     internal::sha256_top(msg_strm, len_strm, end_len_strm, // in
                          hash_strm, end_hash_strm);        // out
 }
+
+/// @brief Multi-lane SHA-256 algorithm, hashing up to _lane_num messages at the same time.
+///
+/// The messages are taken in groups of _lane_num, the last group may be smaller. Inside a group the 512-bit
+/// blocks are interleaved: block k of every message which still has data, in message order, then block k + 1.
+/// The padding is done inside, so only ceil(len / 64) blocks of each message are sent.
+/// Messages of similar length should be grouped together, as a group takes as long as its longest message.
+///
+/// @tparam _lane_num the number of lanes, which should be no less than the latency of one round.
+/// @param msg_strm the message blocks being hashed, byte i at bit 8i.
+/// @param len_strm the length of each message in byte.
+/// @param end_len_strm the flag for end of message length input.
+/// @param hash_strm the result, byte i at bit 8i.
+/// @param end_hash_strm the flag for end of hash output.
+template <unsigned int _lane_num>
+void sha256MultiLane(hls::stream<ap_uint<512> >& msg_strm,
+                     hls::stream<ap_uint<64> >& len_strm,
+                     hls::stream<bool>& end_len_strm,
+                     hls::stream<ap_uint<256> >& hash_strm,
+                     hls::stream<bool>& end_hash_strm) {
+    uint64_t len[_lane_num];
+#pragma HLS resource variable = len core = RAM_2P_LUTRAM
+    ap_uint<256> digest[_lane_num];
+#pragma HLS resource variable = digest core = RAM_2P_LUTRAM
+
+    bool end = end_len_strm.read();
+LOOP_SHA256_ML_MAIN:
+    while (!end) {
+        unsigned int n = 0;
+    LOOP_SHA256_ML_GROUP:
+        while (!end && n < _lane_num) {
+#pragma HLS pipeline II = 1
+            len[n] = len_strm.read();
+            ++n;
+            end = end_len_strm.read();
+        }
+
+        internal::sha256MultiLaneGroup<_lane_num>(n, len, msg_strm, digest);
+
+    LOOP_SHA256_ML_OUT:
+        for (unsigned int c = 0; c < n; ++c) {
+#pragma HLS pipeline II = 1
+            hash_strm.write(digest[c]);
+            end_hash_strm.write(false);
+        }
+    }
+    end_hash_strm.write(true);
+}
 } // namespace security
 } // namespace xf
 
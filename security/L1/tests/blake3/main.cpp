@@ -0,0 +1,241 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "test.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+typedef std::vector<unsigned char> Bytes;
+
+// reference BLAKE3, following the reference implementation of the specification with a stack of subtree roots
+static const uint32_t IV[8] = {0x6a09e667UL, 0xbb67ae85UL, 0x3c6ef372UL, 0xa54ff53aUL,
+                               0x510e527fUL, 0x9b05688cUL, 0x1f83d9abUL, 0x5be0cd19UL};
+static const int PERM[16] = {2, 6, 3, 10, 7, 0, 4, 13, 1, 11, 12, 5, 9, 14, 15, 8};
+
+static uint32_t rotr(uint32_t x, int n) {
+    return (x >> n) | (x << (32 - n));
+}
+
+static void g(uint32_t* v, int a, int b, int c, int d, uint32_t mx, uint32_t my) {
+    v[a] = v[a] + v[b] + mx;
+    v[d] = rotr(v[d] ^ v[a], 16);
+    v[c] = v[c] + v[d];
+    v[b] = rotr(v[b] ^ v[c], 12);
+    v[a] = v[a] + v[b] + my;
+    v[d] = rotr(v[d] ^ v[a], 8);
+    v[c] = v[c] + v[d];
+    v[b] = rotr(v[b] ^ v[c], 7);
+}
+
+static void compress(const uint32_t cv[8],
+                     const unsigned char blk[64],
+                     uint64_t counter,
+                     uint32_t len,
+                     uint32_t flags,
+                     uint32_t out[8]) {
+    uint32_t v[16], m[16], t[16];
+    for (int i = 0; i < 8; i++) {
+        v[i] = cv[i];
+    }
+    for (int i = 0; i < 4; i++) {
+        v[8 + i] = IV[i];
+    }
+    v[12] = (uint32_t)counter;
+    v[13] = (uint32_t)(counter >> 32);
+    v[14] = len;
+    v[15] = flags;
+    for (int i = 0; i < 16; i++) {
+        m[i] = blk[4 * i] | (blk[4 * i + 1] << 8) | (blk[4 * i + 2] << 16) | ((uint32_t)blk[4 * i + 3] << 24);
+    }
+    for (int r = 0; r < 7; r++) {
+        g(v, 0, 4, 8, 12, m[0], m[1]);
+        g(v, 1, 5, 9, 13, m[2], m[3]);
+        g(v, 2, 6, 10, 14, m[4], m[5]);
+        g(v, 3, 7, 11, 15, m[6], m[7]);
+        g(v, 0, 5, 10, 15, m[8], m[9]);
+        g(v, 1, 6, 11, 12, m[10], m[11]);
+        g(v, 2, 7, 8, 13, m[12], m[13]);
+        g(v, 3, 4, 9, 14, m[14], m[15]);
+        for (int i = 0; i < 16; i++) {
+            t[i] = m[PERM[i]];
+        }
+        memcpy(m, t, sizeof(m));
+    }
+    for (int i = 0; i < 8; i++) {
+        out[i] = v[i] ^ v[i + 8];
+    }
+}
+
+static void parent(const uint32_t l[8], const uint32_t r[8], uint32_t flags, uint32_t out[8]) {
+    unsigned char blk[64];
+    for (int i = 0; i < 8; i++) {
+        for (int k = 0; k < 4; k++) {
+            blk[4 * i + k] = l[i] >> (8 * k);
+            blk[32 + 4 * i + k] = r[i] >> (8 * k);
+        }
+    }
+    compress(IV, blk, 0, 64, 4 | flags, out);
+}
+
+Bytes refBlake3(const Bytes& msg) {
+    uint64_t chunkNum = msg.empty() ? 1 : (msg.size() + 1023) / 1024;
+    std::vector<std::vector<uint32_t> > stack;
+    uint32_t cv[8];
+    for (uint64_t ch = 0; ch < chunkNum; ch++) {
+        size_t off = ch * 1024;
+        size_t len = msg.size() - off < 1024 ? msg.size() - off : 1024;
+        size_t blkNum = len == 0 ? 1 : (len + 63) / 64;
+        memcpy(cv, IV, sizeof(cv));
+        for (size_t j = 0; j < blkNum; j++) {
+            unsigned char blk[64] = {0};
+            size_t blkLen = len - j * 64 < 64 ? len - j * 64 : 64;
+            memcpy(blk, msg.data() + off + j * 64, blkLen);
+            uint32_t flags = (j == 0 ? 1 : 0) | (j == blkNum - 1 ? 2 : 0);
+            if (j == blkNum - 1 && chunkNum == 1) {
+                flags |= 8;
+            }
+            compress(cv, blk, ch, blkLen, flags, cv);
+        }
+        if (ch + 1 < chunkNum) {
+            uint64_t total = ch + 1;
+            while ((total & 1) == 0) {
+                parent(stack.back().data(), cv, 0, cv);
+                stack.pop_back();
+                total >>= 1;
+            }
+            stack.push_back(std::vector<uint32_t>(cv, cv + 8));
+        }
+    }
+    while (!stack.empty()) {
+        uint32_t flags = stack.size() == 1 ? 8 : 0;
+        parent(stack.back().data(), cv, flags, cv);
+        stack.pop_back();
+    }
+    Bytes md(32);
+    for (int i = 0; i < 32; i++) {
+        md[i] = cv[i / 4] >> (8 * (i % 4));
+    }
+    return md;
+}
+
+std::string toHex(const Bytes& b) {
+    static const char* hex = "0123456789abcdef";
+    std::string s;
+    for (size_t i = 0; i < b.size(); i++) {
+        s += hex[b[i] >> 4];
+        s += hex[b[i] & 0xf];
+    }
+    return s;
+}
+
+int run(const std::vector<Bytes>& msgs) {
+    hls::stream<ap_uint<512> > msgStrm("msgStrm");
+    hls::stream<ap_uint<64> > lenStrm("lenStrm");
+    hls::stream<bool> endLenStrm("endLenStrm");
+    hls::stream<ap_uint<256> > hashStrm("hashStrm");
+    hls::stream<bool> endHashStrm("endHashStrm");
+
+    for (size_t m = 0; m < msgs.size(); m++) {
+        const Bytes& msg = msgs[m];
+        endLenStrm.write(false);
+        lenStrm.write(msg.size());
+        uint64_t chunkNum = msg.empty() ? 1 : (msg.size() + 1023) / 1024;
+        // block j of every chunk in a group before block j + 1
+        for (uint64_t g = 0; g < chunkNum; g += LANE_NM) {
+            for (int j = 0; j < 16; j++) {
+                for (uint64_t c = g; c < g + LANE_NM && c < chunkNum; c++) {
+                    size_t off = c * 1024 + j * 64;
+                    if (off < msg.size()) {
+                        ap_uint<512> blk = 0;
+                        for (size_t i = 0; i < 64 && off + i < msg.size(); i++) {
+                            blk.range(i * 8 + 7, i * 8) = msg[off + i];
+                        }
+                        msgStrm.write(blk);
+                    }
+                }
+            }
+        }
+    }
+    endLenStrm.write(true);
+
+    test(msgStrm, lenStrm, endLenStrm, hashStrm, endHashStrm);
+
+    int nerror = 0;
+    for (size_t m = 0; m < msgs.size(); m++) {
+        Bytes md = refBlake3(msgs[m]);
+        ap_uint<256> golden;
+        for (int i = 0; i < 32; i++) {
+            golden.range(i * 8 + 7, i * 8) = md[i];
+        }
+        if (endHashStrm.read() || hashStrm.read() != golden) {
+            std::cout << "Error: hash of message " << m << " with " << msgs[m].size() << " bytes" << std::endl;
+            nerror++;
+        }
+    }
+    if (!endHashStrm.read()) {
+        std::cout << "Error: end of hashes" << std::endl;
+        nerror++;
+    }
+    return nerror;
+}
+
+int main() {
+    int nerror = 0;
+
+    // check the reference against the official test vectors, input byte i is i % 251
+    const int vecLen[] = {0, 1, 1024, 1025, 2048};
+    const char* vecHash[] = {"af1349b9f5f9a1a6a0404dea36dcc9499bcb25c9adc112b7cc9a93cae41f3262",
+                             "2d3adedff11b61f14c886e35afa036736dcd87a74d27b5c1510225d0f592e213",
+                             "42214739f095a406f3fc83deb889744ac00df831c10daa55189b5d121c855af7",
+                             "d00278ae47eb27b34faecf67b4fe263f82d5412916c1ffd97c8cb7fb814b8444",
+                             "e776b6028c7cd22a4d0ba182a8bf62205d2ef576467e838ed6f2529b85fba24a"};
+    std::vector<Bytes> msgs;
+    for (int t = 0; t < (int)(sizeof(vecLen) / sizeof(int)); t++) {
+        Bytes msg(vecLen[t]);
+        for (int i = 0; i < vecLen[t]; i++) {
+            msg[i] = i % 251;
+        }
+        if (toHex(refBlake3(msg)) != vecHash[t]) {
+            std::cout << "Error: reference hash of test vector with " << vecLen[t] << " bytes" << std::endl;
+            nerror++;
+        }
+        msgs.push_back(msg);
+    }
+
+    // block and chunk boundaries, a full group, and trees with several groups
+    const int msgLen[] = {63,   64,   65,    1023,  3073,  4096,  7169,  8192,
+                          8193, 9216, 16384, 17000, 31744, 40960, 65537, 102400};
+    for (int t = 0; t < (int)(sizeof(msgLen) / sizeof(int)); t++) {
+        Bytes msg(msgLen[t]);
+        for (int i = 0; i < msgLen[t]; i++) {
+            msg[i] = rand();
+        }
+        msgs.push_back(msg);
+    }
+    nerror += run(msgs);
+
+    if (nerror) {
+        std::cout << "FAIL: " << nerror << " errors found." << std::endl;
+    } else {
+        std::cout << "PASS: " << msgs.size() << " messages hashed." << std::endl;
+    }
+    return nerror;
+}
@@ -0,0 +1,26 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "test.hpp"
+#include "xf_security/blake3.hpp"
+
+void test(hls::stream<ap_uint<512> >& msgStrm,
+          hls::stream<ap_uint<64> >& lenStrm,
+          hls::stream<bool>& endLenStrm,
+          hls::stream<ap_uint<256> >& hashStrm,
+          hls::stream<bool>& endHashStrm) {
+    xf::security::blake3<LANE_NM>(msgStrm, lenStrm, endLenStrm, hashStrm, endHashStrm);
+}
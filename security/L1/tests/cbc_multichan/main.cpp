@@ -0,0 +1,199 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "test.hpp"
+
+#include <openssl/evp.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+// number of messages, a multiple of CH_NM
+#define NUM_MSG 48
+
+struct Message {
+    unsigned char iv[16];
+    std::vector<unsigned char> plain;
+    std::vector<unsigned char> cipher;
+};
+
+ap_uint<128> getBlock(const std::vector<unsigned char>& data, int blk) {
+    ap_uint<128> r = 0;
+    for (int i = 0; i < 16; i++) {
+        r.range(i * 8 + 7, i * 8) = data[blk * 16 + i];
+    }
+    return r;
+}
+
+ap_uint<128> getIV(const Message& m) {
+    ap_uint<128> r = 0;
+    for (int i = 0; i < 16; i++) {
+        r.range(i * 8 + 7, i * 8) = m.iv[i];
+    }
+    return r;
+}
+
+int blocks(const Message& m) {
+    return m.plain.size() / 16;
+}
+
+// interleave batches of CH_NM messages through the encryption engine, and check the ciphertext blocks
+int runEncrypt(const ap_uint<256>& key, std::vector<Message>& msgs) {
+    hls::stream<ap_uint<256> > cipherkeyStrm("cipherkeyStrm");
+    hls::stream<ap_uint<128> > IVStrm("IVStrm");
+    hls::stream<ap_uint<64> > lenStrm("lenStrm");
+    hls::stream<bool> endLenStrm("endLenStrm");
+    hls::stream<ap_uint<128> > plaintextStrm("plaintextStrm");
+    hls::stream<ap_uint<128> > ciphertextStrm("ciphertextStrm");
+    hls::stream<ap_uint<128 * BLK_NM> > cipherWordStrm("cipherWordStrm");
+    hls::stream<ap_uint<128 * BLK_NM> > plainWordStrm("plainWordStrm");
+
+    cipherkeyStrm.write(key);
+    for (int b = 0; b < NUM_MSG / CH_NM; b++) {
+        endLenStrm.write(false);
+        int rounds = 0;
+        for (int c = 0; c < CH_NM; c++) {
+            Message& m = msgs[b * CH_NM + c];
+            IVStrm.write(getIV(m));
+            lenStrm.write(blocks(m));
+            rounds = blocks(m) > rounds ? blocks(m) : rounds;
+        }
+        // round-robin order of the input blocks
+        for (int r = 0; r < rounds; r++) {
+            for (int c = 0; c < CH_NM; c++) {
+                Message& m = msgs[b * CH_NM + c];
+                if (r < blocks(m)) {
+                    plaintextStrm.write(getBlock(m.plain, r));
+                }
+            }
+        }
+    }
+    endLenStrm.write(true);
+
+    test(true, cipherkeyStrm, IVStrm, lenStrm, endLenStrm, plaintextStrm, ciphertextStrm, cipherWordStrm,
+         plainWordStrm);
+
+    int nerror = 0;
+    for (int b = 0; b < NUM_MSG / CH_NM; b++) {
+        int rounds = 0;
+        for (int c = 0; c < CH_NM; c++) {
+            Message& m = msgs[b * CH_NM + c];
+            rounds = blocks(m) > rounds ? blocks(m) : rounds;
+        }
+        for (int r = 0; r < rounds; r++) {
+            for (int c = 0; c < CH_NM; c++) {
+                Message& m = msgs[b * CH_NM + c];
+                if (r < blocks(m)) {
+                    if (ciphertextStrm.read() != getBlock(m.cipher, r)) {
+                        std::cout << "Error: ciphertext of message " << b * CH_NM + c << " block " << r << std::endl;
+                        nerror++;
+                    }
+                }
+            }
+        }
+    }
+    return nerror;
+}
+
+// decrypt the messages one after the other, BLK_NM blocks in each word, and check the plaintext blocks
+int runDecrypt(const ap_uint<256>& key, std::vector<Message>& msgs) {
+    hls::stream<ap_uint<256> > cipherkeyStrm("cipherkeyStrm");
+    hls::stream<ap_uint<128> > IVStrm("IVStrm");
+    hls::stream<ap_uint<64> > lenStrm("lenStrm");
+    hls::stream<bool> endLenStrm("endLenStrm");
+    hls::stream<ap_uint<128> > plaintextStrm("plaintextStrm");
+    hls::stream<ap_uint<128> > ciphertextStrm("ciphertextStrm");
+    hls::stream<ap_uint<128 * BLK_NM> > cipherWordStrm("cipherWordStrm");
+    hls::stream<ap_uint<128 * BLK_NM> > plainWordStrm("plainWordStrm");
+
+    cipherkeyStrm.write(key);
+    for (int t = 0; t < NUM_MSG; t++) {
+        Message& m = msgs[t];
+        endLenStrm.write(false);
+        IVStrm.write(getIV(m));
+        lenStrm.write(blocks(m));
+        for (int w = 0; w * BLK_NM < blocks(m); w++) {
+            ap_uint<128 * BLK_NM> word = 0;
+            for (int i = 0; i < BLK_NM && w * BLK_NM + i < blocks(m); i++) {
+                word.range(128 * i + 127, 128 * i) = getBlock(m.cipher, w * BLK_NM + i);
+            }
+            cipherWordStrm.write(word);
+        }
+    }
+    endLenStrm.write(true);
+
+    test(false, cipherkeyStrm, IVStrm, lenStrm, endLenStrm, plaintextStrm, ciphertextStrm, cipherWordStrm,
+         plainWordStrm);
+
+    int nerror = 0;
+    for (int t = 0; t < NUM_MSG; t++) {
+        Message& m = msgs[t];
+        for (int w = 0; w * BLK_NM < blocks(m); w++) {
+            ap_uint<128 * BLK_NM> word = plainWordStrm.read();
+            // blocks after the end of the message are dropped
+            for (int i = 0; i < BLK_NM && w * BLK_NM + i < blocks(m); i++) {
+                ap_uint<128> blk = word.range(128 * i + 127, 128 * i);
+                if (blk != getBlock(m.plain, w * BLK_NM + i)) {
+                    std::cout << "Error: plaintext of message " << t << " block " << w * BLK_NM + i << std::endl;
+                    nerror++;
+                }
+            }
+        }
+    }
+    return nerror;
+}
+
+int main() {
+    unsigned char keyBytes[32];
+    ap_uint<256> key;
+    for (int i = 0; i < 32; i++) {
+        keyBytes[i] = rand();
+        key.range(i * 8 + 7, i * 8) = keyBytes[i];
+    }
+
+    // messages of 1 to 96 blocks, so that the channels of a batch end in different rounds
+    std::vector<Message> msgs(NUM_MSG);
+    for (int t = 0; t < NUM_MSG; t++) {
+        Message& m = msgs[t];
+        for (int i = 0; i < 16; i++) {
+            m.iv[i] = rand();
+        }
+        m.plain.resize(16 * (1 + (t * 37) % 96));
+        for (size_t i = 0; i < m.plain.size(); i++) {
+            m.plain[i] = rand();
+        }
+        m.cipher.resize(m.plain.size());
+
+        int outlen = 0;
+        EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
+        EVP_EncryptInit_ex(ctx, EVP_aes_256_cbc(), NULL, keyBytes, m.iv);
+        EVP_CIPHER_CTX_set_padding(ctx, 0);
+        EVP_EncryptUpdate(ctx, m.cipher.data(), &outlen, m.plain.data(), m.plain.size());
+        EVP_EncryptFinal_ex(ctx, m.cipher.data() + outlen, &outlen);
+        EVP_CIPHER_CTX_free(ctx);
+    }
+
+    int nerror = runEncrypt(key, msgs);
+    nerror += runDecrypt(key, msgs);
+
+    if (nerror) {
+        std::cout << "FAIL: " << nerror << " errors found." << std::endl;
+    } else {
+        std::cout << "PASS: " << NUM_MSG << " messages encrypted and decrypted." << std::endl;
+    }
+    return nerror;
+}
@@ -0,0 +1,36 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "test.hpp"
+#include "xf_security/cbc.hpp"
+
+void test(bool isEncrypt,
+          hls::stream<ap_uint<256> >& cipherkeyStrm,
+          hls::stream<ap_uint<128> >& IVStrm,
+          hls::stream<ap_uint<64> >& lenStrm,
+          hls::stream<bool>& endLenStrm,
+          hls::stream<ap_uint<128> >& plaintextStrm,
+          hls::stream<ap_uint<128> >& ciphertextStrm,
+          hls::stream<ap_uint<128 * BLK_NM> >& cipherWordStrm,
+          hls::stream<ap_uint<128 * BLK_NM> >& plainWordStrm) {
+    if (isEncrypt) {
+        xf::security::aesCbcEncryptMultiChan<256, CH_NM>(cipherkeyStrm, IVStrm, lenStrm, endLenStrm, plaintextStrm,
+                                                          ciphertextStrm);
+    } else {
+        xf::security::aesCbcDecryptParallel<256, BLK_NM>(cipherkeyStrm, IVStrm, lenStrm, endLenStrm, cipherWordStrm,
+                                                         plainWordStrm);
+    }
+}
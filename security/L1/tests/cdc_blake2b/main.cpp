@@ -0,0 +1,148 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "test.hpp"
+
+#include <openssl/evp.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+// number of inputs
+#define NUM_FILE 5
+
+struct Chunk {
+    uint64_t offset;
+    uint32_t len;
+};
+
+// reference chunking, byte by byte
+void refChunk(const std::vector<unsigned char>& data, uint64_t base, std::vector<Chunk>& chunks) {
+    // gear table, splitmix64 outputs from seed 0
+    uint64_t gear[256];
+    uint64_t x = 0;
+    for (int i = 0; i < 256; i++) {
+        x += 0x9e3779b97f4a7c15ULL;
+        uint64_t z = x;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        gear[i] = z ^ (z >> 31);
+    }
+    int bits = 0;
+    while ((1 << (bits + 1)) <= AVG_SIZE) {
+        bits++;
+    }
+    uint64_t maskS = ~0ULL << (64 - bits - 2);
+    uint64_t maskL = ~0ULL << (64 - bits + 2);
+
+    uint64_t h = 0;
+    uint32_t pos = 0;
+    uint64_t start = 0;
+    for (size_t i = 0; i < data.size(); i++) {
+        h = (h << 1) + gear[data[i]];
+        pos++;
+        uint64_t mask = pos < AVG_SIZE ? maskS : maskL;
+        if (pos >= MAX_SIZE || (pos >= MIN_SIZE && (h & mask) == 0)) {
+            Chunk c = {base + start, pos};
+            chunks.push_back(c);
+            start = i + 1;
+            h = 0;
+            pos = 0;
+        }
+    }
+    if (pos > 0) {
+        Chunk c = {base + start, pos};
+        chunks.push_back(c);
+    }
+}
+
+int main() {
+    // an empty input, a short one, and inputs sharing most of their content with a shift
+    const int lens[NUM_FILE] = {0, 100, 20000, 20007, 12345};
+    std::vector<std::vector<unsigned char> > files(NUM_FILE);
+    std::vector<unsigned char> all;
+    for (int f = 0; f < NUM_FILE; f++) {
+        files[f].resize(lens[f]);
+        for (int i = 0; i < lens[f]; i++) {
+            files[f][i] = rand();
+        }
+    }
+    for (int i = 7; i < lens[3]; i++) {
+        files[3][i] = files[2][i - 7];
+    }
+
+    hls::stream<ap_uint<64> > dataStrm("dataStrm");
+    hls::stream<ap_uint<64> > lenStrm("lenStrm");
+    hls::stream<bool> endLenStrm("endLenStrm");
+    hls::stream<ap_uint<64> > offsetStrm("offsetStrm");
+    hls::stream<ap_uint<32> > chunkLenStrm("chunkLenStrm");
+    hls::stream<ap_uint<512> > digestStrm("digestStrm");
+    hls::stream<bool> endChunkStrm("endChunkStrm");
+
+    std::vector<Chunk> golden;
+    for (int f = 0; f < NUM_FILE; f++) {
+        refChunk(files[f], all.size(), golden);
+        all.insert(all.end(), files[f].begin(), files[f].end());
+        endLenStrm.write(false);
+        lenStrm.write(lens[f]);
+        for (int i = 0; i < lens[f]; i += 8) {
+            ap_uint<64> w = 0;
+            for (int j = 0; j < 8 && i + j < lens[f]; j++) {
+                w.range(j * 8 + 7, j * 8) = files[f][i + j];
+            }
+            dataStrm.write(w);
+        }
+    }
+    endLenStrm.write(true);
+
+    test(dataStrm, lenStrm, endLenStrm, offsetStrm, chunkLenStrm, digestStrm, endChunkStrm);
+
+    int nerror = 0;
+    for (size_t c = 0; c < golden.size(); c++) {
+        if (endChunkStrm.read()) {
+            std::cout << "Error: only " << c << " chunks" << std::endl;
+            nerror++;
+            break;
+        }
+        uint64_t offset = offsetStrm.read();
+        uint32_t len = chunkLenStrm.read();
+        ap_uint<512> digest = digestStrm.read();
+        unsigned char md[64];
+        const unsigned char* data = all.data() + golden[c].offset;
+        EVP_Digest(data, golden[c].len, md, NULL, EVP_blake2b512(), NULL);
+        ap_uint<512> g = 0;
+        for (int i = 0; i < 64; i++) {
+            g.range(i * 8 + 7, i * 8) = md[i];
+        }
+        if (offset != golden[c].offset || len != golden[c].len || digest != g) {
+            std::cout << "Error: chunk " << c << " at " << offset << " of " << len << " bytes, expected "
+                      << golden[c].offset << " of " << golden[c].len << " bytes" << std::endl;
+            nerror++;
+        }
+    }
+    if (nerror == 0 && !endChunkStrm.read()) {
+        std::cout << "Error: more chunks than expected" << std::endl;
+        nerror++;
+    }
+
+    if (nerror) {
+        std::cout << "FAIL: " << nerror << " errors found." << std::endl;
+    } else {
+        std::cout << "PASS: " << golden.size() << " chunks with BLAKE2b-512 digests." << std::endl;
+    }
+    return nerror;
+}
@@ -0,0 +1,153 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "test.hpp"
+
+#include <openssl/evp.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+// number of messages
+#define NUM_MSG 8
+
+struct Message {
+    unsigned char key[32];
+    unsigned char nonce[12];
+    std::vector<unsigned char> aad;
+    std::vector<unsigned char> plain;
+    std::vector<unsigned char> cipher;
+    unsigned char tag[16];
+};
+
+template <int W>
+ap_uint<W> getBlock(const unsigned char* data, int size, int blk) {
+    ap_uint<W> r = 0;
+    for (int i = 0; i < W / 8 && blk * W / 8 + i < size; i++) {
+        r.range(i * 8 + 7, i * 8) = data[blk * W / 8 + i];
+    }
+    return r;
+}
+
+// feed one direction of all messages, and check the output blocks and tags
+int run(bool isEncrypt, std::vector<Message>& msgs) {
+    hls::stream<ap_uint<256> > keyStrm("keyStrm");
+    hls::stream<ap_uint<96> > nonceStrm("nonceStrm");
+    hls::stream<ap_uint<128> > AADStrm("AADStrm");
+    hls::stream<ap_uint<64> > lenAADStrm("lenAADStrm");
+    hls::stream<ap_uint<512> > inStrm("inStrm");
+    hls::stream<ap_uint<64> > lenInStrm("lenInStrm");
+    hls::stream<bool> endLenStrm("endLenStrm");
+    hls::stream<ap_uint<512> > outStrm("outStrm");
+    hls::stream<ap_uint<64> > lenOutStrm("lenOutStrm");
+    hls::stream<ap_uint<128> > tagStrm("tagStrm");
+    hls::stream<bool> endTagStrm("endTagStrm");
+
+    for (int m = 0; m < NUM_MSG; m++) {
+        Message& msg = msgs[m];
+        std::vector<unsigned char>& in = isEncrypt ? msg.plain : msg.cipher;
+        endLenStrm.write(false);
+        keyStrm.write(getBlock<256>(msg.key, 32, 0));
+        nonceStrm.write(getBlock<96>(msg.nonce, 12, 0));
+        lenAADStrm.write(msg.aad.size());
+        for (int i = 0; i < (int)(msg.aad.size() + 15) / 16; i++) {
+            AADStrm.write(getBlock<128>(msg.aad.data(), msg.aad.size(), i));
+        }
+        lenInStrm.write(in.size());
+        for (int i = 0; i < (int)(in.size() + 63) / 64; i++) {
+            inStrm.write(getBlock<512>(in.data(), in.size(), i));
+        }
+    }
+    endLenStrm.write(true);
+
+    test(isEncrypt, keyStrm, nonceStrm, AADStrm, lenAADStrm, inStrm, lenInStrm, endLenStrm, outStrm, lenOutStrm,
+         tagStrm, endTagStrm);
+
+    int nerror = 0;
+    for (int m = 0; m < NUM_MSG; m++) {
+        Message& msg = msgs[m];
+        std::vector<unsigned char>& golden = isEncrypt ? msg.cipher : msg.plain;
+        if (lenOutStrm.read() != golden.size()) {
+            std::cout << "Error: length of message " << m << std::endl;
+            nerror++;
+        }
+        for (int i = 0; i < (int)(golden.size() + 63) / 64; i++) {
+            if (outStrm.read() != getBlock<512>(golden.data(), golden.size(), i)) {
+                std::cout << "Error: message " << m << " block " << i << std::endl;
+                nerror++;
+            }
+        }
+        if (endTagStrm.read() || tagStrm.read() != getBlock<128>(msg.tag, 16, 0)) {
+            std::cout << "Error: tag of message " << m << std::endl;
+            nerror++;
+        }
+    }
+    if (!endTagStrm.read()) {
+        std::cout << "Error: end of tags" << std::endl;
+        nerror++;
+    }
+    return nerror;
+}
+
+int main() {
+    // TLS record like messages with 13 bytes AAD, plus empty and unaligned corner cases
+    const int lenAAD[NUM_MSG] = {13, 13, 0, 12, 13, 33, 13, 16};
+    const int lenPld[NUM_MSG] = {64, 1500, 1, 0, 255, 1024, 17, 640};
+
+    std::vector<Message> msgs(NUM_MSG);
+    for (int m = 0; m < NUM_MSG; m++) {
+        Message& msg = msgs[m];
+        for (int i = 0; i < 32; i++) {
+            msg.key[i] = rand();
+        }
+        for (int i = 0; i < 12; i++) {
+            msg.nonce[i] = rand();
+        }
+        msg.aad.resize(lenAAD[m]);
+        msg.plain.resize(lenPld[m]);
+        msg.cipher.resize(lenPld[m]);
+        for (int i = 0; i < lenAAD[m]; i++) {
+            msg.aad[i] = rand();
+        }
+        for (int i = 0; i < lenPld[m]; i++) {
+            msg.plain[i] = rand();
+        }
+
+        int outlen = 0;
+        EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
+        EVP_EncryptInit_ex(ctx, EVP_chacha20_poly1305(), NULL, msg.key, msg.nonce);
+        if (lenAAD[m] > 0) {
+            EVP_EncryptUpdate(ctx, NULL, &outlen, msg.aad.data(), lenAAD[m]);
+        }
+        if (lenPld[m] > 0) {
+            EVP_EncryptUpdate(ctx, msg.cipher.data(), &outlen, msg.plain.data(), lenPld[m]);
+        }
+        EVP_EncryptFinal_ex(ctx, msg.cipher.data() + outlen, &outlen);
+        EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_GET_TAG, 16, msg.tag);
+        EVP_CIPHER_CTX_free(ctx);
+    }
+
+    int nerror = run(true, msgs);
+    nerror += run(false, msgs);
+
+    if (nerror) {
+        std::cout << "FAIL: " << nerror << " errors found." << std::endl;
+    } else {
+        std::cout << "PASS: " << NUM_MSG << " messages encrypted and decrypted." << std::endl;
+    }
+    return nerror;
+}
@@ -0,0 +1,177 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "test.hpp"
+
+#include <openssl/evp.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+// number of messages, a multiple of CH_NM
+#define NUM_MSG 24
+
+struct Message {
+    unsigned char key[32];
+    unsigned char nonce[12];
+    std::vector<unsigned char> aad;
+    std::vector<unsigned char> plain;
+    std::vector<unsigned char> cipher;
+    unsigned char tag[16];
+};
+
+template <int W>
+ap_uint<W> getBlock(const std::vector<unsigned char>& data, int blk) {
+    ap_uint<W> r = 0;
+    for (int i = 0; i < W / 8 && blk * W / 8 + i < (int)data.size(); i++) {
+        r.range(i * 8 + 7, i * 8) = data[blk * W / 8 + i];
+    }
+    return r;
+}
+
+int roundNum(std::vector<Message>& msgs, int b) {
+    int n = 0;
+    for (int c = 0; c < CH_NM; c++) {
+        Message& msg = msgs[b * CH_NM + c];
+        int k = (msg.aad.size() + 15) / 16 + (msg.plain.size() + 63) / 64 + 2;
+        n = k > n ? k : n;
+    }
+    return n;
+}
+
+// feed one direction of all messages, and check the output blocks and tags
+int run(bool isEncrypt, std::vector<Message>& msgs) {
+    hls::stream<ap_uint<256> > keyStrm("keyStrm");
+    hls::stream<ap_uint<96> > nonceStrm("nonceStrm");
+    hls::stream<ap_uint<64> > lenAADStrm("lenAADStrm");
+    hls::stream<ap_uint<64> > lenInStrm("lenInStrm");
+    hls::stream<bool> endLenStrm("endLenStrm");
+    hls::stream<ap_uint<128> > AADStrm("AADStrm");
+    hls::stream<ap_uint<512> > inStrm("inStrm");
+    hls::stream<ap_uint<512> > outStrm("outStrm");
+    hls::stream<ap_uint<128> > tagStrm("tagStrm");
+
+    for (int b = 0; b < NUM_MSG / CH_NM; b++) {
+        endLenStrm.write(false);
+        for (int c = 0; c < CH_NM; c++) {
+            Message& msg = msgs[b * CH_NM + c];
+            ap_uint<256> key = 0;
+            ap_uint<96> nonce = 0;
+            for (int i = 0; i < 32; i++) {
+                key.range(i * 8 + 7, i * 8) = msg.key[i];
+            }
+            for (int i = 0; i < 12; i++) {
+                nonce.range(i * 8 + 7, i * 8) = msg.nonce[i];
+            }
+            keyStrm.write(key);
+            nonceStrm.write(nonce);
+            lenAADStrm.write(msg.aad.size());
+            lenInStrm.write(msg.plain.size());
+        }
+        // round-robin order of the input blocks
+        for (int r = 1; r < roundNum(msgs, b); r++) {
+            for (int c = 0; c < CH_NM; c++) {
+                Message& msg = msgs[b * CH_NM + c];
+                int ba = (msg.aad.size() + 15) / 16;
+                int bt = (msg.plain.size() + 63) / 64;
+                if (r <= ba) {
+                    AADStrm.write(getBlock<128>(msg.aad, r - 1));
+                } else if (r <= ba + bt) {
+                    inStrm.write(getBlock<512>(isEncrypt ? msg.plain : msg.cipher, r - 1 - ba));
+                }
+            }
+        }
+    }
+    endLenStrm.write(true);
+
+    test(isEncrypt, keyStrm, nonceStrm, lenAADStrm, lenInStrm, endLenStrm, AADStrm, inStrm, outStrm, tagStrm);
+
+    int nerror = 0;
+    for (int b = 0; b < NUM_MSG / CH_NM; b++) {
+        for (int r = 1; r < roundNum(msgs, b); r++) {
+            for (int c = 0; c < CH_NM; c++) {
+                Message& msg = msgs[b * CH_NM + c];
+                int ba = (msg.aad.size() + 15) / 16;
+                int bt = (msg.plain.size() + 63) / 64;
+                if (r > ba && r <= ba + bt) {
+                    if (outStrm.read() != getBlock<512>(isEncrypt ? msg.cipher : msg.plain, r - 1 - ba)) {
+                        std::cout << "Error: message " << b * CH_NM + c << " block " << r - 1 - ba << std::endl;
+                        nerror++;
+                    }
+                }
+            }
+        }
+        for (int c = 0; c < CH_NM; c++) {
+            Message& msg = msgs[b * CH_NM + c];
+            ap_uint<128> golden = 0;
+            for (int i = 0; i < 16; i++) {
+                golden.range(i * 8 + 7, i * 8) = msg.tag[i];
+            }
+            if (tagStrm.read() != golden) {
+                std::cout << "Error: tag of message " << b * CH_NM + c << std::endl;
+                nerror++;
+            }
+        }
+    }
+    return nerror;
+}
+
+int main() {
+    // mobile client like traffic, 64 to 1500 bytes with TLS record AAD and some corner cases
+    std::vector<Message> msgs(NUM_MSG);
+    for (int m = 0; m < NUM_MSG; m++) {
+        Message& msg = msgs[m];
+        for (int i = 0; i < 32; i++) {
+            msg.key[i] = rand();
+        }
+        for (int i = 0; i < 12; i++) {
+            msg.nonce[i] = rand();
+        }
+        msg.aad.resize(m % 5 == 0 ? m % 3 * 16 : 13);
+        msg.plain.resize(m % 7 == 3 ? m % 2 : 64 + (m * 397) % 1437);
+        msg.cipher.resize(msg.plain.size());
+        for (size_t i = 0; i < msg.aad.size(); i++) {
+            msg.aad[i] = rand();
+        }
+        for (size_t i = 0; i < msg.plain.size(); i++) {
+            msg.plain[i] = rand();
+        }
+
+        int outlen = 0;
+        EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
+        EVP_EncryptInit_ex(ctx, EVP_chacha20_poly1305(), NULL, msg.key, msg.nonce);
+        if (msg.aad.size() > 0) {
+            EVP_EncryptUpdate(ctx, NULL, &outlen, msg.aad.data(), msg.aad.size());
+        }
+        if (msg.plain.size() > 0) {
+            EVP_EncryptUpdate(ctx, msg.cipher.data(), &outlen, msg.plain.data(), msg.plain.size());
+        }
+        EVP_EncryptFinal_ex(ctx, msg.cipher.data() + outlen, &outlen);
+        EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_GET_TAG, 16, msg.tag);
+        EVP_CIPHER_CTX_free(ctx);
+    }
+
+    int nerror = run(true, msgs);
+    nerror += run(false, msgs);
+
+    if (nerror) {
+        std::cout << "FAIL: " << nerror << " errors found." << std::endl;
+    } else {
+        std::cout << "PASS: " << NUM_MSG << " messages encrypted and decrypted." << std::endl;
+    }
+    return nerror;
+}
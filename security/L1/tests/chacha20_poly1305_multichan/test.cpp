@@ -0,0 +1,37 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "test.hpp"
+#include "xf_security/chacha20_poly1305.hpp"
+
+void test(bool isEncrypt,
+          hls::stream<ap_uint<256> >& keyStrm,
+          hls::stream<ap_uint<96> >& nonceStrm,
+          hls::stream<ap_uint<64> >& lenAADStrm,
+          hls::stream<ap_uint<64> >& lenInStrm,
+          hls::stream<bool>& endLenStrm,
+          hls::stream<ap_uint<128> >& AADStrm,
+          hls::stream<ap_uint<512> >& inStrm,
+          hls::stream<ap_uint<512> >& outStrm,
+          hls::stream<ap_uint<128> >& tagStrm) {
+    if (isEncrypt) {
+        xf::security::chacha20Poly1305EncryptMultiChan<CH_NM>(keyStrm, nonceStrm, lenAADStrm, lenInStrm, endLenStrm,
+                                                              AADStrm, inStrm, outStrm, tagStrm);
+    } else {
+        xf::security::chacha20Poly1305DecryptMultiChan<CH_NM>(keyStrm, nonceStrm, lenAADStrm, lenInStrm, endLenStrm,
+                                                              AADStrm, inStrm, outStrm, tagStrm);
+    }
+}
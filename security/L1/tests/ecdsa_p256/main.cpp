@@ -0,0 +1,124 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "test.hpp"
+
+#include <openssl/bn.h>
+#include <openssl/ec.h>
+#include <openssl/ecdsa.h>
+#include <openssl/obj_mac.h>
+#include <openssl/sha.h>
+
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+// number of signatures to verify, a multiple of CH_NM
+#define NUM_TESTS 8
+
+ap_uint<256> bn2ap(const BIGNUM* bn) {
+    unsigned char buf[32];
+    BN_bn2binpad(bn, buf, 32);
+    ap_uint<256> r = 0;
+    for (int i = 0; i < 32; i++) {
+        r.range(255 - 8 * i, 248 - 8 * i) = buf[i];
+    }
+    return r;
+}
+
+int main() {
+    hls::stream<ap_uint<256> > hashStrm("hashStrm");
+    hls::stream<ap_uint<512> > sigStrm("sigStrm");
+    hls::stream<ap_uint<512> > pubKeyStrm("pubKeyStrm");
+    hls::stream<bool> endInStrm("endInStrm");
+    hls::stream<bool> resultStrm("resultStrm");
+
+    EC_GROUP* group = EC_GROUP_new_by_curve_name(NID_X9_62_prime256v1);
+    BIGNUM* x = BN_new();
+    BIGNUM* y = BN_new();
+    bool golden[NUM_TESTS];
+
+    for (int t = 0; t < NUM_TESTS; t++) {
+        if (t % CH_NM == 0) {
+            endInStrm.write(false);
+        }
+        // one key per signature, signing its own message
+        EC_KEY* key = EC_KEY_new_by_curve_name(NID_X9_62_prime256v1);
+        EC_KEY_generate_key(key);
+        char msg[64];
+        sprintf(msg, "ECDSA P-256 test message %d", t);
+        unsigned char digest[SHA256_DIGEST_LENGTH];
+        SHA256((const unsigned char*)msg, strlen(msg), digest);
+        ECDSA_SIG* sig = ECDSA_do_sign(digest, SHA256_DIGEST_LENGTH, key);
+        EC_POINT_get_affine_coordinates(group, EC_KEY_get0_public_key(key), x, y, NULL);
+
+        ap_uint<256> hash = 0;
+        for (int i = 0; i < 32; i++) {
+            hash.range(255 - 8 * i, 248 - 8 * i) = digest[i];
+        }
+        ap_uint<512> signature, pubKey;
+        signature.range(255, 0) = bn2ap(ECDSA_SIG_get0_r(sig));
+        signature.range(511, 256) = bn2ap(ECDSA_SIG_get0_s(sig));
+        pubKey.range(255, 0) = bn2ap(x);
+        pubKey.range(511, 256) = bn2ap(y);
+
+        // every other case is tampered with: message, signature, or public key
+        golden[t] = true;
+        if (t % 4 == 1) {
+            hash[0] = ~hash[0];
+            golden[t] = false;
+        } else if (t % 4 == 2) {
+            signature[300] = ~signature[300];
+            golden[t] = false;
+        } else if (t % 8 == 3) {
+            pubKey[0] = ~pubKey[0];
+            golden[t] = false;
+        } else if (t % 8 == 7) {
+            signature.range(255, 0) = 0;
+            golden[t] = false;
+        }
+        hashStrm.write(hash);
+        sigStrm.write(signature);
+        pubKeyStrm.write(pubKey);
+
+        ECDSA_SIG_free(sig);
+        EC_KEY_free(key);
+    }
+    endInStrm.write(true);
+
+    test(hashStrm, sigStrm, pubKeyStrm, endInStrm, resultStrm);
+
+    int nerror = 0;
+    for (int t = 0; t < NUM_TESTS; t++) {
+        bool result = resultStrm.read();
+        std::cout << "signature " << t << ": " << (result ? "valid" : "invalid") << std::endl;
+        if (result != golden[t]) {
+            std::cout << "Error: expected " << (golden[t] ? "valid" : "invalid") << std::endl;
+            nerror++;
+        }
+    }
+
+    BN_free(x);
+    BN_free(y);
+    EC_GROUP_free(group);
+
+    if (nerror) {
+        std::cout << "FAIL: " << nerror << " errors found." << std::endl;
+    } else {
+        std::cout << "PASS: " << NUM_TESTS << " signatures verified." << std::endl;
+    }
+    return nerror;
+}
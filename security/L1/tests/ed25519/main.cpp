@@ -0,0 +1,121 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "test.hpp"
+
+#include <openssl/evp.h>
+#include <openssl/sha.h>
+
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+// number of signatures to verify, a multiple of CH_NM
+#define NUM_TESTS 8
+
+int main() {
+    hls::stream<ap_uint<512> > digestStrm("digestStrm");
+    hls::stream<ap_uint<512> > sigStrm("sigStrm");
+    hls::stream<ap_uint<256> > pubKeyStrm("pubKeyStrm");
+    hls::stream<bool> endInStrm("endInStrm");
+    hls::stream<bool> resultStrm("resultStrm");
+
+    bool golden[NUM_TESTS];
+
+    for (int t = 0; t < NUM_TESTS; t++) {
+        if (t % CH_NM == 0) {
+            endInStrm.write(false);
+        }
+        // one key per signature, signing its own message
+        EVP_PKEY* pkey = NULL;
+        EVP_PKEY_CTX* kctx = EVP_PKEY_CTX_new_id(EVP_PKEY_ED25519, NULL);
+        EVP_PKEY_keygen_init(kctx);
+        EVP_PKEY_keygen(kctx, &pkey);
+        EVP_PKEY_CTX_free(kctx);
+
+        char msg[64];
+        sprintf(msg, "Ed25519 test message %d", t);
+        size_t msgLen = strlen(msg);
+        unsigned char sig[64];
+        size_t sigLen = sizeof(sig);
+        EVP_MD_CTX* mctx = EVP_MD_CTX_new();
+        EVP_DigestSignInit(mctx, NULL, NULL, NULL, pkey);
+        EVP_DigestSign(mctx, sig, &sigLen, (const unsigned char*)msg, msgLen);
+        EVP_MD_CTX_free(mctx);
+        unsigned char pub[32];
+        size_t pubLen = sizeof(pub);
+        EVP_PKEY_get_raw_public_key(pkey, pub, &pubLen);
+        EVP_PKEY_free(pkey);
+
+        // every other case is tampered with: message, signature, or public key
+        golden[t] = true;
+        if (t % 4 == 1) {
+            msg[0] ^= 1;
+            golden[t] = false;
+        } else if (t % 4 == 2) {
+            sig[40] ^= 1;
+            golden[t] = false;
+        } else if (t % 8 == 3) {
+            pub[0] ^= 1;
+            golden[t] = false;
+        } else if (t % 8 == 7) {
+            sig[5] ^= 1;
+            golden[t] = false;
+        }
+
+        // k = SHA-512(R || A || M)
+        unsigned char digest[SHA512_DIGEST_LENGTH];
+        SHA512_CTX sctx;
+        SHA512_Init(&sctx);
+        SHA512_Update(&sctx, sig, 32);
+        SHA512_Update(&sctx, pub, 32);
+        SHA512_Update(&sctx, msg, msgLen);
+        SHA512_Final(digest, &sctx);
+
+        ap_uint<512> apDigest, apSig;
+        ap_uint<256> apPub;
+        for (int i = 0; i < 64; i++) {
+            apDigest.range(8 * i + 7, 8 * i) = digest[i];
+            apSig.range(8 * i + 7, 8 * i) = sig[i];
+        }
+        for (int i = 0; i < 32; i++) {
+            apPub.range(8 * i + 7, 8 * i) = pub[i];
+        }
+        digestStrm.write(apDigest);
+        sigStrm.write(apSig);
+        pubKeyStrm.write(apPub);
+    }
+    endInStrm.write(true);
+
+    test(digestStrm, sigStrm, pubKeyStrm, endInStrm, resultStrm);
+
+    int nerror = 0;
+    for (int t = 0; t < NUM_TESTS; t++) {
+        bool result = resultStrm.read();
+        std::cout << "signature " << t << ": " << (result ? "valid" : "invalid") << std::endl;
+        if (result != golden[t]) {
+            std::cout << "Error: expected " << (golden[t] ? "valid" : "invalid") << std::endl;
+            nerror++;
+        }
+    }
+
+    if (nerror) {
+        std::cout << "FAIL: " << nerror << " errors found." << std::endl;
+    } else {
+        std::cout << "PASS: " << NUM_TESTS << " signatures verified." << std::endl;
+    }
+    return nerror;
+}
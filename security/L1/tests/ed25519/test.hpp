@@ -0,0 +1,31 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _TEST_H_
+#define _TEST_H_
+
+#include <ap_int.h>
+#include <hls_stream.h>
+
+// number of verifications in flight
+#define CH_NM 4
+
+void test(hls::stream<ap_uint<512> >& digestStrm,
+          hls::stream<ap_uint<512> >& sigStrm,
+          hls::stream<ap_uint<256> >& pubKeyStrm,
+          hls::stream<bool>& endInStrm,
+          hls::stream<bool>& resultStrm);
+#endif
@@ -0,0 +1,196 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "test.hpp"
+
+#include <openssl/evp.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+// number of packets, a multiple of CH_NM
+#define NUM_PKT 12
+
+struct Packet {
+    int keyId;
+    unsigned char iv[12];
+    std::vector<unsigned char> aad;
+    std::vector<unsigned char> plain;
+    std::vector<unsigned char> cipher;
+    unsigned char tag[16];
+};
+
+ap_uint<128> getBlock(const std::vector<unsigned char>& data, int blk) {
+    ap_uint<128> r = 0;
+    for (int i = 0; i < 16 && blk * 16 + i < (int)data.size(); i++) {
+        r.range(i * 8 + 7, i * 8) = data[blk * 16 + i];
+    }
+    return r;
+}
+
+int blocks(const std::vector<unsigned char>& data) {
+    return (data.size() + 15) / 16;
+}
+
+// feed one direction of all packets, and check the output blocks and tags
+int run(bool isEncrypt, unsigned char keys[KEY_NM][32], std::vector<Packet>& pkts) {
+    hls::stream<ap_uint<32> > tableIdStrm("tableIdStrm");
+    hls::stream<ap_uint<256> > cipherkeyStrm("cipherkeyStrm");
+    hls::stream<bool> endKeyStrm("endKeyStrm");
+    hls::stream<ap_uint<32> > keyIdStrm("keyIdStrm");
+    hls::stream<ap_uint<96> > IVStrm("IVStrm");
+    hls::stream<ap_uint<64> > lenAADStrm("lenAADStrm");
+    hls::stream<ap_uint<64> > lenPldStrm("lenPldStrm");
+    hls::stream<bool> endLenStrm("endLenStrm");
+    hls::stream<ap_uint<128> > AADStrm("AADStrm");
+    hls::stream<ap_uint<128> > inStrm("inStrm");
+    hls::stream<ap_uint<128> > outStrm("outStrm");
+    hls::stream<ap_uint<128> > tagStrm("tagStrm");
+
+    for (int k = 0; k < KEY_NM; k++) {
+        ap_uint<256> key;
+        for (int i = 0; i < 32; i++) {
+            key.range(i * 8 + 7, i * 8) = keys[k][i];
+        }
+        endKeyStrm.write(false);
+        tableIdStrm.write(k);
+        cipherkeyStrm.write(key);
+    }
+    endKeyStrm.write(true);
+
+    for (int b = 0; b < NUM_PKT / CH_NM; b++) {
+        endLenStrm.write(false);
+        int rounds = 0;
+        for (int c = 0; c < CH_NM; c++) {
+            Packet& p = pkts[b * CH_NM + c];
+            ap_uint<96> iv;
+            for (int i = 0; i < 12; i++) {
+                iv.range(i * 8 + 7, i * 8) = p.iv[i];
+            }
+            keyIdStrm.write(p.keyId);
+            IVStrm.write(iv);
+            lenAADStrm.write(p.aad.size() * 8);
+            lenPldStrm.write(p.plain.size() * 8);
+            int n = blocks(p.aad) + blocks(p.plain) + 2;
+            rounds = n > rounds ? n : rounds;
+        }
+        // round-robin order of the input blocks
+        for (int r = 1; r < rounds; r++) {
+            for (int c = 0; c < CH_NM; c++) {
+                Packet& p = pkts[b * CH_NM + c];
+                int ba = blocks(p.aad);
+                if (r <= ba) {
+                    AADStrm.write(getBlock(p.aad, r - 1));
+                } else if (r <= ba + blocks(p.plain)) {
+                    inStrm.write(getBlock(isEncrypt ? p.plain : p.cipher, r - 1 - ba));
+                }
+            }
+        }
+    }
+    endLenStrm.write(true);
+
+    test(isEncrypt, tableIdStrm, cipherkeyStrm, endKeyStrm, keyIdStrm, IVStrm, lenAADStrm, lenPldStrm, endLenStrm,
+         AADStrm, inStrm, outStrm, tagStrm);
+
+    int nerror = 0;
+    for (int b = 0; b < NUM_PKT / CH_NM; b++) {
+        int rounds = 0;
+        for (int c = 0; c < CH_NM; c++) {
+            Packet& p = pkts[b * CH_NM + c];
+            int n = blocks(p.aad) + blocks(p.plain) + 2;
+            rounds = n > rounds ? n : rounds;
+        }
+        for (int r = 1; r < rounds; r++) {
+            for (int c = 0; c < CH_NM; c++) {
+                Packet& p = pkts[b * CH_NM + c];
+                int ba = blocks(p.aad);
+                if (r > ba && r <= ba + blocks(p.plain)) {
+                    ap_uint<128> out = outStrm.read();
+                    if (out != getBlock(isEncrypt ? p.cipher : p.plain, r - 1 - ba)) {
+                        std::cout << "Error: packet " << b * CH_NM + c << " block " << r - 1 - ba << std::endl;
+                        nerror++;
+                    }
+                }
+            }
+        }
+        for (int c = 0; c < CH_NM; c++) {
+            Packet& p = pkts[b * CH_NM + c];
+            ap_uint<128> tag = tagStrm.read();
+            ap_uint<128> golden;
+            for (int i = 0; i < 16; i++) {
+                golden.range(i * 8 + 7, i * 8) = p.tag[i];
+            }
+            if (tag != golden) {
+                std::cout << "Error: tag of packet " << b * CH_NM + c << std::endl;
+                nerror++;
+            }
+        }
+    }
+    return nerror;
+}
+
+int main() {
+    unsigned char keys[KEY_NM][32];
+    for (int k = 0; k < KEY_NM; k++) {
+        for (int i = 0; i < 32; i++) {
+            keys[k][i] = rand();
+        }
+    }
+
+    // IPsec / TLS record like packets of 64 to 1500 bytes, with different flows and AAD lengths
+    std::vector<Packet> pkts(NUM_PKT);
+    for (int t = 0; t < NUM_PKT; t++) {
+        Packet& p = pkts[t];
+        p.keyId = (t * 5) % KEY_NM;
+        for (int i = 0; i < 12; i++) {
+            p.iv[i] = rand();
+        }
+        p.aad.resize((t * 7) % 29);
+        p.plain.resize(64 + (t * 397) % 1437);
+        for (size_t i = 0; i < p.aad.size(); i++) {
+            p.aad[i] = rand();
+        }
+        for (size_t i = 0; i < p.plain.size(); i++) {
+            p.plain[i] = rand();
+        }
+        p.cipher.resize(p.plain.size());
+
+        int outlen = 0;
+        EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
+        EVP_EncryptInit_ex(ctx, EVP_aes_256_gcm(), NULL, NULL, NULL);
+        EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_SET_IVLEN, 12, NULL);
+        EVP_EncryptInit_ex(ctx, NULL, NULL, keys[p.keyId], p.iv);
+        if (p.aad.size() > 0) {
+            EVP_EncryptUpdate(ctx, NULL, &outlen, p.aad.data(), p.aad.size());
+        }
+        EVP_EncryptUpdate(ctx, p.cipher.data(), &outlen, p.plain.data(), p.plain.size());
+        EVP_EncryptFinal_ex(ctx, p.cipher.data() + outlen, &outlen);
+        EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_GET_TAG, 16, p.tag);
+        EVP_CIPHER_CTX_free(ctx);
+    }
+
+    int nerror = run(true, keys, pkts);
+    nerror += run(false, keys, pkts);
+
+    if (nerror) {
+        std::cout << "FAIL: " << nerror << " errors found." << std::endl;
+    } else {
+        std::cout << "PASS: " << NUM_PKT << " packets encrypted and decrypted." << std::endl;
+    }
+    return nerror;
+}
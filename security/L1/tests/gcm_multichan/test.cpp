@@ -0,0 +1,45 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "test.hpp"
+#include "xf_security/gcm.hpp"
+
+void test(bool isEncrypt,
+          hls::stream<ap_uint<32> >& tableIdStrm,
+          hls::stream<ap_uint<256> >& cipherkeyStrm,
+          hls::stream<bool>& endKeyStrm,
+          hls::stream<ap_uint<32> >& keyIdStrm,
+          hls::stream<ap_uint<96> >& IVStrm,
+          hls::stream<ap_uint<64> >& lenAADStrm,
+          hls::stream<ap_uint<64> >& lenPldStrm,
+          hls::stream<bool>& endLenStrm,
+          hls::stream<ap_uint<128> >& AADStrm,
+          hls::stream<ap_uint<128> >& inStrm,
+          hls::stream<ap_uint<128> >& outStrm,
+          hls::stream<ap_uint<128> >& tagStrm) {
+    xf::security::aesGcmMultiChan<256, CH_NM, KEY_NM> engine;
+
+    // install the keys of all flows
+    while (!endKeyStrm.read()) {
+        engine.updateKey(tableIdStrm.read(), cipherkeyStrm.read());
+    }
+
+    if (isEncrypt) {
+        engine.encrypt(keyIdStrm, IVStrm, lenAADStrm, lenPldStrm, endLenStrm, AADStrm, inStrm, outStrm, tagStrm);
+    } else {
+        engine.decrypt(keyIdStrm, IVStrm, lenAADStrm, lenPldStrm, endLenStrm, AADStrm, inStrm, outStrm, tagStrm);
+    }
+}
@@ -0,0 +1,41 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _TEST_H_
+#define _TEST_H_
+
+#include <ap_int.h>
+#include <hls_stream.h>
+
+// number of packets in one batch
+#define CH_NM 4
+// number of entries in the key table
+#define KEY_NM 8
+
+void test(bool isEncrypt,
+          hls::stream<ap_uint<32> >& tableIdStrm,
+          hls::stream<ap_uint<256> >& cipherkeyStrm,
+          hls::stream<bool>& endKeyStrm,
+          hls::stream<ap_uint<32> >& keyIdStrm,
+          hls::stream<ap_uint<96> >& IVStrm,
+          hls::stream<ap_uint<64> >& lenAADStrm,
+          hls::stream<ap_uint<64> >& lenPldStrm,
+          hls::stream<bool>& endLenStrm,
+          hls::stream<ap_uint<128> >& AADStrm,
+          hls::stream<ap_uint<128> >& inStrm,
+          hls::stream<ap_uint<128> >& outStrm,
+          hls::stream<ap_uint<128> >& tagStrm);
+#endif
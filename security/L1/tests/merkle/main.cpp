@@ -0,0 +1,139 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "test.hpp"
+
+#include <openssl/sha.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+typedef std::vector<unsigned char> Bytes;
+
+// reference tree with the RFC 6962 prefixes, all nodes level by level with the odd node carried up
+std::vector<Bytes> refTree(const std::vector<Bytes>& leaves) {
+    std::vector<Bytes> all, level;
+    for (size_t i = 0; i < leaves.size(); i++) {
+        Bytes leaf(1, 0x00);
+        leaf.insert(leaf.end(), leaves[i].begin(), leaves[i].end());
+        Bytes md(32);
+        SHA256(leaf.data(), leaf.size(), md.data());
+        level.push_back(md);
+    }
+    all.insert(all.end(), level.begin(), level.end());
+    while (level.size() > 1) {
+        std::vector<Bytes> next;
+        for (size_t i = 0; i + 1 < level.size(); i += 2) {
+            unsigned char pair[65];
+            pair[0] = 0x01;
+            memcpy(pair + 1, level[i].data(), 32);
+            memcpy(pair + 33, level[i + 1].data(), 32);
+            Bytes md(32);
+            SHA256(pair, 65, md.data());
+            next.push_back(md);
+        }
+        if (level.size() & 1) {
+            next.push_back(level.back());
+        }
+        all.insert(all.end(), next.begin(), next.end());
+        level = next;
+    }
+    return all;
+}
+
+int run(const std::vector<Bytes>& leaves, bool outputAll) {
+    hls::stream<ap_uint<512> > msgStrm("msgStrm");
+    hls::stream<ap_uint<64> > lenStrm("lenStrm");
+    hls::stream<bool> endLenStrm("endLenStrm");
+    hls::stream<ap_uint<256> > nodeStrm("nodeStrm");
+    hls::stream<bool> endNodeStrm("endNodeStrm");
+
+    int num = leaves.size();
+    for (int g = 0; g < num; g += LANE_NM) {
+        int n = (num - g < LANE_NM) ? num - g : LANE_NM;
+        int maxBlk = 0;
+        for (int c = 0; c < n; c++) {
+            int len = leaves[g + c].size();
+            endLenStrm.write(false);
+            lenStrm.write(len);
+            maxBlk = (len + 63) / 64 > maxBlk ? (len + 63) / 64 : maxBlk;
+        }
+        // block k of every leaf in the group before block k + 1
+        for (int k = 0; k < maxBlk; k++) {
+            for (int c = 0; c < n; c++) {
+                const Bytes& msg = leaves[g + c];
+                if (k * 64 < (int)msg.size()) {
+                    ap_uint<512> blk = 0;
+                    for (int i = 0; i < 64 && k * 64 + i < (int)msg.size(); i++) {
+                        blk.range(i * 8 + 7, i * 8) = msg[k * 64 + i];
+                    }
+                    msgStrm.write(blk);
+                }
+            }
+        }
+    }
+    endLenStrm.write(true);
+
+    test(msgStrm, lenStrm, endLenStrm, outputAll, nodeStrm, endNodeStrm);
+
+    std::vector<Bytes> golden = refTree(leaves);
+    if (!outputAll && golden.size() > 0) {
+        golden.erase(golden.begin(), golden.end() - 1);
+    }
+    int nerror = 0;
+    for (size_t j = 0; j < golden.size(); j++) {
+        ap_uint<256> g;
+        for (int i = 0; i < 32; i++) {
+            g.range(i * 8 + 7, i * 8) = golden[j][i];
+        }
+        if (endNodeStrm.read() || nodeStrm.read() != g) {
+            std::cout << "Error: node " << j << " of a tree with " << num << " leaves" << std::endl;
+            nerror++;
+        }
+    }
+    if (!endNodeStrm.read()) {
+        std::cout << "Error: end of nodes of a tree with " << num << " leaves" << std::endl;
+        nerror++;
+    }
+    return nerror;
+}
+
+int main() {
+    // trees of odd and even sizes, including a single leaf and no leaf
+    const int leafNums[] = {0, 1, 2, 3, 5, 8, 13, 32};
+    int nerror = 0;
+    for (int t = 0; t < (int)(sizeof(leafNums) / sizeof(int)); t++) {
+        std::vector<Bytes> leaves(leafNums[t]);
+        for (int i = 0; i < leafNums[t]; i++) {
+            // lengths of 0 and a multiple of 64 take one more block with the prefix
+            leaves[i].resize(i % 4 == 1 ? 64 * (i % 3) : 100 + (i * 211) % 900);
+            for (size_t j = 0; j < leaves[i].size(); j++) {
+                leaves[i][j] = rand();
+            }
+        }
+        nerror += run(leaves, true);
+        nerror += run(leaves, false);
+    }
+
+    if (nerror) {
+        std::cout << "FAIL: " << nerror << " errors found." << std::endl;
+    } else {
+        std::cout << "PASS: all Merkle trees match." << std::endl;
+    }
+    return nerror;
+}
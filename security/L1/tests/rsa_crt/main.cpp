@@ -0,0 +1,107 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "test.hpp"
+
+#include <openssl/bn.h>
+#include <openssl/rsa.h>
+
+#include <iostream>
+
+template <int W>
+ap_uint<W> bn2ap(const BIGNUM* bn) {
+    unsigned char buf[W / 8];
+    BN_bn2binpad(bn, buf, W / 8);
+    ap_uint<W> r = 0;
+    for (int i = 0; i < W / 8; i++) {
+        r.range(W - 1 - 8 * i, W - 8 - 8 * i) = buf[i];
+    }
+    return r;
+}
+
+int main() {
+    hls::stream<ap_uint<1024> > pStrm("pStrm");
+    hls::stream<ap_uint<1024> > qStrm("qStrm");
+    hls::stream<ap_uint<1024> > dPStrm("dPStrm");
+    hls::stream<ap_uint<1024> > dQStrm("dQStrm");
+    hls::stream<ap_uint<1024> > qInvStrm("qInvStrm");
+    hls::stream<ap_uint<2048> > modulusStrm("modulusStrm");
+    hls::stream<ap_uint<2048> > exponentStrm("exponentStrm");
+    hls::stream<ap_uint<2048> > cipherStrm("cipherStrm");
+    hls::stream<ap_uint<2048> > plainStrm("plainStrm");
+    hls::stream<ap_uint<2048> > reEncStrm("reEncStrm");
+
+    ap_uint<2048> golden[CTX_NM];
+    ap_uint<2048> cipher[CTX_NM];
+    BN_CTX* bnCtx = BN_CTX_new();
+    BIGNUM* e = BN_new();
+    BN_set_word(e, RSA_F4);
+
+    for (int t = 0; t < CTX_NM; t++) {
+        // one key per context, each decrypting its own cipher text
+        RSA* key = RSA_new();
+        RSA_generate_key_ex(key, 2048, e, NULL);
+        const BIGNUM *n, *pubExp, *p, *q, *dP, *dQ, *qInv;
+        RSA_get0_key(key, &n, &pubExp, NULL);
+        RSA_get0_factors(key, &p, &q);
+        RSA_get0_crt_params(key, &dP, &dQ, &qInv);
+
+        BIGNUM* m = BN_new();
+        BIGNUM* c = BN_new();
+        BN_rand_range(m, n);
+        BN_mod_exp(c, m, pubExp, n, bnCtx);
+        golden[t] = bn2ap<2048>(m);
+        cipher[t] = bn2ap<2048>(c);
+
+        pStrm.write(bn2ap<1024>(p));
+        qStrm.write(bn2ap<1024>(q));
+        dPStrm.write(bn2ap<1024>(dP));
+        dQStrm.write(bn2ap<1024>(dQ));
+        qInvStrm.write(bn2ap<1024>(qInv));
+        modulusStrm.write(bn2ap<2048>(n));
+        exponentStrm.write(bn2ap<2048>(pubExp));
+        cipherStrm.write(cipher[t]);
+
+        BN_free(m);
+        BN_free(c);
+        RSA_free(key);
+    }
+    BN_free(e);
+    BN_CTX_free(bnCtx);
+
+    test(pStrm, qStrm, dPStrm, dQStrm, qInvStrm, modulusStrm, exponentStrm, cipherStrm, plainStrm, reEncStrm);
+
+    int nerror = 0;
+    for (int t = 0; t < CTX_NM; t++) {
+        ap_uint<2048> plain = plainStrm.read();
+        ap_uint<2048> reEnc = reEncStrm.read();
+        if (plain != golden[t]) {
+            std::cout << "Error: decryption of context " << t << " does not match" << std::endl;
+            nerror++;
+        }
+        if (reEnc != cipher[t]) {
+            std::cout << "Error: encryption of context " << t << " does not match" << std::endl;
+            nerror++;
+        }
+    }
+
+    if (nerror) {
+        std::cout << "FAIL: " << nerror << " errors found." << std::endl;
+    } else {
+        std::cout << "PASS: " << CTX_NM << " contexts decrypted and encrypted." << std::endl;
+    }
+    return nerror;
+}
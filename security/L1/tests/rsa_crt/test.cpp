@@ -0,0 +1,57 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "test.hpp"
+#include "xf_security/asymmetric.hpp"
+
+// decrypt with CRT, then encrypt the plain texts back with the public keys
+void test(hls::stream<ap_uint<1024> >& pStrm,
+          hls::stream<ap_uint<1024> >& qStrm,
+          hls::stream<ap_uint<1024> >& dPStrm,
+          hls::stream<ap_uint<1024> >& dQStrm,
+          hls::stream<ap_uint<1024> >& qInvStrm,
+          hls::stream<ap_uint<2048> >& modulusStrm,
+          hls::stream<ap_uint<2048> >& exponentStrm,
+          hls::stream<ap_uint<2048> >& cipherStrm,
+          hls::stream<ap_uint<2048> >& plainStrm,
+          hls::stream<ap_uint<2048> >& reEncStrm) {
+    ap_uint<1024> p[CTX_NM], q[CTX_NM], dP[CTX_NM], dQ[CTX_NM], qInv[CTX_NM];
+    ap_uint<2048> modulus[CTX_NM], exponent[CTX_NM], cipher[CTX_NM], plain[CTX_NM], reEnc[CTX_NM];
+
+    for (int i = 0; i < CTX_NM; i++) {
+        p[i] = pStrm.read();
+        q[i] = qStrm.read();
+        dP[i] = dPStrm.read();
+        dQ[i] = dQStrm.read();
+        qInv[i] = qInvStrm.read();
+        modulus[i] = modulusStrm.read();
+        exponent[i] = exponentStrm.read();
+        cipher[i] = cipherStrm.read();
+    }
+
+    xf::security::rsaCrtMultiCtx<32, 64, CTX_NM> crt;
+    crt.updateKey(p, q, dP, dQ, qInv);
+    crt.process(cipher, plain);
+
+    xf::security::rsaMultiCtx<32, 64, CTX_NM> pub;
+    pub.updateKey(modulus, exponent);
+    pub.process(plain, reEnc);
+
+    for (int i = 0; i < CTX_NM; i++) {
+        plainStrm.write(plain[i]);
+        reEncStrm.write(reEnc[i]);
+    }
+}
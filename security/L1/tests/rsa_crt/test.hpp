@@ -0,0 +1,36 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _TEST_H_
+#define _TEST_H_
+
+#include <ap_int.h>
+#include <hls_stream.h>
+
+// number of independent keys in flight
+#define CTX_NM 4
+
+void test(hls::stream<ap_uint<1024> >& pStrm,
+          hls::stream<ap_uint<1024> >& qStrm,
+          hls::stream<ap_uint<1024> >& dPStrm,
+          hls::stream<ap_uint<1024> >& dQStrm,
+          hls::stream<ap_uint<1024> >& qInvStrm,
+          hls::stream<ap_uint<2048> >& modulusStrm,
+          hls::stream<ap_uint<2048> >& exponentStrm,
+          hls::stream<ap_uint<2048> >& cipherStrm,
+          hls::stream<ap_uint<2048> >& plainStrm,
+          hls::stream<ap_uint<2048> >& reEncStrm);
+#endif
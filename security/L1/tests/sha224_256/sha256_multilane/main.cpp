@@ -0,0 +1,97 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "test.hpp"
+
+#include <openssl/sha.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+// number of messages, the last group is not full
+#define NUM_MSG 21
+
+int main() {
+    // block boundaries, padding corner cases and some 4 KB chunks
+    std::vector<std::vector<unsigned char> > msgs(NUM_MSG);
+    const int lens[NUM_MSG] = {0,   1,   55,   56,   63,   64,   65,   119,  120,  127, 128,
+                               200, 511, 4096, 4096, 4000, 1000, 3333, 4096, 5,   64};
+    for (int m = 0; m < NUM_MSG; m++) {
+        msgs[m].resize(lens[m]);
+        for (int i = 0; i < lens[m]; i++) {
+            msgs[m][i] = rand();
+        }
+    }
+
+    hls::stream<ap_uint<512> > msgStrm("msgStrm");
+    hls::stream<ap_uint<64> > lenStrm("lenStrm");
+    hls::stream<bool> endLenStrm("endLenStrm");
+    hls::stream<ap_uint<256> > hashStrm("hashStrm");
+    hls::stream<bool> endHashStrm("endHashStrm");
+
+    for (int g = 0; g < NUM_MSG; g += LANE_NM) {
+        int n = (NUM_MSG - g < LANE_NM) ? NUM_MSG - g : LANE_NM;
+        int maxBlk = 0;
+        for (int c = 0; c < n; c++) {
+            int len = msgs[g + c].size();
+            endLenStrm.write(false);
+            lenStrm.write(len);
+            maxBlk = (len + 63) / 64 > maxBlk ? (len + 63) / 64 : maxBlk;
+        }
+        // block k of every message in the group before block k + 1
+        for (int k = 0; k < maxBlk; k++) {
+            for (int c = 0; c < n; c++) {
+                std::vector<unsigned char>& msg = msgs[g + c];
+                if (k * 64 < (int)msg.size()) {
+                    ap_uint<512> blk = 0;
+                    for (int i = 0; i < 64 && k * 64 + i < (int)msg.size(); i++) {
+                        blk.range(i * 8 + 7, i * 8) = msg[k * 64 + i];
+                    }
+                    msgStrm.write(blk);
+                }
+            }
+        }
+    }
+    endLenStrm.write(true);
+
+    test(msgStrm, lenStrm, endLenStrm, hashStrm, endHashStrm);
+
+    int nerror = 0;
+    for (int m = 0; m < NUM_MSG; m++) {
+        unsigned char md[SHA256_DIGEST_LENGTH];
+        SHA256(msgs[m].data(), msgs[m].size(), md);
+        ap_uint<256> golden;
+        for (int i = 0; i < 32; i++) {
+            golden.range(i * 8 + 7, i * 8) = md[i];
+        }
+        if (endHashStrm.read() || hashStrm.read() != golden) {
+            std::cout << "Error: hash of message " << m << " with " << lens[m] << " bytes" << std::endl;
+            nerror++;
+        }
+    }
+    if (!endHashStrm.read()) {
+        std::cout << "Error: end of hashes" << std::endl;
+        nerror++;
+    }
+
+    if (nerror) {
+        std::cout << "FAIL: " << nerror << " errors found." << std::endl;
+    } else {
+        std::cout << "PASS: " << NUM_MSG << " messages hashed." << std::endl;
+    }
+    return nerror;
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file batch.hpp
+ * @brief layout of the batch transferred to the security overlay kernel.
+ * This file is part of Vitis Security Library.
+ *
+ * @detail The host packs many small records into one input buffer made of 64-byte blocks: one header block, one
+ * descriptor block per record, then the keys, the AADs and the payloads, each starting on a block boundary. For
+ * each record the kernel writes its output text, then one block holding its tag or digest, except for CBC which has
+ * none. This header is shared by the host library and the kernel, so it has no dependency.
+ */
+
+#ifndef _XF_SECURITY_BATCH_HPP_
+#define _XF_SECURITY_BATCH_HPP_
+
+namespace xf {
+namespace security {
+
+// size of a block of the batch buffers in bytes
+#define XF_SECURITY_BATCH_BLK 64
+// number of blocks the kernel addresses in each of the input and output batch buffers
+#define XF_SECURITY_BATCH_MAX_BLK (1 << 20)
+
+/**
+ * @brief Operation of a record.
+ */
+enum batchOp {
+    BATCH_GCM_ENC = 0, ///< AES-256-GCM encryption, outputs the cipher text and the 16-byte tag.
+    BATCH_GCM_DEC,     ///< AES-256-GCM decryption, outputs the plain text and the 16-byte tag to be checked.
+    BATCH_CBC_ENC,     ///< AES-256-CBC encryption without padding, outputs the cipher text.
+    BATCH_CBC_DEC,     ///< AES-256-CBC decryption without padding, outputs the plain text.
+    BATCH_HMAC_SHA256, ///< HMAC-SHA256 with a key of up to 64 bytes, outputs the 32-byte MAC.
+    BATCH_SHA256       ///< SHA-256, outputs the 32-byte digest.
+};
+
+/**
+ * @brief Byte offset of the fields in the header block, all little-endian.
+ */
+enum batchHeader {
+    BATCH_HDR_REC_NUM = 0 ///< uint32_t, number of records, the descriptors are in blocks 1 to BATCH_HDR_REC_NUM.
+};
+
+/**
+ * @brief Byte offset of the fields in a descriptor block, all little-endian.
+ *
+ * Block indexes of the input fields count from the start of the input buffer, and the output block index counts
+ * from the start of the output buffer.
+ */
+enum batchDesc {
+    BATCH_DESC_OP = 0,        ///< uint8_t, the batchOp of the record.
+    BATCH_DESC_KEY_LEN = 1,   ///< uint8_t, length of the key in bytes.
+    BATCH_DESC_KEY_BLK = 4,   ///< uint32_t, block index of the key.
+    BATCH_DESC_DATA_BLK = 8,  ///< uint32_t, block index of the payload.
+    BATCH_DESC_DATA_LEN = 12, ///< uint32_t, length of the payload in bytes.
+    BATCH_DESC_AAD_BLK = 16,  ///< uint32_t, block index of the AAD.
+    BATCH_DESC_AAD_LEN = 20,  ///< uint32_t, length of the AAD in bytes.
+    BATCH_DESC_OUT_BLK = 24,  ///< uint32_t, block index of the output.
+    BATCH_DESC_IV = 32        ///< 16 bytes, the IV, GCM uses the first 12 bytes.
+};
+
+} // end of namespace security
+} // end of namespace xf
+
+#endif // _XF_SECURITY_BATCH_HPP_
@@ -0,0 +1,227 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file session.hpp
+ * @brief header file for the session-oriented host API of the security overlay.
+ * This file is part of Vitis Security Library.
+ *
+ * @detail Applications open a session per cipher and key, and submit records to the engine from any thread. The
+ * engine packs the queued records into one batch with a descriptor table, moves it to the card in one transfer and
+ * runs the overlay kernel once, so the cost of a kernel call is shared by all the records. Small batches, and all
+ * batches when no card is set up, are processed on the CPU with OpenSSL.
+ */
+
+#ifndef _XF_SECURITY_SESSION_HPP_
+#define _XF_SECURITY_SESSION_HPP_
+
+#include <stdint.h>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "xcl2.hpp"
+
+#include "xf_security/batch.hpp"
+#include "xf_security/submit_ring.hpp"
+
+namespace xf {
+namespace security {
+
+/**
+ * @brief Algorithm of a session.
+ */
+enum cryptoAlgo {
+    CRYPTO_AES256_GCM = 0, ///< AES-256-GCM with a 12-byte IV and a 16-byte tag.
+    CRYPTO_AES256_CBC,     ///< AES-256-CBC without padding, the payload is a multiple of 16 bytes.
+    CRYPTO_HMAC_SHA256,    ///< HMAC-SHA256, a key longer than 64 bytes is hashed when the session is opened.
+    CRYPTO_SHA256          ///< SHA-256, the session has no key.
+};
+
+/**
+ * @brief Status of a record.
+ */
+enum cryptoStatus {
+    CRYPTO_PENDING = 0, ///< Submitted and not completed yet.
+    CRYPTO_OK,          ///< Completed.
+    CRYPTO_AUTH_FAIL,   ///< GCM decryption with a wrong tag, the output is cleared.
+    CRYPTO_INVALID      ///< Rejected, the record does not fit its algorithm or the batch buffer.
+};
+
+class cryptoEngine;
+
+/**
+ * @brief cryptoSession holds an algorithm and its key. It is created and released by cryptoEngine.
+ */
+class cryptoSession {
+   public:
+    /**
+     * @brief Algorithm of the session.
+     */
+    cryptoAlgo algo() const { return mAlgo; }
+
+   private:
+    friend class cryptoEngine;
+
+    cryptoSession(cryptoAlgo algo, const unsigned char* key, unsigned int keyLen);
+
+    cryptoAlgo mAlgo;
+    unsigned char mKey[XF_SECURITY_BATCH_BLK];
+    unsigned int mKeyLen;
+    // key block of the session in the batch being packed, valid when mBatchId is the id of that batch
+    uint64_t mBatchId;
+    uint32_t mKeyBlk;
+};
+
+/**
+ * @brief cryptoRecord describes one operation. The caller owns it and its buffers until it is returned by
+ * cryptoEngine::poll.
+ */
+struct cryptoRecord {
+    cryptoSession* session;   ///< Session of the record.
+    bool encrypt;             ///< Direction of a cipher, ignored by HMAC and SHA-256.
+    const unsigned char* in;  ///< Payload.
+    uint32_t inLen;           ///< Length of the payload in bytes.
+    const unsigned char* aad; ///< Additional authenticated data of GCM.
+    uint32_t aadLen;          ///< Length of the AAD in bytes.
+    unsigned char iv[16];     ///< IV, GCM uses the first 12 bytes.
+    unsigned char* out;       ///< Output of a cipher, inLen bytes, not used by HMAC and SHA-256.
+    unsigned char tag[32];    ///< GCM tag, written by encryption and checked by decryption, or the MAC or digest.
+    void* userData;           ///< Free for the caller.
+    int status;               ///< A cryptoStatus, set by the engine.
+};
+
+/**
+ * @brief cryptoEngine batches records of many sessions and runs them on the card or on the CPU.
+ *
+ * submit can be called from any number of threads. flush and poll are usually called from one driver thread:
+ * flush packs and runs one batch of the queued records, and poll returns the completed ones.
+ */
+class cryptoEngine {
+   public:
+    /**
+     * @brief Create an engine which runs on the CPU until init is called.
+     *
+     * @param ringSize Maximum number of queued records, and of completed records not polled yet.
+     * @param batchSize Size of each of the input and output batch buffers in bytes, at most
+     * XF_SECURITY_BATCH_MAX_BLK blocks as addressed by the kernel, a larger size is cut down to it.
+     */
+    cryptoEngine(size_t ringSize = 8192, size_t batchSize = 64 << 20);
+
+    /**
+     * @brief Class destructor.
+     */
+    ~cryptoEngine();
+
+    /**
+     * @brief Program the card with the overlay and map the batch buffers.
+     *
+     * @param xclbinPath Path of the xclbin with secBatchKernel.
+     */
+    int init(const std::string& xclbinPath);
+
+    /**
+     * @brief Set the size under which a batch is processed on the CPU, as the transfers would cost more.
+     *
+     * @param bytes Total payload of a batch in bytes.
+     */
+    void setCpuThreshold(size_t bytes);
+
+    /**
+     * @brief Open a session.
+     *
+     * @param algo The algorithm.
+     * @param key The key, 32 bytes for the ciphers and any length for HMAC, NULL for SHA-256.
+     * @param keyLen Length of the key in bytes.
+     * @return The session, or NULL if the key length does not fit the algorithm.
+     */
+    cryptoSession* openSession(cryptoAlgo algo, const unsigned char* key, unsigned int keyLen);
+
+    /**
+     * @brief Release a session which has no record in flight, its key is wiped.
+     *
+     * @param session The session.
+     */
+    void closeSession(cryptoSession* session);
+
+    /**
+     * @brief Queue a record, lock-free and safe to call from many threads.
+     *
+     * @param rec The record.
+     * @return false if the record is not queued. Its status is CRYPTO_INVALID if it does not fit its algorithm or
+     * the batch buffers, otherwise the queue is full and it can be submitted again later.
+     */
+    bool submit(cryptoRecord* rec);
+
+    /**
+     * @brief Pack the queued records into one batch, as many as the batch buffers and the free slots of the
+     * completion ring hold, and process it. All of them are in the completion ring when it returns.
+     *
+     * Only one thread may call flush at a time.
+     *
+     * @return Number of records processed.
+     */
+    size_t flush();
+
+    /**
+     * @brief Take the completed records, lock-free and safe to call from many threads.
+     *
+     * @param done Array to receive the completed records.
+     * @param max Size of the array.
+     * @return Number of records taken.
+     */
+    size_t poll(cryptoRecord** done, size_t max);
+
+   private:
+    bool check(const cryptoRecord* rec) const;
+    size_t inBlkNum(const cryptoRecord* rec) const;
+    size_t outBlkNum(const cryptoRecord* rec) const;
+    void complete(cryptoRecord* rec, int status);
+    void drainDone();
+
+    void runCpu(cryptoRecord* rec);
+    void packBatch(size_t& inBlk, size_t& outBlk);
+    int runDevice(size_t inBlk, size_t outBlk);
+    void unpackBatch();
+
+    submitRing<cryptoRecord*> mSubmit;
+    submitRing<cryptoRecord*> mComplete;
+    // completed records which did not fit in mComplete, moved to it at the start and the end of each flush
+    std::vector<cryptoRecord*> mDone;
+    // a record taken from mSubmit which did not fit in the last batch
+    cryptoRecord* mCarry;
+    std::vector<cryptoRecord*> mBatch;
+    std::vector<uint32_t> mOutBlk;
+    uint64_t mBatchId;
+
+    bool mDevice;
+    size_t mCpuThreshold;
+    size_t mBatchBlk;
+    unsigned char* mHostIn;
+    unsigned char* mHostOut;
+
+    cl::Context mContext;
+    cl::CommandQueue mQueue;
+    cl::Program mProgram;
+    cl::Kernel mKernel;
+    cl::Buffer mBufIn;
+    cl::Buffer mBufOut;
+};
+
+} // end of namespace security
+} // end of namespace xf
+
+#endif // _XF_SECURITY_SESSION_HPP_
@@ -0,0 +1,151 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file submit_ring.hpp
+ * @brief header file for the lock-free ring of submitted records.
+ * This file is part of Vitis Security Library.
+ *
+ * @detail A bounded multi-producer multi-consumer ring. Every cell carries a sequence number which tells whether it
+ * is free for the producer of a given position or filled for the consumer of that position, so producers and
+ * consumers only contend on one atomic counter each and never take a lock.
+ */
+
+#ifndef _XF_SECURITY_SUBMIT_RING_HPP_
+#define _XF_SECURITY_SUBMIT_RING_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+namespace xf {
+namespace security {
+
+/**
+ * @brief submitRing is a bounded lock-free queue of fixed capacity.
+ *
+ * @tparam T Type of the elements, which should be cheap to copy, typically a pointer.
+ */
+template <typename T>
+class submitRing {
+   public:
+    /**
+     * @brief Create an empty ring.
+     *
+     * @param size Capacity of the ring, rounded up to a power of two.
+     */
+    explicit submitRing(size_t size) {
+        size_t cap = 2;
+        while (cap < size) {
+            cap <<= 1;
+        }
+        mMask = cap - 1;
+        mCells.reset(new cell[cap]);
+        for (size_t i = 0; i < cap; i++) {
+            mCells[i].seq.store(i, std::memory_order_relaxed);
+        }
+        mHead.store(0, std::memory_order_relaxed);
+        mTail.store(0, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Append an element, safe to call from many threads.
+     *
+     * @param v The element.
+     * @return false if the ring is full.
+     */
+    bool push(const T& v) {
+        size_t pos = mTail.load(std::memory_order_relaxed);
+        for (;;) {
+            cell& c = mCells[pos & mMask];
+            size_t seq = c.seq.load(std::memory_order_acquire);
+            ptrdiff_t dif = (ptrdiff_t)seq - (ptrdiff_t)pos;
+            if (dif == 0) {
+                // the cell is free for this position, claim it
+                if (mTail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    c.data = v;
+                    c.seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (dif < 0) {
+                // the cell still holds the element of the previous lap
+                return false;
+            } else {
+                pos = mTail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Take the oldest element, safe to call from many threads.
+     *
+     * @param v The element taken.
+     * @return false if the ring is empty.
+     */
+    bool pop(T& v) {
+        size_t pos = mHead.load(std::memory_order_relaxed);
+        for (;;) {
+            cell& c = mCells[pos & mMask];
+            size_t seq = c.seq.load(std::memory_order_acquire);
+            ptrdiff_t dif = (ptrdiff_t)seq - (ptrdiff_t)(pos + 1);
+            if (dif == 0) {
+                // the cell is filled for this position, claim it
+                if (mHead.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    v = c.data;
+                    // free the cell for the producer of the next lap
+                    c.seq.store(pos + mMask + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (dif < 0) {
+                return false;
+            } else {
+                pos = mHead.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Number of elements in the ring. Other threads may push or pop meanwhile, so it is exact only for
+     * the side which is not running at the same time, e.g. an upper bound for the only producer.
+     */
+    size_t size() const {
+        size_t tail = mTail.load(std::memory_order_acquire);
+        size_t head = mHead.load(std::memory_order_acquire);
+        return tail > head ? tail - head : 0;
+    }
+
+    /**
+     * @brief Capacity of the ring.
+     */
+    size_t capacity() const { return mMask + 1; }
+
+   private:
+    struct cell {
+        std::atomic<size_t> seq;
+        T data;
+    };
+
+    std::unique_ptr<cell[]> mCells;
+    size_t mMask;
+    // keep the counters of producers and consumers on separate cache lines
+    alignas(64) std::atomic<size_t> mTail;
+    alignas(64) std::atomic<size_t> mHead;
+};
+
+} // end of namespace security
+} // end of namespace xf
+
+#endif // _XF_SECURITY_SUBMIT_RING_HPP_
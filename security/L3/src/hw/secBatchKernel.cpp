@@ -0,0 +1,409 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ *
+ * @file secBatchKernel.cpp
+ * @brief kernel code of the security overlay, processing a batch of records of mixed algorithms.
+ * This file is part of Vitis Security Library.
+ *
+ * @detail The layout of the batch is defined in xf_security/batch.hpp. The records are processed one after another,
+ * each by the L1 primitive of its algorithm in a dataflow region of reader, primitive and writer.
+ *
+ */
+
+#include <ap_int.h>
+#include <hls_stream.h>
+#include "xf_security/cbc.hpp"
+#include "xf_security/gcm.hpp"
+#include "xf_security/hmac.hpp"
+#include "xf_security/sha224_256.hpp"
+
+#include "xf_security/batch.hpp"
+
+// @brief a field of the descriptor, at byte offset off.
+#define DESC_FIELD(desc, off, width) (desc).range(8 * (off) + (width)-1, 8 * (off))
+
+template <int msgW, int lW, int hshW>
+struct sha256Wrapper {
+    static void hash(hls::stream<ap_uint<msgW> >& msgStrm,
+                     hls::stream<ap_uint<64> >& lenStrm,
+                     hls::stream<bool>& eLenStrm,
+                     hls::stream<ap_uint<256> >& hshStrm,
+                     hls::stream<bool>& eHshStrm) {
+        xf::security::sha256<msgW>(msgStrm, lenStrm, eLenStrm, hshStrm, eHshStrm);
+    }
+};
+
+// @brief split the blocks from blk into words of W bits, lowest word first.
+template <int W>
+static void readWords(ap_uint<512>* ptr, unsigned int blk, unsigned int num, hls::stream<ap_uint<W> >& strm) {
+    ap_uint<512> b = 0;
+LOOP_READ_WORD:
+    for (unsigned int i = 0; i < num; i++) {
+#pragma HLS pipeline II = 1
+        unsigned int k = i % (512 / W);
+        if (k == 0) {
+            b = ptr[blk + i / (512 / W)];
+        }
+        strm.write(b.range(W * k + W - 1, W * k));
+    }
+} // end readWords
+
+// @brief gather num words of W bits into blocks from blk.
+template <int W>
+static void writeWords(hls::stream<ap_uint<W> >& strm, unsigned int num, ap_uint<512>* ptr, unsigned int blk) {
+    ap_uint<512> b = 0;
+LOOP_WRITE_WORD:
+    for (unsigned int i = 0; i < num; i++) {
+#pragma HLS pipeline II = 1
+        unsigned int k = i % (512 / W);
+        b.range(W * k + W - 1, W * k) = strm.read();
+        if (k == 512 / W - 1 || i == num - 1) {
+            ptr[blk + i / (512 / W)] = b;
+            b = 0;
+        }
+    }
+} // end writeWords
+
+// @brief read the key, IV, lengths, AAD and payload of a GCM record.
+static void readGcm(ap_uint<512>* ptr,
+                    ap_uint<512> desc,
+                    hls::stream<ap_uint<128> >& payloadStrm,
+                    hls::stream<ap_uint<256> >& cipherkeyStrm,
+                    hls::stream<ap_uint<96> >& IVStrm,
+                    hls::stream<ap_uint<128> >& AADStrm,
+                    hls::stream<ap_uint<64> >& lenAADStrm,
+                    hls::stream<ap_uint<64> >& lenPldStrm,
+                    hls::stream<bool>& endLenStrm) {
+    unsigned int keyBlk = DESC_FIELD(desc, xf::security::BATCH_DESC_KEY_BLK, 32);
+    unsigned int aadBlk = DESC_FIELD(desc, xf::security::BATCH_DESC_AAD_BLK, 32);
+    unsigned int aadLen = DESC_FIELD(desc, xf::security::BATCH_DESC_AAD_LEN, 32);
+    unsigned int dataBlk = DESC_FIELD(desc, xf::security::BATCH_DESC_DATA_BLK, 32);
+    unsigned int dataLen = DESC_FIELD(desc, xf::security::BATCH_DESC_DATA_LEN, 32);
+
+    ap_uint<512> key = ptr[keyBlk];
+    cipherkeyStrm.write(key.range(255, 0));
+    IVStrm.write(DESC_FIELD(desc, xf::security::BATCH_DESC_IV, 96));
+    lenAADStrm.write((ap_uint<64>)aadLen * 8);
+    lenPldStrm.write((ap_uint<64>)dataLen * 8);
+    endLenStrm.write(false);
+    endLenStrm.write(true);
+
+    readWords<128>(ptr, aadBlk, (aadLen + 15) / 16, AADStrm);
+    readWords<128>(ptr, dataBlk, (dataLen + 15) / 16, payloadStrm);
+} // end readGcm
+
+// @brief write the output text and the tag of a GCM record.
+static void writeGcm(hls::stream<ap_uint<128> >& cipherStrm,
+                     hls::stream<ap_uint<64> >& lenCphStrm,
+                     hls::stream<ap_uint<128> >& tagStrm,
+                     hls::stream<bool>& endTagStrm,
+                     ap_uint<512>* ptr,
+                     unsigned int outBlk) {
+    ap_uint<64> len = lenCphStrm.read();
+    unsigned int words = (len + 127) / 128;
+    writeWords<128>(cipherStrm, words, ptr, outBlk);
+
+    ap_uint<512> tag = 0;
+    tag.range(127, 0) = tagStrm.read();
+    ptr[outBlk + (words + 3) / 4] = tag;
+    endTagStrm.read();
+    endTagStrm.read();
+} // end writeGcm
+
+// @brief AES-256-GCM encryption of one record.
+static void gcmEncRecord(ap_uint<512>* in, ap_uint<512> desc, ap_uint<512>* out) {
+#pragma HLS dataflow
+    hls::stream<ap_uint<128> > payloadStrm("payloadStrm");
+#pragma HLS STREAM variable = payloadStrm depth = 64 dim = 1
+    hls::stream<ap_uint<256> > cipherkeyStrm("cipherkeyStrm");
+#pragma HLS STREAM variable = cipherkeyStrm depth = 2 dim = 1
+    hls::stream<ap_uint<96> > IVStrm("IVStrm");
+#pragma HLS STREAM variable = IVStrm depth = 2 dim = 1
+    hls::stream<ap_uint<128> > AADStrm("AADStrm");
+#pragma HLS STREAM variable = AADStrm depth = 64 dim = 1
+    hls::stream<ap_uint<64> > lenAADStrm("lenAADStrm");
+#pragma HLS STREAM variable = lenAADStrm depth = 2 dim = 1
+    hls::stream<ap_uint<64> > lenPldStrm("lenPldStrm");
+#pragma HLS STREAM variable = lenPldStrm depth = 2 dim = 1
+    hls::stream<bool> endLenStrm("endLenStrm");
+#pragma HLS STREAM variable = endLenStrm depth = 4 dim = 1
+    hls::stream<ap_uint<128> > cipherStrm("cipherStrm");
+#pragma HLS STREAM variable = cipherStrm depth = 64 dim = 1
+    hls::stream<ap_uint<64> > lenCphStrm("lenCphStrm");
+#pragma HLS STREAM variable = lenCphStrm depth = 2 dim = 1
+    hls::stream<ap_uint<128> > tagStrm("tagStrm");
+#pragma HLS STREAM variable = tagStrm depth = 2 dim = 1
+    hls::stream<bool> endTagStrm("endTagStrm");
+#pragma HLS STREAM variable = endTagStrm depth = 4 dim = 1
+
+    readGcm(in, desc, payloadStrm, cipherkeyStrm, IVStrm, AADStrm, lenAADStrm, lenPldStrm, endLenStrm);
+    xf::security::aes256GcmEncrypt(payloadStrm, cipherkeyStrm, IVStrm, AADStrm, lenAADStrm, lenPldStrm, endLenStrm,
+                                   cipherStrm, lenCphStrm, tagStrm, endTagStrm);
+    writeGcm(cipherStrm, lenCphStrm, tagStrm, endTagStrm, out, DESC_FIELD(desc, xf::security::BATCH_DESC_OUT_BLK, 32));
+} // end gcmEncRecord
+
+// @brief AES-256-GCM decryption of one record, the tag is checked by the host.
+static void gcmDecRecord(ap_uint<512>* in, ap_uint<512> desc, ap_uint<512>* out) {
+#pragma HLS dataflow
+    hls::stream<ap_uint<128> > payloadStrm("payloadStrm");
+#pragma HLS STREAM variable = payloadStrm depth = 64 dim = 1
+    hls::stream<ap_uint<256> > cipherkeyStrm("cipherkeyStrm");
+#pragma HLS STREAM variable = cipherkeyStrm depth = 2 dim = 1
+    hls::stream<ap_uint<96> > IVStrm("IVStrm");
+#pragma HLS STREAM variable = IVStrm depth = 2 dim = 1
+    hls::stream<ap_uint<128> > AADStrm("AADStrm");
+#pragma HLS STREAM variable = AADStrm depth = 64 dim = 1
+    hls::stream<ap_uint<64> > lenAADStrm("lenAADStrm");
+#pragma HLS STREAM variable = lenAADStrm depth = 2 dim = 1
+    hls::stream<ap_uint<64> > lenPldStrm("lenPldStrm");
+#pragma HLS STREAM variable = lenPldStrm depth = 2 dim = 1
+    hls::stream<bool> endLenStrm("endLenStrm");
+#pragma HLS STREAM variable = endLenStrm depth = 4 dim = 1
+    hls::stream<ap_uint<128> > plainStrm("plainStrm");
+#pragma HLS STREAM variable = plainStrm depth = 64 dim = 1
+    hls::stream<ap_uint<64> > lenPlnStrm("lenPlnStrm");
+#pragma HLS STREAM variable = lenPlnStrm depth = 2 dim = 1
+    hls::stream<ap_uint<128> > tagStrm("tagStrm");
+#pragma HLS STREAM variable = tagStrm depth = 2 dim = 1
+    hls::stream<bool> endTagStrm("endTagStrm");
+#pragma HLS STREAM variable = endTagStrm depth = 4 dim = 1
+
+    readGcm(in, desc, payloadStrm, cipherkeyStrm, IVStrm, AADStrm, lenAADStrm, lenPldStrm, endLenStrm);
+    xf::security::aes256GcmDecrypt(payloadStrm, cipherkeyStrm, IVStrm, AADStrm, lenAADStrm, lenPldStrm, endLenStrm,
+                                   plainStrm, lenPlnStrm, tagStrm, endTagStrm);
+    writeGcm(plainStrm, lenPlnStrm, tagStrm, endTagStrm, out, DESC_FIELD(desc, xf::security::BATCH_DESC_OUT_BLK, 32));
+} // end gcmDecRecord
+
+// @brief read the key, IV and payload of a CBC record.
+static void readCbc(ap_uint<512>* ptr,
+                    ap_uint<512> desc,
+                    hls::stream<ap_uint<128> >& textStrm,
+                    hls::stream<bool>& endTextStrm,
+                    hls::stream<ap_uint<256> >& cipherkeyStrm,
+                    hls::stream<ap_uint<128> >& IVStrm) {
+    unsigned int keyBlk = DESC_FIELD(desc, xf::security::BATCH_DESC_KEY_BLK, 32);
+    unsigned int dataBlk = DESC_FIELD(desc, xf::security::BATCH_DESC_DATA_BLK, 32);
+    unsigned int dataLen = DESC_FIELD(desc, xf::security::BATCH_DESC_DATA_LEN, 32);
+
+    ap_uint<512> key = ptr[keyBlk];
+    cipherkeyStrm.write(key.range(255, 0));
+    IVStrm.write(DESC_FIELD(desc, xf::security::BATCH_DESC_IV, 128));
+
+    ap_uint<512> b = 0;
+LOOP_READ_CBC:
+    for (unsigned int i = 0; i < dataLen / 16; i++) {
+#pragma HLS pipeline II = 1
+        unsigned int k = i % 4;
+        if (k == 0) {
+            b = ptr[dataBlk + i / 4];
+        }
+        textStrm.write(b.range(128 * k + 127, 128 * k));
+        endTextStrm.write(false);
+    }
+    endTextStrm.write(true);
+} // end readCbc
+
+// @brief write the output text of a CBC record.
+static void writeCbc(hls::stream<ap_uint<128> >& textStrm,
+                     hls::stream<bool>& endTextStrm,
+                     ap_uint<512>* ptr,
+                     unsigned int outBlk) {
+    ap_uint<512> b = 0;
+    unsigned int i = 0;
+LOOP_WRITE_CBC:
+    while (!endTextStrm.read()) {
+#pragma HLS pipeline II = 1
+        unsigned int k = i % 4;
+        b.range(128 * k + 127, 128 * k) = textStrm.read();
+        if (k == 3) {
+            ptr[outBlk + i / 4] = b;
+            b = 0;
+        }
+        i++;
+    }
+    if (i % 4) {
+        ptr[outBlk + i / 4] = b;
+    }
+} // end writeCbc
+
+// @brief AES-256-CBC encryption of one record.
+static void cbcEncRecord(ap_uint<512>* in, ap_uint<512> desc, ap_uint<512>* out) {
+#pragma HLS dataflow
+    hls::stream<ap_uint<128> > plaintextStrm("plaintextStrm");
+#pragma HLS STREAM variable = plaintextStrm depth = 64 dim = 1
+    hls::stream<bool> endPlaintextStrm("endPlaintextStrm");
+#pragma HLS STREAM variable = endPlaintextStrm depth = 64 dim = 1
+    hls::stream<ap_uint<256> > cipherkeyStrm("cipherkeyStrm");
+#pragma HLS STREAM variable = cipherkeyStrm depth = 2 dim = 1
+    hls::stream<ap_uint<128> > IVStrm("IVStrm");
+#pragma HLS STREAM variable = IVStrm depth = 2 dim = 1
+    hls::stream<ap_uint<128> > ciphertextStrm("ciphertextStrm");
+#pragma HLS STREAM variable = ciphertextStrm depth = 64 dim = 1
+    hls::stream<bool> endCiphertextStrm("endCiphertextStrm");
+#pragma HLS STREAM variable = endCiphertextStrm depth = 64 dim = 1
+
+    readCbc(in, desc, plaintextStrm, endPlaintextStrm, cipherkeyStrm, IVStrm);
+    xf::security::aes256CbcEncrypt(plaintextStrm, endPlaintextStrm, cipherkeyStrm, IVStrm, ciphertextStrm,
+                                   endCiphertextStrm);
+    writeCbc(ciphertextStrm, endCiphertextStrm, out, DESC_FIELD(desc, xf::security::BATCH_DESC_OUT_BLK, 32));
+} // end cbcEncRecord
+
+// @brief AES-256-CBC decryption of one record.
+static void cbcDecRecord(ap_uint<512>* in, ap_uint<512> desc, ap_uint<512>* out) {
+#pragma HLS dataflow
+    hls::stream<ap_uint<128> > ciphertextStrm("ciphertextStrm");
+#pragma HLS STREAM variable = ciphertextStrm depth = 64 dim = 1
+    hls::stream<bool> endCiphertextStrm("endCiphertextStrm");
+#pragma HLS STREAM variable = endCiphertextStrm depth = 64 dim = 1
+    hls::stream<ap_uint<256> > cipherkeyStrm("cipherkeyStrm");
+#pragma HLS STREAM variable = cipherkeyStrm depth = 2 dim = 1
+    hls::stream<ap_uint<128> > IVStrm("IVStrm");
+#pragma HLS STREAM variable = IVStrm depth = 2 dim = 1
+    hls::stream<ap_uint<128> > plaintextStrm("plaintextStrm");
+#pragma HLS STREAM variable = plaintextStrm depth = 64 dim = 1
+    hls::stream<bool> endPlaintextStrm("endPlaintextStrm");
+#pragma HLS STREAM variable = endPlaintextStrm depth = 64 dim = 1
+
+    readCbc(in, desc, ciphertextStrm, endCiphertextStrm, cipherkeyStrm, IVStrm);
+    xf::security::aes256CbcDecrypt(ciphertextStrm, endCiphertextStrm, cipherkeyStrm, IVStrm, plaintextStrm,
+                                   endPlaintextStrm);
+    writeCbc(plaintextStrm, endPlaintextStrm, out, DESC_FIELD(desc, xf::security::BATCH_DESC_OUT_BLK, 32));
+} // end cbcDecRecord
+
+// @brief read the key and message of an HMAC record, the key is empty for SHA-256.
+static void readHash(ap_uint<512>* ptr,
+                     ap_uint<512> desc,
+                     hls::stream<ap_uint<32> >& keyStrm,
+                     hls::stream<ap_uint<64> >& keyLenStrm,
+                     hls::stream<ap_uint<32> >& msgStrm,
+                     hls::stream<ap_uint<64> >& msgLenStrm,
+                     hls::stream<bool>& endLenStrm) {
+    unsigned int keyBlk = DESC_FIELD(desc, xf::security::BATCH_DESC_KEY_BLK, 32);
+    unsigned int keyLen = DESC_FIELD(desc, xf::security::BATCH_DESC_KEY_LEN, 8);
+    unsigned int dataBlk = DESC_FIELD(desc, xf::security::BATCH_DESC_DATA_BLK, 32);
+    unsigned int dataLen = DESC_FIELD(desc, xf::security::BATCH_DESC_DATA_LEN, 32);
+
+    keyLenStrm.write(keyLen);
+    msgLenStrm.write(dataLen);
+    endLenStrm.write(false);
+    endLenStrm.write(true);
+
+    readWords<32>(ptr, keyBlk, (keyLen + 3) / 4, keyStrm);
+    readWords<32>(ptr, dataBlk, (dataLen + 3) / 4, msgStrm);
+} // end readHash
+
+// @brief write the MAC or digest of a record.
+static void writeDigest(hls::stream<ap_uint<256> >& hshStrm,
+                        hls::stream<bool>& endHshStrm,
+                        ap_uint<512>* ptr,
+                        unsigned int outBlk) {
+    ap_uint<512> b = 0;
+    b.range(255, 0) = hshStrm.read();
+    ptr[outBlk] = b;
+    endHshStrm.read();
+    endHshStrm.read();
+} // end writeDigest
+
+// @brief HMAC-SHA256 of one record.
+static void hmacRecord(ap_uint<512>* in, ap_uint<512> desc, ap_uint<512>* out) {
+#pragma HLS dataflow
+    hls::stream<ap_uint<32> > keyStrm("keyStrm");
+#pragma HLS STREAM variable = keyStrm depth = 16 dim = 1
+    hls::stream<ap_uint<64> > keyLenStrm("keyLenStrm");
+#pragma HLS STREAM variable = keyLenStrm depth = 2 dim = 1
+    hls::stream<ap_uint<32> > msgStrm("msgStrm");
+#pragma HLS STREAM variable = msgStrm depth = 128 dim = 1
+    hls::stream<ap_uint<64> > msgLenStrm("msgLenStrm");
+#pragma HLS STREAM variable = msgLenStrm depth = 2 dim = 1
+    hls::stream<bool> endLenStrm("endLenStrm");
+#pragma HLS STREAM variable = endLenStrm depth = 4 dim = 1
+    hls::stream<ap_uint<256> > hshStrm("hshStrm");
+#pragma HLS STREAM variable = hshStrm depth = 2 dim = 1
+    hls::stream<bool> endHshStrm("endHshStrm");
+#pragma HLS STREAM variable = endHshStrm depth = 4 dim = 1
+
+    readHash(in, desc, keyStrm, keyLenStrm, msgStrm, msgLenStrm, endLenStrm);
+    xf::security::hmac<32, 32, 64, 256, 64, sha256Wrapper>(keyStrm, keyLenStrm, msgStrm, msgLenStrm, endLenStrm,
+                                                           hshStrm, endHshStrm);
+    writeDigest(hshStrm, endHshStrm, out, DESC_FIELD(desc, xf::security::BATCH_DESC_OUT_BLK, 32));
+} // end hmacRecord
+
+// @brief SHA-256 of one record.
+static void shaRecord(ap_uint<512>* in, ap_uint<512> desc, ap_uint<512>* out) {
+#pragma HLS dataflow
+    hls::stream<ap_uint<32> > keyStrm("keyStrm");
+#pragma HLS STREAM variable = keyStrm depth = 2 dim = 1
+    hls::stream<ap_uint<64> > keyLenStrm("keyLenStrm");
+#pragma HLS STREAM variable = keyLenStrm depth = 2 dim = 1
+    hls::stream<ap_uint<32> > msgStrm("msgStrm");
+#pragma HLS STREAM variable = msgStrm depth = 128 dim = 1
+    hls::stream<ap_uint<64> > msgLenStrm("msgLenStrm");
+#pragma HLS STREAM variable = msgLenStrm depth = 2 dim = 1
+    hls::stream<bool> endLenStrm("endLenStrm");
+#pragma HLS STREAM variable = endLenStrm depth = 4 dim = 1
+    hls::stream<ap_uint<256> > hshStrm("hshStrm");
+#pragma HLS STREAM variable = hshStrm depth = 2 dim = 1
+    hls::stream<bool> endHshStrm("endHshStrm");
+#pragma HLS STREAM variable = endHshStrm depth = 4 dim = 1
+
+    readHash(in, desc, keyStrm, keyLenStrm, msgStrm, msgLenStrm, endLenStrm);
+    xf::security::sha256<32>(msgStrm, msgLenStrm, endLenStrm, hshStrm, endHshStrm);
+    writeDigest(hshStrm, endHshStrm, out, DESC_FIELD(desc, xf::security::BATCH_DESC_OUT_BLK, 32));
+} // end shaRecord
+
+// @brief top of kernel
+extern "C" void secBatchKernel(ap_uint<512> inputData[XF_SECURITY_BATCH_MAX_BLK],
+                               ap_uint<512> outputData[XF_SECURITY_BATCH_MAX_BLK]) {
+// clang-format off
+#pragma HLS INTERFACE m_axi offset = slave latency = 64 \
+	num_write_outstanding = 16 num_read_outstanding = 16 \
+	max_write_burst_length = 64 max_read_burst_length = 64 \
+	bundle = gmem0_0 port = inputData
+
+#pragma HLS INTERFACE m_axi offset = slave latency = 64 \
+	num_write_outstanding = 16 num_read_outstanding = 16 \
+	max_write_burst_length = 64 max_read_burst_length = 64 \
+	bundle = gmem0_1 port = outputData
+// clang-format on
+
+#pragma HLS INTERFACE s_axilite port = inputData bundle = control
+#pragma HLS INTERFACE s_axilite port = outputData bundle = control
+#pragma HLS INTERFACE s_axilite port = return bundle = control
+
+    ap_uint<512> hdr = inputData[0];
+    unsigned int recNum = DESC_FIELD(hdr, xf::security::BATCH_HDR_REC_NUM, 32);
+
+LOOP_RECORD:
+    for (unsigned int r = 0; r < recNum; r++) {
+        ap_uint<512> desc = inputData[1 + r];
+        unsigned int op = DESC_FIELD(desc, xf::security::BATCH_DESC_OP, 8);
+        if (op == xf::security::BATCH_GCM_ENC) {
+            gcmEncRecord(inputData, desc, outputData);
+        } else if (op == xf::security::BATCH_GCM_DEC) {
+            gcmDecRecord(inputData, desc, outputData);
+        } else if (op == xf::security::BATCH_CBC_ENC) {
+            cbcEncRecord(inputData, desc, outputData);
+        } else if (op == xf::security::BATCH_CBC_DEC) {
+            cbcDecRecord(inputData, desc, outputData);
+        } else if (op == xf::security::BATCH_HMAC_SHA256) {
+            hmacRecord(inputData, desc, outputData);
+        } else if (op == xf::security::BATCH_SHA256) {
+            shaRecord(inputData, desc, outputData);
+        }
+    }
+} // end secBatchKernel
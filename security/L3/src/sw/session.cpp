@@ -0,0 +1,409 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <iostream>
+
+#include <openssl/crypto.h>
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <openssl/sha.h>
+
+#include "xf_security/session.hpp"
+
+namespace xf {
+namespace security {
+
+// number of blocks holding n bytes
+static size_t blkNum(size_t n) {
+    return (n + XF_SECURITY_BATCH_BLK - 1) / XF_SECURITY_BATCH_BLK;
+}
+
+static void putU32(unsigned char* p, uint32_t v) {
+    for (int i = 0; i < 4; i++) {
+        p[i] = (v >> (8 * i)) & 0xff;
+    }
+}
+
+// copy n bytes to consecutive blocks from blk, zero padding the last one, and return the next free block
+static size_t putBlk(unsigned char* base, size_t blk, const unsigned char* src, size_t n) {
+    unsigned char* dst = base + blk * XF_SECURITY_BATCH_BLK;
+    size_t num = blkNum(n);
+    if (n) {
+        memcpy(dst, src, n);
+    }
+    memset(dst + n, 0, num * XF_SECURITY_BATCH_BLK - n);
+    return blk + num;
+}
+
+cryptoSession::cryptoSession(cryptoAlgo algo, const unsigned char* key, unsigned int keyLen)
+    : mAlgo(algo), mKeyLen(keyLen), mBatchId(0), mKeyBlk(0) {
+    memset(mKey, 0, sizeof(mKey));
+    if (keyLen) {
+        memcpy(mKey, key, keyLen);
+    }
+}
+
+cryptoEngine::cryptoEngine(size_t ringSize, size_t batchSize)
+    : mSubmit(ringSize),
+      mComplete(ringSize),
+      mCarry(NULL),
+      mBatchId(0),
+      mDevice(false),
+      mCpuThreshold(0),
+      mBatchBlk(batchSize / XF_SECURITY_BATCH_BLK),
+      mHostIn(NULL),
+      mHostOut(NULL) {
+    // the kernel addresses no more blocks, larger batches are split by flush
+    if (mBatchBlk > XF_SECURITY_BATCH_MAX_BLK) {
+        mBatchBlk = XF_SECURITY_BATCH_MAX_BLK;
+    }
+    if (posix_memalign((void**)&mHostIn, 4096, mBatchBlk * XF_SECURITY_BATCH_BLK) ||
+        posix_memalign((void**)&mHostOut, 4096, mBatchBlk * XF_SECURITY_BATCH_BLK)) {
+        std::cout << "ERROR: failed to allocate the batch buffers" << std::endl;
+        free(mHostIn);
+        mHostIn = NULL;
+        mHostOut = NULL;
+        mBatchBlk = 0;
+    }
+}
+
+cryptoEngine::~cryptoEngine() {
+    free(mHostIn);
+    free(mHostOut);
+}
+
+int cryptoEngine::init(const std::string& xclbinPath) {
+    if (mBatchBlk == 0) {
+        return -1;
+    }
+    std::vector<cl::Device> devices = xcl::get_xil_devices();
+    cl::Device device = devices[0];
+    mContext = cl::Context(device);
+    mQueue = cl::CommandQueue(mContext, device, CL_QUEUE_PROFILING_ENABLE);
+    std::cout << "Selected Device " << device.getInfo<CL_DEVICE_NAME>() << std::endl;
+
+    cl::Program::Binaries xclBins = xcl::import_binary_file(xclbinPath);
+    devices.resize(1);
+    mProgram = cl::Program(mContext, devices, xclBins);
+    mKernel = cl::Kernel(mProgram, "secBatchKernel");
+
+    cl_mem_ext_ptr_t mextIn = {XCL_MEM_DDR_BANK0, mHostIn, 0};
+    cl_mem_ext_ptr_t mextOut = {XCL_MEM_DDR_BANK0, mHostOut, 0};
+    mBufIn = cl::Buffer(mContext, CL_MEM_EXT_PTR_XILINX | CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY,
+                        mBatchBlk * XF_SECURITY_BATCH_BLK, &mextIn);
+    mBufOut = cl::Buffer(mContext, CL_MEM_EXT_PTR_XILINX | CL_MEM_USE_HOST_PTR | CL_MEM_WRITE_ONLY,
+                         mBatchBlk * XF_SECURITY_BATCH_BLK, &mextOut);
+    mKernel.setArg(0, mBufIn);
+    mKernel.setArg(1, mBufOut);
+    mDevice = true;
+    return 0;
+}
+
+void cryptoEngine::setCpuThreshold(size_t bytes) {
+    mCpuThreshold = bytes;
+}
+
+cryptoSession* cryptoEngine::openSession(cryptoAlgo algo, const unsigned char* key, unsigned int keyLen) {
+    if (algo == CRYPTO_AES256_GCM || algo == CRYPTO_AES256_CBC) {
+        if (keyLen != 32) {
+            return NULL;
+        }
+        return new cryptoSession(algo, key, keyLen);
+    } else if (algo == CRYPTO_HMAC_SHA256) {
+        if (keyLen > XF_SECURITY_BATCH_BLK) {
+            // RFC 2104, a key longer than the block size is replaced by its digest
+            unsigned char digest[SHA256_DIGEST_LENGTH];
+            SHA256(key, keyLen, digest);
+            cryptoSession* session = new cryptoSession(algo, digest, SHA256_DIGEST_LENGTH);
+            OPENSSL_cleanse(digest, sizeof(digest));
+            return session;
+        }
+        return new cryptoSession(algo, key, keyLen);
+    } else if (algo == CRYPTO_SHA256) {
+        return new cryptoSession(algo, NULL, 0);
+    }
+    return NULL;
+}
+
+void cryptoEngine::closeSession(cryptoSession* session) {
+    if (session == NULL) {
+        return;
+    }
+    OPENSSL_cleanse(session->mKey, sizeof(session->mKey));
+    delete session;
+}
+
+bool cryptoEngine::check(const cryptoRecord* rec) const {
+    if (rec->session == NULL) {
+        return false;
+    }
+    if (rec->session->mAlgo == CRYPTO_AES256_CBC && rec->inLen % 16) {
+        return false;
+    }
+    // one header block in front of the records
+    return inBlkNum(rec) + 1 <= mBatchBlk && outBlkNum(rec) <= mBatchBlk;
+}
+
+size_t cryptoEngine::inBlkNum(const cryptoRecord* rec) const {
+    // descriptor and key, the key may be shared with other records of the session
+    size_t num = 2 + blkNum(rec->inLen);
+    if (rec->session->mAlgo == CRYPTO_AES256_GCM) {
+        num += blkNum(rec->aadLen);
+    }
+    return num;
+}
+
+size_t cryptoEngine::outBlkNum(const cryptoRecord* rec) const {
+    cryptoAlgo algo = rec->session->mAlgo;
+    if (algo == CRYPTO_AES256_GCM) {
+        return blkNum(rec->inLen) + 1;
+    } else if (algo == CRYPTO_AES256_CBC) {
+        return blkNum(rec->inLen);
+    }
+    return 1;
+}
+
+bool cryptoEngine::submit(cryptoRecord* rec) {
+    if (!check(rec)) {
+        rec->status = CRYPTO_INVALID;
+        return false;
+    }
+    rec->status = CRYPTO_PENDING;
+    return mSubmit.push(rec);
+}
+
+void cryptoEngine::complete(cryptoRecord* rec, int status) {
+    rec->status = status;
+    if (!mComplete.push(rec)) {
+        mDone.push_back(rec);
+    }
+}
+
+size_t cryptoEngine::poll(cryptoRecord** done, size_t max) {
+    size_t n = 0;
+    while (n < max && mComplete.pop(done[n])) {
+        n++;
+    }
+    return n;
+}
+
+void cryptoEngine::drainDone() {
+    size_t spill = 0;
+    while (spill < mDone.size() && mComplete.push(mDone[spill])) {
+        spill++;
+    }
+    mDone.erase(mDone.begin(), mDone.begin() + spill);
+}
+
+size_t cryptoEngine::flush() {
+    // hand over the completed records which did not fit in the ring last time
+    drainDone();
+
+    // only flush pushes to mComplete and poll only frees slots, so the records taken up to the free slots seen here
+    // are all completed into the ring
+    size_t used = mComplete.size() + mDone.size();
+    size_t slots = used < mComplete.capacity() ? mComplete.capacity() - used : 0;
+
+    // take the queued records as long as the batch buffers and the completion ring hold them
+    mBatch.clear();
+    size_t inUsed = 1;
+    size_t outUsed = 0;
+    size_t bytes = 0;
+    cryptoRecord* rec = mCarry;
+    mCarry = NULL;
+    while (mBatch.size() < slots && (rec != NULL || mSubmit.pop(rec))) {
+        if (inUsed + inBlkNum(rec) > mBatchBlk || outUsed + outBlkNum(rec) > mBatchBlk) {
+            break;
+        }
+        inUsed += inBlkNum(rec);
+        outUsed += outBlkNum(rec);
+        bytes += rec->inLen + rec->aadLen;
+        mBatch.push_back(rec);
+        rec = NULL;
+    }
+    // a record taken but not fitting goes first in the next batch
+    mCarry = rec;
+    if (mBatch.empty()) {
+        return 0;
+    }
+
+    if (mDevice && bytes >= mCpuThreshold) {
+        size_t inBlk = 0;
+        size_t outBlk = 0;
+        packBatch(inBlk, outBlk);
+        if (runDevice(inBlk, outBlk)) {
+            // nothing is taken from the output buffer, the batch is run again on the CPU
+            for (size_t i = 0; i < mBatch.size(); i++) {
+                runCpu(mBatch[i]);
+            }
+        } else {
+            unpackBatch();
+        }
+    } else {
+        for (size_t i = 0; i < mBatch.size(); i++) {
+            runCpu(mBatch[i]);
+        }
+    }
+    drainDone();
+    return mBatch.size();
+}
+
+void cryptoEngine::packBatch(size_t& inBlk, size_t& outBlk) {
+    // a new batch id invalidates the key blocks of all the sessions
+    ++mBatchId;
+    size_t recNum = mBatch.size();
+    memset(mHostIn, 0, XF_SECURITY_BATCH_BLK * (1 + recNum));
+    putU32(mHostIn + BATCH_HDR_REC_NUM, recNum);
+
+    inBlk = 1 + recNum;
+    outBlk = 0;
+    mOutBlk.resize(recNum);
+    for (size_t i = 0; i < recNum; i++) {
+        cryptoRecord* rec = mBatch[i];
+        cryptoSession* session = rec->session;
+        unsigned char* desc = mHostIn + XF_SECURITY_BATCH_BLK * (1 + i);
+
+        unsigned char op = BATCH_SHA256;
+        if (session->mAlgo == CRYPTO_AES256_GCM) {
+            op = rec->encrypt ? BATCH_GCM_ENC : BATCH_GCM_DEC;
+        } else if (session->mAlgo == CRYPTO_AES256_CBC) {
+            op = rec->encrypt ? BATCH_CBC_ENC : BATCH_CBC_DEC;
+        } else if (session->mAlgo == CRYPTO_HMAC_SHA256) {
+            op = BATCH_HMAC_SHA256;
+        }
+
+        // one key block per session in the batch
+        if (session->mKeyLen && session->mBatchId != mBatchId) {
+            session->mBatchId = mBatchId;
+            session->mKeyBlk = inBlk;
+            inBlk = putBlk(mHostIn, inBlk, session->mKey, session->mKeyLen);
+        }
+
+        desc[BATCH_DESC_OP] = op;
+        desc[BATCH_DESC_KEY_LEN] = session->mKeyLen;
+        putU32(desc + BATCH_DESC_KEY_BLK, session->mKeyLen ? session->mKeyBlk : 0);
+        if (session->mAlgo == CRYPTO_AES256_GCM) {
+            putU32(desc + BATCH_DESC_AAD_BLK, inBlk);
+            putU32(desc + BATCH_DESC_AAD_LEN, rec->aadLen);
+            inBlk = putBlk(mHostIn, inBlk, rec->aad, rec->aadLen);
+        }
+        putU32(desc + BATCH_DESC_DATA_BLK, inBlk);
+        putU32(desc + BATCH_DESC_DATA_LEN, rec->inLen);
+        inBlk = putBlk(mHostIn, inBlk, rec->in, rec->inLen);
+        putU32(desc + BATCH_DESC_OUT_BLK, outBlk);
+        memcpy(desc + BATCH_DESC_IV, rec->iv, 16);
+
+        mOutBlk[i] = outBlk;
+        outBlk += outBlkNum(rec);
+    }
+}
+
+int cryptoEngine::runDevice(size_t inBlk, size_t outBlk) {
+    // the kernel must never run past its buffers
+    if (inBlk > mBatchBlk || outBlk > mBatchBlk) {
+        std::cout << "ERROR: batch of " << inBlk << " input and " << outBlk << " output blocks exceeds " << mBatchBlk
+                  << std::endl;
+        return -1;
+    }
+    // only the used part of the buffers is moved
+    cl_int err = mQueue.enqueueWriteBuffer(mBufIn, CL_FALSE, 0, inBlk * XF_SECURITY_BATCH_BLK, mHostIn);
+    if (err == CL_SUCCESS) {
+        err = mQueue.enqueueTask(mKernel);
+    }
+    if (err == CL_SUCCESS) {
+        err = mQueue.enqueueReadBuffer(mBufOut, CL_FALSE, 0, outBlk * XF_SECURITY_BATCH_BLK, mHostOut);
+    }
+    // wait for what is enqueued even after an error, as the next batch reuses the host buffers
+    cl_int errFinish = mQueue.finish();
+    if (err == CL_SUCCESS) {
+        err = errFinish;
+    }
+    if (err != CL_SUCCESS) {
+        std::cout << "ERROR: batch of " << mBatch.size() << " records failed on the device, error " << err
+                  << std::endl;
+        return -1;
+    }
+    return 0;
+}
+
+void cryptoEngine::unpackBatch() {
+    for (size_t i = 0; i < mBatch.size(); i++) {
+        cryptoRecord* rec = mBatch[i];
+        cryptoAlgo algo = rec->session->mAlgo;
+        const unsigned char* out = mHostOut + XF_SECURITY_BATCH_BLK * mOutBlk[i];
+        if (algo == CRYPTO_AES256_GCM || algo == CRYPTO_AES256_CBC) {
+            memcpy(rec->out, out, rec->inLen);
+            out += XF_SECURITY_BATCH_BLK * blkNum(rec->inLen);
+        }
+
+        int status = CRYPTO_OK;
+        if (algo == CRYPTO_AES256_GCM && rec->encrypt) {
+            memcpy(rec->tag, out, 16);
+        } else if (algo == CRYPTO_AES256_GCM) {
+            if (CRYPTO_memcmp(rec->tag, out, 16)) {
+                memset(rec->out, 0, rec->inLen);
+                status = CRYPTO_AUTH_FAIL;
+            }
+        } else if (algo != CRYPTO_AES256_CBC) {
+            memcpy(rec->tag, out, 32);
+        }
+        complete(rec, status);
+    }
+}
+
+void cryptoEngine::runCpu(cryptoRecord* rec) {
+    cryptoSession* session = rec->session;
+    int status = CRYPTO_OK;
+    if (session->mAlgo == CRYPTO_AES256_GCM || session->mAlgo == CRYPTO_AES256_CBC) {
+        bool gcm = session->mAlgo == CRYPTO_AES256_GCM;
+        EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
+        int len = 0;
+        EVP_CipherInit_ex(ctx, gcm ? EVP_aes_256_gcm() : EVP_aes_256_cbc(), NULL, NULL, NULL, rec->encrypt);
+        if (gcm) {
+            EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_SET_IVLEN, 12, NULL);
+        } else {
+            EVP_CIPHER_CTX_set_padding(ctx, 0);
+        }
+        EVP_CipherInit_ex(ctx, NULL, NULL, session->mKey, rec->iv, rec->encrypt);
+        if (gcm && rec->aadLen) {
+            EVP_CipherUpdate(ctx, NULL, &len, rec->aad, rec->aadLen);
+        }
+        if (rec->inLen) {
+            EVP_CipherUpdate(ctx, rec->out, &len, rec->in, rec->inLen);
+        }
+        if (gcm && !rec->encrypt) {
+            EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_SET_TAG, 16, rec->tag);
+        }
+        if (EVP_CipherFinal_ex(ctx, rec->out + len, &len) <= 0) {
+            memset(rec->out, 0, rec->inLen);
+            status = CRYPTO_AUTH_FAIL;
+        } else if (gcm && rec->encrypt) {
+            EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_GET_TAG, 16, rec->tag);
+        }
+        EVP_CIPHER_CTX_free(ctx);
+    } else if (session->mAlgo == CRYPTO_HMAC_SHA256) {
+        unsigned int len = 0;
+        HMAC(EVP_sha256(), session->mKey, session->mKeyLen, rec->in, rec->inLen, rec->tag, &len);
+    } else {
+        SHA256(rec->in, rec->inLen, rec->tag);
+    }
+    complete(rec, status);
+}
+
+} // end of namespace security
+} // end of namespace xf
@@ -0,0 +1,240 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <openssl/hmac.h>
+#include <openssl/sha.h>
+
+#include "xf_security/session.hpp"
+
+using namespace xf::security;
+
+// number of producer threads
+#define N_THREAD 4
+// number of records submitted by each producer
+#define N_REC 1000
+// maximum length of a payload in bytes
+#define MAX_LEN 1536
+
+class ArgParser {
+   public:
+    ArgParser(int& argc, const char** argv) {
+        for (int i = 1; i < argc; ++i) mTokens.push_back(std::string(argv[i]));
+    }
+    bool getCmdOption(const std::string option, std::string& value) const {
+        std::vector<std::string>::const_iterator itr;
+        itr = std::find(this->mTokens.begin(), this->mTokens.end(), option);
+        if (itr != this->mTokens.end() && ++itr != this->mTokens.end()) {
+            value = *itr;
+            return true;
+        }
+        return false;
+    }
+
+   private:
+    std::vector<std::string> mTokens;
+};
+
+// a record and the buffers it points to
+struct testCase {
+    cryptoRecord rec;
+    std::vector<unsigned char> in;
+    std::vector<unsigned char> aad;
+    std::vector<unsigned char> out;
+};
+
+// submit the records from several threads while this thread flushes the engine and polls the completed records
+static void runAll(cryptoEngine& engine, std::vector<testCase>& cases) {
+    std::atomic<size_t> rejectNum(0);
+    std::vector<std::thread> producers;
+    for (int t = 0; t < N_THREAD; t++) {
+        producers.push_back(std::thread([&engine, &cases, &rejectNum, t]() {
+            for (size_t i = t; i < cases.size(); i += N_THREAD) {
+                while (!engine.submit(&cases[i].rec)) {
+                    if (cases[i].rec.status == CRYPTO_INVALID) {
+                        std::cout << "ERROR: record " << i << " is rejected" << std::endl;
+                        rejectNum++;
+                        break;
+                    }
+                    std::this_thread::yield();
+                }
+            }
+        }));
+    }
+
+    cryptoRecord* done[256];
+    size_t doneNum = 0;
+    while (doneNum + rejectNum < cases.size()) {
+        engine.flush();
+        doneNum += engine.poll(done, 256);
+    }
+    for (int t = 0; t < N_THREAD; t++) {
+        producers[t].join();
+    }
+}
+
+int main(int argc, const char* argv[]) {
+    std::cout << "\n---------------------Security Session Test-----------------\n";
+    ArgParser parser(argc, argv);
+    std::string xclbin_path;
+
+    // small batches keep many kernel calls in the test
+    cryptoEngine engine(1024, 1 << 20);
+    if (parser.getCmdOption("-xclbin", xclbin_path)) {
+        if (engine.init(xclbin_path)) {
+            std::cout << "ERROR: failed to set up the device" << std::endl;
+            return 1;
+        }
+        engine.setCpuThreshold(0);
+    } else {
+        std::cout << "WARNING: no xclbin, running on the CPU" << std::endl;
+    }
+
+    unsigned char key[32];
+    for (int i = 0; i < 32; i++) {
+        key[i] = i * 7 + 1;
+    }
+    // RFC 4231 test case 2
+    const unsigned char hmacKey[] = "Jefe";
+    cryptoSession* gcm = engine.openSession(CRYPTO_AES256_GCM, key, 32);
+    cryptoSession* cbc = engine.openSession(CRYPTO_AES256_CBC, key, 32);
+    cryptoSession* mac = engine.openSession(CRYPTO_HMAC_SHA256, hmacKey, 4);
+    cryptoSession* sha = engine.openSession(CRYPTO_SHA256, NULL, 0);
+
+    // encryption, MAC and digest of mixed records
+    srand(7);
+    std::vector<testCase> cases(N_THREAD * N_REC);
+    for (size_t i = 0; i < cases.size(); i++) {
+        testCase& c = cases[i];
+        cryptoSession* s[4] = {gcm, cbc, mac, sha};
+        memset(&c.rec, 0, sizeof(c.rec));
+        c.rec.session = s[i % 4];
+        c.rec.encrypt = true;
+        size_t len = rand() % MAX_LEN;
+        if (c.rec.session == cbc) {
+            len &= ~15;
+        }
+        c.in.resize(len);
+        for (size_t j = 0; j < len; j++) {
+            c.in[j] = rand();
+        }
+        if (c.rec.session == gcm) {
+            c.aad.resize(rand() % 64);
+            for (size_t j = 0; j < c.aad.size(); j++) {
+                c.aad[j] = rand();
+            }
+        }
+        c.out.resize(len);
+        for (int j = 0; j < 16; j++) {
+            c.rec.iv[j] = rand();
+        }
+        c.rec.in = c.in.data();
+        c.rec.inLen = len;
+        c.rec.aad = c.aad.data();
+        c.rec.aadLen = c.aad.size();
+        c.rec.out = c.out.data();
+    }
+    // known answers
+    const char* msg = "what do ya want for nothing?";
+    cases[2].in.assign(msg, msg + strlen(msg));
+    cases[2].rec.in = cases[2].in.data();
+    cases[2].rec.inLen = strlen(msg);
+    cases[3].in.assign({'a', 'b', 'c'});
+    cases[3].rec.in = cases[3].in.data();
+    cases[3].rec.inLen = 3;
+    runAll(engine, cases);
+
+    int nerror = 0;
+    const unsigned char hmacGolden[32] = {0x5b, 0xdc, 0xc1, 0x46, 0xbf, 0x60, 0x75, 0x4e, 0x6a, 0x04, 0x24,
+                                          0x26, 0x08, 0x95, 0x75, 0xc7, 0x5a, 0x00, 0x3f, 0x08, 0x9d, 0x27,
+                                          0x39, 0x83, 0x9d, 0xec, 0x58, 0xb9, 0x64, 0xec, 0x38, 0x43};
+    const unsigned char shaGolden[32] = {0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea, 0x41, 0x41, 0x40,
+                                         0xde, 0x5d, 0xae, 0x22, 0x23, 0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17,
+                                         0x7a, 0x9c, 0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad};
+    if (memcmp(cases[2].rec.tag, hmacGolden, 32) || memcmp(cases[3].rec.tag, shaGolden, 32)) {
+        std::cout << "ERROR: known answer mismatch" << std::endl;
+        nerror++;
+    }
+    for (size_t i = 0; i < cases.size(); i++) {
+        cryptoRecord& r = cases[i].rec;
+        unsigned char golden[32];
+        unsigned int len = 0;
+        if (r.session == mac) {
+            HMAC(EVP_sha256(), hmacKey, 4, r.in, r.inLen, golden, &len);
+        } else if (r.session == sha) {
+            SHA256(r.in, r.inLen, golden);
+        }
+        if (r.status != CRYPTO_OK || ((r.session == mac || r.session == sha) && memcmp(r.tag, golden, 32))) {
+            std::cout << "ERROR: record " << i << " mismatch" << std::endl;
+            nerror++;
+        }
+    }
+
+    // decryption of the cipher texts, with the tag of one GCM record broken
+    std::vector<testCase> back;
+    for (size_t i = 0; i < cases.size(); i++) {
+        if (cases[i].rec.session == gcm || cases[i].rec.session == cbc) {
+            testCase c = cases[i];
+            c.in = cases[i].out;
+            c.rec.encrypt = false;
+            c.rec.in = c.in.data();
+            c.rec.out = c.out.data();
+            c.rec.userData = &cases[i];
+            back.push_back(c);
+        }
+    }
+    for (size_t i = 0; i < back.size(); i++) {
+        back[i].rec.in = back[i].in.data();
+        back[i].rec.aad = back[i].aad.data();
+        back[i].rec.out = back[i].out.data();
+    }
+    back[0].rec.tag[0] ^= 1;
+    runAll(engine, back);
+
+    for (size_t i = 0; i < back.size(); i++) {
+        cryptoRecord& r = back[i].rec;
+        const testCase* c = (const testCase*)r.userData;
+        if (i == 0) {
+            if (r.status != CRYPTO_AUTH_FAIL) {
+                std::cout << "ERROR: broken tag is accepted" << std::endl;
+                nerror++;
+            }
+        } else if (r.status != CRYPTO_OK || back[i].out != c->in) {
+            std::cout << "ERROR: record " << i << " does not decrypt" << std::endl;
+            nerror++;
+        }
+    }
+
+    engine.closeSession(gcm);
+    engine.closeSession(cbc);
+    engine.closeSession(mac);
+    engine.closeSession(sha);
+
+    if (nerror) {
+        std::cout << "FAIL: " << nerror << " errors found." << std::endl;
+    } else {
+        std::cout << "PASS: " << cases.size() + back.size() << " records checked." << std::endl;
+    }
+    return nerror;
+}